@@ -93,6 +93,7 @@ install(FILES
               ${CMAKE_SOURCE_DIR}/core/libs/rawengine/drawdecoder.h
               ${CMAKE_SOURCE_DIR}/core/libs/rawengine/drawinfo.h
               ${CMAKE_SOURCE_DIR}/core/libs/rawengine/drawdecodersettings.h
+              ${CMAKE_SOURCE_DIR}/core/libs/rawengine/drawdecodersession.h
 
               ${CMAKE_SOURCE_DIR}/core/libs/widgets/mainview/dactivelabel.h
               ${CMAKE_SOURCE_DIR}/core/libs/widgets/itemview/ditemtooltip.h
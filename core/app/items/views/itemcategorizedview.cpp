@@ -134,6 +134,12 @@ void ItemCategorizedView::installDefaultModels()
 
     model->setWatchFlags(filterModel->suggestedWatchFlags());
 
+    // load the fields painted by the delegate for a whole page of items at once
+
+    DatabaseFields::Set prefetchFields = filterModel->suggestedWatchFlags();
+    prefetchFields                    |= DatabaseFields::PickLabel | DatabaseFields::ColorLabel;
+    model->setPrefetchFields(prefetchFields);
+
     setModels(model, filterModel);
 }
 
@@ -588,6 +594,21 @@ void ItemCategorizedView::updateGeometries()
     d->delayedEnterTimer->start();
 }
 
+void ItemCategorizedView::paintEvent(QPaintEvent* e)
+{
+    // load the fields painted by the delegate for the visible items at once
+
+    const QModelIndexList indexes = categorizedIndexesIn(viewport()->rect());
+
+    if (!indexes.isEmpty() && d->model && d->filterModel)
+    {
+        d->model->prefetch(d->filterModel->mapToSourceItemModel(indexes.first()));
+        d->model->prefetch(d->filterModel->mapToSourceItemModel(indexes.last()));
+    }
+
+    ItemViewCategorized::paintEvent(e);
+}
+
 void ItemCategorizedView::slotDelayedEnter()
 {
     // re-emit entered() for index under mouse (after layout).
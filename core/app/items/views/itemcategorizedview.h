@@ -188,6 +188,7 @@ protected:
     void currentChanged(const QModelIndex& index, const QModelIndex& previous)            override;
     void selectionChanged(const QItemSelection&, const QItemSelection&)                   override;
     void updateGeometries()                                                               override;
+    void paintEvent(QPaintEvent* e)                                                       override;
 
     /// Reimplement these in a subclass
     virtual void activated(const ItemInfo& info, Qt::KeyboardModifiers modifiers);
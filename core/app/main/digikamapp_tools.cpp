@@ -169,6 +169,7 @@ void DigikamApp::slotDetectFaces()
 
     settings.accuracy               = ApplicationSettings::instance()->getFaceDetectionAccuracy();
     settings.useYoloV3              = ApplicationSettings::instance()->getFaceDetectionYoloV3();
+    settings.useReducedSize         = ApplicationSettings::instance()->getFaceDetectionReducedSize();
     settings.task                   = FaceScanSettings::DetectAndRecognize;
     settings.alreadyScannedHandling = FaceScanSettings::Skip;
     settings.infos                  = newImages;
@@ -81,6 +81,7 @@ void ItemIconView::slotImageScanForFaces()
 
     settings.accuracy               = ApplicationSettings::instance()->getFaceDetectionAccuracy();
     settings.useYoloV3              = ApplicationSettings::instance()->getFaceDetectionYoloV3();
+    settings.useReducedSize         = ApplicationSettings::instance()->getFaceDetectionReducedSize();
     settings.task                   = FaceScanSettings::Detect;
     settings.alreadyScannedHandling = FaceScanSettings::Rescan;
 
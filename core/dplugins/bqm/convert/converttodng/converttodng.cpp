@@ -121,6 +121,13 @@ QString ConvertToDNG::outputSuffix() const
     return QLatin1String("dng");
 }
 
+bool ConvertToDNG::requiresFilePath() const
+{
+    // The DNG writer processes the RAW file, not the image data.
+
+    return true;
+}
+
 void ConvertToDNG::cancel()
 {
     m_dngProcessor.cancel();
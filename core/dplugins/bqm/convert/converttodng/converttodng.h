@@ -36,6 +36,7 @@ public:
 
     void cancel()                                           override;
     QString outputSuffix()                            const override;
+    bool    requiresFilePath()                        const override;
     BatchToolSettings defaultSettings()                     override;
 
     BatchTool* clone(QObject* const parent = nullptr) const override;
@@ -165,6 +165,13 @@ void UserScript::slotSettingsChanged()
     }
 }
 
+bool UserScript::requiresFilePath() const
+{
+    // The script gets the paths of the input and output files.
+
+    return true;
+}
+
 QString UserScript::outputSuffix () const
 {
     int filetype = settings()[QLatin1String("Output filetype")].toInt();
@@ -34,6 +34,7 @@ public:
     ~UserScript()                                           override;
 
     QString outputSuffix()                            const override;
+    bool    requiresFilePath()                        const override;
 
     BatchToolSettings defaultSettings()                     override;
 
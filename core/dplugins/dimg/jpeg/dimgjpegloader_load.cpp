@@ -28,6 +28,7 @@ extern "C"
 
 #include <QFile>
 #include <QByteArray>
+#include <QRect>
 
 // Local includes
 
@@ -144,22 +145,12 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
     try
     {
-        // -------------------------------------------------------------------
-        // Find out if we do the fast-track loading with reduced size. Jpeg specific.
-
-        int scaledLoadingSize = 0;
-        QVariant attribute    = imageGetAttribute(QLatin1String("scaledLoadingSize"));
-
-        if (attribute.isValid())
-        {
-            scaledLoadingSize = attribute.toInt();
-        }
-
         // -------------------------------------------------------------------
         // Set JPEG decompressor instance
 
         jpeg_create_decompress(&cinfo);
         bool startedDecompress = false;
+        bool partialDecompress = false;
 
         jpeg_stdio_src(&cinfo, file);
 
@@ -180,6 +171,10 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
         int h = cinfo.image_height;
         QSize originalSize(w, h);
 
+        // Region of interest to load, in full size image coordinates.
+
+        QRect roi = regionOfInterest(originalSize);
+
         // Libjpeg handles the following conversions:
         // YCbCr => GRAYSCALE, YCbCr => RGB, GRAYSCALE => RGB, YCCK => CMYK
         // So we cannot get RGB from CMYK or YCCK, CMYK conversion is handled below
@@ -245,30 +240,11 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             cinfo.do_fancy_upsampling = boolean(true);
             cinfo.do_block_smoothing  = boolean(false);
 
-            // handle scaled loading
-
-            if (scaledLoadingSize)
-            {
-                int imgSize = qMax(cinfo.image_width, cinfo.image_height);
-                int scale   = 1;
+            // handle scaled loading, relative to the region of interest if any.
+            // libjpeg supports 1/1, 1/2, 1/4, 1/8
 
-                // libjpeg supports 1/1, 1/2, 1/4, 1/8
-
-                while (scaledLoadingSize * scale * 2 <= imgSize)
-                {
-                    scale *= 2;
-                }
-
-                if (scale > 8)
-                {
-                    scale = 8;
-                }
-/*
-                cinfo.scale_num   = 1;
-                cinfo.scale_denom = scale;
-*/
-                cinfo.scale_denom *= scale;
-            }
+            const int scale    = scaledLoadingFactor(roi.isNull() ? originalSize : roi.size(), 8);
+            cinfo.scale_denom *= scale;
 
             // initialize decompression
 
@@ -290,12 +266,45 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             w = cinfo.output_width;
             h = cinfo.output_height;
 
+            // -------------------------------------------------------------------
+            // Region of interest in output coordinates. The lines after the region are
+            // not decoded. With libjpeg-turbo, the lines before are skipped without color
+            // conversion and upsampling, and the columns are cropped to the iMCU boundaries.
+
+            QRect region(0, 0, w, h);
+            int   left   = 0;       // First column of the region in a decoded scanline.
+            int   stride = w;       // Columns of a decoded scanline.
+
+            if (!roi.isNull())
+            {
+                region = QRect(QPoint(roi.left()  / scale, roi.top()    / scale),
+                               QPoint(roi.right() / scale, roi.bottom() / scale)) & region;
+                left   = region.left();
+
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && (LIBJPEG_TURBO_VERSION_NUMBER >= 1005000)
+
+                JDIMENSION xoffset = region.left();
+                JDIMENSION width   = region.width();
+                jpeg_crop_scanline(&cinfo, &xoffset, &width);
+                left               = region.left() - (int)xoffset;
+                stride             = cinfo.output_width;
+
+                if (region.top() > 0)
+                {
+                    jpeg_skip_scanlines(&cinfo, region.top());
+                }
+
+#endif
+
+                partialDecompress = (region.bottom() < (h - 1));
+            }
+
             // -------------------------------------------------------------------
             // Get scanlines
 
             uchar* ptr  = nullptr, *data = nullptr, *line[16];
             uchar* ptr2 = nullptr;
-            int    x, y, l, i, scans;
+            int    x, y, l, i, scans = 0;
             //        int count;
             //        int prevy;
 
@@ -349,8 +358,8 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                 return false;
             }
 
-            dest = new_failureTolerant(w, h, 4);
-            cleanupData->setSize(QSize(w, h));
+            dest = new_failureTolerant(region.width(), region.height(), 4);
+            cleanupData->setSize(region.size());
             cleanupData->setDest(dest);
 
             if (!dest)
@@ -371,18 +380,18 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             {
                 for (i = 0 ; i < cinfo.rec_outbuf_height ; ++i)
                 {
-                    line[i] = data + (i * w * 3);
+                    line[i] = data + (i * stride * 3);
                 }
 
                 int checkPoint = 0;
 
-                for (l = 0 ; l < h ; l += cinfo.rec_outbuf_height)
+                for (l = (int)cinfo.output_scanline ; l <= region.bottom() ; l += scans)
                 {
                     // use 0-10% and 90-100% for pseudo-progress
 
                     if (observer && (l >= checkPoint))
                     {
-                        checkPoint += granularity(observer, h, 0.8F);
+                        checkPoint += granularity(observer, region.bottom() + 1, 0.8F);
 
                         if (!observer->continueQuery())
                         {
@@ -393,22 +402,29 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             return false;
                         }
 
-                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)h))));
+                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)(region.bottom() + 1)))));
                     }
 
-                    jpeg_read_scanlines(&cinfo, &line[0], cinfo.rec_outbuf_height);
-                    scans = cinfo.rec_outbuf_height;
+                    scans = jpeg_read_scanlines(&cinfo, &line[0], cinfo.rec_outbuf_height);
 
-                    if ((h - l) < scans)
+                    if (scans <= 0)
                     {
-                        scans = h - l;
+                        break;
                     }
 
                     ptr = data;
 
                     for (y = 0 ; y < scans ; ++y)
                     {
-                        for (x = 0 ; x < w ; ++x)
+                        if (((l + y) < region.top()) || ((l + y) > region.bottom()))
+                        {
+                            ptr += stride * 3;
+                            continue;
+                        }
+
+                        ptr += left * 3;
+
+                        for (x = 0 ; x < region.width() ; ++x)
                         {
                             ptr2[3] = 0xFF;
                             ptr2[2] = ptr[0];
@@ -418,6 +434,8 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             ptr    += 3;
                             ptr2   += 4;
                         }
+
+                        ptr += (stride - left - region.width()) * 3;
                     }
                 }
             }
@@ -425,16 +443,16 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             {
                 for (i = 0 ; i < cinfo.rec_outbuf_height ; ++i)
                 {
-                    line[i] = data + (i * w);
+                    line[i] = data + (i * stride);
                 }
 
                 int checkPoint = 0;
 
-                for (l = 0 ; l < h ; l += cinfo.rec_outbuf_height)
+                for (l = (int)cinfo.output_scanline ; l <= region.bottom() ; l += scans)
                 {
                     if (observer && (l >= checkPoint))
                     {
-                        checkPoint += granularity(observer, h, 0.8F);
+                        checkPoint += granularity(observer, region.bottom() + 1, 0.8F);
 
                         if (!observer->continueQuery())
                         {
@@ -445,22 +463,29 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             return false;
                         }
 
-                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)h))));
+                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)(region.bottom() + 1)))));
                     }
 
-                    jpeg_read_scanlines(&cinfo, line, cinfo.rec_outbuf_height);
-                    scans = cinfo.rec_outbuf_height;
+                    scans = jpeg_read_scanlines(&cinfo, line, cinfo.rec_outbuf_height);
 
-                    if ((h - l) < scans)
+                    if (scans <= 0)
                     {
-                        scans = h - l;
+                        break;
                     }
 
                     ptr = data;
 
                     for (y = 0 ; y < scans ; ++y)
                     {
-                        for (x = 0 ; x < w ; ++x)
+                        if (((l + y) < region.top()) || ((l + y) > region.bottom()))
+                        {
+                            ptr += stride;
+                            continue;
+                        }
+
+                        ptr += left;
+
+                        for (x = 0 ; x < region.width() ; ++x)
                         {
                             ptr2[3] = 0xFF;
                             ptr2[2] = ptr[0];
@@ -470,6 +495,8 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             ptr    ++;
                             ptr2   += 4;
                         }
+
+                        ptr += (stride - left - region.width());
                     }
                 }
             }
@@ -477,18 +504,18 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             {
                 for (i = 0 ; i < cinfo.rec_outbuf_height ; ++i)
                 {
-                    line[i] = data + (i * w * 4);
+                    line[i] = data + (i * stride * 4);
                 }
 
                 int checkPoint = 0;
 
-                for (l = 0 ; l < h ; l += cinfo.rec_outbuf_height)
+                for (l = (int)cinfo.output_scanline ; l <= region.bottom() ; l += scans)
                 {
                     // use 0-10% and 90-100% for pseudo-progress
 
                     if (observer && (l >= checkPoint))
                     {
-                        checkPoint += granularity(observer, h, 0.8F);
+                        checkPoint += granularity(observer, region.bottom() + 1, 0.8F);
 
                         if (!observer->continueQuery())
                         {
@@ -499,22 +526,29 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             return false;
                         }
 
-                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)h))));
+                        observer->progressInfo(0.1F + (0.8F * (((float)l) / ((float)(region.bottom() + 1)))));
                     }
 
-                    jpeg_read_scanlines(&cinfo, &line[0], cinfo.rec_outbuf_height);
-                    scans = cinfo.rec_outbuf_height;
+                    scans = jpeg_read_scanlines(&cinfo, &line[0], cinfo.rec_outbuf_height);
 
-                    if ((h - l) < scans)
+                    if (scans <= 0)
                     {
-                        scans = h - l;
+                        break;
                     }
 
                     ptr   = data;
 
                     for (y = 0 ; y < scans ; ++y)
                     {
-                        for (x = 0 ; x < w ; ++x)
+                        if (((l + y) < region.top()) || ((l + y) > region.bottom()))
+                        {
+                            ptr += stride * 4;
+                            continue;
+                        }
+
+                        ptr += left * 4;
+
+                        for (x = 0 ; x < region.width() ; ++x)
                         {
                             // Inspired by Qt's JPEG loader
 
@@ -528,6 +562,8 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                             ptr    += 4;
                             ptr2   += 4;
                         }
+
+                        ptr += (stride - left - region.width()) * 4;
                     }
                 }
             }
@@ -535,6 +571,15 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             // clean up
 
             cleanupData->deleteData();
+
+            w = region.width();
+            h = region.height();
+
+            if (!roi.isNull())
+            {
+                setLoadedRegion(QRect(region.x()     * scale, region.y()      * scale,
+                                      region.width() * scale, region.height() * scale) & QRect(QPoint(0, 0), originalSize));
+            }
         }
 
         // -------------------------------------------------------------------
@@ -571,7 +616,13 @@ bool DImgJPEGLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
         // -------------------------------------------------------------------
 
-        if (startedDecompress)
+        if      (partialDecompress)
+        {
+            // The lines after the region of interest are not decoded.
+
+            jpeg_abort_decompress(&cinfo);
+        }
+        else if (startedDecompress)
         {
             jpeg_finish_decompress(&cinfo);
         }
@@ -37,6 +37,7 @@ extern "C"
 // Qt includes
 
 #include <QFile>
+#include <QRect>
 #include <QVariant>
 #include <qplatformdefs.h>
 
@@ -300,10 +301,23 @@ bool DImgPGFLoader::load(const QString& filePath, DImgLoaderObserver* const obse
         if (m_loadFlags & LoadImageData)
         {
             // Find out if we do the fast-track loading with reduced size. PGF specific.
+            // With a region of interest, the level is selected for the size of the region.
 
-            int level          = 0;
+            int      level     = 0;
+            QRect    roi;
             QVariant attribute = imageGetAttribute(QLatin1String("scaledLoadingSize"));
 
+#ifdef __PGFROISUPPORT__
+
+            if (pgf.ROIisSupported())
+            {
+                roi = regionOfInterest(originalSize);
+            }
+
+#endif
+
+            const QSize loadingSize = roi.isNull() ? originalSize : roi.size();
+
             if (attribute.isValid() && pgf.Levels() > 0)
             {
                 int scaledLoadingSize = attribute.toInt();
@@ -311,8 +325,8 @@ bool DImgPGFLoader::load(const QString& filePath, DImgLoaderObserver* const obse
 
                 for (i = pgf.Levels() - 1 ; i >= 0 ; --i)
                 {
-                    w = pgf.Width(i);
-                    h = pgf.Height(i);
+                    w = (loadingSize.width()  + (1 << i) - 1) >> i;
+                    h = (loadingSize.height() + (1 << i) - 1) >> i;
 
                     if (qMin(w, h) >= scaledLoadingSize)
                     {
@@ -332,6 +346,32 @@ bool DImgPGFLoader::load(const QString& filePath, DImgLoaderObserver* const obse
                 }
             }
 
+#ifdef __PGFROISUPPORT__
+
+            if (!roi.isNull())
+            {
+                // Only the wavelet blocks covering the region are decoded.
+
+                PGFRect rect(roi.left(), roi.top(), roi.width(), roi.height());
+                pgf.Read(rect, level, DImgPGFLoader::CallbackForLibPGF, this);
+
+                const PGFRect levelRoi = pgf.ComputeLevelROI();
+                width                  = levelRoi.Width();
+                height                 = levelRoi.Height();
+
+                setLoadedRegion(QRect(levelRoi.left << level, levelRoi.top << level,
+                                      width << level,         height << level) & QRect(QPoint(0, 0), originalSize));
+            }
+            else
+
+#endif
+
+            {
+                width  = pgf.Width(level);
+                height = pgf.Height(level);
+                pgf.Read(level, DImgPGFLoader::CallbackForLibPGF, this);
+            }
+
             if (m_sixteenBit)
             {
                 data = new_failureTolerant(width, height, 8); // 16 bits/color/pixel
@@ -345,7 +385,6 @@ bool DImgPGFLoader::load(const QString& filePath, DImgLoaderObserver* const obse
 
             memset(data, 0xFF, width * height * (m_sixteenBit ? 8 : 4));
 
-            pgf.Read(level, DImgPGFLoader::CallbackForLibPGF, this);
             pgf.GetBitmap(m_sixteenBit ? width * 8 : width * 4,
                           (UINT8*)data,
                           m_sixteenBit ? 64 : 32,
@@ -34,6 +34,7 @@ extern "C"
 
 #include <QFile>
 #include <QByteArray>
+#include <QRect>
 #include <QSysInfo>
 
 // Local includes
@@ -181,6 +182,7 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
         ~CleanupData()
         {
             delete [] data;
+            delete [] row;
             freeLines();
 
             if (file)
@@ -199,6 +201,11 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
             lines = l;
         }
 
+        void setRow(uchar* const r)
+        {
+            row = r;
+        }
+
         void setFile(FILE* const f)
         {
             file = f;
@@ -232,6 +239,7 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
     public:
 
         uchar*  data    = nullptr;
+        uchar*  row     = nullptr;
         uchar** lines   = { nullptr };
         FILE*   file    = nullptr;
 
@@ -380,7 +388,9 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
     cleanupData->setColorModel(colorModel);
     cleanupData->setSize(QSize(width, height));
 
-    uchar* data  = nullptr;
+    const QSize originalSize(width, height);
+    QRect       region(QPoint(0, 0), originalSize);
+    uchar*      data  = nullptr;
 
     if (m_loadFlags & LoadImageData)
     {
@@ -550,59 +560,48 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
 
         png_read_update_info(png_ptr, info_ptr);
 
-        if (m_sixteenBit)
-        {
-            data = new_failureTolerant(width, height, 8); // 16 bits/color/pixel
-        }
-        else
+        // Region of interest: only the rows up to the end of the region are decoded,
+        // and only the columns of the region are stored. Interlaced images are decoded
+        // in multiple passes over the whole image: they are always loaded in full.
+
+        if (number_passes == 1)
         {
-            data = new_failureTolerant(width, height, 4); // 8 bits/color/pixel
+            QRect roi = regionOfInterest(originalSize);
+
+            if (!roi.isNull())
+            {
+                region = roi;
+            }
         }
 
-        cleanupData->setData(data);
+        const int bytesDepth = m_sixteenBit ? 8 : 4;
+        data                 = new_failureTolerant(region.width(), region.height(), bytesDepth);
 
-        uchar** lines = nullptr;
-        (void)lines;    // to prevent cppcheck warnings.
-        lines         = (uchar**)malloc(height * sizeof(uchar*));
-        cleanupData->setLines(lines);
+        cleanupData->setData(data);
+        cleanupData->setSize(region.size());
 
-        if (!data || !lines)
+        if (region.size() != originalSize)
         {
-            qCDebug(DIGIKAM_DIMG_LOG_PNG) << "Cannot allocate memory to load PNG image data.";
-            png_read_end(png_ptr, info_ptr);
-            png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp) nullptr);
-            delete cleanupData;
-            loadingFailed();
-
-            return false;
-        }
+            uchar* const row = new_failureTolerant(width, 1, bytesDepth);
+            cleanupData->setRow(row);
 
-        for (int i = 0 ; i < height ; ++i)
-        {
-            if (m_sixteenBit)
+            if (!data || !row)
             {
-                lines[i] = data + ((quint64)i * (quint64)width * 8);
-            }
-            else
-            {
-                lines[i] = data + ((quint64)i * (quint64)width * 4);
-            }
-        }
+                qCDebug(DIGIKAM_DIMG_LOG_PNG) << "Cannot allocate memory to load PNG image data.";
+                png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp) nullptr);
+                delete cleanupData;
+                loadingFailed();
 
-        // The easy way to read the whole image
-        // png_read_image(png_ptr, lines);
-        // The other way to read images is row by row. Necessary for observer.
-        // Now we need to deal with interlacing.
+                return false;
+            }
 
-        for (int pass = 0 ; pass < number_passes ; ++pass)
-        {
             int checkPoint = 0;
 
-            for (int y = 0 ; y < height ; ++y)
+            for (int y = 0 ; y <= region.bottom() ; ++y)
             {
                 if (observer && (y == checkPoint))
                 {
-                    checkPoint += granularity(observer, height, 0.7F);
+                    checkPoint += granularity(observer, region.bottom() + 1, 0.7F);
 
                     if (!observer->continueQuery())
                     {
@@ -613,16 +612,88 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
                         return false;
                     }
 
-                    // use 10% - 80% for progress while reading rows
-
-                    observer->progressInfo(0.1F + (0.7F * (((float)y) / ((float)height))));
+                    observer->progressInfo(0.1F + (0.7F * (((float)y) / ((float)(region.bottom() + 1)))));
                 }
 
-                png_read_rows(png_ptr, lines + y, nullptr, 1);
+                png_read_row(png_ptr, row, nullptr);
+
+                if (y >= region.top())
+                {
+                    memcpy(data + (quint64)(y - region.top()) * region.width() * bytesDepth,
+                           row  + (quint64)region.left() * bytesDepth,
+                           (quint64)region.width() * bytesDepth);
+                }
             }
+
+            width  = region.width();
+            height = region.height();
+            setLoadedRegion(region);
         }
+        else
+        {
+            uchar** lines = nullptr;
+            (void)lines;    // to prevent cppcheck warnings.
+            lines         = (uchar**)malloc(height * sizeof(uchar*));
+            cleanupData->setLines(lines);
+
+            if (!data || !lines)
+            {
+                qCDebug(DIGIKAM_DIMG_LOG_PNG) << "Cannot allocate memory to load PNG image data.";
+                png_read_end(png_ptr, info_ptr);
+                png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp) nullptr);
+                delete cleanupData;
+                loadingFailed();
+
+                return false;
+            }
+
+            for (int i = 0 ; i < height ; ++i)
+            {
+                if (m_sixteenBit)
+                {
+                    lines[i] = data + ((quint64)i * (quint64)width * 8);
+                }
+                else
+                {
+                    lines[i] = data + ((quint64)i * (quint64)width * 4);
+                }
+            }
+
+            // The easy way to read the whole image
+            // png_read_image(png_ptr, lines);
+            // The other way to read images is row by row. Necessary for observer.
+            // Now we need to deal with interlacing.
+
+            for (int pass = 0 ; pass < number_passes ; ++pass)
+            {
+                int checkPoint = 0;
+
+                for (int y = 0 ; y < height ; ++y)
+                {
+                    if (observer && (y == checkPoint))
+                    {
+                        checkPoint += granularity(observer, height, 0.7F);
 
-        cleanupData->freeLines();
+                        if (!observer->continueQuery())
+                        {
+                            png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp) nullptr);
+                            delete cleanupData;
+                            loadingFailed();
+
+                            return false;
+                        }
+
+                        // use 10% - 80% for progress while reading rows
+
+                        observer->progressInfo(0.1F + (0.7F * (((float)y) / ((float)height))));
+                    }
+
+                    png_read_rows(png_ptr, lines + y, nullptr, 1);
+                }
+            }
+
+            cleanupData->freeLines();
+        }
 
         if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
         {
@@ -725,8 +796,10 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
 
     // -------------------------------------------------------------------
 
-    if (m_loadFlags & LoadImageData)
+    if ((m_loadFlags & LoadImageData) && (region.size() == originalSize))
     {
+        // With a region of interest, the rows after the region are not read.
+
         png_read_end(png_ptr, info_ptr);
     }
 
@@ -745,7 +818,7 @@ bool DImgPNGLoader::load(const QString& filePath, DImgLoaderObserver* const obse
     imageSetAttribute(QLatin1String("format"),             QLatin1String("PNG"));
     imageSetAttribute(QLatin1String("originalColorModel"), colorModel);
     imageSetAttribute(QLatin1String("originalBitDepth"),   bit_depth);
-    imageSetAttribute(QLatin1String("originalSize"),       QSize(width, height));
+    imageSetAttribute(QLatin1String("originalSize"),       originalSize);
 
     return true;
 }
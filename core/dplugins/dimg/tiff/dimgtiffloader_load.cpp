@@ -28,6 +28,7 @@ extern "C"
 
 #include <QFile>
 #include <QFloat16>
+#include <QRect>
 #include <QByteArray>
 
 // Local includes
@@ -274,6 +275,7 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
     // Get image data.
 
     QScopedArrayPointer<uchar> data;
+    QRect region(0, 0, w, h);
 
     if (m_loadFlags & LoadImageData)
     {
@@ -287,7 +289,28 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
         if (bits_per_sample == 16)          // 16 bits image.
         {
-            data.reset(new_failureTolerant(w, h, 8));
+            // Region of interest: with interleaved samples, only the strips covering
+            // the rows of the region are decoded. The columns are kept.
+
+            tstrip_t firstStrip = 0;
+            tstrip_t endStrip   = num_of_strips;
+            QRect    roi;
+
+            if (((samples_per_pixel == 1) || (planar_config == PLANARCONFIG_CONTIG)) && !TIFFIsTiled(tif))
+            {
+                roi = regionOfInterest(QSize(w, h));
+            }
+
+            if (!roi.isNull())
+            {
+                firstStrip        = roi.top() / rows_per_strip;
+                endStrip          = qMin(num_of_strips, (tstrip_t)(roi.bottom() / rows_per_strip + 1));
+                const uint top    = firstStrip * rows_per_strip;
+                const uint bottom = qMin(h, endStrip * rows_per_strip);
+                region            = QRect(0, top, w, bottom - top);
+            }
+
+            data.reset(new_failureTolerant(region.width(), region.height(), 8));
             QScopedArrayPointer<uchar> strip(new_failureTolerant(strip_size));
 
             if (!data || strip.isNull())
@@ -301,13 +324,13 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
             qint64 offset     = 0;
             qint64 bytesRead  = 0;
-            uint   checkpoint = 0;
+            uint   checkpoint = firstStrip;
 
-            for (tstrip_t st = 0 ; st < num_of_strips ; ++st)
+            for (tstrip_t st = firstStrip ; st < endStrip ; ++st)
             {
                 if (observer && (st == checkpoint))
                 {
-                    checkpoint += granularity(observer, num_of_strips, 0.8F);
+                    checkpoint += granularity(observer, endStrip - firstStrip, 0.8F);
 
                     if (!observer->continueQuery())
                     {
@@ -317,7 +340,7 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                         return false;
                     }
 
-                    observer->progressInfo(0.1F + (0.8F * (((float)st) / ((float)num_of_strips))));
+                    observer->progressInfo(0.1F + (0.8F * (((float)(st - firstStrip)) / ((float)(endStrip - firstStrip)))));
                 }
 
                 bytesRead = TIFFReadEncodedStrip(tif, st, strip.data(), strip_size);
@@ -589,8 +612,16 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                     offset += bytesRead / 2 * 8;
                 }
             }
+
+            if (region != QRect(0, 0, w, h))
+            {
+                setLoadedRegion(region);
+            }
         }
 
+        // NOTE: 32 bits float images are normalized with the maximal value of the whole image,
+        // they are always loaded in full.
+
         else if ((bits_per_sample == 32) && (sample_format == SAMPLEFORMAT_IEEEFP))          // 32 bits float image.
         {
             data.reset(new_failureTolerant(w, h, 8));
@@ -837,7 +868,16 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
         else       // Non 16 or 32 bits images ==> get it on BGRA 8 bits.
         {
-            data.reset(new_failureTolerant(w, h, 4));
+            // Region of interest: only the strips or tiles covering the region are decoded.
+
+            QRect roi = regionOfInterest(QSize(w, h));
+
+            if (!roi.isNull())
+            {
+                region = roi;
+            }
+
+            data.reset(new_failureTolerant(region.width(), region.height(), 4));
             QScopedArrayPointer<uchar> strip(new_failureTolerant(w, rows_per_strip, 4));
 
             if (!data || strip.isNull())
@@ -878,11 +918,14 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
             // read strips from image: read rows_per_strip, so always start at beginning of a strip
 
-            for (uint row = 0 ; row < h ; row += rows_per_strip)
+            const uint top    = region.top();
+            const uint bottom = region.bottom();
+
+            for (uint row = top - (top % rows_per_strip) ; row <= bottom ; row += rows_per_strip)
             {
                 if (observer && (row >= checkpoint))
                 {
-                    checkpoint += granularity(observer, h, 0.8F);
+                    checkpoint += granularity(observer, bottom + 1, 0.8F);
 
                     if (!observer->continueQuery())
                     {
@@ -892,11 +935,11 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                         return false;
                     }
 
-                    observer->progressInfo(0.1F + (0.8F * (((float)row) / ((float)h))));
+                    observer->progressInfo(0.1F + (0.8F * (((float)row) / ((float)(bottom + 1)))));
                 }
 
                 img.row_offset  = row;
-                img.col_offset  = 0;
+                img.col_offset  = region.left();
 
                 if ((row + rows_per_strip) > img.height)
                 {
@@ -909,7 +952,7 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
 
                 // Read data
 
-                if (TIFFRGBAImageGet(&img, reinterpret_cast<uint32*>(strip.data()), img.width, rows_to_read) == -1)
+                if (TIFFRGBAImageGet(&img, reinterpret_cast<uint32*>(strip.data()), region.width(), rows_to_read) == -1)
                 {
                     qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Failed to read image data";
                     TIFFClose(tif);
@@ -918,9 +961,13 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
                     return false;
                 }
 
-                pixelsRead      = (qint64)rows_to_read * (qint64)img.width;
+                // Keep only the rows of the strip inside the region.
+
+                const uint first = qMax(row, top) - row;
+                const uint last  = qMin(row + rows_to_read - 1, bottom) - row;
+                pixelsRead       = (qint64)(last - first + 1) * (qint64)region.width();
 
-                uchar* stripPtr = (uchar*)(strip.data());
+                uchar* stripPtr = (uchar*)(strip.data() + (qint64)first * region.width() * 4);
                 uchar* dataPtr  = (uchar*)(data.data() + offset);
                 uchar* p        = nullptr;
 
@@ -942,6 +989,11 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
             }
 
             TIFFRGBAImageEnd(&img);
+
+            if (region != QRect(0, 0, w, h))
+            {
+                setLoadedRegion(region);
+            }
         }
     }
 
@@ -954,8 +1006,8 @@ bool DImgTIFFLoader::load(const QString& filePath, DImgLoaderObserver* const obs
         observer->progressInfo(1.0F);
     }
 
-    imageWidth()  = w;
-    imageHeight() = h;
+    imageWidth()  = region.width();
+    imageHeight() = region.height();
     imageData()   = data.take();
     imageSetAttribute(QLatin1String("format"),             QLatin1String("TIFF"));
     imageSetAttribute(QLatin1String("originalColorModel"), colorModel);
@@ -0,0 +1,77 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a ring buffer of encoded MJPEG frames shared by the clients.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "mjpegframering.h"
+
+// Qt includes
+
+#include <QMutexLocker>
+
+namespace DigikamGenericMjpegStreamPlugin
+{
+
+MjpegFrameRing::MjpegFrameRing(int capacity)
+{
+    for (int i = 0 ; i < qMax(1, capacity) ; ++i)
+    {
+        m_sections << QByteArray();
+    }
+}
+
+qint64 MjpegFrameRing::push(const QByteArray& jpeg)
+{
+    // The section is built outside the lock, the writer only waits for the slot update.
+
+    const QByteArray data = section(jpeg);
+
+    QMutexLocker lock(&m_mutex);
+
+    ++m_sequence;
+    m_sections[m_sequence % m_sections.size()] = data;
+
+    return m_sequence;
+}
+
+QByteArray MjpegFrameRing::latest(qint64& sequence) const
+{
+    QMutexLocker lock(&m_mutex);
+
+    sequence = m_sequence;
+
+    if (m_sequence == 0)
+    {
+        return QByteArray();
+    }
+
+    return m_sections.at(m_sequence % m_sections.size());
+}
+
+QByteArray MjpegFrameRing::section(const QByteArray& jpeg)
+{
+    const QByteArray head = QByteArray("--mjpegstream\r\n"
+                                       "Content-type: image/jpeg\r\n"
+                                       "Content-length: ") +
+                            QByteArray::number(jpeg.size())    +
+                            QByteArray("\r\n\r\n");
+
+    QByteArray data;
+    data.reserve(head.size() + jpeg.size() + 4);
+    data.append(head);
+    data.append(jpeg);
+    data.append("\r\n\r\n");
+
+    return data;
+}
+
+} // namespace DigikamGenericMjpegStreamPlugin
@@ -0,0 +1,70 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a ring buffer of encoded MJPEG frames shared by the clients.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+
+namespace DigikamGenericMjpegStreamPlugin
+{
+
+/**
+ * Keep the last frames pushed to the server as complete multipart sections:
+ * the part header, the JPEG data and the trailer. A section is built once
+ * when the frame is pushed and it is shared by reference with all clients,
+ * without copying data. A frame still sent to a slow client stays valid
+ * when the ring slot is reused, as QByteArray is implicitly shared.
+ */
+class MjpegFrameRing
+{
+public:
+
+    explicit MjpegFrameRing(int capacity = 4);
+    ~MjpegFrameRing() = default;
+
+    /**
+     * Build the multipart section of the JPEG frame and store it in the ring.
+     * Return the sequence number of the frame, starting from 1.
+     */
+    qint64     push(const QByteArray& jpeg);
+
+    /**
+     * Return the most recent section and its sequence number,
+     * or a null array with a sequence of 0 if no frame was pushed.
+     */
+    QByteArray latest(qint64& sequence) const;
+
+    /**
+     * Return the multipart section of a JPEG frame as sent to the clients.
+     */
+    static QByteArray section(const QByteArray& jpeg);
+
+private:
+
+    // Disable
+    MjpegFrameRing(const MjpegFrameRing&)            = delete;
+    MjpegFrameRing& operator=(const MjpegFrameRing&) = delete;
+
+private:
+
+    QList<QByteArray> m_sections;
+    qint64            m_sequence = 0;
+    mutable QMutex    m_mutex;
+};
+
+} // namespace DigikamGenericMjpegStreamPlugin
@@ -15,16 +15,16 @@
 
 #include "mjpegframetask.h"
 
-// C++ includes
-
-#include <cmath>
-
 // Qt includes
 
 #include <QString>
 #include <QBuffer>
 #include <QApplication>
 #include <QIcon>
+#include <QMap>
+#include <QFuture>
+#include <QElapsedTimer>
+#include <QtConcurrent>              // krazy:exclude=includes
 
 // Local includes
 
@@ -54,10 +54,14 @@ public:
         endImg    = QIcon::fromTheme(QLatin1String("window-close")).pixmap(VidSlideSettings::videoSizeFromType(type)).toImage();
     }
 
-    MjpegStreamSettings settings;               ///< The MJPEG stream settings.
-    QImage              brokenImg;              ///< Image to push as frame if current item from list cannot be loaded.
-    QImage              endImg;                 ///< Image to push as frame when stream is complete.
-    bool                failedToLoad = false;   ///< determinate if image is loaded
+    MjpegStreamSettings         settings;               ///< The MJPEG stream settings.
+    QImage                      brokenImg;              ///< Image to push as frame if current item from list cannot be loaded.
+    QImage                      endImg;                 ///< Image to push as frame when stream is complete.
+    bool                        failedToLoad = false;   ///< determinate if image is loaded
+    QMap<int, QFuture<QImage> > prefetched;             ///< Items decoded and scaled in background, by index in the list.
+    const int                   lookahead    = 2;       ///< Number of next items to prefetch while the current one is shown.
+    QElapsedTimer               clock;                  ///< Time reference to pace the frames.
+    qint64                      nextFrame    = 0;       ///< Time in ns when the next frame is due.
 };
 
 MjpegFrameTask::MjpegFrameTask(const MjpegStreamSettings& settings)
@@ -90,27 +94,96 @@ QImage MjpegFrameTask::loadImageFromPreviewCache(const QString& path) const
 
     if (dimg.isNull())
     {
-        // Generate an error frame.
-
-        qimg            = d->brokenImg;
-        d->failedToLoad = true;
         qCWarning(DIGIKAM_GENERAL_LOG) << "MjpegStream: Failed to load" << path;
+
+        return qimg;
     }
-    else
+
+    // Generate real preview frame, resized to the wanted dimensions.
+
+    qimg                           = dimg.copyQImage();
+    VidSlideSettings::VidType type = (VidSlideSettings::VidType)d->settings.outSize;
+
+    return FrameUtils::makeScaledImage(qimg, VidSlideSettings::videoSizeFromType(type));
+}
+
+void MjpegFrameTask::prefetchImage(int index)
+{
+    if ((index < 0) || (index >= d->settings.inputImages.count()) || d->prefetched.contains(index))
+    {
+        return;
+    }
+
+    const QString path = d->settings.inputImages[index].toLocalFile();
+
+    d->prefetched.insert(index, QtConcurrent::run([this, path]()
+        {
+            return loadImageFromPreviewCache(path);
+        }
+    ));
+}
+
+QImage MjpegFrameTask::takeImage(int index)
+{
+    prefetchImage(index);
+
+    QImage qimg = d->prefetched.take(index).result();
+
+    // Start to decode the next items while the current one is shown.
+
+    for (int i = 1 ; i <= d->lookahead ; ++i)
     {
-        // Generate real preview frame.
+        int next = index + i;
 
-        qimg = dimg.copyQImage();
+        if (next >= d->settings.inputImages.count())
+        {
+            if (!d->settings.loop)
+            {
+                break;
+            }
+
+            next %= d->settings.inputImages.count();
+        }
+
+        if (next != index)
+        {
+            prefetchImage(next);
+        }
     }
 
-    // Resize output image to the wanted dimensions.
+    if (qimg.isNull())
+    {
+        // Generate an error frame.
 
-    VidSlideSettings::VidType type = (VidSlideSettings::VidType)d->settings.outSize;
-    qimg                           = FrameUtils::makeScaledImage(qimg, VidSlideSettings::videoSizeFromType(type));
+        VidSlideSettings::VidType type = (VidSlideSettings::VidType)d->settings.outSize;
+        qimg                           = FrameUtils::makeScaledImage(d->brokenImg, VidSlideSettings::videoSizeFromType(type));
+        d->failedToLoad                = true;
+    }
 
     return qimg;
 }
 
+void MjpegFrameTask::sendFrame(const QByteArray& frame)
+{
+    Q_EMIT signalFrameChanged(frame);
+
+    // Pace the frames on a fixed period, which include the rendering and the encoding time.
+
+    d->nextFrame      += 1000000000LL / d->settings.rate;
+    const qint64 wait  = d->nextFrame - d->clock.nsecsElapsed();
+
+    if (wait > 0)
+    {
+        QThread::usleep(wait / 1000);
+    }
+    else
+    {
+        // Late frame: do not try to catch up with a burst of frames.
+
+        d->nextFrame = d->clock.nsecsElapsed();
+    }
+}
+
 void MjpegFrameTask::run()
 {
     QImage qiimg;   // Current image in stream.
@@ -131,6 +204,9 @@ void MjpegFrameTask::run()
     effmngr.setOutputSize(JPEGsize);
     effmngr.setFrames(imgFrames);               // Ex: 30 frames at 10 img/s => 3 s of effect
 
+    d->clock.start();
+    d->nextFrame = 0;
+
     do
     {
         // To stream in loop forever.
@@ -146,16 +222,9 @@ void MjpegFrameTask::run()
                 qiimg = FrameUtils::makeFramedImage(QString(), JPEGsize);
             }
 
-            QString ofile;
+            // The current item to pass to the next stage from a transition
 
-            if (i < d->settings.inputImages.count())
-            {
-                // The current item to pass to the next stage from a transition
-
-                ofile = d->settings.inputImages[i].toLocalFile();
-            }
-
-            qoimg      = loadImageFromPreviewCache(ofile);
+            qoimg      = takeImage(i);
 
             // Apply transition between images
 
@@ -171,9 +240,7 @@ void MjpegFrameTask::run()
 
                 qtimg = transmngr.currentFrame(ttmout);
 
-                Q_EMIT signalFrameChanged(imageToJPEGArray(qtimg));
-
-                QThread::msleep(lround(1000.0 / d->settings.rate));
+                sendFrame(imageToJPEGArray(qtimg));
             }
             while ((ttmout != -1) && !m_cancel);
 
@@ -183,8 +250,10 @@ void MjpegFrameTask::run()
 
             // Apply effect on frame
 
-            int count  = 0;
-            int itmout = 0;
+            int count       = 0;
+            int itmout      = 0;
+            qint64 frameKey = 0;
+            QByteArray jpeg;
             effmngr.setImage(qoimg);
             effmngr.setEffect(d->settings.effect);
 
@@ -192,7 +261,20 @@ void MjpegFrameTask::run()
             {
                 // Loop over all stages to make the effect
 
-                qiimg = effmngr.currentFrame(itmout);
+                QImage qeimg = effmngr.currentFrame(itmout);
+
+                if (!jpeg.isNull() && (qeimg.cacheKey() == frameKey))
+                {
+                    // The effect frame did not change, as without effect: send the previous encoded frame again.
+
+                    sendFrame(jpeg);
+                    count++;
+
+                    continue;
+                }
+
+                frameKey = qeimg.cacheKey();
+                qiimg    = qeimg;
 
                 if (!d->failedToLoad)
                 {
@@ -211,11 +293,10 @@ void MjpegFrameTask::run()
                                                 QLatin1String("Failed to load image"));
                 }
 
-                Q_EMIT signalFrameChanged(imageToJPEGArray(qiimg));
+                jpeg = imageToJPEGArray(qiimg);
+                sendFrame(jpeg);
 
                 count++;
-
-                QThread::msleep(lround(1000.0 / d->settings.rate));
             }
             while ((count < imgFrames) && !m_cancel);
 
@@ -225,6 +306,15 @@ void MjpegFrameTask::run()
     }
     while (!m_cancel && d->settings.loop);
 
+    // The prefetch tasks use this instance.
+
+    for (QFuture<QImage> future : std::as_const(d->prefetched))
+    {
+        future.waitForFinished();
+    }
+
+    d->prefetched.clear();
+
     osd.insertMessageOsdToFrame(d->endImg,
                                 JPEGsize,
                                 QLatin1String("End of stream"));
@@ -62,9 +62,27 @@ private:
 
     /**
      * Load image from Preview cache from path with desired output size.
+     * Return a null image if the item cannot be loaded.
+     * This method is called from the prefetch threads.
      */
     QImage loadImageFromPreviewCache(const QString& path) const;
 
+    /**
+     * Start to load the item at index from the list in background, if not yet done.
+     */
+    void   prefetchImage(int index);
+
+    /**
+     * Return the item at index from the list, loaded in background, and start
+     * to load the next items. An error frame is returned if the item cannot be loaded.
+     */
+    QImage takeImage(int index);
+
+    /**
+     * Send the frame to the server and wait until the next frame is due.
+     */
+    void   sendFrame(const QByteArray& frame);
+
     /**
      * Loop from separated main thread to render periodically frames for MJPEG stream.
      * This include transition between images and effect to render items.
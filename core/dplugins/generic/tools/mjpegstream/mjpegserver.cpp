@@ -96,16 +96,12 @@ QStringList MjpegServer::blackList() const
 
 void MjpegServer::slotWriteFrame(const QByteArray& frame)
 {
-    d->mutexFrame.lock();
+    if (!frame.isNull())
     {
-        if (!frame.isNull())
-        {
-            // Perform a deep-copy of image data.
+        // The frame data are shared with the ring, not copied for each client.
 
-            d->lastFrame = QByteArray(frame.data(), frame.size());
-        }
+        d->frames.push(frame);
     }
-    d->mutexFrame.unlock();
 }
 
 void MjpegServer::start()
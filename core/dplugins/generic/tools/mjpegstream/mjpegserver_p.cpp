@@ -26,15 +26,21 @@
 
 #ifndef Q_OS_WIN
 #   include <sys/socket.h>
+#   include <poll.h>
+#   include <errno.h>
 #else
+#   include <winsock2.h>
 #   include <windows.h>
 #   define MSG_NOSIGNAL 0
+#   define MSG_DONTWAIT 0
 #endif
 
 // Qt includes
 
 #include <QString>
 #include <QBuffer>
+#include <QElapsedTimer>
+#include <QVector>
 #include <QtConcurrent>              // krazy:exclude=includes
 
 // Local includes
@@ -44,6 +50,50 @@
 namespace DigikamGenericMjpegStreamPlugin
 {
 
+/**
+ * Return true if the last socket operation failed as the socket buffer is full.
+ */
+static bool socketWouldBlock()
+{
+
+#ifdef Q_OS_WIN
+
+    return (WSAGetLastError() == WSAEWOULDBLOCK);
+
+#else
+
+    return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR));
+
+#endif
+
+}
+
+/**
+ * Wait until one of the sockets can be written, or the timeout in ms.
+ */
+static void waitForSockets(QVector<pollfd>& fds, int timeout)
+{
+    if (fds.isEmpty())
+    {
+        // WSAPoll() do not wait without socket.
+
+        QThread::usleep(timeout * 1000);
+
+        return;
+    }
+
+#ifdef Q_OS_WIN
+
+    (void)WSAPoll(fds.data(), (ULONG)fds.size(), timeout);
+
+#else
+
+    (void)::poll(fds.data(), (nfds_t)fds.size(), timeout);
+
+#endif
+
+}
+
 MjpegServer::Private::Private(QObject* const parent)
     : QObject(parent)
 {
@@ -68,13 +118,23 @@ int MjpegServer::Private::maxClients() const
     return (-1);
 }
 
-int MjpegServer::Private::writeInSocket(int sock, const QByteArray& data) const
+int MjpegServer::Private::writeInSocket(int sock, const char* data, int size) const
 {
-    if (!data.isEmpty())
+    if (size > 0)
     {
         try
         {
-            return (::send(sock, data.constData(), data.size(), MSG_NOSIGNAL));
+            int ret = ::send(sock, data, size, MSG_NOSIGNAL | MSG_DONTWAIT);
+
+            if (ret >= 0)
+            {
+                return ret;
+            }
+
+            if (socketWouldBlock())
+            {
+                return 0;
+            }
         }
         catch (int e)
         {
@@ -176,19 +236,24 @@ void MjpegServer::Private::slotNewConnection()
 
                 mutexClients.lock();
                 {
-                    client->write(QByteArray("HTTP/1.0 200 OK\r\n"));
-
-                    client->write(QByteArray("Server: digiKamMjpeg/1.0\r\n"
-                                             "Accept-Range: bytes\r\n"
-                                             "Connection: close\r\n"
-                                             "Max-Age: 0\r\n"
-                                             "Expires: 0\r\n"
-                                             "Cache-Control: no-cache, private\r\n"
-                                             "Pragma: no-cache\r\n"
-                                             "Content-Type: multipart/x-mixed-replace; boundary=--mjpegstream\r\n"
-                                             "\r\n"));
-
-                    clients.push_back(client);
+                    // The HTTP header is sent by the writer thread before the first frame,
+                    // as the Qt socket buffer is not synchronized with the native socket writes.
+
+                    Client newClient;
+                    newClient.socket     = client;
+                    newClient.descriptor = client->socketDescriptor();
+                    newClient.pending    = QByteArray("HTTP/1.0 200 OK\r\n"
+                                                      "Server: digiKamMjpeg/1.0\r\n"
+                                                      "Accept-Range: bytes\r\n"
+                                                      "Connection: close\r\n"
+                                                      "Max-Age: 0\r\n"
+                                                      "Expires: 0\r\n"
+                                                      "Cache-Control: no-cache, private\r\n"
+                                                      "Pragma: no-cache\r\n"
+                                                      "Content-Type: multipart/x-mixed-replace; boundary=--mjpegstream\r\n"
+                                                      "\r\n");
+
+                    clients.push_back(newClient);
 
                     qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server new client    :" << clientDescription(client);
                     qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server total clients :" << clients.count();
@@ -214,16 +279,24 @@ void MjpegServer::Private::slotClientDisconnected()
 
     mutexClients.lock();
     {
-        int index = clients.indexOf(client);
-
-        if (index != -1)
+        for (int index = 0 ; index < clients.count() ; ++index)
         {
-            clients.removeAt(index);
+            if (clients.at(index).socket == client)
+            {
+                qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server client disconnected :" << clientDescription(client)
+                                             << "- frames sent:"    << clients.at(index).sent
+                                             << "- frames dropped:" << clients.at(index).dropped;
+
+                clients.removeAt(index);
+
+                qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server total clients       :" << clients.count();
+
+                // The native socket is closed after its removal from the list used by the writer thread.
 
-            qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server client disconnected :" << clientDescription(client);
-            qCDebug(DIGIKAM_GENERAL_LOG) << "MJPEG server total clients       :" << clients.count();
+                client->deleteLater();
 
-            client->deleteLater();
+                break;
+            }
         }
     }
     mutexClients.unlock();
@@ -234,63 +307,110 @@ void MjpegServer::Private::slotClientDisconnected()
 
 void MjpegServer::Private::writerThread()
 {
+    QElapsedTimer clock;
+    clock.start();
+
+    QVector<pollfd> fds;
+
     while (isOpened())
     {
-        QList <QFuture<void> > sockTasks;
+        const qint64 now    = clock.nsecsElapsed();
+        const qint64 period = (qint64)delay * 1000;
+        qint64 timeout      = period;
+
+        fds.clear();
 
-        mutexFrame.lock();
+        mutexClients.lock();
         {
-            mutexClients.lock();
+            for (Client& client : clients)
             {
-                for (QTcpSocket* const client : std::as_const(clients))
+                if (client.failed)
                 {
-                    sockTasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                     &MjpegServer::Private::clientWriteMultithreaded, this,
-
-#else
+                    continue;
+                }
 
-                                     this, &MjpegServer::Private::clientWriteMultithreaded,
+                if (client.pending.isEmpty() && (now >= client.nextFrame))
+                {
+                    // Queue the last frame, by reference. The frames pushed while the client
+                    // was still busy are skipped. The last one is sent again if no new frame
+                    // is available, as the clients only show a frame when the next one arrives.
+
+                    qint64 sequence       = 0;
+                    const QByteArray data = frames.latest(sequence);
+
+                    if (!data.isNull())
+                    {
+                        if ((client.sequence > 0) && (sequence > (client.sequence + 1)))
+                        {
+                            client.dropped += sequence - client.sequence - 1;
+                        }
+
+                        client.pending   = data;
+                        client.offset    = 0;
+                        client.sequence  = sequence;
+                        client.nextFrame = qMax(client.nextFrame + period, now);
+                        ++client.sent;
+                    }
+                }
 
-#endif
+                flushClient(client);
 
-                                     client->socketDescriptor(),
-                                     lastFrame)
-                                    );
+                if (!client.pending.isEmpty())
+                {
+                    pollfd fd;
+                    fd.fd      = client.descriptor;
+                    fd.events  = POLLOUT;
+                    fd.revents = 0;
+                    fds.append(fd);
+                }
+                else if (client.nextFrame > now)
+                {
+                    timeout = qMin(timeout, client.nextFrame - now);
                 }
-            }
-            mutexClients.unlock();
-
-            for (QFuture<void> t : std::as_const(sockTasks))
-            {
-                t.waitForFinished();
             }
         }
-        mutexFrame.unlock();
+        mutexClients.unlock();
+
+        // Wait for a busy socket to be writable again, or for the next frame to send.
 
-        QThread::usleep(delay);
+        waitForSockets(fds, qMax(1, (int)(timeout / 1000000)));
     }
 }
 
-void MjpegServer::Private::clientWriteMultithreaded(int client, const QByteArray& data)
+void MjpegServer::Private::flushClient(Client& client)
 {
-    QString head;
-    head.append(QLatin1String("--mjpegstream\r\n"
-                              "Content-type: image/jpeg\r\n"
-                              "Content-length: "));
-    head.append(QString::number(data.size()));
-    head.append(QLatin1String("\r\n\r\n"));
+    while (!client.failed && !client.pending.isEmpty())
+    {
+        int ret = writeInSocket(client.descriptor,
+                                client.pending.constData() + client.offset,
+                                client.pending.size()      - client.offset);
+
+        if      (ret < 0)
+        {
+            // The client is gone. The socket will be removed from the list on disconnection.
 
-    // Write header
+            client.failed = true;
+            client.pending.clear();
+        }
+        else if (ret == 0)
+        {
+            // The socket buffer is full, the end of data is sent when the socket is writable.
 
-    (void)writeInSocket(client, head.toLatin1());
+            return;
+        }
+        else
+        {
+            client.offset += ret;
 
-    // Write image data
+            if (client.offset >= client.pending.size())
+            {
+                // Release the reference to the frame shared with the ring.
 
-    (void)writeInSocket(client, data);
-    (void)writeInSocket(client, QByteArray("\r\n\r\n"));
+                client.pending.clear();
+                client.offset = 0;
+            }
+        }
+    }
 }
 
 } // namespace DigikamGenericMjpegStreamPlugin
@@ -27,6 +27,7 @@
 // Local includes
 
 #include "mjpegserver.h"
+#include "mjpegframering.h"
 #include "digikam_debug.h"
 
 namespace DigikamGenericMjpegStreamPlugin
@@ -40,6 +41,27 @@ class Q_DECL_HIDDEN MjpegServer::Private : public QObject
 {
     Q_OBJECT
 
+public:
+
+    /**
+     * A client connected to the server. The sending state is only
+     * used by the writer thread, with the clients list locked.
+     */
+    class Q_DECL_HIDDEN Client
+    {
+    public:
+
+        QTcpSocket* socket     = nullptr;   ///< the client socket, living in the main thread.
+        int         descriptor = -1;        ///< the native socket written by the writer thread.
+        QByteArray  pending;                ///< the data being sent, shared with the frames ring.
+        int         offset     = 0;         ///< the size of pending data already sent.
+        qint64      sequence   = 0;         ///< the sequence number of the last frame queued.
+        qint64      nextFrame  = 0;         ///< the writer time in ns when the next frame is due.
+        qint64      sent       = 0;         ///< the number of frames sent.
+        qint64      dropped    = 0;         ///< the number of frames skipped while the client was busy.
+        bool        failed     = false;     ///< the socket cannot be written anymore.
+    };
+
 public:
 
     explicit Private(QObject* const parent);
@@ -52,11 +74,12 @@ public:
     int  maxClients() const;
 
     /**
-     * Write data in native socket file descriptor.
+     * Write data in native socket file descriptor without blocking.
      * We need to use native low level socket to write data inside
      * from separated threads, as QTCPSocket only work with a single thread.
+     * Return the size of data written, 0 if the socket buffer is full, or -1 on error.
      */
-    int writeInSocket(int sock, const QByteArray& data) const;
+    int writeInSocket(int sock, const char* data, int size) const;
 
     /**
      * Return an human readable description of client connected through a socket.
@@ -93,11 +116,10 @@ public:
     QTcpServer*        server   = nullptr;  ///< main tcp/ip server.
     int                rate     = 15;       ///< stream frames rate per secs [1...30].
     int                delay    = 40000;    ///< delay between frames in us (1E6/rate).
-    QList<QTcpSocket*> clients;             ///< list of client connected sockets.
-    QByteArray         lastFrame;           ///< the current JPEG frame to dispatch to all connected clients.
+    QList<Client>      clients;             ///< list of client connected sockets.
+    MjpegFrameRing     frames;              ///< the last JPEG frames to dispatch to all connected clients.
     QFuture<void>      srvTask;             ///< server threaded task used to stream on clients.
     QMutex             mutexClients;        ///< to protect current clients list.
-    QMutex             mutexFrame;          ///< to protect current frame data.
     QStringList        blackList;           ///< Clients Ip address list to ban.
 
 private Q_SLOTS:
@@ -116,15 +138,17 @@ private:
 
     /**
      * Single thread method called to write data to all clients.
+     * The sockets are not blocking: the thread waits until a busy client
+     * can be written or a new frame is due. A client still busy sending
+     * a frame skips the next ones instead of delaying the others.
      */
     void writerThread();
 
     /**
-     * This method dispatch to all clients connected to a
-     * separated thread running on one available core automatically.
+     * Send the pending data of the client until the socket buffer is full.
      * This method is called through writerThread().
      */
-    void clientWriteMultithreaded(int client, const QByteArray& data);
+    void flushClient(Client& client);
 };
 
 } // namespace DigikamGenericMjpegStreamPlugin
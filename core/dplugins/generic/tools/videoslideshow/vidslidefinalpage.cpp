@@ -189,6 +189,17 @@ void VidSlideFinalPage::slotDone(bool completed)
         d->progressView->addEntry(i18n("Video Slideshow completed."),
                                   DHistoryView::ProgressEntry);
 
+        if (d->settings->encodingTime > 0)
+        {
+            const double seconds = d->settings->encodingTime / 1000.0;
+
+            d->progressView->addEntry(i18n("%1 frames encoded in %2 s (%3 frames/s)",
+                                           d->settings->framesCount,
+                                           QString::number(seconds, 'f', 1),
+                                           QString::number(d->settings->framesCount / seconds, 'f', 1)),
+                                      DHistoryView::ProgressEntry);
+        }
+
         if (d->settings->outputPlayer != VidSlideSettings::NOPLAYER)
         {
             d->progressView->addEntry(i18n("Opening video stream in player..."),
@@ -19,6 +19,7 @@
 #include <QString>
 #include <QLayout>
 #include <QIcon>
+#include <QTimer>
 
 // KDE includes
 
@@ -49,6 +50,9 @@ public:
     RawPreview*     previewWidget   = nullptr;
 
     DImg            postProcessedImage;
+
+    /// The full size image is decoded while the preview image is post-processed.
+    bool            pendingPreview  = false;
 };
 
 RawImport::RawImport(const QUrl& url, QObject* const parent)
@@ -129,7 +133,11 @@ DImg RawImport::postProcessedImage() const
 
 bool RawImport::hasPostProcessedImage() const
 {
-    return (!demosaicingSettingsDirty() && !d->postProcessedImage.isNull());
+    return (
+            !demosaicingSettingsDirty()                   &&
+            !d->postProcessedImage.isNull()               &&
+            !d->previewWidget->demosaicedImageIsPreview()
+           );
 }
 
 bool RawImport::demosaicingSettingsDirty() const
@@ -166,6 +174,7 @@ void RawImport::slotAbort()
 void RawImport::slotLoadingStarted()
 {
     d->postProcessedImage = DImg();
+    d->pendingPreview     = false;
     d->settingsBox->enableUpdateBtn(false);
     d->settingsBox->histogramBox()->histogram()->setDataLoading();
     d->settingsBox->curvesWidget()->setDataLoading();
@@ -176,6 +185,16 @@ void RawImport::slotLoadingStarted()
 void RawImport::slotDemosaicedImage()
 {
     d->settingsBox->setDemosaicedImage(d->previewWidget->demosaicedImage());
+
+    if (renderingMode() != EditorToolThreaded::NoneRendering)
+    {
+        // The half size preview is still post-processed: the full size image will be processed after.
+
+        d->pendingPreview = true;
+
+        return;
+    }
+
     slotPreview();
 }
 
@@ -197,6 +216,14 @@ void RawImport::setPreviewImage()
     d->settingsBox->setPostProcessedImage(d->postProcessedImage);
     EditorToolIface::editorToolIface()->setToolStopProgress();
     setBusy(false);
+
+    if (d->pendingPreview)
+    {
+        // Wait for the end of the current rendering.
+
+        d->pendingPreview = false;
+        QTimer::singleShot(0, this, SLOT(slotPreview()));
+    }
 }
 
 void RawImport::slotLoadingFailed()
@@ -29,6 +29,7 @@
 // Local includes
 
 #include "digikam_debug.h"
+#include "drawdecodersession.h"
 #include "managedloadsavethread.h"
 #include "editorcore.h"
 #include "previewlayout.h"
@@ -48,11 +49,19 @@ public:
     QUrl                   url;
 
     DImg                   demosaicedImg;
+    bool                   demosaicedIsPreview  = false;
 
     DRawDecoding           settings;
     ManagedLoadSaveThread* thread               = nullptr;
     LoadingDescription     loadingDesc;
+    LoadingDescription     previewDesc;
     ImagePreviewItem*      item                 = nullptr;
+
+    /**
+     * Keep the RAW data unpacked in memory while the tool is open,
+     * to only run the post-unpack stages when the settings change.
+     */
+    DRawDecoderSession*    session              = nullptr;
 };
 
 RawPreview::RawPreview(const QUrl& url, QWidget* const parent)
@@ -62,8 +71,9 @@ RawPreview::RawPreview(const QUrl& url, QWidget* const parent)
     d->item   = new ImagePreviewItem();
     setItem(d->item);
 
-    d->url    = url;
-    d->thread = new ManagedLoadSaveThread;
+    d->url     = url;
+    d->session = new DRawDecoderSession(url.toLocalFile());
+    d->thread  = new ManagedLoadSaveThread;
     d->thread->setLoadingPolicy(ManagedLoadSaveThread::LoadingPolicyFirstRemovePrevious);
 
     // ------------------------------------------------------------
@@ -89,6 +99,7 @@ RawPreview::RawPreview(const QUrl& url, QWidget* const parent)
 RawPreview::~RawPreview()
 {
     delete d->item;
+    delete d->session;
     delete d;
 }
 
@@ -107,6 +118,11 @@ DImg& RawPreview::demosaicedImage() const
     return d->demosaicedImg;
 }
 
+bool RawPreview::demosaicedImageIsPreview() const
+{
+    return d->demosaicedIsPreview;
+}
+
 void RawPreview::setDecodingSettings(const DRawDecoding& settings)
 {
     if ((d->settings == settings) && d->thread->isRunning())
@@ -124,7 +140,23 @@ void RawPreview::setDecodingSettings(const DRawDecoding& settings)
     demosaisedSettings.resetPostProcessingSettings();
 
     d->loadingDesc                  = LoadingDescription(d->url.toLocalFile(), demosaisedSettings);
-    d->thread->load(d->loadingDesc, ManagedLoadSaveThread::LoadingPolicyFirstRemovePrevious);
+
+    if (!demosaisedSettings.rawPrm.halfSizeColorImage)
+    {
+        // Show a fast half size preview first, the full size image is decoded next in background.
+
+        DRawDecoding previewSettings              = demosaisedSettings;
+        previewSettings.rawPrm.halfSizeColorImage = true;
+        d->previewDesc                            = LoadingDescription(d->url.toLocalFile(), previewSettings);
+
+        d->thread->load(d->previewDesc, ManagedLoadSaveThread::LoadingPolicyFirstRemovePrevious);
+        d->thread->load(d->loadingDesc, ManagedLoadSaveThread::LoadingPolicyAppend);
+    }
+    else
+    {
+        d->previewDesc = LoadingDescription();
+        d->thread->load(d->loadingDesc, ManagedLoadSaveThread::LoadingPolicyFirstRemovePrevious);
+    }
 
     Q_EMIT signalLoadingStarted();
 }
@@ -141,6 +173,11 @@ void RawPreview::ICCSettingsChanged()
 
 void RawPreview::cancelLoading()
 {
+    if (!d->previewDesc.filePath.isEmpty())
+    {
+        d->thread->stopLoading(d->previewDesc);
+    }
+
     d->thread->stopLoading(d->loadingDesc);
 }
 
@@ -181,7 +218,9 @@ void RawPreview::slotImageLoaded(const LoadingDescription& description, const DI
     }
     else
     {
-        d->demosaicedImg = image;
+        d->demosaicedImg       = image;
+        d->demosaicedIsPreview = (description.rawDecodingSettings.rawPrm.halfSizeColorImage !=
+                                  d->loadingDesc.rawDecodingSettings.rawPrm.halfSizeColorImage);
 
         Q_EMIT signalDemosaicedImage();
 
@@ -45,6 +45,12 @@ public:
     DImg& demosaicedImage()    const;
     DImg  postProcessedImage() const;
 
+    /**
+     * Return true if the demosaiced image is the half size preview decoded
+     * before the full size image.
+     */
+    bool  demosaicedImageIsPreview() const;
+
     void setDecodingSettings(const DRawDecoding& settings);
     void setPostProcessedImage(const DImg& image);
 
@@ -0,0 +1,351 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Linux inotify based directories watcher
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "albuminotifywatch.h"
+
+// C ANSI includes
+
+#ifdef Q_OS_LINUX
+#   include <sys/inotify.h>
+#   include <unistd.h>
+#   include <errno.h>
+#   include <string.h>
+#endif
+
+// Qt includes
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QtGlobal>
+#include <QSocketNotifier>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN AlbumInotifyWatch::Private
+{
+public:
+
+    class PendingMove
+    {
+    public:
+
+        QString path;
+        bool    isDir = false;
+    };
+
+public:
+
+    Private() = default;
+
+    void renameWatchedPaths(const QString& srcPath, const QString& dstPath);
+
+public:
+
+    int                         fd              = -1;
+    QSocketNotifier*            notifier        = nullptr;
+    bool                        limitReported   = false;
+
+    QHash<int, QString>         watchToPath;
+    QHash<QString, int>         pathToWatch;
+    QHash<quint32, PendingMove> pendingMoves;
+};
+
+void AlbumInotifyWatch::Private::renameWatchedPaths(const QString& srcPath, const QString& dstPath)
+{
+    // A watch follows the inode of the directory: update the paths of the moved
+    // directory and of its subdirectories.
+
+    const QString srcPrefix = srcPath + QLatin1Char('/');
+
+    for (QHash<int, QString>::iterator it = watchToPath.begin() ; it != watchToPath.end() ; ++it)
+    {
+        if ((it.value() == srcPath) || it.value().startsWith(srcPrefix))
+        {
+            pathToWatch.remove(it.value());
+            it.value() = dstPath + it.value().mid(srcPath.length());
+            pathToWatch.insert(it.value(), it.key());
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------
+
+AlbumInotifyWatch::AlbumInotifyWatch(QObject* const parent)
+    : QObject(parent),
+      d      (new Private)
+{
+
+#ifdef Q_OS_LINUX
+
+    d->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (d->fd == -1)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot initialize inotify:" << strerror(errno);
+
+        return;
+    }
+
+    d->notifier = new QSocketNotifier(d->fd, QSocketNotifier::Read, this);
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+
+    connect(d->notifier, SIGNAL(activated(QSocketDescriptor,QSocketNotifier::Type)),
+            this, SLOT(slotReadEvents()));
+
+#else
+
+    connect(d->notifier, SIGNAL(activated(int)),
+            this, SLOT(slotReadEvents()));
+
+#endif
+
+#endif
+
+}
+
+AlbumInotifyWatch::~AlbumInotifyWatch()
+{
+
+#ifdef Q_OS_LINUX
+
+    if (d->fd != -1)
+    {
+        delete d->notifier;
+        ::close(d->fd);
+    }
+
+#endif
+
+    delete d;
+}
+
+bool AlbumInotifyWatch::isValid() const
+{
+    return (d->fd != -1);
+}
+
+bool AlbumInotifyWatch::addPath(const QString& path)
+{
+    if (!isValid())
+    {
+        return false;
+    }
+
+    const QString dir = QDir::cleanPath(path);
+
+    if (d->pathToWatch.contains(dir))
+    {
+        return true;
+    }
+
+#ifdef Q_OS_LINUX
+
+    const int wd = inotify_add_watch(d->fd, QFile::encodeName(dir).constData(),
+                                     IN_CREATE      | IN_DELETE      |
+                                     IN_MOVED_FROM  | IN_MOVED_TO    |
+                                     IN_CLOSE_WRITE | IN_ONLYDIR);
+
+    if (wd == -1)
+    {
+        if ((errno == ENOSPC) && !d->limitReported)
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "The inotify watches limit is reached. "
+                                              "Increase the fs.inotify.max_user_watches kernel setting "
+                                              "to watch the whole collection with inotify.";
+
+            d->limitReported = true;
+        }
+
+        return false;
+    }
+
+    // The same directory can be watched with another path, through a symbolic link.
+
+    d->pathToWatch.remove(d->watchToPath.value(wd));
+    d->watchToPath.insert(wd, dir);
+    d->pathToWatch.insert(dir, wd);
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+
+}
+
+void AlbumInotifyWatch::removePath(const QString& path)
+{
+    const QString dir = QDir::cleanPath(path);
+    const int wd      = d->pathToWatch.value(dir, -1);
+
+    if (wd == -1)
+    {
+        return;
+    }
+
+#ifdef Q_OS_LINUX
+
+    inotify_rm_watch(d->fd, wd);
+
+#endif
+
+    d->pathToWatch.remove(dir);
+    d->watchToPath.remove(wd);
+}
+
+void AlbumInotifyWatch::clear()
+{
+    const QStringList dirs = directories();
+
+    for (const QString& dir : dirs)
+    {
+        removePath(dir);
+    }
+
+    d->pendingMoves.clear();
+}
+
+QStringList AlbumInotifyWatch::directories() const
+{
+    return d->pathToWatch.keys();
+}
+
+void AlbumInotifyWatch::slotReadEvents()
+{
+
+#ifdef Q_OS_LINUX
+
+    // The buffer is aligned as inotify_event, as required by the kernel interface.
+
+    alignas(struct inotify_event) char buffer[65536];
+    QStringList changedDirs;
+
+    Q_FOREVER
+    {
+        const ssize_t length = ::read(d->fd, buffer, sizeof(buffer));
+
+        if (length <= 0)
+        {
+            break;
+        }
+
+        for (char* ptr = buffer ; ptr < (buffer + length) ; )
+        {
+            const struct inotify_event* const event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr                                    += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                d->pendingMoves.clear();
+
+                Q_EMIT signalOverflow();
+
+                continue;
+            }
+
+            if (event->mask & IN_IGNORED)
+            {
+                // The directory was removed, or the watch was removed with removePath().
+
+                d->pathToWatch.remove(d->watchToPath.value(event->wd));
+                d->watchToPath.remove(event->wd);
+
+                continue;
+            }
+
+            const QString dir = d->watchToPath.value(event->wd);
+
+            if (dir.isEmpty() || !event->len)
+            {
+                continue;
+            }
+
+            const QString path = dir + QLatin1Char('/') + QFile::decodeName(event->name);
+            const bool isDir   = (event->mask & IN_ISDIR);
+
+            if      (event->mask & IN_CLOSE_WRITE)
+            {
+                Q_EMIT signalFileModified(path);
+            }
+            else if (event->mask & IN_MOVED_FROM)
+            {
+                Private::PendingMove move;
+                move.path  = path;
+                move.isDir = isDir;
+
+                d->pendingMoves.insert(event->cookie, move);
+            }
+            else if (event->mask & IN_MOVED_TO)
+            {
+                if (d->pendingMoves.contains(event->cookie))
+                {
+                    const Private::PendingMove move = d->pendingMoves.take(event->cookie);
+
+                    if (move.isDir)
+                    {
+                        d->renameWatchedPaths(move.path, path);
+                    }
+
+                    Q_EMIT signalMoved(move.path, path, isDir);
+                }
+                else if (!changedDirs.contains(dir))
+                {
+                    // Moved from outside of the watched directories: a new entry.
+
+                    changedDirs << dir;
+                }
+            }
+            else if (!changedDirs.contains(dir))
+            {
+                changedDirs << dir;
+            }
+        }
+    }
+
+    // The entries moved outside of the watched directories are removed entries.
+    // The kernel queues the two events of a move together, they are read in the same pass.
+
+    for (const Private::PendingMove& move : std::as_const(d->pendingMoves))
+    {
+        const QString dir = move.path.section(QLatin1Char('/'), 0, -2);
+
+        if (!changedDirs.contains(dir))
+        {
+            changedDirs << dir;
+        }
+    }
+
+    d->pendingMoves.clear();
+
+    for (const QString& dir : std::as_const(changedDirs))
+    {
+        Q_EMIT signalDirectoryChanged(dir);
+    }
+
+#endif
+
+}
+
+} // namespace Digikam
+
+#include "moc_albuminotifywatch.cpp"
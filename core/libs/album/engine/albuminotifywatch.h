@@ -0,0 +1,87 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Linux inotify based directories watcher
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+namespace Digikam
+{
+
+/**
+ * A directories watcher using the inotify interface of the Linux kernel.
+ * Unlike QFileSystemWatcher, it reports what changed in a directory:
+ * modified files and moved or renamed files and directories, which are
+ * converted to collection scanner hints by AlbumWatch.
+ * On other platforms, or if inotify cannot be initialized, isValid()
+ * returns false and the caller must use another watcher.
+ */
+class AlbumInotifyWatch : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit AlbumInotifyWatch(QObject* const parent = nullptr);
+    ~AlbumInotifyWatch() override;
+
+    bool isValid()                      const;
+
+    /**
+     * Watch the directory. Returns false if the directory cannot be watched,
+     * typically when the inotify watches limit of the user is reached.
+     */
+    bool addPath(const QString& dir);
+    void removePath(const QString& dir);
+    void clear();
+
+    QStringList directories()           const;
+
+Q_SIGNALS:
+
+    /**
+     * An entry was created or removed in the directory.
+     */
+    void signalDirectoryChanged(const QString& dir);
+
+    /**
+     * A file was closed after writing.
+     */
+    void signalFileModified(const QString& filePath);
+
+    /**
+     * A file or a directory was moved or renamed between watched directories.
+     */
+    void signalMoved(const QString& srcPath, const QString& dstPath, bool isDir);
+
+    /**
+     * The kernel event queue overflowed: events were lost.
+     */
+    void signalOverflow();
+
+private Q_SLOTS:
+
+    void slotReadEvents();
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+};
+
+} // namespace Digikam
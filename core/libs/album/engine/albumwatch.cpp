@@ -21,16 +21,23 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QDir>
+#include <QSet>
+#include <QTimer>
 
 // Local includes
 
 #include "digikam_debug.h"
 #include "album.h"
 #include "albummanager.h"
+#include "albuminotifywatch.h"
 #include "collectionlocation.h"
 #include "collectionmanager.h"
 #include "dbengineparameters.h"
 #include "applicationsettings.h"
+#include "coredb.h"
+#include "coredbaccess.h"
+#include "coredbtransaction.h"
+#include "iteminfo.h"
 #include "scancontroller.h"
 #include "dio.h"
 
@@ -49,11 +56,21 @@ public:
 
 public:
 
-    QFileSystemWatcher* dirWatch = nullptr;
+    QFileSystemWatcher* dirWatch     = nullptr;
+    AlbumInotifyWatch*  inotifyWatch = nullptr;
 
     DbEngineParameters  params;
     QStringList         fileNameBlackList;
     QList<QDateTime>    dbPathModificationDateList;
+
+    /**
+     * Changes are collected and handled together when the timer fires,
+     * so that the database is not queried for each file system event.
+     */
+    QTimer*                         pendingTimer = nullptr;
+    QSet<QString>                   pendingDirs;
+    QSet<QString>                   pendingModifiedFiles;
+    QList<QPair<QString, QString> > pendingItemMoves;
 };
 
 bool AlbumWatch::Private::inBlackList(const QString& path) const
@@ -146,11 +163,46 @@ AlbumWatch::AlbumWatch(AlbumManager* const parent)
     : QObject(parent),
       d      (new Private)
 {
-    d->dirWatch = new QFileSystemWatcher(this);
+    d->dirWatch     = new QFileSystemWatcher(this);
+
+    d->pendingTimer = new QTimer(this);
+    d->pendingTimer->setSingleShot(true);
+    d->pendingTimer->setInterval(500);
+
+    connect(d->pendingTimer, SIGNAL(timeout()),
+            this, SLOT(slotProcessPendingChanges()));
 
     if (ApplicationSettings::instance()->getAlbumMonitoring())
     {
-        qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use QFileSystemWatcher";
+        // On Linux, inotify reports which files were modified or moved, which are
+        // recorded as scanner hints. QFileSystemWatcher remains the fallback for the
+        // other platforms and for the directories over the inotify watches limit.
+
+        d->inotifyWatch = new AlbumInotifyWatch(this);
+
+        if (d->inotifyWatch->isValid())
+        {
+            qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use inotify";
+
+            connect(d->inotifyWatch, SIGNAL(signalDirectoryChanged(QString)),
+                    this, SLOT(slotQFSWatcherDirty(QString)));
+
+            connect(d->inotifyWatch, SIGNAL(signalFileModified(QString)),
+                    this, SLOT(slotInotifyFileModified(QString)));
+
+            connect(d->inotifyWatch, SIGNAL(signalMoved(QString,QString,bool)),
+                    this, SLOT(slotInotifyMoved(QString,QString,bool)));
+
+            connect(d->inotifyWatch, SIGNAL(signalOverflow()),
+                    this, SLOT(slotInotifyOverflow()));
+        }
+        else
+        {
+            delete d->inotifyWatch;
+            d->inotifyWatch = nullptr;
+
+            qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use QFileSystemWatcher";
+        }
 
         connect(d->dirWatch, SIGNAL(directoryChanged(QString)),
                 this, SLOT(slotQFSWatcherDirty(QString)));
@@ -187,11 +239,29 @@ void AlbumWatch::clear()
     {
         d->dirWatch->removePaths(d->dirWatch->directories());
     }
+
+    if (d->inotifyWatch)
+    {
+        d->inotifyWatch->clear();
+    }
+
+    // The pending changes are not scanned, but their albums must be rescanned at next startup.
+
+    d->pendingTimer->stop();
+
+    if (!d->pendingDirs.isEmpty())
+    {
+        invalidateScanJournal(d->pendingDirs);
+    }
+
+    d->pendingDirs.clear();
+    d->pendingModifiedFiles.clear();
+    d->pendingItemMoves.clear();
 }
 
 void AlbumWatch::removeWatchedPAlbums(const PAlbum* const album)
 {
-    if (!album || d->dirWatch->directories().isEmpty())
+    if (!album)
     {
         return;
     }
@@ -205,6 +275,19 @@ void AlbumWatch::removeWatchedPAlbums(const PAlbum* const album)
             d->dirWatch->removePath(dir);
         }
     }
+
+    if (d->inotifyWatch)
+    {
+        const auto inotifyDirs = d->inotifyWatch->directories();
+
+        for (const QString& dir : inotifyDirs)
+        {
+            if (dir.startsWith(QDir::cleanPath(album->folderPath())))
+            {
+                d->inotifyWatch->removePath(dir);
+            }
+        }
+    }
 }
 
 void AlbumWatch::setDbEngineParameters(const DbEngineParameters& params)
@@ -254,7 +337,10 @@ void AlbumWatch::slotAlbumAdded(Album* a)
         return;
     }
 
-    d->dirWatch->addPath(dir);
+    if (!d->inotifyWatch || !d->inotifyWatch->addPath(dir))
+    {
+        d->dirWatch->addPath(dir);
+    }
 }
 
 void AlbumWatch::slotAlbumAboutToBeDeleted(Album* a)
@@ -273,6 +359,11 @@ void AlbumWatch::slotAlbumAboutToBeDeleted(Album* a)
     }
 
     d->dirWatch->removePath(dir);
+
+    if (d->inotifyWatch)
+    {
+        d->inotifyWatch->removePath(dir);
+    }
 }
 
 void AlbumWatch::rescanDirectory(const QString& dir)
@@ -282,9 +373,85 @@ void AlbumWatch::rescanDirectory(const QString& dir)
         return;
     }
 
-    qCDebug(DIGIKAM_GENERAL_LOG) << "Detected change, triggering rescan of" << dir;
+    d->pendingDirs << dir;
 
-    ScanController::instance()->scheduleCollectionScanExternal(dir);
+    if (!d->pendingTimer->isActive())
+    {
+        d->pendingTimer->start();
+    }
+}
+
+void AlbumWatch::slotProcessPendingChanges()
+{
+    const QSet<QString> dirs                        = d->pendingDirs;
+    const QSet<QString> modifiedFiles               = d->pendingModifiedFiles;
+    const QList<QPair<QString, QString> > itemMoves = d->pendingItemMoves;
+    d->pendingDirs.clear();
+    d->pendingModifiedFiles.clear();
+    d->pendingItemMoves.clear();
+
+    // The hints must be recorded before the scan is scheduled.
+
+    for (const QString& filePath : modifiedFiles)
+    {
+        // The modification date of a file written in place can stay the same
+        // (same second, or restored by the writer): force the scanner to check it.
+
+        ItemInfo info = ItemInfo::fromLocalFile(filePath);
+
+        if (!info.isNull())
+        {
+            ScanController::instance()->hintAtModificationOfItem(info.id());
+        }
+    }
+
+    for (const auto& move : itemMoves)
+    {
+        ItemInfo info           = ItemInfo::fromLocalFile(move.first);
+        PAlbum* const dstAlbum  = AlbumManager::instance()->findPAlbum(QUrl::fromLocalFile(QFileInfo(move.second).path()));
+
+        if (!info.isNull() && dstAlbum)
+        {
+            ScanController::instance()->hintAtMoveOrCopyOfItem(info.id(), dstAlbum, QFileInfo(move.second).fileName());
+        }
+    }
+
+    invalidateScanJournal(dirs);
+
+    for (const QString& dir : dirs)
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Detected change, triggering rescan of" << dir;
+
+        ScanController::instance()->scheduleCollectionScanExternal(dir);
+    }
+}
+
+void AlbumWatch::invalidateScanJournal(const QSet<QString>& dirs)
+{
+    // The scan is delayed: if digiKam is closed before, the next fast scan
+    // at startup must rescan the album, even if the directory fingerprint
+    // did not change, as when a file is modified in place.
+
+    CoreDbAccess access;
+    CoreDbTransaction transaction(&access);
+
+    for (const QString& dir : dirs)
+    {
+        CollectionLocation location = CollectionManager::instance()->locationForPath(dir);
+
+        if (location.isNull())
+        {
+            continue;
+        }
+
+        const QString album = CollectionManager::instance()->album(location, dir);
+        const int albumID   = access.db()->getAlbumForPath(location.id(), album, false);
+
+        if (albumID != -1)
+        {
+            access.db()->clearAlbumScanJournal(albumID);
+        }
+    }
 }
 
 void AlbumWatch::slotQFSWatcherDirty(const QString& path)
@@ -311,6 +478,67 @@ void AlbumWatch::slotQFSWatcherDirty(const QString& path)
     }
 }
 
+void AlbumWatch::slotInotifyFileModified(const QString& filePath)
+{
+    if (d->inBlackList(filePath) || DIO::itemsUnderProcessing())
+    {
+        return;
+    }
+
+    d->pendingModifiedFiles << filePath;
+
+    rescanDirectory(QFileInfo(filePath).path());
+}
+
+void AlbumWatch::slotInotifyMoved(const QString& srcPath, const QString& dstPath, bool isDir)
+{
+    if (DIO::itemsUnderProcessing())
+    {
+        return;
+    }
+
+    const QString srcDir = QFileInfo(srcPath).path();
+    const QString dstDir = QFileInfo(dstPath).path();
+
+    // Record the move as a hint, so that the scanner renames the album or the items
+    // in the database, and keeps their properties, instead of removing and adding them.
+
+    if (isDir)
+    {
+        PAlbum* const album = AlbumManager::instance()->findPAlbum(QUrl::fromLocalFile(srcPath));
+
+        if (album)
+        {
+            ScanController::instance()->hintAtMoveOrCopyOfAlbum(album, dstDir, QFileInfo(dstPath).fileName());
+        }
+    }
+    else
+    {
+        d->pendingItemMoves << qMakePair(srcPath, dstPath);
+    }
+
+    rescanDirectory(srcDir);
+
+    if (dstDir != srcDir)
+    {
+        rescanDirectory(dstDir);
+    }
+}
+
+void AlbumWatch::slotInotifyOverflow()
+{
+    // Events were lost: rescan the whole collection.
+
+    qCWarning(DIGIKAM_GENERAL_LOG) << "Inotify event queue overflow, triggering rescan of the collection";
+
+    const QList<CollectionLocation> locations = CollectionManager::instance()->allAvailableLocations();
+
+    for (const CollectionLocation& location : locations)
+    {
+        ScanController::instance()->scheduleCollectionScanExternal(location.albumRootPath());
+    }
+}
+
 } // namespace Digikam
 
 #include "moc_albumwatch.cpp"
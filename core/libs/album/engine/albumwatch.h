@@ -18,6 +18,7 @@
 // Qt includes
 
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QUrl>
 
@@ -47,10 +48,15 @@ protected Q_SLOTS:
     void slotAlbumAdded(Album* album);
     void slotAlbumAboutToBeDeleted(Album* album);
     void slotQFSWatcherDirty(const QString& path);
+    void slotInotifyFileModified(const QString& filePath);
+    void slotInotifyMoved(const QString& srcPath, const QString& dstPath, bool isDir);
+    void slotInotifyOverflow();
+    void slotProcessPendingChanges();
 
 private:
 
     void rescanDirectory(const QString& dir);
+    void invalidateScanJournal(const QSet<QString>& dirs);
 
 private:
 
@@ -426,6 +426,20 @@ bool AlbumManager::setDatabase(const DbEngineParameters& params, bool priority,
     ThumbnailLoadThread::initializeThumbnailDatabase(CoreDbAccess::parameters().thumbnailParameters(),
                                                      new ThumbsDbInfoProvider());
 
+    // The thumbnails pack file is an opt-in alternative storage to the thumbnails database,
+    // in the cache directory. The database stays initialized for the other tools.
+
+    if (qEnvironmentVariableIntValue("DIGIKAM_THUMBNAILS_PACK") > 0)
+    {
+        const QString packPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                                 QLatin1String("/thumbnails-pack");
+
+        if (!ThumbnailLoadThread::initializeThumbnailPackFile(packPath))
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot use thumbnails pack file in" << packPath;
+        }
+    }
+
     DbEngineGuiErrorHandler* const thumbnailsDBHandler = new DbEngineGuiErrorHandler(ThumbsDbAccess::parameters());
     ThumbsDbAccess::initDbEngineErrorHandler(thumbnailsDBHandler);
 
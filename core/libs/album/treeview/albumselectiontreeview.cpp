@@ -299,6 +299,7 @@ void AlbumSelectionTreeView::slotScanForFaces()
 
     settings.accuracy               = ApplicationSettings::instance()->getFaceDetectionAccuracy();
     settings.useYoloV3              = ApplicationSettings::instance()->getFaceDetectionYoloV3();
+    settings.useReducedSize         = ApplicationSettings::instance()->getFaceDetectionReducedSize();
     settings.task                   = FaceScanSettings::DetectAndRecognize;
     settings.alreadyScannedHandling = FaceScanSettings::Rescan;
     settings.albums                 = albums;
@@ -42,6 +42,76 @@ bool s_modificationDateEquals(const QDateTime& a, const QDateTime& b)
     return true;
 }
 
+bool s_statDirectory(const QString& path, QDateTime& modified, QString& fingerprint)
+{
+
+#ifdef Q_OS_UNIX
+
+    // The inode identifies the directory even when it is replaced by another one
+    // with the same name. The modification time changes when an entry is created,
+    // removed or renamed in the directory, and is used with its full resolution.
+    // The device number is not used: it is not stable for removable and network
+    // file systems, which are mounted again with another number.
+
+    QT_STATBUF st;
+
+    if ((QT_STAT(QFile::encodeName(path).constData(), &st) != 0) || !S_ISDIR(st.st_mode))
+    {
+        return false;
+    }
+
+#   if defined(Q_OS_LINUX)
+
+    const qint64 nsecs = st.st_mtim.tv_nsec;
+
+#   elif defined(Q_OS_MACOS) || defined(Q_OS_FREEBSD) || defined(Q_OS_OPENBSD) || defined(Q_OS_NETBSD)
+
+    const qint64 nsecs = st.st_mtimespec.tv_nsec;
+
+#   else
+
+    const qint64 nsecs = 0;
+
+#   endif
+
+    modified    = QDateTime::fromMSecsSinceEpoch((qint64)st.st_mtime * 1000 + nsecs / 1000000, Qt::UTC);
+    fingerprint = QString::fromLatin1("%1:%2.%3")
+                  .arg((quint64)st.st_ino)
+                  .arg((qint64)st.st_mtime)
+                  .arg(nsecs, 9, 10, QLatin1Char('0'));
+
+#else
+
+    // Without inode, the modification time alone is used.
+
+    QFileInfo info(path);
+
+    if (!info.isDir())
+    {
+        return false;
+    }
+
+    modified    = asDateTimeUTC(info.lastModified());
+    fingerprint = QString::number(modified.toMSecsSinceEpoch());
+
+#endif
+
+    return true;
+}
+
+bool s_albumScanJournalEquals(const QString& fingerprint, const QString& journalFingerprint,
+                              const QDateTime& modified, const QDateTime& journalModified)
+{
+    // Albums scanned before the scan journal was introduced only have a modification date.
+
+    if (journalFingerprint.isEmpty())
+    {
+        return s_modificationDateEquals(modified, journalModified);
+    }
+
+    return (fingerprint == journalFingerprint);
+}
+
 // --------------------------------------------------------------------
 
 NewlyAppearedFile::NewlyAppearedFile(int albumId, const QString& fileName)
@@ -30,6 +30,7 @@
 // Qt includes
 
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QDirIterator>
 #include <QWriteLocker>
@@ -39,6 +40,7 @@
 #include <QSet>
 #include <QElapsedTimer>
 #include <QScopedPointer>
+#include <qplatformdefs.h>
 
 // Local includes
 
@@ -67,6 +69,21 @@ namespace Digikam
 
 bool s_modificationDateEquals(const QDateTime& a, const QDateTime& b);
 
+/**
+ * Reads the status of a directory with a single system call: its modification date, and its
+ * scan journal fingerprint made of the inode and the modification time in nanoseconds, or of
+ * the modification time alone where there is no inode. Returns false if the path cannot be
+ * accessed or is not a directory.
+ */
+bool s_statDirectory(const QString& path, QDateTime& modified, QString& fingerprint);
+
+/**
+ * Returns true if an album directory did not change since the last scan recorded in the journal.
+ * Without fingerprint in the journal, the modification dates are compared.
+ */
+bool s_albumScanJournalEquals(const QString& fingerprint, const QString& journalFingerprint,
+                              const QDateTime& modified, const QDateTime& journalModified);
+
 // --------------------------------------------------------------------
 
 class Q_DECL_HIDDEN NewlyAppearedFile
@@ -170,6 +187,7 @@ public:
     QSet<QString>                                 deferredAlbumPaths;
 
     QHash<QString, QDateTime>                     albumDateCache;
+    QHash<QString, QString>                       albumFingerprintCache;
     QList<qlonglong>                              newIdsList;
 
     CollectionScannerObserver*                    observer                  = nullptr;
@@ -476,25 +476,38 @@ void CollectionScanner::scanAlbumRoot(const CollectionLocation& location)
 
     if (!useFastScan || !d->performFastScan || pathDateMap.isEmpty())
     {
+        // Full scan, which also fills the scan journal.
+
         scanAlbum(location, QLatin1String("/"));
     }
     else
     {
+        // Incremental scan: only the albums with a fingerprint different
+        // from the scan journal are scanned.
+
+        const QMap<QString, QString>& pathFingerprintMap = CoreDbAccess().db()->
+                                                           getAlbumScanFingerprintMap(location.id());
+
         for (it = pathDateMap.constBegin() ; it != pathDateMap.constEnd() ; ++it)
         {
             QDateTime modified;
+            QString   fingerprint;
             QString   folder(location.albumRootPath() + it.key());
 
+            // The status of the directory is usually cached by scanForStaleAlbums().
+
             if (d->albumDateCache.contains(folder))
             {
-                modified = d->albumDateCache.value(folder);
+                modified    = d->albumDateCache.value(folder);
+                fingerprint = d->albumFingerprintCache.value(folder);
             }
             else
             {
-                modified = asDateTimeUTC(QFileInfo(folder).lastModified());
+                s_statDirectory(folder, modified, fingerprint);
             }
 
-            if (s_modificationDateEquals(modified, it.value()))
+            if (s_albumScanJournalEquals(fingerprint, pathFingerprintMap.value(it.key()),
+                                         modified, it.value()))
             {
                 int albumID = CoreDbAccess().db()->getAlbumForPath(location.id(), it.key(), false);
                 int counter = CoreDbAccess().db()->getNumberOfItemsInAlbum(albumID);
@@ -571,8 +584,12 @@ void CollectionScanner::scanForStaleAlbums(const QList<int>& locationIdsToScan)
 
         if (location.isAvailable())
         {
+            // One stat of the directory, its status is cached for the fast scan.
+
             QFileInfo fileInfo(location.albumRootPath() + (*it3).relativePath);
-            bool dirExist = (fileInfo.exists() && fileInfo.isDir());
+            QDateTime dateTime;
+            QString   fingerprint;
+            bool dirExist = s_statDirectory(fileInfo.filePath(), dateTime, fingerprint);
 
             if (location.asQtCaseSensitivity() == Qt::CaseInsensitive)
             {
@@ -599,8 +616,8 @@ void CollectionScanner::scanForStaleAlbums(const QList<int>& locationIdsToScan)
             }
             else
             {
-                QDateTime dateTime = asDateTimeUTC(fileInfo.lastModified());
                 d->albumDateCache.insert(fileInfo.filePath(), dateTime);
+                d->albumFingerprintCache.insert(fileInfo.filePath(), fingerprint);
             }
         }
     }
@@ -714,10 +731,14 @@ void CollectionScanner::scanAlbum(const CollectionLocation& location, const QStr
     }
 
     int albumID                          = checkAlbum(location, album);
-    QDateTime albumDateTime              = asDateTimeUTC(QFileInfo(dir.path()).lastModified());
+    QDateTime albumDateTime;
+    QString albumFingerprint;
+    s_statDirectory(dir.path(), albumDateTime, albumFingerprint);
     QDateTime albumModified              = CoreDbAccess().db()->getAlbumModificationDate(albumID);
+    QString albumJournalFingerprint      = CoreDbAccess().db()->getAlbumScanFingerprint(albumID);
 
-    if (checkDate && s_modificationDateEquals(albumDateTime, albumModified))
+    if (checkDate && s_albumScanJournalEquals(albumFingerprint, albumJournalFingerprint,
+                                              albumDateTime, albumModified))
     {
         // mark album as scanned
 
@@ -909,9 +930,20 @@ void CollectionScanner::scanAlbum(const CollectionLocation& location, const QStr
         }
     }
 
-    if (!d->deferredFileScanning && !s_modificationDateEquals(albumDateTime, albumModified))
+    if (!d->deferredFileScanning)
     {
-        CoreDbAccess().db()->setAlbumModificationDate(albumID, albumDateTime);
+        // Update the scan journal. The fingerprint was taken before listing the directory:
+        // a change done while scanning will be detected by the next fast scan.
+
+        if (!s_modificationDateEquals(albumDateTime, albumModified))
+        {
+            CoreDbAccess().db()->setAlbumModificationDate(albumID, albumDateTime);
+        }
+
+        if (albumFingerprint != albumJournalFingerprint)
+        {
+            CoreDbAccess().db()->setAlbumScanFingerprint(albumID, albumFingerprint);
+        }
     }
 
     if (updateAlbumDate)
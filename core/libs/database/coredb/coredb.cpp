@@ -53,6 +53,19 @@ public:
 
     QString constructRelatedImagesSQL(bool fromOrTo, DatabaseRelation::Type type, bool boolean);
     QList<qlonglong> execRelatedImagesQuery(DbEngineSqlQuery& query, qlonglong id, DatabaseRelation::Type type);
+
+    /**
+     * Split the ids in chunks of comma separated integers, to be inlined in a statement:
+     * the count of bound values is not limited by the database backend.
+     */
+    static QStringList idChunks(const QList<qlonglong>& ids);
+
+    /**
+     * Read the fields of the items from the table, with one query per chunk of items.
+     * Each row starts with the id of the item.
+     */
+    QVariantList execItemsFieldsQuery(const QString& table, const QString& idField,
+                                      const QStringList& fieldNames, const QList<qlonglong>& ids);
 };
 
 QString CoreDB::Private::constructRelatedImagesSQL(bool fromOrTo, DatabaseRelation::Type type, bool boolean)
@@ -121,6 +134,49 @@ QList<qlonglong> CoreDB::Private::execRelatedImagesQuery(DbEngineSqlQuery& query
     return imageIds;
 }
 
+QStringList CoreDB::Private::idChunks(const QList<qlonglong>& ids)
+{
+    const int chunkSize = 5000;
+    QStringList chunks;
+
+    for (int i = 0 ; i < ids.size() ; i += chunkSize)
+    {
+        QStringList chunk;
+
+        for (int j = i ; j < qMin(i + chunkSize, ids.size()) ; ++j)
+        {
+            chunk << QString::number(ids.at(j));
+        }
+
+        chunks << chunk.join(QLatin1Char(','));
+    }
+
+    return chunks;
+}
+
+QVariantList CoreDB::Private::execItemsFieldsQuery(const QString& table, const QString& idField,
+                                                   const QStringList& fieldNames, const QList<qlonglong>& ids)
+{
+    QVariantList values;
+    const QStringList chunks = idChunks(ids);
+
+    for (const QString& chunk : chunks)
+    {
+        QString query = QString::fromUtf8("SELECT %1, %2 FROM %3 WHERE %1 IN (%4);")
+                        .arg(idField, fieldNames.join(QString::fromUtf8(", ")), table, chunk);
+
+        QVariantList rows;
+        db->execSql(query, &rows);
+
+        if ((rows.size() % (fieldNames.size() + 1)) == 0)
+        {
+            values << rows;
+        }
+    }
+
+    return values;
+}
+
 // --------------------------------------------------------
 
 CoreDB::CoreDB(CoreDbBackend* const backend)
@@ -449,6 +505,18 @@ void CoreDB::setAlbumModificationDate(int albumID, const QDateTime& modification
                    asDateTimeLocal(modificationDate), albumID);
 }
 
+void CoreDB::setAlbumScanFingerprint(int albumID, const QString& fingerprint)
+{
+    d->db->execSql(QString::fromUtf8("UPDATE Albums SET scanFingerprint=? WHERE id=?;"),
+                   fingerprint.isEmpty() ? QVariant() : QVariant(fingerprint), albumID);
+}
+
+void CoreDB::clearAlbumScanJournal(int albumID)
+{
+    d->db->execSql(QString::fromUtf8("UPDATE Albums SET modificationDate=NULL, scanFingerprint=NULL WHERE id=?;"),
+                   albumID);
+}
+
 void CoreDB::setAlbumIcon(int albumID, qlonglong iconID)
 {
     if (iconID == 0)
@@ -1538,6 +1606,116 @@ QVariantList CoreDB::getItemInformation(qlonglong imageID, DatabaseFields::ItemI
     return values;
 }
 
+QVariantList CoreDB::getImagesFields(const QList<qlonglong>& imageIDs, DatabaseFields::Images fields) const
+{
+    QVariantList values;
+
+    if (fields == DatabaseFields::ImagesNone)
+    {
+        return values;
+    }
+
+    QStringList fieldNames = imagesFieldList(fields);
+    values                 = d->execItemsFieldsQuery(QLatin1String("Images"), QLatin1String("id"),
+                                                     fieldNames, imageIDs);
+
+    // Convert date times to QDateTime, they come as QString
+
+    if ((fields & DatabaseFields::ModificationDate))
+    {
+        const int index = fieldNames.indexOf(QLatin1String("modificationDate")) + 1;
+
+        for (int row = 0 ; row < values.size() ; row += fieldNames.size() + 1)
+        {
+            values[row + index] = QVariant(asDateTimeUTC(values.at(row + index).toDateTime()));
+        }
+    }
+
+    return values;
+}
+
+QVariantList CoreDB::getItemInformation(const QList<qlonglong>& imageIDs, DatabaseFields::ItemInformation fields) const
+{
+    QVariantList values;
+
+    if (fields == DatabaseFields::ItemInformationNone)
+    {
+        return values;
+    }
+
+    QStringList fieldNames = imageInformationFieldList(fields);
+    values                 = d->execItemsFieldsQuery(QLatin1String("ImageInformation"), QLatin1String("imageid"),
+                                                     fieldNames, imageIDs);
+
+    // Convert date times to QDateTime, they come as QString
+
+    QList<int> dateIndexes;
+
+    if ((fields & DatabaseFields::CreationDate))
+    {
+        dateIndexes << fieldNames.indexOf(QLatin1String("creationDate")) + 1;
+    }
+
+    if ((fields & DatabaseFields::DigitizationDate))
+    {
+        dateIndexes << fieldNames.indexOf(QLatin1String("digitizationDate")) + 1;
+    }
+
+    for (int row = 0 ; row < values.size() ; row += fieldNames.size() + 1)
+    {
+        for (const int index : std::as_const(dateIndexes))
+        {
+            values[row + index] = QVariant(asDateTimeUTC(values.at(row + index).toDateTime()));
+        }
+    }
+
+    return values;
+}
+
+QVariantList CoreDB::getItemSortKeys(const QList<qlonglong>& imageIDs) const
+{
+    const int fieldCount     = 15;
+    const QStringList chunks = Private::idChunks(imageIDs);
+    QVariantList values;
+
+    for (const QString& ids : chunks)
+    {
+        QString query = QString::fromUtf8("SELECT Images.id, Images.album, Albums.albumRoot, Albums.relativePath, "
+                                          "Images.name, Images.category, Images.modificationDate, "
+                                          "Images.fileSize, Images.manualOrder, "
+                                          "ImageInformation.rating, ImageInformation.creationDate, "
+                                          "ImageInformation.width, ImageInformation.height, ImageInformation.format, "
+                                          " (SELECT object FROM ImageRelations "
+                                          "  INNER JOIN Images AS Leaders ON ImageRelations.object=Leaders.id "
+                                          "  WHERE ImageRelations.subject=Images.id AND ImageRelations.type=? "
+                                          "  AND Leaders.status<3 LIMIT 1) "
+                                          "FROM Images "
+                                          "LEFT JOIN Albums ON Images.album=Albums.id "
+                                          "LEFT JOIN ImageInformation ON Images.id=ImageInformation.imageid "
+                                          "WHERE Images.id IN (%1);").arg(ids);
+
+        QVariantList chunk;
+        d->db->execSql(query, (int)DatabaseRelation::Grouped, &chunk);
+
+        if ((chunk.size() % fieldCount) != 0)
+        {
+            continue;
+        }
+
+        // Convert date times to QDateTime, they come as QString
+
+        for (int row = 0 ; row < chunk.size() ; row += fieldCount)
+        {
+            chunk[row + 6]  = QVariant(asDateTimeUTC(chunk.at(row + 6).toDateTime()));
+            chunk[row + 10] = QVariant(asDateTimeUTC(chunk.at(row + 10).toDateTime()));
+        }
+
+        values << chunk;
+    }
+
+    return values;
+}
+
 QVariantList CoreDB::getImageMetadata(qlonglong imageID, DatabaseFields::ImageMetadata fields) const
 {
     QVariantList values;
@@ -1706,6 +1884,52 @@ QVariantList CoreDB::getItemPositions(const QList<qlonglong>& imageIDs, Database
     return values;
 }
 
+QVariantList CoreDB::getItemsPositions(const QList<qlonglong>& imageIDs, DatabaseFields::ItemPositions fields) const
+{
+    QVariantList values;
+
+    if (fields == DatabaseFields::ItemPositionsNone)
+    {
+        return values;
+    }
+
+    QStringList fieldNames = imagePositionsFieldList(fields);
+    values                 = d->execItemsFieldsQuery(QLatin1String("ImagePositions"), QLatin1String("imageid"),
+                                                     fieldNames, imageIDs);
+
+    // For some reason REAL values may come as QString QVariants. Convert here.
+
+    const QStringList realFields = QStringList() << QLatin1String("latitudeNumber")
+                                                 << QLatin1String("longitudeNumber")
+                                                 << QLatin1String("altitude")
+                                                 << QLatin1String("orientation")
+                                                 << QLatin1String("tilt")
+                                                 << QLatin1String("roll")
+                                                 << QLatin1String("accuracy");
+    QList<int> realIndexes;
+
+    for (int i = 0 ; i < fieldNames.size() ; ++i)
+    {
+        if (realFields.contains(fieldNames.at(i)))
+        {
+            realIndexes << i + 1;
+        }
+    }
+
+    for (int row = 0 ; row < values.size() ; row += fieldNames.size() + 1)
+    {
+        for (const int index : std::as_const(realIndexes))
+        {
+            if (!values.at(row + index).isNull())
+            {
+                values[row + index] = values.at(row + index).toDouble();
+            }
+        }
+    }
+
+    return values;
+}
+
 void CoreDB::addItemInformation(qlonglong imageID, const QVariantList& infos,
                                 DatabaseFields::ItemInformation fields)
 {
@@ -1974,6 +2198,49 @@ QList<CommentInfo> CoreDB::getItemComments(qlonglong imageID) const
     return list;
 }
 
+QList<CommentInfo> CoreDB::getItemComments(const QList<qlonglong>& imageIDs) const
+{
+    QList<CommentInfo> list;
+    const QStringList chunks = Private::idChunks(imageIDs);
+
+    for (const QString& ids : chunks)
+    {
+        QList<QVariant> values;
+        d->db->execSql(QString::fromUtf8("SELECT imageid, id, type, language, author, date, comment "
+                                         "FROM ImageComments WHERE imageid IN (%1);").arg(ids),
+                       &values);
+
+        if ((values.size() % 7) != 0)
+        {
+            continue;
+        }
+
+        for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ; )
+        {
+            CommentInfo info;
+
+            info.imageId  = (*it).toLongLong();
+            ++it;
+            info.id       = (*it).toInt();
+            ++it;
+            info.type     = (DatabaseComment::Type)(*it).toInt();
+            ++it;
+            info.language = (*it).toString();
+            ++it;
+            info.author   = (*it).toString();
+            ++it;
+            info.date     = asDateTimeUTC((*it).toDateTime());
+            ++it;
+            info.comment  = (*it).toString();
+            ++it;
+
+            list << info;
+        }
+    }
+
+    return list;
+}
+
 int CoreDB::setImageComment(qlonglong imageID, const QString& comment, DatabaseComment::Type type,
                             const QString& language, const QString& author, const QDateTime& date) const
 {
@@ -3421,6 +3688,44 @@ QMap<QString, QDateTime> CoreDB::getAlbumModificationMap(int albumRootId) const
 
 }
 
+QString CoreDB::getAlbumScanFingerprint(int albumID) const
+{
+    QVariantList values;
+
+    d->db->execSql(QString::fromUtf8("SELECT scanFingerprint FROM Albums "
+                                     " WHERE id=?;"),
+                   albumID, &values);
+
+    if (values.isEmpty())
+    {
+        return QString();
+    }
+
+    return values.first().toString();
+}
+
+QMap<QString, QString> CoreDB::getAlbumScanFingerprintMap(int albumRootId) const
+{
+    QList<QVariant> values;
+    QMap<QString, QString> pathFingerprintMap;
+
+    d->db->execSql(QString::fromUtf8("SELECT relativePath, scanFingerprint FROM Albums "
+                                     " WHERE albumRoot=?;"),
+                   albumRootId, &values);
+
+    for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ; )
+    {
+        QString relativePath = (*it).toString();
+        ++it;
+        QString fingerprint  = (*it).toString();
+        ++it;
+
+        pathFingerprintMap.insert(relativePath, fingerprint);
+    }
+
+    return pathFingerprintMap;
+}
+
 QPair<int, int> CoreDB::getNumberOfAllItemsAndAlbums(int albumID) const
 {
     int items    = 0;
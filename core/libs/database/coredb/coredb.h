@@ -306,6 +306,23 @@ public:
      */
     void setAlbumModificationDate(int albumID, const QDateTime& modificationDate);
 
+    /**
+     * Set the scan journal fingerprint of the album directory,
+     * as computed by the collection scanner. A null string clears
+     * the fingerprint and forces the next fast scan to rescan the album.
+     * @param albumID     the id of the album
+     * @param fingerprint the fingerprint of the album directory
+     */
+    void setAlbumScanFingerprint(int albumID, const QString& fingerprint);
+
+    /**
+     * Clear the modification date and the scan journal fingerprint of the album,
+     * so that the next fast scan rescans the album, even if the application is
+     * stopped before the album is scanned again.
+     * @param albumID the id of the album
+     */
+    void clearAlbumScanJournal(int albumID);
+
     /**
      * Set the icon for the album.
      * @param albumID the id of the album
@@ -374,6 +391,18 @@ public:
      */
     QMap<QString, QDateTime> getAlbumModificationMap(int albumRootId)                                               const;
 
+    /**
+     * Returns the scan journal fingerprint of the album directory.
+     * @param albumID the id of the album
+     */
+    QString getAlbumScanFingerprint(int albumID)                                                                    const;
+
+    /**
+     * Returns a QMap with relative path and the scan journal fingerprint of the album directory.
+     * @param albumRootID id of the album root of the album
+     */
+    QMap<QString, QString> getAlbumScanFingerprintMap(int albumRootId)                                              const;
+
     /**
      * Returns a QHash<int, int> of album id -> count of items
      * in the album
@@ -821,6 +850,14 @@ public:
     QVariantList getImagesFields(qlonglong imageID,
                                  DatabaseFields::Images imagesFields)                                               const;
 
+    /**
+     * Read the specified fields of a list of items, with one query per chunk of 5000 items.
+     * Each row starts with the qlonglong id of the item, followed by the fields
+     * in the order of the method above. Unknown items are skipped.
+     */
+    QVariantList getImagesFields(const QList<qlonglong>& imageIDs,
+                                 DatabaseFields::Images imagesFields)                                               const;
+
     /**
      * Add (or replace) the ItemInformation of the specified item.
      * If there is already an entry, it will be discarded.
@@ -857,6 +894,36 @@ public:
                                     DatabaseFields::ItemInformation infoFields
                                         = DatabaseFields::ItemInformationAll)                                       const;
 
+    /**
+     * Read image information of a list of items, with one query per chunk of 5000 items.
+     * Each row starts with the qlonglong id of the item, followed by the fields
+     * in the order of the method above. Items without image information are skipped.
+     */
+    QVariantList getItemInformation(const QList<qlonglong>& imageIDs,
+                                    DatabaseFields::ItemInformation infoFields)                                     const;
+
+    /**
+     * Read the fields used to sort and filter the views of the specified items,
+     * with one query per chunk of 5000 items.
+     * Unknown items are skipped. The fields are returned per item in this order:
+     *  0) qlonglong id
+     *  1) Int       album
+     *  2) Int       album root
+     *  3) String    album relative path
+     *  4) String    name
+     *  5) Int       category
+     *  6) DateTime  modificationDate
+     *  7) qlonglong fileSize
+     *  8) qlonglong manualOrder
+     *  9) Int       rating
+     * 10) DateTime  creationDate
+     * 11) Int       width
+     * 12) Int       height
+     * 13) String    format
+     * 14) qlonglong group leader image id, or null if the item is not grouped
+     */
+    QVariantList getItemSortKeys(const QList<qlonglong>& imageIDs)                                                  const;
+
     /**
      * Add (or replace) the ImageMetadata of the specified item.
      * If there is already an entry, it will be discarded.
@@ -965,6 +1032,13 @@ public:
 
     QVariantList getItemPositions(const QList<qlonglong>& imageIDs, DatabaseFields::ItemPositions fields)                  const;
 
+    /**
+     * Read image positions of a list of items, with one query per chunk of 5000 items.
+     * Each row starts with the qlonglong id of the item, followed by the fields
+     * in the order of getItemPosition(). Items without position are skipped.
+     */
+    QVariantList getItemsPositions(const QList<qlonglong>& imageIDs, DatabaseFields::ItemPositions fields)                 const;
+
     /**
      * Remove the entry in ItemPositions for the given image
      */
@@ -980,6 +1054,12 @@ public:
      */
     QList<CommentInfo> getItemComments(qlonglong imageID)                                                           const;
 
+    /**
+     * Retrieves all available comments for a list of items, with one query per chunk of 5000 items.
+     * The imageId of the returned CommentInfo tells the item.
+     */
+    QList<CommentInfo> getItemComments(const QList<qlonglong>& imageIDs)                                            const;
+
     /**
      * Sets the comments for the image. A comment for the image with the same
      * source, language and author will be overwritten.
@@ -47,7 +47,7 @@ namespace Digikam
 
 int CoreDbSchemaUpdater::schemaVersion()
 {
-    return 16;
+    return 17;
 }
 
 int CoreDbSchemaUpdater::filterSettingsVersion()
@@ -810,6 +810,14 @@ bool CoreDbSchemaUpdater::updateToVersion(int targetVersion)
             return performUpdateToVersion(QLatin1String("UpdateSchemaFromV15ToV16"), 16, 5);
         }
 
+        case 17:
+        {
+            // digiKam for database version 16 can work with version 17,
+            // add scanFingerprint column to the Albums table.
+
+            return performUpdateToVersion(QLatin1String("UpdateSchemaFromV16ToV17"), 17, 5);
+        }
+
         default:
         {
             qCDebug(DIGIKAM_COREDB_LOG) << "Core database: unsupported update to version" << targetVersion;
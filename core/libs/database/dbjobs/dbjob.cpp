@@ -24,6 +24,7 @@
 #include "itemlister.h"
 #include "digikam_debug.h"
 #include "dbjobsthread.h"
+#include "duplicatesworkqueue.h"
 
 namespace Digikam
 {
@@ -269,13 +270,11 @@ SearchesJob::SearchesJob(const SearchesDBJobInfo& jobInfo)
 }
 
 SearchesJob::SearchesJob(const SearchesDBJobInfo& jobInfo,
-                         const QSet<qlonglong>::const_iterator& begin,
-                         const QSet<qlonglong>::const_iterator& end,
+                         DuplicatesWorkQueue* const queue,
                          HaarIface* iface)
     : DBJob    (),
       m_jobInfo(jobInfo),
-      m_begin  (begin),
-      m_end    (end),
+      m_queue  (queue),
       m_iface  (iface)
 {
 }
@@ -338,34 +337,52 @@ void SearchesJob::runFindDuplicates()
     {
         qCDebug(DIGIKAM_DBJOB_LOG) << "No image ids passed for duplicates search";
 
-        Q_EMIT signalDuplicatesResults(HaarIface::DuplicatesResultsMap());
+        Q_EMIT signalDuplicatesDone();
 
         return;
     }
 
     DuplicatesProgressObserver observer(this);
 
-    if (!m_iface)
+    if (!m_iface || !m_queue)
     {
-        qCDebug(DIGIKAM_DBJOB_LOG) << "Invalid HaarIface pointer";
+        qCDebug(DIGIKAM_DBJOB_LOG) << "Invalid HaarIface or work queue pointer";
 
-        Q_EMIT signalDuplicatesResults(HaarIface::DuplicatesResultsMap());
+        Q_EMIT signalDuplicatesDone();
 
         return;
     }
 
     auto restriction = static_cast<HaarIface::DuplicatesSearchRestrictions>(m_jobInfo.searchResultRestriction());
-    auto results     = m_iface->findDuplicates(m_jobInfo.imageIds(),
-                                               m_begin,
-                                               m_end,
-                                               m_jobInfo.refImageSelectionMethod(),
-                                               m_jobInfo.refImageIds(),
-                                               m_jobInfo.minThreshold(),
-                                               m_jobInfo.maxThreshold(),
-                                               restriction,
-                                               &observer);
-
-    Q_EMIT signalDuplicatesResults(results);
+    int chunk        = 0;
+    int chunks       = 0;
+    QList<qlonglong> images2Scan;
+
+    while (!m_cancel && m_queue->takeChunk(chunk, images2Scan))
+    {
+        HaarIface::DuplicatesScansMap scans;
+
+        m_iface->findDuplicates(m_jobInfo.imageIds(),
+                                images2Scan,
+                                m_queue->workersCount(),
+                                m_jobInfo.refImageSelectionMethod(),
+                                m_jobInfo.refImageIds(),
+                                m_jobInfo.minThreshold(),
+                                m_jobInfo.maxThreshold(),
+                                restriction,
+                                &observer,
+                                &scans);
+
+        m_queue->setChunkScans(chunk, scans);
+        ++chunks;
+    }
+
+    qCDebug(DIGIKAM_DBJOB_LOG) << "Duplicates job" << this << "scanned" << chunks << "chunks,"
+                               << observer.processedImages() << "images in"
+                               << observer.elapsedTime() << "ms ("
+                               << observer.throughput() << "images/s )";
+
+    Q_EMIT signalDuplicatesDone();
 }
 
 bool SearchesJob::isCanceled() const
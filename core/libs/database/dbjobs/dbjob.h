@@ -26,6 +26,7 @@ namespace Digikam
 {
 
 class DuplicatesProgressObserver;
+class DuplicatesWorkQueue;
 
 class DIGIKAM_DATABASE_EXPORT DBJob : public ActionJob
 {
@@ -174,8 +175,7 @@ public:
 
     explicit SearchesJob(const SearchesDBJobInfo& jobInfo);
     SearchesJob(const SearchesDBJobInfo& jobInfo,
-                const QSet<qlonglong>::const_iterator& begin,
-                const QSet<qlonglong>::const_iterator& end,
+                DuplicatesWorkQueue* const queue,
                 HaarIface* iface);
 
     ~SearchesJob()  override = default;
@@ -185,7 +185,11 @@ public:
 Q_SIGNALS:
 
     void signalImageProcessed(const ItemInfo&, const QImage&, int dup);
-    void signalDuplicatesResults(const HaarIface::DuplicatesResultsMap&);
+
+    /**
+     * Emitted when the job has no more chunk to scan. The results are in the work queue.
+     */
+    void signalDuplicatesDone();
 
 protected:
 
@@ -194,8 +198,7 @@ protected:
 private:
 
     SearchesDBJobInfo                m_jobInfo;
-    QSet<qlonglong>::const_iterator  m_begin;
-    QSet<qlonglong>::const_iterator  m_end;
+    DuplicatesWorkQueue*             m_queue = nullptr;
     HaarIface*                       m_iface = nullptr;
 
 private:
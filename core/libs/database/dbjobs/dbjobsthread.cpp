@@ -191,41 +191,37 @@ void SearchesDBJobsThread::searchesListing(const SearchesDBJobInfo& info)
 
     if (info.isDuplicatesJob())
     {
-        m_results.clear();
         m_haarIface.reset(new HaarIface(info.imageIds()));
         m_isAlbumUpdate    = info.isAlbumUpdate();
         m_processedImages  = 0;
         m_totalImages2Scan = info.imageIds().count();
 
-        const int threadsCount         = (m_totalImages2Scan < 200) ? 1 : qMax(1, maximumNumberOfThreads());
-        const int images2ScanPerThread = m_totalImages2Scan / threadsCount;
+        // The images are cut in chunks pulled by all jobs from a shared queue,
+        // so that all the threads keep busy until the end of the scan.
 
-        QSet<qlonglong>::const_iterator begin = info.imageIds().constBegin();
-        QSet<qlonglong>::const_iterator end   = info.imageIds().constBegin();
+        const int threadsCount = (m_totalImages2Scan < 200) ? 1 : qMax(1, maximumNumberOfThreads());
+        m_workQueue.reset(new DuplicatesWorkQueue(info.imageIds(), threadsCount));
+        m_runningJobs.clear();
 
-        // Split job on multiple threads
+        HaarIface* const iface                                    = m_haarIface.data();
+        const HaarIface::RefImageSelMethod method                 = info.refImageSelectionMethod();
+        const QSet<qlonglong> refs                                = info.refImageIds();
+        const double minThreshold                                 = info.minThreshold();
+        const double maxThreshold                                 = info.maxThreshold();
+        const HaarIface::DuplicatesSearchRestrictions restriction = static_cast<HaarIface::DuplicatesSearchRestrictions>(info.searchResultRestriction());
 
-        for (int i = 0 ; i < threadsCount ; ++i)
-        {
-            // The last thread should read until the end of the list.
-
-            if (i == threadsCount - 1)
-            {
-                end = info.imageIds().constEnd();
-            }
-            else
+        m_rescan = [iface, method, refs, minThreshold, maxThreshold, restriction](qlonglong imageId)
             {
-                // TODO: port to std::advance https://en.cppreference.com/w/cpp/iterator/advance
-
-                for (int j = 0 ; ((end != info.imageIds().constEnd()) && (j < images2ScanPerThread)) ; ++j, ++end);
-            }
-
-            SearchesJob* const job = new SearchesJob(info, begin, end, m_haarIface.data());
+                return iface->scanForDuplicates(imageId, method, refs, minThreshold, maxThreshold, restriction);
+            };
 
-            begin = end;
+        for (int i = 0 ; i < m_workQueue->workersCount() ; ++i)
+        {
+            SearchesJob* const job = new SearchesJob(info, m_workQueue.data(), m_haarIface.data());
+            m_runningJobs << job;
 
-            connect(job, &SearchesJob::signalDuplicatesResults,
-                    this, &SearchesDBJobsThread::slotDuplicatesResults);
+            connect(job, &SearchesJob::signalDuplicatesDone,
+                    this, &SearchesDBJobsThread::slotDuplicatesDone);
 
             connect(job, &SearchesJob::signalImageProcessed,
                     this, &SearchesDBJobsThread::slotImageProcessed);
@@ -252,37 +248,31 @@ void SearchesDBJobsThread::slotImageProcessed(const ItemInfo& inf, const QImage&
     Q_EMIT signalProgress((++m_processedImages * 100) / m_totalImages2Scan, inf, img, dup);
 }
 
-void SearchesDBJobsThread::slotDuplicatesResults(const HaarIface::DuplicatesResultsMap& incoming)
+void SearchesDBJobsThread::cancel(bool isCancel)
 {
-    auto searchResults = [&](qlonglong imageId) -> HaarIface::DuplicatesResultsMap::iterator
-    {
-        for (auto it = m_results.begin() ; it != m_results.end() ; ++it)
-        {
-            if ((imageId == it.key()) || (it->second.contains(imageId)))
-            {
-                return it;
-            }
-        }
+    // The jobs already queued in the pool still report their end, which is ignored.
 
-        return m_results.end();
-    };
+    m_runningJobs.clear();
 
-    const auto keys = incoming.keys();
+    DBJobsThread::cancel(isCancel);
+}
 
-    for (const auto& referenceImage : keys)
-    {
-        if (searchResults(referenceImage) == m_results.end())
-        {
-            m_results.insert(referenceImage, incoming.value(referenceImage));
-        }
-    }
+void SearchesDBJobsThread::slotDuplicatesDone()
+{
+    // Ignore the jobs canceled or from a previous search.
 
-    if (m_processedImages != m_totalImages2Scan)
+    if (!m_runningJobs.remove(sender()) || !m_runningJobs.isEmpty())
     {
         return;
     }
 
-    HaarIface::rebuildDuplicatesAlbums(m_results, m_isAlbumUpdate);
+    // All jobs are done: the chunks are merged in order, whatever the threads scheduling was,
+    // and the images skipped by their chunk only are scanned again.
+
+    if (m_processedImages == m_totalImages2Scan)
+    {
+        HaarIface::rebuildDuplicatesAlbums(m_workQueue->mergedResults(m_rescan), m_isAlbumUpdate);
+    }
 
     Q_EMIT finished();
 }
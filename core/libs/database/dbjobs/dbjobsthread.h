@@ -17,6 +17,7 @@
 // Qt includes
 
 #include <QImage>
+#include <QSet>
 
 // Local includes
 
@@ -24,6 +25,7 @@
 #include "dbjobinfo.h"
 #include "dbjob.h"
 #include "haariface.h"
+#include "duplicatesworkqueue.h"
 #include "itemlisterrecord.h"
 #include "actionthreadbase.h"
 #include "digikam_export.h"
@@ -165,21 +167,30 @@ public:
      */
     void searchesListing(const SearchesDBJobInfo& info);
 
+    /**
+     * Cancel the jobs as ActionThreadBase::cancel(). The duplicates jobs not started
+     * are deleted without reporting their end, so they are no longer waited for.
+     */
+    void cancel(bool isCancel = true);
+
 public Q_SLOTS:
 
     void slotImageProcessed(const ItemInfo&, const QImage&, int dup);
-    void slotDuplicatesResults(const HaarIface::DuplicatesResultsMap&);
+    void slotDuplicatesDone();
 
 Q_SIGNALS:
 
     void signalProgress(int percentage, const ItemInfo& inf, const QImage& img, int dup);
 
 private:
-    HaarIface::DuplicatesResultsMap m_results;
-    QScopedPointer<HaarIface>       m_haarIface;
-    bool                            m_isAlbumUpdate     = false;
-    int                             m_processedImages   = 0;
-    int                             m_totalImages2Scan  = 0;
+
+    QScopedPointer<DuplicatesWorkQueue> m_workQueue;
+    DuplicatesWorkQueue::ScanFunction   m_rescan;           ///< Scans an image with the settings of the search.
+    QScopedPointer<HaarIface>           m_haarIface;
+    bool                                m_isAlbumUpdate     = false;
+    int                                 m_processedImages   = 0;
+    int                                 m_totalImages2Scan  = 0;
+    QSet<QObject*>                      m_runningJobs;      ///< The duplicates jobs not yet done.
 };
 
 // ---------------------------------------------
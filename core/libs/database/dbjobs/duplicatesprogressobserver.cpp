@@ -24,6 +24,7 @@ DuplicatesProgressObserver::DuplicatesProgressObserver(SearchesJob* const thread
     : HaarProgressObserver(),
       m_job               (thread)
 {
+    m_timer.start();
 }
 
 DuplicatesProgressObserver::~DuplicatesProgressObserver()
@@ -33,6 +34,8 @@ DuplicatesProgressObserver::~DuplicatesProgressObserver()
 
 void DuplicatesProgressObserver::imageProcessed(const ItemInfo& inf, const QImage& img, int dup)
 {
+    ++m_processedImages;
+
     Q_EMIT m_job->signalImageProcessed(inf, img, dup);
 }
 
@@ -41,4 +44,19 @@ bool DuplicatesProgressObserver::isCanceled()
     return m_job->isCanceled();
 }
 
+int DuplicatesProgressObserver::processedImages() const
+{
+    return m_processedImages;
+}
+
+qint64 DuplicatesProgressObserver::elapsedTime() const
+{
+    return m_timer.elapsed();
+}
+
+double DuplicatesProgressObserver::throughput() const
+{
+    return (m_processedImages * 1000.0 / qMax(m_timer.elapsed(), (qint64)1));
+}
+
 } // namespace Digikam
@@ -17,6 +17,7 @@
 // Qt includes
 
 #include <QImage>
+#include <QElapsedTimer>
 
 // Local includes
 
@@ -41,9 +42,18 @@ public:
     void imageProcessed(const ItemInfo& inf, const QImage& img, int dup)    override;
     bool isCanceled()                                                       override;
 
+    /**
+     * Statistics of the thread running the observed job, since the observer creation.
+     */
+    int    processedImages()                                                const;
+    qint64 elapsedTime()                                                    const;  ///< In milliseconds.
+    double throughput()                                                     const;  ///< In images per second.
+
 private:
 
-    SearchesJob* m_job = nullptr;
+    SearchesJob*  m_job             = nullptr;
+    int           m_processedImages = 0;
+    QElapsedTimer m_timer;
 
 private:
 
@@ -0,0 +1,140 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Shared work queue for parallel duplicates scanning
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "duplicatesworkqueue.h"
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QtMath>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+DuplicatesWorkQueue::DuplicatesWorkQueue(const QSet<qlonglong>& images2Scan, int workersCount)
+    : m_images   (images2Scan.begin(), images2Scan.end()),
+      m_nextChunk(0)
+{
+    std::sort(m_images.begin(), m_images.end());
+
+    // Around 16 chunks per worker to balance the load, but not too small chunks
+    // since each chunk skips the images already found as duplicates in itself.
+    // One worker scans all images at once, and nothing is scanned again by the merge.
+
+    if (workersCount <= 1)
+    {
+        m_chunkSize = qMax(1, (int)m_images.count());
+    }
+    else
+    {
+        m_chunkSize = qBound(8, (int)m_images.count() / (workersCount * 16), 128);
+    }
+
+    m_scans.resize(qMax(1, (int)qCeil((double)m_images.count() / m_chunkSize)));
+    m_workersCount = qMin(qMax(1, workersCount), m_scans.count());
+}
+
+int DuplicatesWorkQueue::chunksCount() const
+{
+    return m_scans.count();
+}
+
+int DuplicatesWorkQueue::workersCount() const
+{
+    return m_workersCount;
+}
+
+bool DuplicatesWorkQueue::takeChunk(int& chunk, QList<qlonglong>& images)
+{
+    chunk = m_nextChunk.fetchAndAddRelaxed(1);
+
+    if (chunk >= m_scans.count())
+    {
+        return false;
+    }
+
+    images = m_images.mid(chunk * m_chunkSize, m_chunkSize);
+
+    return true;
+}
+
+void DuplicatesWorkQueue::setChunkScans(int chunk, const HaarIface::DuplicatesScansMap& scans)
+{
+    if ((chunk >= 0) && (chunk < m_scans.count()))
+    {
+        m_scans[chunk] = scans;
+    }
+}
+
+HaarIface::DuplicatesResultsMap DuplicatesWorkQueue::mergedResults(const ScanFunction& rescan) const
+{
+    HaarIface::DuplicatesResultsMap merged;
+    QSet<qlonglong>                 found;
+    int                             rescanned = 0;
+
+    for (int i = 0 ; i < m_images.count() ; ++i)
+    {
+        // An image already listed in a group, as reference or as duplicate, is not scanned.
+
+        const qlonglong image = m_images.at(i);
+
+        if (found.contains(image))
+        {
+            continue;
+        }
+
+        // An image missing from the scans of its chunk was skipped as a duplicate of a previous
+        // image of the chunk, which is not scanned here as it is a duplicate of a previous chunk.
+
+        const HaarIface::DuplicatesScansMap& scans       = m_scans.at(i / m_chunkSize);
+        HaarIface::DuplicatesScansMap::const_iterator it = scans.constFind(image);
+        HaarIface::DuplicatesScan scan;
+
+        if (it != scans.constEnd())
+        {
+            scan = it.value();
+        }
+        else
+        {
+            scan = rescan(image);
+            ++rescanned;
+        }
+
+        if (scan.reference == -1)
+        {
+            continue;
+        }
+
+        merged.insert(scan.reference, qMakePair(scan.similarity, scan.duplicates));
+
+        found << image;
+        found.unite(QSet<qlonglong>(scan.duplicates.constBegin(), scan.duplicates.constEnd()));
+    }
+
+    if (rescanned)
+    {
+        qCDebug(DIGIKAM_DBJOB_LOG) << "Duplicates merge scanned" << rescanned << "images again";
+    }
+
+    return merged;
+}
+
+} // namespace Digikam
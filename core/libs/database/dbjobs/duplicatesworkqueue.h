@@ -0,0 +1,98 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Shared work queue for parallel duplicates scanning
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// C++ includes
+
+#include <functional>
+
+// Qt includes
+
+#include <QAtomicInt>
+#include <QList>
+#include <QSet>
+#include <QVector>
+
+// Local includes
+
+#include "haariface.h"
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * The images to scan are sorted by id and cut in small chunks. All the duplicates
+ * jobs pull the next free chunk from this queue until it is empty, so a job which
+ * hits cheap images takes more chunks than a job which hits expensive ones.
+ *
+ * Each chunk is scanned on its own, and the scans of its images are stored in a dedicated
+ * slot: no lock is taken while the jobs are running. When all jobs are done, the scan of
+ * all images is replayed in order, as one thread does, so the results are the same as
+ * with a single thread and do not depend on the threads scheduling.
+ */
+class DIGIKAM_DATABASE_EXPORT DuplicatesWorkQueue
+{
+public:
+
+    using ScanFunction = std::function<HaarIface::DuplicatesScan(qlonglong)>;
+
+public:
+
+    /**
+     * With one worker, all the images are scanned as one chunk.
+     */
+    DuplicatesWorkQueue(const QSet<qlonglong>& images2Scan, int workersCount);
+    ~DuplicatesWorkQueue() = default;
+
+    int chunksCount()                                                       const;
+
+    /**
+     * The number of jobs to run: the workers count passed to the constructor,
+     * limited to the number of chunks.
+     */
+    int workersCount()                                                      const;
+
+    /**
+     * Take the next free chunk. Return false if all chunks are already taken.
+     */
+    bool takeChunk(int& chunk, QList<qlonglong>& images);
+
+    /**
+     * Store the scans of a chunk taken with takeChunk(), as given by HaarIface::findDuplicates().
+     */
+    void setChunkScans(int chunk, const HaarIface::DuplicatesScansMap& scans);
+
+    /**
+     * Merge the scans of all chunks. To call only when all jobs are done.
+     * An image skipped in its chunk, as a duplicate of an image which is
+     * itself skipped by the merge, is scanned again with 'rescan'.
+     */
+    HaarIface::DuplicatesResultsMap mergedResults(const ScanFunction& rescan) const;
+
+private:
+
+    QList<qlonglong>                         m_images;
+    int                                      m_chunkSize    = 1;
+    int                                      m_workersCount = 1;
+    QAtomicInt                               m_nextChunk;
+    QVector<HaarIface::DuplicatesScansMap>   m_scans;
+
+private:
+
+    Q_DISABLE_COPY(DuplicatesWorkQueue)
+};
+
+} // namespace Digikam
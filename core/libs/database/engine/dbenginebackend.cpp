@@ -1975,12 +1975,19 @@ void BdEngineBackend::rollbackTransaction()
 {
     Q_D(BdEngineBackend);
 
-    // we leave that out for transaction counting. It's an exceptional condition.
-
     if (!d->databaseForThread().rollback())
     {
         qCDebug(DIGIKAM_DBENGINE_LOG) << "Failed to run database backend rollback transaction.";
     }
+
+    // The rollback ends the transaction as commitTransaction() does, so that the next
+    // beginTransaction() of the thread starts a new one.
+
+    if (d->decrementTransactionCount())
+    {
+        d->isInTransaction = false;
+        d->transactionFinished();
+    }
 }
 
 QStringList BdEngineBackend::tables()
@@ -468,7 +468,7 @@ public:
      */
     BdEngineBackend::QueryState commitTransaction();
     /**
-     * Rollback the current database transaction
+     * Rollback the current database transaction, instead of committing it
      */
     void rollbackTransaction();
 
@@ -35,6 +35,15 @@
 
 #include "dimg.h"
 
+// SIMD includes
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define HAAR_HAVE_SIMD
+#   define HAAR_TARGET_SSE2 __attribute__((target("sse2")))
+#   define HAAR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 using namespace std;
 
 namespace Digikam
@@ -66,6 +75,341 @@ public:
 
 typedef std::priority_queue<valStruct> valqueue;
 
+// --- SIMD implementations ----------------------------------------------------------------------
+
+/**
+ * The SIMD kernels below do exactly the same double precision operations in the same order
+ * than the scalar loops, one coefficient per vector lane, and never fuse a multiplication
+ * with an addition, so the signatures are bit-exact with the ones already stored in database.
+ */
+
+enum SimdLevel
+{
+    SimdNone = 0,
+    SimdSSE2,
+    SimdAVX2
+};
+
+#ifdef HAAR_HAVE_SIMD
+
+/**
+ * Return the best SIMD instruction set available at run-time for the Haar kernels.
+ * The environment variable DIGIKAM_HAAR_SIMD can lower it, for benchmarking purpose.
+ */
+static int haarSimdLevel()
+{
+    static const int level = []()
+    {
+        __builtin_cpu_init();
+
+        if      (__builtin_cpu_supports("avx2"))
+        {
+            return int(SimdAVX2);
+        }
+        else if (__builtin_cpu_supports("sse2"))
+        {
+            return int(SimdSSE2);
+        }
+
+        return int(SimdNone);
+    }();
+
+    // For benchmarking and testing purpose: 0 = scalar only, 1 = SSE2, 2 = AVX2.
+    // The variable is read for each Calculator to be changed at run-time by the unit test.
+
+    if (qEnvironmentVariableIsSet("DIGIKAM_HAAR_SIMD"))
+    {
+        return qMin(level, qBound(int(SimdNone), qEnvironmentVariableIntValue("DIGIKAM_HAAR_SIMD"), int(SimdAVX2)));
+    }
+
+    return level;
+}
+
+// RGB -> YIQ conversion, returns the number of pixels converted
+
+HAAR_TARGET_AVX2 static int haarYiqAVX2(Unit* const a, Unit* const b, Unit* const c)
+{
+    int i = 0;
+
+    for ( ; (i + 4) <= NumberOfPixelsSquared ; i += 4)
+    {
+        const __m256d r  = _mm256_loadu_pd(a + i);
+        const __m256d g  = _mm256_loadu_pd(b + i);
+        const __m256d bl = _mm256_loadu_pd(c + i);
+
+        const __m256d Y  = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(0.299), r),
+                                                       _mm256_mul_pd(_mm256_set1_pd(0.587), g)),
+                                         _mm256_mul_pd(_mm256_set1_pd(0.114), bl));
+        const __m256d I  = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(0.596), r),
+                                                       _mm256_mul_pd(_mm256_set1_pd(0.275), g)),
+                                         _mm256_mul_pd(_mm256_set1_pd(0.321), bl));
+        const __m256d Q  = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(0.212), r),
+                                                       _mm256_mul_pd(_mm256_set1_pd(0.523), g)),
+                                         _mm256_mul_pd(_mm256_set1_pd(0.311), bl));
+
+        _mm256_storeu_pd(a + i, Y);
+        _mm256_storeu_pd(b + i, I);
+        _mm256_storeu_pd(c + i, Q);
+    }
+
+    return i;
+}
+
+HAAR_TARGET_SSE2 static int haarYiqSSE2(Unit* const a, Unit* const b, Unit* const c)
+{
+    int i = 0;
+
+    for ( ; (i + 2) <= NumberOfPixelsSquared ; i += 2)
+    {
+        const __m128d r  = _mm_loadu_pd(a + i);
+        const __m128d g  = _mm_loadu_pd(b + i);
+        const __m128d bl = _mm_loadu_pd(c + i);
+
+        const __m128d Y  = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(0.299), r),
+                                                 _mm_mul_pd(_mm_set1_pd(0.587), g)),
+                                      _mm_mul_pd(_mm_set1_pd(0.114), bl));
+        const __m128d I  = _mm_sub_pd(_mm_sub_pd(_mm_mul_pd(_mm_set1_pd(0.596), r),
+                                                 _mm_mul_pd(_mm_set1_pd(0.275), g)),
+                                      _mm_mul_pd(_mm_set1_pd(0.321), bl));
+        const __m128d Q  = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(_mm_set1_pd(0.212), r),
+                                                 _mm_mul_pd(_mm_set1_pd(0.523), g)),
+                                      _mm_mul_pd(_mm_set1_pd(0.311), bl));
+
+        _mm_storeu_pd(a + i, Y);
+        _mm_storeu_pd(b + i, I);
+        _mm_storeu_pd(c + i, Q);
+    }
+
+    return i;
+}
+
+// One level of the row decomposition, returns the number of coefficient pairs processed
+
+HAAR_TARGET_AVX2 static int haarRowAVX2(Unit* const row, Unit* const t, int h1, Unit C)
+{
+    const __m256d vc = _mm256_set1_pd(C);
+    int k            = 0;
+
+    for ( ; (k + 4) <= h1 ; k += 4)
+    {
+        // De-interleave the even and odd elements of the row.
+
+        const __m256d x0   = _mm256_loadu_pd(row + 2 * k);
+        const __m256d x1   = _mm256_loadu_pd(row + 2 * k + 4);
+        const __m256d even = _mm256_permute4x64_pd(_mm256_unpacklo_pd(x0, x1), 0xD8);
+        const __m256d odd  = _mm256_permute4x64_pd(_mm256_unpackhi_pd(x0, x1), 0xD8);
+
+        _mm256_storeu_pd(t   + k, _mm256_mul_pd(_mm256_sub_pd(even, odd), vc));
+        _mm256_storeu_pd(row + k, _mm256_add_pd(even, odd));
+    }
+
+    return k;
+}
+
+HAAR_TARGET_SSE2 static int haarRowSSE2(Unit* const row, Unit* const t, int h1, Unit C)
+{
+    const __m128d vc = _mm_set1_pd(C);
+    int k            = 0;
+
+    for ( ; (k + 2) <= h1 ; k += 2)
+    {
+        const __m128d x0   = _mm_loadu_pd(row + 2 * k);
+        const __m128d x1   = _mm_loadu_pd(row + 2 * k + 2);
+        const __m128d even = _mm_unpacklo_pd(x0, x1);
+        const __m128d odd  = _mm_unpackhi_pd(x0, x1);
+
+        _mm_storeu_pd(t   + k, _mm_mul_pd(_mm_sub_pd(even, odd), vc));
+        _mm_storeu_pd(row + k, _mm_add_pd(even, odd));
+    }
+
+    return k;
+}
+
+// Column decomposition of 4 (AVX2) or 2 (SSE2) adjacent columns, one column per lane
+
+HAAR_TARGET_AVX2 static void haarColumnsAVX2(Unit* const a, int column)
+{
+    Unit t[(NumberOfPixels >> 1) * 4];
+    Unit C = 1.0;
+    int  h1;
+
+    for (int h = NumberOfPixels ; h > 1 ; h = h1)
+    {
+        h1               = h >> 1;
+        C               *= 0.7071;       // 1/sqrt(2) = 0.7071
+        const __m256d vc = _mm256_set1_pd(C);
+
+        for (int k = 0 ; k < h1 ; ++k)
+        {
+            Unit* const r2   = a + 2 * k * NumberOfPixels + column;
+            const __m256d x0 = _mm256_loadu_pd(r2);
+            const __m256d x1 = _mm256_loadu_pd(r2 + NumberOfPixels);
+
+            _mm256_storeu_pd(t + 4 * k,                         _mm256_mul_pd(_mm256_sub_pd(x0, x1), vc));
+            _mm256_storeu_pd(a + k * NumberOfPixels + column,   _mm256_add_pd(x0, x1));
+        }
+
+        // Write back subtraction results:
+
+        for (int k = 0 ; k < h1 ; ++k)
+        {
+            _mm256_storeu_pd(a + (h1 + k) * NumberOfPixels + column, _mm256_loadu_pd(t + 4 * k));
+        }
+    }
+
+    // Fix first element of each column:
+
+    _mm256_storeu_pd(a + column, _mm256_mul_pd(_mm256_loadu_pd(a + column), _mm256_set1_pd(C)));
+}
+
+HAAR_TARGET_SSE2 static void haarColumnsSSE2(Unit* const a, int column)
+{
+    Unit t[(NumberOfPixels >> 1) * 2];
+    Unit C = 1.0;
+    int  h1;
+
+    for (int h = NumberOfPixels ; h > 1 ; h = h1)
+    {
+        h1               = h >> 1;
+        C               *= 0.7071;       // 1/sqrt(2) = 0.7071
+        const __m128d vc = _mm_set1_pd(C);
+
+        for (int k = 0 ; k < h1 ; ++k)
+        {
+            Unit* const r2   = a + 2 * k * NumberOfPixels + column;
+            const __m128d x0 = _mm_loadu_pd(r2);
+            const __m128d x1 = _mm_loadu_pd(r2 + NumberOfPixels);
+
+            _mm_storeu_pd(t + 2 * k,                         _mm_mul_pd(_mm_sub_pd(x0, x1), vc));
+            _mm_storeu_pd(a + k * NumberOfPixels + column,   _mm_add_pd(x0, x1));
+        }
+
+        // Write back subtraction results:
+
+        for (int k = 0 ; k < h1 ; ++k)
+        {
+            _mm_storeu_pd(a + (h1 + k) * NumberOfPixels + column, _mm_loadu_pd(t + 2 * k));
+        }
+    }
+
+    // Fix first element of each column:
+
+    _mm_storeu_pd(a + column, _mm_mul_pd(_mm_loadu_pd(a + column), _mm_set1_pd(C)));
+}
+
+// Index of the first coefficient from 'begin' with a magnitude larger than 'threshold'
+
+HAAR_TARGET_AVX2 static int haarFirstLargerAVX2(const Unit* const cdata, int begin, Unit threshold)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d vt   = _mm256_set1_pd(threshold);
+    int i              = begin;
+
+    for ( ; (i + 4) <= NumberOfPixelsSquared ; i += 4)
+    {
+        const __m256d mag = _mm256_andnot_pd(sign, _mm256_loadu_pd(cdata + i));
+        const int mask    = _mm256_movemask_pd(_mm256_cmp_pd(mag, vt, _CMP_GT_OQ));
+
+        if (mask)
+        {
+            return (i + __builtin_ctz(mask));
+        }
+    }
+
+    for ( ; i < NumberOfPixelsSquared ; ++i)
+    {
+        if (fabs(cdata[i]) > threshold)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+HAAR_TARGET_SSE2 static int haarFirstLargerSSE2(const Unit* const cdata, int begin, Unit threshold)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d vt   = _mm_set1_pd(threshold);
+    int i              = begin;
+
+    for ( ; (i + 2) <= NumberOfPixelsSquared ; i += 2)
+    {
+        const __m128d mag = _mm_andnot_pd(sign, _mm_loadu_pd(cdata + i));
+        const int mask    = _mm_movemask_pd(_mm_cmpgt_pd(mag, vt));
+
+        if (mask)
+        {
+            return (i + __builtin_ctz(mask));
+        }
+    }
+
+    for ( ; i < NumberOfPixelsSquared ; ++i)
+    {
+        if (fabs(cdata[i]) > threshold)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+#else
+
+static int haarSimdLevel()
+{
+    return int(SimdNone);
+}
+
+#endif // HAAR_HAVE_SIMD
+
+/**
+ * Index of the first coefficient from 'begin' with a magnitude larger than 'threshold',
+ * or NumberOfPixelsSquared if there is none.
+ */
+static int haarFirstLarger(const Unit* const cdata, int begin, Unit threshold, int simdLevel)
+{
+
+#ifdef HAAR_HAVE_SIMD
+
+    switch (simdLevel)
+    {
+        case SimdAVX2:
+        {
+            return haarFirstLargerAVX2(cdata, begin, threshold);
+        }
+
+        case SimdSSE2:
+        {
+            return haarFirstLargerSSE2(cdata, begin, threshold);
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+#else
+
+    Q_UNUSED(simdLevel);
+
+#endif
+
+    int i = begin;
+
+    for ( ; i < NumberOfPixelsSquared ; ++i)
+    {
+        if (fabs(cdata[i]) > threshold)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
 // --------------------------------------------------------------------
 
 /**
@@ -164,6 +508,11 @@ WeightBin::WeightBin()
  * Here input is RGB data [0..255] in Unit arrays
  * Computation is (almost) in-situ.
  */
+Calculator::Calculator()
+    : m_simdLevel(haarSimdLevel())
+{
+}
+
 void Calculator::haar2D(Unit a[])
 {
     int  i;
@@ -190,8 +539,33 @@ void Calculator::haar2D(Unit a[])
 
             h1 = h >> 1;        // h = 2*h1
             C *= 0.7071;        // 1/sqrt(2)
+            k  = 0;
+
+#ifdef HAAR_HAVE_SIMD
 
-            for (k = 0, j1 = j2 = i ; k < h1 ; ++k, ++j1, j2 += 2)
+            switch (m_simdLevel)
+            {
+                case SimdAVX2:
+                {
+                    k = haarRowAVX2(a + i, t, h1, C);
+                    break;
+                }
+
+                case SimdSSE2:
+                {
+                    k = haarRowSSE2(a + i, t, h1, C);
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+
+#endif
+
+            for (j1 = i + k, j2 = i + 2 * k ; k < h1 ; ++k, ++j1, j2 += 2)
             {
                 int j21 = j2+1;
                 t[k]    = (a[j2] - a[j21]) * C;
@@ -216,7 +590,41 @@ void Calculator::haar2D(Unit a[])
 
     // Decompose columns:
 
-    for (i = 0 ; i < NumberOfPixels ; ++i)
+    i = 0;
+
+#ifdef HAAR_HAVE_SIMD
+
+    switch (m_simdLevel)
+    {
+        case SimdAVX2:
+        {
+            for ( ; i < NumberOfPixels ; i += 4)
+            {
+                haarColumnsAVX2(a, i);
+            }
+
+            break;
+        }
+
+        case SimdSSE2:
+        {
+            for ( ; i < NumberOfPixels ; i += 2)
+            {
+                haarColumnsSSE2(a, i);
+            }
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+#endif
+
+    for ( ; i < NumberOfPixels ; ++i)
     {
         Unit C = 1.0;
         int  h, h1;
@@ -264,8 +672,33 @@ void Calculator::transform(ImageData* const data)
     Unit* a = data->data1;
     Unit* b = data->data2;
     Unit* c = data->data3;
+    int   i = 0;
+
+#ifdef HAAR_HAVE_SIMD
 
-    for (int i = 0 ; i < NumberOfPixelsSquared ; ++i)
+    switch (m_simdLevel)
+    {
+        case SimdAVX2:
+        {
+            i = haarYiqAVX2(a, b, c);
+            break;
+        }
+
+        case SimdSSE2:
+        {
+            i = haarYiqSSE2(a, b, c);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+#endif
+
+    for ( ; i < NumberOfPixelsSquared ; ++i)
     {
         Unit Y, I, Q;
 
@@ -311,24 +744,22 @@ void Calculator::getmLargests(Unit* const cdata, Idx* const sig)
     }
 
     // Queue is full (size is NUM_COEFS)
+    // Most coefficients are smaller than the smallest entry of the queue and discarded:
+    // jump directly to the next larger one, the queue is then updated in the same order.
 
-    for (/*i = NUM_COEFS+1*/ ; i < NumberOfPixelsSquared ; ++i)
+    for (i = haarFirstLarger(cdata, i, vq.top().d, m_simdLevel) ; i < NumberOfPixelsSquared ;
+         i = haarFirstLarger(cdata, i + 1, vq.top().d, m_simdLevel))
     {
         val.d = fabs(cdata[i]);
 
-        if (val.d > vq.top().d)
-        {
-            // Make room by dropping smallest entry:
-
-            vq.pop();
+        // Make room by dropping smallest entry:
 
-            // Insert val as new entry:
+        vq.pop();
 
-            val.i = i;
-            vq.push(val);
-        }
+        // Insert val as new entry:
 
-        // else discard: do nothing
+        val.i = i;
+        vq.push(val);
     }
 
     // Empty the (non-empty) queue and fill-in sig:
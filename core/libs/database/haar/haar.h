@@ -273,7 +273,7 @@ class Calculator
 
 public:
 
-    Calculator()  = default;
+    Calculator();
     ~Calculator() = default;
 
     int  calcHaar(ImageData* const imageData, SignatureData* const sigData);
@@ -284,6 +284,11 @@ private:
 
     void        haar2D(Unit a[]);
     inline void getmLargests(Unit* const cdata, Idx* const sig);
+
+private:
+
+    /// The SIMD kernels used by this calculator, selected at construction.
+    int         m_simdLevel = 0;
 };
 
 } // namespace Haar
@@ -120,30 +120,103 @@ bool HaarIface::indexImage(qlonglong imageid, const DImg& image)
     return indexImage(imageid);
 }
 
-// NOTE: private method: d->m_data has been filled
-
-bool HaarIface::indexImage(qlonglong imageid)
+bool HaarIface::calculateSignature(const DImg& image, Haar::SignatureData& sig)
 {
+    if (image.isNull())
+    {
+        return false;
+    }
+
+    d->setImageDataFromImage(image);
+
     Haar::Calculator haar;
     haar.transform(d->imageData());
-
-    Haar::SignatureData sig;
     haar.calcHaar(d->imageData(), &sig);
 
-    // Store main entry
+    return true;
+}
+
+void HaarIface::storeSignatures(const QList<QPair<qlonglong, Haar::SignatureData> >& signatures)
+{
+    if (signatures.isEmpty())
+    {
+        return;
+    }
+
+    QList<qlonglong> imageIds;
+
+    for (const auto& entry : signatures)
+    {
+        imageIds << entry.first;
+    }
+
+    // Read the state of all items with one query.
+
+    const DatabaseFields::Images fields = DatabaseFields::Status           |
+                                          DatabaseFields::ModificationDate |
+                                          DatabaseFields::UniqueHash;
+
+    QVariantList values = CoreDbAccess().db()->getImagesFields(imageIds, fields);
+    QHash<qlonglong, QPair<QDateTime, QString> > visibleItems;
 
+    for (int i = 0 ; (i + 3) < values.size() ; i += 4)
+    {
+        if (values.at(i + 1).toInt() == DatabaseItem::Visible)
+        {
+            visibleItems[values.at(i).toLongLong()] = qMakePair(values.at(i + 2).toDateTime(),
+                                                                values.at(i + 3).toString());
+        }
+    }
+
+    QList<QPair<qlonglong, Haar::SignatureData> > stored;
     DatabaseBlob blob;
-    QByteArray array = blob.write(sig);
 
-    ItemInfo info(imageid);
+    {
+        SimilarityDbAccess access;
+        access.backend()->beginTransaction();
+
+        for (const auto& entry : signatures)
+        {
+            QHash<qlonglong, QPair<QDateTime, QString> >::const_iterator it = visibleItems.constFind(entry.first);
+
+            if (it == visibleItems.constEnd())
+            {
+                continue;
+            }
+
+            Haar::SignatureData sig = entry.second;
+            QByteArray array        = blob.write(sig);
+
+            access.backend()->execSql(QString::fromUtf8("REPLACE INTO ImageHaarMatrix "
+                                                        " (imageid, modificationDate, uniqueHash, matrix) "
+                                                        " VALUES(?, ?, ?, ?);"),
+                                      entry.first, asDateTimeLocal(it->first), it->second, array);
+
+            stored << entry;
+        }
+
+        access.backend()->commitTransaction();
+    }
+
+    // Keep the in-memory signature index up to date.
 
-    if (!info.isNull() && info.isVisible())
+    for (const auto& entry : std::as_const(stored))
     {
-        SimilarityDbAccess().backend()->execSql(QString::fromUtf8("REPLACE INTO ImageHaarMatrix "
-                                                                  " (imageid, modificationDate, uniqueHash, matrix) "
-                                                                  " VALUES(?, ?, ?, ?);"),
-                                                imageid, asDateTimeLocal(info.modDateTime()), info.uniqueHash(), array);
+        HaarSignatureIndex::instance()->insert(entry.first, entry.second);
     }
+}
+
+// NOTE: private method: d->m_data has been filled
+
+bool HaarIface::indexImage(qlonglong imageid)
+{
+    Haar::Calculator haar;
+    haar.transform(d->imageData());
+
+    Haar::SignatureData sig;
+    haar.calcHaar(d->imageData(), &sig);
+
+    storeSignatures(QList<QPair<qlonglong, Haar::SignatureData> >() << qMakePair(imageid, sig));
 
     return true;
 }
@@ -338,13 +411,7 @@ QPair<double, QMap<qlonglong, double> > HaarIface::bestMatchesWithThreshold(qlon
                                                                             searchResultRestriction,
                                                                             SketchType type)
 {
-    int albumId                    = CoreDbAccess().db()->getItemAlbum(imageid);
-    QMap<qlonglong, double> scores = searchDatabase(querySig,
-                                                    type,
-                                                    targetAlbums,
-                                                    searchResultRestriction,
-                                                    imageid,
-                                                    albumId);
+    int albumId = CoreDbAccess().db()->getItemAlbum(imageid);
     double lowest, highest;
     getBestAndWorstPossibleScore(querySig, type, &lowest, &highest);
 
@@ -362,6 +429,16 @@ QPair<double, QMap<qlonglong, double> > HaarIface::bestMatchesWithThreshold(qlon
 
     double requiredScore   = lowest + scoreRange * percentageRange;
 
+    // Only the images with at most the required score are returned by the search.
+
+    QMap<qlonglong, double> scores = searchDatabase(querySig,
+                                                    type,
+                                                    targetAlbums,
+                                                    searchResultRestriction,
+                                                    imageid,
+                                                    albumId,
+                                                    requiredScore);
+
     // Set the supremum which solves the problem that if
     // required == maximum, no results will be returned.
     // Eg, id required == maximum == 50.0, only images with exactly this
@@ -463,22 +540,14 @@ QMap<qlonglong, double> HaarIface::searchDatabase(Haar::SignatureData* const que
                                                   SketchType type, const QList<int>& targetAlbums,
                                                   DuplicatesSearchRestrictions searchResultRestriction,
                                                   qlonglong originalImageId,
-                                                  int originalAlbumId)
+                                                  int originalAlbumId,
+                                                  double maxScore)
 {
     // The table of constant weight factors applied to each channel and the weight bin
 
     Haar::Weights weights((Haar::Weights::SketchType)type);
 
-    // layout the query signature for fast lookup
-
-    Haar::SignatureMap queryMapY, queryMapI, queryMapQ;
-    queryMapY.fill(querySig->sig[0]);
-    queryMapI.fill(querySig->sig[1]);
-    queryMapQ.fill(querySig->sig[2]);
-    std::reference_wrapper<Haar::SignatureMap> queryMaps[3] = { queryMapY, queryMapI, queryMapQ };
-
     // Map imageid -> score. Lowest score is best.
-    // any newly inserted value will be initialized with a score of 0, as required
 
     QMap<qlonglong, double> scores;
 
@@ -489,21 +558,20 @@ QMap<qlonglong, double> HaarIface::searchDatabase(Haar::SignatureData* const que
         d->rebuildSignatureCache();
     }
 
-    for (auto it = d->signatureCache()->constBegin() ; it != d->signatureCache()->constEnd() ; ++it)
+    const QList<HaarSignatureIndex::Match> matches = d->searchSignatureCache(*querySig, weights, maxScore);
+
+    for (const HaarSignatureIndex::Match& match : matches)
     {
         // If the image is the original one or
         // No restrictions apply or
         // SameAlbum restriction applies and the albums are equal or
         // DifferentAlbum restriction applies and the albums differ
-        // then calculate the score.
-
-        const qlonglong& imageId = it.key();
+        // then keep the score.
 
-        if (fulfillsRestrictions(imageId, d->albumCache()->value(imageId), originalImageId,
+        if (fulfillsRestrictions(match.imageId, match.value, originalImageId,
                                  originalAlbumId, targetAlbums, searchResultRestriction))
         {
-            const Haar::SignatureData& data = it.value();
-            scores[imageId]                 = calculateScore(*querySig, data, weights, queryMaps);
+            scores.insert(match.imageId, match.score);
         }
     }
 
@@ -757,92 +825,113 @@ QSet<qlonglong> HaarIface::imagesFromAlbumsAndTags(const QList<int>& albums2Scan
     return images;
 }
 
-HaarIface::DuplicatesResultsMap HaarIface::findDuplicates(const QSet<qlonglong>& images2Scan,
-                                                          const QSet<qlonglong>::const_iterator& rangeBegin,
-                                                          const QSet<qlonglong>::const_iterator& rangeEnd,
-                                                          RefImageSelMethod refImageSelectionMethod,
-                                                          const QSet<qlonglong>& refs,
-                                                          double requiredPercentage,
-                                                          double maximumPercentage,
-                                                          DuplicatesSearchRestrictions searchResultRestriction,
-                                                          HaarProgressObserver* const observer)
+HaarIface::DuplicatesScan HaarIface::scanForDuplicates(qlonglong imageId,
+                                                      RefImageSelMethod refImageSelectionMethod,
+                                                      const QSet<qlonglong>& refs,
+                                                      double requiredPercentage,
+                                                      double maximumPercentage,
+                                                      DuplicatesSearchRestrictions searchResultRestriction)
 {
     static const QList<int>                 emptyTargetAlbums;
-    DuplicatesResultsMap                    resultsMap;
-    DuplicatesResultsMap::iterator          resultsIterator;
-    QSet<qlonglong>::const_iterator         images2ScanIterator;
     QPair<double, QMap<qlonglong, double> > bestMatches;
     QList<qlonglong>                        duplicates;
-    QSet<qlonglong>                         resultsCandidates;
-    const bool                              singleThread = ((rangeBegin == images2Scan.constBegin()) &&
-                                                            (rangeEnd   == images2Scan.constEnd()));
+    DuplicatesScan                          scan;
 
-    // create signature cache map for fast lookup
+    // find images with required similarity
 
-    if (!d->hasSignatureCache())
-    {
-        d->rebuildSignatureCache(images2Scan);
-    }
+    bestMatches = bestMatchesForImageWithThreshold(imageId,
+                                                   requiredPercentage,
+                                                   maximumPercentage,
+                                                   emptyTargetAlbums,
+                                                   searchResultRestriction,
+                                                   ScannedSketch);
+
+    // We need only the image ids from the best matches map.
+
+    duplicates      = bestMatches.second.keys();
+    scan.duplicates = duplicates;
+
+    // the list will usually contain one image: the original. Filter out.
 
-    for (images2ScanIterator = rangeBegin ; images2ScanIterator != rangeEnd ; ++images2ScanIterator)
+    if (
+        !(duplicates.isEmpty())     &&
+        !((duplicates.count() == 1) &&
+        (duplicates.first() == imageId))
+       )
     {
+        DEBUG_DUPLICATES("\tHas duplicates");
 
-#if ENABLE_DEBUG_DUPLICATES
+        // Use the oldest image date or larger pixel/file size as the reference image.
+        // Or if the image is in the refImage list
 
-        {
-            ItemInfo info(*images2ScanIterator);
-            const QString path = info.filePath();
-            const QString name = info.name();
-            DEBUG_DUPLICATES("Iterate image: " << name << "Path: " << path);
-        }
+        QDateTime refDateTime;
+        QDateTime refModDateTime;
+        quint64   refPixelSize  = 0;
+        qlonglong refFileSize   = 0;
+        qlonglong reference     = imageId;
 
-#endif
+        const bool useReferenceImages = (
+                                         (refImageSelectionMethod == RefImageSelMethod::PreferFolder) ||
+                                         (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder)
+                                        );
 
-        if (observer && observer->isCanceled())
-        {
-            break;
-        }
+        bool referenceFound = false;
 
-        if (!resultsCandidates.contains(*images2ScanIterator))
+        if (useReferenceImages)
         {
-            // find images with required similarity
+            for (auto it = refs.begin() ; it != refs.end() ; ++it)
+            {
 
-            bestMatches = bestMatchesForImageWithThreshold(*images2ScanIterator,
-                                                           requiredPercentage,
-                                                           maximumPercentage,
-                                                           emptyTargetAlbums,
-                                                           searchResultRestriction,
-                                                           ScannedSketch);
+#if ENABLE_DEBUG_DUPLICATES
 
-            // We need only the image ids from the best matches map.
+                {
+                    ItemInfo info(*it);
+                    const QString path = info.filePath();
+                    const QString name = info.name();
+                    DEBUG_DUPLICATES("\tReference image: " << name << "Path: " << path << ", Id: " << info.id());
+                }
 
-            duplicates = bestMatches.second.keys();
+#endif
+
+                if (*it == imageId)
+                {
+                    // image of images2ScanIterator is already in the references present, so take it as the
+                    // reference
+
+                    DEBUG_DUPLICATES("\tReference found!");
+                    referenceFound = true;
+                    break;
+                }
+            }
+        }
 
-            // the list will usually contain one image: the original. Filter out.
+        if (
+            !useReferenceImages                                                               ||
+            (!referenceFound && (refImageSelectionMethod == RefImageSelMethod::PreferFolder)) ||
+            (referenceFound  && (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder))
+           )
+        {
+            DEBUG_DUPLICATES("\tChecking Duplicates")
 
-            if (
-                !(duplicates.isEmpty())     &&
-                !((duplicates.count() == 1) &&
-                (duplicates.first() == *images2ScanIterator))
-               )
+            for (const qlonglong& refId : std::as_const(duplicates))
             {
-                DEBUG_DUPLICATES("\tHas duplicates");
 
-                // Use the oldest image date or larger pixel/file size as the reference image.
-                // Or if the image is in the refImage list
+#if ENABLE_DEBUG_DUPLICATES
 
-                QDateTime refDateTime;
-                QDateTime refModDateTime;
-                quint64   refPixelSize  = 0;
-                qlonglong refFileSize   = 0;
-                qlonglong reference     = *images2ScanIterator;
+                {
+                    ItemInfo info(refId);
+                    const QString path = info.filePath();
+                    const QString name = info.name();
+                    DEBUG_DUPLICATES("\t\tDuplicates: " << name << "Path: " << path << ", Id: " << info.id());
+                }
 
-                const bool useReferenceImages = (
-                                                 (refImageSelectionMethod == RefImageSelMethod::PreferFolder) ||
-                                                 (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder)
-                                                );
+#endif
+
+                ItemInfo info(refId);
+                quint64 infoPixelSize = (quint64)info.dimensions().width() *
+                                        (quint64)info.dimensions().height();
 
-                bool referenceFound = false;
+                referenceFound = false;
 
                 if (useReferenceImages)
                 {
@@ -855,134 +944,145 @@ HaarIface::DuplicatesResultsMap HaarIface::findDuplicates(const QSet<qlonglong>&
                             ItemInfo info(*it);
                             const QString path = info.filePath();
                             const QString name = info.name();
-                            DEBUG_DUPLICATES("\tReference image: " << name << "Path: " << path << ", Id: " << info.id());
+                            DEBUG_DUPLICATES("\t\tReference image: " << name << "Path: " << path << ", Id: " << info.id());
                         }
 
 #endif
 
-                        if (*it == *images2ScanIterator)
+                        if (*it == refId)
                         {
-                            // image of images2ScanIterator is already in the references present, so take it as the
-                            // reference
-
-                            DEBUG_DUPLICATES("\tReference found!");
+                            DEBUG_DUPLICATES("\t\tReference found!");
                             referenceFound = true;
                             break;
                         }
                     }
                 }
 
-                if (
-                    !useReferenceImages                                                               ||
-                    (!referenceFound && (refImageSelectionMethod == RefImageSelMethod::PreferFolder)) ||
-                    (referenceFound  && (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder))
-                   )
+                const bool preferFolderCond  = (
+                                                referenceFound &&
+                                                (refImageSelectionMethod == RefImageSelMethod::PreferFolder)
+                                               );
+
+                const bool excludeFolderCond = (
+                                                !referenceFound &&
+                                                (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder)
+                                               );
+
+                const bool newerCreationCond = (
+                                                (refImageSelectionMethod == RefImageSelMethod::NewerCreationDate) &&
+                                                (!refDateTime.isValid() || (info.dateTime() >  refDateTime))
+                                               );
+
+                const bool newerModCond      = (
+                                                (refImageSelectionMethod == RefImageSelMethod::NewerModificationDate) &&
+                                                (!refModDateTime.isValid() || (info.modDateTime() >  refModDateTime))
+                                               );
+
+                const bool olderOrLargerCond = (
+                                                (refImageSelectionMethod == RefImageSelMethod::OlderOrLarger)          &&
+                                                (!refDateTime.isValid()                                                ||
+                                                (infoPixelSize   >  refPixelSize)                                      ||
+                                                ((infoPixelSize  == refPixelSize) && (info.fileSize() >  refFileSize)) ||
+                                                (
+                                                 (infoPixelSize  == refPixelSize) && (info.fileSize() == refFileSize)  &&
+                                                 (info.dateTime() <  refDateTime))
+                                                )
+                                               );
+
+                if (preferFolderCond || excludeFolderCond || newerCreationCond || newerModCond || olderOrLargerCond)
                 {
-                    DEBUG_DUPLICATES("\tChecking Duplicates")
-
-                    for (const qlonglong& refId : std::as_const(duplicates))
-                    {
+                    reference      = refId;
+                    refDateTime    = info.dateTime();
+                    refModDateTime = info.modDateTime();
+                    refFileSize    = info.fileSize();
+                    refPixelSize   = infoPixelSize;
 
 #if ENABLE_DEBUG_DUPLICATES
 
-                        {
-                            ItemInfo info(refId);
-                            const QString path = info.filePath();
-                            const QString name = info.name();
-                            DEBUG_DUPLICATES("\t\tDuplicates: " << name << "Path: " << path << ", Id: " << info.id());
-                        }
+                    {
+                        const QString path = info.filePath();
+                        const QString name = info.name();
+                        DEBUG_DUPLICATES("\t\tUse as eference image: " << name << "Path: " << path << ", Id: " << info.id() << "Pixelsize: " << infoPixelSize << ", File size: " << refFileSize << ", Datetime: " << refDateTime);
+                    }
 
 #endif
 
-                        ItemInfo info(refId);
-                        quint64 infoPixelSize = (quint64)info.dimensions().width() *
-                                                (quint64)info.dimensions().height();
-
-                        referenceFound = false;
+                    if (preferFolderCond || excludeFolderCond)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
 
-                        if (useReferenceImages)
-                        {
-                            for (auto it = refs.begin() ; it != refs.end() ; ++it)
-                            {
+        scan.reference  = reference;
+        scan.similarity = bestMatches.first;
+    }
 
-#if ENABLE_DEBUG_DUPLICATES
+    return scan;
+}
 
-                                {
-                                    ItemInfo info(*it);
-                                    const QString path = info.filePath();
-                                    const QString name = info.name();
-                                    DEBUG_DUPLICATES("\t\tReference image: " << name << "Path: " << path << ", Id: " << info.id());
-                                }
+HaarIface::DuplicatesResultsMap HaarIface::findDuplicates(const QSet<qlonglong>& images2Scan,
+                                                          const QList<qlonglong>& images2ScanChunk,
+                                                          int threadsCount,
+                                                          RefImageSelMethod refImageSelectionMethod,
+                                                          const QSet<qlonglong>& refs,
+                                                          double requiredPercentage,
+                                                          double maximumPercentage,
+                                                          DuplicatesSearchRestrictions searchResultRestriction,
+                                                          HaarProgressObserver* const observer,
+                                                          DuplicatesScansMap* const scans)
+{
+    DuplicatesResultsMap                    resultsMap;
+    QList<qlonglong>::const_iterator        images2ScanIterator;
+    QList<qlonglong>                        duplicates;
+    QSet<qlonglong>                         resultsCandidates;
+    const bool                              singleThread = (threadsCount == 1);
 
-#endif
+    // create signature cache map for fast lookup
 
-                                if (*it == refId)
-                                {
-                                    DEBUG_DUPLICATES("\t\tReference found!");
-                                    referenceFound = true;
-                                    break;
-                                }
-                            }
-                        }
+    if (!d->hasSignatureCache())
+    {
+        d->rebuildSignatureCache(images2Scan);
+    }
 
-                        const bool preferFolderCond  = (
-                                                        referenceFound &&
-                                                        (refImageSelectionMethod == RefImageSelMethod::PreferFolder)
-                                                       );
-
-                        const bool excludeFolderCond = (
-                                                        !referenceFound &&
-                                                        (refImageSelectionMethod == RefImageSelMethod::ExcludeFolder)
-                                                       );
-
-                        const bool newerCreationCond = (
-                                                        (refImageSelectionMethod == RefImageSelMethod::NewerCreationDate) &&
-                                                        (!refDateTime.isValid() || (info.dateTime() >  refDateTime))
-                                                       );
-
-                        const bool newerModCond      = (
-                                                        (refImageSelectionMethod == RefImageSelMethod::NewerModificationDate) &&
-                                                        (!refModDateTime.isValid() || (info.modDateTime() >  refModDateTime))
-                                                       );
-
-                        const bool olderOrLargerCond = (
-                                                        (refImageSelectionMethod == RefImageSelMethod::OlderOrLarger)          &&
-                                                        (!refDateTime.isValid()                                                ||
-                                                        (infoPixelSize   >  refPixelSize)                                      ||
-                                                        ((infoPixelSize  == refPixelSize) && (info.fileSize() >  refFileSize)) ||
-                                                        (
-                                                         (infoPixelSize  == refPixelSize) && (info.fileSize() == refFileSize)  &&
-                                                         (info.dateTime() <  refDateTime))
-                                                        )
-                                                       );
-
-                        if (preferFolderCond || excludeFolderCond || newerCreationCond || newerModCond || olderOrLargerCond)
-                        {
-                            reference      = refId;
-                            refDateTime    = info.dateTime();
-                            refModDateTime = info.modDateTime();
-                            refFileSize    = info.fileSize();
-                            refPixelSize   = infoPixelSize;
+    for (images2ScanIterator = images2ScanChunk.constBegin() ; images2ScanIterator != images2ScanChunk.constEnd() ; ++images2ScanIterator)
+    {
 
 #if ENABLE_DEBUG_DUPLICATES
 
-                            {
-                                const QString path = info.filePath();
-                                const QString name = info.name();
-                                DEBUG_DUPLICATES("\t\tUse as eference image: " << name << "Path: " << path << ", Id: " << info.id() << "Pixelsize: " << infoPixelSize << ", File size: " << refFileSize << ", Datetime: " << refDateTime);
-                            }
+        {
+            ItemInfo info(*images2ScanIterator);
+            const QString path = info.filePath();
+            const QString name = info.name();
+            DEBUG_DUPLICATES("Iterate image: " << name << "Path: " << path);
+        }
 
 #endif
 
-                            if (preferFolderCond || excludeFolderCond)
-                            {
-                                break;
-                            }
-                        }
-                    }
-                }
+        if (observer && observer->isCanceled())
+        {
+            break;
+        }
 
-                resultsMap.insert(reference, qMakePair(bestMatches.first, duplicates));
+        if (!resultsCandidates.contains(*images2ScanIterator))
+        {
+            const DuplicatesScan scan = scanForDuplicates(*images2ScanIterator,
+                                                          refImageSelectionMethod,
+                                                          refs,
+                                                          requiredPercentage,
+                                                          maximumPercentage,
+                                                          searchResultRestriction);
+            duplicates                = scan.duplicates;
+
+            if (scans)
+            {
+                scans->insert(*images2ScanIterator, scan);
+            }
+
+            if (scan.reference != -1)
+            {
+                resultsMap.insert(scan.reference, qMakePair(scan.similarity, scan.duplicates));
 
                 resultsCandidates << *images2ScanIterator;
                 resultsCandidates.unite(QSet<qlonglong>(duplicates.begin(), duplicates.end()));
@@ -995,7 +1095,7 @@ HaarIface::DuplicatesResultsMap HaarIface::findDuplicates(const QSet<qlonglong>&
 
         if (singleThread && !resultsCandidates.contains(*images2ScanIterator))
         {
-            d->signatureCache()->remove(*images2ScanIterator);
+            d->removeFromSignatureCache(*images2ScanIterator);
         }
 
         if (observer)
@@ -1041,9 +1141,12 @@ double HaarIface::calculateScore(const Haar::SignatureData& querySig,
         score += weights.weightForAverage(channel) * fabs(querySig.avg[channel] - targetSig.avg[channel]);
     }
 
-    // Step 2: Decrease the score if query and target have significant coefficients in common
+    // Step 2: Decrease the score if query and target have significant coefficients in common.
+    // The sum of the weights is exact in double precision, so the result does not depend of
+    // the order of the coefficients, as with the inverted lists of HaarSignatureIndex.
 
-    int x        = 0;
+    int    x        = 0;
+    double coefSum  = 0.0;
 
     for (int channel = 0 ; channel < 3 ; ++channel)
     {
@@ -1061,11 +1164,13 @@ double HaarIface::calculateScore(const Haar::SignatureData& querySig,
 
             if ((queryMap)[x])
             {
-                score -= weights.weight(d->weightBin.binAbs(x), channel);
+                coefSum += weights.weight(d->weightBin.binAbs(x), channel);
             }
         }
     }
 
+    score -= coefSum;
+
     return score;
 }
 
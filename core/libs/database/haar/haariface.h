@@ -18,6 +18,10 @@
 
 #pragma once
 
+// C++ includes
+
+#include <limits>
+
 // Qt includes
 
 #include <QSet>
@@ -107,6 +111,23 @@ public:
 
     using DuplicatesResultsMap = QMap<qlonglong, QPair<double, QList<qlonglong> > >;
 
+    /**
+     * The duplicates found for one scanned image.
+     */
+    class DuplicatesScan
+    {
+    public:
+
+        qlonglong        reference  = -1;       ///< The reference image, -1 if the image has no duplicates.
+        double           similarity = 0.0;
+        QList<qlonglong> duplicates;            ///< The best matches, with the scanned image.
+    };
+
+    /**
+     * The scans of the images, by scanned image id.
+     */
+    using DuplicatesScansMap   = QMap<qlonglong, DuplicatesScan>;
+
 public:
 
     explicit HaarIface();
@@ -124,6 +145,19 @@ public:
     bool indexImage(qlonglong imageid, const QImage& image);
     bool indexImage(qlonglong imageid, const DImg& image);
 
+    /**
+     * Computes the Haar signature of an image, without storing it.
+     * The image is best loaded at preferredSize().
+     */
+    bool calculateSignature(const DImg& image, Haar::SignatureData& sig);
+
+    /**
+     * Stores the signatures of several images in the database within one transaction,
+     * and adds them to the in-memory signature index. The images which are not visible
+     * in the collection anymore are skipped.
+     */
+    static void storeSignatures(const QList<QPair<qlonglong, Haar::SignatureData> >& signatures);
+
     QMap<qlonglong, double> bestMatchesForSignature(const QString& signature,
                                                     const QList<int>& targetAlbums,
                                                     int numberOfResults = 20,
@@ -187,20 +221,39 @@ public:
      * Fill a map of duplicates images found over a list of images to scan.
      * For each map item, the result values is list of candidate images which are duplicates of the key image.
      * All images are referenced by id from database.
+     * Only the images of 'images2ScanChunk', a subset of 'images2Scan', are scanned,
+     * so that several threads can share the work over the same HaarIface instance.
+     * 'threadsCount' is the number of threads scanning 'images2Scan' at the same time.
+     * With only one thread, the images without duplicates are removed from the signature
+     * cache once scanned, to speed up the next searches.
      * The threshold is in the range 0..1, with 1 meaning identical signature.
+     * The images of the chunk already found as duplicates in it are not scanned.
+     * If 'scans' is not null, the scans of the other images are stored in it.
      */
     DuplicatesResultsMap findDuplicates(
         const QSet<qlonglong>& images2Scan,
-        const QSet<qlonglong>::const_iterator& rangeBegin,
-        const QSet<qlonglong>::const_iterator& rangeEnd,
+        const QList<qlonglong>& images2ScanChunk,
+        int threadsCount,
         RefImageSelMethod refImageSelectionMethod,
         const QSet<qlonglong>& refs,
         double requiredPercentage,
         double maximumPercentage,
         DuplicatesSearchRestrictions searchResultRestriction = DuplicatesSearchRestrictions::None,
-        HaarProgressObserver* const observer = nullptr
+        HaarProgressObserver* const observer = nullptr,
+        DuplicatesScansMap* const scans = nullptr
     );
 
+    /**
+     * Find the duplicates of one image and select their reference image,
+     * as findDuplicates() does for each image scanned.
+     */
+    DuplicatesScan scanForDuplicates(qlonglong imageId,
+                                     RefImageSelMethod refImageSelectionMethod,
+                                     const QSet<qlonglong>& refs,
+                                     double requiredPercentage,
+                                     double maximumPercentage,
+                                     DuplicatesSearchRestrictions searchResultRestriction);
+
     /**
      * Collects all images from the given album and tag ids according to their relation.
      */
@@ -275,6 +328,7 @@ private:
      * @param searchResultRestriction restrictions to apply to the generated map, i.e. None (default), same album or different album.
      * @param originalImageId the id of the original image to compare to other images. -1 is only used for sketch search.
      * @param albumId The album which images must or must not belong to (depending on searchResultRestriction).
+     * @param maxScore Only the images with a score lower or equal to this value are returned.
      * @return The map of image ids and scores which fulfill the restrictions, if any.
      */
     QMap<qlonglong, double> searchDatabase(Haar::SignatureData* const data,
@@ -282,7 +336,8 @@ private:
                                            const QList<int>& targetAlbums,
                                            DuplicatesSearchRestrictions searchResultRestriction = None,
                                            qlonglong originalImageId = -1,
-                                           int albumId = -1);
+                                           int albumId = -1,
+                                           double maxScore = std::numeric_limits<double>::max());
 
     double calculateScore(const Haar::SignatureData& querySig,
                           const Haar::SignatureData& targetSig,
@@ -96,27 +96,14 @@ HaarIface::Private::Private()
 
 void HaarIface::Private::rebuildSignatureCache(const QSet<qlonglong>& imageIds)
 {
-    m_signatureCache.reset(new SignatureCache);
-    m_albumCache.reset(new AlbumCache);
-
-    // Variables for data read from DB
+    HaarSignatureIndex* const index = HaarSignatureIndex::instance();
+    index->load();
 
-    DatabaseBlob        blob;
-    qlonglong           imageid;
-    int                 albumid;
-    Haar::SignatureData targetSig;
+    m_albumCache.reset(new AlbumCache);
 
     // reference for easier access
 
-    SignatureCache& sigCache = *m_signatureCache;
-    AlbumCache&     albCache = *m_albumCache;
-
-    DbEngineSqlQuery query   = SimilarityDbAccess().backend()->prepareQuery(signatureQuery);
-
-    if (!SimilarityDbAccess().backend()->exec(query))
-    {
-        return;
-    }
+    AlbumCache& albCache = *m_albumCache;
 
     QHash<qlonglong, QPair<int, int> > itemAlbumHash = CoreDbAccess().db()->getAllItemsWithAlbum();
 
@@ -139,16 +126,17 @@ void HaarIface::Private::rebuildSignatureCache(const QSet<qlonglong>& imageIds)
     }
 
     const bool filterByAlbumRoots = !m_albumRootsToSearch.isEmpty();
+    const QList<qlonglong> ids    = index->imageIds();
 
-    while (query.next())
+    for (const qlonglong& imageid : ids)
     {
-        imageid = query.value(0).toLongLong();
+        QHash<qlonglong, QPair<int, int> >::const_iterator it = itemAlbumHash.constFind(imageid);
 
-        if (itemAlbumHash.contains(imageid))
+        if (it != itemAlbumHash.constEnd())
         {
             // Pair storage of <albumroootid, albumid>
 
-            const QPair<int, int>& albumPair = itemAlbumHash.value(imageid);
+            const QPair<int, int>& albumPair = it.value();
 
             if (filterByAlbumRoots)
             {
@@ -158,17 +146,17 @@ void HaarIface::Private::rebuildSignatureCache(const QSet<qlonglong>& imageIds)
                 }
             }
 
-            blob.read(query.value(1).toByteArray(), targetSig);
-            albumid           = albumPair.second;
-            sigCache[imageid] = targetSig;
-            albCache[imageid] = albumid;
+            albCache[imageid] = albumPair.second;
         }
     }
+
+    QWriteLocker locker(&m_rowLock);
+    m_rowAlbums = index->rowValues(albCache, &m_rowGeneration);
 }
 
 bool HaarIface::Private::hasSignatureCache() const
 {
-    return !(m_signatureCache.isNull() || m_signatureCache->isEmpty());
+    return !(m_albumCache.isNull() || m_albumCache->isEmpty());
 }
 
 bool HaarIface::Private::retrieveSignatureFromCache(qlonglong imageId, Haar::SignatureData& data)
@@ -178,29 +166,68 @@ bool HaarIface::Private::retrieveSignatureFromCache(qlonglong imageId, Haar::Sig
         return false;
     }
 
-    if (m_signatureCache->contains(imageId))
+    if (m_albumCache->contains(imageId))
     {
-        data = m_signatureCache->value(imageId);
-
-        return true;
+        return HaarSignatureIndex::instance()->signature(imageId, data);
     }
 
     return false;
 }
 
-void HaarIface::Private::setImageDataFromImage(const QImage& image)
+void HaarIface::Private::removeFromSignatureCache(qlonglong imageId)
 {
-    m_data->fillPixelData(image);
+    QWriteLocker locker(&m_rowLock);
+
+    if (m_albumCache)
+    {
+        m_albumCache->remove(imageId);
+    }
+
+    const int row = HaarSignatureIndex::instance()->row(imageId, m_rowGeneration);
+
+    if ((row >= 0) && (row < m_rowAlbums.size()))
+    {
+        m_rowAlbums[row] = -1;
+    }
 }
 
-void HaarIface::Private::setImageDataFromImage(const DImg& image)
+QList<HaarSignatureIndex::Match> HaarIface::Private::searchSignatureCache(const Haar::SignatureData& querySig,
+                                                                          const Haar::Weights& weights,
+                                                                          double maxScore)
+{
+    HaarSignatureIndex* const index = HaarSignatureIndex::instance();
+    QList<HaarSignatureIndex::Match> matches;
+
+    Q_FOREVER
+    {
+        {
+            QReadLocker locker(&m_rowLock);
+
+            if (index->score(querySig, weights, m_rowAlbums, m_rowGeneration, maxScore, matches))
+            {
+                return matches;
+            }
+        }
+
+        // The index rows have been renumbered since the last mapping.
+
+        QWriteLocker locker(&m_rowLock);
+
+        if (m_albumCache)
+        {
+            m_rowAlbums = index->rowValues(*m_albumCache, &m_rowGeneration);
+        }
+    }
+}
+
+void HaarIface::Private::setImageDataFromImage(const QImage& image)
 {
     m_data->fillPixelData(image);
 }
 
-SignatureCache* HaarIface::Private::signatureCache() const
+void HaarIface::Private::setImageDataFromImage(const DImg& image)
 {
-    return m_signatureCache.data();
+    m_data->fillPixelData(image);
 }
 
 AlbumCache* HaarIface::Private::albumCache() const
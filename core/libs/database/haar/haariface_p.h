@@ -34,6 +34,7 @@
 #include <QImage>
 #include <QImageReader>
 #include <QMap>
+#include <QReadWriteLock>
 
 // Local includes
 
@@ -51,6 +52,7 @@
 #include "similaritydb.h"
 #include "similaritydbaccess.h"
 #include "previewloadthread.h"
+#include "haarsignatureindex.h"
 
 using namespace std;
 
@@ -59,8 +61,7 @@ using namespace std;
 namespace Digikam
 {
 
-typedef QMap<qlonglong, Haar::SignatureData> SignatureCache;
-typedef QMap<qlonglong, int>                 AlbumCache;
+typedef QMap<qlonglong, int> AlbumCache;
 
 /**
  * This class encapsulates the Haar signature in a QByteArray
@@ -101,15 +102,27 @@ public:
 
 public:
 
+    /**
+     * Select the signatures of the shared HaarSignatureIndex to search in,
+     * with the album of each image.
+     */
     void rebuildSignatureCache(const QSet<qlonglong>& imageIds = {});
     bool hasSignatureCache()              const;
 
     bool retrieveSignatureFromCache(qlonglong imageId, Haar::SignatureData& data);
+    void removeFromSignatureCache(qlonglong imageId);
+
+    /**
+     * Score the selected signatures against the query signature.
+     * Only the images with a score lower or equal to 'maxScore' are returned.
+     */
+    QList<HaarSignatureIndex::Match> searchSignatureCache(const Haar::SignatureData& querySig,
+                                                          const Haar::Weights& weights,
+                                                          double maxScore);
 
     void setImageDataFromImage(const QImage& image);
     void setImageDataFromImage(const DImg& image);
 
-    SignatureCache*  signatureCache()     const;
     AlbumCache*      albumCache()         const;
     Haar::ImageData* imageData()          const;
 
@@ -118,14 +131,20 @@ public:
 
 public:
 
-    const QString                   signatureQuery = QString::fromUtf8("SELECT imageid, matrix FROM ImageHaarMatrix;");
     const Haar::WeightBin           weightBin;
 
 private:
 
-    QScopedPointer<SignatureCache>  m_signatureCache;
     QScopedPointer<AlbumCache>      m_albumCache;
 
+    /**
+     * The album of each HaarSignatureIndex row selected in m_albumCache, -1 otherwise,
+     * for the index generation m_rowGeneration.
+     */
+    QVector<int>                    m_rowAlbums;
+    int                             m_rowGeneration = -1;
+    QReadWriteLock                  m_rowLock;
+
     QScopedPointer<Haar::ImageData> m_data;
 
     QSet<int>                       m_albumRootsToSearch;
@@ -0,0 +1,659 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Persistent in-memory index of Haar signatures
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "haarsignatureindex.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <vector>
+
+// Qt includes
+
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QElapsedTimer>
+
+// Local includes
+
+#include "haariface_p.h"
+#include "dbengineparameters.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN HaarSignatureIndex::Private
+{
+public:
+
+    enum
+    {
+        CoefficientsPerRow = 3 * Haar::NumberOfCoefficients,
+        SlotsPerChannel    = 2 * Haar::NumberOfPixelsSquared
+    };
+
+    /**
+     * An update received while the index is loading from the database,
+     * to replay after the load.
+     */
+    class PendingUpdate
+    {
+    public:
+
+        enum Type
+        {
+            Insert = 0,
+            Copy,
+            Remove
+        };
+
+    public:
+
+        Type                type   = Insert;
+        qlonglong           id     = -1;
+        qlonglong           srcId  = -1;
+        Haar::SignatureData sig;
+    };
+
+public:
+
+    Private() = default;
+
+    static bool isValidCoefficient(Haar::Idx coef)
+    {
+        return ((coef > -Haar::NumberOfPixelsSquared) && (coef < Haar::NumberOfPixelsSquared));
+    }
+
+    void clear()
+    {
+        ids.clear();
+        alive.clear();
+        coefficients.clear();
+        rows.clear();
+
+        for (int c = 0 ; c < 3 ; ++c)
+        {
+            avg[c].clear();
+
+            for (int i = 0 ; i < SlotsPerChannel ; ++i)
+            {
+                postings[c][i].clear();
+            }
+        }
+
+        deadRows = 0;
+    }
+
+    void append(qlonglong imageId, const Haar::SignatureData& sig)
+    {
+        // An updated signature replaces the previous row.
+
+        kill(imageId);
+
+        const int row = ids.size();
+
+        ids.append(imageId);
+        alive.append(1);
+        rows.insert(imageId, row);
+
+        for (int c = 0 ; c < 3 ; ++c)
+        {
+            avg[c].append(sig.avg[c]);
+
+            for (int i = 0 ; i < Haar::NumberOfCoefficients ; ++i)
+            {
+                const Haar::Idx coef = sig.sig[c][i];
+                coefficients.append(coef);
+
+                if (isValidCoefficient(coef))
+                {
+                    postings[c][coef + Haar::NumberOfPixelsSquared].append(row);
+                }
+            }
+        }
+    }
+
+    void kill(qlonglong imageId)
+    {
+        QHash<qlonglong, int>::iterator it = rows.find(imageId);
+
+        if (it != rows.end())
+        {
+            alive[it.value()] = 0;
+            rows.erase(it);
+            ++deadRows;
+        }
+    }
+
+    void readSignature(int row, Haar::SignatureData& sig) const
+    {
+        const Haar::Idx* coefs = coefficients.constData() + row * CoefficientsPerRow;
+
+        for (int c = 0 ; c < 3 ; ++c)
+        {
+            sig.avg[c] = avg[c].at(row);
+
+            for (int i = 0 ; i < Haar::NumberOfCoefficients ; ++i)
+            {
+                sig.sig[c][i] = *coefs++;
+            }
+        }
+    }
+
+    void swapData(Private& other)
+    {
+        ids.swap(other.ids);
+        alive.swap(other.alive);
+        coefficients.swap(other.coefficients);
+        rows.swap(other.rows);
+
+        for (int c = 0 ; c < 3 ; ++c)
+        {
+            avg[c].swap(other.avg[c]);
+
+            for (int i = 0 ; i < SlotsPerChannel ; ++i)
+            {
+                postings[c][i].swap(other.postings[c][i]);
+            }
+        }
+
+        std::swap(deadRows, other.deadRows);
+    }
+
+    void copy(qlonglong srcId, qlonglong dstId)
+    {
+        const int row = rows.value(srcId, -1);
+
+        if (row != -1)
+        {
+            Haar::SignatureData sig;
+            readSignature(row, sig);
+            append(dstId, sig);
+        }
+    }
+
+    void compact()
+    {
+        QVector<qlonglong> oldIds    = ids;
+        QVector<quint8>    oldAlive  = alive;
+        QVector<double>    oldAvg[3] = { avg[0], avg[1], avg[2] };
+        QVector<Haar::Idx> oldCoefs  = coefficients;
+
+        clear();
+
+        Haar::SignatureData sig;
+
+        for (int row = 0 ; row < oldIds.size() ; ++row)
+        {
+            if (!oldAlive.at(row))
+            {
+                continue;
+            }
+
+            const Haar::Idx* coefs = oldCoefs.constData() + row * CoefficientsPerRow;
+
+            for (int c = 0 ; c < 3 ; ++c)
+            {
+                sig.avg[c] = oldAvg[c].at(row);
+
+                for (int i = 0 ; i < Haar::NumberOfCoefficients ; ++i)
+                {
+                    sig.sig[c][i] = *coefs++;
+                }
+            }
+
+            append(oldIds.at(row), sig);
+        }
+
+        ++generation;
+    }
+
+    /**
+     * Compact the rows when more than a quarter of them are dead. The small indexes
+     * are not compacted, as the renumbering costs more than scoring the dead rows.
+     */
+    void compactIfNeeded()
+    {
+        if ((ids.size() >= 1024) && (deadRows > (ids.size() / 4)))
+        {
+            compact();
+        }
+    }
+
+public:
+
+    QVector<qlonglong>    ids;
+    QVector<quint8>       alive;
+    QVector<double>       avg[3];
+    QVector<Haar::Idx>    coefficients;                         ///< CoefficientsPerRow entries per row.
+    QHash<qlonglong, int> rows;                                 ///< Live rows only.
+
+    /**
+     * Inverted lists: rows using a coefficient, per channel,
+     * indexed by the signed coefficient + NumberOfPixelsSquared.
+     */
+    QVector<int>          postings[3][SlotsPerChannel];
+
+    int                   deadRows   = 0;
+    int                   generation = 0;
+    bool                  loaded     = false;
+    bool                  loading    = false;
+    DbEngineParameters    parameters;
+    QList<PendingUpdate>  pendingUpdates;
+
+    const Haar::WeightBin weightBin;
+
+    mutable QReadWriteLock lock;
+
+    /**
+     * Serialize the loads. The database is read without holding 'lock', as a
+     * database access can call insert(), copy() or remove() with its own lock held.
+     */
+    QMutex                loadMutex;
+};
+
+// -----------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN HaarSignatureIndexCreator
+{
+public:
+
+    HaarSignatureIndex object;
+};
+
+Q_GLOBAL_STATIC(HaarSignatureIndexCreator, haarSignatureIndexCreator)
+
+// -----------------------------------------------------------------------------------------------
+
+HaarSignatureIndex::HaarSignatureIndex()
+    : d(new Private)
+{
+}
+
+HaarSignatureIndex::~HaarSignatureIndex()
+{
+    delete d;
+}
+
+HaarSignatureIndex* HaarSignatureIndex::instance()
+{
+    return &haarSignatureIndexCreator->object;
+}
+
+void HaarSignatureIndex::load()
+{
+    const DbEngineParameters parameters = SimilarityDbAccess::parameters();
+
+    QMutexLocker loadLocker(&d->loadMutex);
+
+    {
+        QWriteLocker locker(&d->lock);
+
+        if (d->loaded && (d->parameters == parameters))
+        {
+            d->compactIfNeeded();
+
+            return;
+        }
+
+        d->loading = true;
+        d->pendingUpdates.clear();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QScopedPointer<Private> data(new Private);
+
+    DbEngineSqlQuery query = SimilarityDbAccess().backend()->prepareQuery(QString::fromUtf8("SELECT imageid, matrix FROM ImageHaarMatrix;"));
+    bool ok                = SimilarityDbAccess().backend()->exec(query);
+
+    if (ok)
+    {
+        DatabaseBlob        blob;
+        Haar::SignatureData sig;
+
+        while (query.next())
+        {
+            blob.read(query.value(1).toByteArray(), sig);
+            data->append(query.value(0).toLongLong(), sig);
+        }
+    }
+
+    QWriteLocker locker(&d->lock);
+
+    d->loading = false;
+
+    if (!ok)
+    {
+        d->pendingUpdates.clear();
+
+        return;
+    }
+
+    d->swapData(*data);
+
+    // Replay the updates received while reading the database.
+
+    for (const Private::PendingUpdate& update : std::as_const(d->pendingUpdates))
+    {
+        switch (update.type)
+        {
+            case Private::PendingUpdate::Insert:
+            {
+                d->append(update.id, update.sig);
+                break;
+            }
+
+            case Private::PendingUpdate::Copy:
+            {
+                d->copy(update.srcId, update.id);
+                break;
+            }
+
+            case Private::PendingUpdate::Remove:
+            {
+                d->kill(update.id);
+                break;
+            }
+        }
+    }
+
+    d->pendingUpdates.clear();
+
+    d->loaded     = true;
+    d->parameters = parameters;
+    ++d->generation;
+
+    qCDebug(DIGIKAM_DATABASE_LOG) << "Haar signature index loaded with" << d->rows.size()
+                                  << "signatures in" << timer.elapsed() << "ms";
+}
+
+void HaarSignatureIndex::insert(qlonglong imageId, const Haar::SignatureData& sig)
+{
+    QWriteLocker locker(&d->lock);
+
+    if      (d->loading)
+    {
+        Private::PendingUpdate update;
+        update.type = Private::PendingUpdate::Insert;
+        update.id   = imageId;
+        update.sig  = sig;
+        d->pendingUpdates << update;
+    }
+    else if (d->loaded)
+    {
+        d->append(imageId, sig);
+
+        d->compactIfNeeded();
+    }
+}
+
+void HaarSignatureIndex::copy(qlonglong srcId, qlonglong dstId)
+{
+    QWriteLocker locker(&d->lock);
+
+    if (d->loading)
+    {
+        Private::PendingUpdate update;
+        update.type  = Private::PendingUpdate::Copy;
+        update.id    = dstId;
+        update.srcId = srcId;
+        d->pendingUpdates << update;
+    }
+    else
+    {
+        d->copy(srcId, dstId);
+
+        d->compactIfNeeded();
+    }
+}
+
+void HaarSignatureIndex::remove(qlonglong imageId)
+{
+    QWriteLocker locker(&d->lock);
+
+    if (d->loading)
+    {
+        Private::PendingUpdate update;
+        update.type = Private::PendingUpdate::Remove;
+        update.id   = imageId;
+        d->pendingUpdates << update;
+    }
+    else
+    {
+        d->kill(imageId);
+
+        d->compactIfNeeded();
+    }
+}
+
+bool HaarSignatureIndex::contains(qlonglong imageId) const
+{
+    QReadLocker locker(&d->lock);
+
+    return d->rows.contains(imageId);
+}
+
+bool HaarSignatureIndex::signature(qlonglong imageId, Haar::SignatureData& sig) const
+{
+    QReadLocker locker(&d->lock);
+
+    const int row = d->rows.value(imageId, -1);
+
+    if (row == -1)
+    {
+        return false;
+    }
+
+    d->readSignature(row, sig);
+
+    return true;
+}
+
+QList<qlonglong> HaarSignatureIndex::imageIds() const
+{
+    QReadLocker locker(&d->lock);
+
+    return d->rows.keys();
+}
+
+QVector<int> HaarSignatureIndex::rowValues(const QMap<qlonglong, int>& values, int* const generation) const
+{
+    QReadLocker locker(&d->lock);
+
+    QVector<int> result(d->ids.size(), -1);
+
+    for (QMap<qlonglong, int>::const_iterator it = values.constBegin() ; it != values.constEnd() ; ++it)
+    {
+        const int row = d->rows.value(it.key(), -1);
+
+        if (row != -1)
+        {
+            result[row] = it.value();
+        }
+    }
+
+    *generation = d->generation;
+
+    return result;
+}
+
+int HaarSignatureIndex::row(qlonglong imageId, int generation) const
+{
+    QReadLocker locker(&d->lock);
+
+    if (generation != d->generation)
+    {
+        return -1;
+    }
+
+    return d->rows.value(imageId, -1);
+}
+
+bool HaarSignatureIndex::score(const Haar::SignatureData& query,
+                               const Haar::Weights& weights,
+                               const QVector<int>& rowValues,
+                               int generation,
+                               double maxScore,
+                               QList<Match>& matches) const
+{
+    QReadLocker locker(&d->lock);
+
+    if (generation != d->generation)
+    {
+        return false;
+    }
+
+    // Rows appended after the row values computation are not part of the search.
+
+    const int rowCount = qMin(rowValues.size(), d->ids.size());
+
+    // Scratch buffers are kept per thread to not allocate and clear megabytes for each query.
+
+    thread_local std::vector<double> coefSums;
+    thread_local std::vector<int>    touched;
+
+    if ((int)coefSums.size() < rowCount)
+    {
+        coefSums.resize(rowCount, 0.0);
+    }
+
+    // Step 1: Sum the weights of the coefficients that query and targets have in common,
+    // walking the inverted list of each query coefficient. The rows found are the candidates.
+
+    double* const sums = coefSums.data();
+
+    for (int c = 0 ; c < 3 ; ++c)
+    {
+        Haar::Idx coefs[Haar::NumberOfCoefficients];
+        std::copy(query.sig[c], query.sig[c] + Haar::NumberOfCoefficients, coefs);
+        std::sort(coefs, coefs + Haar::NumberOfCoefficients);
+
+        for (int k = 0 ; k < Haar::NumberOfCoefficients ; ++k)
+        {
+            const Haar::Idx coef = coefs[k];
+
+            if (((k > 0) && (coef == coefs[k - 1])) || !Private::isValidCoefficient(coef))
+            {
+                continue;
+            }
+
+            const QVector<int>& list = d->postings[c][coef + Haar::NumberOfPixelsSquared];
+            const double weight      = weights.weight(d->weightBin.binAbs(coef), c);
+
+            for (const int row : list)
+            {
+                if (row >= rowCount)
+                {
+                    break;      // Lists are sorted by row.
+                }
+
+                if (sums[row] == 0.0)
+                {
+                    touched.push_back(row);
+                }
+
+                sums[row] += weight;
+            }
+        }
+    }
+
+    // Step 2: Score the rows with the average intensity values of all three channels, then
+    // subtract the sum of the weights at once, as HaarIface::calculateScore(). This sum is
+    // exact in double precision, whatever the order.
+
+    const double  q0     = query.avg[0];
+    const double  q1     = query.avg[1];
+    const double  q2     = query.avg[2];
+    const double  w0     = weights.weightForAverage(0);
+    const double  w1     = weights.weightForAverage(1);
+    const double  w2     = weights.weightForAverage(2);
+    const double* a0     = d->avg[0].constData();
+    const double* a1     = d->avg[1].constData();
+    const double* a2     = d->avg[2].constData();
+    const int*    values = rowValues.constData();
+    const quint8* alive  = d->alive.constData();
+
+    auto addMatch = [&](int row, double score)
+    {
+        Match match;
+        match.imageId = d->ids.at(row);
+        match.value   = values[row];
+        match.score   = score;
+        matches << match;
+    };
+
+    if (maxScore < 0.0)
+    {
+        // The average term is never negative: a row can only reach a negative score with at least
+        // -maxScore of common coefficient weights. The rows without common coefficients are skipped
+        // without being read, so the cost only depends on the inverted lists of the query.
+
+        const double minSum = -maxScore;
+
+        for (const int row : touched)
+        {
+            const double sum = sums[row];
+            sums[row]        = 0.0;
+
+            if ((sum < minSum) || (values[row] < 0) || !alive[row])
+            {
+                continue;
+            }
+
+            double score = w0 * fabs(q0 - a0[row]) + w1 * fabs(q1 - a1[row]) + w2 * fabs(q2 - a2[row]);
+            score       -= sum;
+
+            if (score <= maxScore)
+            {
+                addMatch(row, score);
+            }
+        }
+
+        touched.clear();
+
+        return true;
+    }
+
+    // A threshold not lower than zero can be reached without common coefficients: all rows are scored.
+
+    for (int row = 0 ; row < rowCount ; ++row)
+    {
+        if ((values[row] < 0) || !alive[row])
+        {
+            continue;
+        }
+
+        double score = w0 * fabs(q0 - a0[row]) + w1 * fabs(q1 - a1[row]) + w2 * fabs(q2 - a2[row]);
+        score       -= sums[row];
+
+        if (score <= maxScore)
+        {
+            addMatch(row, score);
+        }
+    }
+
+    for (const int row : touched)
+    {
+        sums[row] = 0.0;
+    }
+
+    touched.clear();
+
+    return true;
+}
+
+} // namespace Digikam
@@ -0,0 +1,134 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Persistent in-memory index of Haar signatures
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QList>
+#include <QMap>
+#include <QVector>
+
+// Local includes
+
+#include "haar.h"
+
+namespace Digikam
+{
+
+/**
+ * This class hosts all the Haar signatures of the similarity database in memory, for
+ * the whole application life. It is loaded once from the ImageHaarMatrix table and
+ * updated incrementally when a fingerprint is written, copied or removed.
+ *
+ * Data are stored as a structure of arrays: one contiguous array per channel average
+ * and one contiguous array of coefficients. Each entry is a "row". An inverted list
+ * per channel and per signed coefficient index gives the rows using this coefficient,
+ * as described in the "Fast Multiresolution Image Querying" paper. The rows sharing
+ * coefficients with a query are found with the 3 x 40 inverted lists of the query
+ * coefficients. With a negative score threshold, as used by the duplicates search, only
+ * these candidates are scored and the other rows are never read.
+ *
+ * Rows of removed or updated signatures are kept as dead entries until the next
+ * compaction, when more than a quarter of the rows are dead. A compaction renumbers
+ * all rows and increases the generation counter.
+ * All methods are thread-safe.
+ */
+class HaarSignatureIndex
+{
+public:
+
+    class Match
+    {
+    public:
+
+        qlonglong imageId = -1;
+        int       value   = -1;     ///< The row value passed to score().
+        double    score   = 0.0;
+    };
+
+public:
+
+    static HaarSignatureIndex* instance();
+
+    /**
+     * Load all signatures from the similarity database if not yet done, or if the
+     * database settings changed since the last load. Compact the index if too many
+     * rows are dead.
+     */
+    void load();
+
+    /**
+     * Add or replace the signature of an image. Do nothing if the index is not loaded:
+     * the signature will be read from the database with the next load().
+     */
+    void insert(qlonglong imageId, const Haar::SignatureData& sig);
+
+    /**
+     * Give to the destination image the signature of the source image, if any.
+     */
+    void copy(qlonglong srcId, qlonglong dstId);
+
+    void remove(qlonglong imageId);
+
+    bool contains(qlonglong imageId)                                     const;
+    bool signature(qlonglong imageId, Haar::SignatureData& sig)          const;
+    QList<qlonglong> imageIds()                                          const;
+
+    /**
+     * Map image ids to rows. The returned vector has one entry per row: the value of
+     * 'values' for the image id of this row, or -1 if the image is not listed.
+     * 'generation' is set to the generation of the returned mapping.
+     */
+    QVector<int> rowValues(const QMap<qlonglong, int>& values, int* const generation) const;
+
+    /**
+     * Return the row of an image for the given generation, or -1.
+     */
+    int row(qlonglong imageId, int generation)                           const;
+
+    /**
+     * Score all live rows with a value >= 0 in 'rowValues' against the query signature.
+     * Scores are the same as HaarIface::calculateScore(), lower is better.
+     * Only rows with a score lower or equal to 'maxScore' are appended to 'matches', in no
+     * particular order. A negative 'maxScore' limits the scoring to the rows sharing
+     * coefficients with the query.
+     * Return false, without scoring, if 'generation' is not the current one: the
+     * row values must be recomputed with rowValues().
+     */
+    bool score(const Haar::SignatureData& query,
+               const Haar::Weights& weights,
+               const QVector<int>& rowValues,
+               int generation,
+               double maxScore,
+               QList<Match>& matches)                                    const;
+
+private:
+
+    // Disable
+    HaarSignatureIndex();
+    ~HaarSignatureIndex();
+
+    explicit HaarSignatureIndex(const HaarSignatureIndex&) = delete;
+    HaarSignatureIndex& operator=(const HaarSignatureIndex&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+
+    friend class HaarSignatureIndexCreator;
+};
+
+} // namespace Digikam
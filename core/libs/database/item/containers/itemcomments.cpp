@@ -33,9 +33,14 @@ public:
     Private() = default;
 
     void init(const CoreDbAccess& access, qlonglong imageId)
+    {
+        init(imageId, access.db()->getItemComments(imageId));
+    }
+
+    void init(qlonglong imageId, const QList<CommentInfo>& comments)
     {
         id    = imageId;
-        infos = access.db()->getItemComments(id);
+        infos = comments;
 
         for (int i = 0 ; i < infos.size() ; ++i)
         {
@@ -158,6 +163,12 @@ ItemComments::ItemComments(const CoreDbAccess& access, qlonglong imageid)
     d->init(access, imageid);
 }
 
+ItemComments::ItemComments(qlonglong imageid, const QList<CommentInfo>& comments)
+    : d(new Private)
+{
+    d->init(imageid, comments);
+}
+
 ItemComments::ItemComments(const ItemComments& other)
     : d(other.d)
 {
@@ -100,6 +100,12 @@ public:
      */
     ItemComments(const CoreDbAccess& access, qlonglong imageid);
 
+    /**
+     * Create a ItemComments object for the image with the specified id,
+     * from the comments of the image already read from the database.
+     */
+    ItemComments(qlonglong imageid, const QList<CommentInfo>& comments);
+
     ItemComments(const ItemComments& other);
     ~ItemComments();
 
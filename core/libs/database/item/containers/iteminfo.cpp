@@ -30,7 +30,7 @@ ItemInfo::ItemInfo(const ItemListerRecord& record)
     // cppcheck-suppress useInitializationList
     m_data                         = ItemInfoStatic::cache()->infoForId(record.imageID);
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     bool newlyCreated              = (m_data->albumId == -1);
 
     m_data->albumId                = record.albumID;
@@ -81,7 +81,7 @@ ItemInfo::ItemInfo(qlonglong ID)
 
         if (info.id)
         {
-            ItemInfoWriteLocker lock;
+            ItemInfoWriteLocker lock(m_data.data());
             m_data->albumId     = info.albumID;
             m_data->albumRootId = info.albumRootID;
             m_data->name        = info.itemName;
@@ -209,7 +209,7 @@ ItemInfo ItemInfo::fromLocationAlbumAndName(int locationId, const QString& album
 
         info.m_data              = ItemInfoStatic::cache()->infoForId(shortInfo.id);
 
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(info.m_data.data());
         info.m_data->albumId     = shortInfo.albumID;
         info.m_data->albumRootId = shortInfo.albumRootID;
         info.m_data->name        = shortInfo.itemName;
@@ -228,7 +228,7 @@ ItemInfo ItemInfo::copyItem(int dstAlbumID, const QString& dstFileName)
     }
 
     {
-        ItemInfoReadLocker lock;
+        ItemInfoReadLocker lock(m_data.data());
 
         if ((dstAlbumID == m_data->albumId) && (dstFileName == m_data->name))
         {
@@ -31,7 +31,7 @@ ItemPosition ItemInfo::imagePosition() const
 
     if (!m_data->positionsCached)
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data.data()->longitude       = pos.longitudeNumber();
         m_data.data()->latitude        = pos.latitudeNumber();
         m_data.data()->altitude        = pos.altitude();
@@ -50,7 +50,7 @@ qlonglong ItemInfo::groupImageId() const
 
     int groupImage       = ids.isEmpty() ? -1 : ids.first();
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->groupImage       = groupImage;
     m_data.data()->groupImageCached = true;
 
@@ -77,8 +77,6 @@ void ItemInfoList::loadGroupImageIds() const
     QVector<QList<qlonglong> > allGroupIds = CoreDbAccess().db()->getImagesRelatedFrom(infoList.toImageIdList(),
                                                                                        DatabaseRelation::Grouped);
 
-    ItemInfoWriteLocker lock;
-
     for (int i = 0 ; i < infoList.size() ; ++i)
     {
         const ItemInfo& info             = infoList.at(i);
@@ -89,6 +87,7 @@ void ItemInfoList::loadGroupImageIds() const
             continue;
         }
 
+        ItemInfoWriteLocker lock(info.m_data.data());
         info.m_data.data()->groupImage       = groupIds.isEmpty() ? -1 : groupIds.first();
         info.m_data.data()->groupImageCached = true;
     }
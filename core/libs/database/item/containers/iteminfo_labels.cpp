@@ -31,7 +31,7 @@ int ItemInfo::pickLabel() const
 
     int pickLabel = TagsCache::instance()->pickLabelFromTags(tagIds());
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->pickLabel       = (pickLabel == -1) ? NoPickLabel : pickLabel;
     m_data.data()->pickLabelCached = true;
 
@@ -49,7 +49,7 @@ int ItemInfo::colorLabel() const
 
     int colorLabel = TagsCache::instance()->colorLabelFromTags(tagIds());
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->colorLabel       = (colorLabel == -1) ? NoColorLabel : colorLabel;
     m_data.data()->colorLabelCached = true;
 
@@ -81,7 +81,7 @@ void ItemInfo::setPickLabel(int pickId)
     QVector<int> pickLabelTags = TagsCache::instance()->pickLabelTags();
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->pickLabel       = pickId;
         m_data->pickLabelCached = true;
     }
@@ -115,7 +115,7 @@ void ItemInfo::setColorLabel(int colorId)
     QVector<int> colorLabelTags = TagsCache::instance()->colorLabelTags();
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->colorLabel       = colorId;
         m_data->colorLabelCached = true;
     }
@@ -146,7 +146,7 @@ void ItemInfo::setRating(int value)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->rating       = value;
         m_data->ratingCached = true;
     }
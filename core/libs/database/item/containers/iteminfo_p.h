@@ -63,7 +63,7 @@ MetadataInfo::Field DatabaseImageMetadataFieldsToMetadataInfoField(const Databas
 #define RETURN_IF_CACHED(x)                            \
                                                        \
     {                                                  \
-        ItemInfoReadLocker lock;                       \
+        ItemInfoReadLocker lock(m_data.data());        \
                                                        \
         if (m_data->x##Cached)                         \
         {                                              \
@@ -74,7 +74,7 @@ MetadataInfo::Field DatabaseImageMetadataFieldsToMetadataInfoField(const Databas
 #define RETURN_ASPECTRATIO_IF_IMAGESIZE_CACHED()       \
                                                        \
     {                                                  \
-        ItemInfoReadLocker lock;                       \
+        ItemInfoReadLocker lock(m_data.data());        \
                                                        \
         if (m_data->imageSizeCached)                   \
         {                                              \
@@ -86,7 +86,7 @@ MetadataInfo::Field DatabaseImageMetadataFieldsToMetadataInfoField(const Databas
 #define STORE_IN_CACHE_AND_RETURN(x, retrieveMethod)   \
                                                        \
     {                                                  \
-        ItemInfoWriteLocker lock;                      \
+        ItemInfoWriteLocker lock(m_data.data());       \
                                                        \
         if (!values.isEmpty())                         \
         {                                              \
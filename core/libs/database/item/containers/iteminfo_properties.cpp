@@ -47,7 +47,7 @@ QString ItemInfo::name() const
         return QString();
     }
 
-    ItemInfoReadLocker lock;
+    ItemInfoReadLocker lock(m_data.data());
 
     return m_data->name;
 }
@@ -82,7 +82,7 @@ QString ItemInfo::title() const
         title = comments.defaultComment(DatabaseComment::Title);
     }
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->defaultTitle       = title;
     m_data.data()->defaultTitleCached = true;
 
@@ -105,7 +105,7 @@ QString ItemInfo::comment() const
         comment = comments.defaultComment();
     }
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->defaultComment       = comment;
     m_data.data()->defaultCommentCached = true;
 
@@ -205,7 +205,7 @@ QSize ItemInfo::dimensions() const
 
     QVariantList values = CoreDbAccess().db()->getItemInformation(m_data->id, DatabaseFields::Width | DatabaseFields::Height);
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->imageSizeCached = true;
 
     if (values.size() == 2)
@@ -228,7 +228,7 @@ int ItemInfo::faceCount() const
     FaceTagsEditor fte;
     int count = fte.databaseFaces(m_data->id).count();
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->faceCountCached = true;
     m_data.data()->faceCount       = count;
 
@@ -247,7 +247,7 @@ int ItemInfo::unconfirmedFaceCount() const
     FaceTagsEditor fte;
     int count = fte.unconfirmedNameFaceTagsIfaces(m_data->id).count();
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->unconfirmedFaceCountCached = true;
     m_data.data()->unconfirmedFaceCount       = count;
 
@@ -266,7 +266,7 @@ QMap<QString, QString> ItemInfo::getSuggestedNames() const
     FaceTagsEditor fte;
     QMap<QString, QString> faceSuggestions = fte.getSuggestedNames(m_data->id);
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->faceSuggestionsCached = true;
     m_data.data()->faceSuggestions       = faceSuggestions;
 
@@ -307,7 +307,7 @@ QString ItemInfo::filePath() const
     }
 
     QString album     = ItemInfoStatic::cache()->albumRelativePath(m_data->albumId);
-    ItemInfoReadLocker lock;
+    ItemInfoReadLocker lock(m_data.data());
 
     if (album == QLatin1String("/"))
     {
@@ -387,7 +387,7 @@ void ItemInfo::setManualOrder(qlonglong value)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->manualOrder       = value;
         m_data->manualOrderCached = true;
     }
@@ -403,7 +403,7 @@ void ItemInfo::setOrientation(int value)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->orientation       = value;
         m_data->orientationCached = true;
     }
@@ -419,7 +419,7 @@ void ItemInfo::setName(const QString& newName)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->name = newName;
         ItemInfoStatic::cache()->cacheByName(m_data);
     }
@@ -435,7 +435,7 @@ void ItemInfo::setDateTime(const QDateTime& dateTime)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->creationDate       = dateTime;
         m_data->creationDateCached = true;
     }
@@ -451,7 +451,7 @@ void ItemInfo::setModDateTime(const QDateTime& dateTime)
     }
 
     {
-        ItemInfoWriteLocker lock;
+        ItemInfoWriteLocker lock(m_data.data());
         m_data->modificationDate       = dateTime;
         m_data->modificationDateCached = true;
     }
@@ -473,7 +473,7 @@ ItemInfo::DatabaseFieldsHashRaw ItemInfo::getDatabaseFieldsRaw(const DatabaseFie
     // consolidate to one ReadLocker. In particular, the shallow copy of the QHash must be done under protection
 
     {
-        ItemInfoReadLocker lock;
+        ItemInfoReadLocker lock(m_data.data());
         cachedVideoMetadata = m_data->videoMetadataCached;
         cachedImageMetadata = m_data->imageMetadataCached;
         cachedHash = m_data->databaseFieldsHashRaw;
@@ -488,7 +488,7 @@ ItemInfo::DatabaseFieldsHashRaw ItemInfo::getDatabaseFieldsRaw(const DatabaseFie
         {
             const QVariantList fieldValues = CoreDbAccess().db()->getVideoMetadata(m_data->id, missingVideoMetadata);
 
-            ItemInfoWriteLocker lock;
+            ItemInfoWriteLocker lock(m_data.data());
 
             if (fieldValues.isEmpty())
             {
@@ -526,7 +526,7 @@ ItemInfo::DatabaseFieldsHashRaw ItemInfo::getDatabaseFieldsRaw(const DatabaseFie
         {
             const QVariantList fieldValues = CoreDbAccess().db()->getImageMetadata(m_data->id, missingImageMetadata);
 
-            ItemInfoWriteLocker lock;
+            ItemInfoWriteLocker lock(m_data.data());
 
             if (fieldValues.isEmpty())
             {
@@ -75,7 +75,7 @@ QList<int> ItemInfo::tagIds() const
 
     QList<int> ids = CoreDbAccess().db()->getItemTagIDs(m_data->id);
 
-    ItemInfoWriteLocker lock;
+    ItemInfoWriteLocker lock(m_data.data());
     m_data.data()->tagIds       = ids;
     m_data.data()->tagIdsCached = true;
 
@@ -101,8 +101,6 @@ void ItemInfoList::loadTagIds() const
 
     QVector<QList<int> > allTagIds = CoreDbAccess().db()->getItemsTagIDs(infoList.toImageIdList());
 
-    ItemInfoWriteLocker lock;
-
     for (int i = 0 ; i < infoList.size() ; ++i)
     {
         const ItemInfo& info  = infoList.at(i);
@@ -113,6 +111,7 @@ void ItemInfoList::loadTagIds() const
             continue;
         }
 
+        ItemInfoWriteLocker lock(info.m_data.data());
         info.m_data.data()->tagIds       = ids;
         info.m_data.data()->tagIdsCached = true;
     }
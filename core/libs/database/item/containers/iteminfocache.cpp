@@ -23,6 +23,8 @@
 #include "iteminfo.h"
 #include "iteminfolist.h"
 #include "iteminfodata.h"
+#include "itemcomments.h"
+#include "tagscache.h"
 #include "digikam_debug.h"
 
 namespace Digikam
@@ -62,7 +64,7 @@ void ItemInfoCache::checkAlbums()
 
         QList<AlbumShortInfo> infos = CoreDbAccess().db()->getAlbumShortInfos();
 
-        ItemInfoWriteLocker lock;
+        QWriteLocker lock(&m_listLock);
         m_albums                    = infos;
         m_needUpdateAlbums          = false;
     }
@@ -74,21 +76,36 @@ int ItemInfoCache::getImageGroupedCount(qlonglong id)
     {
         QList<qlonglong> ids = CoreDbAccess().db()->getRelatedImagesToByType(DatabaseRelation::Grouped);
 
-        ItemInfoWriteLocker lock;
+        QWriteLocker lock(&m_listLock);
         m_grouped            = ids;
         m_needUpdateGrouped  = false;
     }
 
-    ItemInfoReadLocker lock;
+    QReadLocker lock(&m_listLock);
 
     return m_grouped.count(id);
 }
 
+ItemInfoCache::Shard& ItemInfoCache::shard(qlonglong id)
+{
+    return m_shards[quint64(id) % ShardCount];
+}
+
+QExplicitlySharedDataPointer<ItemInfoData> ItemInfoCache::cachedInfo(qlonglong id)
+{
+    Shard& idShard = shard(id);
+    QReadLocker lock(&idShard.lock);
+
+    return idShard.infoHash.value(id);
+}
+
 QExplicitlySharedDataPointer<ItemInfoData> ItemInfoCache::infoForId(qlonglong id)
 {
+    Shard& idShard = shard(id);
+
     {
-        ItemInfoReadLocker lock;
-        QExplicitlySharedDataPointer<ItemInfoData> ptr(m_infoHash.value(id));
+        QReadLocker lock(&idShard.lock);
+        QExplicitlySharedDataPointer<ItemInfoData> ptr(idShard.infoHash.value(id));
 
         if (ptr)
         {
@@ -96,17 +113,27 @@ QExplicitlySharedDataPointer<ItemInfoData> ItemInfoCache::infoForId(qlonglong id
         }
     }
 
-    ItemInfoWriteLocker lock;
+    QWriteLocker lock(&idShard.lock);
+
+    // Another thread may have created the data in between.
+
+    QExplicitlySharedDataPointer<ItemInfoData> ptr(idShard.infoHash.value(id));
+
+    if (ptr)
+    {
+        return ptr;
+    }
+
     ItemInfoData* const data = new ItemInfoData();
     data->id                 = id;
-    m_infoHash[id]           = data;
+    idShard.infoHash[id]     = data;
 
     return QExplicitlySharedDataPointer<ItemInfoData>(data);
 }
 
 void ItemInfoCache::cacheByName(const QExplicitlySharedDataPointer<ItemInfoData>& infoPtr)
 {
-    // Called with Write lock
+    // Called with the write lock of the data
 
     if (!infoPtr || (infoPtr->id == -1) || infoPtr->name.isEmpty())
     {
@@ -115,6 +142,7 @@ void ItemInfoCache::cacheByName(const QExplicitlySharedDataPointer<ItemInfoData>
 
     // Called in a context where we can assume that the entry is not yet cached by name (newly created data)
 
+    QWriteLocker lock(&m_nameLock);
     m_nameHash.remove(m_dataHash.value(infoPtr->id), infoPtr);
     m_dataHash.insert(infoPtr->id, infoPtr->name);
     m_nameHash.insert(infoPtr->name, infoPtr);
@@ -123,24 +151,42 @@ void ItemInfoCache::cacheByName(const QExplicitlySharedDataPointer<ItemInfoData>
 QExplicitlySharedDataPointer<ItemInfoData> ItemInfoCache::infoForPath(int albumRootId,
                                                                       const QString& relativePath, const QString& name)
 {
-    ItemInfoReadLocker lock;
-
     // We check all entries in the multi hash with matching file name
 
-    QMultiHash<QString, QExplicitlySharedDataPointer<ItemInfoData> >::const_iterator it;
+    QList<QExplicitlySharedDataPointer<ItemInfoData> > candidates;
+
+    {
+        QReadLocker lock(&m_nameLock);
+        QMultiHash<QString, QExplicitlySharedDataPointer<ItemInfoData> >::const_iterator it;
+
+        for (it = m_nameHash.constFind(name) ; (it != m_nameHash.constEnd()) && (it.key() == name) ; ++it)
+        {
+            candidates << it.value();
+        }
+    }
 
-    for (it = m_nameHash.constFind(name) ; (it != m_nameHash.constEnd()) && (it.key() == name) ; ++it)
+    for (const QExplicitlySharedDataPointer<ItemInfoData>& candidate : std::as_const(candidates))
     {
+        int candidateAlbumRootId = -1;
+        int candidateAlbumId     = -1;
+
+        {
+            ItemInfoReadLocker lock(candidate.data());
+            candidateAlbumRootId = candidate->albumRootId;
+            candidateAlbumId     = candidate->albumId;
+        }
+
         // first check that album root matches
 
-        if (it.value()->albumRootId != albumRootId)
+        if (candidateAlbumRootId != albumRootId)
         {
             continue;
         }
 
         // check that relativePath matches. We get relativePath from entry's id and compare to given name.
 
-        QList<AlbumShortInfo>::const_iterator albumIt = findAlbum(it.value()->albumId);
+        QReadLocker lock(&m_listLock);
+        QList<AlbumShortInfo>::const_iterator albumIt = findAlbum(candidateAlbumId);
 
         if ((albumIt == m_albums.constEnd()) || (albumIt->relativePath != relativePath))
         {
@@ -149,7 +195,7 @@ QExplicitlySharedDataPointer<ItemInfoData> ItemInfoCache::infoForPath(int albumR
 
         // we have now a match by name, albumRootId and relativePath
 
-        return it.value();
+        return candidate;
     }
 
     return QExplicitlySharedDataPointer<ItemInfoData>();
@@ -162,7 +208,22 @@ void ItemInfoCache::dropInfo(const QExplicitlySharedDataPointer<ItemInfoData>& i
         return;
     }
 
-    ItemInfoWriteLocker lock;
+    qlonglong id = -1;
+    QString   name;
+
+    {
+        ItemInfoReadLocker lock(infoPtr.data());
+        id   = infoPtr->id;
+        name = infoPtr->name;
+    }
+
+    // The name lock and the shard lock are held while checking the reference counter:
+    // no other thread can take a new reference from the cache in between, by id or by
+    // name. Lock order is the names, then the shard, as everywhere both are needed.
+
+    QWriteLocker nameLock(&m_nameLock);
+    Shard& idShard = shard(id);
+    QWriteLocker lock(&idShard.lock);
 
     // When we have the last ItemInfoData, the reference counter is at 3.
     // Because 2 QExplicitlySharedDataPointers are in cache and 1 is held by m_data.
@@ -172,15 +233,23 @@ void ItemInfoCache::dropInfo(const QExplicitlySharedDataPointer<ItemInfoData>& i
         return;
     }
 
-    m_nameHash.remove(m_dataHash.value(infoPtr->id), infoPtr);
-    m_nameHash.remove(infoPtr->name, infoPtr);
-    m_infoHash.remove(infoPtr->id);
-    m_dataHash.remove(infoPtr->id);
+    if (idShard.infoHash.value(id) == infoPtr)
+    {
+        idShard.infoHash.remove(id);
+    }
+
+    m_nameHash.remove(m_dataHash.value(id), infoPtr);
+    m_nameHash.remove(name, infoPtr);
+
+    if (!idShard.infoHash.contains(id))
+    {
+        m_dataHash.remove(id);
+    }
 }
 
 QList<AlbumShortInfo>::const_iterator ItemInfoCache::findAlbum(int id)
 {
-    // Called with read lock
+    // Called with read lock of the lists
 
     AlbumShortInfo info;
     info.id = id;
@@ -203,7 +272,7 @@ QList<AlbumShortInfo>::const_iterator ItemInfoCache::findAlbum(int id)
 QString ItemInfoCache::albumRelativePath(int albumId)
 {
     checkAlbums();
-    ItemInfoReadLocker lock;
+    QReadLocker lock(&m_listLock);
     QList<AlbumShortInfo>::const_iterator it = findAlbum(albumId);
 
     if (it != m_albums.constEnd())
@@ -214,105 +283,533 @@ QString ItemInfoCache::albumRelativePath(int albumId)
     return QString();
 }
 
+void ItemInfoCache::prefetch(const QList<qlonglong>& ids, const DatabaseFields::Set& fields)
+{
+    const DatabaseFields::Images    imagesFields = fields.getImages()          & (DatabaseFields::Category         |
+                                                                                  DatabaseFields::ModificationDate |
+                                                                                  DatabaseFields::FileSize         |
+                                                                                  DatabaseFields::UniqueHash       |
+                                                                                  DatabaseFields::ManualOrder);
+    DatabaseFields::ItemInformation infoFields   = fields.getItemInformation() & (DatabaseFields::Rating       |
+                                                                                  DatabaseFields::CreationDate |
+                                                                                  DatabaseFields::Orientation  |
+                                                                                  DatabaseFields::Width        |
+                                                                                  DatabaseFields::Height       |
+                                                                                  DatabaseFields::Format);
+
+    if (infoFields & (DatabaseFields::Width | DatabaseFields::Height))
+    {
+        // Width and height are cached together as image size.
+
+        infoFields |= DatabaseFields::Width | DatabaseFields::Height;
+    }
+
+    const bool loadLabels    = (fields.getItemInformation() & (DatabaseFields::PickLabel | DatabaseFields::ColorLabel));
+    const bool loadComments  = (fields.getItemComments()    != DatabaseFields::ItemCommentsNone);
+    const bool loadPositions = (fields.getItemPositions()   & (DatabaseFields::LatitudeNumber  |
+                                                               DatabaseFields::LongitudeNumber |
+                                                               DatabaseFields::Altitude));
+    const bool loadGroups    = (fields.getImageHistoryInfo() & DatabaseFields::ImageRelations);
+
+    // Find the cached items which miss some of the fields, per database table.
+
+    QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> > infos;
+    QHash<qlonglong, quint32>                                      invalidationCounts;
+    QList<qlonglong> imagesIds, infoIds, tagIds, commentIds, positionIds, groupIds;
+
+    for (const qlonglong id : ids)
+    {
+        if (infos.contains(id))
+        {
+            continue;
+        }
+
+        const QExplicitlySharedDataPointer<ItemInfoData> data = cachedInfo(id);
+
+        if (!data)
+        {
+            continue;
+        }
+
+        infos.insert(id, data);
+
+        ItemInfoReadLocker lock(data.data());
+        invalidationCounts.insert(id, data->invalidationCount);
+
+        if (
+            ((imagesFields & DatabaseFields::Category)         && !data->categoryCached)         ||
+            ((imagesFields & DatabaseFields::ModificationDate) && !data->modificationDateCached) ||
+            ((imagesFields & DatabaseFields::FileSize)         && !data->fileSizeCached)         ||
+            ((imagesFields & DatabaseFields::UniqueHash)       && !data->uniqueHashCached)       ||
+            ((imagesFields & DatabaseFields::ManualOrder)      && !data->manualOrderCached)
+           )
+        {
+            imagesIds << id;
+        }
+
+        if (
+            ((infoFields & DatabaseFields::Rating)       && !data->ratingCached)       ||
+            ((infoFields & DatabaseFields::CreationDate) && !data->creationDateCached) ||
+            ((infoFields & DatabaseFields::Orientation)  && !data->orientationCached)  ||
+            ((infoFields & DatabaseFields::Format)       && !data->formatCached)       ||
+            ((infoFields & (DatabaseFields::Width | DatabaseFields::Height)) && !data->imageSizeCached)
+           )
+        {
+            infoIds << id;
+        }
+
+        if (loadLabels && (!data->tagIdsCached || !data->pickLabelCached || !data->colorLabelCached))
+        {
+            tagIds << id;
+        }
+
+        if (loadComments && (!data->defaultCommentCached || !data->defaultTitleCached))
+        {
+            commentIds << id;
+        }
+
+        if (loadPositions && !data->positionsCached)
+        {
+            positionIds << id;
+        }
+
+        if (loadGroups && !data->groupImageCached)
+        {
+            groupIds << id;
+        }
+    }
+
+    // Read the fields with one query per table, without holding the ItemInfo locks.
+
+    QVariantList                imagesValues;
+    QVariantList                infoValues;
+    QVariantList                positionValues;
+    QVector<QList<int> >        allTagIds;
+    QVector<QList<qlonglong> >  allGroupIds;
+    QHash<qlonglong, QString>   comments;
+    QHash<qlonglong, QString>   titles;
+
+    {
+        CoreDbAccess access;
+
+        if (!imagesIds.isEmpty())
+        {
+            imagesValues   = access.db()->getImagesFields(imagesIds, imagesFields);
+        }
+
+        if (!infoIds.isEmpty())
+        {
+            infoValues     = access.db()->getItemInformation(infoIds, infoFields);
+        }
+
+        if (!positionIds.isEmpty())
+        {
+            positionValues = access.db()->getItemsPositions(positionIds, DatabaseFields::LatitudeNumber  |
+                                                                         DatabaseFields::LongitudeNumber |
+                                                                         DatabaseFields::Altitude);
+        }
+
+        if (!tagIds.isEmpty())
+        {
+            allTagIds      = access.db()->getItemsTagIDs(tagIds);
+        }
+
+        if (!groupIds.isEmpty())
+        {
+            allGroupIds    = access.db()->getImagesRelatedFrom(groupIds, DatabaseRelation::Grouped);
+        }
+
+        if (!commentIds.isEmpty())
+        {
+            QHash<qlonglong, QList<CommentInfo> > commentInfos;
+            const QList<CommentInfo> list = access.db()->getItemComments(commentIds);
+
+            for (const CommentInfo& info : list)
+            {
+                commentInfos[info.imageId] << info;
+            }
+
+            for (const qlonglong id : std::as_const(commentIds))
+            {
+                ItemComments itemComments(id, commentInfos.value(id));
+                comments[id] = itemComments.defaultComment();
+                titles[id]   = itemComments.defaultComment(DatabaseComment::Title);
+            }
+        }
+    }
+
+    QVector<int> pickLabels(allTagIds.size());
+    QVector<int> colorLabels(allTagIds.size());
+
+    for (int i = 0 ; i < allTagIds.size() ; ++i)
+    {
+        pickLabels[i]  = TagsCache::instance()->pickLabelFromTags(allTagIds.at(i));
+        colorLabels[i] = TagsCache::instance()->colorLabelFromTags(allTagIds.at(i));
+    }
+
+    // Store the fields. Fields cached meanwhile are kept. The entries invalidated
+    // since the counter was read are skipped: the values read may be outdated.
+
+    auto invalidated = [&invalidationCounts](const ItemInfoData* const data)
+    {
+        return (data->invalidationCount != invalidationCounts.value(data->id));
+    };
+
+    const int imagesCount = CoreDB::imagesFieldList(imagesFields).size() + 1;
+
+    for (int row = 0 ; row < imagesValues.size() ; row += imagesCount)
+    {
+        ItemInfoData* const data = infos.value(imagesValues.at(row).toLongLong()).data();
+
+        if (!data)
+        {
+            continue;
+        }
+
+        ItemInfoWriteLocker lock(data);
+
+        if (invalidated(data))
+        {
+            continue;
+        }
+
+        int column = row + 1;
+
+        if (imagesFields & DatabaseFields::Category)
+        {
+            if (!data->categoryCached)
+            {
+                data->category         = (DatabaseItem::Category)imagesValues.at(column).toInt();
+                data->categoryCached   = true;
+            }
+
+            ++column;
+        }
+
+        if (imagesFields & DatabaseFields::ModificationDate)
+        {
+            if (!data->modificationDateCached)
+            {
+                data->modificationDate       = imagesValues.at(column).toDateTime();
+                data->modificationDateCached = true;
+            }
+
+            ++column;
+        }
+
+        if (imagesFields & DatabaseFields::FileSize)
+        {
+            if (!data->fileSizeCached)
+            {
+                data->fileSize         = imagesValues.at(column).toLongLong();
+                data->fileSizeCached   = true;
+            }
+
+            ++column;
+        }
+
+        if (imagesFields & DatabaseFields::UniqueHash)
+        {
+            if (!data->uniqueHashCached)
+            {
+                data->uniqueHash       = imagesValues.at(column).toString();
+                data->uniqueHashCached = true;
+            }
+
+            ++column;
+        }
+
+        if ((imagesFields & DatabaseFields::ManualOrder) && !data->manualOrderCached)
+        {
+            data->manualOrder       = imagesValues.at(column).toLongLong();
+            data->manualOrderCached = true;
+        }
+    }
+
+    const int infoCount = CoreDB::imageInformationFieldList(infoFields).size() + 1;
+
+    for (int row = 0 ; row < infoValues.size() ; row += infoCount)
+    {
+        ItemInfoData* const data = infos.value(infoValues.at(row).toLongLong()).data();
+
+        if (!data)
+        {
+            continue;
+        }
+
+        ItemInfoWriteLocker lock(data);
+
+        if (invalidated(data))
+        {
+            continue;
+        }
+
+        int column = row + 1;
+
+        if (infoFields & DatabaseFields::Rating)
+        {
+            if (!data->ratingCached)
+            {
+                data->rating       = infoValues.at(column).toLongLong();
+                data->ratingCached = true;
+            }
+
+            ++column;
+        }
+
+        if (infoFields & DatabaseFields::CreationDate)
+        {
+            if (!data->creationDateCached)
+            {
+                data->creationDate       = infoValues.at(column).toDateTime();
+                data->creationDateCached = true;
+            }
+
+            ++column;
+        }
+
+        if (infoFields & DatabaseFields::Orientation)
+        {
+            if (!data->orientationCached)
+            {
+                data->orientation       = infoValues.at(column).toInt();
+                data->orientationCached = true;
+            }
+
+            ++column;
+        }
+
+        if (infoFields & DatabaseFields::Width)
+        {
+            if (!data->imageSizeCached)
+            {
+                data->imageSize       = QSize(infoValues.at(column).toInt(), infoValues.at(column + 1).toInt());
+                data->imageSizeCached = true;
+            }
+
+            column += 2;
+        }
+
+        if ((infoFields & DatabaseFields::Format) && !data->formatCached)
+        {
+            data->format       = infoValues.at(column).toString();
+            data->formatCached = true;
+        }
+    }
+
+    for (int i = 0 ; i < allTagIds.size() ; ++i)
+    {
+        ItemInfoData* const data = infos.value(tagIds.at(i)).data();
+        ItemInfoWriteLocker lock(data);
+
+        if (invalidated(data))
+        {
+            continue;
+        }
+
+        if (!data->tagIdsCached)
+        {
+            data->tagIds       = allTagIds.at(i);
+            data->tagIdsCached = true;
+        }
+
+        if (!data->pickLabelCached)
+        {
+            data->pickLabel        = (pickLabels.at(i)  == -1) ? NoPickLabel  : pickLabels.at(i);
+            data->pickLabelCached  = true;
+        }
+
+        if (!data->colorLabelCached)
+        {
+            data->colorLabel       = (colorLabels.at(i) == -1) ? NoColorLabel : colorLabels.at(i);
+            data->colorLabelCached = true;
+        }
+    }
+
+    for (int i = 0 ; i < allGroupIds.size() ; ++i)
+    {
+        ItemInfoData* const data = infos.value(groupIds.at(i)).data();
+        ItemInfoWriteLocker lock(data);
+
+        if (invalidated(data))
+        {
+            continue;
+        }
+
+        data->groupImage         = allGroupIds.at(i).isEmpty() ? -1 : allGroupIds.at(i).first();
+        data->groupImageCached   = true;
+    }
+
+    for (const qlonglong id : std::as_const(commentIds))
+    {
+        ItemInfoData* const data = infos.value(id).data();
+        ItemInfoWriteLocker lock(data);
+
+        if (invalidated(data))
+        {
+            continue;
+        }
+
+        if (!data->defaultCommentCached)
+        {
+            data->defaultComment       = comments.value(id);
+            data->defaultCommentCached = true;
+        }
+
+        if (!data->defaultTitleCached)
+        {
+            data->defaultTitle         = titles.value(id);
+            data->defaultTitleCached   = true;
+        }
+    }
+
+    // The items without row in ImagePositions have no coordinates.
+
+    QHash<qlonglong, int> positionRows;
+
+    for (int row = 0 ; row < positionValues.size() ; row += 4)
+    {
+        positionRows.insert(positionValues.at(row).toLongLong(), row);
+    }
+
+    for (const qlonglong id : std::as_const(positionIds))
+    {
+        ItemInfoData* const data = infos.value(id).data();
+        ItemInfoWriteLocker lock(data);
+
+        if (data->positionsCached || invalidated(data))
+        {
+            continue;
+        }
+
+        const int row            = positionRows.value(id, -1);
+        const QVariant latitude  = (row == -1) ? QVariant() : positionValues.at(row + 1);
+        const QVariant longitude = (row == -1) ? QVariant() : positionValues.at(row + 2);
+        const QVariant altitude  = (row == -1) ? QVariant() : positionValues.at(row + 3);
+
+        data->latitude           = latitude.toDouble();
+        data->longitude          = longitude.toDouble();
+        data->altitude           = altitude.toDouble();
+        data->hasCoordinates     = (!latitude.isNull() && !longitude.isNull());
+        data->hasAltitude        = !altitude.isNull();
+        data->positionsCached    = true;
+    }
+}
+
 void ItemInfoCache::invalidate()
 {
-    ItemInfoWriteLocker lock;
-    QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> >::iterator it;
+    QList<QExplicitlySharedDataPointer<ItemInfoData> > infos;
 
-    for (it = m_infoHash.begin() ; it != m_infoHash.end() ; ++it)
+    for (Shard& idShard : m_shards)
     {
-        (*it)->invalid = true;
-        (*it)->id      = -1;
+        QWriteLocker lock(&idShard.lock);
+        infos << idShard.infoHash.values();
+        idShard.infoHash.clear();
     }
 
-    m_albums.clear();
-    m_grouped.clear();
-    m_nameHash.clear();
-    m_infoHash.clear();
-    m_dataHash.clear();
-    m_needUpdateAlbums  = true;
-    m_needUpdateGrouped = true;
+    {
+        QWriteLocker lock(&m_nameLock);
+        m_nameHash.clear();
+        m_dataHash.clear();
+    }
+
+    {
+        QWriteLocker lock(&m_listLock);
+        m_albums.clear();
+        m_grouped.clear();
+        m_needUpdateAlbums  = true;
+        m_needUpdateGrouped = true;
+    }
+
+    for (const QExplicitlySharedDataPointer<ItemInfoData>& info : std::as_const(infos))
+    {
+        ItemInfoWriteLocker lock(info.data());
+        info->invalid = true;
+        info->id      = -1;
+    }
 }
 
 void ItemInfoCache::slotImageChanged(const ImageChangeset& changeset)
 {
-    ItemInfoWriteLocker lock;
     const auto ids = changeset.ids();
 
     for (const qlonglong& imageId : ids)
     {
-        QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> >::iterator it = m_infoHash.find(imageId);
+        QExplicitlySharedDataPointer<ItemInfoData> info = cachedInfo(imageId);
 
-        if (it != m_infoHash.end())
+        if (info)
         {
+            ItemInfoWriteLocker lock(info.data());
+            ++info->invalidationCount;
+
             // invalidate the relevant field. It will be lazy-loaded at first access.
 
             DatabaseFields::Set changes = changeset.changes();
 
             if (changes & DatabaseFields::ItemCommentsAll)
             {
-                (*it)->defaultCommentCached = false;
-                (*it)->defaultTitleCached   = false;
+                info->defaultCommentCached = false;
+                info->defaultTitleCached   = false;
             }
 
             if (changes & DatabaseFields::Category)
             {
-                (*it)->categoryCached = false;
+                info->categoryCached = false;
             }
 
             if (changes & DatabaseFields::Format)
             {
-                (*it)->formatCached = false;
+                info->formatCached = false;
             }
 
             if (changes & DatabaseFields::PickLabel)
             {
-                (*it)->pickLabelCached = false;
+                info->pickLabelCached = false;
             }
 
             if (changes & DatabaseFields::ColorLabel)
             {
-                (*it)->colorLabelCached = false;
+                info->colorLabelCached = false;
             }
 
             if (changes & DatabaseFields::Rating)
             {
-                (*it)->ratingCached = false;
+                info->ratingCached = false;
             }
 
             if (changes & DatabaseFields::CreationDate)
             {
-                (*it)->creationDateCached = false;
+                info->creationDateCached = false;
             }
 
             if (changes & DatabaseFields::ModificationDate)
             {
-                (*it)->modificationDateCached = false;
+                info->modificationDateCached = false;
             }
 
             if (changes & DatabaseFields::Orientation)
             {
-                (*it)->orientationCached = false;
+                info->orientationCached = false;
             }
 
             if (changes & DatabaseFields::FileSize)
             {
-                (*it)->fileSizeCached = false;
+                info->fileSizeCached = false;
             }
 
             if (changes & DatabaseFields::UniqueHash)
             {
-                (*it)->uniqueHashCached = false;
+                info->uniqueHashCached = false;
             }
 
             if (changes & DatabaseFields::ManualOrder)
             {
-                (*it)->manualOrderCached = false;
+                info->manualOrderCached = false;
             }
 
             if ((changes & DatabaseFields::Width) || (changes & DatabaseFields::Height))
             {
-                (*it)->imageSizeCached = false;
+                info->imageSizeCached = false;
             }
 
             if (
@@ -321,31 +818,31 @@ void ItemInfoCache::slotImageChanged(const ImageChangeset& changeset)
                 (changes & DatabaseFields::Altitude)
                )
             {
-                (*it)->positionsCached = false;
+                info->positionsCached = false;
             }
 
             if (changes & DatabaseFields::ImageRelations)
             {
-                (*it)->groupImageCached = false;
-                m_needUpdateGrouped     = true;
+                info->groupImageCached = false;
+                m_needUpdateGrouped    = true;
             }
 
             if (changes.hasFieldsFromVideoMetadata())
             {
                 const DatabaseFields::VideoMetadata changedVideoMetadata = changes.getVideoMetadata();
-                (*it)->videoMetadataCached                              &= ~changedVideoMetadata;
-                (*it)->hasVideoMetadata                                  = true;
+                info->videoMetadataCached                               &= ~changedVideoMetadata;
+                info->hasVideoMetadata                                   = true;
 
-                (*it)->databaseFieldsHashRaw.removeAllFields(changedVideoMetadata);
+                info->databaseFieldsHashRaw.removeAllFields(changedVideoMetadata);
             }
 
             if (changes.hasFieldsFromImageMetadata())
             {
                 const DatabaseFields::ImageMetadata changedImageMetadata = changes.getImageMetadata();
-                (*it)->imageMetadataCached                              &= ~changedImageMetadata;
-                (*it)->hasImageMetadata                                  = true;
+                info->imageMetadataCached                               &= ~changedImageMetadata;
+                info->hasImageMetadata                                   = true;
 
-                (*it)->databaseFieldsHashRaw.removeAllFields(changedImageMetadata);
+                info->databaseFieldsHashRaw.removeAllFields(changedImageMetadata);
             }
         }
         else
@@ -359,36 +856,38 @@ void ItemInfoCache::slotImageTagChanged(const ImageTagChangeset& changeset)
 {
     if (changeset.propertiesWereChanged())
     {
-        ItemInfoWriteLocker lock;
         const auto ids = changeset.ids();
 
         for (const qlonglong& imageId : ids)
         {
-            QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> >::iterator it = m_infoHash.find(imageId);
+            QExplicitlySharedDataPointer<ItemInfoData> info = cachedInfo(imageId);
 
-            if (it != m_infoHash.end())
+            if (info)
             {
-                (*it)->faceCountCached            = false;
-                (*it)->faceSuggestionsCached      = false;
-                (*it)->unconfirmedFaceCountCached = false;
+                ItemInfoWriteLocker lock(info.data());
+                ++info->invalidationCount;
+                info->faceCountCached            = false;
+                info->faceSuggestionsCached      = false;
+                info->unconfirmedFaceCountCached = false;
             }
         }
 
         return;
     }
 
-    ItemInfoWriteLocker lock;
     const auto ids = changeset.ids();
 
     for (const qlonglong& imageId : ids)
     {
-        QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> >::iterator it = m_infoHash.find(imageId);
+        QExplicitlySharedDataPointer<ItemInfoData> info = cachedInfo(imageId);
 
-        if (it != m_infoHash.end())
+        if (info)
         {
-            (*it)->tagIdsCached     = false;
-            (*it)->colorLabelCached = false;
-            (*it)->pickLabelCached  = false;
+            ItemInfoWriteLocker lock(info.data());
+            ++info->invalidationCount;
+            info->tagIdsCached     = false;
+            info->colorLabelCached = false;
+            info->pickLabelCached  = false;
         }
     }
 }
@@ -20,10 +20,12 @@
 #include <QHash>
 #include <QObject>
 #include <QMultiHash>
+#include <QReadWriteLock>
 #include <QExplicitlySharedDataPointer>
 
 // Local includes
 
+#include "coredbfields.h"
 #include "coredbwatch.h"
 
 namespace Digikam
@@ -59,7 +61,7 @@ public:
     /**
      * Call this to put data in the hash by file name if you have newly created data
      * and the name is filled.
-     * Call under write lock.
+     * Call under the write lock of the data.
      */
     void cacheByName(const QExplicitlySharedDataPointer<ItemInfoData>& infoPtr);
 
@@ -72,6 +74,17 @@ public:
                                                            const QString& relativePath,
                                                            const QString& name);
 
+    /**
+     * Load the specified fields of the cached items with one database query per table,
+     * and store them without database access under the locks. Fields already cached
+     * are not loaded again, items which are not in the cache are skipped.
+     * Supported are the fields of the Images, ImageInformation and ImagePositions tables
+     * kept by ItemInfo, and the default title and comment. PickLabel and ColorLabel load
+     * the tag ids, ImageRelations loads the group leader. Nothing is stored for an item
+     * whose fields were invalidated by a change while the database was read.
+     */
+    void prefetch(const QList<qlonglong>& ids, const DatabaseFields::Set& fields);
+
     /**
      * Returns the cached relativePath for the given album id.
      */
@@ -93,19 +106,51 @@ private Q_SLOTS:
     void slotImageTagChanged(const ImageTagChangeset& changeset);
     void slotAlbumChange(const AlbumChangeset&);
 
+private:
+
+    /**
+     * A part of the index by id, with its own lock. The items are spread over
+     * the shards by id, so that lookups of unrelated items do not contend.
+     */
+    class Shard
+    {
+    public:
+
+        QReadWriteLock                                                lock;
+        QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> > infoHash;
+    };
+
+    enum
+    {
+        ShardCount = 32
+    };
+
 private:
 
     // Disable
     explicit ItemInfoCache(QObject*) = delete;
 
-    QList<AlbumShortInfo>::const_iterator findAlbum(int id);
-    void                                  checkAlbums();
+    Shard&                                     shard(qlonglong id);
+
+    /**
+     * Return the cached object for the given image id, or 0 if not cached.
+     */
+    QExplicitlySharedDataPointer<ItemInfoData> cachedInfo(qlonglong id);
+
+    QList<AlbumShortInfo>::const_iterator      findAlbum(int id);
+    void                                       checkAlbums();
 
 private:
 
+    Shard                                                            m_shards[ShardCount];
+
+    /// Guards m_nameHash and m_dataHash. Taken before a shard lock when both are needed.
+    QReadWriteLock                                                   m_nameLock;
     QMultiHash<QString, QExplicitlySharedDataPointer<ItemInfoData> > m_nameHash;
-    QHash<qlonglong, QExplicitlySharedDataPointer<ItemInfoData> >    m_infoHash;
     QHash<qlonglong, QString>                                        m_dataHash;
+
+    /// Guards m_grouped and m_albums.
+    QReadWriteLock                                                   m_listLock;
     volatile bool                                                    m_needUpdateAlbums     = true;
     volatile bool                                                    m_needUpdateGrouped    = true;
     QList<qlonglong>                                                 m_grouped;
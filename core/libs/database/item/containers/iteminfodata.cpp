@@ -44,4 +44,13 @@ ItemInfoCache* ItemInfoStatic::cache()
     return &m_instance->m_cache;
 }
 
+QReadWriteLock* ItemInfoStatic::dataLock(const ItemInfoData* const data)
+{
+    // The low bits of the address are the same for all data because of the alignment.
+
+    const quintptr key = reinterpret_cast<quintptr>(data) >> 4;
+
+    return &m_instance->m_dataLocks[key % DataLockCount];
+}
+
 } // namespace Digikam
@@ -45,10 +45,23 @@ public:
 
     static ItemInfoCache* cache();
 
+    /**
+     * Returns the lock guarding the fields of the data.
+     * The data are spread over a fixed pool of locks by address, so that
+     * readers of an item do not block on writers of unrelated items.
+     * Never hold the locks of two data at the same time: they may share a lock.
+     */
+    static QReadWriteLock* dataLock(const ItemInfoData* const data);
+
 public:
 
+    enum
+    {
+        DataLockCount = 64
+    };
+
     ItemInfoCache          m_cache;
-    QReadWriteLock         m_lock;
+    QReadWriteLock         m_dataLocks[DataLockCount];
 
     static ItemInfoStatic* m_instance;
 };
@@ -59,8 +72,8 @@ class ItemInfoReadLocker : public QReadLocker
 {
 public:
 
-    explicit ItemInfoReadLocker()
-        : QReadLocker(&ItemInfoStatic::m_instance->m_lock)
+    explicit ItemInfoReadLocker(const ItemInfoData* const data)
+        : QReadLocker(ItemInfoStatic::dataLock(data))
     {
     }
 };
@@ -71,8 +84,8 @@ class ItemInfoWriteLocker : public QWriteLocker
 {
 public:
 
-    explicit ItemInfoWriteLocker()
-        : QWriteLocker(&ItemInfoStatic::m_instance->m_lock)
+    explicit ItemInfoWriteLocker(const ItemInfoData* const data)
+        : QWriteLocker(ItemInfoStatic::dataLock(data))
     {
     }
 };
@@ -147,6 +160,9 @@ public:
 
     bool                                     invalid                    = false;
 
+    //! incremented each time cached fields are invalidated, see ItemInfoCache::prefetch()
+    quint32                                  invalidationCount          = 0;
+
     // These two are initially true because we assume the data is there.
     // Once we query the data and find out it is missing, we set them to false.
 
@@ -17,6 +17,7 @@
 
 // Local includes
 
+#include "iteminfodata.h"
 
 namespace Digikam
 {
@@ -58,6 +59,16 @@ QList<QUrl> ItemInfoList::toImageUrlList() const
     return urlList;
 }
 
+void ItemInfoList::prefetch(const DatabaseFields::Set& fields) const
+{
+    if (isEmpty())
+    {
+        return;
+    }
+
+    ItemInfoStatic::cache()->prefetch(toImageIdList(), fields);
+}
+
 bool ItemInfoList::namefileLessThan(const ItemInfo& d1, const ItemInfo& d2)
 {
     return d1.name().toLower() < d2.name().toLower(); // sort by name
@@ -47,6 +47,13 @@ public:
     void loadGroupImageIds()          const;
     void loadTagIds()                 const;
 
+    /**
+     * Load the fields of all items with one database query per table,
+     * instead of one query per item and field on first access.
+     * See ItemInfoCache::prefetch() for the supported fields.
+     */
+    void prefetch(const DatabaseFields::Set& fields) const;
+
     bool static namefileLessThan(const ItemInfo& d1, const ItemInfo& d2);
 
     /**
@@ -29,6 +29,7 @@
 #include "coredbaccess.h"
 #include "coredbchangesets.h"
 #include "coredbwatch.h"
+#include "itemattributeswatch.h"
 #include "iteminfolist.h"
 #include "facetagsiface.h"
 #include "facetags.h"
@@ -307,6 +308,17 @@ void ItemFilterModel::setDirectSourceItemModel(ItemModel* const sourceModel)
 
         connect(d->imageModel, SIGNAL(imageTagChange(ImageTagChangeset,QItemSelection)),
                 this, SLOT(slotImageTagChange(ImageTagChangeset)));
+
+        connect(d->imageModel, SIGNAL(imageInfosAboutToBeAdded(QList<ItemInfo>)),
+                this, SLOT(slotImageInfosAboutToBeAdded(QList<ItemInfo>)));
+
+        connect(ItemAttributesWatch::instance(), SIGNAL(signalImageRatingChanged(qlonglong)),
+                this, SLOT(slotImageAttributesChanged(qlonglong)),
+                Qt::UniqueConnection);
+
+        connect(ItemAttributesWatch::instance(), SIGNAL(signalImageDateChanged(qlonglong)),
+                this, SLOT(slotImageAttributesChanged(qlonglong)),
+                Qt::UniqueConnection);
     }
 
     setSourceModel(d->imageModel);
@@ -667,6 +679,8 @@ void ItemFilterModel::slotModelReset()
     }
 
     d->filterResults.clear();
+    d->sortKeys->clear();
+    d->invalidateSortKeys();
 }
 
 bool ItemFilterModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
@@ -841,6 +855,7 @@ void ItemFilterModelFilterer::process(ItemFilterModelTodoPackage package)
     GroupItemFilterSettings   localGroupFilter;
     bool                      hasOneMatch;
     bool                      hasOneMatchForText;
+    bool                      loadSortKeys;
 
     {
         QMutexLocker lock(&d->mutex);
@@ -849,14 +864,55 @@ void ItemFilterModelFilterer::process(ItemFilterModelTodoPackage package)
         localGroupFilter   = d->groupFilterCopy;
         hasOneMatch        = d->hasOneMatch;
         hasOneMatchForText = d->hasOneMatchForText;
+        loadSortKeys       = d->loadSortKeys;
+    }
+
+    // Load the packed keys of the package with one query: the model sorts from them
+    // in the GUI thread, and the rating and date filters reject items without ItemInfo.
+    // A rejected item is not checked for a text match.
+
+    const bool filterByKeys = (
+                               (localFilter.isFilteringByRating() || localFilter.isFilteringByDay()) &&
+                               (hasOneMatchForText || !localFilter.isFilteringByText())
+                              );
+    ItemSortKeyColumns keys;
+
+    if (loadSortKeys || filterByKeys)
+    {
+        QList<qlonglong> ids;
+
+        for (const ItemInfo& info : std::as_const(package.infos))
+        {
+            ids << info.id();
+        }
+
+        keys = d->sortKeys->columns(ids);
     }
 
+    auto rejectedByKeys = [&keys, &localFilter, filterByKeys](qlonglong id)
+    {
+        if (!filterByKeys)
+        {
+            return false;
+        }
+
+        const int index = keys.indexOf(id);
+
+        return ((index != -1) && !localFilter.matchesKeys(keys, index));
+    };
+
     // Actual filtering. The variants to spare checking hasOneMatch over and over again.
 
     if      (hasOneMatch && hasOneMatchForText)
     {
         for (const ItemInfo& info : std::as_const(package.infos))
         {
+            if (rejectedByKeys(info.id()))
+            {
+                package.filterResults[info.id()] = false;
+                continue;
+            }
+
             package.filterResults[info.id()] = (
                                                 localFilter.matches(info)        &&
                                                 localVersionFilter.matches(info) &&
@@ -870,6 +926,12 @@ void ItemFilterModelFilterer::process(ItemFilterModelTodoPackage package)
 
         for (const ItemInfo& info : std::as_const(package.infos))
         {
+            if (rejectedByKeys(info.id()))
+            {
+                package.filterResults[info.id()] = false;
+                continue;
+            }
+
             package.filterResults[info.id()] = (
                                                 localFilter.matches(info, &matchForText) &&
                                                 localVersionFilter.matches(info)         &&
@@ -888,6 +950,12 @@ void ItemFilterModelFilterer::process(ItemFilterModelTodoPackage package)
 
         for (const ItemInfo& info : std::as_const(package.infos))
         {
+            if (rejectedByKeys(info.id()))
+            {
+                package.filterResults[info.id()] = false;
+                continue;
+            }
+
             result                           = (
                                                 localFilter.matches(info, &matchForText) &&
                                                 localVersionFilter.matches(info)         &&
@@ -925,6 +993,14 @@ void ItemFilterModel::setItemSortSettings(const ItemSortSettings& sorter)
     Q_D(ItemFilterModel);
 
     d->sorter = sorter;
+
+    {
+        QMutexLocker lock(&d->mutex);
+        d->loadSortKeys = ItemSortKeys::covers(d->sorter);
+    }
+
+    d->invalidateSortKeys();
+    d->prefetchSortKeys();
     setCategorizedModel(d->sorter.categorizationMode != ItemSortSettings::NoCategories);
     invalidate();
 }
@@ -988,6 +1064,32 @@ int ItemFilterModel::compareCategories(const QModelIndex& left, const QModelInde
     const ItemInfo& leftInfo    = d->imageModel->imageInfoRef(left);
     const ItemInfo& rightInfo   = d->imageModel->imageInfoRef(right);
 
+    // The categories by month and by format are compared from the packed keys.
+    // The other modes can be customized by compareInfosCategories().
+
+    if (
+        (d->sorter.categorizationMode == ItemSortSettings::CategoryByMonth) ||
+        (d->sorter.categorizationMode == ItemSortSettings::CategoryByFormat)
+       )
+    {
+        int leftIndex  = d->sortKeyIndex(leftInfo.id());
+        int rightIndex = d->sortKeyIndex(rightInfo.id());
+
+        if ((leftIndex != -1) && (rightIndex != -1))
+        {
+            const qlonglong leftGroupImageId  = d->sortKeyColumns.groupImageIds.at(leftIndex);
+            const qlonglong rightGroupImageId = d->sortKeyColumns.groupImageIds.at(rightIndex);
+
+            leftIndex  = (leftGroupImageId  == -1) ? leftIndex  : d->sortKeyIndex(leftGroupImageId);
+            rightIndex = (rightGroupImageId == -1) ? rightIndex : d->sortKeyIndex(rightGroupImageId);
+
+            if ((leftIndex != -1) && (rightIndex != -1))
+            {
+                return d->sorter.compareCategories(d->sortKeyColumns, leftIndex, rightIndex);
+            }
+        }
+    }
+
     // Check grouping
 
     qlonglong leftGroupImageId  = leftInfo.groupImageId();
@@ -1041,6 +1143,47 @@ bool ItemFilterModel::subSortLessThan(const QModelIndex& left, const QModelIndex
                                   right.data(ItemModel::ExtraDataRole));
     }
 
+    // Sort from the packed keys, with the same grouping rules as below.
+    // The items sorted with the whole model compare by position.
+
+    int leftIndex  = d->sortKeyIndex(leftInfo.id());
+    int rightIndex = d->sortKeyIndex(rightInfo.id());
+
+    if ((leftIndex != -1) && (rightIndex != -1))
+    {
+        const qlonglong leftGroupImageId  = d->sortKeyColumns.groupImageIds.at(leftIndex);
+        const qlonglong rightGroupImageId = d->sortKeyColumns.groupImageIds.at(rightIndex);
+
+        if (leftGroupImageId != rightGroupImageId)
+        {
+            if (leftGroupImageId == rightInfo.id())
+            {
+                return false;
+            }
+
+            if (rightGroupImageId == leftInfo.id())
+            {
+                return true;
+            }
+
+            leftIndex  = (leftGroupImageId  == -1) ? leftIndex  : d->sortKeyIndex(leftGroupImageId);
+            rightIndex = (rightGroupImageId == -1) ? rightIndex : d->sortKeyIndex(rightGroupImageId);
+        }
+
+        if ((leftIndex != -1) && (rightIndex != -1))
+        {
+            const int leftPosition  = d->sortPositions.at(leftIndex);
+            const int rightPosition = d->sortPositions.at(rightIndex);
+
+            if ((leftPosition != -1) && (rightPosition != -1))
+            {
+                return (leftPosition < rightPosition);
+            }
+
+            return d->sorter.lessThan(d->sortKeyColumns, leftIndex, rightIndex);
+        }
+    }
+
     // Check grouping
 
     qlonglong leftGroupImageId  = leftInfo.groupImageId();
@@ -1273,6 +1416,27 @@ void ItemFilterModel::slotImageChange(const ImageChangeset& changeset)
         return;
     }
 
+    // keep the packed keys up to date, even when the view is not sorted again now
+
+    DatabaseFields::Set keyFields = ItemSortKeys::watchFlags();
+
+    if (keyFields & changeset.changes())
+    {
+        QList<qlonglong> keyIds;
+        const auto ids = changeset.ids();
+        d->sortKeys->invalidate(ids);
+
+        for (const qlonglong& id : ids)
+        {
+            if (d->sortKeyColumns.indexOf(id) != -1)
+            {
+                keyIds << id;
+            }
+        }
+
+        d->updateSortKeys(keyIds);
+    }
+
     // already scheduled to re-filter?
 
     if (d->updateFilterTimer->isActive())
@@ -1319,10 +1483,35 @@ void ItemFilterModel::slotImageChange(const ImageChangeset& changeset)
     }
     else
     {
+        d->prefetchSortKeys();
         invalidate();    // just resort, reuse filter results
     }
 }
 
+void ItemFilterModel::slotImageAttributesChanged(qlonglong imageId)
+{
+    Q_D(ItemFilterModel);
+
+    if (!d->imageModel || !d->imageModel->hasImage(imageId))
+    {
+        return;
+    }
+
+    // The view is sorted again by slotImageChange() if needed: only update the keys of the item.
+
+    d->sortKeys->invalidate(QList<qlonglong>() << imageId);
+    d->updateSortKeys(QList<qlonglong>() << imageId);
+}
+
+void ItemFilterModel::slotImageInfosAboutToBeAdded(const QList<ItemInfo>& infos)
+{
+    Q_D(ItemFilterModel);
+
+    // The new rows are sorted on insertion: load their keys before, with one query.
+
+    d->updateSortKeys(ItemInfoList(infos).toImageIdList());
+}
+
 // -------------------------------------------------------------------------------------------------------
 
 NoDuplicatesItemFilterModel::NoDuplicatesItemFilterModel(QObject* const parent)
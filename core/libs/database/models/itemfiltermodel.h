@@ -301,6 +301,8 @@ protected:
 
     /**
      * Reimplement to customize sorting. Do not take categories into account here.
+     * Note: when the sort role is covered by ItemSortKeys, the items are sorted
+     * from their packed keys and this method is not called.
      */
     virtual bool infosLessThan(const ItemInfo& left, const ItemInfo& right)                  const;
 
@@ -316,6 +318,8 @@ protected Q_SLOTS:
 
     void slotImageTagChange(const ImageTagChangeset& changeset);
     void slotImageChange(const ImageChangeset& changeset);
+    void slotImageAttributesChanged(qlonglong imageId);
+    void slotImageInfosAboutToBeAdded(const QList<ItemInfo>& infos);
 
     void slotRowsInserted(const QModelIndex& parent, int start, int end);
     void slotRowsAboutToBeRemoved(const QModelIndex& parent, int start, int end);
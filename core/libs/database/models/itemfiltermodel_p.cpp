@@ -27,6 +27,7 @@ namespace Digikam
 {
 
 ItemFilterModel::ItemFilterModelPrivate::ItemFilterModelPrivate()
+    : sortKeys(new ItemSortKeys)
 {
     setupWorkers();
 }
@@ -41,6 +42,7 @@ ItemFilterModel::ItemFilterModelPrivate::~ItemFilterModelPrivate()
 
     delete preparer;
     delete filterer;
+    delete sortKeys;
 }
 
 void ItemFilterModel::ItemFilterModelPrivate::init(ItemFilterModel* qq)
@@ -213,6 +215,14 @@ void ItemFilterModel::ItemFilterModelPrivate::packageFinished(const ItemFilterMo
 
     if ((sentOut == 0) && (sentOutForReAdd == 0) && !imageModel->isRefreshing())
     {
+        // The items added one package after the other are sorted again at once, from their keys.
+
+        if (sortPositions.contains(-1))
+        {
+            sortKeysValid = false;
+        }
+
+        prefetchSortKeys();
         q->invalidate(); // use invalidate, not invalidateFilter only. Sorting may have changed as well.
 
         Q_EMIT q->filterMatches(hasOneMatch);
@@ -223,6 +233,75 @@ void ItemFilterModel::ItemFilterModelPrivate::packageFinished(const ItemFilterMo
     }
 }
 
+int ItemFilterModel::ItemFilterModelPrivate::sortKeyIndex(qlonglong imageId) const
+{
+    prefetchSortKeys();
+
+    if (!sortKeysCovered)
+    {
+        return -1;
+    }
+
+    // An item without keys is compared from its ItemInfo: no database query while sorting.
+
+    return sortKeyColumns.indexOf(imageId);
+}
+
+void ItemFilterModel::ItemFilterModelPrivate::prefetchSortKeys() const
+{
+    if (sortKeysValid)
+    {
+        return;
+    }
+
+    sortKeysValid   = true;
+    sortKeysCovered = ItemSortKeys::covers(sorter);
+    sortKeyColumns  = ItemSortKeyColumns();
+    sortPositions.clear();
+
+    if (sortKeysCovered && imageModel)
+    {
+        sortKeyColumns = sortKeys->columns(imageModel->imageIds(), true);
+        sortPositions  = ItemSortKeys::sortPositions(sortKeyColumns, sorter);
+    }
+}
+
+void ItemFilterModel::ItemFilterModelPrivate::updateSortKeys(const QList<qlonglong>& imageIds)
+{
+    if (!sortKeysValid || !sortKeysCovered || imageIds.isEmpty())
+    {
+        return;
+    }
+
+    // The updated items lose their position and are compared key by key,
+    // until the whole model is sorted again.
+
+    const ItemSortKeyColumns updated = sortKeys->columns(imageIds, true);
+
+    for (int i = 0 ; i < updated.size() ; ++i)
+    {
+        const int index = sortKeyColumns.indexOf(updated.ids.at(i));
+
+        if (index != -1)
+        {
+            sortKeyColumns.replace(index, updated, i);
+            sortPositions[index] = -1;
+        }
+        else
+        {
+            sortKeyColumns.append(updated, i);
+            sortPositions << -1;
+        }
+    }
+}
+
+void ItemFilterModel::ItemFilterModelPrivate::invalidateSortKeys()
+{
+    sortKeysValid  = false;
+    sortKeyColumns = ItemSortKeyColumns();
+    sortPositions.clear();
+}
+
 void ItemFilterModel::ItemFilterModelPrivate::packageDiscarded(const ItemFilterModelTodoPackage& package)
 {
     // Either, the model was reset, or the filter changed
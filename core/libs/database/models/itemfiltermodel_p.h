@@ -28,6 +28,7 @@
 
 #include "iteminfo.h"
 #include "itemfiltermodel.h"
+#include "itemsortkeys.h"
 #include "digikam_export.h"
 
 // NOTE: we need the EXPORT macro in a private header because
@@ -83,6 +84,24 @@ public:
     void infosToProcess(const QList<ItemInfo>& infos);
     void infosToProcess(const QList<ItemInfo>& infos, const QList<QVariant>& extraValues, bool forReAdd = true);
 
+    /**
+     * Return the index of the item in the packed sort keys, or -1 if the sort
+     * settings are not covered by the keys or the item has no keys.
+     */
+    int  sortKeyIndex(qlonglong imageId) const;
+
+    /**
+     * Load the keys and compute the sort positions of all model items, with one
+     * query, if invalidateSortKeys() was called. Call it before sorting.
+     */
+    void prefetchSortKeys() const;
+
+    /**
+     * Load again the keys of the items, and add the items not yet known.
+     */
+    void updateSortKeys(const QList<qlonglong>& imageIds);
+    void invalidateSortKeys();
+
 public:
 
     ItemFilterModel*                   q                    = nullptr;
@@ -120,6 +139,17 @@ public:
 
     QList<ItemFilterModelPrepareHook*> prepareHooks;
 
+    /// Shared with the filter thread, which loads the keys of the packages.
+    ItemSortKeys*                      sortKeys             = nullptr;
+    bool                               loadSortKeys         = true;
+
+    /// Keys and sort positions of the model items, used in the GUI thread only.
+    /// The items added since the last sort of the whole model have no position.
+    mutable ItemSortKeyColumns         sortKeyColumns;
+    mutable QVector<int>               sortPositions;
+    mutable bool                       sortKeysValid        = false;
+    mutable bool                       sortKeysCovered      = false;
+
 /*
     QHash<int, QSet<qlonglong> >       categoryCountHashInt;
     QHash<QString, QSet<qlonglong> >   categoryCountHashString;
@@ -32,6 +32,7 @@
 #include "digikam_globals.h"
 #include "coredbfields.h"
 #include "iteminfo.h"
+#include "itemsortkeys.h"
 #include "tagscache.h"
 #include "versionmanagersettings.h"
 
@@ -423,51 +424,9 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
 
     //-- Filter by rating ---------------------------------------------------------
 
-    if (m_ratingFilter >= 0)
+    if ((m_ratingFilter >= 0) && !matchesRating(info.rating()))
     {
-        // for now we treat -1 (no rating) just like a rating of 0.
-
-        int rating = info.rating();
-
-        if (rating == -1)
-        {
-            rating = 0;
-        }
-
-        if (m_isUnratedExcluded && (rating == 0))
-        {
-            match = false;
-        }
-        else
-        {
-            if      (m_ratingCond == GreaterEqualCondition)
-            {
-                // If the rating is not >=, i.e it is <, then it does not match.
-
-                if (rating < m_ratingFilter)
-                {
-                    match = false;
-                }
-            }
-            else if (m_ratingCond == EqualCondition)
-            {
-                // If the rating is not =, i.e it is !=, then it does not match.
-
-                if (rating != m_ratingFilter)
-                {
-                    match = false;
-                }
-            }
-            else
-            {
-                // If the rating is not <=, i.e it is >, then it does not match.
-
-                if (rating > m_ratingFilter)
-                {
-                    match = false;
-                }
-            }
-        }
+        match = false;
     }
 
     // -- Filter by mime type -----------------------------------------------------
@@ -873,6 +832,53 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
     return match;
 }
 
+bool ItemFilterSettings::matchesKeys(const ItemSortKeyColumns& keys, int index) const
+{
+    if (!m_dayFilter.isEmpty() && !m_dayFilter.contains(QDateTime(keys.creationDays.at(index), QTime())))
+    {
+        return false;
+    }
+
+    if ((m_ratingFilter >= 0) && !matchesRating(keys.ratings.at(index)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool ItemFilterSettings::matchesRating(int rating) const
+{
+    // for now we treat -1 (no rating) just like a rating of 0.
+
+    if (rating == -1)
+    {
+        rating = 0;
+    }
+
+    if (m_isUnratedExcluded && (rating == 0))
+    {
+        return false;
+    }
+
+    if      (m_ratingCond == GreaterEqualCondition)
+    {
+        // If the rating is not >=, i.e it is <, then it does not match.
+
+        return (rating >= m_ratingFilter);
+    }
+    else if (m_ratingCond == EqualCondition)
+    {
+        // If the rating is not =, i.e it is !=, then it does not match.
+
+        return (rating == m_ratingFilter);
+    }
+
+    // If the rating is not <=, i.e it is >, then it does not match.
+
+    return (rating <= m_ratingFilter);
+}
+
 // -------------------------------------------------------------------------------------------------
 
 VersionItemFilterSettings::VersionItemFilterSettings(const VersionManagerSettings& settings)
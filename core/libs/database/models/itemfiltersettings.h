@@ -38,6 +38,7 @@ namespace Digikam
 {
 
 class ItemInfo;
+class ItemSortKeyColumns;
 class VersionManagerSettings;
 
 namespace DatabaseFields
@@ -118,6 +119,13 @@ public:
      */
     bool matches(const ItemInfo& info, bool* const foundText = nullptr) const;
 
+    /**
+     *  Returns false if the item at the given index of the packed keys does not match
+     *  the rating and date filters. This is a quick rejection test without ItemInfo:
+     *  an item passing it must still be checked with matches().
+     */
+    bool matchesKeys(const ItemSortKeyColumns& keys, int index)         const;
+
 public:
 
     /// --- Tags filter ---
@@ -212,6 +220,8 @@ private:
      */
     bool isFilteringInternally()                            const;
 
+    bool matchesRating(int rating)                          const;
+
 private:
 
     /// --- Tags filter ---
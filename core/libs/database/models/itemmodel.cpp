@@ -18,6 +18,7 @@
 // Qt includes
 
 #include <QHash>
+#include <QSet>
 #include <QItemSelection>
 
 // Local includes
@@ -63,8 +64,50 @@ public:
     ItemInfoList                       pendingInfos;
     QList<QVariant>                    pendingExtraValues;
 
+    DatabaseFields::Set                prefetchFields;
+    QSet<qlonglong>                    prefetchedIds;
+    const int                          prefetchPageSize             = 256;
+
 public:
 
+    inline bool hasPrefetchFields() const
+    {
+        return (prefetchFields.getImages()           != DatabaseFields::ImagesNone)           ||
+               (prefetchFields.getItemInformation()  != DatabaseFields::ItemInformationNone)  ||
+               (prefetchFields.getItemComments()     != DatabaseFields::ItemCommentsNone)     ||
+               (prefetchFields.getItemPositions()    != DatabaseFields::ItemPositionsNone)    ||
+               (prefetchFields.getImageHistoryInfo() != DatabaseFields::ImageHistoryInfoNone);
+    }
+
+    /**
+     * Load the prefetch fields of the page of items around the row,
+     * if the item was not yet prefetched.
+     */
+    void prefetch(int row)
+    {
+        if (!hasPrefetchFields() || prefetchedIds.contains(infos.at(row).id()))
+        {
+            return;
+        }
+
+        const int begin = qMax(0, row - prefetchPageSize / 2);
+        const int end   = qMin(infos.size(), begin + prefetchPageSize);
+        ItemInfoList page;
+
+        for (int i = begin ; i < end ; ++i)
+        {
+            const ItemInfo& info = infos.at(i);
+
+            if (!prefetchedIds.contains(info.id()))
+            {
+                prefetchedIds << info.id();
+                page          << info;
+            }
+        }
+
+        page.prefetch(prefetchFields);
+    }
+
     inline bool isValid(const QModelIndex& index)
     {
         if (!index.isValid())
@@ -181,6 +224,22 @@ void ItemModel::setWatchFlags(const DatabaseFields::Set& set)
     d->watchFlags = set;
 }
 
+void ItemModel::setPrefetchFields(const DatabaseFields::Set& set)
+{
+    d->prefetchFields = set;
+    d->prefetchedIds.clear();
+}
+
+void ItemModel::prefetch(const QModelIndex& index)
+{
+    if (!d->isValid(index))
+    {
+        return;
+    }
+
+    d->prefetch(index.row());
+}
+
 ItemInfo ItemModel::imageInfo(const QModelIndex& index) const
 {
     if (!d->isValid(index))
@@ -586,6 +645,7 @@ void ItemModel::clearItemInfos()
     d->extraValues.clear();
     d->idHash.clear();
     d->filePathHash.clear();
+    d->prefetchedIds.clear();
 
     delete d->incrementalUpdater;
 
@@ -1127,6 +1187,16 @@ void ItemModel::removeRowPairs(const QList<QPair<int, int> >& toRemove)
         }
     }
 
+    // the data of the removed items may leave the ItemInfo cache: prefetch them again if added back
+
+    for (const qlonglong& id : std::as_const(removeFilePaths))
+    {
+        if (!d->idHash.contains(id))
+        {
+            d->prefetchedIds.remove(id);
+        }
+    }
+
     // tidy up: remove old indexes from file path hash now
 
     if (d->keepFilePathCache)
@@ -1430,6 +1500,18 @@ void ItemModel::slotImageChange(const ImageChangeset& changeset)
         return;
     }
 
+    if (d->prefetchFields & changeset.changes())
+    {
+        // The ItemInfo cache dropped the changed fields: load them again with the next page.
+
+        const auto ids = changeset.ids();
+
+        for (const qlonglong& id : ids)
+        {
+            d->prefetchedIds.remove(id);
+        }
+    }
+
     if (d->watchFlags & changeset.changes())
     {
         if (changeset.changes() & DatabaseFields::Name)
@@ -1493,6 +1575,7 @@ void ItemModel::slotImageTagChange(const ImageTagChangeset& changeset)
         if (index.isValid())
         {
             items.select(index, index);
+            d->prefetchedIds.remove(id);
         }
     }
 
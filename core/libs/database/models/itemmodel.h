@@ -116,6 +116,22 @@ public:
      */
     void setWatchFlags(const DatabaseFields::Set& set);
 
+    /**
+     * Set the database fields to load in advance for the views.
+     * When prefetch() is called for an index, these fields are loaded for the
+     * page of items around it, with one database query per table, instead of
+     * one query per item and field when the delegate paints.
+     * See ItemInfoCache::prefetch() for the supported fields.
+     * Default is no flag (no prefetch).
+     */
+    void setPrefetchFields(const DatabaseFields::Set& set);
+
+    /**
+     * Load the prefetch fields of the page of items around the index,
+     * if the item was not yet prefetched. Views call it before painting.
+     */
+    void prefetch(const QModelIndex& index);
+
     /**
      * Returns the ItemInfo object, reference or image id from the underlying data
      * pointed to by the index.
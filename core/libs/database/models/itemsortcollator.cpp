@@ -30,18 +30,43 @@ class Q_DECL_HIDDEN ItemSortCollator::Private
 {
 public:
 
-    Private()
+    Private() = default;
+
+    /**
+     * The collators are configured before each comparison: each thread
+     * has its own instances, for the items sorted from several threads.
+     */
+    static QCollator& itemCollator()
     {
-        itemCollator.setNumericMode(true);
-        albumCollator.setNumericMode(true);
-        albumCollator.setIgnorePunctuation(false);
+        thread_local QCollator collator = []()
+            {
+                QCollator c;
+                c.setNumericMode(true);
+
+                return c;
+            }();
+
+        return collator;
     }
 
+    static QCollator& albumCollator()
+    {
+        thread_local QCollator collator = []()
+            {
+                QCollator c;
+                c.setNumericMode(true);
+                c.setIgnorePunctuation(false);
+
+                return c;
+            }();
+
+        return collator;
+    }
+
+public:
+
     const QString            versionStr     = QLatin1String("_v");
     const QRegularExpression versionExp     = QRegularExpression(QRegularExpression::anchoredPattern(QLatin1String("(.+)_v(\\d+)(.+)?")));
-
-    QCollator                itemCollator;
-    QCollator                albumCollator;
 };
 
 // -----------------------------------------------------------------------------------------------
@@ -90,10 +115,11 @@ int ItemSortCollator::itemCompare(const QString& a, const QString& b,
                          );
         }
 
-        d->itemCollator.setCaseSensitivity(caseSensitive);
-        d->itemCollator.setIgnorePunctuation(hasVersion);
+        QCollator& collator = Private::itemCollator();
+        collator.setCaseSensitivity(caseSensitive);
+        collator.setIgnorePunctuation(hasVersion);
 
-        return d->itemCollator.compare(a, b);
+        return collator.compare(a, b);
     }
 
     return QString::compare(a, b, caseSensitive);
@@ -104,9 +130,10 @@ int ItemSortCollator::albumCompare(const QString& a, const QString& b,
 {
     if (natural)
     {
-        d->albumCollator.setCaseSensitivity(caseSensitive);
+        QCollator& collator = Private::albumCollator();
+        collator.setCaseSensitivity(caseSensitive);
 
-        return d->albumCollator.compare(a, b);
+        return collator.compare(a, b);
     }
 
     return QString::compare(a, b, caseSensitive);
@@ -0,0 +1,497 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Packed sort and filter keys of the items for ItemFilterModel
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "itemsortkeys.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+// Qt includes
+
+#include <QDateTime>
+#include <QFuture>
+#include <QReadLocker>
+#include <QReadWriteLock>
+#include <QThread>
+#include <QWriteLocker>
+#include <QtConcurrent>    // krazy:exclude=includes
+
+// Local includes
+
+#include "collectionmanager.h"
+#include "coredb.h"
+#include "coredbaccess.h"
+#include "coredbfields.h"
+#include "itemsortcollator.h"
+#include "itemsortsettings.h"
+
+namespace Digikam
+{
+
+/**
+ * Sort the indexes with a stable sort: the chunks of the list are sorted in parallel,
+ * then merged pairwise. The comparison function must be thread-safe.
+ */
+template <typename LessThan>
+static void parallelSort(QVector<int>& indexes, const LessThan& lessThan)
+{
+    // Small lists are sorted in the calling thread.
+
+    const int size   = indexes.size();
+    const int chunks = qBound(1, size / 10000, QThread::idealThreadCount());
+
+    if (chunks == 1)
+    {
+        std::stable_sort(indexes.begin(), indexes.end(), lessThan);
+
+        return;
+    }
+
+    int* const data = indexes.data();
+    QVector<int> bounds;
+
+    for (int i = 0 ; i <= chunks ; ++i)
+    {
+        bounds << int((qint64)size * i / chunks);
+    }
+
+    QList<QFuture<void> > tasks;
+
+    for (int i = 0 ; i < chunks ; ++i)
+    {
+        int* const begin = data + bounds.at(i);
+        int* const end   = data + bounds.at(i + 1);
+
+        tasks.append(QtConcurrent::run([begin, end, &lessThan]()
+            {
+                std::stable_sort(begin, end, lessThan);
+            }
+        ));
+    }
+
+    for (QFuture<void> t : std::as_const(tasks))
+    {
+        t.waitForFinished();
+    }
+
+    for (int width = 1 ; width < chunks ; width *= 2)
+    {
+        tasks.clear();
+
+        for (int i = 0 ; (i + width) < chunks ; i += 2 * width)
+        {
+            int* const begin  = data + bounds.at(i);
+            int* const middle = data + bounds.at(i + width);
+            int* const end    = data + bounds.at(qMin(i + 2 * width, chunks));
+
+            tasks.append(QtConcurrent::run([begin, middle, end, &lessThan]()
+                {
+                    std::inplace_merge(begin, middle, end, lessThan);
+                }
+            ));
+        }
+
+        for (QFuture<void> t : std::as_const(tasks))
+        {
+            t.waitForFinished();
+        }
+    }
+}
+
+/**
+ * Return the rank of each string in the natural order. Equal strings have the same rank.
+ */
+static QVector<int> rankStrings(const QVector<QString>& strings, Qt::CaseSensitivity caseSensitive, bool natural)
+{
+    ItemSortCollator* const collator = ItemSortCollator::instance();
+    QVector<int> order(strings.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    parallelSort(order, [&strings, collator, caseSensitive, natural](int a, int b)
+        {
+            return (collator->itemCompare(strings.at(a), strings.at(b), caseSensitive, natural) < 0);
+        }
+    );
+
+    QVector<int> ranks(strings.size());
+    int rank = 0;
+
+    for (int i = 0 ; i < order.size() ; ++i)
+    {
+        if ((i > 0) && (collator->itemCompare(strings.at(order.at(i - 1)), strings.at(order.at(i)),
+                                              caseSensitive, natural) != 0))
+        {
+            ++rank;
+        }
+
+        ranks[order.at(i)] = rank;
+    }
+
+    return ranks;
+}
+
+static inline qint64 dateKey(const QDateTime& dateTime)
+{
+    return (dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min());
+}
+
+// ------------------------------------------------------------------------------------------
+
+void ItemSortKeyColumns::append(const ItemSortKeyColumns& other, int otherIndex)
+{
+    ids               << -1;
+    groupImageIds     << -1;
+    albumIds          << 0;
+    albumRootIds      << 0;
+    albumPaths        << QString();
+    names             << QString();
+    categories        << 0;
+    modificationDates << 0;
+    creationDates     << 0;
+    creationDays      << QDate();
+    fileSizes         << 0;
+    manualOrders      << 0;
+    ratings           << 0;
+    widths            << 0;
+    heights           << 0;
+    formats           << QString();
+    nameRanks         << -1;
+    pathRanks         << -1;
+    formatRanks       << -1;
+
+    replace(ids.size() - 1, other, otherIndex);
+}
+
+void ItemSortKeyColumns::replace(int index, const ItemSortKeyColumns& other, int otherIndex)
+{
+    if (ids.at(index) != -1)
+    {
+        indexes.remove(ids.at(index));
+    }
+
+    ids[index]               = other.ids.at(otherIndex);
+    groupImageIds[index]     = other.groupImageIds.at(otherIndex);
+    albumIds[index]          = other.albumIds.at(otherIndex);
+    albumRootIds[index]      = other.albumRootIds.at(otherIndex);
+    albumPaths[index]        = other.albumPaths.at(otherIndex);
+    names[index]             = other.names.at(otherIndex);
+    categories[index]        = other.categories.at(otherIndex);
+    modificationDates[index] = other.modificationDates.at(otherIndex);
+    creationDates[index]     = other.creationDates.at(otherIndex);
+    creationDays[index]      = other.creationDays.at(otherIndex);
+    fileSizes[index]         = other.fileSizes.at(otherIndex);
+    manualOrders[index]      = other.manualOrders.at(otherIndex);
+    ratings[index]           = other.ratings.at(otherIndex);
+    widths[index]            = other.widths.at(otherIndex);
+    heights[index]           = other.heights.at(otherIndex);
+    formats[index]           = other.formats.at(otherIndex);
+    nameRanks[index]         = -1;
+    pathRanks[index]         = -1;
+    formatRanks[index]       = -1;
+
+    indexes.insert(ids.at(index), index);
+}
+
+void ItemSortKeyColumns::release(int index)
+{
+    indexes.remove(ids.at(index));
+
+    ids[index]        = -1;
+    albumPaths[index] = QString();
+    names[index]      = QString();
+    formats[index]    = QString();
+}
+
+QString ItemSortKeyColumns::filePath(int index) const
+{
+    // Same as ItemInfo::filePath()
+
+    const QString albumRoot = CollectionManager::instance()->albumRootPath(albumRootIds.at(index));
+
+    if (albumRoot.isNull())
+    {
+        return QString();
+    }
+
+    const QString& album = albumPaths.at(index);
+
+    if (album == QLatin1String("/"))
+    {
+        return (albumRoot + album + names.at(index));
+    }
+
+    return (albumRoot + album + QLatin1Char('/') + names.at(index));
+}
+
+// ------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ItemSortKeys::Private
+{
+public:
+
+    Private() = default;
+
+    QList<qlonglong> missing(const QList<qlonglong>& imageIds);
+    void             load(const QList<qlonglong>& imageIds);
+
+public:
+
+    QReadWriteLock     lock;
+    ItemSortKeyColumns keys;
+    QVector<int>       freeSlots;
+};
+
+QList<qlonglong> ItemSortKeys::Private::missing(const QList<qlonglong>& imageIds)
+{
+    QList<qlonglong> ids;
+    QReadLocker locker(&lock);
+
+    for (const qlonglong id : imageIds)
+    {
+        if (keys.indexOf(id) == -1)
+        {
+            ids << id;
+        }
+    }
+
+    return ids;
+}
+
+void ItemSortKeys::Private::load(const QList<qlonglong>& imageIds)
+{
+    if (imageIds.isEmpty())
+    {
+        return;
+    }
+
+    // The query runs without lock, the other threads keep reading the loaded keys.
+
+    const QVariantList values = CoreDbAccess().db()->getItemSortKeys(imageIds);
+    const int fieldCount      = 15;
+    ItemSortKeyColumns loaded;
+
+    for (int row = 0 ; (row + fieldCount) <= values.size() ; row += fieldCount)
+    {
+        const QDateTime creationDate = values.at(row + 10).toDateTime();
+
+        loaded.ids               << values.at(row).toLongLong();
+        loaded.albumIds          << values.at(row + 1).toInt();
+        loaded.albumRootIds      << values.at(row + 2).toInt();
+        loaded.albumPaths        << values.at(row + 3).toString();
+        loaded.names             << values.at(row + 4).toString();
+        loaded.categories        << values.at(row + 5).toInt();
+        loaded.modificationDates << dateKey(values.at(row + 6).toDateTime());
+        loaded.fileSizes         << values.at(row + 7).toLongLong();
+        loaded.manualOrders      << values.at(row + 8).toLongLong();
+        loaded.ratings           << values.at(row + 9).toInt();
+        loaded.creationDates     << dateKey(creationDate);
+        loaded.creationDays      << creationDate.date();
+        loaded.widths            << values.at(row + 11).toInt();
+        loaded.heights           << values.at(row + 12).toInt();
+        loaded.formats           << values.at(row + 13).toString();
+        loaded.groupImageIds     << (values.at(row + 14).isNull() ? -1 : values.at(row + 14).toLongLong());
+    }
+
+    QWriteLocker locker(&lock);
+
+    for (int i = 0 ; i < loaded.ids.size() ; ++i)
+    {
+        const int index = keys.indexOf(loaded.ids.at(i));
+
+        if      (index != -1)
+        {
+            keys.replace(index, loaded, i);
+        }
+        else if (!freeSlots.isEmpty())
+        {
+            keys.replace(freeSlots.takeLast(), loaded, i);
+        }
+        else
+        {
+            keys.append(loaded, i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+
+ItemSortKeys::ItemSortKeys()
+    : d(new Private)
+{
+}
+
+ItemSortKeys::~ItemSortKeys()
+{
+    delete d;
+}
+
+ItemSortKeyColumns ItemSortKeys::columns(const QList<qlonglong>& imageIds, bool includeGroupLeaders)
+{
+    d->load(d->missing(imageIds));
+
+    ItemSortKeyColumns result;
+
+    {
+        QReadLocker locker(&d->lock);
+
+        for (const qlonglong id : imageIds)
+        {
+            const int index = d->keys.indexOf(id);
+
+            if ((index != -1) && (result.indexOf(id) == -1))
+            {
+                result.append(d->keys, index);
+            }
+        }
+    }
+
+    if (includeGroupLeaders)
+    {
+        QList<qlonglong> leaders;
+
+        for (const qlonglong leader : std::as_const(result.groupImageIds))
+        {
+            if ((leader != -1) && (result.indexOf(leader) == -1))
+            {
+                leaders << leader;
+            }
+        }
+
+        if (!leaders.isEmpty())
+        {
+            const ItemSortKeyColumns leaderColumns = columns(leaders);
+
+            for (int i = 0 ; i < leaderColumns.size() ; ++i)
+            {
+                result.append(leaderColumns, i);
+            }
+        }
+    }
+
+    return result;
+}
+
+void ItemSortKeys::invalidate(const QList<qlonglong>& imageIds)
+{
+    QWriteLocker locker(&d->lock);
+
+    for (const qlonglong id : imageIds)
+    {
+        const int index = d->keys.indexOf(id);
+
+        if (index != -1)
+        {
+            d->keys.release(index);
+            d->freeSlots << index;
+        }
+    }
+}
+
+void ItemSortKeys::clear()
+{
+    QWriteLocker locker(&d->lock);
+
+    d->keys = ItemSortKeyColumns();
+    d->freeSlots.clear();
+}
+
+bool ItemSortKeys::covers(const ItemSortSettings& sorter)
+{
+    return (
+            (sorter.sortRole != ItemSortSettings::SortBySimilarity) &&
+            (sorter.sortRole != ItemSortSettings::SortByFaces)
+           );
+}
+
+DatabaseFields::Set ItemSortKeys::watchFlags()
+{
+    DatabaseFields::Set set;
+
+    set |= DatabaseFields::Album            |
+           DatabaseFields::Name             |
+           DatabaseFields::Category         |
+           DatabaseFields::ModificationDate |
+           DatabaseFields::FileSize         |
+           DatabaseFields::ManualOrder;
+
+    set |= DatabaseFields::Rating           |
+           DatabaseFields::CreationDate     |
+           DatabaseFields::Width            |
+           DatabaseFields::Height           |
+           DatabaseFields::Format;
+
+    set |= DatabaseFields::ImageRelations;
+
+    return set;
+}
+
+QVector<int> ItemSortKeys::sortPositions(ItemSortKeyColumns& columns, const ItemSortSettings& sorter)
+{
+    const int size = columns.size();
+
+    // The names are the first tie-breaker of all sort roles.
+
+    columns.nameRanks = rankStrings(columns.names, sorter.sortCaseSensitivity, sorter.strTypeNatural);
+
+    if (sorter.sortRole == ItemSortSettings::SortByFilePath)
+    {
+        QVector<QString> paths;
+        paths.reserve(size);
+
+        for (int i = 0 ; i < size ; ++i)
+        {
+            paths << columns.filePath(i);
+        }
+
+        columns.pathRanks = rankStrings(paths, sorter.sortCaseSensitivity, sorter.strTypeNatural);
+    }
+    else
+    {
+        columns.pathRanks.fill(-1, size);
+    }
+
+    if (sorter.categorizationMode == ItemSortSettings::CategoryByFormat)
+    {
+        columns.formatRanks = rankStrings(columns.formats, sorter.categorizationCaseSensitivity, sorter.strTypeNatural);
+    }
+    else
+    {
+        columns.formatRanks.fill(-1, size);
+    }
+
+    QVector<int> order(size);
+    std::iota(order.begin(), order.end(), 0);
+
+    const ItemSortKeyColumns& keys = columns;
+
+    parallelSort(order, [&keys, &sorter](int a, int b)
+        {
+            return sorter.lessThan(keys, a, b);
+        }
+    );
+
+    QVector<int> positions(size);
+
+    for (int i = 0 ; i < size ; ++i)
+    {
+        positions[order.at(i)] = i;
+    }
+
+    return positions;
+}
+
+} // namespace Digikam
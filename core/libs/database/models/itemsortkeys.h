@@ -0,0 +1,165 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Packed sort and filter keys of the items for ItemFilterModel
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+class ItemSortSettings;
+
+namespace DatabaseFields
+{
+    class Set;
+}
+
+/**
+ * The keys used to sort and filter a list of items, stored per column:
+ * the value of the item at index i is at index i of each vector.
+ * The dates are stored as milliseconds since epoch, an invalid date
+ * being less than all valid ones.
+ */
+class DIGIKAM_DATABASE_EXPORT ItemSortKeyColumns
+{
+public:
+
+    ItemSortKeyColumns() = default;
+
+    int     size()                                                                      const
+    {
+        return ids.size();
+    }
+
+    /**
+     * Return the index of the item, or -1 if the item is not in the columns.
+     */
+    int     indexOf(qlonglong imageId)                                                  const
+    {
+        return indexes.value(imageId, -1);
+    }
+
+    /**
+     * Append or replace the keys of the item at index otherIndex of other.
+     * The string ranks are reset: they are computed for a whole list of items.
+     */
+    void    append(const ItemSortKeyColumns& other, int otherIndex);
+    void    replace(int index, const ItemSortKeyColumns& other, int otherIndex);
+
+    /**
+     * Remove the item from the index. Its entry in the columns stays as a free slot.
+     */
+    void    release(int index);
+
+    QString filePath(int index)                                                         const;
+
+public:
+
+    QHash<qlonglong, int> indexes;
+
+    QVector<qlonglong>    ids;
+    QVector<qlonglong>    groupImageIds;
+    QVector<int>          albumIds;
+    QVector<int>          albumRootIds;
+    QVector<QString>      albumPaths;
+    QVector<QString>      names;
+    QVector<int>          categories;
+    QVector<qint64>       modificationDates;
+    QVector<qint64>       creationDates;
+    QVector<QDate>        creationDays;
+    QVector<qlonglong>    fileSizes;
+    QVector<qlonglong>    manualOrders;
+    QVector<int>          ratings;
+    QVector<int>          widths;
+    QVector<int>          heights;
+    QVector<QString>      formats;
+
+    /// Ranks of the strings in their natural order, -1 if not computed.
+    QVector<int>          nameRanks;
+    QVector<int>          pathRanks;
+    QVector<int>          formatRanks;
+};
+
+// ------------------------------------------------------------------------------------------
+
+/**
+ * A thread-safe store of the sort and filter keys of the items, loaded from the
+ * database with one query for a whole list of items. ItemFilterModel fills it
+ * from its filter thread and sorts from the packed keys, instead of calling the
+ * ItemInfo accessors for each comparison.
+ */
+class DIGIKAM_DATABASE_EXPORT ItemSortKeys
+{
+public:
+
+    ItemSortKeys();
+    ~ItemSortKeys();
+
+    /**
+     * Return the packed keys of the items, in the order of the list.
+     * The keys of the items not yet in the store are loaded with one database query.
+     * Duplicated and unknown items are skipped.
+     * If includeGroupLeaders is true, the group leaders of the items are appended.
+     */
+    ItemSortKeyColumns columns(const QList<qlonglong>& imageIds, bool includeGroupLeaders = false);
+
+    /**
+     * Forget the keys of the items: they are loaded again on next use.
+     */
+    void invalidate(const QList<qlonglong>& imageIds);
+    void clear();
+
+public:
+
+    /**
+     * Returns true if the sort role of the settings is computed from the keys.
+     * Sorting by similarity and by faces needs the ItemInfo.
+     */
+    static bool covers(const ItemSortSettings& sorter);
+
+    /**
+     * Returns database fields a change in which changes the keys.
+     */
+    static DatabaseFields::Set watchFlags();
+
+    /**
+     * Compute the ranks of the strings used by the sort settings, and return
+     * the position of each item in the sort order. Both use a parallel sort.
+     */
+    static QVector<int> sortPositions(ItemSortKeyColumns& columns, const ItemSortSettings& sorter);
+
+private:
+
+    // Disable
+    ItemSortKeys(const ItemSortKeys&)            = delete;
+    ItemSortKeys& operator=(const ItemSortKeys&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+};
+
+} // namespace Digikam
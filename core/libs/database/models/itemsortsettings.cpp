@@ -23,6 +23,7 @@
 // Local includes
 
 #include "iteminfo.h"
+#include "itemsortkeys.h"
 #include "coredbfields.h"
 #include "facetagseditor.h"
 
@@ -464,6 +465,192 @@ int ItemSortSettings::compare(const ItemInfo& left, const ItemInfo& right, SortR
     }
 }
 
+/**
+ * Compare the strings from their ranks when both are computed, else with the collator.
+ */
+static inline int compareKeyStrings(const QVector<int>& ranks, int left, int right,
+                                    const QString& leftValue, const QString& rightValue,
+                                    Qt::SortOrder sortOrder, Qt::CaseSensitivity caseSensitive, bool natural)
+{
+    if ((ranks.at(left) != -1) && (ranks.at(right) != -1))
+    {
+        return ItemSortSettings::compareByOrder(ranks.at(left), ranks.at(right), sortOrder);
+    }
+
+    return ItemSortSettings::naturalCompare(leftValue, rightValue, sortOrder, caseSensitive, natural);
+}
+
+int ItemSortSettings::compareCategories(const ItemSortKeyColumns& keys, int left, int right) const
+{
+    switch (categorizationMode)
+    {
+        case CategoryByAlbum:
+        {
+            int leftAlbum  = keys.albumIds.at(left);
+            int rightAlbum = keys.albumIds.at(right);
+
+            if      (leftAlbum == rightAlbum)
+            {
+                return 0;
+            }
+            else if (lessThanByOrder(leftAlbum, rightAlbum, currentCategorizationSortOrder))
+            {
+                return -1;
+            }
+
+            return 1;
+        }
+
+        case CategoryByFormat:
+        {
+            return compareKeyStrings(keys.formatRanks, left, right,
+                                     keys.formats.at(left), keys.formats.at(right),
+                                     currentCategorizationSortOrder,
+                                     categorizationCaseSensitivity, strTypeNatural);
+        }
+
+        case CategoryByMonth:
+        {
+            const QDate& leftDate  = keys.creationDays.at(left);
+            const QDate& rightDate = keys.creationDays.at(right);
+            int leftMonth          = leftDate.year()  * 100 + leftDate.month();
+            int rightMonth         = rightDate.year() * 100 + rightDate.month();
+
+            return compareByOrder(leftMonth, rightMonth, currentCategorizationSortOrder);
+        }
+
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+bool ItemSortSettings::lessThan(const ItemSortKeyColumns& keys, int left, int right) const
+{
+    int result = compare(keys, left, right, sortRole);
+
+    if (result != 0)
+    {
+        return (result < 0);
+    }
+
+    if (keys.ids.at(left) == keys.ids.at(right))
+    {
+        return false;
+    }
+
+    // Same hierarchy of sort orders as for the ItemInfos
+
+    const SortRole hierarchy[] =
+    {
+        SortByFileName,
+        SortByCreationDate,
+        SortByModificationDate,
+        SortByFilePath,
+        SortByFileSize,
+        SortByManualOrderAndName,
+        SortByManualOrderAndDate
+    };
+
+    for (const SortRole role : hierarchy)
+    {
+        if ((result = compare(keys, left, right, role)) != 0)
+        {
+            return (result < 0);
+        }
+    }
+
+    return false;
+}
+
+int ItemSortSettings::compare(const ItemSortKeyColumns& keys, int left, int right, SortRole role) const
+{
+    switch (role)
+    {
+        case SortByFileName:
+        {
+            return compareKeyStrings(keys.nameRanks, left, right,
+                                     keys.names.at(left), keys.names.at(right),
+                                     currentSortOrder, sortCaseSensitivity, strTypeNatural);
+        }
+
+        case SortByFilePath:
+        {
+            if ((keys.pathRanks.at(left) != -1) && (keys.pathRanks.at(right) != -1))
+            {
+                return compareByOrder(keys.pathRanks.at(left), keys.pathRanks.at(right), currentSortOrder);
+            }
+
+            return naturalCompare(keys.filePath(left), keys.filePath(right),
+                                  currentSortOrder, sortCaseSensitivity, strTypeNatural);
+        }
+
+        case SortByFileSize:
+        {
+            return compareByOrder(keys.fileSizes.at(left), keys.fileSizes.at(right), currentSortOrder);
+        }
+
+        case SortByCreationDate:
+        {
+            return compareByOrder(keys.creationDates.at(left), keys.creationDates.at(right), currentSortOrder);
+        }
+
+        case SortByModificationDate:
+        {
+            return compareByOrder(keys.modificationDates.at(left), keys.modificationDates.at(right), currentSortOrder);
+        }
+
+        case SortByRating:
+        {
+            return (- compareByOrder(keys.ratings.at(left), keys.ratings.at(right), currentSortOrder));
+        }
+
+        case SortByImageSize:
+        {
+            int leftPixels  = keys.widths.at(left)  * keys.heights.at(left);
+            int rightPixels = keys.widths.at(right) * keys.heights.at(right);
+
+            return compareByOrder(leftPixels, rightPixels, currentSortOrder);
+        }
+
+        case SortByAspectRatio:
+        {
+            int leftAR  = (double(keys.widths.at(left))  / double(keys.heights.at(left)))  * 1000000;
+            int rightAR = (double(keys.widths.at(right)) / double(keys.heights.at(right))) * 1000000;
+
+            return compareByOrder(leftAR, rightAR, currentSortOrder);
+        }
+
+        case SortByManualOrderAndName:
+        case SortByManualOrderAndDate:
+        {
+            int result;
+
+            if ((result = compareByOrder(keys.manualOrders.at(left), keys.manualOrders.at(right), currentSortOrder)) != 0)
+            {
+                return result;
+            }
+
+            if (role == SortByManualOrderAndDate)
+            {
+                return compareByOrder(keys.creationDates.at(left), keys.creationDates.at(right), currentSortOrder);
+            }
+
+            return compareKeyStrings(keys.nameRanks, left, right,
+                                     keys.names.at(left), keys.names.at(right),
+                                     currentSortOrder, sortCaseSensitivity, strTypeNatural);
+        }
+
+        default:
+        {
+            // Similarity and faces are not in the keys.
+
+            return 0;
+        }
+    }
+}
+
 bool ItemSortSettings::lessThan(const QVariant& left, const QVariant& right) const
 {
 
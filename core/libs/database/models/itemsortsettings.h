@@ -28,6 +28,7 @@ namespace Digikam
 {
 
 class ItemInfo;
+class ItemSortKeyColumns;
 class FaceTagsIface;
 
 namespace DatabaseFields
@@ -113,6 +114,16 @@ public:
      */
     bool lessThan(const QVariant& left, const QVariant& right)                  const;
 
+    /**
+     * Same as the methods above, for the items at index left and right of the packed keys.
+     * The categories by faces and the sort roles not covered by ItemSortKeys are not
+     * computed, and compare as equal. The similarity is not used to break ties.
+     */
+    int  compareCategories(const ItemSortKeyColumns& keys, int left, int right) const;
+    bool lessThan(const ItemSortKeyColumns& keys, int left, int right)          const;
+    int  compare(const ItemSortKeyColumns& keys, int left, int right,
+                 SortRole sortRole)                                             const;
+
     void setSortRole(SortRole role);
     void setSortOrder(SortOrder order);
     void setStringTypeNatural(bool natural);
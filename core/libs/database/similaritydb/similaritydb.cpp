@@ -21,6 +21,7 @@
 
 #include "digikam_debug.h"
 #include "digikam_globals.h"
+#include "haarsignatureindex.h"
 
 namespace Digikam
 {
@@ -318,6 +319,8 @@ void SimilarityDb::copySimilarityAttributes(qlonglong srcId, qlonglong dstId)
                                      "SELECT ?, modificationDate, uniqueHash, matrix "
                                      " FROM ImageHaarMatrix WHERE imageid=?;"),
                    dstId, srcId);
+
+    HaarSignatureIndex::instance()->copy(srcId, dstId);
 }
 
 
@@ -328,6 +331,8 @@ void SimilarityDb::removeImageFingerprint(qlonglong imageID,
     {
         d->db->execSql(QString::fromUtf8("DELETE FROM ImageHaarMatrix WHERE imageid=?;"),
                        imageID);
+
+        HaarSignatureIndex::instance()->remove(imageID);
     }
     else if (algorithm == FuzzyAlgorithm::TfIdf)
     {
@@ -46,6 +46,7 @@
 #include "itemscanner.h"
 #include "thumbsdb.h"
 #include "thumbsdbaccess.h"
+#include "thumbnailwritequeue.h"
 #include "iojobsmanager.h"
 #include "collectionmanager.h"
 #include "collectionlocation.h"
@@ -790,6 +791,10 @@ void DIO::slotOneProccessed(const QUrl& url)
                 QString newName = data->destUrl(url).fileName();
                 QString newPath = data->destUrl(url).toLocalFile();
 
+                // Thumbnails still queued are written with the old path.
+
+                ThumbnailWriteQueue::instance()->flush();
+
                 if (data->fileConflict() == IOJobData::Overwrite)
                 {
                     ThumbsDbAccess().db()->removeByFilePath(newPath);
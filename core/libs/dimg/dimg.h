@@ -214,6 +214,20 @@ public:
     bool        load(const QString& filePath, int loadFlags, DImgLoaderObserver* const observer,
                      const DRawDecoding& rawDecodingSettings = DRawDecoding());
 
+    /**
+     * Load only the region of the image, given in full size image coordinates of the image rotated
+     * with the Exif orientation. The loader maps it back with the image size read from the file,
+     * so no additional pass is needed to get the size first.
+     * If scaledSize is not 0, the region is reduced while its largest side is not smaller than
+     * scaledSize. The loaders supporting it (JPEG, PNG, TIFF, PGF) decode only the region:
+     * loadedRegion() returns then the region loaded, in full size image coordinates, not rotated,
+     * which can be a bit larger than the region requested. Other loaders load the full image and
+     * loadedRegion() returns a null rectangle.
+     */
+    bool        loadRegion(const QString& filePath, const QRect& region, int orientation, int scaledSize,
+                           int loadFlags, DImgLoaderObserver* const observer = nullptr,
+                           const DRawDecoding& rawDecodingSettings = DRawDecoding());
+
     bool        save(const QString& filePath, FORMAT frm, DImgLoaderObserver* const observer = nullptr);
     bool        save(const QString& filePath, const QString& format, DImgLoaderObserver* const observer = nullptr);
 
@@ -292,6 +306,12 @@ public:
      */
     QSize       originalRatioSize() const;
 
+    /**
+     * Returns the region of the original file loaded by loadRegion(), in full size image coordinates,
+     * or a null rectangle if the full image was loaded.
+     */
+    QRect       loadedRegion() const;
+
     /**
      * Returns the file format in form of the FORMAT enum that was detected in the load()
      * method. Other than the format attribute which is written by the DImgLoader,
@@ -86,6 +86,32 @@ bool DImg::load(const QString& filePath,
     return load(filePath, loadFlags, observer, rawDecodingSettings);
 }
 
+bool DImg::loadRegion(const QString& filePath,
+                      const QRect& region,
+                      int orientation,
+                      int scaledSize,
+                      int loadFlags,
+                      DImgLoaderObserver* const observer,
+                      const DRawDecoding& rawDecodingSettings)
+{
+    removeAttribute(QLatin1String("loadedRegion"));
+    setAttribute(QLatin1String("regionOfInterest"),  region);
+    setAttribute(QLatin1String("regionOrientation"), orientation);
+
+    if (scaledSize > 0)
+    {
+        setAttribute(QLatin1String("scaledLoadingSize"), scaledSize);
+    }
+
+    bool ret = load(filePath, loadFlags, observer, rawDecodingSettings);
+
+    removeAttribute(QLatin1String("regionOfInterest"));
+    removeAttribute(QLatin1String("regionOrientation"));
+    removeAttribute(QLatin1String("scaledLoadingSize"));
+
+    return ret;
+}
+
 bool DImg::load(const QString& filePath,
                 int loadFlagsInt,
                 DImgLoaderObserver* const observer,
@@ -111,6 +111,11 @@ QSize DImg::originalSize() const
     return size();
 }
 
+QRect DImg::loadedRegion() const
+{
+    return attribute(QLatin1String("loadedRegion")).toRect();
+}
+
 QSize DImg::originalRatioSize() const
 {
     QSize size = originalSize();
@@ -40,6 +40,17 @@ extern "C"
 #include "dimg.h"
 #include "dimg_p.h"
 
+// SIMD includes
+
+// NOTE: x86-64 only, the 16 bits kernels use 64 bits integer intrinsics.
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#   include <immintrin.h>
+#   define DIMGSCALE_HAVE_SIMD
+#   define DIMGSCALE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#   define DIMGSCALE_TARGET_AVX2  __attribute__((target("avx2")))
+#endif
+
 typedef uint64_t ullong;    // krazy:exclude=typedefs
 typedef int64_t  llong;     // krazy:exclude=typedefs
 
@@ -292,6 +303,41 @@ void dimgScaleAARGB16(DImgScaleInfo* const isi, ullong* const dest,
                       int dow, int sow,
                       int clip_dx, int clip_dy, int clip_dw, int clip_dh);
 
+#ifdef DIMGSCALE_HAVE_SIMD
+
+enum SimdLevel
+{
+    SimdNone = 0,
+    SimdSSE41,
+    SimdAVX2
+};
+
+/**
+ * Return the best SIMD instruction set available at run-time for the scale kernels.
+ * The environment variable DIGIKAM_DIMGSCALE_SIMD can lower it, for benchmarking purpose.
+ */
+int dimgScaleSimdLevel();
+
+/**
+ * SSE4.1 implementation of dimgScaleAARGBA() and dimgScaleAARGB(), bit-exact with the scalar code.
+ * Arguments are the same than the scalar versions, 'opaque' set the Alpha byte to 0xFF as dimgScaleAARGB().
+ */
+void dimgScaleAA8SSE41(DImgScaleInfo* const isi, uint* const dest,
+                       int dxx, int dyy, int dow, int sow,
+                       int clip_dx, int clip_dy, int clip_dw, int clip_dh,
+                       bool opaque);
+
+/**
+ * AVX2 implementation of dimgScaleAARGBA16() and dimgScaleAARGB16(), bit-exact with the scalar code.
+ * Arguments are the same than the scalar versions, 'opaque' set the Alpha word to 0xFFFF as dimgScaleAARGB16().
+ */
+void dimgScaleAA16AVX2(DImgScaleInfo* const isi, ullong* const dest,
+                       int dxx, int dyy, int dow, int sow,
+                       int clip_dx, int clip_dy, int clip_dw, int clip_dh,
+                       bool opaque);
+
+#endif // DIMGSCALE_HAVE_SIMD
+
 } // namespace DImgScale
 
 using namespace DImgScale;
@@ -800,6 +846,18 @@ void DImgScale::dimgScaleAARGBA(DImgScaleInfo* const isi, uint* const dest,
 {
     Q_UNUSED(dw);
     Q_UNUSED(dh);
+
+#ifdef DIMGSCALE_HAVE_SIMD
+
+    if ((dimgScaleSimdLevel() >= SimdSSE41) && isi->ypoints && isi->xpoints)
+    {
+        dimgScaleAA8SSE41(isi, dest, dxx, dyy, dow, sow,
+                          clip_dx, clip_dy, clip_dw, clip_dh, false);
+        return;
+    }
+
+#endif
+
     uint* sptr = nullptr;
     uint* dptr = nullptr;
     int x, y;
@@ -1289,6 +1347,18 @@ void DImgScale::dimgScaleAARGB(DImgScaleInfo* const isi, uint* const dest,
 {
     Q_UNUSED(dw);
     Q_UNUSED(dh);
+
+#ifdef DIMGSCALE_HAVE_SIMD
+
+    if ((dimgScaleSimdLevel() >= SimdSSE41) && isi->ypoints && isi->xpoints)
+    {
+        dimgScaleAA8SSE41(isi, dest, dxx, dyy, dow, sow,
+                          clip_dx, clip_dy, clip_dw, clip_dh, true);
+        return;
+    }
+
+#endif
+
     uint* sptr = nullptr;
     uint* dptr = nullptr;
     int x, y;
@@ -1739,6 +1809,18 @@ void DImgScale::dimgScaleAARGB16(DImgScaleInfo* const isi, ullong* const dest,
 {
     Q_UNUSED(dw);
     Q_UNUSED(dh);
+
+#ifdef DIMGSCALE_HAVE_SIMD
+
+    if ((dimgScaleSimdLevel() >= SimdAVX2) && isi->ypoints16 && isi->xpoints)
+    {
+        dimgScaleAA16AVX2(isi, dest, dxx, dyy, dow, sow,
+                          clip_dx, clip_dy, clip_dw, clip_dh, true);
+        return;
+    }
+
+#endif
+
     ullong* sptr = nullptr;
     ullong* dptr = nullptr;
     int x, y;
@@ -2182,6 +2264,18 @@ void DImgScale::dimgScaleAARGBA16(DImgScaleInfo* const isi, ullong* const dest,
 {
     Q_UNUSED(dw);
     Q_UNUSED(dh);
+
+#ifdef DIMGSCALE_HAVE_SIMD
+
+    if ((dimgScaleSimdLevel() >= SimdAVX2) && isi->ypoints16 && isi->xpoints)
+    {
+        dimgScaleAA16AVX2(isi, dest, dxx, dyy, dow, sow,
+                          clip_dx, clip_dy, clip_dw, clip_dh, false);
+        return;
+    }
+
+#endif
+
     ullong* sptr = nullptr;
     ullong* dptr = nullptr;
     int x, y;
@@ -2652,4 +2746,507 @@ void DImgScale::dimgScaleAARGBA16(DImgScaleInfo* const isi, ullong* const dest,
     }
 }
 
+// --- SIMD implementations ----------------------------------------------------------------------
+
+#ifdef DIMGSCALE_HAVE_SIMD
+
+/**
+ * The SIMD kernels below do exactly the same fixed-point integer operations than the scalar
+ * Imlib2 loops, one color channel per vector lane, so the output is bit-exact. The 8 bits
+ * kernels use one 32 bits lane per channel (SSE4.1), the 16 bits kernels one 64 bits lane per
+ * channel (AVX2), as the 16 bits arithmetic overflows 32 bits integers.
+ */
+
+int DImgScale::dimgScaleSimdLevel()
+{
+    static const int level = []()
+    {
+        __builtin_cpu_init();
+
+        if      (__builtin_cpu_supports("avx2"))
+        {
+            return int(SimdAVX2);
+        }
+        else if (__builtin_cpu_supports("sse4.1"))
+        {
+            return int(SimdSSE41);
+        }
+
+        return int(SimdNone);
+    }();
+
+    // For benchmarking and testing purpose: 0 = scalar only, 1 = SSE4.1, 2 = AVX2.
+    // The variable is read at each call to be changed at run-time by the unit test.
+
+    if (qEnvironmentVariableIsSet("DIGIKAM_DIMGSCALE_SIMD"))
+    {
+        return qMin(level, qBound(int(SimdNone), qEnvironmentVariableIntValue("DIGIKAM_DIMGSCALE_SIMD"), int(SimdAVX2)));
+    }
+
+    return level;
+}
+
+// 8 bits helpers
+
+DIMGSCALE_TARGET_SSE41 static inline __m128i dimgLoad8(const uint* const pix)
+{
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*reinterpret_cast<const int*>(pix)));
+}
+
+DIMGSCALE_TARGET_SSE41 static inline __m128i dimgMul8(const __m128i& v, int w)
+{
+    return _mm_mullo_epi32(v, _mm_set1_epi32(w));
+}
+
+DIMGSCALE_TARGET_SSE41 static inline void dimgStore8(uint* const dptr, const __m128i& v, bool opaque)
+{
+    // Keep the low byte of each lane, as the scalar code does with an unsigned char assignment.
+
+    const __m128i mask = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    uint val           = (uint)_mm_cvtsi128_si32(_mm_shuffle_epi8(v, mask));
+
+    *dptr              = opaque ? (val | 0xFF000000) : val;
+}
+
+/**
+ * Accumulate a source span along one axis with the down-scaling weights.
+ * 'step' is 1 to walk a row and the scanline width to walk a column.
+ */
+DIMGSCALE_TARGET_SSE41 static inline __m128i dimgSpan8(const uint* pix, int step,
+                                                        int ap, int C, int shift)
+{
+    const __m128i sh = _mm_cvtsi32_si128(shift);
+    __m128i acc      = _mm_srl_epi32(dimgMul8(dimgLoad8(pix), ap), sh);
+    int j;
+
+    for (j = (1 << 14) - ap ; j > C ; j -= C)
+    {
+        pix += step;
+        acc  = _mm_add_epi32(acc, _mm_srl_epi32(dimgMul8(dimgLoad8(pix), C), sh));
+    }
+
+    if (j > 0)
+    {
+        pix += step;
+        acc  = _mm_add_epi32(acc, _mm_srl_epi32(dimgMul8(dimgLoad8(pix), j), sh));
+    }
+
+    return acc;
+}
+
+DIMGSCALE_TARGET_SSE41 void DImgScale::dimgScaleAA8SSE41(DImgScaleInfo* const isi, uint* const dest,
+                                                           int dxx, int dyy, int dow, int sow,
+                                                           int clip_dx, int clip_dy,
+                                                           int clip_dw, int clip_dh,
+                                                           bool opaque)
+{
+    uint* sptr = nullptr;
+    uint* dptr = nullptr;
+    uint* pix  = nullptr;
+    int x, y;
+    uint** ypoints    = isi->ypoints;
+    int* xpoints      = isi->xpoints;
+    int* xapoints     = isi->xapoints;
+    int* yapoints     = isi->yapoints;
+
+    const int x_begin = dxx + clip_dx;
+    const int x_end   = x_begin + clip_dw;
+    const int y_begin = clip_dy;
+    const int y_end   = clip_dy + clip_dh;
+
+    // scaling up both ways
+
+    if (isi->xup_yup == 3)
+    {
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            dptr = dest + (y - y_begin) * dow;
+            sptr = ypoints[dyy + y];
+
+            if (YAP > 0)
+            {
+                for (x = x_begin ; x < x_end ; ++x)
+                {
+                    pix = sptr + xpoints[x];
+
+                    if (XAP > 0)
+                    {
+                        __m128i v  = _mm_add_epi32(dimgMul8(dimgLoad8(pix),           INV_XAP),
+                                                   dimgMul8(dimgLoad8(pix + 1),       XAP));
+                        __m128i vv = _mm_add_epi32(dimgMul8(dimgLoad8(pix + sow + 1), XAP),
+                                                   dimgMul8(dimgLoad8(pix + sow),     INV_XAP));
+                        v          = _mm_srli_epi32(_mm_add_epi32(dimgMul8(vv, YAP),
+                                                                  dimgMul8(v,  INV_YAP)), 16);
+                        dimgStore8(dptr, v, opaque);
+                    }
+                    else
+                    {
+                        __m128i v  = _mm_add_epi32(dimgMul8(dimgLoad8(pix),       INV_YAP),
+                                                   dimgMul8(dimgLoad8(pix + sow), YAP));
+                        dimgStore8(dptr, _mm_srli_epi32(v, 8), opaque);
+                    }
+
+                    ++dptr;
+                }
+            }
+            else
+            {
+                for (x = x_begin ; x < x_end ; ++x)
+                {
+                    if (XAP > 0)
+                    {
+                        pix       = sptr + xpoints[x];
+                        __m128i v = _mm_add_epi32(dimgMul8(dimgLoad8(pix),     INV_XAP),
+                                                  dimgMul8(dimgLoad8(pix + 1), XAP));
+                        dimgStore8(dptr, _mm_srli_epi32(v, 8), opaque);
+                        ++dptr;
+                    }
+                    else
+                    {
+                        *dptr++ = sptr[xpoints[x]];
+                    }
+                }
+            }
+        }
+    }
+
+    // if we're scaling down vertically
+
+    else if (isi->xup_yup == 1)
+    {
+        int Cy, yap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            Cy   = YAP >> 16;
+            yap  = YAP & 0xffff;
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                pix       = ypoints[dyy + y] + xpoints[x];
+                __m128i v = dimgSpan8(pix, sow, yap, Cy, 10);
+
+                if (XAP > 0)
+                {
+                    __m128i vv = dimgSpan8(pix + 1, sow, yap, Cy, 10);
+                    v          = _mm_srli_epi32(_mm_add_epi32(dimgMul8(v,  INV_XAP),
+                                                              dimgMul8(vv, XAP)), 12);
+                }
+                else
+                {
+                    v = _mm_srli_epi32(v, 4);
+                }
+
+                dimgStore8(dptr, v, opaque);
+                ++dptr;
+            }
+        }
+    }
+
+    // if we're scaling down horizontally
+
+    else if (isi->xup_yup == 2)
+    {
+        int Cx, xap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                Cx        = XAP >> 16;
+                xap       = XAP & 0xffff;
+                pix       = ypoints[dyy + y] + xpoints[x];
+                __m128i v = dimgSpan8(pix, 1, xap, Cx, 10);
+
+                if (YAP > 0)
+                {
+                    __m128i vv = dimgSpan8(pix + sow, 1, xap, Cx, 10);
+                    v          = _mm_srli_epi32(_mm_add_epi32(dimgMul8(v,  INV_YAP),
+                                                              dimgMul8(vv, YAP)), 12);
+                }
+                else
+                {
+                    v = _mm_srli_epi32(v, 4);
+                }
+
+                dimgStore8(dptr, v, opaque);
+                ++dptr;
+            }
+        }
+    }
+
+    // if we're scaling down horizontally & vertically
+
+    else
+    {
+        int Cx, Cy, j, xap, yap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            Cy   = YAP >> 16;
+            yap  = YAP & 0xffff;
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                Cx        = XAP >> 16;
+                xap       = XAP & 0xffff;
+                sptr      = ypoints[dyy + y] + xpoints[x];
+                __m128i v = _mm_srli_epi32(dimgMul8(dimgSpan8(sptr, 1, xap, Cx, 9), yap), 14);
+
+                for (j = (1 << 14) - yap ; j > Cy ; j -= Cy)
+                {
+                    sptr += sow;
+                    v     = _mm_add_epi32(v, _mm_srli_epi32(dimgMul8(dimgSpan8(sptr, 1, xap, Cx, 9), Cy), 14));
+                }
+
+                if (j > 0)
+                {
+                    sptr += sow;
+                    v     = _mm_add_epi32(v, _mm_srli_epi32(dimgMul8(dimgSpan8(sptr, 1, xap, Cx, 9), j), 14));
+                }
+
+                dimgStore8(dptr, _mm_srli_epi32(v, 5), opaque);
+                ++dptr;
+            }
+        }
+    }
+}
+
+// 16 bits helpers
+
+DIMGSCALE_TARGET_AVX2 static inline __m256i dimgLoad16(const ullong* const pix)
+{
+    return _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pix)));
+}
+
+DIMGSCALE_TARGET_AVX2 static inline __m256i dimgMul16(const __m256i& v, llong w)
+{
+    // All operands are positive and lower than 2^32: an unsigned 32x32 -> 64 bits product is exact.
+
+    return _mm256_mul_epu32(v, _mm256_set1_epi64x(w));
+}
+
+DIMGSCALE_TARGET_AVX2 static inline void dimgStore16(ullong* const dptr, const __m256i& v, bool opaque)
+{
+    // Keep the low 16 bits of each lane, as the scalar code does with an unsigned short assignment.
+
+    const __m256i idx  = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+    const __m128i mask = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m128i low        = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, idx));
+    ullong val         = 0;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&val), _mm_shuffle_epi8(low, mask));
+
+    *dptr              = opaque ? (val | 0xFFFF000000000000ULL) : val;
+}
+
+DIMGSCALE_TARGET_AVX2 static inline __m256i dimgSpan16(const ullong* pix, int step,
+                                                        int ap, int C, int shift)
+{
+    const __m128i sh = _mm_cvtsi32_si128(shift);
+    __m256i acc      = _mm256_srl_epi64(dimgMul16(dimgLoad16(pix), ap), sh);
+    int j;
+
+    for (j = (1 << 14) - ap ; j > C ; j -= C)
+    {
+        pix += step;
+        acc  = _mm256_add_epi64(acc, _mm256_srl_epi64(dimgMul16(dimgLoad16(pix), C), sh));
+    }
+
+    if (j > 0)
+    {
+        pix += step;
+        acc  = _mm256_add_epi64(acc, _mm256_srl_epi64(dimgMul16(dimgLoad16(pix), j), sh));
+    }
+
+    return acc;
+}
+
+DIMGSCALE_TARGET_AVX2 void DImgScale::dimgScaleAA16AVX2(DImgScaleInfo* const isi, ullong* const dest,
+                                                          int dxx, int dyy, int dow, int sow,
+                                                          int clip_dx, int clip_dy,
+                                                          int clip_dw, int clip_dh,
+                                                          bool opaque)
+{
+    ullong* sptr = nullptr;
+    ullong* dptr = nullptr;
+    ullong* pix  = nullptr;
+    int x, y;
+    ullong** ypoints  = isi->ypoints16;
+    int* xpoints      = isi->xpoints;
+    int* xapoints     = isi->xapoints;
+    int* yapoints     = isi->yapoints;
+
+    const int x_begin = dxx + clip_dx;
+    const int x_end   = x_begin + clip_dw;
+    const int y_begin = clip_dy;
+    const int y_end   = clip_dy + clip_dh;
+
+    // scaling up both ways
+
+    if (isi->xup_yup == 3)
+    {
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            dptr = dest + (y - y_begin) * dow;
+            sptr = ypoints[dyy + y];
+
+            if (YAP > 0)
+            {
+                for (x = x_begin ; x < x_end ; ++x)
+                {
+                    pix = sptr + xpoints[x];
+
+                    if (XAP > 0)
+                    {
+                        __m256i v  = _mm256_add_epi64(dimgMul16(dimgLoad16(pix),           INV_XAP),
+                                                      dimgMul16(dimgLoad16(pix + 1),       XAP));
+                        __m256i vv = _mm256_add_epi64(dimgMul16(dimgLoad16(pix + sow + 1), XAP),
+                                                      dimgMul16(dimgLoad16(pix + sow),     INV_XAP));
+                        v          = _mm256_srli_epi64(_mm256_add_epi64(dimgMul16(vv, YAP),
+                                                                        dimgMul16(v,  INV_YAP)), 16);
+                        dimgStore16(dptr, v, opaque);
+                    }
+                    else
+                    {
+                        __m256i v  = _mm256_add_epi64(dimgMul16(dimgLoad16(pix),       INV_YAP),
+                                                      dimgMul16(dimgLoad16(pix + sow), YAP));
+                        dimgStore16(dptr, _mm256_srli_epi64(v, 8), opaque);
+                    }
+
+                    ++dptr;
+                }
+            }
+            else
+            {
+                for (x = x_begin ; x < x_end ; ++x)
+                {
+                    if (XAP > 0)
+                    {
+                        pix       = sptr + xpoints[x];
+                        __m256i v = _mm256_add_epi64(dimgMul16(dimgLoad16(pix),     INV_XAP),
+                                                     dimgMul16(dimgLoad16(pix + 1), XAP));
+                        dimgStore16(dptr, _mm256_srli_epi64(v, 8), opaque);
+                        ++dptr;
+                    }
+                    else
+                    {
+                        *dptr++ = sptr[xpoints[x]];
+                    }
+                }
+            }
+        }
+    }
+
+    // if we're scaling down vertically
+
+    else if (isi->xup_yup == 1)
+    {
+        int Cy, yap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            Cy   = YAP >> 16;
+            yap  = YAP & 0xffff;
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                pix       = ypoints[dyy + y] + xpoints[x];
+                __m256i v = dimgSpan16(pix, sow, yap, Cy, 10);
+
+                if (XAP > 0)
+                {
+                    __m256i vv = dimgSpan16(pix + 1, sow, yap, Cy, 10);
+                    v          = _mm256_srli_epi64(_mm256_add_epi64(dimgMul16(v,  INV_XAP),
+                                                                    dimgMul16(vv, XAP)), 12);
+                }
+                else
+                {
+                    v = _mm256_srli_epi64(v, 4);
+                }
+
+                dimgStore16(dptr, v, opaque);
+                ++dptr;
+            }
+        }
+    }
+
+    // if we're scaling down horizontally
+
+    else if (isi->xup_yup == 2)
+    {
+        int Cx, xap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                Cx        = XAP >> 16;
+                xap       = XAP & 0xffff;
+                pix       = ypoints[dyy + y] + xpoints[x];
+                __m256i v = dimgSpan16(pix, 1, xap, Cx, 10);
+
+                if (YAP > 0)
+                {
+                    __m256i vv = dimgSpan16(pix + sow, 1, xap, Cx, 10);
+                    v          = _mm256_srli_epi64(_mm256_add_epi64(dimgMul16(v,  INV_YAP),
+                                                                    dimgMul16(vv, YAP)), 12);
+                }
+                else
+                {
+                    v = _mm256_srli_epi64(v, 4);
+                }
+
+                dimgStore16(dptr, v, opaque);
+                ++dptr;
+            }
+        }
+    }
+
+    // if we're scaling down horizontally & vertically
+
+    else
+    {
+        int Cx, Cy, j, xap, yap;
+
+        for (y = y_begin ; y < y_end ; ++y)
+        {
+            Cy   = YAP >> 16;
+            yap  = YAP & 0xffff;
+            dptr = dest + (y - y_begin) * dow;
+
+            for (x = x_begin ; x < x_end ; ++x)
+            {
+                Cx        = XAP >> 16;
+                xap       = XAP & 0xffff;
+                sptr      = ypoints[dyy + y] + xpoints[x];
+                __m256i v = _mm256_srli_epi64(dimgMul16(dimgSpan16(sptr, 1, xap, Cx, 9), yap), 14);
+
+                for (j = (1 << 14) - yap ; j > Cy ; j -= Cy)
+                {
+                    sptr += sow;
+                    v     = _mm256_add_epi64(v, _mm256_srli_epi64(dimgMul16(dimgSpan16(sptr, 1, xap, Cx, 9), Cy), 14));
+                }
+
+                if (j > 0)
+                {
+                    sptr += sow;
+                    v     = _mm256_add_epi64(v, _mm256_srli_epi64(dimgMul16(dimgSpan16(sptr, 1, xap, Cx, 9), j), 14));
+                }
+
+                dimgStore16(dptr, _mm256_srli_epi64(v, 5), opaque);
+                ++dptr;
+            }
+        }
+    }
+}
+
+#endif // DIMGSCALE_HAVE_SIMD
+
 } // namespace Digikam
@@ -20,10 +20,15 @@
 #include <QObject>
 #include <QDateTime>
 #include <QThreadPool>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
 #include "digikam_debug.h"
+#include "dimgtilescheduler.h"
 
 namespace Digikam
 {
@@ -287,6 +292,101 @@ QList<int> DImgThreadedFilter::multithreadedSteps(int stop, int start) const
     return vals;
 }
 
+bool DImgThreadedFilter::processTiles(const QSize& size,
+                                      int bytesPerPixel,
+                                      int halo,
+                                      const TileFunction& func,
+                                      int progressBegin,
+                                      int progressEnd,
+                                      const QSize& tileSize)
+{
+    if (size.isEmpty())
+    {
+        return runningFlag();
+    }
+
+    const int threads = qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+    const QSize tile  = tileSize.isEmpty() ? DImgTileScheduler::tileSize(size, bytesPerPixel, halo, threads)
+                                           : tileSize.boundedTo(size);
+    const int columns = (size.width()  + tile.width()  - 1) / tile.width();
+    const int rows    = (size.height() + tile.height() - 1) / tile.height();
+    const int count   = columns * rows;
+    const QRect bounds(QPoint(0, 0), size);
+
+    DImgTileScheduler scheduler(count, threads);
+    QAtomicInt        done;
+    QMutex            progressLock;
+    int               lastProgress = progressBegin;
+
+    auto worker = [&](int id)
+    {
+        int index = 0;
+
+        while (runningFlag() && scheduler.takeTile(id, index))
+        {
+            Tile t;
+            t.index    = index;
+            t.area     = QRect((index % columns) * tile.width(),
+                               (index / columns) * tile.height(),
+                               tile.width(), tile.height()) & bounds;
+            t.haloArea = t.area.adjusted(-halo, -halo, halo, halo) & bounds;
+
+            func(t);
+
+            const int finished = done.fetchAndAddOrdered(1) + 1;
+
+            if (progressEnd > progressBegin)
+            {
+                const int progr = progressBegin + (int)((qint64)finished * (progressEnd - progressBegin) / count);
+
+                QMutexLocker lock(&progressLock);
+
+                if (progr > lastProgress)
+                {
+                    lastProgress = progr;
+                    postProgress(progr);
+                }
+            }
+        }
+    };
+
+    QList<QFuture<void> > tasks;
+
+    for (int i = 1 ; i < scheduler.workersCount() ; ++i)
+    {
+        tasks.append(QtConcurrent::run([&worker, i]()
+            {
+                worker(i);
+            }
+        ));
+    }
+
+    // The calling thread is a worker too: no dead-lock if the pool is busy.
+
+    worker(0);
+
+    for (QFuture<void>& t : tasks)
+    {
+        t.waitForFinished();
+    }
+
+    return (runningFlag() && (done.loadRelaxed() == count));
+}
+
+bool DImgThreadedFilter::processRanges(int count,
+                                       int bytesPerItem,
+                                       const RangeFunction& func,
+                                       int progressBegin,
+                                       int progressEnd)
+{
+    return processTiles(QSize(count, 1), bytesPerItem, 0,
+                        [&func](const Tile& tile)
+                        {
+                            func(tile.area.left(), tile.area.right() + 1);
+                        },
+                        progressBegin, progressEnd);
+}
+
 } // namespace Digikam
 
 #include "moc_dimgthreadedfilter.cpp"
@@ -15,6 +15,14 @@
 
 #pragma once
 
+// C++ includes
+
+#include <functional>
+
+// Qt includes
+
+#include <QRect>
+
 // Local includes
 
 #include "digikam_export.h"
@@ -31,6 +39,27 @@ class DIGIKAM_EXPORT DImgThreadedFilter : public DynamicThread
 {
     Q_OBJECT
 
+public:
+
+    /**
+     * A tile of the area processed by processTiles(). The tile function writes the
+     * pixels of area, and can read the pixels of haloArea: area grown by the halo
+     * and clipped to the processed area.
+     */
+    class DIGIKAM_EXPORT Tile
+    {
+    public:
+
+        Tile() = default;
+
+        QRect area;
+        QRect haloArea;
+        int   index = 0;
+    };
+
+    typedef std::function<void(const Tile&)>         TileFunction;
+    typedef std::function<void(int start, int stop)> RangeFunction;
+
 public:
 
     /**
@@ -88,7 +117,7 @@ public:
      * Between range [start,stop], this method will divide by equal steps depending of number of CPU cores available.
      * To be sure that all values will be processed, in case of CPU core division give rest, the last step compensate
      * the difference.
-     * See Blur filter loop implementation for example to see how to use this method with QtConcurrents API.
+     * Prefer processTiles() or processRanges(), which balance the load between the cores.
      */
     QList<int> multithreadedSteps(int stop, int start = 0)                      const;
 
@@ -193,6 +222,34 @@ protected:
      */
     void postProgress(int progress);
 
+    /**
+     * Split an area of size pixels in tiles fitting in the cache of a core, with a margin of
+     * halo pixels readable around each tile, and call func for each tile, in parallel on all
+     * threads of the global thread pool including the calling one. Idle threads steal tiles
+     * from busy ones. Remaining tiles are skipped as soon as runningFlag() is false.
+     * The progress is posted from progressBegin to progressEnd, not at all if both are equal.
+     * The tileSize can be forced, for ex. to full rows.
+     * Returns false if the computation was canceled.
+     * See Blur filter implementation for an example.
+     */
+    bool processTiles(const QSize& size,
+                      int bytesPerPixel,
+                      int halo,
+                      const TileFunction& func,
+                      int progressBegin = 0,
+                      int progressEnd = 100,
+                      const QSize& tileSize = QSize());
+
+    /**
+     * Same as processTiles() for a one dimension range of count items: func is called with
+     * the range [start, stop[ of items to process.
+     */
+    bool processRanges(int count,
+                       int bytesPerItem,
+                       const RangeFunction& func,
+                       int progressBegin = 0,
+                       int progressEnd = 100);
+
 protected:
 
     /**
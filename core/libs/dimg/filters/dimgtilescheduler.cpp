@@ -0,0 +1,159 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : work-stealing scheduler for tiled image filters
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "dimgtilescheduler.h"
+
+// C++ includes
+
+#include <cmath>
+
+// Qt includes
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+namespace Digikam
+{
+
+/**
+ * The working set of a tile, halo included: the size of the L2 cache of most cores.
+ */
+static const int s_tileCacheSize = 256 * 1024;
+
+class Q_DECL_HIDDEN DImgTileScheduler::Private
+{
+public:
+
+    class Queue
+    {
+    public:
+
+        QMutex mutex;
+        int    begin = 0;
+        int    end   = 0;
+    };
+
+public:
+
+    Private() = default;
+
+    QVector<Queue*> queues;
+};
+
+DImgTileScheduler::DImgTileScheduler(int tilesCount, int workersCount)
+    : d(new Private)
+{
+    const int workers = qBound(1, workersCount, qMax(1, tilesCount));
+
+    for (int i = 0 ; i < workers ; ++i)
+    {
+        Private::Queue* const queue = new Private::Queue;
+        queue->begin                = (int)((qint64)tilesCount * i       / workers);
+        queue->end                  = (int)((qint64)tilesCount * (i + 1) / workers);
+        d->queues << queue;
+    }
+}
+
+DImgTileScheduler::~DImgTileScheduler()
+{
+    qDeleteAll(d->queues);
+    delete d;
+}
+
+int DImgTileScheduler::workersCount() const
+{
+    return d->queues.size();
+}
+
+bool DImgTileScheduler::takeTile(int worker, int& tile)
+{
+    Private::Queue* const own = d->queues.at(worker);
+
+    {
+        QMutexLocker lock(&own->mutex);
+
+        if (own->begin < own->end)
+        {
+            tile = own->begin++;
+
+            return true;
+        }
+    }
+
+    // Own range is empty: steal from the other workers, nearest first.
+    // Only one lock is held at a time.
+
+    for (int i = 1 ; i < d->queues.size() ; ++i)
+    {
+        Private::Queue* const victim = d->queues.at((worker + i) % d->queues.size());
+        int begin                    = 0;
+        int end                      = 0;
+
+        {
+            QMutexLocker lock(&victim->mutex);
+
+            const int remaining = victim->end - victim->begin;
+
+            if (remaining <= 0)
+            {
+                continue;
+            }
+
+            begin       = victim->begin + remaining / 2;
+            end         = victim->end;
+            victim->end = begin;
+        }
+
+        tile = begin;
+
+        QMutexLocker lock(&own->mutex);
+        own->begin = begin + 1;
+        own->end   = end;
+
+        return true;
+    }
+
+    return false;
+}
+
+QSize DImgTileScheduler::tileSize(const QSize& size, int bytesPerPixel, int halo, int workersCount)
+{
+    const qint64 budget = qMax((qint64)1, (qint64)s_tileCacheSize / qMax(1, bytesPerPixel));
+    const int    tiles  = 4 * qMax(1, workersCount);
+
+    if (size.height() <= 1)
+    {
+        const qint64 balanced = qMax((qint64)1, (qint64)size.width() / tiles);
+
+        return QSize((int)qMax((qint64)1, qMin(qMin(budget, balanced), (qint64)size.width())), 1);
+    }
+
+    // A tile is at least as wide as its halo, else most of the work is done in the halo.
+
+    const int edge = (int)std::sqrt((double)budget);
+    int width      = qMin(size.width(), qMax(qMax(edge - 2 * halo, 2 * halo), 16));
+    int height     = qBound(1, (int)(budget / (width + 2 * halo)) - 2 * halo, size.height());
+    height         = qMax(height, qMin(16, size.height()));
+
+    while ((height > 8) &&
+           ((((size.width() + width - 1) / width) * ((size.height() + height - 1) / height)) < tiles))
+    {
+        height /= 2;
+    }
+
+    return QSize(width, height);
+}
+
+} // namespace Digikam
@@ -0,0 +1,67 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : work-stealing scheduler for tiled image filters
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QSize>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * Distribute tiles, numbered from 0 to tilesCount - 1, between workers.
+ * Each worker starts with a contiguous range of tiles, which keeps neighbor tiles
+ * on the same core. When its range is empty, a worker steals the second half of
+ * the remaining range of another worker. All methods are thread-safe.
+ */
+class DIGIKAM_EXPORT DImgTileScheduler
+{
+public:
+
+    DImgTileScheduler(int tilesCount, int workersCount);
+    ~DImgTileScheduler();
+
+    int  workersCount()                                     const;
+
+    /**
+     * Return in tile the next tile to process by the worker, or false if all tiles are taken.
+     */
+    bool takeTile(int worker, int& tile);
+
+    /**
+     * Return the size of the tiles used to split an area of size pixels, so that a tile
+     * and its halo fit in the cache of a core, with enough tiles to balance the load
+     * between the workers. An area with a height of 1 is split as a range of items.
+     */
+    static QSize tileSize(const QSize& size, int bytesPerPixel, int halo, int workersCount);
+
+private:
+
+    // Disable
+    DImgTileScheduler(const DImgTileScheduler&)            = delete;
+    DImgTileScheduler& operator=(const DImgTileScheduler&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+};
+
+} // namespace Digikam
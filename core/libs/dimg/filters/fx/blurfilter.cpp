@@ -18,9 +18,8 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QtMath>
-#include <QMutex>
+#include <QScopedArrayPointer>
 
 // Local includes
 
@@ -36,10 +35,7 @@ public:
 
     Private() = default;
 
-    int    radius         = 3;
-    int    globalProgress = 0;
-
-    QMutex lock;
+    int radius = 3;
 };
 
 BlurFilter::BlurFilter(QObject* const parent)
@@ -87,26 +83,28 @@ QString BlurFilter::DisplayableName()
     return QString::fromUtf8(I18N_NOOP("Blur Filter"));
 }
 
-void BlurFilter::blurMultithreaded(uint start, uint stop)
+void BlurFilter::blurTile(const Tile& tile)
 {
     bool sixteenBit  = m_orgImage.sixteenBit();
-    int  height      = m_orgImage.height();
-    int  width       = m_orgImage.width();
     int  radius      = d->radius;
-    int  oldProgress = 0;
-    int  progress    = 0;
+    int  left        = tile.haloArea.left();
+    int  right       = tile.haloArea.right() + 1;
+    int  width       = right - left;
     uint a, r, g, b;
     int  mx;
     int  my;
     int  mw;
     int  mh;
     int  mt;
-    int* as = new int[width];
-    int* rs = new int[width];
-    int* gs = new int[width];
-    int* bs = new int[width];
 
-    for (uint y = start ; runningFlag() && (y < stop) ; ++y)
+    // The column sums only cover the tile and its halo: they stay in the cache.
+
+    QScopedArrayPointer<int> as(new int[width]);
+    QScopedArrayPointer<int> rs(new int[width]);
+    QScopedArrayPointer<int> gs(new int[width]);
+    QScopedArrayPointer<int> bs(new int[width]);
+
+    for (int y = tile.area.top() ; runningFlag() && (y <= tile.area.bottom()) ; ++y)
     {
         my = y - radius;
         mh = (radius << 1) + 1;
@@ -118,23 +116,23 @@ void BlurFilter::blurMultithreaded(uint start, uint stop)
             my  = 0;
         }
 
-        if ((my + mh) > height)
+        if ((my + mh) > (int)m_orgImage.height())
         {
-            mh = height - my;
+            mh = m_orgImage.height() - my;
         }
 
-        uchar* pDst8           = m_destImage.scanLine(y);
-        unsigned short* pDst16 = reinterpret_cast<unsigned short*>(m_destImage.scanLine(y));
+        uchar* pDst8           = m_destImage.scanLine(y)  + tile.area.left() * 4;
+        unsigned short* pDst16 = reinterpret_cast<unsigned short*>(m_destImage.scanLine(y)) + tile.area.left() * 4;
 
-        memset(as, 0, width * sizeof(int));
-        memset(rs, 0, width * sizeof(int));
-        memset(gs, 0, width * sizeof(int));
-        memset(bs, 0, width * sizeof(int));
+        memset(as.data(), 0, width * sizeof(int));
+        memset(rs.data(), 0, width * sizeof(int));
+        memset(gs.data(), 0, width * sizeof(int));
+        memset(bs.data(), 0, width * sizeof(int));
 
         for (int yy = 0 ; yy < mh ; ++yy)
         {
-            uchar* pSrc8           = m_orgImage.scanLine(yy + my);
-            unsigned short* pSrc16 = reinterpret_cast<unsigned short*>(m_orgImage.scanLine(yy + my));
+            uchar* pSrc8           = m_orgImage.scanLine(yy + my) + left * 4;
+            unsigned short* pSrc16 = reinterpret_cast<unsigned short*>(m_orgImage.scanLine(yy + my)) + left * 4;
 
             for (int x = 0 ; x < width ; ++x)
             {
@@ -157,85 +155,62 @@ void BlurFilter::blurMultithreaded(uint start, uint stop)
             }
         }
 
-        if (width > ((radius << 1) + 1))
+        for (int x = tile.area.left() ; x <= tile.area.right() ; ++x)
         {
-            for (int x = 0 ; x < width ; ++x)
+            a  = 0;
+            r  = 0;
+            g  = 0;
+            b  = 0;
+            mx = x - radius;
+            mw = (radius << 1) + 1;
+
+            if (mx < left)
             {
-                a  = 0;
-                r  = 0;
-                g  = 0;
-                b  = 0;
-                mx = x - radius;
-                mw = (radius << 1) + 1;
-
-                if (mx < 0)
-                {
-                    mw += mx;
-                    mx  = 0;
-                }
-
-                if ((mx + mw) > width)
-                {
-                    mw = width - mx;
-                }
-
-                mt = mw * mh;
+                mw -= left - mx;
+                mx  = left;
+            }
 
-                for (int xx = mx ; xx < (mw + mx) ; ++xx)
-                {
-                    a += as[xx];
-                    r += rs[xx];
-                    g += gs[xx];
-                    b += bs[xx];
-                }
+            if ((mx + mw) > right)
+            {
+                mw = right - mx;
+            }
 
-                if (mt != 0)
-                {
-                    a = a / mt;
-                    r = r / mt;
-                    g = g / mt;
-                    b = b / mt;
-                }
+            mt = mw * mh;
 
-                if (sixteenBit)
-                {
-                    pDst16[0] = b;
-                    pDst16[1] = g;
-                    pDst16[2] = r;
-                    pDst16[3] = a;
-                    pDst16   += 4;
-                }
-                else
-                {
-                    pDst8[0] = b;
-                    pDst8[1] = g;
-                    pDst8[2] = r;
-                    pDst8[3] = a;
-                    pDst8   += 4;
-                }
+            for (int xx = mx - left ; xx < (mw + mx - left) ; ++xx)
+            {
+                a += as[xx];
+                r += rs[xx];
+                g += gs[xx];
+                b += bs[xx];
             }
-        }
-        else
-        {
-            qCDebug(DIGIKAM_DIMG_LOG) << "Radius too small...";
-        }
 
-        progress = (int)(((double)y * (100.0 / QThreadPool::globalInstance()->maxThreadCount())) / (stop-start));
+            if (mt != 0)
+            {
+                a = a / mt;
+                r = r / mt;
+                g = g / mt;
+                b = b / mt;
+            }
 
-        if (((progress % 5) == 0) && (progress > oldProgress))
-        {
-            d->lock.lock();
-            oldProgress        = progress;
-            d->globalProgress += 5;
-            postProgress(d->globalProgress);
-            d->lock.unlock();
+            if (sixteenBit)
+            {
+                pDst16[0] = b;
+                pDst16[1] = g;
+                pDst16[2] = r;
+                pDst16[3] = a;
+                pDst16   += 4;
+            }
+            else
+            {
+                pDst8[0] = b;
+                pDst8[1] = g;
+                pDst8[2] = r;
+                pDst8[3] = a;
+                pDst8   += 4;
+            }
         }
     }
-
-    delete [] as;
-    delete [] rs;
-    delete [] gs;
-    delete [] bs;
 }
 
 void BlurFilter::filterImage()
@@ -248,33 +223,19 @@ void BlurFilter::filterImage()
         return;
     }
 
-    QList<int> vals = multithreadedSteps(m_orgImage.height());
-    QList <QFuture<void> > tasks;
-
-    for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
+    if ((int)m_orgImage.width() <= ((d->radius << 1) + 1))
     {
-        tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                       &BlurFilter::blurMultithreaded, this,
-
-#else
+        qCDebug(DIGIKAM_DIMG_LOG) << "Radius too small...";
 
-                                       this, &BlurFilter::blurMultithreaded,
-
-#endif
-
-                                       vals[j],
-                                       vals[j+1]
-                                      )
-        );
+        return;
     }
 
-    for (QFuture<void> t : std::as_const(tasks))
-    {
-        t.waitForFinished();
-    }
+    processTiles(m_orgImage.size(), m_orgImage.bytesDepth(), d->radius,
+                 [this](const Tile& tile)
+                 {
+                     blurTile(tile);
+                 }
+    );
 }
 
 FilterAction BlurFilter::filterAction()
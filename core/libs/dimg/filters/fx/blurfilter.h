@@ -77,7 +77,7 @@ public:
 private:
 
     void filterImage()                                                        override;
-    void blurMultithreaded(uint start, uint stop);
+    void blurTile(const Tile& tile);
 
 private:
 
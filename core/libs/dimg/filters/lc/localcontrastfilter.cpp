@@ -21,7 +21,6 @@
 // Qt includes
 
 #include <QtMath>
-#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
@@ -319,8 +318,7 @@ void LocalContrastFilter::processRgbImage(float* const img, int sizex, int sizey
 
     postProgress(40);
 
-    QList<int> vals = multithreadedSteps(size);
-    int         pos  = 0;
+    int pos = 0;
 
     for (int nstage = 0 ; runningFlag() && (nstage < TONEMAPPING_MAX_STAGES) ; ++nstage)
     {
@@ -342,34 +340,15 @@ void LocalContrastFilter::processRgbImage(float* const img, int sizex, int sizey
 
             inplaceBlur(blurimage.data(), sizex, sizey, d->par.getBlur(nstage));
 
-            QList <QFuture<void> > tasks;
-
-            for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-            {
-                tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                               &LocalContrastFilter::blurMultithreaded, this,
-
-#else
-
-                                               this, &LocalContrastFilter::blurMultithreaded,
+            float* const blurdata = blurimage.data();
 
-#endif
-
-                                               vals[j],
-                                               vals[j+1],
-                                               img,
-                                               blurimage.data()
-                                              )
-                );
-            }
-
-            for (QFuture<void> t : std::as_const(tasks))
-            {
-                t.waitForFinished();
-            }
+            processRanges(size, 4 * sizeof(float),
+                          [this, img, blurdata](int start, int stop)
+                          {
+                              blurMultithreaded(start, stop, img, blurdata);
+                          },
+                          0, 0
+            );
         }
 
         postProgress(50 + nstage * 5);
@@ -380,34 +359,15 @@ void LocalContrastFilter::processRgbImage(float* const img, int sizex, int sizey
         qCDebug(DIGIKAM_DIMG_LOG) << "highSaturation : " << d->par.highSaturation;
         qCDebug(DIGIKAM_DIMG_LOG) << "lowSaturation : "  << d->par.lowSaturation;
 
-        QList <QFuture<void> > tasks;
+        float* const srcdata = srcimg.data();
 
-        for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-        {
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &LocalContrastFilter::saturationMultithreaded, this,
-
-#else
-
-                                           this, &LocalContrastFilter::saturationMultithreaded,
-
-#endif
-
-                                           vals[j],
-                                           vals[j+1],
-                                           img,
-                                           srcimg.data()
-                                          )
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
+        processRanges(size, 6 * sizeof(float),
+                      [this, img, srcdata](int start, int stop)
+                      {
+                          saturationMultithreaded(start, stop, img, srcdata);
+                      },
+                      0, 0
+        );
     }
 
     postProgress(70);
@@ -487,68 +447,32 @@ void LocalContrastFilter::inplaceBlur(float* const data, int sizex, int sizey, f
     prm.blur            = blur;
     prm.denormal_remove = (float)(1e-15);
 
-    QList<int> valsx = multithreadedSteps(prm.sizex);
-    QList<int> valsy = multithreadedSteps(prm.sizey);
+    // The rows are processed by ranges of consecutive rows, the columns by ranges
+    // of adjacent columns, which share the cache lines loaded from memory.
 
     for (uint stage = 0 ; runningFlag() && (stage < 2) ; ++stage)
     {
-        QList <QFuture<void> > tasks;
-
-        for (int j = 0 ; runningFlag() && (j < valsy.count()-1) ; ++j)
-        {
-            prm.start = valsy[j];
-            prm.stop  = valsy[j+1];
-
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &LocalContrastFilter::inplaceBlurYMultithreaded, this,
-
-#else
-
-                                           this, &LocalContrastFilter::inplaceBlurYMultithreaded,
-
-#endif
-
-                                           prm
-                                          )
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
-
-        tasks.clear();
-
-        for (int j = 0 ; runningFlag() && (j < valsx.count()-1) ; ++j)
-        {
-            prm.start = valsx[j];
-            prm.stop  = valsx[j+1];
-
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &LocalContrastFilter::inplaceBlurXMultithreaded, this,
-
-#else
-
-                                           this, &LocalContrastFilter::inplaceBlurXMultithreaded,
-
-#endif
-
-                                           prm
-                                          )
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
+        processRanges(prm.sizey, prm.sizex * sizeof(float),
+                      [this, &prm](int start, int stop)
+                      {
+                          Args range  = prm;
+                          range.start = start;
+                          range.stop  = stop;
+                          inplaceBlurYMultithreaded(range);
+                      },
+                      0, 0
+        );
+
+        processRanges(prm.sizex, sizeof(float),
+                      [this, &prm](int start, int stop)
+                      {
+                          Args range  = prm;
+                          range.start = start;
+                          range.stop  = stop;
+                          inplaceBlurXMultithreaded(range);
+                      },
+                      0, 0
+        );
     }
 }
 
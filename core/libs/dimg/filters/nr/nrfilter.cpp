@@ -23,7 +23,8 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
+#include <QMutex>
+#include <QMutexLocker>
 
 // Local includes
 
@@ -349,8 +350,7 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
 
     QScopedArrayPointer<float> temp(new float[qMax(width, height)]);
 
-    QList<int> vals = multithreadedSteps(size);
-    QList <QFuture<void> > tasks;
+    QMutex mutex;
 
     Args prm;
     prm.thold     = &thold;
@@ -393,33 +393,31 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
         stdev[0]   = stdev[1]   = stdev[2]   = stdev[3]   = stdev[4]   = 0.0;
         samples[0] = samples[1] = samples[2] = samples[3] = samples[4] = 0;
 
-        // calculate stdevs for all intensities
+        // calculate stdevs for all intensities, with per range accumulators merged at end.
 
-        for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-        {
-            prm.start = vals[j];
-            prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &NRFilter::calculteStdevMultithreaded, this,
-
-#else
-
-                                           this, &NRFilter::calculteStdevMultithreaded,
+        processRanges(size, 3 * sizeof(float),
+                      [this, &prm, &mutex](int start, int stop)
+                      {
+                          double rangeStdev[5]   = { 0.0 };
+                          uint   rangeSamples[5] = { 0 };
 
-#endif
+                          Args range    = prm;
+                          range.start   = start;
+                          range.stop    = stop;
+                          range.stdev   = &rangeStdev[0];
+                          range.samples = &rangeSamples[0];
+                          calculteStdevMultithreaded(range);
 
-                                           prm
-                                          )
-            );
-        }
+                          QMutexLocker lock(&mutex);
 
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
+                          for (int i = 0 ; i < 5 ; ++i)
+                          {
+                              prm.stdev[i]   += rangeStdev[i];
+                              prm.samples[i] += rangeSamples[i];
+                          }
+                      },
+                      0, 0
+        );
 
         stdev[0] = sqrt(stdev[0] / (samples[0] + 1));
         stdev[1] = sqrt(stdev[1] / (samples[1] + 1));
@@ -429,33 +427,19 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
 
         // do thresholding
 
-        tasks.clear();
-
-        for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-        {
-            prm.start = vals[j];
-            prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &NRFilter::thresholdingMultithreaded, this,
-
-#else
-
-                                           this, &NRFilter::thresholdingMultithreaded,
-
-#endif
-
-                                           prm
-                                          )
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
+        processRanges(size, 3 * sizeof(float),
+                      [this, &prm](int start, int stop)
+                      {
+                          float rangeThold = 0.0;
+
+                          Args range  = prm;
+                          range.start = start;
+                          range.stop  = stop;
+                          range.thold = &rangeThold;
+                          thresholdingMultithreaded(range);
+                      },
+                      0, 0
+        );
 
         hpass = lpass;
     }
@@ -24,10 +24,6 @@
 #include <cmath>
 #include <cstdlib>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "digikam_debug.h"
@@ -146,7 +142,7 @@ void SharpenFilter::sharpenImage(double radius, double sigma)
     convolveImage(kernelWidth, kernel.data());
 }
 
-void SharpenFilter::convolveImageMultithreaded(const Args& prm)
+void SharpenFilter::convolveTile(const Args& prm, const Tile& tile)
 {
     double  maxClamp = m_destImage.sixteenBit() ? 16777215.0 : 65535.0;
     double* k        = nullptr;
@@ -154,44 +150,45 @@ void SharpenFilter::convolveImageMultithreaded(const Args& prm)
     int     mx, my, sx, sy, mcx, mcy;
     DColor  color;
 
-    for (uint x = prm.start ; runningFlag() && (x < prm.stop) ; ++x)
+    for (int y = tile.area.top() ; runningFlag() && (y <= tile.area.bottom()) ; ++y)
     {
-        k   = prm.normal_kernel;
-        red = green = blue = alpha = 0;
-        sy  = prm.y - prm.halfKernelWidth;
-
-        for (mcy = 0 ; runningFlag() && (mcy < prm.kernelWidth) ; ++mcy, ++sy)
+        for (int x = tile.area.left() ; x <= tile.area.right() ; ++x)
         {
-            my = (sy < 0) ? 0 : (sy > (int)m_destImage.height() - 1) ? m_destImage.height() - 1 : sy;
-            sx = x + (-prm.halfKernelWidth);
+            k   = prm.normal_kernel;
+            red = green = blue = alpha = 0;
+            sy  = y - prm.halfKernelWidth;
 
-            for (mcx = 0 ; runningFlag() && (mcx < prm.kernelWidth) ; ++mcx, ++sx)
+            for (mcy = 0 ; mcy < prm.kernelWidth ; ++mcy, ++sy)
             {
-                mx     = (sx < 0) ? 0 : (sx > (int)m_destImage.width() - 1) ? m_destImage.width() - 1 : sx;
-                color  = m_orgImage.getPixelColor(mx, my);
-                red   += (*k) * (color.red()   * 257.0);
-                green += (*k) * (color.green() * 257.0);
-                blue  += (*k) * (color.blue()  * 257.0);
-                alpha += (*k) * (color.alpha() * 257.0);
-                ++k;
+                my = (sy < 0) ? 0 : (sy > (int)m_destImage.height() - 1) ? m_destImage.height() - 1 : sy;
+                sx = x + (-prm.halfKernelWidth);
+
+                for (mcx = 0 ; mcx < prm.kernelWidth ; ++mcx, ++sx)
+                {
+                    mx     = (sx < 0) ? 0 : (sx > (int)m_destImage.width() - 1) ? m_destImage.width() - 1 : sx;
+                    color  = m_orgImage.getPixelColor(mx, my);
+                    red   += (*k) * (color.red()   * 257.0);
+                    green += (*k) * (color.green() * 257.0);
+                    blue  += (*k) * (color.blue()  * 257.0);
+                    alpha += (*k) * (color.alpha() * 257.0);
+                    ++k;
+                }
             }
-        }
 
-        red   =   red < 0.0 ? 0.0 :   (red > maxClamp) ? maxClamp :   red + 0.5;
-        green = green < 0.0 ? 0.0 : (green > maxClamp) ? maxClamp : green + 0.5;
-        blue  =  blue < 0.0 ? 0.0 :  (blue > maxClamp) ? maxClamp :  blue + 0.5;
-        alpha = alpha < 0.0 ? 0.0 : (alpha > maxClamp) ? maxClamp : alpha + 0.5;
+            red   =   red < 0.0 ? 0.0 :   (red > maxClamp) ? maxClamp :   red + 0.5;
+            green = green < 0.0 ? 0.0 : (green > maxClamp) ? maxClamp : green + 0.5;
+            blue  =  blue < 0.0 ? 0.0 :  (blue > maxClamp) ? maxClamp :  blue + 0.5;
+            alpha = alpha < 0.0 ? 0.0 : (alpha > maxClamp) ? maxClamp : alpha + 0.5;
 
-        m_destImage.setPixelColor(x, prm.y, DColor((int)(red  / 257UL), (int)(green / 257UL),
+            m_destImage.setPixelColor(x, y, DColor((int)(red  / 257UL), (int)(green / 257UL),
                                                    (int)(blue / 257UL), (int)(alpha / 257UL),
                                                    m_destImage.sixteenBit()));
+        }
     }
 }
 
 bool SharpenFilter::convolveImage(const unsigned int order, const double* const kernel)
 {
-    uint    y;
-    int     progress;
     long    i;
     double  normalize = 0.0;
 
@@ -233,49 +230,13 @@ bool SharpenFilter::convolveImage(const unsigned int order, const double* const
     }
 
     prm.normal_kernel = normal_kernel.data();
-    QList<int> vals   = multithreadedSteps(m_destImage.width());
-
-    for (y = 0 ; runningFlag() && (y < m_destImage.height()) ; ++y)
-    {
-        QList <QFuture<void> > tasks;
-
-        for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-        {
-            prm.start = vals[j];
-            prm.stop  = vals[j+1];
-            prm.y     = y;
-
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &SharpenFilter::convolveImageMultithreaded, this,
-
-#else
-
-                                           this, &SharpenFilter::convolveImageMultithreaded,
-
-#endif
-
-                                           prm
-                                          )
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
-
-        progress = (int)(((double)y * 100.0) / m_destImage.height());
-
-        if ((progress % 5) == 0)
-        {
-            postProgress(progress);
-        }
-    }
 
-    return true;
+    return processTiles(m_destImage.size(), m_orgImage.bytesDepth(), prm.halfKernelWidth,
+                        [this, &prm](const Tile& tile)
+                        {
+                            convolveTile(prm, tile);
+                        }
+    );
 }
 
 int SharpenFilter::getOptimalKernelWidth(double radius, double sigma)
@@ -36,9 +36,6 @@ private:
 
         Args() = default;
 
-        uint    start           = 0;
-        uint    stop            = 0;
-        uint    y               = 0;
         long    kernelWidth     = 0;
         double* normal_kernel   = nullptr;
         long    halfKernelWidth = 0;
@@ -91,7 +88,7 @@ private:
 
     bool convolveImage(const unsigned int order, const double* const kernel);
 
-    void convolveImageMultithreaded(const Args& prm);
+    void convolveTile(const Args& prm, const Tile& tile);
 
     int  getOptimalKernelWidth(double radius, double sigma);
 
@@ -22,10 +22,6 @@
 #include <cmath>
 #include <cstdlib>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "dimg.h"
@@ -68,7 +64,7 @@ QString UnsharpMaskFilter::DisplayableName()
     return QString::fromUtf8(I18N_NOOP("Unsharp Mask Tool"));
 }
 
-void UnsharpMaskFilter::unsharpMaskMultithreaded(uint start, uint stop, uint y)
+void UnsharpMaskFilter::unsharpMaskTile(const Tile& tile)
 {
     long int zero  = 0;
     double   value = 0.0;
@@ -79,103 +75,104 @@ void UnsharpMaskFilter::unsharpMaskMultithreaded(uint start, uint stop, uint y)
     double quantumThreshold = quantum * m_threshold;
     int hp = 0, sp = 0, lp = 0, hq = 0, sq = 0, lq = 0;
 
-    for (uint x = start ; runningFlag() && (x < stop) ; ++x)
+    for (int y = tile.area.top() ; runningFlag() && (y <= tile.area.bottom()) ; ++y)
     {
-        p = m_orgImage.getPixelColor(x, y);
-        q = m_destImage.getPixelColor(x, y);
-
-        if (m_luma)
+        for (int x = tile.area.left() ; x <= tile.area.right() ; ++x)
         {
-            p.getHSL(&hp, &sp, &lp);
-            q.getHSL(&hq, &sq, &lq);
+            p = m_orgImage.getPixelColor(x, y);
+            q = m_destImage.getPixelColor(x, y);
 
-            // luma channel
+            if (m_luma)
+            {
+                p.getHSL(&hp, &sp, &lp);
+                q.getHSL(&hq, &sq, &lq);
 
-            value = (double)(lp) - (double)(lq);
+                // luma channel
 
-            if (fabs(2.0 * value) < quantumThreshold)
-            {
-                value = (double)(lp);
+                value = (double)(lp) - (double)(lq);
+
+                if (fabs(2.0 * value) < quantumThreshold)
+                {
+                    value = (double)(lp);
+                }
+                else
+                {
+                    value = (double)(lp) + value * m_amount;
+                }
+
+                q.setHSL(hp, sp, CLAMP(lround(value), zero, quantum), m_destImage.sixteenBit());
+                q.setAlpha(p.alpha());
             }
             else
             {
-                value = (double)(lp) + value * m_amount;
-            }
+                // Red channel.
 
-            q.setHSL(hp, sp, CLAMP(lround(value), zero, quantum), m_destImage.sixteenBit());
-            q.setAlpha(p.alpha());
-        }
-        else
-        {
-            // Red channel.
+                value = (double)(p.red()) - (double)(q.red());
 
-            value = (double)(p.red()) - (double)(q.red());
+                if (fabs(2.0 * value) < quantumThreshold)
+                {
+                    value = (double)(p.red());
+                }
+                else
+                {
+                    value = (double)(p.red()) + value * m_amount;
+                }
 
-            if (fabs(2.0 * value) < quantumThreshold)
-            {
-                value = (double)(p.red());
-            }
-            else
-            {
-                value = (double)(p.red()) + value * m_amount;
-            }
+                q.setRed(CLAMP(lround(value), zero, quantum));
 
-            q.setRed(CLAMP(lround(value), zero, quantum));
+                // Green Channel.
 
-            // Green Channel.
+                value = (double)(p.green()) - (double)(q.green());
 
-            value = (double)(p.green()) - (double)(q.green());
+                if (fabs(2.0 * value) < quantumThreshold)
+                {
+                    value = (double)(p.green());
+                }
+                else
+                {
+                    value = (double)(p.green()) + value * m_amount;
+                }
 
-            if (fabs(2.0 * value) < quantumThreshold)
-            {
-                value = (double)(p.green());
-            }
-            else
-            {
-                value = (double)(p.green()) + value * m_amount;
-            }
+                q.setGreen(CLAMP(lround(value), zero, quantum));
 
-            q.setGreen(CLAMP(lround(value), zero, quantum));
+                // Blue Channel.
 
-            // Blue Channel.
+                value = (double)(p.blue()) - (double)(q.blue());
 
-            value = (double)(p.blue()) - (double)(q.blue());
+                if (fabs(2.0 * value) < quantumThreshold)
+                {
+                    value = (double)(p.blue());
+                }
+                else
+                {
+                    value = (double)(p.blue()) + value * m_amount;
+                }
 
-            if (fabs(2.0 * value) < quantumThreshold)
-            {
-                value = (double)(p.blue());
-            }
-            else
-            {
-                value = (double)(p.blue()) + value * m_amount;
-            }
+                q.setBlue(CLAMP(lround(value), zero, quantum));
 
-            q.setBlue(CLAMP(lround(value), zero, quantum));
+                // Alpha Channel.
 
-            // Alpha Channel.
+                value = (double)(p.alpha()) - (double)(q.alpha());
 
-            value = (double)(p.alpha()) - (double)(q.alpha());
+                if (fabs(2.0 * value) < quantumThreshold)
+                {
+                    value = (double)(p.alpha());
+                }
+                else
+                {
+                    value = (double)(p.alpha()) + value * m_amount;
+                }
 
-            if (fabs(2.0 * value) < quantumThreshold)
-            {
-                value = (double)(p.alpha());
-            }
-            else
-            {
-                value = (double)(p.alpha()) + value * m_amount;
+                q.setAlpha(CLAMP(lround(value), zero, quantum));
             }
 
-            q.setAlpha(CLAMP(lround(value), zero, quantum));
+            m_destImage.setPixelColor(x, y, q);
         }
-
-        m_destImage.setPixelColor(x, y, q);
     }
 }
 
 void UnsharpMaskFilter::filterImage()
 {
-    int progress;
-
     if (m_orgImage.isNull())
     {
         qCWarning(DIGIKAM_DIMG_LOG) << "No image data available!";
@@ -186,44 +183,13 @@ void UnsharpMaskFilter::filterImage()
     // cppcheck-suppress unusedScopedObject
     BlurFilter(this, m_orgImage, m_destImage, 0, 10, (int)(m_radius*10.0));
 
-    QList<int> vals = multithreadedSteps(m_destImage.width());
-
-    for (uint y = 0 ; runningFlag() && (y < m_destImage.height()) ; ++y)
-    {
-        QList <QFuture<void> > tasks;
-
-        for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
-        {
-            tasks.append(QtConcurrent::run(
-
-#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
-
-                                           &UnsharpMaskFilter::unsharpMaskMultithreaded, this,
-
-#else
-
-                                           this, &UnsharpMaskFilter::unsharpMaskMultithreaded,
-
-#endif
-
-                                           vals[j],
-                                           vals[j+1],
-                                           y)
-            );
-        }
-
-        for (QFuture<void> t : std::as_const(tasks))
-        {
-            t.waitForFinished();
-        }
-
-        progress = (int)(10.0 + ((double)y * 90.0) / m_destImage.height());
-
-        if ((progress % 5) == 0)
-        {
-            postProgress(progress);
-        }
-    }
+    processTiles(m_destImage.size(), m_destImage.bytesDepth(), 0,
+                 [this](const Tile& tile)
+                 {
+                     unsharpMaskTile(tile);
+                 },
+                 10, 100
+    );
 }
 
 FilterAction UnsharpMaskFilter::filterAction()
@@ -69,7 +69,7 @@ public:
 private:
 
     void filterImage()                                                        override;
-    void unsharpMaskMultithreaded(uint start, uint stop, uint y);
+    void unsharpMaskTile(const Tile& tile);
 
 private:
 
@@ -33,6 +33,7 @@
 #include "dimg_p.h"
 #include "dmetadata.h"
 #include "dimgloaderobserver.h"
+#include "metaengine_rotation.h"
 
 namespace Digikam
 {
@@ -134,6 +135,72 @@ void DImgLoader::imageSetAttribute(const QString& key, const QVariant& value)
     m_image->setAttribute(key, value);
 }
 
+QRect DImgLoader::regionOfInterest(const QSize& size) const
+{
+    QVariant attribute = imageGetAttribute(QLatin1String("regionOfInterest"));
+
+    if (!attribute.isValid())
+    {
+        return QRect();
+    }
+
+    const QRect full(QPoint(0, 0), size);
+    QRect region       = attribute.toRect();
+    QVariant rotation  = imageGetAttribute(QLatin1String("regionOrientation"));
+
+    if (rotation.isValid())
+    {
+        // The region refers to the image rotated with the Exif orientation:
+        // map it back with the size read from the file header.
+
+        const QTransform matrix = orientationTransform(size, rotation.toInt());
+        region                  = matrix.inverted().mapRect(QRectF(region)).toAlignedRect();
+    }
+
+    region             &= full;
+
+    if (!region.isValid() || (region == full))
+    {
+        return QRect();
+    }
+
+    return region;
+}
+
+QTransform DImgLoader::orientationTransform(const QSize& size, int orientation)
+{
+    QTransform matrix = MetaEngineRotation::toTransform((MetaEngine::ImageOrientation)orientation);
+    const QRectF full = matrix.mapRect(QRectF(QPointF(0.0, 0.0), QSizeF(size)));
+
+    return (matrix * QTransform::fromTranslate(-full.left(), -full.top()));
+}
+
+int DImgLoader::scaledLoadingFactor(const QSize& size, int maxFactor) const
+{
+    QVariant attribute = imageGetAttribute(QLatin1String("scaledLoadingSize"));
+
+    if (!attribute.isValid() || (attribute.toInt() <= 0))
+    {
+        return 1;
+    }
+
+    const int scaledLoadingSize = attribute.toInt();
+    const int imgSize           = qMax(size.width(), size.height());
+    int factor                  = 1;
+
+    while (((factor * 2) <= maxFactor) && ((scaledLoadingSize * factor * 2) <= imgSize))
+    {
+        factor *= 2;
+    }
+
+    return factor;
+}
+
+void DImgLoader::setLoadedRegion(const QRect& region)
+{
+    imageSetAttribute(QLatin1String("loadedRegion"), region);
+}
+
 QMap<QString, QString>& DImgLoader::imageEmbeddedText() const
 {
     return m_image->m_priv->embeddedText;
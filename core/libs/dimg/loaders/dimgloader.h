@@ -22,7 +22,9 @@
 // Qt includes
 
 #include <QMap>
+#include <QRect>
 #include <QString>
+#include <QTransform>
 #include <QVariant>
 
 // Local includes
@@ -88,6 +90,12 @@ public:
     static int convertCompressionForLibPng(int value);
     static int convertCompressionForLibJpeg(int value);
 
+    /**
+     * Return the transform from the coordinates of the image stored in a file of size pixels
+     * to the coordinates of the image rotated with the Exif orientation.
+     */
+    static QTransform orientationTransform(const QSize& size, int orientation);
+
     /**
      * Value returned : -1 : unsupported platform
      *                   0 : parse failure from supported platform
@@ -123,6 +131,25 @@ protected:
     void                    imageSetEmbbededText(const QString& key,
                                                  const QString& text);
 
+    /**
+     * Region loading, see DImg::loadRegion(): return the region of interest set in the
+     * "regionOfInterest" attribute, mapped back from the "regionOrientation" Exif orientation
+     * if any and clipped to an image of size pixels, or a null rectangle if the whole image
+     * must be loaded.
+     */
+    QRect                   regionOfInterest(const QSize& size)                     const;
+
+    /**
+     * Return the power of two to divide the size of an image of size pixels for the reduced
+     * loading requested in the "scaledLoadingSize" attribute, limited to maxFactor.
+     */
+    int                     scaledLoadingFactor(const QSize& size, int maxFactor)   const;
+
+    /**
+     * Store the region loaded, in full size image coordinates, for DImg::loadedRegion().
+     */
+    void                    setLoadedRegion(const QRect& region);
+
     void                    loadingFailed();
     bool                    checkExifWorkingColorSpace()                            const;
     void                    purgeExifWorkingColorSpace();
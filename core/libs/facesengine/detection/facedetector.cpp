@@ -104,6 +104,69 @@ public:
 */
     }
 
+    /**
+     * The images are prepared as for the detection of one image, which depends
+     * on the model, then the faces are detected with one pass when possible.
+     */
+    template <typename T>
+    QList<QList<QRectF> > detectFaces(const QList<T>& images)
+    {
+        QList<QList<QRectF> > result;
+
+        std::vector<cv::Mat>  cvImages;
+        std::vector<cv::Size> paddedSizes;
+        QList<int>            indexes;
+
+        for (int i = 0 ; i < images.size() ; ++i)
+        {
+            result << QList<QRectF>();
+
+            if (images.at(i).isNull() || !images.at(i).size().isValid())
+            {
+                continue;
+            }
+
+            cv::Size paddedSize(0, 0);
+            cvImages.push_back(backend()->prepareForDetection(images.at(i), paddedSize));
+            paddedSizes.push_back(paddedSize);
+            indexes << i;
+        }
+
+        if (cvImages.empty())
+        {
+            return result;
+        }
+
+        try
+        {
+            const std::vector<std::vector<cv::Rect> > bboxes = backend()->cvDetectFaces(cvImages, paddedSizes);
+
+            for (size_t i = 0 ; i < bboxes.size() ; ++i)
+            {
+                QList<QRect> absRects;
+
+                for (const cv::Rect& bbox : bboxes[i])
+                {
+                    absRects << QRect(bbox.x, bbox.y, bbox.width, bbox.height);
+                }
+
+                result[indexes.at(int(i))] = FaceDetector::toRelativeRects(absRects,
+                                                                           QSize(cvImages[i].cols - 2 * paddedSizes[i].width,
+                                                                                 cvImages[i].rows - 2 * paddedSizes[i].height));
+            }
+        }
+        catch (cv::Exception& e)
+        {
+            qCCritical(DIGIKAM_FACESENGINE_LOG) << "cv::Exception:" << e.what();
+        }
+        catch (...)
+        {
+            qCCritical(DIGIKAM_FACESENGINE_LOG) << "Default exception from OpenCV";
+        }
+
+        return result;
+    }
+
 public:
 
     QVariantMap            m_parameters;
@@ -236,6 +299,16 @@ QList<QRectF> FaceDetector::detectFaces(const QString& imagePath)
     return result;
 }
 
+QList<QList<QRectF> > FaceDetector::detectFaces(const QList<QImage>& images)
+{
+    return d->detectFaces(images);
+}
+
+QList<QList<QRectF> > FaceDetector::detectFaces(const QList<DImg>& images)
+{
+    return d->detectFaces(images);
+}
+
 void FaceDetector::setParameter(const QString& parameter, const QVariant& value)
 {
     d->m_parameters.insert(parameter, value);
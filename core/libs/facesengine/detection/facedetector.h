@@ -74,6 +74,15 @@ public:
 
     QList<QRectF> detectFaces(const QString& imagePath);
 
+    /**
+     * Scan several images for faces, with one pass of the neural network
+     * when the model supports it. Return one list of regions per image.
+     *
+     * Found faces are returned in relative coordinates.
+     */
+    QList<QList<QRectF> > detectFaces(const QList<QImage>& images);
+    QList<QList<QRectF> > detectFaces(const QList<DImg>& images);
+
     /**
      * Tunes backend parameters.
      * Available parameters:
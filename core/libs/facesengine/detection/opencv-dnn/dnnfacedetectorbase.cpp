@@ -42,6 +42,18 @@ DNNFaceDetectorBase::DNNFaceDetectorBase(float scale,
 {
 }
 
+void DNNFaceDetectorBase::detectFaces(const std::vector<cv::Mat>& inputImages,
+                                      const std::vector<cv::Size>& paddedSizes,
+                                      std::vector<std::vector<cv::Rect> >& detectedBboxes)
+{
+    detectedBboxes.resize(inputImages.size());
+
+    for (size_t i = 0 ; i < inputImages.size() ; ++i)
+    {
+        detectFaces(inputImages[i], paddedSizes[i], detectedBboxes[i]);
+    }
+}
+
 cv::Size DNNFaceDetectorBase::nnInputSizeRequired() const
 {
     return inputImageSize;
@@ -44,6 +44,15 @@ public:
                              const cv::Size& paddedSize,
                              std::vector<cv::Rect>& detectedBboxes) = 0;
 
+    /**
+     * Detect the faces of several images prepared for the detection, with one pass
+     * of the neural network when the model supports it. The default implementation
+     * processes the images one by one.
+     */
+    virtual void detectFaces(const std::vector<cv::Mat>& inputImages,
+                             const std::vector<cv::Size>& paddedSizes,
+                             std::vector<std::vector<cv::Rect> >& detectedBboxes);
+
     cv::Size nnInputSizeRequired() const;
 
 protected:
@@ -124,9 +124,39 @@ void DNNFaceDetectorSSD::detectFaces(const cv::Mat& inputImage,
     postprocess(detection, paddedSize, detectedBboxes);
 }
 
+void DNNFaceDetectorSSD::detectFaces(const std::vector<cv::Mat>& inputImages,
+                                     const std::vector<cv::Size>& paddedSizes,
+                                     std::vector<std::vector<cv::Rect> >& detectedBboxes)
+{
+    detectedBboxes.resize(inputImages.size());
+
+    if (inputImages.empty() || net.empty())
+    {
+        return;
+    }
+
+    // The images are resized to the input size of the network, the detections of
+    // all images are returned in one matrix, with the index of the image in the batch.
+
+    cv::Mat detection;
+    cv::Mat inputBlob = cv::dnn::blobFromImages(inputImages, scaleFactor, inputImageSize, meanValToSubtract, true, false);
+
+    {
+        QMutexLocker lock(&mutex);
+        net.setInput(inputBlob);
+        detection = net.forward();
+    }
+
+    for (size_t i = 0 ; i < inputImages.size() ; ++i)
+    {
+        postprocess(detection, paddedSizes[i], detectedBboxes[i], int(i));
+    }
+}
+
 void DNNFaceDetectorSSD::postprocess(cv::Mat detection,
                                      const cv::Size& paddedSize,
-                                     std::vector<cv::Rect>& detectedBboxes) const
+                                     std::vector<cv::Rect>& detectedBboxes,
+                                     int imageId) const
 {
     std::vector<float> goodConfidences, doubtConfidences, confidences;
     std::vector<cv::Rect> goodBoxes, doubtBoxes, boxes;
@@ -137,6 +167,11 @@ void DNNFaceDetectorSSD::postprocess(cv::Mat detection,
 
     for (int i = 0 ; i < detectionMat.rows ; ++i)
     {
+        if ((imageId >= 0) && (int(detectionMat.at<float>(i, 0)) != imageId))
+        {
+            continue;
+        }
+
         float confidence = detectionMat.at<float>(i, 2);
 
         if (confidence > confidenceThreshold)
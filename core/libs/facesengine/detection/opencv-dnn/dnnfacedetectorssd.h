@@ -36,11 +36,19 @@ public:
                      const cv::Size& paddedSize,
                      std::vector<cv::Rect>& detectedBboxes)       override;
 
+    void detectFaces(const std::vector<cv::Mat>& inputImages,
+                     const std::vector<cv::Size>& paddedSizes,
+                     std::vector<std::vector<cv::Rect> >& detectedBboxes) override;
+
 private:
 
+    /**
+     * With a batch of images, imageId selects the detections of one image.
+     */
     void postprocess(cv::Mat detectionMat,
                      const cv::Size& paddedSize,
-                     std::vector<cv::Rect>& detectedBboxes) const;
+                     std::vector<cv::Rect>& detectedBboxes,
+                     int imageId = -1) const;
 
 private:
 
@@ -141,6 +141,49 @@ void DNNFaceDetectorYOLO::detectFaces(const cv::Mat& inputImage,
     qCDebug(DIGIKAM_FACESENGINE_LOG) << "postprocess YOLO detection in" << timer.elapsed() << "ms";
 }
 
+void DNNFaceDetectorYOLO::detectFaces(const std::vector<cv::Mat>& inputImages,
+                                      const std::vector<cv::Size>& paddedSizes,
+                                      std::vector<std::vector<cv::Rect> >& detectedBboxes)
+{
+    detectedBboxes.resize(inputImages.size());
+
+    if (inputImages.empty() || net.empty())
+    {
+        return;
+    }
+
+    QElapsedTimer timer;
+
+    cv::Mat inputBlob  = cv::dnn::blobFromImages(inputImages, scaleFactor, inputImageSize, meanValToSubtract, true, false);
+    std::vector<cv::Mat> outs;
+
+    {
+        QMutexLocker lock(&mutex);
+        net.setInput(inputBlob);
+        timer.start();
+        net.forward(outs, getOutputsNames());
+        qCDebug(DIGIKAM_FACESENGINE_LOG) << "forward YOLO detection of" << inputImages.size()
+                                         << "images in" << timer.elapsed() << "ms";
+    }
+
+    // Each output layer stores the boxes of the images one after the other.
+
+    const int batch = int(inputImages.size());
+
+    for (int b = 0 ; b < batch ; ++b)
+    {
+        std::vector<cv::Mat> imageOuts;
+
+        for (const cv::Mat& out : outs)
+        {
+            const int rows = out.rows / batch;
+            imageOuts.push_back(out.rowRange(b * rows, (b + 1) * rows));
+        }
+
+        postprocess(imageOuts, paddedSizes[b], detectedBboxes[b]);
+    }
+}
+
 void DNNFaceDetectorYOLO::postprocess(const std::vector<cv::Mat>& outs,
                                       const cv::Size& paddedSize,
                                       std::vector<cv::Rect>& detectedBboxes) const
@@ -41,6 +41,10 @@ public:
                      const cv::Size& paddedSize,
                      std::vector<cv::Rect>& detectedBboxes)       override;
 
+    void detectFaces(const std::vector<cv::Mat>& inputImages,
+                     const std::vector<cv::Size>& paddedSizes,
+                     std::vector<std::vector<cv::Rect> >& detectedBboxes) override;
+
 private:
 
     std::vector<cv::String> getOutputsNames()               const;
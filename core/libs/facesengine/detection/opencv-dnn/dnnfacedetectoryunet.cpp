@@ -67,8 +67,6 @@ const int DNNFaceDetectorYuNet::imageSizeMaxDimensions[5] =
     2000
 };
 
-QMutex DNNFaceDetectorYuNet::lockModel;
-
 DNNFaceDetectorYuNet::DNNFaceDetectorYuNet()
     : DNNFaceDetectorBase(1.0F / 255.0F,
                           cv::Scalar(0.0, 0.0, 0.0),
@@ -199,9 +197,9 @@ cv::Mat DNNFaceDetectorYuNet::callModel(const cv::Mat& inputImage)
 
     qCDebug(DIGIKAM_FACESENGINE_LOG) << "starting YuNet face detection";
 
-    // lock the model for single threading
+    // lock the model of this instance for single threading
 
-    QMutexLocker lock(&lockModel);
+    QMutexLocker lock(&mutex);
 
     try
     {
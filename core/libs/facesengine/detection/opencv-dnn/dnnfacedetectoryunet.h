@@ -42,10 +42,15 @@ public:
                      const cv::Size& paddedSize,
                      std::vector<cv::Rect>& detectedBboxes)     override;
 
+    /**
+     * The YuNet model has a variable input size: the images are processed one by one,
+     * the detectors of different threads run in parallel.
+     */
+    using DNNFaceDetectorBase::detectFaces;
+
 protected:
 
-    cv::Ptr<cv::FaceDetectorYN>         cv_model;                   ///< the YuNet model
-    static QMutex                       lockModel;                  ///< mutex for single-threading calls to the model
+    cv::Ptr<cv::FaceDetectorYN>         cv_model;                   ///< the YuNet model, locked by the mutex of the instance
     static const int                    imageSizeMaxDimensions[5];  ///< stepped array for controlling the size of the image fed to YuNet  
 /*
     static std::map<std::string, int>   str2backend;
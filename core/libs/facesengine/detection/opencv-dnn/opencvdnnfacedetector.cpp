@@ -147,7 +147,14 @@ cv::Mat OpenCVDNNFaceDetector::prepareForDetection(const QImage& inputImage, cv:
         }
     }
 
-    return prepareForDetection(cvImage, paddedSize);
+    if (DetectorNNModel::YUNET == m_modelType)
+    {
+        return prepareForDetectionYuNet(cvImage, paddedSize);
+    }
+    else
+    {
+        return prepareForDetection(cvImage, paddedSize);
+    }
 }
 
 cv::Mat OpenCVDNNFaceDetector::prepareForDetection(const QString& inputImagePath, cv::Size& paddedSize) const
@@ -166,7 +173,14 @@ cv::Mat OpenCVDNNFaceDetector::prepareForDetection(const QString& inputImagePath
 
     cv::Mat cvImage = cv::imdecode(std::vector<char>(buffer.begin(), buffer.end()), cv::IMREAD_COLOR);
 
-    return prepareForDetection(cvImage, paddedSize);
+    if (DetectorNNModel::YUNET == m_modelType)
+    {
+        return prepareForDetectionYuNet(cvImage, paddedSize);
+    }
+    else
+    {
+        return prepareForDetection(cvImage, paddedSize);
+    }
 }
 
 cv::Mat OpenCVDNNFaceDetector::prepareForDetection(cv::Mat& cvImage, cv::Size& paddedSize) const
@@ -309,4 +323,14 @@ std::vector<cv::Rect> OpenCVDNNFaceDetector::cvDetectFaces(const cv::Mat& inputI
     return detectedBboxes;
 }
 
+std::vector<std::vector<cv::Rect> > OpenCVDNNFaceDetector::cvDetectFaces(const std::vector<cv::Mat>& inputImages,
+                                                                         const std::vector<cv::Size>& paddedSizes)
+{
+    std::vector<std::vector<cv::Rect> > detectedBboxes;
+
+    m_inferenceEngine->detectFaces(inputImages, paddedSizes, detectedBboxes);
+
+    return detectedBboxes;
+}
+
 } // namespace Digikam
\ No newline at end of file
@@ -55,6 +55,13 @@ public:
     QList<QRect> detectFaces(const cv::Mat& inputImage, const cv::Size& paddedSize);
     std::vector<cv::Rect> cvDetectFaces(const cv::Mat& inputImage, const cv::Size& paddedSize);
 
+    /**
+     * Detect the faces of several prepared images, with one pass of the neural network
+     * when the model supports it.
+     */
+    std::vector<std::vector<cv::Rect> > cvDetectFaces(const std::vector<cv::Mat>& inputImages,
+                                                      const std::vector<cv::Size>& paddedSizes);
+
     /**
      * Returns the image size (one dimension)
      * recommended for face detection. If the image is considerably larger, it will be rescaled automatically.
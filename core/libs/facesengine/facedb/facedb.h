@@ -36,6 +36,7 @@ namespace Digikam
 {
 
 class KDTree;
+class HNSWIndex;
 
 class FaceDb
 {
@@ -92,6 +93,19 @@ public:
      */
     KDTree* reconstructTree()                                                   const;
 
+    /**
+     * @brief reconstructIndex: load the HNSW index from its snapshot file, and add the
+     * face vectors inserted in the database since the snapshot was saved. The index is
+     * rebuilt from the database if the snapshot is missing or out of date.
+     * @return
+     */
+    HNSWIndex* reconstructIndex()                                               const;
+
+    /**
+     * @brief indexSnapshotPath: path of the HNSW index snapshot file, next to the face database
+     */
+    static QString indexSnapshotPath();
+
     /**
      * @brief trainData: extract train data from database
      * @return
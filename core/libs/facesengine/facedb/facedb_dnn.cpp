@@ -16,6 +16,15 @@
 
 #include "facedb_p.h"
 
+// Qt includes
+
+#include <QDir>
+#include <QElapsedTimer>
+
+// Local includes
+
+#include "facedbaccess.h"
+
 namespace Digikam
 {
 
@@ -75,6 +84,73 @@ KDTree* FaceDb::reconstructTree() const
     return tree;
 }
 
+HNSWIndex* FaceDb::reconstructIndex() const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    HNSWIndex* const index = new HNSWIndex(128);
+    int lastNodeId         = 0;
+
+    if (index->load(indexSnapshotPath()))
+    {
+        // The snapshot is up to date if it contains all the vectors of the database up to
+        // its last node. Removing vectors from the database deletes the snapshot file.
+
+        DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT COUNT(*) FROM FaceMatrices WHERE id <= ?;"),
+                                                  index->lastNodeId());
+
+        if (query.next() && (query.value(0).toInt() == index->size()))
+        {
+            lastNodeId = index->lastNodeId();
+        }
+        else
+        {
+            qCDebug(DIGIKAM_FACEDB_LOG) << "Face index snapshot is out of date";
+
+            index->clear();
+        }
+    }
+
+    const int loaded       = index->size();
+    DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT id, identity, embedding FROM FaceMatrices "
+                                                            "WHERE id > ? ORDER BY id;"),
+                                              lastNodeId);
+
+    while (query.next())
+    {
+        int nodeId                    = query.value(0).toInt();
+        int identity                  = query.value(1).toInt();
+        cv::Mat recordedFaceEmbedding = cv::Mat(1, 128, CV_32F, query.value(2).toByteArray().data()).clone();
+
+        if (!index->add(recordedFaceEmbedding, identity, nodeId))
+        {
+            qCWarning(DIGIKAM_FACEDB_LOG) << "Error insert node" << nodeId;
+        }
+    }
+
+    qCDebug(DIGIKAM_FACEDB_LOG) << "Face index loaded with" << loaded << "vectors from snapshot and"
+                                << index->size() - loaded << "vectors from database in"
+                                << timer.elapsed() << "ms";
+
+    return index;
+}
+
+QString FaceDb::indexSnapshotPath()
+{
+    const DbEngineParameters params = FaceDbAccess::parameters();
+
+    if (params.isSQLite())
+    {
+        return QDir::cleanPath(params.getFaceDatabaseNameOrDir() + QLatin1String("/recognition-hnsw.idx"));
+    }
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+
+    return QDir::cleanPath(dir + QLatin1String("/recognition-hnsw.idx"));
+}
+
 cv::Ptr<cv::ml::TrainData> FaceDb::trainData() const
 {
     cv::Mat feature, label;
@@ -92,6 +168,8 @@ cv::Ptr<cv::ml::TrainData> FaceDb::trainData() const
 
 void FaceDb::clearDNNTraining(const QString& context)
 {
+    QFile::remove(indexSnapshotPath());
+
     if (context.isNull())
     {
         d->db->execSql(QLatin1String("DELETE FROM FaceMatrices;"));
@@ -105,6 +183,8 @@ void FaceDb::clearDNNTraining(const QString& context)
 
 void FaceDb::clearDNNTraining(const QList<int>& identities, const QString& context)
 {
+    QFile::remove(indexSnapshotPath());
+
     for (int id : std::as_const(identities))
     {
         if (context.isNull())
@@ -26,6 +26,7 @@
 
 #include "digikam_debug.h"
 #include "kd_tree.h"
+#include "hnsw_index.h"
 
 namespace Digikam
 {
@@ -64,6 +64,9 @@ public:
      * Determines recognition threshold, 0->accept very insecure recognitions, 1-> be very sure about a recognition.
      *
      * "k-nearest" : limit the number of nearest neighbors for KNN
+     *
+     * "classifier", values: "hnsw" (default), "tree", "db", type: string
+     * Selects the index of the face embeddings used to find the nearest neighbors.
      */
     void        setParameter(const QString& parameter, const QVariant& value);
     void        setParameters(const QVariantMap& parameters);
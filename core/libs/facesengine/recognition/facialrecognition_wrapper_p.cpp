@@ -60,7 +60,7 @@ FacialRecognitionWrapper::Private::Private()
         qCDebug(DIGIKAM_FACESENGINE_LOG) << "Failed to initialize face database";
     }
 
-    recognizer = new OpenCVDNNFaceRecognizer(OpenCVDNNFaceRecognizer::Tree);
+    createRecognizer();
 }
 
 FacialRecognitionWrapper::Private::~Private()
@@ -56,6 +56,13 @@ public:
 
     void applyParameters();
 
+    /**
+     * Create the recognizer using the classifier set in the "classifier" parameter,
+     * HNSW by default.
+     */
+    void createRecognizer();
+    OpenCVDNNFaceRecognizer::Classifier requestedClassifier() const;
+
 public:
 
     // --- Faces Training management (facesengine_interface_training.cpp) ----------------------------------
@@ -86,6 +93,8 @@ public:
     QVariantMap                 parameters;
     QHash<int, Identity>        identityCache;
     OpenCVDNNFaceRecognizer*    recognizer  = nullptr;
+
+    OpenCVDNNFaceRecognizer::Classifier classifier = OpenCVDNNFaceRecognizer::HNSW;
 };
 
 } // namespace Digikam
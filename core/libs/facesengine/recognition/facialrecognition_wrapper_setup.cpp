@@ -20,8 +20,39 @@
 namespace Digikam
 {
 
+OpenCVDNNFaceRecognizer::Classifier FacialRecognitionWrapper::Private::requestedClassifier() const
+{
+    const QString name = parameters.value(QLatin1String("classifier")).toString().toLower();
+
+    if      (name == QLatin1String("tree"))
+    {
+        return OpenCVDNNFaceRecognizer::Tree;
+    }
+    else if (name == QLatin1String("db"))
+    {
+        return OpenCVDNNFaceRecognizer::DB;
+    }
+
+    return OpenCVDNNFaceRecognizer::HNSW;
+}
+
+void FacialRecognitionWrapper::Private::createRecognizer()
+{
+    delete recognizer;
+
+    classifier = requestedClassifier();
+    recognizer = new OpenCVDNNFaceRecognizer(classifier);
+
+    qCDebug(DIGIKAM_FACESENGINE_LOG) << "recognition classifier" << (int)classifier;
+}
+
 void FacialRecognitionWrapper::Private::applyParameters()
 {
+    if (requestedClassifier() != classifier)
+    {
+        createRecognizer();
+    }
+
     int k           = 5;
     float threshold = 0.6F;
 
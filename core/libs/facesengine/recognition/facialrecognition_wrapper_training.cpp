@@ -50,9 +50,8 @@ void FacialRecognitionWrapper::Private::clear(const QList<int>& idsToClear, cons
 {
     recognizer->clearTraining(idsToClear, trainingContext);
 
-    delete recognizer;
-
-    recognizer = new OpenCVDNNFaceRecognizer(OpenCVDNNFaceRecognizer::Tree);
+    createRecognizer();
+    applyParameters();
 }
 
 // -------------------------------------------------------------------------------------
@@ -0,0 +1,247 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam
+ *
+ * Date        : 2026-10-17
+ * Description : Queue grouping the inputs of a neural network from several threads in batches
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "dnnbatchqueue.h"
+
+// C++ includes
+
+#include <deque>
+
+// Qt includes
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN DNNBatchQueue::Private
+{
+public:
+
+    class Request
+    {
+    public:
+
+        cv::Mat input;
+        cv::Mat output;
+        qint64  queued = 0;
+        bool    done   = false;
+    };
+
+public:
+
+    explicit Private(const BatchFunction& func)
+        : function(func)
+    {
+        clock.start();
+    }
+
+    /**
+     * Run the batch function on the oldest pending requests. The mutex is locked on call and on return.
+     */
+    void runBatch();
+
+public:
+
+    BatchFunction        function;
+    int                  batchSize  = 8;
+    int                  maxLatency = 5;
+    int                  callers    = 0;
+
+    QElapsedTimer        clock;
+    QMutex               mutex;
+    QWaitCondition       condition;
+    std::deque<Request*> pending;
+};
+
+void DNNBatchQueue::Private::runBatch()
+{
+    std::vector<Request*> batch;
+    std::vector<cv::Mat>  inputs;
+
+    while (!pending.empty() && (int(batch.size()) < batchSize))
+    {
+        batch.push_back(pending.front());
+        inputs.push_back(pending.front()->input);
+        pending.pop_front();
+    }
+
+    mutex.unlock();
+
+    std::vector<cv::Mat> outputs;
+
+    try
+    {
+        outputs = function(inputs);
+    }
+    catch (cv::Exception& e)
+    {
+        qCWarning(DIGIKAM_FACESENGINE_LOG) << "cv::Exception:" << e.what();
+    }
+    catch (...)
+    {
+        qCWarning(DIGIKAM_FACESENGINE_LOG) << "Default exception from OpenCV";
+    }
+
+    mutex.lock();
+
+    // An empty output marks a failed input for the caller.
+
+    for (size_t i = 0 ; i < batch.size() ; ++i)
+    {
+        if (i < outputs.size())
+        {
+            batch[i]->output = outputs[i];
+        }
+
+        batch[i]->done = true;
+    }
+
+    condition.wakeAll();
+}
+
+// ----------------------------------------------------------------------------------------
+
+DNNBatchQueue::DNNBatchQueue(const BatchFunction& function, int batchSize, int maxLatency)
+    : d(new Private(function))
+{
+    setBatchSize(batchSize);
+    setMaxLatency(maxLatency);
+}
+
+DNNBatchQueue::~DNNBatchQueue()
+{
+    delete d;
+}
+
+void DNNBatchQueue::setBatchSize(int size)
+{
+    QMutexLocker lock(&d->mutex);
+
+    d->batchSize = qMax(1, size);
+    d->condition.wakeAll();
+}
+
+int DNNBatchQueue::batchSize() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->batchSize;
+}
+
+void DNNBatchQueue::setMaxLatency(int msecs)
+{
+    QMutexLocker lock(&d->mutex);
+
+    d->maxLatency = qMax(0, msecs);
+    d->condition.wakeAll();
+}
+
+int DNNBatchQueue::maxLatency() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->maxLatency;
+}
+
+std::vector<cv::Mat> DNNBatchQueue::process(const std::vector<cv::Mat>& inputs)
+{
+    std::vector<Private::Request> requests(inputs.size());
+    std::vector<cv::Mat>          outputs(inputs.size());
+
+    if (inputs.empty())
+    {
+        return outputs;
+    }
+
+    QMutexLocker lock(&d->mutex);
+
+    const qint64 now = d->clock.elapsed();
+
+    for (size_t i = 0 ; i < inputs.size() ; ++i)
+    {
+        requests[i].input  = inputs[i];
+        requests[i].queued = now;
+        d->pending.push_back(&requests[i]);
+    }
+
+    ++d->callers;
+
+    // A waiting thread can have a full batch now.
+
+    d->condition.wakeAll();
+
+    Q_FOREVER
+    {
+        bool done = true;
+
+        for (const Private::Request& request : requests)
+        {
+            if (!request.done)
+            {
+                done = false;
+                break;
+            }
+        }
+
+        if (done)
+        {
+            break;
+        }
+
+        if (d->pending.empty())
+        {
+            // The remaining requests run in the batch of another thread.
+
+            d->condition.wait(&d->mutex);
+
+            continue;
+        }
+
+        // Without another caller, no request can join the batch: do not wait for the latency.
+
+        const qint64 waited = d->clock.elapsed() - d->pending.front()->queued;
+
+        if ((d->callers == 1) || (int(d->pending.size()) >= d->batchSize) || (waited >= d->maxLatency))
+        {
+            d->runBatch();
+        }
+        else
+        {
+            d->condition.wait(&d->mutex, (unsigned long)(d->maxLatency - waited));
+        }
+    }
+
+    --d->callers;
+
+    for (size_t i = 0 ; i < requests.size() ; ++i)
+    {
+        outputs[i] = requests[i].output;
+    }
+
+    return outputs;
+}
+
+cv::Mat DNNBatchQueue::process(const cv::Mat& input)
+{
+    return process(std::vector<cv::Mat>(1, input)).front();
+}
+
+} // namespace Digikam
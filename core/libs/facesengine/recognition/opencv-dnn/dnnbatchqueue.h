@@ -0,0 +1,82 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam
+ *
+ * Date        : 2026-10-17
+ * Description : Queue grouping the inputs of a neural network from several threads in batches
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// C++ includes
+
+#include <functional>
+#include <vector>
+
+// Local includes
+
+#include "digikam_opencv.h"
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * Group the inputs submitted by concurrent threads in batches, and run the neural
+ * network once per batch. There is no dedicated thread: one of the waiting threads
+ * runs the batch function, when the batch is full or when the oldest input waited
+ * for the maximum latency, and gives the outputs back to the other threads. A thread
+ * alone in the queue runs its inputs at once, without waiting for the latency.
+ * The batch function can run concurrently for different batches.
+ */
+class DIGIKAM_EXPORT DNNBatchQueue
+{
+public:
+
+    /**
+     * Return one output per input, in the same order.
+     */
+    typedef std::function<std::vector<cv::Mat>(const std::vector<cv::Mat>&)> BatchFunction;
+
+public:
+
+    explicit DNNBatchQueue(const BatchFunction& function, int batchSize = 8, int maxLatency = 5);
+    ~DNNBatchQueue();
+
+    /**
+     * Maximum count of inputs in a batch. With a size of 1, the inputs are not grouped.
+     */
+    void setBatchSize(int size);
+    int  batchSize()                                                    const;
+
+    /**
+     * Maximum time in milliseconds an input waits for the next inputs before its batch starts.
+     */
+    void setMaxLatency(int msecs);
+    int  maxLatency()                                                   const;
+
+    /**
+     * Process the inputs in the batches of the queue and return their outputs.
+     * This method is thread-safe and blocks until all outputs are available.
+     */
+    std::vector<cv::Mat> process(const std::vector<cv::Mat>& inputs);
+    cv::Mat              process(const cv::Mat& input);
+
+private:
+
+    // Disable
+    DNNBatchQueue(const DNNBatchQueue&)            = delete;
+    DNNBatchQueue& operator=(const DNNBatchQueue&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+};
+
+} // namespace Digikam
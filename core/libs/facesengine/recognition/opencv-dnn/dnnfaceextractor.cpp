@@ -17,8 +17,11 @@
 
 // Qt includes
 
+#include <QList>
 #include <QMutex>
 #include <QString>
+#include <QThread>
+#include <QWaitCondition>
 #include <QFileInfo>
 #include <QMutexLocker>
 #include <QElapsedTimer>
@@ -29,6 +32,7 @@
 #include "digikam_debug.h"
 #include "digikam_config.h"
 #include "recognitionpreprocessor.h"
+#include "dnnbatchqueue.h"
 
 namespace Digikam
 {
@@ -37,21 +41,55 @@ class Q_DECL_HIDDEN DNNFaceExtractor::Private
 {
 public:
 
-    Private() = default;
+    Private()
+        : queue([this](const std::vector<cv::Mat>& faces)
+                {
+                    return forward(faces);
+                })
+    {
+        if (qEnvironmentVariableIsSet("DIGIKAM_DNN_BATCH_SIZE"))
+        {
+            queue.setBatchSize(qEnvironmentVariableIntValue("DIGIKAM_DNN_BATCH_SIZE"));
+        }
+
+        if (qEnvironmentVariableIsSet("DIGIKAM_DNN_BATCH_LATENCY"))
+        {
+            queue.setMaxLatency(qEnvironmentVariableIntValue("DIGIKAM_DNN_BATCH_LATENCY"));
+        }
+    }
 
     ~Private()
     {
         delete preprocessor;
     }
 
+    cv::dnn::Net readNet() const;
+
+    /**
+     * Take a network from the pool, the pool grows up to one network per core
+     * when the faces are not processed in batches.
+     */
+    cv::dnn::Net acquireNet();
+    void releaseNet(const cv::dnn::Net& net);
+
+    /**
+     * Compute the embeddings of a batch of aligned faces with one pass of the neural network.
+     */
+    std::vector<cv::Mat> forward(const std::vector<cv::Mat>& alignedFaces);
+
 public:
 
     RecognitionPreprocessor* preprocessor       = nullptr;
 
     int                      ref                = 1;
 
-    cv::dnn::Net             net;
+    QString                  modelPath;
+    QList<cv::dnn::Net>      freeNets;
+    int                      netsCount          = 0;
     QMutex                   mutex;
+    QWaitCondition           netReleased;
+
+    DNNBatchQueue            queue;
 
     // As we use OpenFace, we need to set appropriate values for image color space and image size
 
@@ -60,6 +98,125 @@ public:
     cv::Scalar               meanValToSubtract  = cv::Scalar(0.0, 0.0, 0.0);
 };
 
+cv::dnn::Net DNNFaceExtractor::Private::readNet() const
+{
+    cv::dnn::Net net;
+
+    try
+    {
+
+#ifdef Q_OS_WIN
+
+        net = cv::dnn::readNetFromTorch(modelPath.toLocal8Bit().constData());
+
+#else
+
+        net = cv::dnn::readNetFromTorch(modelPath.toStdString());
+
+#endif
+
+#if (OPENCV_VERSION == QT_VERSION_CHECK(4, 7, 0))
+
+        net.enableWinograd(false);
+
+#endif
+
+    }
+    catch (cv::Exception& e)
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "cv::Exception:" << e.what();
+    }
+    catch (...)
+    {
+       qCWarning(DIGIKAM_FACEDB_LOG) << "Default exception from OpenCV";
+    }
+
+    return net;
+}
+
+cv::dnn::Net DNNFaceExtractor::Private::acquireNet()
+{
+    QMutexLocker lock(&mutex);
+
+    if (!netsCount)
+    {
+        return cv::dnn::Net();
+    }
+
+    const int maxNets = (queue.batchSize() > 1) ? 1 : qMax(1, QThread::idealThreadCount());
+
+    while (freeNets.isEmpty())
+    {
+        if (netsCount < maxNets)
+        {
+            ++netsCount;
+            lock.unlock();
+
+            return readNet();
+        }
+
+        netReleased.wait(&mutex);
+    }
+
+    return freeNets.takeLast();
+}
+
+void DNNFaceExtractor::Private::releaseNet(const cv::dnn::Net& net)
+{
+    if (net.empty())
+    {
+        return;
+    }
+
+    QMutexLocker lock(&mutex);
+
+    freeNets << net;
+    netReleased.wakeOne();
+}
+
+std::vector<cv::Mat> DNNFaceExtractor::Private::forward(const std::vector<cv::Mat>& alignedFaces)
+{
+    std::vector<cv::Mat> embeddings(alignedFaces.size());
+    cv::dnn::Net net = acquireNet();
+
+    if (net.empty())
+    {
+        return embeddings;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    cv::Mat blob = cv::dnn::blobFromImages(alignedFaces, scaleFactor, imageSize, cv::Scalar(), true, false);
+    cv::Mat output;
+
+    try
+    {
+        net.setInput(blob);
+        output = net.forward();
+    }
+    catch (...)
+    {
+        releaseNet(net);
+
+        throw;
+    }
+
+    releaseNet(net);
+
+    for (int i = 0 ; (i < output.rows) && (i < int(embeddings.size())) ; ++i)
+    {
+        embeddings[i] = output.row(i).clone();
+    }
+
+    qCDebug(DIGIKAM_FACEDB_LOG) << "Finish computing" << alignedFaces.size()
+                                << "face embeddings in" << timer.elapsed() << "ms";
+
+    return embeddings;
+}
+
+// ----------------------------------------------------------------------------------------
+
 DNNFaceExtractor::DNNFaceExtractor()
     : d(new Private)
 {
@@ -119,39 +276,21 @@ bool DNNFaceExtractor::loadModels()
 
     if (QFileInfo::exists(nnmodel))
     {
-        try
-        {
-            qCDebug(DIGIKAM_FACEDB_LOG) << "Extractor model:" << nnmodel;
-
-#ifdef Q_OS_WIN
-
-            d->net = cv::dnn::readNetFromTorch(nnmodel.toLocal8Bit().constData());
-
-#else
-
-            d->net = cv::dnn::readNetFromTorch(nnmodel.toStdString());
-
-#endif
-
-#if (OPENCV_VERSION == QT_VERSION_CHECK(4, 7, 0))
-
-            d->net.enableWinograd(false);
+        qCDebug(DIGIKAM_FACEDB_LOG) << "Extractor model:" << nnmodel;
 
-#endif
+        d->modelPath           = nnmodel;
+        const cv::dnn::Net net = d->readNet();
 
-        }
-        catch (cv::Exception& e)
+        if (net.empty())
         {
-            qCWarning(DIGIKAM_FACEDB_LOG) << "cv::Exception:" << e.what();
-
             return false;
         }
-        catch (...)
-        {
-           qCWarning(DIGIKAM_FACEDB_LOG) << "Default exception from OpenCV";
 
-           return false;
-        }
+        QMutexLocker lock(&d->mutex);
+
+        d->freeNets.clear();
+        d->freeNets << net;
+        d->netsCount = 1;
     }
     else
     {
@@ -248,45 +387,38 @@ cv::Mat DNNFaceExtractor::alignFace(const cv::Mat& inputImage) const
 
 cv::Mat DNNFaceExtractor::getFaceEmbedding(const cv::Mat& faceImage)
 {
-    cv::Mat face_descriptors;
-    cv::Mat alignedFace;
-/*
-    qCDebug(DIGIKAM_FACEDB_LOG) << "faceImage channels: " << faceImage.channels();
-    qCDebug(DIGIKAM_FACEDB_LOG) << "faceImage size: (" << faceImage.rows << ", " << faceImage.cols << ")\n";
-*/
-    QElapsedTimer timer;
+    return getFaceEmbeddings(std::vector<cv::Mat>(1, faceImage)).front();
+}
 
+std::vector<cv::Mat> DNNFaceExtractor::getFaceEmbeddings(const std::vector<cv::Mat>& faceImages)
+{
+    QElapsedTimer timer;
     timer.start();
-/*
-    alignedFace = faceImage;
-*/
-    alignedFace = d->preprocessor->preprocess(faceImage);
 
-    qCDebug(DIGIKAM_FACEDB_LOG) << "Finish aligning face in " << timer.elapsed() << " ms";
-    qCDebug(DIGIKAM_FACEDB_LOG) << "Start neural network";
+    std::vector<cv::Mat> alignedFaces(faceImages.size());
 
-    timer.start();
+    cv::parallel_for_(cv::Range(0, int(faceImages.size())), [&](const cv::Range& range)
+        {
+            for (int i = range.start ; i < range.end ; ++i)
+            {
+                alignedFaces[i] = d->preprocessor->preprocess(faceImages[i]);
+            }
+        }
+    );
 
-    cv::Mat blob = cv::dnn::blobFromImage(alignedFace, d->scaleFactor, d->imageSize, cv::Scalar(), true, false);
+    qCDebug(DIGIKAM_FACEDB_LOG) << "Finish aligning" << faceImages.size() << "faces in" << timer.elapsed() << "ms";
 
-    if (!d->net.empty())
-    {
-        QMutexLocker lock(&d->mutex);
-        d->net.setInput(blob);
-        face_descriptors = d->net.forward();
-    }
-
-    qCDebug(DIGIKAM_FACEDB_LOG) << "Finish computing face embedding in "
-                                << timer.elapsed() << " ms";
+    return d->queue.process(alignedFaces);
+}
 
-/*
-    cv::Mat blob = cv::dnn::blobFromImage(faceImage, 1.0 / 255, cv::Size(96, 96), cv::Scalar(0,0,0), false, true, CV_32F); // work for openface.nn4
-    cv::Mat blob = cv::dnn::blobFromImage(faceImage, 1.0 / 255, cv::Size(224,224), cv::Scalar(0,0,0), false, true, CV_32F);
-    net.setInput(blob);
-    cv::Mat face_descriptors = net.forward();
-*/
+void DNNFaceExtractor::setBatchSize(int size)
+{
+    d->queue.setBatchSize(size);
+}
 
-    return face_descriptors;
+void DNNFaceExtractor::setBatchLatency(int msecs)
+{
+    d->queue.setMaxLatency(msecs);
 }
 
 } // namespace Digikam
@@ -54,6 +54,26 @@ public:
     cv::Mat alignFace(const cv::Mat& inputImage) const;
     cv::Mat getFaceEmbedding(const cv::Mat& faceImage);
 
+    /**
+     * Return the embeddings of the faces, in the same order. The faces are aligned in parallel,
+     * then grouped in batches with the faces submitted by the other threads.
+     * An empty embedding is returned for a face which cannot be processed.
+     */
+    std::vector<cv::Mat> getFaceEmbeddings(const std::vector<cv::Mat>& faceImages);
+
+    /**
+     * Maximum count of faces processed by one pass of the neural network.
+     * With a size of 1, the faces are not grouped and one network is used per core.
+     * The default value is 8, or the DIGIKAM_DNN_BATCH_SIZE environment variable.
+     */
+    void setBatchSize(int size);
+
+    /**
+     * Maximum time in milliseconds a face waits for the next faces before its batch starts.
+     * The default value is 5 ms, or the DIGIKAM_DNN_BATCH_LATENCY environment variable.
+     */
+    void setBatchLatency(int msecs);
+
     /**
      * Calculate different between 2 vectors
      */
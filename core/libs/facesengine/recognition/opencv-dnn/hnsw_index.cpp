@@ -0,0 +1,751 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam
+ *
+ * Date        : 2026-10-17
+ * Description : Memory-resident approximate nearest neighbors index of face embeddings
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "hnsw_index.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Qt includes
+
+#include <QDataStream>
+#include <QFile>
+#include <QReadLocker>
+#include <QReadWriteLock>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QWriteLocker>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+// SIMD includes
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define HNSWINDEX_HAVE_SIMD
+#   define HNSWINDEX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace Digikam
+{
+
+static const quint32 s_snapshotMagic   = 0x64484E53;     // "dHNS"
+static const quint32 s_snapshotVersion = 1;
+
+/**
+ * A node of the graph with its squared distance to the query.
+ */
+typedef std::pair<float, int> HNSWCandidate;
+
+typedef float (*HNSWDistance)(const float* const, const float* const, int);
+
+static float hnswSqrDistance(const float* const pos1, const float* const pos2, int dimension)
+{
+    // Independent accumulators let the compiler vectorize the loop with the baseline instruction set.
+
+    float acc[8] = { 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F, 0.0F };
+    int i        = 0;
+
+    for ( ; (i + 8) <= dimension ; i += 8)
+    {
+        for (int j = 0 ; j < 8 ; ++j)
+        {
+            const float diff = pos1[i + j] - pos2[i + j];
+            acc[j]          += diff * diff;
+        }
+    }
+
+    float sum = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+
+    for ( ; i < dimension ; ++i)
+    {
+        const float diff = pos1[i] - pos2[i];
+        sum             += diff * diff;
+    }
+
+    return sum;
+}
+
+#ifdef HNSWINDEX_HAVE_SIMD
+
+HNSWINDEX_TARGET_AVX2 static float hnswSqrDistanceAVX2(const float* const pos1, const float* const pos2, int dimension)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    int i       = 0;
+
+    for ( ; (i + 16) <= dimension ; i += 16)
+    {
+        const __m256 diff0 = _mm256_sub_ps(_mm256_loadu_ps(pos1 + i),     _mm256_loadu_ps(pos2 + i));
+        const __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(pos1 + i + 8), _mm256_loadu_ps(pos2 + i + 8));
+        acc0               = _mm256_fmadd_ps(diff0, diff0, acc0);
+        acc1               = _mm256_fmadd_ps(diff1, diff1, acc1);
+    }
+
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum       = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum              = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum              = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+    float result     = _mm_cvtss_f32(sum);
+
+    for ( ; i < dimension ; ++i)
+    {
+        const float diff = pos1[i] - pos2[i];
+        result          += diff * diff;
+    }
+
+    return result;
+}
+
+/**
+ * Return true if the AVX2 distance kernel can be used at run-time.
+ * The environment variable DIGIKAM_HNSW_SIMD set to 0 disables it, for benchmarking purpose.
+ */
+static bool hnswUseAVX2()
+{
+    static const bool avx2 = []()
+    {
+        if (qEnvironmentVariableIsSet("DIGIKAM_HNSW_SIMD") && (qEnvironmentVariableIntValue("DIGIKAM_HNSW_SIMD") == 0))
+        {
+            return false;
+        }
+
+        __builtin_cpu_init();
+
+        return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"));
+    }();
+
+    return avx2;
+}
+
+#endif // HNSWINDEX_HAVE_SIMD
+
+template <typename T>
+static bool hnswWriteArray(QDataStream& stream, const QVector<T>& array)
+{
+    const int bytes = int(array.size() * sizeof(T));
+
+    return (stream.writeRawData(reinterpret_cast<const char*>(array.constData()), bytes) == bytes);
+}
+
+template <typename T>
+static bool hnswReadArray(QDataStream& stream, QVector<T>& array, int count)
+{
+    array.resize(count);
+    const int bytes = int(count * sizeof(T));
+
+    return (stream.readRawData(reinterpret_cast<char*>(array.data()), bytes) == bytes);
+}
+
+// ----------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN HNSWIndex::Private
+{
+public:
+
+    Private(int dimension, int m, int efc)
+        : dim           (dimension),
+          M             (qMax(2, m)),
+          efConstruction(qMax(M, efc)),
+          levelMult     (1.0 / std::log(double(M))),
+          distance      (hnswSqrDistance)
+    {
+
+#ifdef HNSWINDEX_HAVE_SIMD
+
+        if (hnswUseAVX2())
+        {
+            distance = hnswSqrDistanceAVX2;
+        }
+
+#endif
+
+    }
+
+    const float* vector(int node) const
+    {
+        return (vectors.constData() + qsizetype(node) * dim);
+    }
+
+    /**
+     * The links of a node on a layer: the count of links, followed by the linked nodes.
+     */
+    const int* links(int node, int level) const
+    {
+        if (level == 0)
+        {
+            return (baseLinks.constData() + qsizetype(node) * (2 * M + 1));
+        }
+
+        return (upperLinks.at(node).constData() + (level - 1) * (M + 1));
+    }
+
+    int* links(int node, int level)
+    {
+        if (level == 0)
+        {
+            return (baseLinks.data() + qsizetype(node) * (2 * M + 1));
+        }
+
+        return (upperLinks[node].data() + (level - 1) * (M + 1));
+    }
+
+    int maxLinks(int level) const
+    {
+        return (level ? M : 2 * M);
+    }
+
+    void reset();
+    int  randomLevel();
+
+    int  greedySearch(const float* const query, int entry, int fromLevel, int toLevel)    const;
+    std::vector<HNSWCandidate> searchLayer(const float* const query, int entry,
+                                           int ef, int level)                               const;
+    std::vector<int> selectNeighbors(const std::vector<HNSWCandidate>& candidates, int m)  const;
+    void connect(int node, int neighbor, int level);
+
+public:
+
+    const int              dim;
+    const int              M;
+    const int              efConstruction;
+    int                    efSearch     = 64;
+
+    QVector<float>         vectors;
+    QVector<float>         sqNorms;
+    QVector<int>           identities;
+    QVector<int>           nodeIds;
+    QVector<int>           levels;
+    QVector<int>           baseLinks;
+    QVector<QVector<int> > upperLinks;
+
+    int                    entryPoint   = -1;
+    int                    maxLevel     = -1;
+    int                    lastNodeId   = 0;
+    bool                   modified     = false;
+
+    std::mt19937           generator;
+    const double           levelMult;
+    HNSWDistance           distance;
+
+    mutable QReadWriteLock lock;
+};
+
+void HNSWIndex::Private::reset()
+{
+    vectors.clear();
+    sqNorms.clear();
+    identities.clear();
+    nodeIds.clear();
+    levels.clear();
+    baseLinks.clear();
+    upperLinks.clear();
+
+    entryPoint = -1;
+    maxLevel   = -1;
+    lastNodeId = 0;
+    modified   = true;
+
+    generator.seed(std::mt19937::default_seed);
+}
+
+int HNSWIndex::Private::randomLevel()
+{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    return int(-std::log(1.0 - uniform(generator)) * levelMult);
+}
+
+int HNSWIndex::Private::greedySearch(const float* const query, int entry, int fromLevel, int toLevel) const
+{
+    int   current     = entry;
+    float currentDist = distance(query, vector(current), dim);
+
+    for (int level = fromLevel ; level > toLevel ; --level)
+    {
+        bool changed = true;
+
+        while (changed)
+        {
+            changed               = false;
+            const int* const list = links(current, level);
+
+            for (int i = 1 ; i <= list[0] ; ++i)
+            {
+                const float dist = distance(query, vector(list[i]), dim);
+
+                if (dist < currentDist)
+                {
+                    currentDist = dist;
+                    current     = list[i];
+                    changed     = true;
+                }
+            }
+        }
+    }
+
+    return current;
+}
+
+std::vector<HNSWCandidate> HNSWIndex::Private::searchLayer(const float* const query, int entry,
+                                                           int ef, int level) const
+{
+    std::vector<bool> visited(identities.size(), false);
+
+    // Closest candidate first to expand, farthest result first to prune.
+
+    std::priority_queue<HNSWCandidate, std::vector<HNSWCandidate>, std::greater<HNSWCandidate> > candidates;
+    std::priority_queue<HNSWCandidate>                                                         results;
+
+    const float entryDist = distance(query, vector(entry), dim);
+    visited[entry]        = true;
+    candidates.emplace(entryDist, entry);
+    results.emplace(entryDist, entry);
+
+    while (!candidates.empty())
+    {
+        const HNSWCandidate current = candidates.top();
+
+        if ((current.first > results.top().first) && (int(results.size()) >= ef))
+        {
+            break;
+        }
+
+        candidates.pop();
+        const int* const list = links(current.second, level);
+
+        for (int i = 1 ; i <= list[0] ; ++i)
+        {
+            const int neighbor = list[i];
+
+            if (visited[neighbor])
+            {
+                continue;
+            }
+
+            visited[neighbor] = true;
+            const float dist  = distance(query, vector(neighbor), dim);
+
+            if ((int(results.size()) < ef) || (dist < results.top().first))
+            {
+                candidates.emplace(dist, neighbor);
+                results.emplace(dist, neighbor);
+
+                if (int(results.size()) > ef)
+                {
+                    results.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<HNSWCandidate> sorted(results.size());
+
+    for (int i = int(sorted.size()) - 1 ; i >= 0 ; --i)
+    {
+        sorted[i] = results.top();
+        results.pop();
+    }
+
+    return sorted;
+}
+
+std::vector<int> HNSWIndex::Private::selectNeighbors(const std::vector<HNSWCandidate>& candidates, int m) const
+{
+    // Keep a candidate only if it is closer to the base node than to the neighbors already kept:
+    // the links spread in all directions, which keeps the graph connected between clusters.
+
+    std::vector<int> selected;
+    selected.reserve(m);
+
+    for (const HNSWCandidate& candidate : candidates)
+    {
+        if (int(selected.size()) >= m)
+        {
+            break;
+        }
+
+        bool keep = true;
+
+        for (const int node : selected)
+        {
+            if (distance(vector(candidate.second), vector(node), dim) < candidate.first)
+            {
+                keep = false;
+                break;
+            }
+        }
+
+        if (keep)
+        {
+            selected.push_back(candidate.second);
+        }
+    }
+
+    return selected;
+}
+
+void HNSWIndex::Private::connect(int node, int neighbor, int level)
+{
+    int* const list = links(neighbor, level);
+    const int max   = maxLinks(level);
+
+    if (list[0] < max)
+    {
+        list[++list[0]] = node;
+
+        return;
+    }
+
+    // The list of links is full: select again the best links among the current ones and the new node.
+
+    const float* const base = vector(neighbor);
+    std::vector<HNSWCandidate> candidates;
+    candidates.reserve(max + 1);
+    candidates.emplace_back(distance(base, vector(node), dim), node);
+
+    for (int i = 1 ; i <= list[0] ; ++i)
+    {
+        candidates.emplace_back(distance(base, vector(list[i]), dim), list[i]);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    const std::vector<int> selected = selectNeighbors(candidates, max);
+    list[0]                         = int(selected.size());
+    std::copy(selected.begin(), selected.end(), list + 1);
+}
+
+// ----------------------------------------------------------------------------------------
+
+HNSWIndex::HNSWIndex(int dim, int M, int efConstruction)
+    : d(new Private(dim, M, efConstruction))
+{
+}
+
+HNSWIndex::~HNSWIndex()
+{
+    delete d;
+}
+
+int HNSWIndex::dimension() const
+{
+    return d->dim;
+}
+
+int HNSWIndex::size() const
+{
+    QReadLocker lock(&d->lock);
+
+    return d->identities.size();
+}
+
+void HNSWIndex::clear()
+{
+    QWriteLocker lock(&d->lock);
+
+    d->reset();
+}
+
+void HNSWIndex::setSearchSize(int ef)
+{
+    QWriteLocker lock(&d->lock);
+
+    d->efSearch = qMax(1, ef);
+}
+
+int HNSWIndex::lastNodeId() const
+{
+    QReadLocker lock(&d->lock);
+
+    return d->lastNodeId;
+}
+
+bool HNSWIndex::isModified() const
+{
+    QReadLocker lock(&d->lock);
+
+    return d->modified;
+}
+
+bool HNSWIndex::add(const cv::Mat& position, int identity, int nodeId)
+{
+    if ((position.type() != CV_32F) || (int(position.total()) != d->dim))
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Invalid face embedding for the index";
+
+        return false;
+    }
+
+    const cv::Mat embedding = position.isContinuous() ? position : position.clone();
+    const float* const pos  = embedding.ptr<float>();
+
+    QWriteLocker lock(&d->lock);
+
+    const int node  = d->identities.size();
+    const int level = d->randomLevel();
+    float sqNorm    = 0.0F;
+
+    for (int i = 0 ; i < d->dim ; ++i)
+    {
+        sqNorm += pos[i] * pos[i];
+    }
+
+    d->vectors.resize(d->vectors.size() + d->dim);
+    std::copy(pos, pos + d->dim, d->vectors.data() + qsizetype(node) * d->dim);
+
+    d->sqNorms    << sqNorm;
+    d->identities << identity;
+    d->nodeIds    << nodeId;
+    d->levels     << level;
+    d->upperLinks << QVector<int>(level * (d->M + 1), 0);
+    d->baseLinks.resize(d->baseLinks.size() + 2 * d->M + 1);
+    d->lastNodeId  = qMax(d->lastNodeId, nodeId);
+    d->modified    = true;
+
+    if (d->entryPoint == -1)
+    {
+        d->entryPoint = node;
+        d->maxLevel   = level;
+
+        return true;
+    }
+
+    const float* const query = d->vector(node);
+    int entry                = d->greedySearch(query, d->entryPoint, d->maxLevel, level);
+
+    for (int l = qMin(level, d->maxLevel) ; l >= 0 ; --l)
+    {
+        const std::vector<HNSWCandidate> candidates = d->searchLayer(query, entry, d->efConstruction, l);
+        const std::vector<int> neighbors            = d->selectNeighbors(candidates, d->M);
+        int* const list                             = d->links(node, l);
+        list[0]                                     = int(neighbors.size());
+        std::copy(neighbors.begin(), neighbors.end(), list + 1);
+
+        for (const int neighbor : neighbors)
+        {
+            d->connect(node, neighbor, l);
+        }
+
+        entry = candidates.front().second;
+    }
+
+    if (level > d->maxLevel)
+    {
+        d->entryPoint = node;
+        d->maxLevel   = level;
+    }
+
+    return true;
+}
+
+QMap<double, QVector<int> > HNSWIndex::getClosestNeighbors(const cv::Mat& position,
+                                                           float          sqRange,
+                                                           float          cosThreshold,
+                                                           int            maxNbNeighbors) const
+{
+    QMap<double, QVector<int> > neighborList;
+
+    if ((position.type() != CV_32F) || (int(position.total()) != d->dim) || (maxNbNeighbors <= 0))
+    {
+        return neighborList;
+    }
+
+    const cv::Mat embedding = position.isContinuous() ? position : position.clone();
+    const float* const pos  = embedding.ptr<float>();
+    double sqNorm           = 0.0;
+
+    for (int i = 0 ; i < d->dim ; ++i)
+    {
+        sqNorm += pos[i] * pos[i];
+    }
+
+    QReadLocker lock(&d->lock);
+
+    if (d->entryPoint == -1)
+    {
+        return neighborList;
+    }
+
+    const int entry                             = d->greedySearch(pos, d->entryPoint, d->maxLevel, 0);
+    const std::vector<HNSWCandidate> candidates = d->searchLayer(pos, entry, qMax(d->efSearch, maxNbNeighbors), 0);
+    int count                                   = 0;
+
+    for (const HNSWCandidate& candidate : candidates)
+    {
+        if (candidate.first >= sqRange)
+        {
+            break;
+        }
+
+        // Same cosine distance than KDNode::cosDistance(), with the scalar product
+        // computed from the squared distance and the squared norms.
+
+        const double nodeSqNorm    = d->sqNorms.at(candidate.second);
+        const double scalarProduct = (sqNorm + nodeSqNorm - candidate.first) / 2.0;
+
+        if ((scalarProduct / (sqNorm * nodeSqNorm)) <= cosThreshold)
+        {
+            continue;
+        }
+
+        neighborList[candidate.first].append(d->identities.at(candidate.second));
+
+        if (++count >= maxNbNeighbors)
+        {
+            break;
+        }
+    }
+
+    return neighborList;
+}
+
+bool HNSWIndex::save(const QString& filePath)
+{
+    QWriteLocker lock(&d->lock);
+
+    QSaveFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot write the face index snapshot" << filePath;
+
+        return false;
+    }
+
+    // The arrays are written in the native byte order, a snapshot from another architecture is rejected.
+
+    QDataStream stream(&file);
+    stream << s_snapshotMagic
+           << s_snapshotVersion
+           << qint32(QSysInfo::ByteOrder)
+           << qint32(d->dim)
+           << qint32(d->M)
+           << qint32(d->identities.size())
+           << qint32(d->entryPoint)
+           << qint32(d->maxLevel)
+           << qint32(d->lastNodeId);
+
+    bool ok = (hnswWriteArray(stream, d->vectors)    &&
+               hnswWriteArray(stream, d->sqNorms)    &&
+               hnswWriteArray(stream, d->identities) &&
+               hnswWriteArray(stream, d->nodeIds)    &&
+               hnswWriteArray(stream, d->levels)     &&
+               hnswWriteArray(stream, d->baseLinks));
+
+    for (int i = 0 ; ok && (i < d->upperLinks.size()) ; ++i)
+    {
+        ok = hnswWriteArray(stream, d->upperLinks.at(i));
+    }
+
+    if (!ok || !file.commit())
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot write the face index snapshot" << filePath;
+
+        return false;
+    }
+
+    d->modified = false;
+
+    return true;
+}
+
+bool HNSWIndex::load(const QString& filePath)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QWriteLocker lock(&d->lock);
+
+    d->reset();
+
+    QDataStream stream(&file);
+    quint32 magic   = 0;
+    quint32 version = 0;
+    qint32  order   = 0;
+    qint32  dim     = 0;
+    qint32  M       = 0;
+    qint32  count   = 0;
+    qint32  entry   = 0;
+    qint32  level   = 0;
+    qint32  lastId  = 0;
+
+    stream >> magic >> version >> order >> dim >> M >> count >> entry >> level >> lastId;
+
+    // The size of the file bounds the count of nodes, before allocating the arrays.
+
+    if (
+        (stream.status() != QDataStream::Ok) ||
+        (magic != s_snapshotMagic)           ||
+        (version != s_snapshotVersion)       ||
+        (order != qint32(QSysInfo::ByteOrder)) ||
+        (dim != d->dim) || (M != d->M)       ||
+        (count < 0)     || (qint64(count) * dim * qint64(sizeof(float)) > file.size()) ||
+        (entry >= count)
+       )
+    {
+        qCDebug(DIGIKAM_FACEDB_LOG) << "Face index snapshot is not compatible" << filePath;
+
+        return false;
+    }
+
+    bool ok = (hnswReadArray(stream, d->vectors,    count * dim)           &&
+               hnswReadArray(stream, d->sqNorms,    count)                 &&
+               hnswReadArray(stream, d->identities, count)                 &&
+               hnswReadArray(stream, d->nodeIds,    count)                 &&
+               hnswReadArray(stream, d->levels,     count)                 &&
+               hnswReadArray(stream, d->baseLinks,  count * (2 * d->M + 1)));
+
+    d->upperLinks.resize(ok ? count : 0);
+
+    for (int i = 0 ; ok && (i < count) ; ++i)
+    {
+        ok = ((d->levels.at(i) >= 0) && (d->levels.at(i) <= level) &&
+              hnswReadArray(stream, d->upperLinks[i], d->levels.at(i) * (d->M + 1)));
+    }
+
+    if (!ok)
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Face index snapshot is corrupted" << filePath;
+
+        d->reset();
+
+        return false;
+    }
+
+    d->entryPoint = entry;
+    d->maxLevel   = level;
+    d->lastNodeId = lastId;
+    d->modified   = false;
+
+    // Do not draw again the same levels than the nodes already in the index.
+
+    d->generator.seed(std::mt19937::default_seed + count);
+
+    return true;
+}
+
+} // namespace Digikam
@@ -0,0 +1,108 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam
+ *
+ * Date        : 2026-10-17
+ * Description : Memory-resident approximate nearest neighbors index of face embeddings
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+// Local includes
+
+#include "digikam_opencv.h"
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * Hierarchical Navigable Small World graph (HNSW) over the face embeddings.
+ * The vectors are stored in one contiguous float array and compared with
+ * squared Euclidean distances, computed with AVX2 when the CPU supports it.
+ * A search visits O(log(n)) nodes instead of the whole collection, and returns
+ * the same neighbors than KDTree for almost all queries.
+ *
+ * The index is thread-safe: searches run in parallel, insertions are exclusive.
+ */
+class DIGIKAM_GUI_EXPORT HNSWIndex
+{
+
+public:
+
+    /**
+     * @param dim            : dimension of the face embeddings
+     * @param M              : number of links per node on the upper layers, 2 * M on the base layer
+     * @param efConstruction : size of the candidates list while inserting a node
+     */
+    explicit HNSWIndex(int dim = 128, int M = 16, int efConstruction = 200);
+    ~HNSWIndex();
+
+    int  dimension()                                                    const;
+    int  size()                                                         const;
+    void clear();
+
+    /**
+     * Size of the candidates list while searching, higher is slower with a better recall.
+     */
+    void setSearchSize(int ef);
+
+    /**
+     * @brief add new face vector to the index
+     * @param position : K-dimension vector
+     * @param identity : identity of this face vector
+     * @param nodeId   : id of the face vector in the FaceMatrices table
+     * @return true if the vector is added
+     */
+    bool add(const cv::Mat& position, int identity, int nodeId);
+
+    /**
+     * @return Map of N-nearest neighbors, sorted by distance, with the same
+     * filters than KDTree::getClosestNeighbors().
+     */
+    QMap<double, QVector<int> > getClosestNeighbors(const cv::Mat& position,
+                                                    float          sqRange,
+                                                    float          cosThreshold,
+                                                    int            maxNbNeighbors) const;
+
+    /**
+     * Return the highest FaceMatrices id in the index, to update a loaded snapshot
+     * with the vectors added to the database after it was saved.
+     */
+    int  lastNodeId()                                                   const;
+
+    /**
+     * Return true if the index changed since it was built or loaded.
+     */
+    bool isModified()                                                   const;
+
+    /**
+     * Save and load a binary snapshot of the index, to not rebuild the graph at each start.
+     */
+    bool save(const QString& filePath);
+    bool load(const QString& filePath);
+
+private:
+
+    // Disable
+    HNSWIndex(const HNSWIndex&)            = delete;
+    HNSWIndex& operator=(const HNSWIndex&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+};
+
+} // namespace Digikam
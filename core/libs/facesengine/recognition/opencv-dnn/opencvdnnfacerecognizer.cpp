@@ -74,7 +74,9 @@ void OpenCVDNNFaceRecognizer::train(const QList<QImage*>& images,
                                     const int             label,
                                     const QString&        context)
 {
-    cv::parallel_for_(cv::Range(0, images.size()), Private::ParallelTrainer(d, images, label, context));
+    const std::vector<cv::Mat> embeddings = d->faceEmbeddings(images);
+
+    cv::parallel_for_(cv::Range(0, images.size()), Private::ParallelTrainer(d, embeddings, label, context));
 
     d->newDataAdded = true;
 }
@@ -85,6 +87,11 @@ int OpenCVDNNFaceRecognizer::recognize(QImage* inputImage)
 
     cv::Mat faceEmbedding = d->extractors[0]->getFaceEmbedding(prepareForRecognition(*inputImage));
 
+    if (faceEmbedding.empty())
+    {
+        return id;
+    }
+
     switch (d->method)
     {
         case SVM:
@@ -111,6 +118,12 @@ int OpenCVDNNFaceRecognizer::recognize(QImage* inputImage)
             break;
         }
 
+        case HNSW:
+        {
+            id = d->predictIndex(faceEmbedding);
+            break;
+        }
+
         default:
         {
             qCWarning(DIGIKAM_FACEDB_LOG) << "Not recognized classifying method";
@@ -124,7 +137,9 @@ QVector<int> OpenCVDNNFaceRecognizer::recognize(const QList<QImage*>& inputImage
 {
     QVector<int> ids;
 
-    cv::parallel_for_(cv::Range(0, inputImages.size()), Private::ParallelRecognizer(d, inputImages, ids));
+    const std::vector<cv::Mat> embeddings = d->faceEmbeddings(inputImages);
+
+    cv::parallel_for_(cv::Range(0, inputImages.size()), Private::ParallelRecognizer(d, embeddings, ids));
 
     return ids;
 }
@@ -140,6 +155,14 @@ void OpenCVDNNFaceRecognizer::clearTraining(const QList<int>& idsToClear, const
     {
         FaceDbAccess().db()->clearDNNTraining(idsToClear, trainingContext);
     }
+
+    if (d->index)
+    {
+        // The vectors cannot be removed from the graph: build it again from the database.
+
+        delete d->index;
+        d->index = FaceDbAccess().db()->reconstructIndex();
+    }
 /*
     FaceDbAccess().db()->clearTreeDb();
 */
@@ -160,6 +183,15 @@ bool OpenCVDNNFaceRecognizer::registerTrainingData(const cv::Mat& preprocessedIm
             return false;
         }
     }
+    else if (d->method == HNSW)
+    {
+        if (!d->index->add(faceEmbedding, label, 0))
+        {
+            qCWarning(DIGIKAM_FACEDB_LOG) << "Error insert new node";
+
+            return false;
+        }
+    }
 
     return true;
 }
@@ -168,10 +200,14 @@ int OpenCVDNNFaceRecognizer::verifyTestData(const cv::Mat& preprocessedImage)
 {
     int id = -1;
 
-    if (d->method == Tree)
+    if      (d->method == Tree)
     {
         id = d->predictKDTree(d->extractors[0]->getFaceEmbedding(preprocessedImage));
     }
+    else if (d->method == HNSW)
+    {
+        id = d->predictIndex(d->extractors[0]->getFaceEmbedding(preprocessedImage));
+    }
 
     return id;
 }
@@ -38,6 +38,7 @@ public:
         OpenCV_KNN,
         Tree,
         DB,
+        HNSW,       ///< In-memory approximate nearest neighbors graph, see HNSWIndex.
     };
 
     /**
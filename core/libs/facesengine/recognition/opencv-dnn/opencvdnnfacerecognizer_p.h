@@ -32,6 +32,7 @@
 #include "facedbaccess.h"
 #include "facedb.h"
 #include "kd_tree.h"
+#include "hnsw_index.h"
 
 namespace Digikam
 {
@@ -76,6 +77,12 @@ public:
                 break;
             }
 
+            case HNSW:
+            {
+                index = FaceDbAccess().db()->reconstructIndex();
+                break;
+            }
+
             default:
             {
                 qFatal("Invalid classifier");
@@ -94,6 +101,16 @@ public:
         }
 
         delete tree;
+
+        if (index)
+        {
+            if (index->isModified())
+            {
+                index->save(FaceDb::indexSnapshotPath());
+            }
+
+            delete index;
+        }
     }
 
 public:
@@ -106,9 +123,20 @@ public:
 
     int predictKDTree(const cv::Mat& faceEmbedding) const;
     int predictDb(const cv::Mat& faceEmbedding) const;
+    int predictIndex(const cv::Mat& faceEmbedding) const;
+
+    /**
+     * Return the identity with the best score among the closest neighbors, or -1.
+     */
+    int vote(const QMap<double, QVector<int> >& closestNeighbors) const;
 
     bool insertData(const cv::Mat& position, const int label, const QString& context = QString());
 
+    /**
+     * Return the embeddings of the faces, computed in batches by the neural network.
+     */
+    std::vector<cv::Mat> faceEmbeddings(const QList<QImage*>& images);
+
 public:
 
     Classifier                 method;
@@ -118,6 +146,7 @@ public:
     cv::Ptr<cv::ml::KNearest>  knn;
 
     KDTree*                    tree         = nullptr;
+    HNSWIndex*                 index        = nullptr;
     int                        kNeighbors   = 5;
     float                      threshold    = 0.4F;
 
@@ -134,22 +163,28 @@ class OpenCVDNNFaceRecognizer::Private::ParallelRecognizer : public cv::Parallel
 public:
 
     ParallelRecognizer(OpenCVDNNFaceRecognizer::Private* d,
-                       const QList<QImage*>& images,
+                       const std::vector<cv::Mat>& embeddings,
                        QVector<int>& ids)
-        : images    (images),
+        : embeddings(embeddings),
           ids       (ids),
           d         (d)
     {
-        ids.resize(images.size());
+        ids.resize(int(embeddings.size()));
     }
 
     void operator()(const cv::Range& range) const override
     {
         for(int i = range.start ; i < range.end ; ++i)
         {
-            int id = -1;
+            int id                       = -1;
+            const cv::Mat& faceEmbedding = embeddings[i];
 
-            cv::Mat faceEmbedding = d->extractors[i%(d->extractors.size())]->getFaceEmbedding(OpenCVDNNFaceRecognizer::prepareForRecognition(*images[i]));
+            if (faceEmbedding.empty())
+            {
+                ids[i] = id;
+
+                continue;
+            }
 
             switch (d->method)
             {
@@ -177,6 +212,12 @@ public:
                     break;
                 }
 
+                case HNSW:
+                {
+                    id = d->predictIndex(faceEmbedding);
+                    break;
+                }
+
                 default:
                 {
                     qCWarning(DIGIKAM_FACEDB_LOG) << "Not recognized classifying method";
@@ -189,7 +230,7 @@ public:
 
 private:
 
-    const QList<QImage*>&                   images;
+    const std::vector<cv::Mat>&             embeddings;
     QVector<int>&                           ids;
 
     OpenCVDNNFaceRecognizer::Private* const d = nullptr;
@@ -204,10 +245,10 @@ class OpenCVDNNFaceRecognizer::Private::ParallelTrainer: public cv::ParallelLoop
 public:
 
     ParallelTrainer(OpenCVDNNFaceRecognizer::Private* d,
-                    const QList<QImage*>& images,
+                    const std::vector<cv::Mat>& embeddings,
                     const int& id,
                     const QString& context)
-        : images    (images),
+        : embeddings(embeddings),
           id        (id),
           context   (context),
           d         (d)
@@ -218,10 +259,7 @@ public:
     {
         for(int i = range.start ; i < range.end ; ++i)
         {
-            cv::Mat faceEmbedding = d->extractors[i%(d->extractors.size())]->
-                getFaceEmbedding(OpenCVDNNFaceRecognizer::prepareForRecognition(*images[i]));
-
-            if (!d->insertData(faceEmbedding, id, context))
+            if (embeddings[i].empty() || !d->insertData(embeddings[i], id, context))
             {
                 qCWarning(DIGIKAM_FACEDB_LOG) << "Fail to register a face of identity" << id;
             }
@@ -230,7 +268,7 @@ public:
 
 private:
 
-    const QList<QImage*>&                   images;
+    const std::vector<cv::Mat>&             embeddings;
     const int&                              id;
     const QString&                          context;
 
@@ -307,61 +345,39 @@ int OpenCVDNNFaceRecognizer::Private::predictKDTree(const cv::Mat& faceEmbedding
 
     // Look for K-nearest neighbor which have the cosine distance greater than the threshold.
 
-    QMap<double, QVector<int> > closestNeighbors = tree->getClosestNeighbors(faceEmbedding, threshold, 0.8, kNeighbors);
-
-    QMap<int, QVector<double> > votingGroups;
-
-    for (QMap<double, QVector<int> >::const_iterator iter  = closestNeighbors.cbegin();
-                                                     iter != closestNeighbors.cend();
-                                                     ++iter)
-    {
-        for (QVector<int>::const_iterator node  = iter.value().cbegin();
-                                          node != iter.value().cend();
-                                          ++node)
-        {
-            int label = (*node);
-
-            votingGroups[label].append(iter.key());
-        }
-    }
+    return vote(tree->getClosestNeighbors(faceEmbedding, threshold, 0.8, kNeighbors));
+}
 
-    double maxScore = 0.0;
-    int prediction  = -1;
+int OpenCVDNNFaceRecognizer::Private::predictDb(const cv::Mat& faceEmbedding) const
+{
+    return vote(FaceDbAccess().db()->getClosestNeighborsTreeDb(faceEmbedding, threshold, 0.8, kNeighbors));
+}
 
-    for (QMap<int, QVector<double> >::const_iterator group  = votingGroups.cbegin();
-                                                     group != votingGroups.cend();
-                                                     ++group)
+int OpenCVDNNFaceRecognizer::Private::predictIndex(const cv::Mat& faceEmbedding) const
+{
+    if (!index)
     {
-        double score = 0.0;
-
-        for (int i = 0 ; i < group.value().size() ; ++i)
-        {
-            score += (threshold - group.value()[i]);
-        }
-
-        if (score > maxScore)
-        {
-            maxScore   = score;
-            prediction = group.key();
-        }
+        return -1;
     }
 
-    return prediction;
+    return vote(index->getClosestNeighbors(faceEmbedding, threshold, 0.8, kNeighbors));
 }
 
-int OpenCVDNNFaceRecognizer::Private::predictDb(const cv::Mat& faceEmbedding) const
+int OpenCVDNNFaceRecognizer::Private::vote(const QMap<double, QVector<int> >& closestNeighbors) const
 {
-    QMap<double, QVector<int> > closestNeighbors = FaceDbAccess().db()->getClosestNeighborsTreeDb(faceEmbedding, threshold, 0.8, kNeighbors);
-
     QMap<int, QVector<double> > votingGroups;
 
     for (QMap<double, QVector<int> >::const_iterator iter  = closestNeighbors.cbegin();
                                                      iter != closestNeighbors.cend();
                                                      ++iter)
     {
-        for (int i = 0 ; i < iter.value().size() ; ++i)
+        for (QVector<int>::const_iterator node  = iter.value().cbegin();
+                                          node != iter.value().cend();
+                                          ++node)
         {
-            votingGroups[iter.value()[i]].append(iter.key());
+            int label = (*node);
+
+            votingGroups[label].append(iter.key());
         }
     }
 
@@ -422,8 +438,33 @@ bool OpenCVDNNFaceRecognizer::Private::insertData(const cv::Mat& nodePos, const
             return false;
         }
     }
+    else if (method == HNSW)
+    {
+        if (!index->add(nodePos, label, nodeId))
+        {
+            qCWarning(DIGIKAM_FACEDB_LOG) << "Error insert new node" << nodeId;
+
+            return false;
+        }
+    }
 
     return true;
 }
 
+std::vector<cv::Mat> OpenCVDNNFaceRecognizer::Private::faceEmbeddings(const QList<QImage*>& images)
+{
+    std::vector<cv::Mat> faces(images.size());
+
+    cv::parallel_for_(cv::Range(0, images.size()), [&](const cv::Range& range)
+        {
+            for (int i = range.start ; i < range.end ; ++i)
+            {
+                faces[i] = OpenCVDNNFaceRecognizer::prepareForRecognition(*images[i]);
+            }
+        }
+    );
+
+    return extractors[0]->getFaceEmbeddings(faces);
+}
+
 } // namespace Digikam
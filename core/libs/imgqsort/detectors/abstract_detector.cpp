@@ -32,6 +32,11 @@ AbstractDetector::AbstractDetector(QObject* const parent)
 {
 }
 
+float AbstractDetector::detectImage(const DetectionImage& image) const
+{
+    return detect(image.bgr);
+}
+
 /**
  * NOTE: Maybe this function will move to read_image() of imagequalityparser
  * in case all detectors of IQS use cv::Mat
@@ -72,6 +77,32 @@ cv::Mat AbstractDetector::prepareForDetection(const DImg& inputImage)
     return cv::Mat();
 }
 
+DetectionImage AbstractDetector::prepareImage(const cv::Mat& bgrImage)
+{
+    DetectionImage image;
+    image.bgr = bgrImage;
+
+    if (bgrImage.empty())
+    {
+        return image;
+    }
+
+    try
+    {
+        cv::cvtColor(bgrImage, image.gray, cv::COLOR_BGR2GRAY);
+    }
+    catch (cv::Exception& e)
+    {
+        qCCritical(DIGIKAM_FACESENGINE_LOG) << "cv::Exception:" << e.what();
+    }
+    catch (...)
+    {
+        qCCritical(DIGIKAM_FACESENGINE_LOG) << "Default exception from OpenCV";
+    }
+
+    return image;
+}
+
 } // namespace Digikam
 
 #include "moc_abstract_detector.cpp"
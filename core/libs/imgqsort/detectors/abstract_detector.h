@@ -27,6 +27,23 @@
 namespace Digikam
 {
 
+/**
+ * The image converted once for all detectors, and shared read-only between them.
+ */
+class DetectionImage
+{
+public:
+
+    DetectionImage() = default;
+
+public:
+
+    cv::Mat bgr;        ///< 8 bits BGR image
+    cv::Mat gray;       ///< 8 bits gray conversion of the BGR image
+};
+
+// -------------------------------------------------------------------------------------------
+
 class AbstractDetector : public QObject
 {
     Q_OBJECT
@@ -38,9 +55,20 @@ public:
 
     virtual float detect(const cv::Mat& image) const = 0;
 
+    /**
+     * Run the detection on the shared image. The default implementation uses the BGR image.
+     * The detectors working on the gray image re-implement it to skip their own conversion.
+     */
+    virtual float detectImage(const DetectionImage& image) const;
+
 public:
 
     static cv::Mat prepareForDetection(const DImg& inputImage);
+
+    /**
+     * Compute the conversions of the BGR image used by the detectors.
+     */
+    static DetectionImage prepareImage(const cv::Mat& bgrImage);
 };
 
 } // namespace Digikam
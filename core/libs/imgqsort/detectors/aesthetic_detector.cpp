@@ -23,6 +23,7 @@
 // Local includes
 
 #include "digikam_debug.h"
+#include "dnnbatchqueue.h"
 
 namespace Digikam
 {
@@ -30,6 +31,34 @@ namespace Digikam
 cv::dnn::Net AestheticDetector::s_model      = cv::dnn::Net();
 QMutex       AestheticDetector::s_modelMutex = QMutex();
 
+/**
+ * The images analyzed concurrently by the maintenance tasks are grouped
+ * in batches, to run the model once per batch.
+ */
+static DNNBatchQueue* aestheticBatchQueue()
+{
+    static DNNBatchQueue queue(&AestheticDetector::s_forward);
+
+    static const bool init = []()
+    {
+        if (qEnvironmentVariableIsSet("DIGIKAM_DNN_BATCH_SIZE"))
+        {
+            queue.setBatchSize(qEnvironmentVariableIntValue("DIGIKAM_DNN_BATCH_SIZE"));
+        }
+
+        if (qEnvironmentVariableIsSet("DIGIKAM_DNN_BATCH_LATENCY"))
+        {
+            queue.setMaxLatency(qEnvironmentVariableIntValue("DIGIKAM_DNN_BATCH_LATENCY"));
+        }
+
+        return true;
+    }();
+
+    Q_UNUSED(init);
+
+    return &queue;
+}
+
 AestheticDetector::AestheticDetector()
     : AbstractDetector()
 {
@@ -43,15 +72,17 @@ float AestheticDetector::detect(const cv::Mat& image) const
 {
     try
     {
-        QMutexLocker locker(&s_modelMutex);
-
         cv::Mat input = preprocess(image);
 
-        if (!s_model.empty())
+        if (input.empty())
         {
-            s_model.setInput(input);
-            cv::Mat out = s_model.forward();
+            return (-1.0F);
+        }
 
+        cv::Mat out   = aestheticBatchQueue()->process(input);
+
+        if (!out.empty())
+        {
             return postProcess(out);
         }
         else
@@ -79,10 +110,13 @@ cv::Mat AestheticDetector::preprocess(const cv::Mat& image) const
 {
     try
     {
-        cv::Mat img_rgb;
-        cv::cvtColor(image, img_rgb, cv::COLOR_BGR2RGB);
+        // Nearest pixel sampling selects the same pixels before and after the color conversion:
+        // reduce the image first to convert only the pixels used by the model.
+
+        cv::Mat img_bgr;
+        cv::resize(image, img_bgr, cv::Size(299, 299), 0, 0, cv::INTER_NEAREST_EXACT);
         cv::Mat cv_resized;
-        cv::resize(img_rgb, cv_resized, cv::Size(299, 299), 0, 0, cv::INTER_NEAREST_EXACT);
+        cv::cvtColor(img_bgr, cv_resized, cv::COLOR_BGR2RGB);
         cv_resized.convertTo(cv_resized, CV_32FC3);
         cv_resized   = cv_resized.mul(1.0F / 127.5F);
         subtract(cv_resized, cv::Scalar(1, 1, 1), cv_resized);
@@ -105,6 +139,45 @@ cv::Mat AestheticDetector::preprocess(const cv::Mat& image) const
     }
 }
 
+std::vector<cv::Mat> AestheticDetector::s_forward(const std::vector<cv::Mat>& inputs)
+{
+    std::vector<cv::Mat> outputs(inputs.size());
+
+    if (inputs.empty())
+    {
+        return outputs;
+    }
+
+    // Stack the blobs of one image in one blob of N images.
+
+    std::vector<int> sizes(inputs[0].size.p, inputs[0].size.p + inputs[0].dims);
+    sizes[0]              = int(inputs.size());
+    cv::Mat blob(int(sizes.size()), sizes.data(), CV_32F);
+    const size_t imgBytes = inputs[0].total() * inputs[0].elemSize();
+
+    for (size_t i = 0 ; i < inputs.size() ; ++i)
+    {
+        memcpy(blob.ptr<uchar>() + i * imgBytes, inputs[i].ptr<uchar>(), imgBytes);
+    }
+
+    QMutexLocker locker(&s_modelMutex);
+
+    if (s_model.empty())
+    {
+        return outputs;
+    }
+
+    s_model.setInput(blob);
+    cv::Mat out = s_model.forward();
+
+    for (int i = 0 ; (i < out.rows) && (i < int(outputs.size())) ; ++i)
+    {
+        outputs[i] = out.row(i).clone();
+    }
+
+    return outputs;
+}
+
 float AestheticDetector::postProcess(const cv::Mat& modelOutput) const
 {
     try
@@ -51,6 +51,11 @@ public:
     static void s_unloadModel();
     static bool s_isEmptyModel();
 
+    /**
+     * Run the model once for the inputs of a batch, and return one output per input.
+     */
+    static std::vector<cv::Mat> s_forward(const std::vector<cv::Mat>& inputs);
+
 private:
 
     static cv::dnn::Net s_model;
@@ -71,10 +71,15 @@ BlurDetector::~BlurDetector()
 }
 
 float BlurDetector::detect(const cv::Mat& image) const
+{
+    return detectImage(prepareImage(image));
+}
+
+float BlurDetector::detectImage(const DetectionImage& image) const
 {
     try
     {
-        cv::Mat edgesMap      = edgeDetection(image);
+        cv::Mat edgesMap      = edgeDetection(image.gray);
 
         cv::Mat defocusMap    = detectDefocusMap(edgesMap);
         defocusMap.convertTo(defocusMap, CV_8U);
@@ -82,7 +87,7 @@ float BlurDetector::detect(const cv::Mat& image) const
         cv::Mat motionBlurMap = detectMotionBlurMap(edgesMap);
         motionBlurMap.convertTo(motionBlurMap, CV_8U);
 
-        cv::Mat weightsMat    = getWeightMap(image);
+        cv::Mat weightsMat    = getWeightMap(image.bgr);
 
         cv::Mat blurMap       = defocusMap + motionBlurMap;
 
@@ -110,19 +115,14 @@ float BlurDetector::detect(const cv::Mat& image) const
     return 0.0F;
 }
 
-cv::Mat BlurDetector::edgeDetection(const cv::Mat& image) const
+cv::Mat BlurDetector::edgeDetection(const cv::Mat& grayImage) const
 {
     try
     {
-        // Convert the image to grayscale
-
-        cv::Mat image_gray;
-        cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
-
         // Use laplacian to detect edge map
 
         cv::Mat dst;
-        cv::Laplacian( image_gray, dst, CV_32F);
+        cv::Laplacian(grayImage, dst, CV_32F);
 
         return dst;
     }
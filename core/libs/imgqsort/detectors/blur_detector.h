@@ -32,10 +32,11 @@ public:
     ~BlurDetector();
 
     float detect(const cv::Mat& image)                          const override;
+    float detectImage(const DetectionImage& image)              const override;
 
 private:
 
-    cv::Mat edgeDetection(const cv::Mat& image)                 const;
+    cv::Mat edgeDetection(const cv::Mat& grayImage)             const;
     cv::Mat detectDefocusMap(const cv::Mat& edgesMap)           const;
     cv::Mat detectMotionBlurMap(const cv::Mat& edgesMap)        const;
     bool    isMotionBlur(const cv::Mat& frag)                   const;
@@ -72,21 +72,24 @@ auto accessCol = [](const cv::Mat& mat)
 };
 
 float CompressionDetector::detect(const cv::Mat& image) const
+{
+    return detectImage(prepareImage(image));
+}
+
+float CompressionDetector::detectImage(const DetectionImage& image) const
 {
     try
     {
-        cv::Mat gray_image;
-
-        cv::cvtColor(image, gray_image, cv::COLOR_BGR2GRAY);
+        const cv::Mat& gray_image = image.gray;
 
         cv::Mat verticalBlock    = checkEdgesBlock(gray_image, gray_image.cols, accessCol);
         cv::Mat horizontalBlock  = checkEdgesBlock(gray_image, gray_image.rows, accessRow);
-        cv::Mat mono_color_map   = detectMonoColorRegion(image);
+        cv::Mat mono_color_map   = detectMonoColorRegion(image.bgr);
         cv::Mat block_map        = mono_color_map.mul(verticalBlock + horizontalBlock);
 
         int nb_pixels_edge_block = cv::countNonZero(block_map);
         int nb_pixels_mono_color = cv::countNonZero(mono_color_map);
-        int nb_pixels_normal     = image.total() - nb_pixels_edge_block - nb_pixels_edge_block;
+        int nb_pixels_normal     = image.bgr.total() - nb_pixels_edge_block - nb_pixels_edge_block;
 
         float res                = static_cast<float>((nb_pixels_mono_color * d->weight_mono_color +
                                                        nb_pixels_edge_block * d->threshold_edges_block) /
@@ -66,6 +66,11 @@ float ExposureDetector::detect(const cv::Mat& image) const
     return std::max(overexposed, underexposed);
 }
 
+float ExposureDetector::detectImage(const DetectionImage& image) const
+{
+    return detect(image.gray);
+}
+
 float ExposureDetector::percent_overexposed(const cv::Mat& image) const
 {
     int over_exposed_pixel      = count_by_condition(image, d->threshold_overexposed, 255);
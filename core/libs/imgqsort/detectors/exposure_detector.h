@@ -32,6 +32,7 @@ public:
     ~ExposureDetector();
 
     float detect(const cv::Mat& image)                  const override;
+    float detectImage(const DetectionImage& image)      const override;
 
 private:
 
@@ -133,6 +133,11 @@ float NoiseDetector::detect(const cv::Mat& image) const
     return 1.0F;
 }
 
+float NoiseDetector::detectImage(const DetectionImage& image) const
+{
+    return detect(image.gray);
+}
+
 NoiseDetector::Mat3D NoiseDetector::decompose_by_filter(const cv::Mat& image, const Mat3D& filters) const
 {
     try
@@ -36,6 +36,7 @@ public:
     ~NoiseDetector();
 
     float detect(const cv::Mat& image)                                          const override;
+    float detectImage(const DetectionImage& image)                              const override;
 
 public:
 
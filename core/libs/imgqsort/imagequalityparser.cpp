@@ -64,10 +64,6 @@ void ImageQualityParser::startAnalyse()
 
     cv::Mat cvImage    = AbstractDetector::prepareForDetection(d->image);
 
-    cv::Mat grayImage;
-
-    cv::cvtColor(cvImage, grayImage, cv::COLOR_BGR2GRAY);
-
     //-----------------------------------------------------------------------------
 
     std::unique_ptr<BlurDetector>        blurDetector;
@@ -94,32 +90,36 @@ void ImageQualityParser::startAnalyse()
         }
         else
         {
+            // Convert the image once, the detectors share the conversions.
+
+            DetectionImage image = AbstractDetector::prepareImage(cvImage);
+
             if (d->imq.detectBlur)
             {
                 blurDetector = std::unique_ptr<BlurDetector>(new BlurDetector(d->image));
 
-                pool.addDetector(cvImage, d->imq.blurWeight, blurDetector.get());
+                pool.addDetector(image, d->imq.blurWeight, blurDetector.get());
             }
 
             if (d->imq.detectNoise)
             {
                 noiseDetector = std::unique_ptr<NoiseDetector>(new NoiseDetector());
 
-                pool.addDetector(grayImage, d->imq.noiseWeight, noiseDetector.get());
+                pool.addDetector(image, d->imq.noiseWeight, noiseDetector.get());
             }
 
             if (d->imq.detectCompression)
             {
                 compressionDetector = std::unique_ptr<CompressionDetector>(new CompressionDetector());
 
-                pool.addDetector(cvImage, d->imq.compressionWeight, compressionDetector.get());
+                pool.addDetector(image, d->imq.compressionWeight, compressionDetector.get());
             }
 
             if (d->imq.detectExposure)
             {
                 exposureDetector = std::unique_ptr<ExposureDetector>(new ExposureDetector());
 
-                pool.addDetector(grayImage, d->imq.exposureWeight, exposureDetector.get());
+                pool.addDetector(image, d->imq.exposureWeight, exposureDetector.get());
             }
 
             pool.start();
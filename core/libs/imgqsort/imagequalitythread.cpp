@@ -20,7 +20,7 @@ namespace Digikam
 
 ImageQualityThread::ImageQualityThread(QObject* const parent,
                                        AbstractDetector* const detector,
-                                       const cv::Mat& image,
+                                       const DetectionImage& image,
                                        ImageQualityCalculator* const calculator,
                                        float weight_quality)
     : QThread     (parent),
@@ -33,7 +33,7 @@ ImageQualityThread::ImageQualityThread(QObject* const parent,
 
 void ImageQualityThread::run()
 {
-    float damageLevel = m_detector->detect(m_image);
+    float damageLevel = m_detector->detectImage(m_image);
     m_calculator->addDetectionResult(QString(), damageLevel, m_weight);
 }
 
@@ -58,7 +58,7 @@ ImageQualityThreadPool::~ImageQualityThreadPool()
 }
 
 
-void ImageQualityThreadPool::addDetector(const cv::Mat& image,
+void ImageQualityThreadPool::addDetector(const DetectionImage& image,
                                          float weight_quality,
                                          AbstractDetector* const detector)
 {
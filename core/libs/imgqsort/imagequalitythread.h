@@ -37,7 +37,7 @@ public:
 
     explicit ImageQualityThread(QObject* const parent,
                                 AbstractDetector* const detector,
-                                const cv::Mat& image,
+                                const DetectionImage& image,
                                 ImageQualityCalculator* const calculator,
                                 float weight_quality);
     ~ImageQualityThread() = default;
@@ -48,9 +48,9 @@ public:
 
 private:
 
-    AbstractDetector*     m_detector;
+    AbstractDetector*       m_detector;
     ImageQualityCalculator* m_calculator;
-    cv::Mat                 m_image;
+    DetectionImage          m_image;
     float                   m_weight;
 };
 
@@ -68,7 +68,7 @@ public:
 
 public:
 
-    void addDetector(const cv::Mat& image,
+    void addDetector(const DetectionImage& image,
                      float weight_quality,
                      AbstractDetector* const detector);
 
@@ -16,6 +16,10 @@
 
 #include "drawdecoder_p.h"
 
+// Local includes
+
+#include "drawdecodersession_p.h"
+
 namespace Digikam
 {
 
@@ -331,6 +335,15 @@ bool DRawDecoder::rawFileIdentify(DRawInfo& identify, const QString& path)
         return false;
     }
 
+    // The file is identified only once while a session is alive.
+
+    QSharedPointer<DRawDecoderSession::Private> session = DRawDecoderSession::Private::find(path);
+
+    if (session && session->identifyInfo(identify))
+    {
+        return true;
+    }
+
     LibRaw* const raw = new LibRaw;
 
 #ifdef Q_OS_WIN
@@ -367,6 +380,11 @@ bool DRawDecoder::rawFileIdentify(DRawInfo& identify, const QString& path)
     raw->recycle();
     delete raw;
 
+    if (session)
+    {
+        session->setIdentifyInfo(identify);
+    }
+
     return true;
 }
 
@@ -18,6 +18,8 @@
 
 #include <QString>
 #include <QScopedPointer>
+#include <QElapsedTimer>
+#include <QMutexLocker>
 
 // DNG SDK includes
 
@@ -28,6 +30,7 @@
 // Local includes
 
 #include "metaengine.h"
+#include "drawdecodersession_p.h"
 
 namespace Digikam
 {
@@ -239,6 +242,16 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
                                           int& width, int& height, int& rgbmax)
 {
     m_parent->m_cancel       = false;
+
+    // Process again the data unpacked in memory if a session is alive for this file.
+
+    QSharedPointer<DRawDecoderSession::Private> session = DRawDecoderSession::Private::find(filePath);
+
+    if (session)
+    {
+        return loadFromSession(session.data(), imageData, width, height, rgbmax);
+    }
+
     LibRaw* const raw        = new LibRaw;
 
     // Set progress call back function.
@@ -246,9 +259,204 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
     raw->set_progress_handler(s_progressCallbackForLibRaw, this);
     raw->set_exifparser_handler(s_exifParserCallbackForLibRaw, this);
 
-    QByteArray deadpixelPath = QFile::encodeName(m_parent->m_decoderSettings.deadPixelMap);
-    QByteArray cameraProfile = QFile::encodeName(m_parent->m_decoderSettings.inputProfile);
-    QByteArray outputProfile = QFile::encodeName(m_parent->m_decoderSettings.outputProfile);
+    setupDecoding(raw, filePath);
+
+#ifdef USE_DNGSDK
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: setup internal DNG SDK";
+
+    raw->imgdata.rawparams.use_dngsdk = LIBRAW_DNG_ALL;
+    dng_host* const dnghost           = new dng_host;
+    raw->set_dng_host(dnghost);
+
+#endif
+
+    //-------------------------------------------------------------------------------------------
+
+    setProgress(0.1);
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << filePath;
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << m_parent->m_decoderSettings;
+
+#ifdef Q_OS_WIN
+
+    int ret = raw->open_file((const wchar_t*)filePath.utf16());
+
+#else
+
+    int ret = raw->open_file(filePath.toUtf8().constData());
+
+#endif
+
+    if (ret != LIBRAW_SUCCESS)
+    {
+        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run open_file: " << libraw_strerror(ret);
+        raw->recycle();
+        delete raw;
+
+#ifdef USE_DNGSDK
+
+        delete dnghost;
+
+#endif
+
+        return false;
+    }
+
+    if (m_parent->m_cancel)
+    {
+        raw->recycle();
+        delete raw;
+
+#ifdef USE_DNGSDK
+
+        delete dnghost;
+
+#endif
+
+        return false;
+    }
+
+    setProgress(0.2);
+
+    ret = raw->unpack();
+
+    if (ret != LIBRAW_SUCCESS)
+    {
+        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run unpack: " << libraw_strerror(ret);
+        raw->recycle();
+        delete raw;
+
+#ifdef USE_DNGSDK
+
+        delete dnghost;
+
+#endif
+
+        return false;
+    }
+
+    if (m_parent->m_cancel)
+    {
+        raw->recycle();
+        delete raw;
+
+#ifdef USE_DNGSDK
+
+        delete dnghost;
+
+#endif
+
+        return false;
+    }
+
+    setProgress(0.25);
+
+    bool processed = processImage(raw, imageData, width, height, rgbmax);
+
+    raw->recycle();
+    delete raw;
+
+#ifdef USE_DNGSDK
+
+    delete dnghost;
+
+#endif
+
+    if (!processed || m_parent->m_cancel)
+    {
+        return false;
+    }
+
+    setProgress(0.4);
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: data info: width=" << width
+                                   << " height=" << height
+                                   << " rgbmax=" << rgbmax;
+
+    return true;
+}
+
+bool DRawDecoder::Private::loadFromSession(DRawDecoderSession::Private* const session, QByteArray& imageData,
+                                           int& width, int& height, int& rgbmax)
+{
+    QMutexLocker lock(&session->mutex);
+
+    if (!session->lastImage.isNull() && (session->lastSettings == m_parent->m_decoderSettings))
+    {
+        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: reuse the last image processed with the same settings";
+
+        imageData = session->lastImage;
+        width     = session->lastWidth;
+        height    = session->lastHeight;
+        rgbmax    = session->lastRgbmax;
+        setProgress(0.4);
+
+        return true;
+    }
+
+    LibRaw* const raw = session->raw;
+
+    // The progress call back is reset at the end, as this container can be deleted before the next decoding.
+
+    raw->set_progress_handler(s_progressCallbackForLibRaw, this);
+    raw->set_exifparser_handler(s_exifParserCallbackForLibRaw, this);
+
+    setProgress(0.1);
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << session->filePath << "(RAW session)";
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << m_parent->m_decoderSettings;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool processed = false;
+
+    if (session->unpack() && !m_parent->m_cancel)
+    {
+        setProgress(0.25);
+
+        // The processing parameters of the previous decoding are not kept.
+
+        session->resetParameters();
+        setupDecoding(raw, session->filePath);
+
+        processed = processImage(raw, imageData, width, height, rgbmax);
+
+        // Only the unpacked data are kept, the processing buffer is rebuilt from them by the next decoding.
+
+        raw->free_image();
+    }
+
+    raw->set_progress_handler(nullptr, nullptr);
+    raw->set_exifparser_handler(nullptr, nullptr);
+
+    if (!processed || m_parent->m_cancel)
+    {
+        return false;
+    }
+
+    session->lastSettings = m_parent->m_decoderSettings;
+    session->lastImage    = imageData;
+    session->lastWidth    = width;
+    session->lastHeight   = height;
+    session->lastRgbmax   = rgbmax;
+
+    setProgress(0.4);
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: data info: width=" << width
+                                   << " height=" << height
+                                   << " rgbmax=" << rgbmax
+                                   << " processed in" << timer.elapsed() << "ms";
+
+    return true;
+}
+
+void DRawDecoder::Private::setupDecoding(LibRaw* const raw, const QString& filePath)
+{
+    m_deadPixelPath = QFile::encodeName(m_parent->m_decoderSettings.deadPixelMap);
+    m_cameraProfile = QFile::encodeName(m_parent->m_decoderSettings.inputProfile);
+    m_outputProfile = QFile::encodeName(m_parent->m_decoderSettings.outputProfile);
 
     if (!m_parent->m_decoderSettings.autoBrightness)
     {
@@ -321,7 +529,7 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
     {
         // (-P) Read the dead pixel list from this file.
 
-        raw->imgdata.params.bad_pixels = deadpixelPath.data();
+        raw->imgdata.params.bad_pixels = m_deadPixelPath.data();
     }
 
     switch (m_parent->m_decoderSettings.whiteBalance)
@@ -499,7 +707,7 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
             {
                 // (-p) Use input profile file to define the camera's raw colorspace.
 
-                raw->imgdata.params.camera_profile = cameraProfile.data();
+                raw->imgdata.params.camera_profile = m_cameraProfile.data();
             }
 
             break;
@@ -521,7 +729,7 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
             {
                 // (-o) Use ICC profile file to define the output colorspace.
 
-                raw->imgdata.params.output_profile = outputProfile.data();
+                raw->imgdata.params.output_profile = m_outputProfile.data();
             }
 
             break;
@@ -540,98 +748,11 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
 
     raw->imgdata.params.dcb_iterations = m_parent->m_decoderSettings.dcbIterations;
     raw->imgdata.params.dcb_enhance_fl = m_parent->m_decoderSettings.dcbEnhanceFl;
+}
 
-#ifdef USE_DNGSDK
-
-    qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: setup internal DNG SDK";
-
-    raw->imgdata.rawparams.use_dngsdk = LIBRAW_DNG_ALL;
-    dng_host* const dnghost           = new dng_host;
-    raw->set_dng_host(dnghost);
-
-#endif
-
-    //-------------------------------------------------------------------------------------------
-
-    setProgress(0.1);
-
-    qCDebug(DIGIKAM_RAWENGINE_LOG) << filePath;
-    qCDebug(DIGIKAM_RAWENGINE_LOG) << m_parent->m_decoderSettings;
-
-#ifdef Q_OS_WIN
-
-    int ret = raw->open_file((const wchar_t*)filePath.utf16());
-
-#else
-
-    int ret = raw->open_file(filePath.toUtf8().constData());
-
-#endif
-
-    if (ret != LIBRAW_SUCCESS)
-    {
-        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run open_file: " << libraw_strerror(ret);
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
-
-        return false;
-    }
-
-    if (m_parent->m_cancel)
-    {
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
-
-        return false;
-    }
-
-    setProgress(0.2);
-
-    ret = raw->unpack();
-
-    if (ret != LIBRAW_SUCCESS)
-    {
-        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run unpack: " << libraw_strerror(ret);
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
-
-        return false;
-    }
-
-    if (m_parent->m_cancel)
-    {
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
-
-        return false;
-    }
-
-    setProgress(0.25);
-
+bool DRawDecoder::Private::processImage(LibRaw* const raw, QByteArray& imageData,
+                                        int& width, int& height, int& rgbmax)
+{
     if (m_parent->m_decoderSettings.fixColorsHighlights)
     {
         qCDebug(DIGIKAM_RAWENGINE_LOG) << "Applying LibRaw highlights adjustments";
@@ -649,34 +770,17 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
         raw->imgdata.params.adjust_maximum_thr = 0.0;
     }
 
-    ret = raw->dcraw_process();
+    int ret = raw->dcraw_process();
 
     if (ret != LIBRAW_SUCCESS)
     {
         qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run dcraw_process: " << libraw_strerror(ret);
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
 
         return false;
     }
 
     if (m_parent->m_cancel)
     {
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
-
         return false;
     }
 
@@ -687,14 +791,6 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
     if (!img)
     {
         qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run dcraw_make_mem_image: " << libraw_strerror(ret);
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
 
         return false;
     }
@@ -704,14 +800,6 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
         // Clear memory allocation. Introduced with LibRaw 0.11.0
 
         raw->dcraw_clear_mem(img);
-        raw->recycle();
-        delete raw;
-
-#ifdef USE_DNGSDK
-
-        delete dnghost;
-
-#endif
 
         return false;
     }
@@ -744,25 +832,6 @@ bool DRawDecoder::Private::loadFromLibraw(const QString& filePath, QByteArray& i
     // Clear memory allocation. Introduced with LibRaw 0.11.0
 
     raw->dcraw_clear_mem(img);
-    raw->recycle();
-    delete raw;
-
-#ifdef USE_DNGSDK
-
-    delete dnghost;
-
-#endif
-
-    if (m_parent->m_cancel)
-    {
-        return false;
-    }
-
-    setProgress(0.4);
-
-    qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: data info: width=" << width
-                                   << " height=" << height
-                                   << " rgbmax=" << rgbmax;
 
     return true;
 }
@@ -30,6 +30,7 @@
 #include "digikam_debug.h"
 #include "drawinfo.h"
 #include "drawdecoder.h"
+#include "drawdecodersession.h"
 #include "drawfiles.h"
 
 // LibRaw includes
@@ -93,6 +94,23 @@ public:
     bool   loadFromLibraw(const QString& filePath, QByteArray& imageData,
                           int& width, int& height, int& rgbmax);
 
+    /**
+     * Decode the file from the data unpacked in memory by the session.
+     */
+    bool   loadFromSession(DRawDecoderSession::Private* const session, QByteArray& imageData,
+                           int& width, int& height, int& rgbmax);
+
+    /**
+     * Set the LibRaw processing parameters from the decoder settings.
+     */
+    void   setupDecoding(LibRaw* const raw, const QString& filePath);
+
+    /**
+     * Run the processing stages after the unpacking, and extract the image data.
+     */
+    bool   processImage(LibRaw* const raw, QByteArray& imageData,
+                        int& width, int& height, int& rgbmax);
+
 public:
 
     static void createPPMHeader(QByteArray& imgData, libraw_processed_image_t* const img);
@@ -109,6 +127,13 @@ private:
 
     DRawDecoder* m_parent   = nullptr;
 
+    /**
+     * The paths passed to LibRaw with the processing parameters.
+     */
+    QByteArray   m_deadPixelPath;
+    QByteArray   m_cameraProfile;
+    QByteArray   m_outputProfile;
+
     friend class DRawDecoder;
 };
 
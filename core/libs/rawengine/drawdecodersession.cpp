@@ -0,0 +1,192 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a session keeping the unpacked data of a RAW file
+ *               to process it again with other decoding settings.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "drawdecodersession_p.h"
+
+// Qt includes
+
+#include <QHash>
+#include <QMutexLocker>
+#include <QWeakPointer>
+
+// DNG SDK includes
+
+#ifdef USE_DNGSDK
+#   include "dng_host.h"
+#endif
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN DRawDecoderSessionRegistry
+{
+public:
+
+    QMutex                                                     mutex;
+    QHash<QString, QWeakPointer<DRawDecoderSession::Private> > sessions;
+};
+
+Q_GLOBAL_STATIC(DRawDecoderSessionRegistry, s_registry)
+
+// --------------------------------------------------------------------------------------------------
+
+DRawDecoderSession::Private::Private(const QString& path)
+    : filePath(path),
+      raw     (new LibRaw)
+{
+    defaultParams = raw->imgdata.params;
+}
+
+DRawDecoderSession::Private::~Private()
+{
+    raw->recycle();
+    delete raw;
+
+#ifdef USE_DNGSDK
+
+    delete dnghost;
+
+#endif
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << "RAW session released for" << filePath;
+
+    if (s_registry.isDestroyed())
+    {
+        return;
+    }
+
+    QMutexLocker lock(&s_registry->mutex);
+
+    // A new session can be registered for this file while this one is released.
+
+    auto it = s_registry->sessions.find(filePath);
+
+    if ((it != s_registry->sessions.end()) && it.value().isNull())
+    {
+        s_registry->sessions.erase(it);
+    }
+}
+
+QSharedPointer<DRawDecoderSession::Private> DRawDecoderSession::Private::find(const QString& path)
+{
+    QMutexLocker lock(&s_registry->mutex);
+
+    return s_registry->sessions.value(path).toStrongRef();
+}
+
+bool DRawDecoderSession::Private::unpack()
+{
+    if (unpacked)
+    {
+        return true;
+    }
+
+#ifdef USE_DNGSDK
+
+    if (!dnghost)
+    {
+        raw->imgdata.rawparams.use_dngsdk = LIBRAW_DNG_ALL;
+        dnghost                           = new dng_host;
+        raw->set_dng_host(dnghost);
+    }
+
+#endif
+
+#ifdef Q_OS_WIN
+
+    int ret = raw->open_file((const wchar_t*)filePath.utf16());
+
+#else
+
+    int ret = raw->open_file(filePath.toUtf8().constData());
+
+#endif
+
+    if (ret != LIBRAW_SUCCESS)
+    {
+        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run open_file: " << libraw_strerror(ret);
+        raw->recycle();
+
+        return false;
+    }
+
+    ret = raw->unpack();
+
+    if (ret != LIBRAW_SUCCESS)
+    {
+        qCDebug(DIGIKAM_RAWENGINE_LOG) << "LibRaw: failed to run unpack: " << libraw_strerror(ret);
+        raw->recycle();
+
+        return false;
+    }
+
+    unpacked = true;
+
+    qCDebug(DIGIKAM_RAWENGINE_LOG) << "RAW session unpacked" << filePath;
+
+    return true;
+}
+
+void DRawDecoderSession::Private::resetParameters()
+{
+    raw->imgdata.params = defaultParams;
+}
+
+bool DRawDecoderSession::Private::identifyInfo(DRawInfo& info) const
+{
+    QMutexLocker lock(&infoMutex);
+
+    if (identified)
+    {
+        info = identify;
+    }
+
+    return identified;
+}
+
+void DRawDecoderSession::Private::setIdentifyInfo(const DRawInfo& info)
+{
+    QMutexLocker lock(&infoMutex);
+
+    identify   = info;
+    identified = true;
+}
+
+// --------------------------------------------------------------------------------------------------
+
+DRawDecoderSession::DRawDecoderSession(const QString& filePath)
+{
+    QMutexLocker lock(&s_registry->mutex);
+
+    d = s_registry->sessions.value(filePath).toStrongRef();
+
+    if (!d)
+    {
+        d = QSharedPointer<Private>(new Private(filePath));
+        s_registry->sessions.insert(filePath, d.toWeakRef());
+    }
+}
+
+DRawDecoderSession::~DRawDecoderSession()
+{
+    // The data are released with the last session of the file, or after the current decoding.
+}
+
+QString DRawDecoderSession::filePath() const
+{
+    return d->filePath;
+}
+
+} // namespace Digikam
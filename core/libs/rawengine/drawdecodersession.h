@@ -0,0 +1,65 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a session keeping the unpacked data of a RAW file
+ *               to process it again with other decoding settings.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QSharedPointer>
+#include <QString>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * While a session is alive for a RAW file, the decoding of this file with DRawDecoder,
+ * from any thread, keeps the file opened and the sensor data unpacked in memory. The next
+ * decodings only run the post-processing stages (white balance, demosaicing, noise reduction,
+ * color conversion) from these data, and the last processed image is reused as long as
+ * the settings do not change. The memory is released with the last session of the file.
+ *
+ * Typical use is an interactive tool decoding the same file again each time the
+ * settings are changed by the user.
+ */
+class DIGIKAM_EXPORT DRawDecoderSession
+{
+public:
+
+    explicit DRawDecoderSession(const QString& filePath);
+    ~DRawDecoderSession();
+
+    QString filePath() const;
+
+public:
+
+    // NOTE: declared public to be used by the DRawDecoder private container.
+    class Private;
+
+private:
+
+    // Disable
+    DRawDecoderSession(const DRawDecoderSession&)            = delete;
+    DRawDecoderSession& operator=(const DRawDecoderSession&) = delete;
+
+private:
+
+    QSharedPointer<Private> d;
+};
+
+} // namespace Digikam
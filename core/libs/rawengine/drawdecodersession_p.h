@@ -0,0 +1,98 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a session keeping the unpacked data of a RAW file
+ *               to process it again with other decoding settings.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QByteArray>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+
+// Local includes
+
+#include "drawdecodersession.h"
+#include "drawdecoder_p.h"
+
+#ifdef USE_DNGSDK
+class dng_host;
+#endif
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN DRawDecoderSession::Private
+{
+public:
+
+    explicit Private(const QString& path);
+    ~Private();
+
+    /**
+     * Return the session data of the file if a session is alive, else a null pointer.
+     * The data stay valid while the returned pointer is kept.
+     */
+    static QSharedPointer<Private> find(const QString& path);
+
+    /**
+     * Open the file and unpack the sensor data, if not yet done.
+     * The session mutex must be locked.
+     */
+    bool unpack();
+
+    /**
+     * Restore the processing parameters of a new LibRaw instance, before to apply the decoding settings.
+     * The session mutex must be locked.
+     */
+    void resetParameters();
+
+    /**
+     * The identification information, as returned by DRawDecoder::rawFileIdentify().
+     */
+    bool identifyInfo(DRawInfo& info) const;
+    void setIdentifyInfo(const DRawInfo& info);
+
+public:
+
+    QString                filePath;
+    QMutex                 mutex;                       ///< The LibRaw instance is used by one decoding at a time.
+    LibRaw*                raw           = nullptr;     ///< The opened file, with unpacked data if unpacked is true.
+    libraw_output_params_t defaultParams;               ///< The processing parameters of a new LibRaw instance.
+    bool                   unpacked      = false;
+
+#ifdef USE_DNGSDK
+
+    dng_host*              dnghost       = nullptr;
+
+#endif
+
+    /**
+     * The last processed image, reused if the same settings are requested again.
+     */
+    DRawDecoderSettings    lastSettings;
+    QByteArray             lastImage;
+    int                    lastWidth     = 0;
+    int                    lastHeight    = 0;
+    int                    lastRgbmax    = 0;
+
+private:
+
+    mutable QMutex         infoMutex;
+    DRawInfo               identify;
+    bool                   identified    = false;
+};
+
+} // namespace Digikam
@@ -286,8 +286,9 @@ void ApplicationSettings::readSettings()
     // ---------------------------------------------------------------------
 
     group                    = config->group(d->configGroupFaceDetection);
-    d->faceDetectionAccuracy = group.readEntry(d->configFaceDetectionAccuracyEntry, double(0.7));
-    d->faceDetectionYoloV3   = group.readEntry(d->configFaceDetectionYoloV3Entry,   false);
+    d->faceDetectionAccuracy    = group.readEntry(d->configFaceDetectionAccuracyEntry,    double(0.7));
+    d->faceDetectionYoloV3      = group.readEntry(d->configFaceDetectionYoloV3Entry,      false);
+    d->faceDetectionReducedSize = group.readEntry(d->configFaceDetectionReducedSizeEntry, false);
 
     // ---------------------------------------------------------------------
 
@@ -474,6 +475,7 @@ void ApplicationSettings::saveSettings()
 
     group.writeEntry(d->configFaceDetectionAccuracyEntry,               d->faceDetectionAccuracy);
     group.writeEntry(d->configFaceDetectionYoloV3Entry,                 d->faceDetectionYoloV3);
+    group.writeEntry(d->configFaceDetectionReducedSizeEntry,            d->faceDetectionReducedSize);
 
     group = config->group(d->configGroupDuplicatesSearch);
 
@@ -472,6 +472,9 @@ public:
     bool getFaceDetectionYoloV3() const;
     void setFaceDetectionYoloV3(bool yolo);
 
+    bool getFaceDetectionReducedSize() const;
+    void setFaceDetectionReducedSize(bool reduced);
+
     void setShowThumbbar(bool val);
     bool getShowThumbbar() const;
 
@@ -227,6 +227,16 @@ void ApplicationSettings::setFaceDetectionYoloV3(bool yolo)
     d->faceDetectionYoloV3 = yolo;
 }
 
+bool ApplicationSettings::getFaceDetectionReducedSize() const
+{
+    return d->faceDetectionReducedSize;
+}
+
+void ApplicationSettings::setFaceDetectionReducedSize(bool reduced)
+{
+    d->faceDetectionReducedSize = reduced;
+}
+
 void ApplicationSettings::setApplicationStyle(const QString& style)
 {
     if (d->applicationStyle.compare(style, Qt::CaseInsensitive) != 0)
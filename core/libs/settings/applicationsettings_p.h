@@ -180,6 +180,7 @@ public:
     const QString configStringComparisonTypeEntry                   = QLatin1String("String Comparison Type");
     const QString configFaceDetectionAccuracyEntry                  = QLatin1String("Detection Accuracy");
     const QString configFaceDetectionYoloV3Entry                    = QLatin1String("Use Yolo V3");
+    const QString configFaceDetectionReducedSizeEntry               = QLatin1String("Detect On Reduced Size");
     const QString configApplicationStyleEntry                       = QLatin1String("Application Style");
     const QString configIconThemeEntry                              = QLatin1String("Icon Theme");
     const QString configApplicationFontEntry                        = QLatin1String("Application Font");
@@ -337,6 +338,7 @@ public:
     /// face detection settings
     double                                       faceDetectionAccuracy                              = 0.7;
     bool                                         faceDetectionYoloV3                                = false;
+    bool                                         faceDetectionReducedSize                           = false;
 
     /// misc
     ApplicationSettings::StringComparisonType    stringComparisonType                               = ApplicationSettings::Natural;
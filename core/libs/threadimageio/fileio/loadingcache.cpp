@@ -16,7 +16,7 @@
 
 // Qt includes
 
-#include <QCache>
+#include <QAtomicInt>
 #include <QHash>
 
 // KDE includes
@@ -27,6 +27,7 @@
 
 #include "digikam_debug.h"
 #include "iccsettings.h"
+#include "loadingcachestore.h"
 #include "metaengine.h"
 #include "thumbnailsize.h"
 
@@ -38,10 +39,19 @@ class Q_DECL_HIDDEN LoadingCache::Private
 public:
 
     explicit Private(LoadingCache* const qq)
-        : q(qq)
+        : imageCache          (QLatin1String("Images"),              4,  LoadingCacheStore<DImg>::AdmitFrequent),
+          previewCache        (QLatin1String("Previews"),            8,  LoadingCacheStore<DImg>::AdmitAll),
+          thumbnailImageCache (QLatin1String("Thumbnails"),          16, LoadingCacheStore<QImage>::AdmitAll),
+          thumbnailPixmapCache(QLatin1String("Thumbnail pixmaps"),   1,  LoadingCacheStore<QPixmap>::AdmitAll),
+          bufferedTPixmapCache(QLatin1String("Buffered pixmaps"),    1,  LoadingCacheStore<QPixmap>::AdmitAll),
+          statsInterval       (qMax(0, qEnvironmentVariableIntValue("DIGIKAM_LOADINGCACHE_STATS"))),
+          q                   (qq)
     {
     }
 
+    LoadingCacheStore<DImg>& imageStore(const QString& cacheKey);
+    void countRequest();
+
     void mapImageFilePath(const QString& filePath, const QString& cacheKey);
     void mapThumbnailFilePath(const QString& filePath, const QString& cacheKey);
     void cleanUpImageFilePathHash();
@@ -50,10 +60,21 @@ public:
 
 public:
 
-    QCache<QString, DImg>           imageCache;
-    QCache<QString, QImage>         thumbnailImageCache;
-    QCache<QString, QPixmap>        thumbnailPixmapCache;
-    QCache<QString, QPixmap>        bufferedTPixmapCache;
+    /**
+     * Full images live in a single shard: they are few and large, and the budget
+     * of a shard is the size limit of a cacheable image. Previews and thumbnails are
+     * requested concurrently by all loading threads and are spread over several shards.
+     * Pixmaps are only used from the main thread.
+     */
+    LoadingCacheStore<DImg>         imageCache;
+    LoadingCacheStore<DImg>         previewCache;
+    LoadingCacheStore<QImage>       thumbnailImageCache;
+    LoadingCacheStore<QPixmap>      thumbnailPixmapCache;
+    LoadingCacheStore<QPixmap>      bufferedTPixmapCache;
+
+    const int                       statsInterval;
+    QAtomicInt                      requests;
+
     QMultiHash<QString, QString>    imageFilePathHash;
     QMultiHash<QString, QString>    thumbnailFilePathHash;
     QHash<LoadingProcess*, QString> loadingDict;
@@ -79,9 +100,29 @@ LoadingCacheFileWatch* LoadingCache::Private::fileWatch() const
     return watch;
 }
 
+LoadingCacheStore<DImg>& LoadingCache::Private::imageStore(const QString& cacheKey)
+{
+    // See LoadingDescription::cacheKey() for the keys of reduced size previews.
+
+    if (cacheKey.contains(QLatin1String("-previewImage")))
+    {
+        return previewCache;
+    }
+
+    return imageCache;
+}
+
+void LoadingCache::Private::countRequest()
+{
+    if (statsInterval && (((requests.fetchAndAddRelaxed(1) + 1) % statsInterval) == 0))
+    {
+        q->logStatistics();
+    }
+}
+
 void LoadingCache::Private::mapImageFilePath(const QString& filePath, const QString& cacheKey)
 {
-    if (imageFilePathHash.size() > (5 * imageCache.size()))
+    if (imageFilePathHash.size() > (5 * (imageCache.size() + previewCache.size())))
     {
         cleanUpImageFilePathHash();
     }
@@ -103,7 +144,11 @@ void LoadingCache::Private::cleanUpImageFilePathHash()
 {
     // Remove all entries from hash whose value is no longer a key in the cache
 
-    QList<QString> keys = imageCache.keys();
+    QList<QString> keys;
+
+    keys += imageCache.keys();
+    keys += previewCache.keys();
+
     QMultiHash<QString, QString>::iterator it;
 
     for (it = imageFilePathHash.begin() ; it != imageFilePathHash.end() ; )
@@ -181,6 +226,8 @@ LoadingCache::LoadingCache()
 
 LoadingCache::~LoadingCache()
 {
+    logStatistics();
+
     delete d->watch;
     delete d;
     m_instance = nullptr;
@@ -190,18 +237,19 @@ DImg* LoadingCache::retrieveImage(const QString& cacheKey) const
 {
     QString filePath(d->imageFilePathHash.key(cacheKey));
     d->fileWatch()->checkFileWatch(filePath);
+    d->countRequest();
 
-    return d->imageCache[cacheKey];
+    return d->imageStore(cacheKey).object(cacheKey);
 }
 
 bool LoadingCache::putImage(const QString& cacheKey, const DImg& img, const QString& filePath) const
 {
-    bool isInserted = false;
+    bool isInserted                = false;
+    LoadingCacheStore<DImg>& store = d->imageStore(cacheKey);
 
-    if (isCacheable(img))
+    if ((qint64)img.numBytes() <= store.maxEntryCost())
     {
-        int cost   = img.numBytes() / 1024;
-        isInserted = d->imageCache.insert(cacheKey, new DImg(img), cost);
+        isInserted = store.insert(cacheKey, img, img.numBytes());
 
         if (isInserted && !filePath.isEmpty())
         {
@@ -215,19 +263,20 @@ bool LoadingCache::putImage(const QString& cacheKey, const DImg& img, const QStr
 
 void LoadingCache::removeImage(const QString& cacheKey)
 {
-    d->imageCache.remove(cacheKey);
+    d->imageStore(cacheKey).remove(cacheKey);
 }
 
 void LoadingCache::removeImages()
 {
     d->imageCache.clear();
+    d->previewCache.clear();
 }
 
-bool LoadingCache::isCacheable(const DImg& img) const
+bool LoadingCache::isCacheable(const QString& cacheKey, const DImg& img) const
 {
-    // return whether image fits in cache
+    // return whether image fits in the store of this key
 
-    return ((quint64)d->imageCache.maxCost() >= (img.numBytes() / 1024));
+    return ((quint64)d->imageStore(cacheKey).maxEntryCost() >= img.numBytes());
 }
 
 void LoadingCache::addLoadingProcess(LoadingProcess* const process)
@@ -257,29 +306,56 @@ void LoadingCache::notifyNewLoadingProcess(LoadingProcess* const process, const
 void LoadingCache::setCacheSize(int megabytes)
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "Allowing a cache size of" << megabytes << "MB";
-    d->imageCache.setMaxCost(megabytes * 1024);
+
+    const qint64 bytes = (qint64)megabytes * 1024 * 1024;
+
+    d->imageCache.setMaxCost(bytes / 3 * 2);
+    d->previewCache.setMaxCost(bytes - d->imageCache.maxCost());
 }
 
 quint64 LoadingCache::getCacheSize() const
 {
-    return ((quint64)(d->imageCache.maxCost()) * 1024);
+    return ((quint64)(d->imageCache.maxCost() + d->previewCache.maxCost()));
 }
 
 // --- Thumbnails ----
 
 const QImage* LoadingCache::retrieveThumbnail(const QString& cacheKey) const
 {
-    return d->thumbnailImageCache[cacheKey];
+    d->countRequest();
+
+    return d->thumbnailImageCache.object(cacheKey);
 }
 
 const QPixmap* LoadingCache::retrieveThumbnailPixmap(const QString& cacheKey) const
 {
-    return d->thumbnailPixmapCache[cacheKey];
+    d->countRequest();
+
+    return d->thumbnailPixmapCache.object(cacheKey);
 }
 
 const QPixmap* LoadingCache::retrieveBufferedTPixmap(const QString& cacheKey) const
 {
-    return d->bufferedTPixmapCache[cacheKey];
+    return d->bufferedTPixmapCache.object(cacheKey);
+}
+
+bool LoadingCache::findThumbnail(const QString& cacheKey, QImage& thumb) const
+{
+    d->countRequest();
+
+    return d->thumbnailImageCache.find(cacheKey, thumb);
+}
+
+bool LoadingCache::peekThumbnail(const QString& cacheKey, QImage& thumb) const
+{
+    return d->thumbnailImageCache.peek(cacheKey, thumb);
+}
+
+bool LoadingCache::findThumbnailPixmap(const QString& cacheKey, QPixmap& thumb) const
+{
+    d->countRequest();
+
+    return d->thumbnailPixmapCache.find(cacheKey, thumb);
 }
 
 bool LoadingCache::hasThumbnailPixmap(const QString& cacheKey) const
@@ -289,9 +365,9 @@ bool LoadingCache::hasThumbnailPixmap(const QString& cacheKey) const
 
 void LoadingCache::putThumbnail(const QString& cacheKey, const QImage& thumb, const QString& filePath)
 {
-    int cost = thumb.sizeInBytes();
+    qint64 cost = thumb.sizeInBytes();
 
-    if (d->thumbnailImageCache.insert(cacheKey, new QImage(thumb), cost))
+    if (d->thumbnailImageCache.insert(cacheKey, thumb, cost))
     {
         d->mapThumbnailFilePath(filePath, cacheKey);
     }
@@ -299,9 +375,9 @@ void LoadingCache::putThumbnail(const QString& cacheKey, const QImage& thumb, co
 
 void LoadingCache::putThumbnail(const QString& cacheKey, const QPixmap& thumb, const QString& filePath)
 {
-    int cost = thumb.width() * thumb.height() * thumb.depth() / 8;
+    qint64 cost = (qint64)thumb.width() * thumb.height() * thumb.depth() / 8;
 
-    if (d->thumbnailPixmapCache.insert(cacheKey, new QPixmap(thumb), cost))
+    if (d->thumbnailPixmapCache.insert(cacheKey, thumb, cost))
     {
         d->mapThumbnailFilePath(filePath, cacheKey);
 
@@ -323,15 +399,15 @@ void LoadingCache::removeThumbnails()
 
 void LoadingCache::setThumbnailCacheSize(int numberOfQImages, int numberOfQPixmaps)
 {
-    d->thumbnailImageCache.setMaxCost(numberOfQImages                *
+    d->thumbnailImageCache.setMaxCost((qint64)numberOfQImages        *
                                       ThumbnailSize::maxThumbsSize() *
                                       ThumbnailSize::maxThumbsSize() * 4);
 
-    d->thumbnailPixmapCache.setMaxCost(numberOfQPixmaps               *
+    d->thumbnailPixmapCache.setMaxCost((qint64)numberOfQPixmaps       *
                                        ThumbnailSize::maxThumbsSize() *
                                        ThumbnailSize::maxThumbsSize() * QPixmap::defaultDepth() / 8);
 
-    d->bufferedTPixmapCache.setMaxCost((numberOfQPixmaps / 2)         *
+    d->bufferedTPixmapCache.setMaxCost((qint64)(numberOfQPixmaps / 2) *
                                        ThumbnailSize::maxThumbsSize() *
                                        ThumbnailSize::maxThumbsSize() * QPixmap::defaultDepth() / 8);
 }
@@ -349,27 +425,23 @@ void LoadingCache::notifyFileChanged(const QString& filePath, bool notify)
 
     for (const QString& cacheKey : std::as_const(keys))
     {
-        d->imageCache.remove(cacheKey);
+        d->imageStore(cacheKey).remove(cacheKey);
     }
 
     keys = d->thumbnailFilePathHash.values(filePath);
 
     for (const QString& cacheKey : std::as_const(keys))
     {
-        if (d->thumbnailPixmapCache.contains(cacheKey))
-        {
-            QPixmap* const thumb = d->thumbnailPixmapCache[cacheKey];
+        QPixmap thumb;
 
-            if (thumb)
-            {
-                int cost = thumb->width() * thumb->height() * thumb->depth() / 8;
+        if (d->thumbnailPixmapCache.take(cacheKey, thumb))
+        {
+            qint64 cost = (qint64)thumb.width() * thumb.height() * thumb.depth() / 8;
 
-                d->bufferedTPixmapCache.insert(cacheKey, new QPixmap(*thumb), cost);
-            }
+            d->bufferedTPixmapCache.insert(cacheKey, thumb, cost);
         }
 
         d->thumbnailImageCache.remove(cacheKey);
-        d->thumbnailPixmapCache.remove(cacheKey);
     }
 
     if (notify)
@@ -378,6 +450,29 @@ void LoadingCache::notifyFileChanged(const QString& filePath, bool notify)
     }
 }
 
+QList<LoadingCacheStatistics> LoadingCache::statistics() const
+{
+    QList<LoadingCacheStatistics> stats;
+
+    stats << d->imageCache.statistics()
+          << d->previewCache.statistics()
+          << d->thumbnailImageCache.statistics()
+          << d->thumbnailPixmapCache.statistics()
+          << d->bufferedTPixmapCache.statistics();
+
+    return stats;
+}
+
+void LoadingCache::logStatistics() const
+{
+    const QList<LoadingCacheStatistics> stats = statistics();
+
+    for (const LoadingCacheStatistics& s : stats)
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG).noquote() << "LoadingCache" << s.toString();
+    }
+}
+
 void LoadingCache::iccSettingsChanged(const ICCSettingsContainer& current, const ICCSettingsContainer& previous)
 {
     if (
@@ -394,6 +489,31 @@ void LoadingCache::iccSettingsChanged(const ICCSettingsContainer& current, const
 
 //---------------------------------------------------------------------------------------------------
 
+double LoadingCacheStatistics::hitRate() const
+{
+    const quint64 requests = hits + misses;
+
+    return (requests ? (100.0 * hits / requests) : 0.0);
+}
+
+QString LoadingCacheStatistics::toString() const
+{
+    return QString::fromLatin1("%1: %2 entries, %3 / %4 MB, hit rate %5% (%6 hits, %7 misses), "
+                               "%8 insertions, %9 evictions, %10 rejections")
+           .arg(name)
+           .arg(count)
+           .arg(cost    / 1048576.0, 0, 'f', 1)
+           .arg(maxCost / 1048576.0, 0, 'f', 1)
+           .arg(hitRate(), 0, 'f', 1)
+           .arg(hits)
+           .arg(misses)
+           .arg(insertions)
+           .arg(evictions)
+           .arg(rejections);
+}
+
+//---------------------------------------------------------------------------------------------------
+
 LoadingCacheFileWatch::~LoadingCacheFileWatch()
 {
     if (m_cache)
@@ -112,6 +112,33 @@ private:
 
 // --------------------------------------------------------------------------------------------------------------
 
+/**
+ * Counters of one of the stores of the LoadingCache, see LoadingCache::statistics().
+ */
+class DIGIKAM_EXPORT LoadingCacheStatistics
+{
+public:
+
+    LoadingCacheStatistics() = default;
+
+    double hitRate() const;
+    QString toString() const;
+
+public:
+
+    QString name;
+    quint64 hits       = 0;
+    quint64 misses     = 0;
+    quint64 insertions = 0;
+    quint64 evictions  = 0;     ///< entries dropped to make room for new ones.
+    quint64 rejections = 0;     ///< entries refused by the admission policy or too large.
+    qint64  cost       = 0;     ///< in bytes.
+    qint64  maxCost    = 0;     ///< in bytes.
+    int     count      = 0;
+};
+
+// --------------------------------------------------------------------------------------------------------------
+
 class DIGIKAM_EXPORT LoadingCache : public QObject
 {
     Q_OBJECT
@@ -120,6 +147,11 @@ public:
 
     /**
      * NOTE: !! All methods of LoadingCache shall only be called when a CacheLock is held !!
+     *
+     * The exceptions are findThumbnail(), findThumbnailPixmap(), peekThumbnail() and statistics():
+     * the stores of the cache are sharded, each shard having its own lock, and these methods
+     * return copies of the cached objects. The CacheLock protects the loading processes, the file
+     * watch and the lifetime of the pointers returned by the retrieve methods.
      */
 
     class DIGIKAM_EXPORT CacheLock
@@ -148,12 +180,16 @@ public:
     DImg* retrieveImage(const QString& cacheKey) const;
 
     /**
-     * Returns whether the given DImg fits in the cache.
+     * Returns whether the given DImg fits in the store used for this cache key,
+     * full images or reduced size previews.
      */
-    bool isCacheable(const DImg& img) const;
+    bool isCacheable(const QString& cacheKey, const DImg& img) const;
 
     /**
      * Put image into for given string into the cache.
+     * Full images and reduced size previews are kept in separated stores: previews
+     * are always admitted, while a full image only evicts images which are not
+     * requested more often, so that one-off batch loads do not flush the working set.
      * Returns true if image has been put in the cache, false otherwise.
      * Ownership of the DImg instance is passed to the cache.
      * When it cannot be put in the cache it is deleted.
@@ -196,7 +232,8 @@ public:
     void notifyNewLoadingProcess(LoadingProcess* const process, const LoadingDescription& description);
 
     /**
-     * Sets the cache size in megabytes.
+     * Sets the cache size in megabytes, shared between full images (two thirds)
+     * and reduced size previews (one third).
      * The thumbnail cache is not affected and setThumbnailCacheSize takes the maximum number.
      */
     void setCacheSize(int megabytes);
@@ -222,6 +259,19 @@ public:
     const QPixmap* retrieveBufferedTPixmap(const QString& cacheKey) const;
     bool  hasThumbnailPixmap(const QString& cacheKey) const;
 
+    /**
+     * Same as retrieveThumbnail() and retrieveThumbnailPixmap(), but return a copy
+     * of the thumbnail. These methods do not need the CacheLock.
+     */
+    bool findThumbnail(const QString& cacheKey, QImage& thumb) const;
+    bool findThumbnailPixmap(const QString& cacheKey, QPixmap& thumb) const;
+
+    /**
+     * Same as findThumbnail(), without counting a request in the statistics.
+     * Used to look again for a thumbnail under the CacheLock.
+     */
+    bool peekThumbnail(const QString& cacheKey, QImage& thumb) const;
+
     /**
      * Puts a thumbnail into the thumbnail cache.
      */
@@ -267,6 +317,16 @@ public:
      */
     void notifyFileChanged(const QString& filePath, bool notify = true);
 
+    // ------- Statistics -----------------------------------
+
+    /**
+     * Returns the hit, miss, eviction and rejection counters of each store of the cache.
+     * Set the DIGIKAM_LOADINGCACHE_STATS environment variable to a number of requests
+     * to print them periodically in the debug log, they are also printed at clean up.
+     */
+    QList<LoadingCacheStatistics> statistics() const;
+    void logStatistics() const;
+
 Q_SIGNALS:
 
     /**
@@ -71,7 +71,7 @@ void LoadingCacheInterface::putImage(const QString& filePath, const DImg& img)
     LoadingCache* const cache = LoadingCache::cache();
     LoadingCache::CacheLock lock(cache);
 
-    if (cache->isCacheable(img))
+    if (cache->isCacheable(filePath, img))
     {
         cache->putImage(filePath, img, filePath);
     }
@@ -0,0 +1,687 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : sharded LRU stores with cost accounting used by the loading cache
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QAtomicInteger>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QVector>
+
+// Local includes
+
+#include "loadingcache.h"
+
+namespace Digikam
+{
+
+/**
+ * A count-min sketch with small saturated counters, estimating how often a key has
+ * been requested recently. All counters are halved when the number of recorded
+ * requests reaches the sample size, so that old popularity fades away.
+ * Not thread-safe: each shard owns its sketch.
+ */
+class LoadingCacheFrequencySketch
+{
+public:
+
+    LoadingCacheFrequencySketch()
+    {
+        resize(256);
+    }
+
+    void resize(int expectedEntries)
+    {
+        int width = 64;
+
+        while ((width < expectedEntries) && (width < (1 << 20)))
+        {
+            width <<= 1;
+        }
+
+        if (width == m_width)
+        {
+            return;
+        }
+
+        m_width      = width;
+        m_sampleSize = 10 * width;
+        m_additions  = 0;
+        m_table.fill(0, Rows * width);
+    }
+
+    void increment(uint hash)
+    {
+        bool added = false;
+
+        for (int row = 0 ; row < Rows ; ++row)
+        {
+            quint8& counter = m_table[indexOf(hash, row)];
+
+            if (counter < MaxCount)
+            {
+                ++counter;
+                added = true;
+            }
+        }
+
+        if (added && (++m_additions >= m_sampleSize))
+        {
+            reset();
+        }
+    }
+
+    int frequency(uint hash) const
+    {
+        int freq = MaxCount;
+
+        for (int row = 0 ; row < Rows ; ++row)
+        {
+            freq = qMin(freq, (int)m_table.at(indexOf(hash, row)));
+        }
+
+        return freq;
+    }
+
+private:
+
+    int indexOf(uint hash, int row) const
+    {
+        // The low bits of the hash select the shard, the sketch use the mixed high bits.
+
+        static const quint32 seeds[Rows] = { 0x9E3779B1, 0x85EBCA77, 0xC2B2AE3D, 0x27D4EB2F };
+
+        const quint32 h = (hash ^ (hash >> 15)) * seeds[row];
+
+        return (row * m_width + (int)((h >> 12) & (quint32)(m_width - 1)));
+    }
+
+    void reset()
+    {
+        for (int i = 0 ; i < m_table.size() ; ++i)
+        {
+            m_table[i] >>= 1;
+        }
+
+        m_additions /= 2;
+    }
+
+private:
+
+    enum
+    {
+        Rows     = 4,
+        MaxCount = 15
+    };
+
+    QVector<quint8> m_table;
+    int             m_width      = 0;
+    int             m_sampleSize = 0;
+    int             m_additions  = 0;
+};
+
+// --------------------------------------------------------------------------------------------------------------
+
+/**
+ * A LRU store of implicitly shared values (DImg, QImage, QPixmap), split in shards
+ * selected by the hash of the key. Each shard has its own lock and its own frequency
+ * sketch, while the cost budget is shared by all shards: an entry can use the whole
+ * budget, and the least recently used entry of the whole store is evicted first.
+ *
+ * Locking contract:
+ * - all methods lock the shards internally, never more than one shard at a time.
+ * - entries are only deleted by insert(), remove(), clear() and setMaxCost(), which
+ *   LoadingCache calls with the CacheLock held. A pointer returned by object() thus
+ *   stays valid as long as the caller holds the CacheLock.
+ * - find() and peek() return a copy of the value and can be used without the CacheLock.
+ */
+template <class T>
+class LoadingCacheStore
+{
+public:
+
+    enum AdmissionPolicy
+    {
+        /// Plain LRU: a new entry always evicts the least recently used ones.
+        AdmitAll,
+
+        /// TinyLFU: a new entry only evicts entries which are not more frequently requested.
+        AdmitFrequent
+    };
+
+public:
+
+    LoadingCacheStore(const QString& name, int shardCount, AdmissionPolicy policy)
+        : m_name  (name),
+          m_policy(policy)
+    {
+        int count = 1;
+
+        while (count < shardCount)
+        {
+            count <<= 1;
+        }
+
+        for (int i = 0 ; i < count ; ++i)
+        {
+            m_shards << new Shard;
+        }
+    }
+
+    ~LoadingCacheStore()
+    {
+        clear();
+        qDeleteAll(m_shards);
+    }
+
+    void setMaxCost(qint64 maxCost)
+    {
+        m_maxCost = maxCost;
+
+        // Thumbnails and previews are typically a few hundred kilobytes.
+
+        const int expected = (int)qMin(maxCost / m_shards.size() / (256 * 1024) + 1, (qint64)(1 << 20));
+
+        for (Shard* const shard : std::as_const(m_shards))
+        {
+            QMutexLocker locker(&shard->mutex);
+            shard->sketch.resize(expected);
+        }
+
+        trim();
+    }
+
+    qint64 maxCost() const
+    {
+        return m_maxCost;
+    }
+
+    /**
+     * The maximal cost of one entry, i.e. the budget of the whole store.
+     */
+    qint64 maxEntryCost() const
+    {
+        return m_maxCost;
+    }
+
+    T* object(const QString& key)
+    {
+        const uint hash    = qHash(key);
+        Shard* const shard = shardOf(hash);
+        QMutexLocker locker(&shard->mutex);
+
+        shard->sketch.increment(hash);
+        Node* const node   = shard->nodes.value(key);
+
+        if (!node)
+        {
+            m_misses.fetchAndAddRelaxed(1);
+
+            return nullptr;
+        }
+
+        m_hits.fetchAndAddRelaxed(1);
+        moveToFront(shard, node);
+
+        return &node->value;
+    }
+
+    bool find(const QString& key, T& value)
+    {
+        const uint hash    = qHash(key);
+        Shard* const shard = shardOf(hash);
+        QMutexLocker locker(&shard->mutex);
+
+        shard->sketch.increment(hash);
+        Node* const node   = shard->nodes.value(key);
+
+        if (!node)
+        {
+            m_misses.fetchAndAddRelaxed(1);
+
+            return false;
+        }
+
+        m_hits.fetchAndAddRelaxed(1);
+        moveToFront(shard, node);
+        value = node->value;
+
+        return true;
+    }
+
+    /**
+     * Same as find(), without counting a request.
+     */
+    bool peek(const QString& key, T& value) const
+    {
+        Shard* const shard = shardOf(qHash(key));
+        QMutexLocker locker(&shard->mutex);
+        Node* const node   = shard->nodes.value(key);
+
+        if (!node)
+        {
+            return false;
+        }
+
+        value = node->value;
+
+        return true;
+    }
+
+    bool contains(const QString& key) const
+    {
+        Shard* const shard = shardOf(qHash(key));
+        QMutexLocker locker(&shard->mutex);
+
+        return shard->nodes.contains(key);
+    }
+
+    /**
+     * Insert or replace an entry. Returns false if the entry is larger than the store,
+     * or if the admission policy prefers the entries which would be evicted for it.
+     */
+    bool insert(const QString& key, const T& value, qint64 cost)
+    {
+        const uint hash    = qHash(key);
+        Shard* const shard = shardOf(hash);
+
+        if (cost > m_maxCost)
+        {
+            remove(key);
+            m_rejections.fetchAndAddRelaxed(1);
+
+            return false;
+        }
+
+        // Replacing an entry does not change the working set.
+
+        if (!replace(shard, key, value, cost))
+        {
+            // The admission check locks the other shards, one at a time.
+
+            if ((m_policy == AdmitFrequent) && !admit(shard, hash, cost))
+            {
+                m_rejections.fetchAndAddRelaxed(1);
+
+                return false;
+            }
+
+            QMutexLocker locker(&shard->mutex);
+            Node* node = shard->nodes.value(key);
+
+            if (node)
+            {
+                m_totalCost.fetchAndAddRelaxed(cost - node->cost);
+                node->value = value;
+                node->cost  = cost;
+                moveToFront(shard, node);
+            }
+            else
+            {
+                node        = new Node;
+                node->key   = key;
+                node->value = value;
+                node->cost  = cost;
+                m_totalCost.fetchAndAddRelaxed(cost);
+                shard->nodes.insert(key, node);
+                linkFront(shard, node);
+                m_insertions.fetchAndAddRelaxed(1);
+            }
+        }
+
+        trim();
+
+        return true;
+    }
+
+    bool remove(const QString& key)
+    {
+        Shard* const shard = shardOf(qHash(key));
+        QMutexLocker locker(&shard->mutex);
+        Node* const node   = shard->nodes.value(key);
+
+        if (!node)
+        {
+            return false;
+        }
+
+        unlink(shard, node);
+
+        return true;
+    }
+
+    /**
+     * Remove an entry and return its value, without counting a request.
+     */
+    bool take(const QString& key, T& value)
+    {
+        Shard* const shard = shardOf(qHash(key));
+        QMutexLocker locker(&shard->mutex);
+        Node* const node   = shard->nodes.value(key);
+
+        if (!node)
+        {
+            return false;
+        }
+
+        value = node->value;
+        unlink(shard, node);
+
+        return true;
+    }
+
+    void clear()
+    {
+        for (Shard* const shard : std::as_const(m_shards))
+        {
+            QMutexLocker locker(&shard->mutex);
+
+            while (shard->last)
+            {
+                unlink(shard, shard->last);
+            }
+        }
+    }
+
+    QList<QString> keys() const
+    {
+        QList<QString> list;
+
+        for (Shard* const shard : std::as_const(m_shards))
+        {
+            QMutexLocker locker(&shard->mutex);
+            list += shard->nodes.keys();
+        }
+
+        return list;
+    }
+
+    int size() const
+    {
+        int count = 0;
+
+        for (Shard* const shard : std::as_const(m_shards))
+        {
+            QMutexLocker locker(&shard->mutex);
+            count += shard->nodes.size();
+        }
+
+        return count;
+    }
+
+    LoadingCacheStatistics statistics() const
+    {
+        LoadingCacheStatistics stats;
+        stats.name       = m_name;
+        stats.hits       = m_hits.loadRelaxed();
+        stats.misses     = m_misses.loadRelaxed();
+        stats.insertions = m_insertions.loadRelaxed();
+        stats.evictions  = m_evictions.loadRelaxed();
+        stats.rejections = m_rejections.loadRelaxed();
+        stats.maxCost    = m_maxCost;
+        stats.cost       = m_totalCost.loadRelaxed();
+        stats.count      = size();
+
+        return stats;
+    }
+
+private:
+
+    class Node
+    {
+    public:
+
+        QString key;
+        T       value;
+        qint64  cost = 0;
+        quint64 tick = 0;        ///< time of the last use, on the clock of the store
+        Node*   prev = nullptr;
+        Node*   next = nullptr;
+    };
+
+    class Shard
+    {
+    public:
+
+        mutable QMutex              mutex;
+        QHash<QString, Node*>       nodes;
+        Node*                       first = nullptr;     ///< most recently used
+        Node*                       last  = nullptr;     ///< least recently used
+        LoadingCacheFrequencySketch sketch;
+    };
+
+    /**
+     * An entry of a shard which would be evicted, as seen by the admission check.
+     */
+    class Victim
+    {
+    public:
+
+        quint64 tick      = 0;
+        qint64  cost      = 0;
+        int     frequency = 0;
+    };
+
+private:
+
+    Shard* shardOf(uint hash) const
+    {
+        return m_shards.at((int)(hash & (uint)(m_shards.size() - 1)));
+    }
+
+    void linkFront(Shard* const shard, Node* const node)
+    {
+        node->tick = m_clock.fetchAndAddRelaxed(1) + 1;
+        node->prev = nullptr;
+        node->next = shard->first;
+
+        if (shard->first)
+        {
+            shard->first->prev = node;
+        }
+
+        shard->first = node;
+
+        if (!shard->last)
+        {
+            shard->last = node;
+        }
+    }
+
+    void detach(Shard* const shard, Node* const node)
+    {
+        if (node->prev)
+        {
+            node->prev->next = node->next;
+        }
+        else
+        {
+            shard->first = node->next;
+        }
+
+        if (node->next)
+        {
+            node->next->prev = node->prev;
+        }
+        else
+        {
+            shard->last = node->prev;
+        }
+
+        node->prev = nullptr;
+        node->next = nullptr;
+    }
+
+    void moveToFront(Shard* const shard, Node* const node)
+    {
+        detach(shard, node);
+        linkFront(shard, node);
+    }
+
+    void unlink(Shard* const shard, Node* const node)
+    {
+        detach(shard, node);
+        shard->nodes.remove(node->key);
+        m_totalCost.fetchAndAddRelaxed(-node->cost);
+        delete node;
+    }
+
+    bool replace(Shard* const shard, const QString& key, const T& value, qint64 cost)
+    {
+        QMutexLocker locker(&shard->mutex);
+        Node* const node = shard->nodes.value(key);
+
+        if (!node)
+        {
+            return false;
+        }
+
+        m_totalCost.fetchAndAddRelaxed(cost - node->cost);
+        node->value = value;
+        node->cost  = cost;
+        moveToFront(shard, node);
+
+        return true;
+    }
+
+    /**
+     * Walk the entries of the whole store which would be evicted to make room for
+     * the candidate, least recently used first, and refuse it if one of them is
+     * requested more often. Ties are admitted: among cold entries the store behaves
+     * as a LRU. Each shard is locked in turn to take a snapshot of its oldest entries.
+     */
+    bool admit(Shard* const shard, uint hash, qint64 cost) const
+    {
+        const qint64 needed = m_totalCost.loadRelaxed() + cost - m_maxCost;
+
+        if (needed <= 0)
+        {
+            return true;
+        }
+
+        int candidate = 0;
+
+        {
+            QMutexLocker locker(&shard->mutex);
+            candidate = shard->sketch.frequency(hash);
+        }
+
+        QList<Victim> victims;
+
+        for (Shard* const other : std::as_const(m_shards))
+        {
+            QMutexLocker locker(&other->mutex);
+            qint64 freed = 0;
+
+            for (Node* node = other->last ; node && (freed < needed) ; node = node->prev)
+            {
+                Victim victim;
+                victim.tick      = node->tick;
+                victim.cost      = node->cost;
+                victim.frequency = other->sketch.frequency(qHash(node->key));
+                victims << victim;
+                freed           += node->cost;
+            }
+        }
+
+        std::sort(victims.begin(), victims.end(),
+                  [](const Victim& a, const Victim& b)
+                  {
+                      return (a.tick < b.tick);
+                  }
+        );
+
+        qint64 freed = 0;
+
+        for (const Victim& victim : std::as_const(victims))
+        {
+            if (freed >= needed)
+            {
+                break;
+            }
+
+            if (victim.frequency > candidate)
+            {
+                return false;
+            }
+
+            freed += victim.cost;
+        }
+
+        return true;
+    }
+
+    /**
+     * Evict the least recently used entries of the whole store until it fits in its budget.
+     */
+    void trim()
+    {
+        while (m_totalCost.loadRelaxed() > m_maxCost)
+        {
+            Shard* oldest = nullptr;
+            quint64 tick  = 0;
+
+            for (Shard* const shard : std::as_const(m_shards))
+            {
+                QMutexLocker locker(&shard->mutex);
+
+                if (shard->last && (!oldest || (shard->last->tick < tick)))
+                {
+                    oldest = shard;
+                    tick   = shard->last->tick;
+                }
+            }
+
+            if (!oldest)
+            {
+                break;
+            }
+
+            QMutexLocker locker(&oldest->mutex);
+
+            if (oldest->last)
+            {
+                unlink(oldest, oldest->last);
+                m_evictions.fetchAndAddRelaxed(1);
+            }
+        }
+    }
+
+private:
+
+    const QString                   m_name;
+    const AdmissionPolicy           m_policy;
+    QVector<Shard*>                 m_shards;
+    qint64                          m_maxCost    = 0;
+
+    QAtomicInteger<qint64>          m_totalCost  = 0;
+    QAtomicInteger<quint64>         m_clock      = 0;
+
+    QAtomicInteger<quint64>         m_hits       = 0;
+    QAtomicInteger<quint64>         m_misses     = 0;
+    QAtomicInteger<quint64>         m_insertions = 0;
+    QAtomicInteger<quint64>         m_evictions  = 0;
+    QAtomicInteger<quint64>         m_rejections = 0;
+};
+
+} // namespace Digikam
@@ -86,7 +86,7 @@ int ThumbnailCreator::Private::storageSize() const
 
     if (onlyLargeThumbnails)
     {
-        if ((dpr > 1.0) && (thumbnailStorage == ThumbnailDatabase))
+        if ((dpr > 1.0) && (thumbnailStorage != FreeDesktopStandard))
         {
             return ThumbnailSize::getUseLargeThumbs() ? ThumbnailSize::MAX
                                                       : ThumbnailSize::HD;
@@ -98,7 +98,7 @@ int ThumbnailCreator::Private::storageSize() const
     }
     else
     {
-        if ((dpr > 1.0) && (thumbnailStorage == ThumbnailDatabase))
+        if ((dpr > 1.0) && (thumbnailStorage != FreeDesktopStandard))
         {
             return (thumbnailSize <= ThumbnailSize::Small) ? ThumbnailSize::Huge
                                                            : ThumbnailSize::HD;
@@ -241,6 +241,23 @@ QImage ThumbnailCreator::load(const ThumbnailIdentifier& identifier,
                 break;
             }
 
+            case ThumbnailPack:
+            {
+                if (pregenerate)
+                {
+                    if (isInPack(info))
+                    {
+                        return QImage();
+                    }
+                }
+                else
+                {
+                    image = loadFromPack(info);
+                }
+
+                break;
+            }
+
             case FreeDesktopStandard:
             {
                 image = loadFreedesktop(info);
@@ -283,6 +300,23 @@ QImage ThumbnailCreator::load(const ThumbnailIdentifier& identifier,
                 break;
             }
 
+            case ThumbnailPack:
+            {
+                image = loadFromPack(info);
+
+                if (image.isNull())
+                {
+                    image = createThumbnail(info, rect);
+
+                    if (!image.isNull())
+                    {
+                        storeInPack(info, image);
+                    }
+                }
+
+                break;
+            }
+
             case FreeDesktopStandard:
             {
                 image = createThumbnail(info, rect);
@@ -328,7 +362,7 @@ QImage ThumbnailCreator::load(const ThumbnailIdentifier& identifier,
 
     image.qimage = handleAlphaChannel(image.qimage);
 
-    if (d->thumbnailStorage == ThumbnailDatabase)
+    if (d->thumbnailStorage != FreeDesktopStandard)
     {
         // Image is stored, or created, unrotated, and is now rotated for display
         // detail thumbnails are stored readily rotated
@@ -461,6 +495,12 @@ void ThumbnailCreator::store(const QString& path, const QImage& i, const QRect&
             break;
         }
 
+        case ThumbnailPack:
+        {
+            storeInPack(info, image);
+            break;
+        }
+
         case FreeDesktopStandard:
         {
             storeFreedesktop(info, image);
@@ -495,6 +535,23 @@ void ThumbnailCreator::deleteThumbnailsFromDisk(const QString& filePath) const
             deleteFromDatabase(info);
             break;
         }
+
+        case ThumbnailPack:
+        {
+            ThumbnailInfo info;
+
+            if (d->infoProvider)
+            {
+                info = d->infoProvider->thumbnailInfo(ThumbnailIdentifier(filePath));
+            }
+            else
+            {
+                info = fileThumbnailInfo(filePath);
+            }
+
+            deleteFromPack(info);
+            break;
+        }
     }
 }
 
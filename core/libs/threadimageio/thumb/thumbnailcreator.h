@@ -44,7 +44,8 @@ public:
     enum StorageMethod
     {
         FreeDesktopStandard,
-        ThumbnailDatabase
+        ThumbnailDatabase,
+        ThumbnailPack           ///< See ThumbnailPackFile.
     };
 
 public:
@@ -212,6 +213,11 @@ private:
     bool isInDatabase(const ThumbnailInfo& info)                                    const;
     void deleteFromDatabase(const ThumbnailInfo& info)                              const;
 
+    void storeInPack(const ThumbnailInfo& info, const ThumbnailImage& image)        const;
+    ThumbnailImage loadFromPack(const ThumbnailInfo& info)                          const;
+    bool isInPack(const ThumbnailInfo& info)                                        const;
+    void deleteFromPack(const ThumbnailInfo& info)                                  const;
+
     void storeFreedesktop(const ThumbnailInfo& info, const ThumbnailImage& image)   const;
     ThumbnailImage loadFreedesktop(const ThumbnailInfo& info)                       const;
     void deleteFromDiskFreedesktop(const QString& filePath)                         const;
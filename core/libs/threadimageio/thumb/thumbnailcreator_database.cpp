@@ -83,91 +83,26 @@ void ThumbnailCreator::storeInDatabase(const ThumbnailInfo& info, const Thumbnai
         }
     }
 
-    ThumbsDbAccess access;
-    BdEngineBackend::QueryState lastQueryState = BdEngineBackend::QueryState(BdEngineBackend::ConnectionError);
-
-    while (lastQueryState == BdEngineBackend::ConnectionError)
-    {
-        lastQueryState = access.backend()->beginTransaction();
-
-        if (BdEngineBackend::NoErrors != lastQueryState)
-        {
-            continue;
-        }
-
-        // Insert thumbnail data
-
-        if (dbInfo.id == -1)
-        {
-            QVariant id;
-            lastQueryState = access.db()->insertThumbnail(dbInfo, &id);
-
-            if (BdEngineBackend::NoErrors != lastQueryState)
-            {
-                continue;
-            }
-            else
-            {
-                dbInfo.id = id.toInt();
-            }
-        }
-        else
-        {
-            lastQueryState = access.db()->replaceThumbnail(dbInfo);
-
-            if (BdEngineBackend::NoErrors != lastQueryState)
-            {
-                continue;
-            }
-        }
-
-        // Insert lookup data used to locate thumbnail data
+    // The thumbnail and its look-up data are stored by the write queue,
+    // grouped with the thumbnails of other threads in one transaction.
 
-        if (!info.customIdentifier.isNull())
-        {
-            lastQueryState = access.db()->insertCustomIdentifier(info.customIdentifier, dbInfo.id);
-
-            if (BdEngineBackend::NoErrors != lastQueryState)
-            {
-                continue;
-            }
-        }
-        else
-        {
-            if (!info.uniqueHash.isNull())
-            {
-                lastQueryState = access.db()->insertUniqueHash(info.uniqueHash, info.fileSize, dbInfo.id);
-
-                if (BdEngineBackend::NoErrors != lastQueryState)
-                {
-                    continue;
-                }
-            }
+    ThumbnailWriteQueue::instance()->enqueue(info, dbInfo);
+}
 
-            if (!info.filePath.isNull())
-            {
-                lastQueryState = access.db()->insertFilePath(info.filePath, dbInfo.id);
+ThumbsDbInfo ThumbnailCreator::loadThumbsDbInfo(const ThumbnailInfo& info) const
+{
+    ThumbsDbInfo dbInfo;
 
-                if (BdEngineBackend::NoErrors != lastQueryState)
-                {
-                    continue;
-                }
-            }
-        }
+    // A thumbnail still queued for writing is newer than the database content.
 
-        lastQueryState = access.backend()->commitTransaction();
+    if (ThumbnailWriteQueue::instance()->findPending(info, dbInfo))
+    {
+        d->dbIdForReplacement = dbInfo.id;
 
-        if (BdEngineBackend::NoErrors != lastQueryState)
-        {
-            continue;
-        }
+        return dbInfo;
     }
-}
 
-ThumbsDbInfo ThumbnailCreator::loadThumbsDbInfo(const ThumbnailInfo& info) const
-{
     ThumbsDbAccess access;
-    ThumbsDbInfo   dbInfo;
 
     // Custom identifier takes precedence
 
@@ -303,6 +238,10 @@ ThumbnailImage ThumbnailCreator::loadFromDatabase(const ThumbnailInfo& info) con
 
 void ThumbnailCreator::deleteFromDatabase(const ThumbnailInfo& info) const
 {
+    // Do not let a queued thumbnail be written after its removal.
+
+    ThumbnailWriteQueue::instance()->flush();
+
     ThumbsDbAccess access;
     BdEngineBackend::QueryState lastQueryState = BdEngineBackend::QueryState(BdEngineBackend::ConnectionError);
 
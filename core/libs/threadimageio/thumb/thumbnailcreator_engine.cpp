@@ -336,14 +336,24 @@ QImage ThumbnailCreator::loadImageDetail(const ThumbnailInfo& info,
         }
     }
 
+    const int orientation = exifOrientation(info, metadata, false, false);
+
     if (img.isNull())
     {
-        qDebug(DIGIKAM_GENERAL_LOG) << "Try to get thumbnail from DImg scaled for" << path;
+        qDebug(DIGIKAM_GENERAL_LOG) << "Try to get thumbnail from DImg region for" << path;
+
+        // Decode only the detail, reduced to the thumbnail size, if the loader supports it.
+        // The detail rect refers to the oriented image: the loader maps it back to the image
+        // stored in the file with the size read in its header.
 
-        // TODO: scaledLoading if detailRect is large
-        // TODO: use code from PreviewTask, including cache storage
+        DImgLoader::LoadFlags loadFlags = DImgLoader::LoadItemInfo | DImgLoader::LoadImageData;
+
+        if (profile)
+        {
+            loadFlags |= DImgLoader::LoadICCData;
+        }
 
-        if (!img.load(path, false, profile ? true : false, false, false, d->observer, d->fastRawSettings))
+        if (!img.loadRegion(path, detailRect, orientation, d->storageSize(), loadFlags, d->observer, d->fastRawSettings))
         {
             return QImage();
         }
@@ -354,13 +364,34 @@ QImage ThumbnailCreator::loadImageDetail(const ThumbnailInfo& info,
         *profile = img.getIccProfile();
     }
 
+    // The size of the image stored in the file, before rotation swaps it.
+
+    const QSize fileSize = img.originalSize();
+
     // We must rotate before clipping because the rect refers to the oriented image.
-    // I do not know currently how to back-rotate the rect for clipping before rotation.
-    // If someone has the mathematics, have a go.
 
-    img.rotateAndFlip(exifOrientation(info, metadata, false, false));
+    img.rotateAndFlip(orientation);
+
+    QRect mappedDetail;
+
+    if (!img.loadedRegion().isNull())
+    {
+        // Only a region of the image was loaded, possibly reduced: map the detail into it.
+
+        const QTransform matrix = DImgLoader::orientationTransform(fileSize, orientation);
+        const QRectF loaded     = matrix.mapRect(QRectF(img.loadedRegion()));
+        const qreal  scale      = img.width() / qMax(loaded.width(), 1.0);
+
+        mappedDetail            = QRectF((detailRect.x() - loaded.x()) * scale,
+                                         (detailRect.y() - loaded.y()) * scale,
+                                         detailRect.width()            * scale,
+                                         detailRect.height()           * scale).toAlignedRect();
+    }
+    else
+    {
+        mappedDetail = TagRegion::mapFromOriginalSize(img, detailRect);
+    }
 
-    QRect mappedDetail = TagRegion::mapFromOriginalSize(img, detailRect);
     img.crop(mappedDetail.intersected(QRect(0, 0, img.width(), img.height())));
 
     return img.copyQImage32();
@@ -61,6 +61,8 @@
 #include "thumbsdb.h"
 #include "thumbsdbbackend.h"
 #include "thumbnailsize.h"
+#include "thumbnailpackfile.h"
+#include "thumbnailwritequeue.h"
 
 #ifdef HAVE_MEDIAPLAYER
 #   include "videothumbnailer.h"
@@ -0,0 +1,84 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Loader for thumbnails - Pack file thumbnail storage
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "thumbnailcreator_p.h"
+
+namespace Digikam
+{
+
+void ThumbnailCreator::storeInPack(const ThumbnailInfo& info, const ThumbnailImage& image) const
+{
+    // As with the database, the thumbnail is stored unrotated with its orientation hint.
+
+    if (!ThumbnailPackFile::instance()->store(info, image.qimage, info.modificationDate, image.exifOrientation))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot save thumb in pack file";
+    }
+}
+
+bool ThumbnailCreator::isInPack(const ThumbnailInfo& info) const
+{
+    QDateTime modificationDate;
+
+    if (!ThumbnailPackFile::instance()->contains(info, modificationDate))
+    {
+        return false;
+    }
+
+    return (modificationDate >= info.modificationDate);
+}
+
+ThumbnailImage ThumbnailCreator::loadFromPack(const ThumbnailInfo& info) const
+{
+    ThumbnailImage image;
+    QDateTime      modificationDate;
+    int            orientationHint = DMetadata::ORIENTATION_UNSPECIFIED;
+
+    if (!ThumbnailPackFile::instance()->find(info, image.qimage, modificationDate, orientationHint))
+    {
+        return ThumbnailImage();
+    }
+
+    // Check modification date
+
+    if (modificationDate < info.modificationDate)
+    {
+        return ThumbnailImage();
+    }
+
+    // Give priority to main database's rotation flag, as in loadFromDatabase()
+
+    image.exifOrientation = info.orientationHint;
+
+    if ((image.exifOrientation == DMetadata::ORIENTATION_UNSPECIFIED) &&
+        !info.filePath.isEmpty()                                      &&
+        LoadSaveThread::infoProvider())
+    {
+        image.exifOrientation = LoadSaveThread::infoProvider()->orientationHint(info.filePath);
+    }
+
+    if (image.exifOrientation == DMetadata::ORIENTATION_UNSPECIFIED)
+    {
+        image.exifOrientation = orientationHint;
+    }
+
+    return image;
+}
+
+void ThumbnailCreator::deleteFromPack(const ThumbnailInfo& info) const
+{
+    ThumbnailPackFile::instance()->remove(info);
+}
+
+} // namespace Digikam
@@ -129,6 +129,10 @@ void ThumbnailLoadThread::cleanUp()
 
     defaultIconViewThread()->wait();
     defaultThread()->wait();
+
+    // Store the queued thumbnails before the thumbnails database is closed.
+
+    ThumbnailWriteQueue::instance()->shutDown();
 }
 
 void ThumbnailLoadThread::initializeThumbnailDatabase(const DbEngineParameters& params, ThumbnailInfoProvider* const provider)
@@ -155,6 +159,31 @@ void ThumbnailLoadThread::initializeThumbnailDatabase(const DbEngineParameters&
     }
 }
 
+bool ThumbnailLoadThread::initializeThumbnailPackFile(const QString& dirPath, ThumbnailInfoProvider* const provider)
+{
+    if (static_d->firstThreadCreated)
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Call initializeThumbnailPackFile at application start. "
+                                        "There are already thumbnail loading threads created, "
+                                        "and these will not be switched to use the pack file. ";
+    }
+
+    if (!ThumbnailPackFile::instance()->open(dirPath))
+    {
+        return false;
+    }
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Thumbnails pack file ready for use";
+    static_d->storageMethod = ThumbnailCreator::ThumbnailPack;
+
+    if (provider)
+    {
+        static_d->provider  = provider;
+    }
+
+    return true;
+}
+
 void ThumbnailLoadThread::setDisplayingWidget(QWidget* const widget)
 {
     static_d->profile = IccManager::displayProfile(widget);
@@ -253,16 +282,9 @@ bool ThumbnailLoadThread::find(const ThumbnailIdentifier& identifier,
 
     QString cacheKey = description.cacheKey();
 
-    {
-        LoadingCache* const cache = LoadingCache::cache();
-        LoadingCache::CacheLock lock(cache);
-        const QPixmap* cachePix   = cache->retrieveThumbnailPixmap(cacheKey);
+    // The pixmap store is looked-up without the CacheLock, the GUI does not wait on loading threads.
 
-        if (cachePix)
-        {
-            pix = *cachePix;
-        }
-    }
+    LoadingCache::cache()->findThumbnailPixmap(cacheKey, pix);
 
     if (!pix.isNull())
     {
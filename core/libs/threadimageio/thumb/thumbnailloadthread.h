@@ -59,6 +59,15 @@ public:
      */
     static void initializeThumbnailDatabase(const DbEngineParameters& params, ThumbnailInfoProvider* const provider = nullptr);
 
+    /**
+     * Enable loading of thumbnails from a memory-mapped pack file in the given directory,
+     * instead of the thumbnail database. See ThumbnailPackFile.
+     * This shall be called once at application startup, after initializeThumbnailDatabase() if any.
+     * The thumbnail info provider is changed only if one is given.
+     * Return false if the pack file cannot be opened.
+     */
+    static bool initializeThumbnailPackFile(const QString& dirPath, ThumbnailInfoProvider* const provider = nullptr);
+
     /**
      * For color management, this sets the widget the thumbnails will be color managed for.
      * (currently it is only possible to set one global widget)
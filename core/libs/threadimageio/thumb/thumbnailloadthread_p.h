@@ -42,6 +42,8 @@
 #include "thumbsdbaccess.h"
 #include "thumbnailsize.h"
 #include "thumbnailcreator.h"
+#include "thumbnailpackfile.h"
+#include "thumbnailwritequeue.h"
 
 namespace Digikam
 {
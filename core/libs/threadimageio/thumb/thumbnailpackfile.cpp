@@ -0,0 +1,1136 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Memory-mapped pack file storing PGF thumbnails
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "thumbnailpackfile.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <cstring>
+
+// Qt includes
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVector>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "pgfutils.h"
+#include "thumbsdb.h"
+
+#ifdef Q_OS_WIN
+#   include <windows.h>
+#else
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+namespace Digikam
+{
+
+namespace
+{
+
+const char    s_indexMagic[8]   = { 'D', 'K', 'T', 'H', 'P', 'I', 'D', 'X' };
+const char    s_dataMagic[8]    = { 'D', 'K', 'T', 'H', 'P', 'D', 'A', 'T' };
+const quint32 s_version         = 2;
+const quint32 s_minSlots        = 4096;
+
+/**
+ * Number of records appended before they are synced to the disk and published in the index.
+ */
+const int     s_syncRecords     = 32;
+
+/**
+ * The data file is mapped by segments. A record never crosses a segment boundary,
+ * so the data file grows without mapping again what is already mapped.
+ */
+const qint64  s_segmentSize     = 64 * 1024 * 1024;
+const qint64  s_dataHeaderSize  = 16;
+
+struct IndexHeader
+{
+    char    magic[8];
+    quint32 version;
+    quint32 slotCount;          ///< Always a power of 2.
+    quint32 usedSlots;
+    quint32 generation;         ///< Number of the data file in use.
+    quint64 dataEnd;
+    quint8  reserved[32];
+};
+
+struct IndexSlot
+{
+    quint64 key;                ///< 0 for an empty slot.
+    quint64 offset;
+    quint32 length;             ///< 0 for a removed thumbnail.
+    quint32 reserved;
+};
+
+struct RecordHeader
+{
+    quint64 key;
+    qint64  modificationDate;   ///< Milliseconds since epoch.
+    quint32 width;
+    quint32 height;
+    quint32 type;               ///< DatabaseThumbnail::Type of the data.
+    qint32  orientationHint;
+    quint32 dataBytes;
+    quint32 reserved;
+    quint64 secondKey;          ///< The file path key when the first one is the unique hash key.
+};
+
+static_assert(sizeof(IndexHeader)  == 64, "Unexpected index header size");
+static_assert(sizeof(IndexSlot)    == 24, "Unexpected index slot size");
+static_assert(sizeof(RecordHeader) == 48, "Unexpected record header size");
+
+quint64 packKey(const QString& identifier)
+{
+    // FNV-1a: stable between sessions, unlike qHash() which is seeded per process.
+
+    quint64 hash       = 14695981039346656037ULL;
+    const uchar* bytes = reinterpret_cast<const uchar*>(identifier.constData());
+    const int size     = identifier.size() * (int)sizeof(QChar);
+
+    for (int i = 0 ; i < size ; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return (hash ? hash : 1);
+}
+
+/**
+ * The keys of a thumbnail, in look-up order.
+ */
+QList<quint64> packKeys(const ThumbnailInfo& info)
+{
+    QList<quint64> keys;
+
+    if (!info.customIdentifier.isEmpty())
+    {
+        keys << packKey(QLatin1String("c:") + info.customIdentifier);
+
+        return keys;
+    }
+
+    if (!info.uniqueHash.isEmpty())
+    {
+        keys << packKey(QString::fromLatin1("h:%1:%2").arg(info.uniqueHash).arg(info.fileSize));
+    }
+
+    if (!info.filePath.isEmpty())
+    {
+        keys << packKey(QLatin1String("p:") + info.filePath);
+    }
+
+    return keys;
+}
+
+/**
+ * Write to the disk the pages of a memory mapped range, and wait for the end of the write.
+ */
+bool syncMapped(uchar* const address, qint64 length)
+{
+
+#ifdef Q_OS_WIN
+
+    return FlushViewOfFile(address, (SIZE_T)length);
+
+#else
+
+    const quintptr pageSize = (quintptr)sysconf(_SC_PAGESIZE);
+    const quintptr start    = (quintptr)address & ~(pageSize - 1);
+
+    return (msync(reinterpret_cast<void*>(start), (size_t)((quintptr)address + length - start), MS_SYNC) == 0);
+
+#endif
+
+}
+
+quint32 slotCountFor(int entries)
+{
+    quint32 count = s_minSlots;
+
+    while (count < (quint32)entries * 2)
+    {
+        count *= 2;
+    }
+
+    return count;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThumbnailPackFile::Private
+{
+public:
+
+    Private() = default;
+
+    QString indexPath()                                                     const
+    {
+        return (dirPath + QLatin1String("/thumbnails.idx"));
+    }
+
+    QString dataPath(quint32 generation)                                    const
+    {
+        return (dirPath + QString::fromLatin1("/thumbnails-%1.pack").arg(generation));
+    }
+
+    IndexSlot* slots()                                                      const
+    {
+        return reinterpret_cast<IndexSlot*>(index + sizeof(IndexHeader));
+    }
+
+    uchar* dataAt(qint64 offset)                                            const
+    {
+        return (segments.at(offset / s_segmentSize) + (offset % s_segmentSize));
+    }
+
+    static IndexSlot* findSlot(IndexHeader* const hdr, IndexSlot* const table, quint64 key);
+
+    bool openIndex();
+    bool openData();
+    bool reset();
+    void closeIndex();
+    void retireData();
+
+    /**
+     * Create a new index file with the given slots, and replace the current one.
+     */
+    bool writeIndex(quint32 slotCount, quint32 generation, quint64 dataEnd,
+                    const QVector<IndexSlot>& liveSlots);
+
+    /**
+     * Create a new data file, mapping its first segment.
+     */
+    static QFile* createData(const QString& path, QVector<uchar*>& maps);
+    static bool   growData(QFile* const file, QVector<uchar*>& maps, qint64 end);
+
+    const RecordHeader* record(const IndexSlot& slot)                       const;
+
+    /**
+     * Look-up the record of a thumbnail, pending or published. The lock must be held
+     * while the record, which points into the mapped memory, is used.
+     */
+    const RecordHeader* findRecord(const ThumbnailInfo& info)               const;
+    QVector<IndexSlot>  liveSlots()                                         const;
+
+    /**
+     * Write to the disk the records appended since the last call, then write their slots
+     * in the index. The write lock must be held.
+     */
+    bool publish();
+
+    /**
+     * Write to the disk the data file from 'begin' up to 'end'.
+     */
+    static bool syncData(const QVector<uchar*>& maps, quint64 begin, quint64 end);
+
+public:
+
+    mutable QReadWriteLock lock;
+
+    QString                dirPath;
+
+    QFile                  indexFile;
+    uchar*                 index        = nullptr;
+    IndexHeader*           header       = nullptr;
+
+    QFile*                 dataFile     = nullptr;
+    QVector<uchar*>        segments;
+
+    quint64                dataEnd      = 0;        ///< End of the records, published or not.
+    QHash<quint64, IndexSlot> pending;              ///< Slots of the records not yet published, by key.
+    int                    pendingRecords = 0;
+};
+
+IndexSlot* ThumbnailPackFile::Private::findSlot(IndexHeader* const hdr, IndexSlot* const table, quint64 key)
+{
+    // Linear probing. Return the slot of the key, or the empty slot where to insert it.
+
+    const quint32 mask = hdr->slotCount - 1;
+
+    for (quint32 i = 0, pos = (quint32)(key & mask) ; i < hdr->slotCount ; ++i, pos = (pos + 1) & mask)
+    {
+        if ((table[pos].key == key) || (table[pos].key == 0))
+        {
+            return &table[pos];
+        }
+    }
+
+    return nullptr;
+}
+
+const RecordHeader* ThumbnailPackFile::Private::record(const IndexSlot& slot) const
+{
+    if (
+        (slot.length < sizeof(RecordHeader))                                 ||
+        (slot.offset < (quint64)s_dataHeaderSize)                            ||
+        ((slot.offset + slot.length) > dataEnd)                              ||
+        (((slot.offset % s_segmentSize) + slot.length) > (quint64)s_segmentSize)
+       )
+    {
+        return nullptr;
+    }
+
+    const RecordHeader* const rec = reinterpret_cast<const RecordHeader*>(dataAt(slot.offset));
+
+    if (
+        ((rec->key != slot.key) && (rec->secondKey != slot.key))                 ||
+        ((quint64)rec->dataBytes + sizeof(RecordHeader) > slot.length)
+       )
+    {
+        return nullptr;
+    }
+
+    return rec;
+}
+
+const RecordHeader* ThumbnailPackFile::Private::findRecord(const ThumbnailInfo& info) const
+{
+    if (!index)
+    {
+        return nullptr;
+    }
+
+    const QList<quint64> keys = packKeys(info);
+
+    for (quint64 key : keys)
+    {
+        // A pending slot is newer than the published one.
+
+        QHash<quint64, IndexSlot>::const_iterator it = pending.constFind(key);
+        const IndexSlot* slot                        = nullptr;
+
+        if (it != pending.constEnd())
+        {
+            slot = &it.value();
+        }
+        else
+        {
+            slot = findSlot(header, slots(), key);
+        }
+
+        if (!slot || (slot->key != key) || !slot->length)
+        {
+            continue;
+        }
+
+        const RecordHeader* const rec = record(*slot);
+
+        if (rec && (rec->type == DatabaseThumbnail::PGF))
+        {
+            return rec;
+        }
+    }
+
+    return nullptr;
+}
+
+QVector<IndexSlot> ThumbnailPackFile::Private::liveSlots() const
+{
+    QVector<IndexSlot> live;
+    const IndexSlot* const table = slots();
+
+    for (quint32 i = 0 ; i < header->slotCount ; ++i)
+    {
+        if (table[i].key && table[i].length && !pending.contains(table[i].key))
+        {
+            live << table[i];
+        }
+    }
+
+    for (const IndexSlot& slot : pending)
+    {
+        if (slot.length)
+        {
+            live << slot;
+        }
+    }
+
+    return live;
+}
+
+bool ThumbnailPackFile::Private::publish()
+{
+    if (pending.isEmpty())
+    {
+        return true;
+    }
+
+    // The records must be on the disk before the index points to them, else a crash
+    // can leave an index slot pointing to incomplete data. They are synced by groups,
+    // as a sync for each thumbnail would stall the readers waiting for the lock.
+
+    if (!syncData(segments, header->dataEnd, dataEnd))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot write" << pendingRecords << "thumbnails in the pack file";
+
+        pending.clear();
+        pendingRecords = 0;
+
+        return false;
+    }
+
+    header->dataEnd = dataEnd;
+
+    for (const IndexSlot& pslot : std::as_const(pending))
+    {
+        IndexSlot* const slot = findSlot(header, slots(), pslot.key);
+
+        if (!slot)
+        {
+            continue;
+        }
+
+        if (!slot->key)
+        {
+            slot->key = pslot.key;
+            header->usedSlots++;
+        }
+
+        slot->offset = pslot.offset;
+        slot->length = pslot.length;
+    }
+
+    pending.clear();
+    pendingRecords = 0;
+
+    // Keep the load factor under 70 %.
+
+    if ((quint64)header->usedSlots * 10 > (quint64)header->slotCount * 7)
+    {
+        const QVector<IndexSlot> live = liveSlots();
+
+        if (!writeIndex(slotCountFor(live.count()), header->generation, header->dataEnd, live))
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot grow the thumbnails pack index";
+        }
+    }
+
+    return true;
+}
+
+void ThumbnailPackFile::Private::closeIndex()
+{
+    if (index)
+    {
+        indexFile.unmap(index);
+    }
+
+    indexFile.close();
+    index  = nullptr;
+    header = nullptr;
+}
+
+void ThumbnailPackFile::Private::retireData()
+{
+    // The mapped data are only read under the lock, and find() returns decoded images:
+    // with the write lock held, no reader remains and the file can be unmapped at once.
+
+    if (dataFile)
+    {
+        for (uchar* const map : std::as_const(segments))
+        {
+            dataFile->unmap(map);
+        }
+
+        dataFile->close();
+        delete dataFile;
+    }
+
+    dataFile = nullptr;
+    segments.clear();
+}
+
+bool ThumbnailPackFile::Private::syncData(const QVector<uchar*>& maps, quint64 begin, quint64 end)
+{
+    bool ok = true;
+
+    for (quint64 pos = begin ; pos < end ; )
+    {
+        const int     i    = (int)(pos / s_segmentSize);
+        const quint64 next = qMin(end, (quint64)(i + 1) * s_segmentSize);
+
+        if (i >= maps.size())
+        {
+            return false;
+        }
+
+        ok                &= syncMapped(maps.at(i) + (pos % s_segmentSize), (qint64)(next - pos));
+        pos                = next;
+    }
+
+    return ok;
+}
+
+bool ThumbnailPackFile::Private::openIndex()
+{
+    indexFile.setFileName(indexPath());
+
+    if (!indexFile.open(QIODevice::ReadWrite) || (indexFile.size() < (qint64)sizeof(IndexHeader)))
+    {
+        closeIndex();
+
+        return false;
+    }
+
+    index  = indexFile.map(0, indexFile.size());
+    header = reinterpret_cast<IndexHeader*>(index);
+
+    if (
+        !index                                                                               ||
+        (memcmp(header->magic, s_indexMagic, sizeof(s_indexMagic)) != 0)                     ||
+        (header->version != s_version)                                                       ||
+        (header->slotCount < s_minSlots)                                                     ||
+        (header->slotCount & (header->slotCount - 1))                                        ||
+        (indexFile.size() != (qint64)(sizeof(IndexHeader) + header->slotCount * sizeof(IndexSlot)))
+       )
+    {
+        closeIndex();
+
+        return false;
+    }
+
+    return true;
+}
+
+bool ThumbnailPackFile::Private::openData()
+{
+    QFile* const file = new QFile(dataPath(header->generation));
+
+    if (
+        !file->open(QIODevice::ReadWrite)                   ||
+        (file->size() < (qint64)header->dataEnd)            ||
+        (file->size() < s_segmentSize)                      ||
+        (file->size() % s_segmentSize)
+       )
+    {
+        delete file;
+
+        return false;
+    }
+
+    QVector<uchar*> maps;
+
+    for (qint64 offset = 0 ; offset < file->size() ; offset += s_segmentSize)
+    {
+        uchar* const map = file->map(offset, s_segmentSize);
+
+        if (!map)
+        {
+            delete file;
+
+            return false;
+        }
+
+        maps << map;
+    }
+
+    if (memcmp(maps.first(), s_dataMagic, sizeof(s_dataMagic)) != 0)
+    {
+        delete file;
+
+        return false;
+    }
+
+    dataFile = file;
+    segments = maps;
+
+    return true;
+}
+
+QFile* ThumbnailPackFile::Private::createData(const QString& path, QVector<uchar*>& maps)
+{
+    QFile* const file = new QFile(path);
+    maps.clear();
+
+    if (!file->open(QIODevice::ReadWrite | QIODevice::Truncate) || !growData(file, maps, s_dataHeaderSize))
+    {
+        delete file;
+
+        return nullptr;
+    }
+
+    memcpy(maps.first(), s_dataMagic, sizeof(s_dataMagic));
+    memcpy(maps.first() + sizeof(s_dataMagic), &s_version, sizeof(s_version));
+
+    return file;
+}
+
+bool ThumbnailPackFile::Private::growData(QFile* const file, QVector<uchar*>& maps, qint64 end)
+{
+    while ((qint64)maps.size() * s_segmentSize < end)
+    {
+        const qint64 offset = (qint64)maps.size() * s_segmentSize;
+
+        if (!file->resize(offset + s_segmentSize))
+        {
+            return false;
+        }
+
+        uchar* const map = file->map(offset, s_segmentSize);
+
+        if (!map)
+        {
+            return false;
+        }
+
+        maps << map;
+    }
+
+    return true;
+}
+
+bool ThumbnailPackFile::Private::writeIndex(quint32 slotCount, quint32 generation, quint64 dataEnd,
+                                            const QVector<IndexSlot>& liveSlots)
+{
+    const QString newPath = indexPath() + QLatin1String(".new");
+    QFile newFile(newPath);
+
+    if (!newFile.open(QIODevice::ReadWrite | QIODevice::Truncate) ||
+        !newFile.resize(sizeof(IndexHeader) + (qint64)slotCount * sizeof(IndexSlot)))
+    {
+        return false;
+    }
+
+    uchar* const map = newFile.map(0, newFile.size());
+
+    if (!map)
+    {
+        return false;
+    }
+
+    memset(map, 0, newFile.size());
+
+    IndexHeader* const hdr   = reinterpret_cast<IndexHeader*>(map);
+    IndexSlot* const   table = reinterpret_cast<IndexSlot*>(map + sizeof(IndexHeader));
+
+    memcpy(hdr->magic, s_indexMagic, sizeof(s_indexMagic));
+    hdr->version    = s_version;
+    hdr->slotCount  = slotCount;
+    hdr->generation = generation;
+    hdr->dataEnd    = dataEnd;
+
+    for (const IndexSlot& slot : liveSlots)
+    {
+        IndexSlot* const target = findSlot(hdr, table, slot.key);
+        *target                 = slot;
+        hdr->usedSlots++;
+    }
+
+    // The new index must be on the disk before it replaces the current one.
+
+    const bool synced = syncMapped(map, newFile.size());
+
+    newFile.unmap(map);
+    newFile.close();
+
+    if (!synced)
+    {
+        QFile::remove(newPath);
+
+        return false;
+    }
+
+    // Replace the current index. Nothing outside of this class points into the index.
+
+    closeIndex();
+    QFile::remove(indexPath());
+
+    if (!QFile::rename(newPath, indexPath()))
+    {
+        return false;
+    }
+
+    return openIndex();
+}
+
+bool ThumbnailPackFile::Private::reset()
+{
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Create new thumbnails pack files in" << dirPath;
+
+    closeIndex();
+    retireData();
+
+    pending.clear();
+    pendingRecords           = 0;
+
+    const quint32 generation = 1;
+    QVector<uchar*> maps;
+    QFile* const file        = createData(dataPath(generation), maps);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    if (!writeIndex(s_minSlots, generation, s_dataHeaderSize, QVector<IndexSlot>()))
+    {
+        delete file;
+
+        return false;
+    }
+
+    dataFile = file;
+    segments = maps;
+    dataEnd  = header->dataEnd;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThumbnailPackFileCreator
+{
+public:
+
+    ThumbnailPackFile object;
+};
+
+Q_GLOBAL_STATIC(ThumbnailPackFileCreator, thumbnailPackFileCreator)
+
+// -----------------------------------------------------------------------------------------------
+
+ThumbnailPackFile* ThumbnailPackFile::instance()
+{
+    return &thumbnailPackFileCreator->object;
+}
+
+ThumbnailPackFile::ThumbnailPackFile()
+    : d(new Private)
+{
+}
+
+ThumbnailPackFile::~ThumbnailPackFile()
+{
+    if (d->index)
+    {
+        d->publish();
+    }
+
+    d->closeIndex();
+    d->retireData();
+
+    delete d;
+}
+
+bool ThumbnailPackFile::open(const QString& dirPath)
+{
+    QWriteLocker lock(&d->lock);
+
+    if (d->index && (d->dirPath == dirPath))
+    {
+        return true;
+    }
+
+    if (d->index)
+    {
+        d->publish();
+    }
+
+    d->closeIndex();
+    d->retireData();
+
+    d->dirPath = dirPath;
+
+    if (!QDir().mkpath(dirPath))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot create thumbnails pack directory" << dirPath;
+
+        return false;
+    }
+
+    if (!d->openIndex() || !d->openData())
+    {
+        if (!d->reset())
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot create thumbnails pack files in" << dirPath;
+            d->closeIndex();
+            d->retireData();
+
+            return false;
+        }
+    }
+
+    d->dataEnd = d->header->dataEnd;
+    d->pending.clear();
+    d->pendingRecords = 0;
+
+    // Remove the data files left by an interrupted compaction.
+
+    const QString current     = QFileInfo(d->dataPath(d->header->generation)).fileName();
+    const QStringList entries = QDir(dirPath).entryList(QStringList() << QLatin1String("thumbnails-*.pack"), QDir::Files);
+
+    for (const QString& entry : entries)
+    {
+        if (entry != current)
+        {
+            QFile::remove(dirPath + QLatin1Char('/') + entry);
+        }
+    }
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Thumbnails pack file ready for use:" << d->dataPath(d->header->generation)
+                                 << "(" << d->header->dataEnd << "bytes )";
+
+    return true;
+}
+
+void ThumbnailPackFile::close()
+{
+    QWriteLocker lock(&d->lock);
+
+    if (d->index)
+    {
+        d->publish();
+    }
+
+    d->closeIndex();
+    d->retireData();
+    d->dirPath.clear();
+}
+
+bool ThumbnailPackFile::isOpen() const
+{
+    QReadLocker lock(&d->lock);
+
+    return (d->index != nullptr);
+}
+
+QString ThumbnailPackFile::path() const
+{
+    QReadLocker lock(&d->lock);
+
+    return d->dirPath;
+}
+
+bool ThumbnailPackFile::contains(const ThumbnailInfo& info, QDateTime& modificationDate) const
+{
+    QReadLocker lock(&d->lock);
+
+    const RecordHeader* const rec = d->findRecord(info);
+
+    if (!rec)
+    {
+        return false;
+    }
+
+    modificationDate              = QDateTime::fromMSecsSinceEpoch(rec->modificationDate);
+
+    return true;
+}
+
+bool ThumbnailPackFile::find(const ThumbnailInfo& info,
+                             QImage& image,
+                             QDateTime& modificationDate,
+                             int& orientationHint) const
+{
+    QReadLocker lock(&d->lock);
+
+    const RecordHeader* const rec = d->findRecord(info);
+
+    if (!rec)
+    {
+        return false;
+    }
+
+    modificationDate              = QDateTime::fromMSecsSinceEpoch(rec->modificationDate);
+    orientationHint               = rec->orientationHint;
+
+    // Decode straight from the mapped memory, without copying the compressed data. The other
+    // readers go on meanwhile: only a writer waits for the end of the decoding.
+
+    const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(rec) + sizeof(RecordHeader),
+                                                    rec->dataBytes);
+
+    if (!PGFUtils::readPGFImageData(data, image))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot load PGF thumb from pack file";
+
+        return false;
+    }
+
+    return !image.isNull();
+}
+
+bool ThumbnailPackFile::store(const ThumbnailInfo& info,
+                              const QImage& qimage,
+                              const QDateTime& modificationDate,
+                              int orientationHint)
+{
+    const QList<quint64> keys = packKeys(info);
+
+    if (keys.isEmpty() || qimage.isNull())
+    {
+        return false;
+    }
+
+    // Compressed as in the thumbnails database. NOTE: see bug #233094: using PGF
+    // compression level 4 there. Do not use a value > 4, else image is blurred due to down-sampling.
+
+    QByteArray data;
+
+    if (!PGFUtils::writePGFImageData(qimage, data, 4))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot save PGF thumb in pack file";
+
+        return false;
+    }
+
+    const quint64 length = ((sizeof(RecordHeader) + data.size() + 15) / 16) * 16;
+
+    if (length > (quint64)s_segmentSize)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Thumbnail too large for the pack file:" << qimage.size();
+
+        return false;
+    }
+
+    QWriteLocker lock(&d->lock);
+
+    if (!d->index)
+    {
+        return false;
+    }
+
+    // Append the record, in the next segment if it does not fit in the current one.
+
+    quint64 offset = d->dataEnd;
+
+    if (((offset % s_segmentSize) + length) > (quint64)s_segmentSize)
+    {
+        offset = ((offset / s_segmentSize) + 1) * s_segmentSize;
+    }
+
+    if (!Private::growData(d->dataFile, d->segments, offset + length))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot grow the thumbnails pack file";
+
+        return false;
+    }
+
+    RecordHeader rec;
+    memset(&rec, 0, sizeof(RecordHeader));
+    rec.key              = keys.first();
+    rec.secondKey        = (keys.count() > 1) ? keys.at(1) : 0;
+    rec.modificationDate = modificationDate.isValid() ? modificationDate.toMSecsSinceEpoch() : 0;
+    rec.width            = qimage.width();
+    rec.height           = qimage.height();
+    rec.type             = DatabaseThumbnail::PGF;
+    rec.orientationHint  = orientationHint;
+    rec.dataBytes        = data.size();
+
+    uchar* const target  = d->dataAt(offset);
+    memcpy(target, &rec, sizeof(RecordHeader));
+    memcpy(target + sizeof(RecordHeader), data.constData(), data.size());
+
+    d->dataEnd           = offset + length;
+
+    // All keys point to the same record. The slots are readable at once, and written
+    // in the index when the group of records is synced to the disk.
+
+    for (quint64 key : keys)
+    {
+        IndexSlot slot;
+        memset(&slot, 0, sizeof(IndexSlot));
+        slot.key    = key;
+        slot.offset = offset;
+        slot.length = length;
+
+        d->pending.insert(key, slot);
+    }
+
+    if (++d->pendingRecords < s_syncRecords)
+    {
+        return true;
+    }
+
+    return d->publish();
+}
+
+void ThumbnailPackFile::remove(const ThumbnailInfo& info)
+{
+    const QList<quint64> keys = packKeys(info);
+
+    QWriteLocker lock(&d->lock);
+
+    if (!d->index)
+    {
+        return;
+    }
+
+    for (quint64 key : keys)
+    {
+        d->pending.remove(key);
+
+        IndexSlot* const slot = Private::findSlot(d->header, d->slots(), key);
+
+        if (slot && (slot->key == key))
+        {
+            slot->offset = 0;
+            slot->length = 0;
+        }
+    }
+}
+
+bool ThumbnailPackFile::compact()
+{
+    QWriteLocker lock(&d->lock);
+
+    if (!d->index || !d->publish())
+    {
+        return false;
+    }
+
+    const quint64 before     = d->header->dataEnd;
+    QVector<IndexSlot> live  = d->liveSlots();
+
+    std::sort(live.begin(), live.end(),
+              [](const IndexSlot& a, const IndexSlot& b)
+              {
+                  return (a.offset < b.offset);
+              }
+    );
+
+    const quint32 generation = d->header->generation + 1;
+    QVector<uchar*> maps;
+    QFile* const file        = Private::createData(d->dataPath(generation), maps);
+
+    if (!file)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot create the compacted thumbnails pack file";
+
+        return false;
+    }
+
+    // Copy each live record once, even if several keys point to it.
+
+    QHash<quint64, quint64> moved;
+    quint64 end              = s_dataHeaderSize;
+
+    for (IndexSlot& slot : live)
+    {
+        QHash<quint64, quint64>::const_iterator it = moved.constFind(slot.offset);
+
+        if (it != moved.constEnd())
+        {
+            slot.offset = it.value();
+            continue;
+        }
+
+        quint64 offset = end;
+
+        if (((offset % s_segmentSize) + slot.length) > (quint64)s_segmentSize)
+        {
+            offset = ((offset / s_segmentSize) + 1) * s_segmentSize;
+        }
+
+        if (!Private::growData(file, maps, offset + slot.length))
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot grow the compacted thumbnails pack file";
+            file->remove();
+            delete file;
+
+            return false;
+        }
+
+        memcpy(maps.at(offset / s_segmentSize) + (offset % s_segmentSize), d->dataAt(slot.offset), slot.length);
+
+        moved.insert(slot.offset, offset);
+        slot.offset = offset;
+        end         = offset + slot.length;
+    }
+
+    // The records must be on the disk before the new index points to them.
+
+    if (!Private::syncData(maps, 0, end))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot write the compacted thumbnails pack file";
+        file->remove();
+        delete file;
+
+        return false;
+    }
+
+    const QString oldPath = d->dataPath(d->header->generation);
+
+    if (!d->writeIndex(slotCountFor(live.count()), generation, end, live))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot write the compacted thumbnails pack index";
+        file->remove();
+        delete file;
+
+        // The pack file is closed if the previous index was already replaced.
+
+        if (!d->index)
+        {
+            d->retireData();
+        }
+
+        return false;
+    }
+
+    d->retireData();
+    d->dataFile = file;
+    d->segments = maps;
+    d->dataEnd  = end;
+    QFile::remove(oldPath);
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Thumbnails pack file compacted from" << before << "to" << end << "bytes";
+
+    return true;
+}
+
+int ThumbnailPackFile::count() const
+{
+    QReadLocker lock(&d->lock);
+
+    if (!d->index)
+    {
+        return 0;
+    }
+
+    QSet<quint64> records;
+    const QVector<IndexSlot> live = d->liveSlots();
+
+    for (const IndexSlot& slot : live)
+    {
+        records << slot.offset;
+    }
+
+    return records.count();
+}
+
+qint64 ThumbnailPackFile::dataSize() const
+{
+    QReadLocker lock(&d->lock);
+
+    return (d->index ? (qint64)d->dataEnd : 0);
+}
+
+} // namespace Digikam
@@ -0,0 +1,108 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Memory-mapped pack file storing PGF thumbnails
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QDateTime>
+#include <QImage>
+#include <QString>
+
+// Local includes
+
+#include "digikam_export.h"
+#include "thumbnailinfo.h"
+
+namespace Digikam
+{
+
+/**
+ * An alternative to the thumbnails database: thumbnails are stored compressed with PGF,
+ * as in the database, in an append-only data file mapped in memory. A fixed-size index
+ * file, also mapped in memory, is an open addressing hash table giving the offset
+ * and the length of each record from a 64 bits key computed from the thumbnail
+ * identifiers (custom identifier, unique hash and file size, file path).
+ *
+ * Loading a thumbnail is a hash table look-up and the PGF decoding of the mapped data,
+ * without copy: no SQL query and no database lock shared with the other threads.
+ *
+ * New records are readable at once, and are written to the disk by groups before the
+ * index points to them: a crash can lose the last thumbnails stored, but never leaves
+ * an index slot pointing to incomplete data.
+ *
+ * Replaced and removed thumbnails stay in the data file until compact() is called.
+ * All methods are thread-safe.
+ */
+class DIGIKAM_EXPORT ThumbnailPackFile
+{
+public:
+
+    static ThumbnailPackFile* instance();
+
+    /**
+     * Open, or create, the pack files in the given directory.
+     */
+    bool open(const QString& dirPath);
+    void close();
+    bool isOpen()                                                           const;
+    QString path()                                                          const;
+
+    /**
+     * Look-up a thumbnail, with the same precedence of identifiers as the thumbnails database.
+     */
+    bool find(const ThumbnailInfo& info,
+              QImage& image,
+              QDateTime& modificationDate,
+              int& orientationHint)                                         const;
+
+    /**
+     * Look-up a thumbnail without decoding it, and give its modification date.
+     */
+    bool contains(const ThumbnailInfo& info, QDateTime& modificationDate)   const;
+
+    bool store(const ThumbnailInfo& info,
+               const QImage& image,
+               const QDateTime& modificationDate,
+               int orientationHint);
+
+    void remove(const ThumbnailInfo& info);
+
+    /**
+     * Rewrite the data file with the live thumbnails only, and rebuild the index.
+     * The previous data file is unmapped and removed.
+     */
+    bool compact();
+
+    int    count()                                                          const;
+    qint64 dataSize()                                                       const;
+
+private:
+
+    // Disable
+    ThumbnailPackFile();
+    ~ThumbnailPackFile();
+
+    explicit ThumbnailPackFile(const ThumbnailPackFile&) = delete;
+    ThumbnailPackFile& operator=(const ThumbnailPackFile&) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+
+    friend class ThumbnailPackFileCreator;
+};
+
+} // namespace Digikam
@@ -93,50 +93,51 @@ void ThumbnailLoadingTask::execute()
     }
 
     LoadingCache* const cache = LoadingCache::cache();
+
+    // find possible cached images, without contending on the CacheLock
+
+    cache->findThumbnail(m_loadingDescription.cacheKey(), m_qimage);
+
+    if (m_qimage.isNull())
     {
         LoadingCache::CacheLock lock(cache);
 
-        // find possible cached images
-
-        const QImage* const cachedImage = cache->retrieveThumbnail(m_loadingDescription.cacheKey());
+        // A loading process puts its thumbnail in the cache and leaves the list of
+        // loading processes under the CacheLock: look again, else a thumbnail which
+        // has just been finished would be generated a second time.
 
-        if (cachedImage)
-        {
-            m_qimage = *cachedImage;
-        }
+        cache->peekThumbnail(m_loadingDescription.cacheKey(), m_qimage);
 
-        if (m_qimage.isNull())
-        {
-            // find possible running loading process
-            // do not wait on other loading processes?
+        // find possible running loading process
+        // do not wait on other loading processes?
 
-            LoadingProcess* const usedProcess = cache->retrieveLoadingProcess(m_loadingDescription.cacheKey());
+        LoadingProcess* const usedProcess = m_qimage.isNull() ? cache->retrieveLoadingProcess(m_loadingDescription.cacheKey())
+                                                              : nullptr;
 
-            if (usedProcess)
-            {
-                // Other process is right now loading this image.
-                // Add this task to the list of listeners and
-                // attach this thread to the other thread, wait until loading
-                // has finished.
+        if (usedProcess)
+        {
+            // Other process is right now loading this image.
+            // Add this task to the list of listeners and
+            // attach this thread to the other thread, wait until loading
+            // has finished.
 
-                usedProcess->addListener(this);
+            usedProcess->addListener(this);
 
-                // break loop when either the loading has completed, or this task is being stopped
+            // break loop when either the loading has completed, or this task is being stopped
 
-                // cppcheck-suppress knownConditionTrueFalse
-                while ((m_loadingTaskStatus != LoadingTaskStatusStopping) && !usedProcess->completed())
-                {
-                    lock.timedWait();
-                }
+            // cppcheck-suppress knownConditionTrueFalse
+            while ((m_loadingTaskStatus != LoadingTaskStatusStopping) && !usedProcess->completed())
+            {
+                lock.timedWait();
+            }
 
-                // remove listener from process
+            // remove listener from process
 
-                usedProcess->removeListener(this);
+            usedProcess->removeListener(this);
 
-                // wake up the process which is waiting until all listeners have removed themselves
+            // wake up the process which is waiting until all listeners have removed themselves
 
-                lock.wakeAll();
-            }
+            lock.wakeAll();
         }
     }
 
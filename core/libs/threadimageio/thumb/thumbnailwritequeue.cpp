@@ -0,0 +1,564 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Write-behind queue grouping thumbnails database writes
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "thumbnailwritequeue.h"
+
+// Qt includes
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "thumbsdbaccess.h"
+#include "thumbsdbbackend.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN ThumbnailWriteQueue::Private
+{
+public:
+
+    class Entry
+    {
+    public:
+
+        ThumbnailInfo info;
+        ThumbsDbInfo  dbInfo;
+        qint64        queued = 0;
+    };
+
+public:
+
+    Private()
+    {
+        clock.start();
+
+        bool ok        = false;
+        int value      = qEnvironmentVariableIntValue("DIGIKAM_THUMBSDB_BATCH_SIZE", &ok);
+
+        if (ok)
+        {
+            batchSize  = qMax(1, value);
+        }
+
+        value          = qEnvironmentVariableIntValue("DIGIKAM_THUMBSDB_BATCH_LATENCY", &ok);
+
+        if (ok)
+        {
+            maxLatency = qMax(0, value);
+        }
+    }
+
+    static QStringList keysOf(const ThumbnailInfo& info);
+
+    /**
+     * Store a group of thumbnails in one transaction, or one by one if the transaction fails.
+     * Ids of inserted thumbnails are set in 'group'.
+     */
+    static bool writeGroup(QList<Entry>& group);
+    static BdEngineBackend::QueryState writeTransaction(ThumbsDbAccess& access, QList<Entry>& group);
+    static BdEngineBackend::QueryState writeEntry(ThumbsDbAccess& access, Entry& entry);
+
+    bool lookup(const QString& key, ThumbsDbInfo& dbInfo) const;
+    void removeEntry(quint64 seq);
+
+public:
+
+    mutable QMutex          mutex;
+    QWaitCondition          condVar;            ///< Wakes up the writer thread.
+    QWaitCondition          writtenCondVar;     ///< Wakes up the threads waiting for a group commit.
+
+    QMap<quint64, Entry>    entries;            ///< Queued thumbnails, in queuing order.
+    QHash<QString, quint64> keys;               ///< Identifier keys to queued thumbnails.
+    quint64                 lastSeq         = 0;
+
+    QElapsedTimer           clock;
+    int                     batchSize       = 100;
+    int                     maxLatency      = 500;
+    int                     flushRequests   = 0;
+    bool                    running         = false;
+    bool                    stopped         = false;
+};
+
+QStringList ThumbnailWriteQueue::Private::keysOf(const ThumbnailInfo& info)
+{
+    // Same identifiers as stored by ThumbnailCreator::storeInDatabase().
+
+    QStringList list;
+
+    if (!info.customIdentifier.isNull())
+    {
+        list << QLatin1String("c:") + info.customIdentifier;
+    }
+    else
+    {
+        if (!info.uniqueHash.isNull())
+        {
+            list << QString::fromLatin1("h:%1:%2").arg(info.uniqueHash).arg(info.fileSize);
+        }
+
+        if (!info.filePath.isNull())
+        {
+            list << QLatin1String("p:") + info.filePath;
+        }
+    }
+
+    return list;
+}
+
+bool ThumbnailWriteQueue::Private::lookup(const QString& key, ThumbsDbInfo& dbInfo) const
+{
+    QHash<QString, quint64>::const_iterator it = keys.constFind(key);
+
+    if (it == keys.constEnd())
+    {
+        return false;
+    }
+
+    dbInfo = entries.value(it.value()).dbInfo;
+
+    return true;
+}
+
+void ThumbnailWriteQueue::Private::removeEntry(quint64 seq)
+{
+    QMap<quint64, Entry>::iterator it = entries.find(seq);
+
+    if (it == entries.end())
+    {
+        return;
+    }
+
+    const QStringList entryKeys = keysOf(it->info);
+
+    for (const QString& key : entryKeys)
+    {
+        if (keys.value(key) == seq)
+        {
+            keys.remove(key);
+        }
+    }
+
+    entries.erase(it);
+}
+
+BdEngineBackend::QueryState ThumbnailWriteQueue::Private::writeEntry(ThumbsDbAccess& access, Entry& entry)
+{
+    BdEngineBackend::QueryState lastQueryState;
+
+    // Insert thumbnail data
+
+    if (entry.dbInfo.id == -1)
+    {
+        QVariant id;
+        lastQueryState = access.db()->insertThumbnail(entry.dbInfo, &id);
+
+        if (BdEngineBackend::NoErrors != lastQueryState)
+        {
+            return lastQueryState;
+        }
+
+        entry.dbInfo.id = id.toInt();
+    }
+    else
+    {
+        lastQueryState = access.db()->replaceThumbnail(entry.dbInfo);
+
+        if (BdEngineBackend::NoErrors != lastQueryState)
+        {
+            return lastQueryState;
+        }
+    }
+
+    // Insert lookup data used to locate thumbnail data
+
+    if (!entry.info.customIdentifier.isNull())
+    {
+        return access.db()->insertCustomIdentifier(entry.info.customIdentifier, entry.dbInfo.id);
+    }
+
+    if (!entry.info.uniqueHash.isNull())
+    {
+        lastQueryState = access.db()->insertUniqueHash(entry.info.uniqueHash, entry.info.fileSize, entry.dbInfo.id);
+
+        if (BdEngineBackend::NoErrors != lastQueryState)
+        {
+            return lastQueryState;
+        }
+    }
+
+    if (!entry.info.filePath.isNull())
+    {
+        lastQueryState = access.db()->insertFilePath(entry.info.filePath, entry.dbInfo.id);
+    }
+
+    return lastQueryState;
+}
+
+BdEngineBackend::QueryState ThumbnailWriteQueue::Private::writeTransaction(ThumbsDbAccess& access, QList<Entry>& group)
+{
+    BdEngineBackend::QueryState lastQueryState = BdEngineBackend::QueryState(BdEngineBackend::ConnectionError);
+    QList<Entry> attempt;
+
+    while (lastQueryState == BdEngineBackend::ConnectionError)
+    {
+        // Restart from the original ids: inserts of a failed transaction are lost.
+
+        attempt        = group;
+        lastQueryState = access.backend()->beginTransaction();
+
+        if (BdEngineBackend::NoErrors != lastQueryState)
+        {
+            continue;
+        }
+
+        for (Entry& entry : attempt)
+        {
+            lastQueryState = writeEntry(access, entry);
+
+            if (BdEngineBackend::NoErrors != lastQueryState)
+            {
+                break;
+            }
+        }
+
+        if (BdEngineBackend::NoErrors != lastQueryState)
+        {
+            // Do not leave the connection in the middle of the transaction.
+
+            access.backend()->rollbackTransaction();
+            continue;
+        }
+
+        // A failed commit is rolled back by the backend.
+
+        lastQueryState = access.backend()->commitTransaction();
+    }
+
+    if (BdEngineBackend::NoErrors == lastQueryState)
+    {
+        group = attempt;
+    }
+
+    return lastQueryState;
+}
+
+bool ThumbnailWriteQueue::Private::writeGroup(QList<Entry>& group)
+{
+    ThumbsDbAccess access;
+
+    if (BdEngineBackend::NoErrors == writeTransaction(access, group))
+    {
+        return true;
+    }
+
+    // One thumbnail which cannot be stored must not lose the others of the group:
+    // they are stored again one by one.
+
+    int failed = 0;
+
+    for (Entry& entry : group)
+    {
+        QList<Entry> single;
+        single << entry;
+
+        if (BdEngineBackend::NoErrors == writeTransaction(access, single))
+        {
+            entry = single.first();
+        }
+        else
+        {
+            ++failed;
+        }
+    }
+
+    if (failed)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot store" << failed << "of" << group.count() << "thumbnails in DB";
+
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThumbnailWriteQueueCreator
+{
+public:
+
+    ThumbnailWriteQueue object;
+};
+
+Q_GLOBAL_STATIC(ThumbnailWriteQueueCreator, thumbnailWriteQueueCreator)
+
+// -----------------------------------------------------------------------------------------------
+
+ThumbnailWriteQueue* ThumbnailWriteQueue::instance()
+{
+    return &thumbnailWriteQueueCreator->object;
+}
+
+ThumbnailWriteQueue::ThumbnailWriteQueue()
+    : QThread(),
+      d      (new Private)
+{
+    setObjectName(QLatin1String("ThumbnailWriteQueue"));
+}
+
+ThumbnailWriteQueue::~ThumbnailWriteQueue()
+{
+    {
+        QMutexLocker lock(&d->mutex);
+
+        if (!d->entries.isEmpty())
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << d->entries.count()
+                                           << "thumbnails not stored in DB: write queue not shut down";
+        }
+
+        d->running = false;
+        d->stopped = true;
+        d->condVar.wakeAll();
+    }
+
+    wait();
+
+    delete d;
+}
+
+void ThumbnailWriteQueue::setBatchSize(int size)
+{
+    QMutexLocker lock(&d->mutex);
+    d->batchSize = qMax(1, size);
+    d->condVar.wakeAll();
+}
+
+int ThumbnailWriteQueue::batchSize() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->batchSize;
+}
+
+void ThumbnailWriteQueue::setMaximumLatency(int msecs)
+{
+    QMutexLocker lock(&d->mutex);
+    d->maxLatency = qMax(0, msecs);
+    d->condVar.wakeAll();
+}
+
+int ThumbnailWriteQueue::maximumLatency() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->maxLatency;
+}
+
+void ThumbnailWriteQueue::enqueue(const ThumbnailInfo& info, const ThumbsDbInfo& dbInfo)
+{
+    Private::Entry entry;
+    entry.info   = info;
+    entry.dbInfo = dbInfo;
+
+    QMutexLocker lock(&d->mutex);
+
+    // Do not let the producers run too far ahead of the writer.
+
+    while ((d->entries.count() >= 4 * d->batchSize) && d->running)
+    {
+        d->writtenCondVar.wait(&d->mutex);
+    }
+
+    if ((d->batchSize <= 1) || d->stopped)
+    {
+        lock.unlock();
+
+        QList<Private::Entry> group;
+        group << entry;
+        Private::writeGroup(group);
+
+        return;
+    }
+
+    // A newer thumbnail for the same identifiers replaces the queued one.
+
+    const QStringList entryKeys = Private::keysOf(info);
+
+    for (const QString& key : entryKeys)
+    {
+        if (d->keys.contains(key))
+        {
+            d->removeEntry(d->keys.value(key));
+        }
+    }
+
+    entry.queued = d->clock.elapsed();
+    d->entries.insert(++d->lastSeq, entry);
+
+    for (const QString& key : entryKeys)
+    {
+        d->keys.insert(key, d->lastSeq);
+    }
+
+    if (!d->running)
+    {
+        d->running = true;
+        start(QThread::LowPriority);
+    }
+
+    d->condVar.wakeOne();
+}
+
+bool ThumbnailWriteQueue::findPending(const ThumbnailInfo& info, ThumbsDbInfo& dbInfo) const
+{
+    QMutexLocker lock(&d->mutex);
+
+    if (d->entries.isEmpty())
+    {
+        return false;
+    }
+
+    if (!info.customIdentifier.isEmpty())
+    {
+        return d->lookup(QLatin1String("c:") + info.customIdentifier, dbInfo);
+    }
+
+    if (!info.uniqueHash.isEmpty() &&
+        d->lookup(QString::fromLatin1("h:%1:%2").arg(info.uniqueHash).arg(info.fileSize), dbInfo))
+    {
+        return true;
+    }
+
+    if (!info.filePath.isEmpty())
+    {
+        return d->lookup(QLatin1String("p:") + info.filePath, dbInfo);
+    }
+
+    return false;
+}
+
+void ThumbnailWriteQueue::flush()
+{
+    QMutexLocker lock(&d->mutex);
+
+    if (!d->running || d->entries.isEmpty())
+    {
+        return;
+    }
+
+    // Only wait for the thumbnails queued up to now.
+
+    const quint64 lastSeq = d->lastSeq;
+    d->flushRequests++;
+    d->condVar.wakeAll();
+
+    while (d->running && !d->entries.isEmpty() && (d->entries.firstKey() <= lastSeq))
+    {
+        d->writtenCondVar.wait(&d->mutex);
+    }
+
+    d->flushRequests--;
+}
+
+void ThumbnailWriteQueue::shutDown()
+{
+    flush();
+
+    {
+        QMutexLocker lock(&d->mutex);
+        d->running = false;
+        d->stopped = true;
+        d->condVar.wakeAll();
+        d->writtenCondVar.wakeAll();
+    }
+
+    wait();
+}
+
+void ThumbnailWriteQueue::run()
+{
+    QMutexLocker lock(&d->mutex);
+
+    while (d->running)
+    {
+        if (d->entries.isEmpty())
+        {
+            d->condVar.wait(&d->mutex);
+            continue;
+        }
+
+        const qint64 age = d->clock.elapsed() - d->entries.first().queued;
+
+        if ((d->entries.count() < d->batchSize) && (age < d->maxLatency) && !d->flushRequests)
+        {
+            d->condVar.wait(&d->mutex, d->maxLatency - age);
+            continue;
+        }
+
+        QList<quint64>        seqs;
+        QList<Private::Entry> group;
+
+        for (QMap<quint64, Private::Entry>::const_iterator it = d->entries.constBegin() ;
+             (it != d->entries.constEnd()) && (group.count() < d->batchSize) ; ++it)
+        {
+            seqs  << it.key();
+            group << it.value();
+        }
+
+        // The group stays in the queue, and visible to findPending(), until committed.
+
+        lock.unlock();
+
+        Private::writeGroup(group);
+
+        lock.relock();
+
+        for (int i = 0 ; i < group.count() ; ++i)
+        {
+            // A thumbnail queued again while its first version was inserted must
+            // replace the new row, not insert another one.
+
+            const QStringList entryKeys = Private::keysOf(group.at(i).info);
+
+            for (const QString& key : entryKeys)
+            {
+                QMap<quint64, Private::Entry>::iterator it = d->entries.find(d->keys.value(key));
+
+                if ((it != d->entries.end()) && (it.key() != seqs.at(i)) && (it->dbInfo.id == -1))
+                {
+                    it->dbInfo.id = group.at(i).dbInfo.id;
+                }
+            }
+
+            d->removeEntry(seqs.at(i));
+        }
+
+        d->writtenCondVar.wakeAll();
+    }
+
+    d->writtenCondVar.wakeAll();
+}
+
+} // namespace Digikam
+
+#include "moc_thumbnailwritequeue.cpp"
@@ -0,0 +1,101 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Write-behind queue grouping thumbnails database writes
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QThread>
+
+// Local includes
+
+#include "digikam_export.h"
+#include "thumbnailinfo.h"
+#include "thumbsdb.h"
+
+namespace Digikam
+{
+
+/**
+ * Thumbnails created by all ThumbnailLoadThread workers are not written to the
+ * thumbnails database one by one, each in its own transaction: they are queued here
+ * and a writer thread stores them by groups, in one transaction per group.
+ *
+ * A group is written when the queue holds batchSize() thumbnails, or when the oldest
+ * queued thumbnail waits for more than maximumLatency() milliseconds.
+ * Default values can be changed with the DIGIKAM_THUMBSDB_BATCH_SIZE and
+ * DIGIKAM_THUMBSDB_BATCH_LATENCY environment variables. A batch size of 1 disables
+ * the queue: thumbnails are written at once, in the calling thread.
+ *
+ * A queued thumbnail stays visible to findPending() until its group is committed,
+ * so a thumbnail is never regenerated because it is not yet in the database.
+ */
+class DIGIKAM_EXPORT ThumbnailWriteQueue : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    static ThumbnailWriteQueue* instance();
+
+    /**
+     * Queue a thumbnail to store in the database. A thumbnail already queued
+     * for the same identifiers is replaced.
+     */
+    void enqueue(const ThumbnailInfo& info, const ThumbsDbInfo& dbInfo);
+
+    /**
+     * Look-up a queued thumbnail, with the same precedence of identifiers
+     * as the database look-up: custom identifier, unique hash, then file path.
+     */
+    bool findPending(const ThumbnailInfo& info, ThumbsDbInfo& dbInfo) const;
+
+    /**
+     * Write all queued thumbnails and wait until they are committed.
+     * To call before changing the thumbnails database from outside of the queue.
+     */
+    void flush();
+
+    /**
+     * Flush and stop the writer thread. Call it before the thumbnails database is closed.
+     */
+    void shutDown();
+
+    void setBatchSize(int size);
+    int  batchSize()                                    const;
+
+    void setMaximumLatency(int msecs);
+    int  maximumLatency()                               const;
+
+protected:
+
+    void run()                                          override;
+
+private:
+
+    // Disable
+    ThumbnailWriteQueue();
+    ~ThumbnailWriteQueue()                              override;
+
+    explicit ThumbnailWriteQueue(QObject*) = delete;
+
+private:
+
+    class Private;
+    Private* const d = nullptr;
+
+    friend class ThumbnailWriteQueueCreator;
+};
+
+} // namespace Digikam
@@ -44,6 +44,26 @@ EffectMngr::EffectType EffectMngr::Private::getRandomEffect() const
 
 void EffectMngr::Private::updateCurrentFrame(const QRectF& area)
 {
+    const bool scalable = (
+                           ((eff_image.format() == QImage::Format_ARGB32)  ||
+                            (eff_image.format() == QImage::Format_RGB32))  &&
+                           (eff_image.width()  >= 2)                       &&
+                           (eff_image.height() >= 2)                       &&
+                           !eff_outSize.isEmpty()
+                          );
+
+    if (scalable)
+    {
+        // Render the area in a reused frame buffer, without intermediate images.
+
+        QImage frame = eff_frames.take(eff_outSize);
+        FrameRender::scaleArea(frame, eff_image, area, eff_scaleBuffer);
+        eff_frames.recycle(eff_curFrame);
+        eff_curFrame = frame;
+
+        return;
+    }
+
     QImage kbImg = eff_image.copy(area.toAlignedRect())
                             .scaled(eff_outSize,
                                     Qt::KeepAspectRatioByExpanding,
@@ -17,6 +17,7 @@
 // C++ includes
 
 #include <cmath>
+#include <vector>
 
 // Qt includes
 
@@ -28,6 +29,7 @@
 // Local includes
 
 #include "effectmngr.h"
+#include "framerender.h"
 #include "digikam_config.h"
 #include "digikam_debug.h"
 
@@ -61,6 +63,9 @@ public:
     int                                           eff_step      = 0;
     int                                           eff_imgFrames = 125;
 
+    FrameBufferPool                               eff_frames;
+    std::vector<int>                              eff_scaleBuffer;
+
 public:
 
     void registerEffects();
@@ -0,0 +1,656 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : row-parallel and vectorized kernels to render
+ *               the frames of the transitions and the effects
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "framerender.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <cstring>
+
+// Qt includes
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent>    // krazy:exclude=includes
+
+// SIMD includes
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   include <immintrin.h>
+#   define FRAME_HAVE_SIMD
+#   define FRAME_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+
+namespace Digikam
+{
+
+namespace
+{
+
+/// Minimum amount of rows processed by a thread.
+static const int s_minChunkRows = 32;
+
+/// Amount of frame buffers kept to be reused.
+static const int s_poolSize     = 3;
+
+bool isFormat32(const QImage& img)
+{
+    return (
+            (img.format() == QImage::Format_RGB32) ||
+            (img.format() == QImage::Format_ARGB32)
+           );
+}
+
+/**
+ * Convert a premultiplied pixel to the channels in memory order of a little endian QRgb:
+ * blue, green, red and alpha. The channels of a pixel which is not premultiplied are
+ * truncated to 8 bits, as qRgba() does, which keeps the sums in the range of the kernels.
+ */
+inline void unpremultiply(QRgb p, int* const c)
+{
+    const int alpha = qAlpha(p);
+
+    if      (alpha == 255)
+    {
+        c[0] = qBlue(p);
+        c[1] = qGreen(p);
+        c[2] = qRed(p);
+        c[3] = 255;
+    }
+    else if (alpha == 0)
+    {
+        c[0] = 0;
+        c[1] = 0;
+        c[2] = 0;
+        c[3] = 0;
+    }
+    else
+    {
+        c[0] = (255 * qBlue(p)  / alpha) & 0xFF;
+        c[1] = (255 * qGreen(p) / alpha) & 0xFF;
+        c[2] = (255 * qRed(p)   / alpha) & 0xFF;
+        c[3] = alpha;
+    }
+}
+
+/**
+ * Add (sign = 1) or remove (sign = -1) the line to the column sums of the box blur.
+ */
+void addLineScalar(int* const sums, const QRgb* const line, int from, int width, int sign)
+{
+    int c[4];
+
+    for (int x = from ; x < width ; ++x)
+    {
+        unpremultiply(line[x], c);
+        int* const s = sums + (x << 2);
+        s[0]        += sign * c[0];
+        s[1]        += sign * c[1];
+        s[2]        += sign * c[2];
+        s[3]        += sign * c[3];
+    }
+}
+
+/**
+ * Write the line of the box blur from the column sums, mh being the height of the vertical window.
+ * The horizontal window is slided along the line.
+ */
+void blurLineScalar(QRgb* const out, const int* const sums, int width, int radius, int mh)
+{
+    int acc[4] = { 0, 0, 0, 0 };
+
+    for (int x = 0 ; x <= qMin(width - 1, radius) ; ++x)
+    {
+        for (int c = 0 ; c < 4 ; ++c)
+        {
+            acc[c] += sums[(x << 2) + c];
+        }
+    }
+
+    for (int x = 0 ; x < width ; ++x)
+    {
+        const int mt = (qMin(width, x + radius + 1) - qMax(0, x - radius)) * mh;
+        out[x]       = qRgba(acc[2] / mt, acc[1] / mt, acc[0] / mt, acc[3] / mt);
+
+        const int in = x + radius + 1;
+        const int ou = x - radius;
+
+        for (int c = 0 ; c < 4 ; ++c)
+        {
+            if (in < width)
+            {
+                acc[c] += sums[(in << 2) + c];
+            }
+
+            if (ou >= 0)
+            {
+                acc[c] -= sums[(ou << 2) + c];
+            }
+        }
+    }
+}
+
+/**
+ * Bilinear interpolation of a pixel with 7 bits weights: vertical then horizontal.
+ * The SIMD kernel does exactly the same integer operations.
+ */
+inline QRgb bilinear(const QRgb* const row0, const QRgb* const row1, int x0, int wx, int wy)
+{
+    const uchar* const p00 = reinterpret_cast<const uchar*>(row0 + x0);
+    const uchar* const p10 = reinterpret_cast<const uchar*>(row1 + x0);
+    QRgb out               = 0;
+    uchar* const o         = reinterpret_cast<uchar*>(&out);
+
+    for (int c = 0 ; c < 4 ; ++c)
+    {
+        const int v0 = p00[c]     + (((p10[c]     - p00[c])     * wy) >> 7);
+        const int v1 = p00[c + 4] + (((p10[c + 4] - p00[c + 4]) * wy) >> 7);
+        o[c]         = uchar(v0 + (((v1 - v0) * wx) >> 7));
+    }
+
+    return out;
+}
+
+void scaleLineScalar(QRgb* const out, const QRgb* const row0, const QRgb* const row1,
+                     const int* const xs, const int* const wxs, int width, int wy)
+{
+    for (int x = 0 ; x < width ; ++x)
+    {
+        out[x] = bilinear(row0, row1, xs[x], wxs[x], wy);
+    }
+}
+
+// --- SIMD implementations ----------------------------------------------------------------------
+
+enum SimdLevel
+{
+    SimdNone = 0,
+    SimdSSE2
+};
+
+#ifdef FRAME_HAVE_SIMD
+
+/**
+ * Return the best SIMD instruction set available at run-time for the frame kernels.
+ * The environment variable DIGIKAM_FRAMES_SIMD can lower it, for benchmarking purpose.
+ */
+int frameSimdLevel()
+{
+    static const int level = []()
+    {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return int(SimdSSE2);
+        }
+
+        return int(SimdNone);
+    }();
+
+    // For benchmarking and testing purpose: 0 = scalar only, 1 = SSE2.
+    // The variable is read for each frame to be changed at run-time by the unit test.
+
+    if (qEnvironmentVariableIsSet("DIGIKAM_FRAMES_SIMD"))
+    {
+        return qMin(level, qBound(int(SimdNone), qEnvironmentVariableIntValue("DIGIKAM_FRAMES_SIMD"), int(SimdSSE2)));
+    }
+
+    return level;
+}
+
+/**
+ * The channels of the pixels are summed in 32 bits lanes, one pixel per vector.
+ * Groups of 4 pixels which are not all opaque are unpremultiplied by the scalar code.
+ */
+FRAME_TARGET_SSE2 void addLineSSE2(int* const sums, const QRgb* const line, int width, int sign)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000));
+    int x               = 0;
+
+    for ( ; (x + 4) <= width ; x += 4)
+    {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + x));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(px, alpha), alpha)) != 0xFFFF)
+        {
+            addLineScalar(sums, line, x, x + 4, sign);
+            continue;
+        }
+
+        const __m128i lo = _mm_unpacklo_epi8(px, zero);
+        const __m128i hi = _mm_unpackhi_epi8(px, zero);
+        __m128i c[4]     =
+        {
+            _mm_unpacklo_epi16(lo, zero),
+            _mm_unpackhi_epi16(lo, zero),
+            _mm_unpacklo_epi16(hi, zero),
+            _mm_unpackhi_epi16(hi, zero)
+        };
+
+        __m128i* const s = reinterpret_cast<__m128i*>(sums + (x << 2));
+
+        for (int i = 0 ; i < 4 ; ++i)
+        {
+            const __m128i v = _mm_loadu_si128(s + i);
+            _mm_storeu_si128(s + i, (sign > 0) ? _mm_add_epi32(v, c[i])
+                                               : _mm_sub_epi32(v, c[i]));
+        }
+    }
+
+    addLineScalar(sums, line, x, width, sign);
+}
+
+/**
+ * The division of the sums is done in single precision: the sums are below 2^24 and the quotients
+ * are truncated, which gives the same results as the integer divisions of the scalar code.
+ */
+FRAME_TARGET_SSE2 void blurLineSSE2(QRgb* const out, const int* const sums, int width, int radius, int mh)
+{
+    const __m128i* const s = reinterpret_cast<const __m128i*>(sums);
+    __m128i acc            = _mm_setzero_si128();
+
+    for (int x = 0 ; x <= qMin(width - 1, radius) ; ++x)
+    {
+        acc = _mm_add_epi32(acc, _mm_loadu_si128(s + x));
+    }
+
+    for (int x = 0 ; x < width ; ++x)
+    {
+        const int mt     = (qMin(width, x + radius + 1) - qMax(0, x - radius)) * mh;
+        const __m128i q  = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(acc), _mm_set1_ps(float(mt))));
+        const __m128i pk = _mm_packs_epi32(q, q);
+        out[x]           = QRgb(_mm_cvtsi128_si32(_mm_packus_epi16(pk, pk)));
+
+        const int in     = x + radius + 1;
+        const int ou     = x - radius;
+
+        if (in < width)
+        {
+            acc = _mm_add_epi32(acc, _mm_loadu_si128(s + in));
+        }
+
+        if (ou >= 0)
+        {
+            acc = _mm_sub_epi32(acc, _mm_loadu_si128(s + ou));
+        }
+    }
+}
+
+/**
+ * One pixel per iteration: the 2 pixels of a source row are loaded together as 8 x 16 bits lanes.
+ */
+FRAME_TARGET_SSE2 void scaleLineSSE2(QRgb* const out, const QRgb* const row0, const QRgb* const row1,
+                                     const int* const xs, const int* const wxs, int width, int wy)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vwy  = _mm_set1_epi16(short(wy));
+
+    for (int x = 0 ; x < width ; ++x)
+    {
+        const __m128i t  = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row0 + xs[x])), zero);
+        const __m128i b  = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row1 + xs[x])), zero);
+        const __m128i v  = _mm_add_epi16(t, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(b, t), vwy), 7));
+        const __m128i v1 = _mm_srli_si128(v, 8);
+        const __m128i h  = _mm_add_epi16(v, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(v1, v),
+                                                                           _mm_set1_epi16(short(wxs[x]))), 7));
+        out[x]           = QRgb(_mm_cvtsi128_si32(_mm_packus_epi16(h, h)));
+    }
+}
+
+#else
+
+int frameSimdLevel()
+{
+    return int(SimdNone);
+}
+
+#endif // FRAME_HAVE_SIMD
+
+void addLine(int* const sums, const QRgb* const line, int width, int sign, int simdLevel)
+{
+
+#ifdef FRAME_HAVE_SIMD
+
+    if (simdLevel == SimdSSE2)
+    {
+        addLineSSE2(sums, line, width, sign);
+
+        return;
+    }
+
+#else
+
+    Q_UNUSED(simdLevel);
+
+#endif
+
+    addLineScalar(sums, line, 0, width, sign);
+}
+
+void blurLine(QRgb* const out, const int* const sums, int width, int radius, int mh, int simdLevel)
+{
+
+#ifdef FRAME_HAVE_SIMD
+
+    if (simdLevel == SimdSSE2)
+    {
+        blurLineSSE2(out, sums, width, radius, mh);
+
+        return;
+    }
+
+#else
+
+    Q_UNUSED(simdLevel);
+
+#endif
+
+    blurLineScalar(out, sums, width, radius, mh);
+}
+
+void scaleLine(QRgb* const out, const QRgb* const row0, const QRgb* const row1,
+               const int* const xs, const int* const wxs, int width, int wy, int simdLevel)
+{
+
+#ifdef FRAME_HAVE_SIMD
+
+    if (simdLevel == SimdSSE2)
+    {
+        scaleLineSSE2(out, row0, row1, xs, wxs, width, wy);
+
+        return;
+    }
+
+#else
+
+    Q_UNUSED(simdLevel);
+
+#endif
+
+    scaleLineScalar(out, row0, row1, xs, wxs, width, wy);
+}
+
+/**
+ * Return the first source pixel and the 7 bits weight of the next one for a destination coordinate.
+ */
+inline void sourceCoordinate(double pos, int size, int* const first, int* const weight)
+{
+    pos     = qBound(0.0, pos, double(size - 1));
+    *first  = qMin(int(pos), size - 2);
+    *weight = qRound((pos - *first) * 128.0);
+}
+
+} // namespace
+
+bool FrameRender::isOpaque(const QImage& img)
+{
+    if (img.format() == QImage::Format_RGB32)
+    {
+        return true;
+    }
+
+    if (img.format() != QImage::Format_ARGB32)
+    {
+        return false;
+    }
+
+    QAtomicInt transparent(0);
+
+    processRows(img.height(), [&img, &transparent](int, int begin, int end)
+        {
+            for (int y = begin ; (y < end) && !transparent.loadRelaxed() ; ++y)
+            {
+                const QRgb* const line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+
+                for (int x = 0 ; x < img.width() ; ++x)
+                {
+                    if (qAlpha(line[x]) != 255)
+                    {
+                        transparent.storeRelaxed(1);
+
+                        return;
+                    }
+                }
+            }
+        }
+    );
+
+    return !transparent.loadRelaxed();
+}
+
+int FrameRender::rowChunks(int rows)
+{
+    return qBound(1, rows / s_minChunkRows, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+void FrameRender::processRows(int rows, const std::function<void(int, int, int)>& func)
+{
+    const int chunks = rowChunks(rows);
+
+    if (chunks == 1)
+    {
+        func(0, 0, rows);
+
+        return;
+    }
+
+    QList<QFuture<void> > tasks;
+
+    for (int i = 1 ; i < chunks ; ++i)
+    {
+        const int begin = rows * i       / chunks;
+        const int end   = rows * (i + 1) / chunks;
+
+        tasks.append(QtConcurrent::run([&func, i, begin, end]()
+            {
+                func(i, begin, end);
+            }
+        ));
+    }
+
+    // The first range is processed in the calling thread.
+
+    func(0, 0, rows / chunks);
+
+    for (QFuture<void> t : std::as_const(tasks))
+    {
+        t.waitForFinished();
+    }
+}
+
+void FrameRender::copyImage(QImage& frame, const QImage& img, const QPoint& pos, const QRect& clip)
+{
+    QRect area = frame.rect() & QRect(pos, img.size());
+
+    if (clip.isValid())
+    {
+        area &= clip;
+    }
+
+    if (area.isEmpty() || !isFormat32(img) || (frame.depth() != 32))
+    {
+        return;
+    }
+
+    const size_t bytes = size_t(area.width()) * sizeof(QRgb);
+
+    // Access the pixels before the threads, to detach the frame only once.
+
+    uchar* const dst       = frame.bits();
+    const uchar* const src = img.constBits();
+    const qsizetype dbpl   = frame.bytesPerLine();
+    const qsizetype sbpl   = img.bytesPerLine();
+
+    processRows(area.height(), [&](int, int begin, int end)
+        {
+            for (int y = area.top() + begin ; y < area.top() + end ; ++y)
+            {
+                memcpy(dst + y * dbpl + area.left() * sizeof(QRgb),
+                       src + (y - pos.y()) * sbpl + (area.left() - pos.x()) * sizeof(QRgb),
+                       bytes);
+            }
+        }
+    );
+}
+
+void FrameRender::boxBlur(QImage& frame, const QImage& img, int radius, std::vector<int>& buffer)
+{
+    const int w = img.width();
+    const int h = img.height();
+
+    if ((frame.size() != img.size()) || (img.depth() != 32) || (frame.depth() != 32) || (radius < 1))
+    {
+        return;
+    }
+
+    // One line of column sums per range of rows, 4 channels per column.
+
+    const size_t lineSize  = size_t(w) * 4;
+    buffer.resize(lineSize * rowChunks(h));
+
+    uchar* const dst       = frame.bits();
+    const uchar* const src = img.constBits();
+    const qsizetype dbpl   = frame.bytesPerLine();
+    const qsizetype sbpl   = img.bytesPerLine();
+    const int simdLevel    = frameSimdLevel();
+
+    processRows(h, [&](int chunk, int begin, int end)
+        {
+            int* const sums = buffer.data() + lineSize * chunk;
+            std::fill(sums, sums + lineSize, 0);
+
+            // The vertical window of the first row of the range.
+
+            for (int y = qMax(0, begin - radius) ; y < qMin(h, begin + radius + 1) ; ++y)
+            {
+                addLine(sums, reinterpret_cast<const QRgb*>(src + y * sbpl), w, 1, simdLevel);
+            }
+
+            for (int y = begin ; y < end ; ++y)
+            {
+                const int mh = qMin(h, y + radius + 1) - qMax(0, y - radius);
+
+                blurLine(reinterpret_cast<QRgb*>(dst + y * dbpl), sums, w, radius, mh, simdLevel);
+
+                // Slide the vertical window to the next row.
+
+                if ((y + radius + 1) < h)
+                {
+                    addLine(sums, reinterpret_cast<const QRgb*>(src + (y + radius + 1) * sbpl), w, 1, simdLevel);
+                }
+
+                if ((y - radius) >= 0)
+                {
+                    addLine(sums, reinterpret_cast<const QRgb*>(src + (y - radius) * sbpl), w, -1, simdLevel);
+                }
+            }
+        }
+    );
+}
+
+void FrameRender::scaleArea(QImage& frame, const QImage& img, const QRectF& area, std::vector<int>& buffer)
+{
+    const int fw = frame.width();
+    const int fh = frame.height();
+
+    if ((img.width() < 2) || (img.height() < 2) || !isFormat32(img) || (frame.depth() != 32) ||
+        frame.isNull() || area.isEmpty())
+    {
+        return;
+    }
+
+    // Source pixels per frame pixel: the area covers the frame, centered if their aspect ratios differ.
+
+    const double scale = qMin(area.width() / fw, area.height() / fh);
+    const double left  = area.center().x() - (fw * scale) / 2.0;
+    const double top   = area.center().y() - (fh * scale) / 2.0;
+
+    // The source columns and weights are the same for all rows.
+
+    buffer.resize(size_t(fw) * 2);
+    int* const xs  = buffer.data();
+    int* const wxs = buffer.data() + fw;
+
+    for (int x = 0 ; x < fw ; ++x)
+    {
+        sourceCoordinate(left + (x + 0.5) * scale - 0.5, img.width(), &xs[x], &wxs[x]);
+    }
+
+    uchar* const dst       = frame.bits();
+    const uchar* const src = img.constBits();
+    const qsizetype dbpl   = frame.bytesPerLine();
+    const qsizetype sbpl   = img.bytesPerLine();
+    const int simdLevel    = frameSimdLevel();
+
+    processRows(fh, [&](int, int begin, int end)
+        {
+            for (int y = begin ; y < end ; ++y)
+            {
+                int y0 = 0;
+                int wy = 0;
+                sourceCoordinate(top + (y + 0.5) * scale - 0.5, img.height(), &y0, &wy);
+
+                scaleLine(reinterpret_cast<QRgb*>(dst + y * dbpl),
+                          reinterpret_cast<const QRgb*>(src + y0       * sbpl),
+                          reinterpret_cast<const QRgb*>(src + (y0 + 1) * sbpl),
+                          xs, wxs, fw, wy, simdLevel);
+            }
+        }
+    );
+}
+
+// ----------------------------------------------------------------------------------------
+
+QImage FrameBufferPool::take(const QSize& size)
+{
+    for (int i = 0 ; i < m_frames.size() ; ++i)
+    {
+        if (m_frames.at(i).isDetached() && (m_frames.at(i).size() == size))
+        {
+            return m_frames.takeAt(i);
+        }
+    }
+
+    return QImage(size, QImage::Format_ARGB32);
+}
+
+void FrameBufferPool::recycle(const QImage& frame)
+{
+    if (frame.isNull() || (frame.format() != QImage::Format_ARGB32))
+    {
+        return;
+    }
+
+    for (const QImage& img : std::as_const(m_frames))
+    {
+        if (img.constBits() == frame.constBits())
+        {
+            return;
+        }
+    }
+
+    m_frames.append(frame);
+
+    while (m_frames.size() > s_poolSize)
+    {
+        m_frames.removeFirst();
+    }
+}
+
+} // namespace Digikam
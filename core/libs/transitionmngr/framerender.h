@@ -0,0 +1,107 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : row-parallel and vectorized kernels to render
+ *               the frames of the transitions and the effects
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// C++ includes
+
+#include <functional>
+#include <vector>
+
+// Qt includes
+
+#include <QImage>
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QRectF>
+#include <QSize>
+
+namespace Digikam
+{
+
+/**
+ * The kernels work on 32 bits per pixel images and copy the pixels as they are.
+ * They are used with opaque images, where this gives the same result as to draw
+ * them with a QPainter. The rows are processed in parallel in the global thread pool.
+ */
+class Q_DECL_HIDDEN FrameRender
+{
+public:
+
+    /**
+     * Return true if the image is RGB32 or ARGB32 and all its pixels are opaque.
+     */
+    static bool isOpaque(const QImage& img);
+
+    /**
+     * Return the number of ranges of rows processed in parallel by processRows().
+     */
+    static int  rowChunks(int rows);
+
+    /**
+     * Run the function on each range [begin, end[ of rows and wait for all of them.
+     */
+    static void processRows(int rows, const std::function<void(int chunk, int begin, int end)>& func);
+
+    /**
+     * Copy the image at the position in the frame. Only the pixels in the clip
+     * rectangle of the frame are written, if it is valid.
+     */
+    static void copyImage(QImage& frame, const QImage& img, const QPoint& pos, const QRect& clip = QRect());
+
+    /**
+     * Box blur of the image with the radius, written as ARGB32 pixels in the frame
+     * of the same size. The pixels of the image are handled as premultiplied.
+     * The column sums are computed in the buffer.
+     */
+    static void boxBlur(QImage& frame, const QImage& img, int radius, std::vector<int>& buffer);
+
+    /**
+     * Bilinear scale of the area of the image to fill the frame, keeping the aspect ratio
+     * by expanding. The image must be at least 2x2. The coordinates are computed in the buffer.
+     */
+    static void scaleArea(QImage& frame, const QImage& img, const QRectF& area, std::vector<int>& buffer);
+};
+
+// ----------------------------------------------------------------------------------------
+
+/**
+ * The ARGB32 frame buffers of a renderer. A buffer is reused once the frame
+ * returned to the caller is released, instead of allocating a new frame.
+ */
+class Q_DECL_HIDDEN FrameBufferPool
+{
+public:
+
+    FrameBufferPool()  = default;
+    ~FrameBufferPool() = default;
+
+    /**
+     * Return a frame buffer of the size with undefined content.
+     */
+    QImage take(const QSize& size);
+
+    /**
+     * Keep the frame to be reused when it will not be shared anymore.
+     */
+    void   recycle(const QImage& frame);
+
+private:
+
+    QList<QImage> m_frames;
+};
+
+} // namespace Digikam
@@ -63,19 +63,21 @@ void TransitionMngr::setTransition(TransType type)
 
 void TransitionMngr::setInImage(const QImage& iimg)
 {
-    d->eff_inImage = iimg;
+    d->eff_inImage  = iimg;
+    d->eff_inOpaque = FrameRender::isOpaque(iimg);
 }
 
 void TransitionMngr::setOutImage(const QImage& oimg)
 {
-    d->eff_outImage = oimg;
+    d->eff_outImage  = oimg;
+    d->eff_outOpaque = FrameRender::isOpaque(oimg);
 }
 
 QImage TransitionMngr::currentFrame(int& tmout)
 {
     if (!d->eff_isRunning)
     {
-        d->eff_curFrame  = d->eff_inImage;
+        d->setFrame(d->eff_inImage);
         tmout            = (this->d->*d->eff_transList[d->eff_curTransition])(true);
         d->eff_isRunning = true;
     }
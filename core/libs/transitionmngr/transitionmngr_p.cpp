@@ -14,6 +14,10 @@
 
 #include "transitionmngr_p.h"
 
+// Qt includes
+
+#include <QRegion>
+
 namespace Digikam
 {
 
@@ -49,6 +53,94 @@ void TransitionMngr::Private::registerTransitions()
     eff_transList.insert(TransitionMngr::BlurOut,         &TransitionMngr::Private::transitionBlurOut);
 }
 
+void TransitionMngr::Private::setFrame(const QImage& frame)
+{
+    eff_frames.recycle(eff_curFrame);
+    eff_curFrame = frame;
+}
+
+bool TransitionMngr::Private::canCopyImages() const
+{
+    return (
+            eff_inOpaque                          &&
+            eff_outOpaque                         &&
+            (eff_inImage.size()  == eff_outSize)  &&
+            (eff_outImage.size() == eff_outSize)
+           );
+}
+
+void TransitionMngr::Private::drawImages(const QPoint& inPos, const QPoint& outPos, bool outOverIn)
+{
+    const QImage& under   = outOverIn ? eff_inImage  : eff_outImage;
+    const QImage& over    = outOverIn ? eff_outImage : eff_inImage;
+    const QPoint underPos = outOverIn ? inPos        : outPos;
+    const QPoint overPos  = outOverIn ? outPos       : inPos;
+
+    if (!canCopyImages())
+    {
+        QPainter bufferPainter(&eff_curFrame);
+        bufferPainter.drawImage(underPos, under);
+        bufferPainter.drawImage(overPos,  over);
+        bufferPainter.end();
+
+        return;
+    }
+
+    // The image under is only copied where it is visible. Both images cover the frame.
+
+    QImage frame          = eff_frames.take(eff_outSize);
+    const QRect overRect  = QRect(overPos, over.size()) & frame.rect();
+    const QRegion visible = QRegion(frame.rect()).subtracted(overRect);
+
+    for (const QRect& rect : visible)
+    {
+        FrameRender::copyImage(frame, under, underPos, rect);
+    }
+
+    FrameRender::copyImage(frame, over, overPos);
+
+    setFrame(frame);
+}
+
+void TransitionMngr::Private::drawOutImageAreas(const QList<QRect>& areas)
+{
+    const bool copyable = (
+                           eff_outOpaque                                     &&
+                           (eff_outImage.size() == eff_curFrame.size())      &&
+                           ((eff_curFrame.format() == QImage::Format_ARGB32) ||
+                            (eff_curFrame.format() == QImage::Format_RGB32))
+                          );
+
+    if (!copyable)
+    {
+        QPainter bufferPainter(&eff_curFrame);
+        QBrush brush = QBrush(eff_outImage);
+
+        for (const QRect& rect : areas)
+        {
+            bufferPainter.fillRect(rect, brush);
+        }
+
+        bufferPainter.end();
+
+        return;
+    }
+
+    if (!eff_curFrame.isDetached())
+    {
+        // The previous frame is still used by the caller: continue in a buffer.
+
+        QImage frame = eff_frames.take(eff_curFrame.size());
+        FrameRender::copyImage(frame, eff_curFrame, QPoint(0, 0));
+        setFrame(frame);
+    }
+
+    for (const QRect& rect : areas)
+    {
+        FrameRender::copyImage(eff_curFrame, eff_outImage, QPoint(0, 0), rect);
+    }
+}
+
 TransitionMngr::TransType TransitionMngr::Private::getRandomTransition() const
 {
     QList<TransitionMngr::TransType> effs = eff_transList.keys();
@@ -17,6 +17,7 @@
 // C++ includes
 
 #include <cmath>
+#include <vector>
 
 // Qt includes
 
@@ -28,6 +29,7 @@
 // Local includes
 
 #include "transitionmngr.h"
+#include "framerender.h"
 #include "digikam_config.h"
 #include "digikam_debug.h"
 
@@ -100,10 +102,21 @@ public:
     int                                           eff_psx               = 0;
     int                                           eff_psy               = 0;
 
+    // Frames are rendered without a QPainter when the images are opaque.
+    bool                                          eff_inOpaque          = false;
+    bool                                          eff_outOpaque         = false;
+    FrameBufferPool                               eff_frames;
+    std::vector<int>                              eff_blurBuffer;
+
 public:
 
     void registerTransitions();
 
+    /**
+     * Replace the current frame, and keep its buffer to be reused.
+     */
+    void setFrame(const QImage& frame);
+
     TransitionMngr::TransType getRandomTransition() const;
 
 private:
@@ -145,8 +158,23 @@ private:
 
 private:
 
-    QRgb   convertFromPremult(const QRgb& p)       const;
-    QImage fastBlur(const QImage& img, int radius) const;
+    QImage fastBlur(const QImage& img, int radius);
+
+    /**
+     * Return true if the frame can be rendered by copying the pixels of the in and out images.
+     */
+    bool   canCopyImages()                         const;
+
+    /**
+     * Render a frame with the in and out images at their positions,
+     * the out image over the in image if outOverIn is true, else the opposite.
+     */
+    void   drawImages(const QPoint& inPos, const QPoint& outPos, bool outOverIn);
+
+    /**
+     * Copy the areas of the out image into the current frame.
+     */
+    void   drawOutImageAreas(const QList<QRect>& areas);
 
 private:
 
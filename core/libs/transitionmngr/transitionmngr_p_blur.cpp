@@ -17,123 +17,20 @@
 namespace Digikam
 {
 
-QRgb TransitionMngr::Private::convertFromPremult(const QRgb& p) const
+QImage TransitionMngr::Private::fastBlur(const QImage& image, int radius)
 {
-    int alpha = qAlpha(p);
-
-    return (!alpha ? 0
-                   : qRgba(255 * qRed(p)   / alpha,
-                           255 * qGreen(p) / alpha,
-                           255 * qBlue(p)  / alpha,
-                           alpha));
-}
-
-QImage TransitionMngr::Private::fastBlur(const QImage& image, int radius) const
-{
-    int*  as = nullptr;
-    int*  rs = nullptr;
-    int*  gs = nullptr;
-    int*  bs = nullptr;
-    int x, y, w, h, mx, my, mw, mh, mt, xx, yy;
-    int a, r, g, b;
-
     if ((radius < 1) || image.isNull() || (image.width() < (radius << 1)))
     {
         return image;
     }
 
-    QImage img = image;
-    w          = img.width();
-    h          = img.height();
+    const QImage img = (image.depth() == 32) ? image
+                                             : image.convertToFormat(QImage::Format_ARGB32);
 
-    QImage buffer(w, h, img.hasAlphaChannel() ? QImage::Format_ARGB32
-                                              : QImage::Format_RGB32);
+    QImage buffer(img.size(), img.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                    : QImage::Format_RGB32);
 
-    as = new int[w];
-    rs = new int[w];
-    gs = new int[w];
-    bs = new int[w];
-
-    for (y = 0 ; y < h ; ++y)
-    {
-        my = y - radius;
-        mh = (radius << 1) + 1;
-
-        if (my < 0)
-        {
-            mh += my;
-            my  = 0;
-        }
-
-        if ((my + mh) > h)
-        {
-            mh = h - my;
-        }
-
-        QRgb* p1 = reinterpret_cast<QRgb*>(buffer.scanLine(y));
-        memset(as, 0, w*sizeof(int));
-        memset(rs, 0, w*sizeof(int));
-        memset(gs, 0, w*sizeof(int));
-        memset(bs, 0, w*sizeof(int));
-
-        QRgb pixel;
-
-        for (yy = 0 ; yy < mh ; ++yy)
-        {
-            QRgb* p2 = reinterpret_cast<QRgb*>(img.scanLine(yy + my));
-
-            for (x = 0 ; x < w ; ++x, ++p2)
-            {
-                pixel  = convertFromPremult(*p2);
-                as[x] += qAlpha(pixel);
-                rs[x] += qRed(pixel);
-                gs[x] += qGreen(pixel);
-                bs[x] += qBlue(pixel);
-            }
-        }
-
-        for (x = 0 ; x < w ; ++x)
-        {
-            a  = 0;
-            r  = 0;
-            g  = 0;
-            b  = 0;
-            mx = x - radius;
-            mw = (radius << 1) + 1;
-
-            if (mx < 0)
-            {
-                mw += mx;
-                mx  = 0;
-            }
-
-            if ((mx + mw) > w)
-            {
-                mw = w - mx;
-            }
-
-            mt = mw * mh;
-
-            for (xx = mx ; xx < (mw + mx) ; ++xx)
-            {
-                a += as[xx];
-                r += rs[xx];
-                g += gs[xx];
-                b += bs[xx];
-            }
-
-            a     = a / mt;
-            r     = r / mt;
-            g     = g / mt;
-            b     = b / mt;
-            *p1++ = qRgba(r, g, b, a);
-        }
-    }
-
-    delete [] as;
-    delete [] rs;
-    delete [] gs;
-    delete [] bs;
+    FrameRender::boxBlur(buffer, img, radius, eff_blurBuffer);
 
     return buffer.convertToFormat(QImage::Format_ARGB32_Premultiplied);
 }
@@ -171,9 +68,20 @@ int TransitionMngr::Private::transitionBlurIn(bool aInit)
         eff_fd = 25.0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0, fastBlur(eff_outImage, eff_fd));
-    bufferPainter.end();
+    if (eff_outOpaque && (eff_outImage.size() == eff_outSize) && (eff_outSize.width() >= (int(eff_fd) << 1)))
+    {
+        // The blurred image of an opaque image is opaque: it replaces the frame.
+
+        QImage frame = eff_frames.take(eff_outSize);
+        FrameRender::boxBlur(frame, eff_outImage, int(eff_fd), eff_blurBuffer);
+        setFrame(frame);
+    }
+    else
+    {
+        QPainter bufferPainter(&eff_curFrame);
+        bufferPainter.drawImage(0, 0, fastBlur(eff_outImage, eff_fd));
+        bufferPainter.end();
+    }
 
     eff_fd = eff_fd - 1.0;
 
@@ -182,7 +90,7 @@ int TransitionMngr::Private::transitionBlurIn(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -194,9 +102,20 @@ int TransitionMngr::Private::transitionBlurOut(bool aInit)
         eff_fd = 1.0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0, fastBlur(eff_inImage, eff_fd));
-    bufferPainter.end();
+    if (eff_inOpaque && (eff_inImage.size() == eff_outSize) && (eff_outSize.width() >= (int(eff_fd) << 1)))
+    {
+        // The blurred image of an opaque image is opaque: it replaces the frame.
+
+        QImage frame = eff_frames.take(eff_outSize);
+        FrameRender::boxBlur(frame, eff_inImage, int(eff_fd), eff_blurBuffer);
+        setFrame(frame);
+    }
+    else
+    {
+        QPainter bufferPainter(&eff_curFrame);
+        bufferPainter.drawImage(0, 0, fastBlur(eff_inImage, eff_fd));
+        bufferPainter.end();
+    }
 
     eff_fd = eff_fd + 1.0;
 
@@ -205,7 +124,7 @@ int TransitionMngr::Private::transitionBlurOut(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -25,10 +25,7 @@ int TransitionMngr::Private::transitionSlideL2R(bool aInit)
         eff_i  = 0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0,     0, eff_outImage);
-    bufferPainter.drawImage(eff_i, 0, eff_inImage);
-    bufferPainter.end();
+    drawImages(QPoint(eff_i, 0), QPoint(0, 0), false);
 
     eff_i = eff_i + lround(eff_fx);
 
@@ -37,7 +34,7 @@ int TransitionMngr::Private::transitionSlideL2R(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -50,10 +47,7 @@ int TransitionMngr::Private::transitionSlideR2L(bool aInit)
         eff_i  = 0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0,     0, eff_outImage);
-    bufferPainter.drawImage(eff_i, 0, eff_inImage);
-    bufferPainter.end();
+    drawImages(QPoint(eff_i, 0), QPoint(0, 0), false);
 
     eff_i = eff_i - lround(eff_fx);
 
@@ -62,7 +56,7 @@ int TransitionMngr::Private::transitionSlideR2L(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -75,10 +69,7 @@ int TransitionMngr::Private::transitionSlideT2B(bool aInit)
         eff_i  = 0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0,     eff_outImage);
-    bufferPainter.drawImage(0, eff_i, eff_inImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, eff_i), QPoint(0, 0), false);
 
     eff_i = eff_i + lround(eff_fy);
 
@@ -87,7 +78,7 @@ int TransitionMngr::Private::transitionSlideT2B(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -100,10 +91,7 @@ int TransitionMngr::Private::transitionSlideB2T(bool aInit)
         eff_i  = 0;
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0,     eff_outImage);
-    bufferPainter.drawImage(0, eff_i, eff_inImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, eff_i), QPoint(0, 0), false);
 
     eff_i = eff_i - lround(eff_fy);
 
@@ -112,7 +100,7 @@ int TransitionMngr::Private::transitionSlideB2T(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
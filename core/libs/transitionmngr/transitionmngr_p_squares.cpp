@@ -35,7 +35,7 @@ int TransitionMngr::Private::transitionChessboard(bool aInit)
 
     if (eff_ix >= eff_w)
     {
-        eff_curFrame = eff_outImage;
+        setFrame(eff_outImage);
         return -1;
     }
 
@@ -44,15 +44,16 @@ int TransitionMngr::Private::transitionChessboard(bool aInit)
     eff_iy  = eff_iy ? 0 : eff_dy;
     eff_y   = eff_y  ? 0 : eff_dy;
 
-    QPainter bufferPainter(&eff_curFrame);
-    QBrush brush = QBrush(eff_outImage);
+    QList<QRect> areas;
 
     for (int y = 0 ; y < eff_w ; y += (eff_dy << 1))
     {
-        bufferPainter.fillRect(eff_ix, y + eff_iy, eff_dx, eff_dy, brush);
-        bufferPainter.fillRect(eff_x, y + eff_y, eff_dx, eff_dy, brush);
+        areas << QRect(eff_ix, y + eff_iy, eff_dx, eff_dy);
+        areas << QRect(eff_x, y + eff_y, eff_dx, eff_dy);
     }
 
+    drawOutImageAreas(areas);
+
     return eff_wait;
 }
 
@@ -75,7 +76,7 @@ int TransitionMngr::Private::transitionGrowing(bool aInit)
 
     if ((eff_x < 0) || (eff_y < 0))
     {
-        eff_curFrame = eff_outImage;
+        setFrame(eff_outImage);
         return -1;
     }
 
@@ -84,9 +85,7 @@ int TransitionMngr::Private::transitionGrowing(bool aInit)
     eff_psx = eff_w - (eff_x << 1);
     eff_psy = eff_h - (eff_y << 1);
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.fillRect(eff_px, eff_py, eff_psx, eff_psy, QBrush(eff_outImage));
-    bufferPainter.end();
+    drawOutImageAreas(QList<QRect>() << QRect(eff_px, eff_py, eff_psx, eff_psy));
 
     return 20;
 }
@@ -113,7 +112,7 @@ int TransitionMngr::Private::transitionSpiralIn(bool aInit)
 
     if ((eff_i == 0) && (eff_x0 >= eff_x1))
     {
-        eff_curFrame = eff_outImage;
+        setFrame(eff_outImage);
         return -1;
     }
 
@@ -151,9 +150,7 @@ int TransitionMngr::Private::transitionSpiralIn(bool aInit)
     eff_psx = eff_ix;
     eff_psy = eff_iy;
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.fillRect(eff_px, eff_py, eff_psx, eff_psy, QBrush(eff_outImage));
-    bufferPainter.end();
+    drawOutImageAreas(QList<QRect>() << QRect(eff_px, eff_py, eff_psx, eff_psy));
 
     eff_x += eff_dx;
     eff_y += eff_dy;
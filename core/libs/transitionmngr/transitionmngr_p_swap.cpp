@@ -25,10 +25,7 @@ int TransitionMngr::Private::transitionSwapL2R(bool aInit)
         eff_i  = -eff_outSize.width();
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0,     0, eff_inImage);
-    bufferPainter.drawImage(eff_i, 0, eff_outImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, 0), QPoint(eff_i, 0), true);
 
     eff_i = eff_i + lround(eff_fx);
 
@@ -37,7 +34,7 @@ int TransitionMngr::Private::transitionSwapL2R(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -50,10 +47,7 @@ int TransitionMngr::Private::transitionSwapR2L(bool aInit)
         eff_i  = eff_outSize.width();
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0,     0, eff_inImage);
-    bufferPainter.drawImage(eff_i, 0, eff_outImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, 0), QPoint(eff_i, 0), true);
 
     eff_i = eff_i - lround(eff_fx);
 
@@ -62,7 +56,7 @@ int TransitionMngr::Private::transitionSwapR2L(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -75,10 +69,7 @@ int TransitionMngr::Private::transitionSwapT2B(bool aInit)
         eff_i  = -eff_outSize.height();
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0,     eff_inImage);
-    bufferPainter.drawImage(0, eff_i, eff_outImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, 0), QPoint(0, eff_i), true);
 
     eff_i = eff_i + lround(eff_fy);
 
@@ -87,7 +78,7 @@ int TransitionMngr::Private::transitionSwapT2B(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
@@ -100,10 +91,7 @@ int TransitionMngr::Private::transitionSwapB2T(bool aInit)
         eff_i  = eff_outSize.height();
     }
 
-    QPainter bufferPainter(&eff_curFrame);
-    bufferPainter.drawImage(0, 0,     eff_inImage);
-    bufferPainter.drawImage(0, eff_i, eff_outImage);
-    bufferPainter.end();
+    drawImages(QPoint(0, 0), QPoint(0, eff_i), true);
 
     eff_i = eff_i - lround(eff_fy);
 
@@ -112,7 +100,7 @@ int TransitionMngr::Private::transitionSwapB2T(bool aInit)
         return 15;
     }
 
-    eff_curFrame = eff_outImage;
+    setFrame(eff_outImage);
 
     return -1;
 }
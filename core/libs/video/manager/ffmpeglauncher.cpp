@@ -62,6 +62,42 @@ void FFmpegLauncher::encodeFrames()
          << QLatin1String("-i")
          << QDir::toNativeSeparators(m_settings->filesList);      // File list of frames to encode.
 
+    args << outputArguments();
+
+    setArguments(args);
+    startProcess();
+}
+
+QStringList FFmpegLauncher::streamingArguments() const
+{
+    // Raw RGB frames are read from the standard input, without intermediate files
+    // ffmpeg -f rawvideo -pix_fmt rgb24 -s 1920x1080 -r 25 -i - -b:v 200000 -r 25 -vcodec mpeg4 -y output.mp4
+
+    const QSize size = m_settings->videoSize();
+    QStringList args;
+
+    // Frames input
+
+    args << QLatin1String("-f")
+         << QLatin1String("rawvideo")
+         << QLatin1String("-pix_fmt")
+         << QLatin1String("rgb24")
+         << QLatin1String("-s")                                   // Frames size.
+         << QString::fromLatin1("%1x%2").arg(size.width()).arg(size.height())
+         << QLatin1String("-r")                                   // Frames rate of the input.
+         << QString::number(m_settings->videoFrameRate())
+         << QLatin1String("-i")
+         << QLatin1String("-");                                   // Frames piped to the standard input.
+
+    args << outputArguments();
+
+    return args;
+}
+
+QStringList FFmpegLauncher::outputArguments() const
+{
+    QStringList args;
+
     // Audio input
 
     if (!m_settings->audioTrack.isEmpty())
@@ -103,8 +139,7 @@ void FFmpegLauncher::encodeFrames()
          << QLatin1String("-y")                                   // Overwrite target.
          << QDir::toNativeSeparators(m_settings->outputFile);     // Target video stream.
 
-    setArguments(args);
-    startProcess();
+    return args;
 }
 
 QMap<QString, QString> FFmpegLauncher::supportedCodecs()
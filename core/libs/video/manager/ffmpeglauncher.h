@@ -17,6 +17,8 @@
 // Qt includes
 
 #include <QMap>
+#include <QSize>
+#include <QStringList>
 #include <QString>
 #include <QTime>
 
@@ -48,6 +50,12 @@ public:
      */
     void encodeFrames();
 
+    /**
+     * Return the FFmpeg arguments to encode the raw RGB frames written
+     * to the standard input of the process, with the settings of the video.
+     */
+    QStringList streamingArguments()            const;
+
     /**
      * Get the map of supported codecs with features.
      */
@@ -64,6 +72,13 @@ public:
      */
     QTime soundTrackLength(const QString& audioPath);
 
+private:
+
+    /**
+     * Return the FFmpeg arguments of the soundtrack, the metadata and the encoding of the video.
+     */
+    QStringList outputArguments()               const;
+
 private:
 
     VidSlideSettings* m_settings = nullptr;
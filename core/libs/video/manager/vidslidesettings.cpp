@@ -62,6 +62,8 @@ void VidSlideSettings::readSettings(KConfigGroup& group)
                    false);
     strength     = group.readEntry("Strength",
                    5);
+    streamFrames = group.readEntry("StreamFrames",
+                   true);
 }
 
 void VidSlideSettings::writeSettings(KConfigGroup& group)
@@ -83,6 +85,7 @@ void VidSlideSettings::writeSettings(KConfigGroup& group)
     group.writeEntry("FFmpegPath",   ffmpegPath);
     group.writeEntry("Equalize",     equalize);
     group.writeEntry("Strength",     strength);
+    group.writeEntry("StreamFrames", streamFrames);
 }
 
 QSize VidSlideSettings::videoSize() const
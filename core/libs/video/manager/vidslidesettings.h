@@ -257,6 +257,16 @@ public:
     bool                              equalize          = false;                ///< Equalize filter to applying while encoding video from frames.
     int                               strength          = 5;                    ///< Equalization strength factor.
 
+    /**
+     * Pipe the raw frames to FFmpeg while they are generated,
+     * instead of encoding temporary JPEG files at end.
+     */
+    bool                              streamFrames      = true;
+
+    int                               framesCount       = 0;                    ///< Amount of frames encoded in the video.
+    qint64                            encodingTime      = 0;                    ///< Time in ms to generate and encode the frames.
+    QString                           encodingTraces;                           ///< FFmpeg output while streaming frames.
+
     // -- FFMpeg features --------
 
     QMap<QString, QString>            ffmpegCodecs;                             ///< Map of FFmpeg codec names and features.
@@ -31,6 +31,13 @@
 #include <QIODevice>
 #include <QDateTime>
 #include <QTextStream>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
 
 // KDE includes
 
@@ -40,15 +47,163 @@
 
 #include "digikam_debug.h"
 #include "digikam_config.h"
+#include "digikam_globals.h"
 #include "frameutils.h"
 #include "frameosd.h"
 #include "dfileoperations.h"
 #include "transitionmngr.h"
 #include "effectmngr.h"
+#include "ffmpeglauncher.h"
 
 namespace Digikam
 {
 
+namespace
+{
+
+/**
+ * Amount of frames rendered in advance while FFmpeg encodes.
+ * A 4K RGB frame uses 25 MB of memory.
+ */
+static const int s_queuedFrames = 4;
+
+/**
+ * A bounded queue of frames between the rendering thread and the encoding pipe.
+ */
+class Q_DECL_HIDDEN VidSlideFrameQueue
+{
+public:
+
+    explicit VidSlideFrameQueue(int capacity)
+        : capacity(capacity)
+    {
+    }
+
+    /**
+     * Wait for a free place in the queue to append the frame.
+     * Return false if the queue is closed.
+     */
+    bool push(const QImage& frame)
+    {
+        QMutexLocker lock(&mutex);
+
+        while ((frames.size() >= capacity) && !closed)
+        {
+            notFull.wait(&mutex);
+        }
+
+        if (closed)
+        {
+            return false;
+        }
+
+        frames.enqueue(frame);
+        notEmpty.wakeOne();
+
+        return true;
+    }
+
+    /**
+     * Wait for the next frame. Return a null image when all frames are taken or if the queue is closed.
+     */
+    QImage pop()
+    {
+        QMutexLocker lock(&mutex);
+
+        while (frames.isEmpty() && !finished && !closed)
+        {
+            notEmpty.wait(&mutex);
+        }
+
+        if (frames.isEmpty() || closed)
+        {
+            return QImage();
+        }
+
+        QImage frame = frames.dequeue();
+        notFull.wakeOne();
+
+        return frame;
+    }
+
+    /**
+     * No more frames will be pushed.
+     */
+    void finish()
+    {
+        QMutexLocker lock(&mutex);
+
+        finished = true;
+        notEmpty.wakeAll();
+    }
+
+    /**
+     * Drop the frames and stop both sides of the queue.
+     */
+    void close()
+    {
+        QMutexLocker lock(&mutex);
+
+        closed = true;
+        frames.clear();
+        notFull.wakeAll();
+        notEmpty.wakeAll();
+    }
+
+private:
+
+    const int      capacity;
+    QMutex         mutex;
+    QWaitCondition notFull;
+    QWaitCondition notEmpty;
+    QQueue<QImage> frames;
+    bool           finished = false;
+    bool           closed   = false;
+};
+
+/**
+ * Write the RGB888 frame to the standard input of the process and wait until it is read,
+ * to not buffer the whole video in memory if the encoding is slower than the rendering.
+ */
+bool writeFrame(QProcess& process, const QImage& frame)
+{
+    const qint64 lineBytes = frame.width() * 3;
+
+    if (frame.bytesPerLine() == lineBytes)
+    {
+        const qint64 size = lineBytes * frame.height();
+
+        if (process.write(reinterpret_cast<const char*>(frame.constBits()), size) != size)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // The lines of the image are aligned on 32 bits.
+
+        for (int y = 0 ; y < frame.height() ; ++y)
+        {
+            if (process.write(reinterpret_cast<const char*>(frame.constScanLine(y)), lineBytes) != lineBytes)
+            {
+                return false;
+            }
+        }
+    }
+
+    while (process.bytesToWrite() > 0)
+    {
+        if (!process.waitForBytesWritten(30000))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
 VidSlideTask::VidSlideTask(VidSlideSettings* const settings)
     : ActionJob()
 {
@@ -62,19 +217,6 @@ VidSlideTask::~VidSlideTask()
 
 void VidSlideTask::run()
 {
-    FrameOsd osd;
-
-    int frameId           = 1;
-    m_settings->filesList = m_settings->tempDir + QLatin1String("fileslist.txt");
-    QFile fList(m_settings->filesList);
-
-    if (!fList.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot create files list:" << m_settings->filesList;
-    }
-
-    QTextStream out(&fList);
-
     // ---------------------------------------------
     // Setup output video file
 
@@ -89,12 +231,31 @@ void VidSlideTask::run()
         outFile = DFileOperations::getUniqueFileUrl(dest).toLocalFile();
     }
 
+    m_settings->outputFile  = outFile;
+    m_settings->framesCount = 0;
+    m_settings->encodingTraces.clear();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool done = m_settings->streamFrames ? streamFrames()
+                                         : writeFrameFiles();
+
+    m_settings->encodingTime = timer.elapsed();
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << m_settings->framesCount << "frames generated in"
+                                 << m_settings->encodingTime << "ms";
+
+    Q_EMIT signalDone(done && !m_cancel);
+}
+
+void VidSlideTask::renderFrames(const std::function<bool(const QImage&)>& sink)
+{
+    FrameOsd osd;
+
     QImage qiimg;
     QSize osize = m_settings->videoSize();
 
-    // --------------------------------------------------------------
-    // Loop to encode frames with images list as temporary JPEG files
-
     TransitionMngr transmngr;
     transmngr.setOutputSize(osize);
 
@@ -102,7 +263,9 @@ void VidSlideTask::run()
     effmngr.setOutputSize(osize);
     effmngr.setFrames(m_settings->imgFrames);
 
-    for (int i = 0 ; ((i < m_settings->inputImages.count() + 1) && !m_cancel) ; ++i)
+    bool accepted = true;
+
+    for (int i = 0 ; ((i < m_settings->inputImages.count() + 1) && accepted && !m_cancel) ; ++i)
     {
         if (i == 0)
         {
@@ -125,31 +288,21 @@ void VidSlideTask::run()
         transmngr.setTransition(m_settings->transition);
 
         int ttmout = 0;
-        QImage frame;
-        QString framePath;
 
         do
         {
-            frame     = QImage(transmngr.currentFrame(ttmout));
-            framePath = m_settings->tempDir + QString::fromLatin1("frame_%1").arg(frameId, 9, 10, QLatin1Char('0')) + QLatin1String(".jpg");
+            accepted = sink(transmngr.currentFrame(ttmout));
 
-            if (!frame.save(framePath, "JPEG"))
+            if (accepted)
             {
-                qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot generate frame:" << framePath;
+                ++m_settings->framesCount;
             }
-            else
-            {
-                qCDebug(DIGIKAM_GENERAL_LOG) << "Frame generated:" << framePath;
-            }
-
-            out << QString::fromUtf8("file '%1'").arg(QFileInfo(framePath).fileName()) << Qt::endl;
-            ++frameId;
         }
-        while ((ttmout != -1) && !m_cancel);
+        while ((ttmout != -1) && accepted && !m_cancel);
 
         // -- Images encoding ----------
 
-        if (i < m_settings->inputImages.count())
+        if ((i < m_settings->inputImages.count()) && accepted)
         {
             int count  = 0;
             int itmout = 0;
@@ -168,23 +321,16 @@ void VidSlideTask::run()
                                          m_settings->iface);
                 }
 
-                frame     = qiimg;
-                framePath = m_settings->tempDir + QString::fromLatin1("frame_%1").arg(frameId, 9, 10, QLatin1Char('0')) + QLatin1String(".jpg");
+                accepted = sink(qiimg);
 
-                if (!frame.save(framePath, "JPEG"))
-                {
-                    qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot generate frame:" << framePath;
-                }
-                else
+                if (accepted)
                 {
-                    qCDebug(DIGIKAM_GENERAL_LOG) << "Frame generated:" << ":" << framePath;
+                    ++m_settings->framesCount;
                 }
 
-                out << QString::fromUtf8("file '%1'").arg(QFileInfo(framePath).fileName()) << Qt::endl;
-                ++frameId;
                 ++count;
             }
-            while ((count < m_settings->imgFrames) && !m_cancel);
+            while ((count < m_settings->imgFrames) && accepted && !m_cancel);
         }
 
         qCDebug(DIGIKAM_GENERAL_LOG) << "Generating frames from image" << i << "done";
@@ -196,12 +342,139 @@ void VidSlideTask::run()
 
         Q_EMIT signalProgress(i);
     }
+}
+
+bool VidSlideTask::writeFrameFiles()
+{
+    int frameId           = 1;
+    m_settings->filesList = m_settings->tempDir + QLatin1String("fileslist.txt");
+    QFile fList(m_settings->filesList);
+
+    if (!fList.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot create files list:" << m_settings->filesList;
+    }
+
+    QTextStream out(&fList);
+
+    // --------------------------------------------------------------
+    // Loop to encode frames with images list as temporary JPEG files
+
+    renderFrames([this, &frameId, &out](const QImage& frame)
+        {
+            QString framePath = m_settings->tempDir + QString::fromLatin1("frame_%1").arg(frameId, 9, 10, QLatin1Char('0')) + QLatin1String(".jpg");
+
+            if (!frame.save(framePath, "JPEG"))
+            {
+                qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot generate frame:" << framePath;
+            }
+            else
+            {
+                qCDebug(DIGIKAM_GENERAL_LOG) << "Frame generated:" << framePath;
+            }
+
+            out << QString::fromUtf8("file '%1'").arg(QFileInfo(framePath).fileName()) << Qt::endl;
+            ++frameId;
+
+            return true;
+        }
+    );
 
     fList.close();
 
-    m_settings->outputFile = outFile;
+    return true;
+}
+
+bool VidSlideTask::streamFrames()
+{
+    FFmpegLauncher launcher;
+    launcher.setSettings(m_settings);
+    const QStringList args = launcher.streamingArguments();
+    const QSize osize      = m_settings->videoSize();
+
+    QProcess process;
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.setWorkingDirectory(m_settings->outputDir);
+    process.setProcessEnvironment(adjustedEnvironmentForAppImage());
+
+    qCInfo(DIGIKAM_GENERAL_LOG) << "=== Starting process:" << m_settings->ffmpegPath << args;
+
+    process.start(m_settings->ffmpegPath, args);
+
+    if (!process.waitForStarted(30000))
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot start FFmpeg:" << m_settings->ffmpegPath;
+
+        m_settings->encodingTraces = process.errorString();
+
+        return false;
+    }
+
+    Q_EMIT signalMessage(i18n("Encoding frames while they are generated..."), false);
+
+    // The frames are rendered in advance in a separated thread while FFmpeg encodes the previous ones.
+
+    VidSlideFrameQueue queue(s_queuedFrames);
+
+    QThread* const renderer = QThread::create([this, &queue, osize]()
+        {
+            renderFrames([&queue, osize](const QImage& frame)
+                {
+                    QImage rgb = frame.convertToFormat(QImage::Format_RGB888);
+
+                    if (rgb.size() != osize)
+                    {
+                        rgb = rgb.scaled(osize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+                    }
+
+                    return queue.push(rgb);
+                }
+            );
+
+            queue.finish();
+        }
+    );
+
+    renderer->start();
+
+    bool written = true;
+    QImage frame;
+
+    while (!(frame = queue.pop()).isNull())
+    {
+        if (m_cancel || !writeFrame(process, frame))
+        {
+            written = false;
+            queue.close();
+            break;
+        }
+
+        m_settings->encodingTraces.append(QString::fromLocal8Bit(process.readAll()));
+    }
+
+    renderer->wait();
+    delete renderer;
+
+    process.closeWriteChannel();
+
+    if (!written)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Frames streaming to FFmpeg stopped";
+
+        process.kill();
+    }
+
+    process.waitForFinished(-1);
+    m_settings->encodingTraces.append(QString::fromLocal8Bit(process.readAll()));
+
+    qCInfo(DIGIKAM_GENERAL_LOG) << "=== Process execution is complete!";
+    qCInfo(DIGIKAM_GENERAL_LOG) << "> Process exit code        :" << process.exitCode();
 
-    Q_EMIT signalDone(!m_cancel);
+    return (
+            written                                        &&
+            (process.exitStatus() == QProcess::NormalExit) &&
+            (process.exitCode()   == 0)
+           );
 }
 
 } // namespace Digikam
@@ -14,8 +14,13 @@
 
 #pragma once
 
+// C++ includes
+
+#include <functional>
+
 // Qt includes
 
+#include <QImage>
 #include <QString>
 
 // Local includes
@@ -47,6 +52,22 @@ protected:
 
 private:
 
+    /**
+     * Render all frames of the slideshow in order and pass them to the sink.
+     * The rendering stops when the sink returns false.
+     */
+    void renderFrames(const std::function<bool(const QImage&)>& sink);
+
+    /**
+     * Save the frames as temporary JPEG files and list them for FFmpeg.
+     */
+    bool writeFrameFiles();
+
+    /**
+     * Pipe the frames to FFmpeg as raw RGB data while they are rendered in a separated thread.
+     */
+    bool streamFrames();
+
     // Disable
     VidSlideTask(QObject*);
 
@@ -87,11 +87,25 @@ void VidSlideThread::slotEncodeFrames(bool prepareDone)
 {
     if (!prepareDone)
     {
+        if (m_settings->streamFrames)
+        {
+            Q_EMIT signalMessage(i18n("Error while encoding frames!"), true);
+        }
+
         Q_EMIT signalDone(false);
 
         return;
     }
 
+    if (m_settings->streamFrames)
+    {
+        // The frames are already encoded while they were generated.
+
+        slotEncodeDone(true, 0);
+
+        return;
+    }
+
     Q_EMIT signalMessage(i18n("Encoding frames..."), false);
 
     if (m_encoder)
@@ -123,6 +137,11 @@ void VidSlideThread::slotEncodeDone(bool success, int exitCode)
         b = true;
     }
 
+    if (m_encoder && !m_settings->streamFrames)
+    {
+        m_settings->encodingTime += m_encoder->elapsedTime();
+    }
+
     if (b)
     {
         if (QDir().exists(m_settings->tempDir))
@@ -147,6 +166,11 @@ QString VidSlideThread::encodingTraces() const
         return m_encoder->output();
     }
 
+    if (m_settings)
+    {
+        return m_settings->encodingTraces;
+    }
+
     return QString();
 }
 
@@ -0,0 +1,221 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to compare full and incremental collection scans
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QSqlDatabase>
+#include <QStandardPaths>
+#include <QUrl>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "collectionlocation.h"
+#include "collectionmanager.h"
+#include "collectionscanner.h"
+#include "coredbaccess.h"
+#include "dbengineparameters.h"
+#include "metaenginesettings.h"
+
+using namespace Digikam;
+
+static QString albumPath(const QString& collection, int album)
+{
+    return collection + QString::fromLatin1("/album%1").arg(album);
+}
+
+static bool createCollection(const QString& collection, int albums, int files)
+{
+    QImage img(32, 32, QImage::Format_RGB32);
+
+    for (int a = 0 ; a < albums ; ++a)
+    {
+        const QString path = albumPath(collection, a);
+
+        if (!QDir().mkpath(path))
+        {
+            return false;
+        }
+
+        for (int f = 0 ; f < files ; ++f)
+        {
+            img.fill(qRgb((a * 7) % 256, (f * 13) % 256, 128));
+
+            if (!img.save(path + QString::fromLatin1("/image%1.jpg").arg(f), "JPEG"))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Add one new file in the first count albums, as a camera import would do.
+ */
+static void changeAlbums(const QString& collection, int count, const QString& name)
+{
+    QImage img(32, 32, QImage::Format_RGB32);
+    img.fill(Qt::white);
+
+    for (int a = 0 ; a < count ; ++a)
+    {
+        img.save(albumPath(collection, a) + QLatin1Char('/') + name, "JPEG");
+    }
+}
+
+static void setFastScan(bool on)
+{
+    MetaEngineSettingsContainer settings = MetaEngineSettings::instance()->settings();
+    settings.useFastScan                 = on;
+    MetaEngineSettings::instance()->setSettings(settings);
+}
+
+static qint64 scan(bool incremental)
+{
+    setFastScan(incremental);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CollectionScanner scanner;
+    scanner.setPerformFastScan(incremental);
+    scanner.completeScan();
+
+    return timer.elapsed();
+}
+
+int main(int argc, char** argv)
+{
+    QApplication app(argc, argv);
+
+    // Do not change the settings of the user.
+
+    QStandardPaths::setTestModeEnabled(true);
+
+    if ((argc < 4) || (argc > 6))
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "collectionscan_cli - compare full and incremental collection scans";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <directory> <albums> <files per album> [changed albums] [create|scan]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Without mode, create the collection and the database, then scan.";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Drop the page cache of the system before a \"scan\" run to measure a cold start.";
+        return -1;
+    }
+
+    const QString dir        = QString::fromUtf8(argv[1]);
+    const int albums         = QString::fromUtf8(argv[2]).toInt();
+    const int files          = QString::fromUtf8(argv[3]).toInt();
+    const int changed        = (argc > 4) ? QString::fromUtf8(argv[4]).toInt() : qMax(1, albums / 100);
+    const QString mode       = (argc > 5) ? QString::fromUtf8(argv[5]) : QString();
+    const QString collection = dir + QLatin1String("/collection");
+
+    if ((albums <= 0) || (files <= 0) || !QDir().mkpath(collection))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    if (!QSqlDatabase::isDriverAvailable(DbEngineParameters::SQLiteDatabaseType()))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Qt SQlite plugin is missing.";
+        return -1;
+    }
+
+    const QString dbFile = dir + QLatin1String("/digikam4.db");
+
+    if (mode != QLatin1String("scan"))
+    {
+        QFile::remove(dbFile);
+
+        if (!createCollection(collection, albums, files))
+        {
+            qCWarning(DIGIKAM_TESTS_LOG) << "Cannot create the collection in" << collection;
+            return -1;
+        }
+    }
+
+    DbEngineParameters params(DbEngineParameters::SQLiteDatabaseType(), dbFile,
+                              DbEngineParameters::SQLiteDatabaseType(), dbFile);
+    CoreDbAccess::setParameters(params, CoreDbAccess::MainApplication);
+
+    if (!CoreDbAccess::checkReadyForUse(nullptr))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Cannot open the database" << dbFile;
+        return -1;
+    }
+
+    if (CollectionManager::instance()->allLocations().isEmpty())
+    {
+        CollectionManager::instance()->addLocation(QUrl::fromLocalFile(collection));
+    }
+
+    if (mode != QLatin1String("scan"))
+    {
+        // The first scan adds all items and fills the scan journal.
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("Initial scan of %1 albums x %2 files: %3 ms")
+               .arg(albums).arg(files).arg(scan(false));
+    }
+
+    if (mode == QLatin1String("create"))
+    {
+        CoreDbAccess::cleanUpDatabase();
+
+        return 0;
+    }
+
+    // The first scan of this pass runs on a cold page cache if it was dropped before.
+
+    const qint64 coldIncremental = scan(true);
+    const qint64 warmFull        = scan(false);
+    const qint64 warmIncremental = scan(true);
+
+    changeAlbums(collection, changed, QLatin1String("new1.jpg"));
+    const qint64 changedFull        = scan(false);
+
+    changeAlbums(collection, changed, QLatin1String("new2.jpg"));
+    const qint64 changedIncremental = scan(true);
+
+    // Restore the collection for the next run.
+
+    for (int a = 0 ; a < changed ; ++a)
+    {
+        QFile::remove(albumPath(collection, a) + QLatin1String("/new1.jpg"));
+        QFile::remove(albumPath(collection, a) + QLatin1String("/new2.jpg"));
+    }
+
+    scan(true);
+    setFastScan(false);
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Start-up scan: incremental %1 ms (first run of the process)").arg(coldIncremental);
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Unchanged collection: full %1 ms - incremental %2 ms")
+           .arg(warmFull).arg(warmIncremental);
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("%1 changed albums: full %2 ms - incremental %3 ms")
+           .arg(changed).arg(changedFull).arg(changedIncremental);
+
+    CoreDbAccess::cleanUpDatabase();
+
+    return 0;
+}
@@ -0,0 +1,335 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the merge of the parallel duplicates scan
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "duplicatesworkqueue_utest.h"
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QMap>
+#include <QRandomGenerator>
+#include <QSet>
+
+// Local includes
+
+#include "duplicatesworkqueue.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(DuplicatesWorkQueueTest)
+
+/**
+ * The similarity between images, symmetric as the Haar score: each image
+ * lists the images it is a duplicate of.
+ */
+using SimilarityGraph = QMap<qlonglong, QSet<qlonglong> >;
+
+static void addEdge(SimilarityGraph& graph, qlonglong a, qlonglong b)
+{
+    graph[a] << b;
+    graph[b] << a;
+}
+
+/**
+ * Stand-in for HaarIface::scanForDuplicates(): the duplicates are the image with
+ * its neighbours, and the reference is the smallest id of the group.
+ */
+static HaarIface::DuplicatesScan scanImage(const SimilarityGraph& graph, qlonglong imageId)
+{
+    HaarIface::DuplicatesScan scan;
+    const QSet<qlonglong> neighbours = graph.value(imageId);
+
+    if (neighbours.isEmpty())
+    {
+        return scan;
+    }
+
+    scan.duplicates = QList<qlonglong>(neighbours.constBegin(), neighbours.constEnd());
+    scan.duplicates << imageId;
+    std::sort(scan.duplicates.begin(), scan.duplicates.end());
+
+    scan.reference  = scan.duplicates.first();
+    scan.similarity = 0.9 + 0.0001 * imageId;
+
+    return scan;
+}
+
+/**
+ * The scan of all images by one thread, as HaarIface::findDuplicates() does it.
+ */
+static HaarIface::DuplicatesResultsMap sequentialResults(const SimilarityGraph& graph, const QSet<qlonglong>& images)
+{
+    QList<qlonglong> sorted(images.constBegin(), images.constEnd());
+    std::sort(sorted.begin(), sorted.end());
+
+    HaarIface::DuplicatesResultsMap results;
+    QSet<qlonglong>                 found;
+
+    for (const qlonglong image : std::as_const(sorted))
+    {
+        if (found.contains(image))
+        {
+            continue;
+        }
+
+        const HaarIface::DuplicatesScan scan = scanImage(graph, image);
+
+        if (scan.reference != -1)
+        {
+            results.insert(scan.reference, qMakePair(scan.similarity, scan.duplicates));
+
+            found << image;
+            found.unite(QSet<qlonglong>(scan.duplicates.constBegin(), scan.duplicates.constEnd()));
+        }
+    }
+
+    return results;
+}
+
+/**
+ * The parallel scan: each chunk is scanned on its own, skipping only the images
+ * found as duplicates in the chunk, then the chunks are merged. The chunks are
+ * taken in reverse order to check that the merge does not depend on it.
+ */
+static HaarIface::DuplicatesResultsMap parallelResults(const SimilarityGraph& graph, const QSet<qlonglong>& images,
+                                                       int workersCount, int* const rescanned = nullptr)
+{
+    DuplicatesWorkQueue queue(images, workersCount);
+    QList<QPair<int, QList<qlonglong> > > chunks;
+    int chunk = 0;
+    QList<qlonglong> chunkImages;
+
+    while (queue.takeChunk(chunk, chunkImages))
+    {
+        chunks.prepend(qMakePair(chunk, chunkImages));
+    }
+
+    for (const auto& chunkToScan : std::as_const(chunks))
+    {
+        HaarIface::DuplicatesScansMap scans;
+        QSet<qlonglong>               found;
+
+        for (const qlonglong image : chunkToScan.second)
+        {
+            if (found.contains(image))
+            {
+                continue;
+            }
+
+            const HaarIface::DuplicatesScan scan = scanImage(graph, image);
+            scans.insert(image, scan);
+
+            if (scan.reference != -1)
+            {
+                found << image;
+                found.unite(QSet<qlonglong>(scan.duplicates.constBegin(), scan.duplicates.constEnd()));
+            }
+        }
+
+        queue.setChunkScans(chunkToScan.first, scans);
+    }
+
+    int count = 0;
+
+    const HaarIface::DuplicatesResultsMap results = queue.mergedResults([&graph, &count](qlonglong imageId)
+        {
+            ++count;
+
+            return scanImage(graph, imageId);
+        }
+    );
+
+    if (rescanned)
+    {
+        *rescanned = count;
+    }
+
+    return results;
+}
+
+static QSet<qlonglong> imageRange(qlonglong first, qlonglong last)
+{
+    QSet<qlonglong> images;
+
+    for (qlonglong id = first ; id <= last ; ++id)
+    {
+        images << id;
+    }
+
+    return images;
+}
+
+void DuplicatesWorkQueueTest::testChunks()
+{
+    const QSet<qlonglong> images = imageRange(1, 1000);
+
+    // One worker scans all images as one chunk.
+
+    DuplicatesWorkQueue single(images, 1);
+    QCOMPARE(single.chunksCount(),  1);
+    QCOMPARE(single.workersCount(), 1);
+
+    // The chunks cover all images once, in order.
+
+    DuplicatesWorkQueue queue(images, 4);
+    QVERIFY(queue.chunksCount() > 4);
+    QCOMPARE(queue.workersCount(), 4);
+
+    QList<qlonglong> taken;
+    int chunk = 0;
+    int count = 0;
+    QList<qlonglong> chunkImages;
+
+    while (queue.takeChunk(chunk, chunkImages))
+    {
+        QCOMPARE(chunk, count++);
+        taken << chunkImages;
+    }
+
+    QCOMPARE(count, queue.chunksCount());
+
+    QList<qlonglong> expected(images.constBegin(), images.constEnd());
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(taken, expected);
+
+    // Not more workers than chunks.
+
+    DuplicatesWorkQueue small(imageRange(1, 10), 8);
+    QCOMPARE(small.chunksCount(),  2);
+    QCOMPARE(small.workersCount(), 2);
+}
+
+void DuplicatesWorkQueueTest::testGroupAcrossChunks()
+{
+    // With two workers, the chunks are 1-8 and 9-16. Image 9 is a duplicate of 1
+    // and of 10. One thread groups 1 with 9, then 9 with 10 when scanning 10.
+    // The second chunk alone groups 1, 9 and 10 under 9, and skips 10.
+
+    const QSet<qlonglong> images = imageRange(1, 16);
+    SimilarityGraph graph;
+    addEdge(graph, 1, 9);
+    addEdge(graph, 9, 10);
+
+    const HaarIface::DuplicatesResultsMap expected = sequentialResults(graph, images);
+    QCOMPARE(expected.count(), 2);
+    QCOMPARE(expected.value(1).second,  QList<qlonglong>({ 1, 9 }));
+    QCOMPARE(expected.value(9).second,  QList<qlonglong>({ 9, 10 }));
+
+    int rescanned = 0;
+    QVERIFY(parallelResults(graph, images, 2, &rescanned) == expected);
+    QCOMPARE(rescanned, 1);
+
+    // One worker never scans again.
+
+    QVERIFY(parallelResults(graph, images, 1, &rescanned) == expected);
+    QCOMPARE(rescanned, 0);
+}
+
+void DuplicatesWorkQueueTest::testDuplicateOfSkippedImage()
+{
+    // Image 3 is a duplicate of 12 only, and 12 is a duplicate of 3 and 14.
+    // One thread groups 3 with 12, then 12 with 14 under 12 when scanning 14.
+    // The second chunk alone groups 3, 12 and 14 under 3, in place of the group
+    // of the first chunk, and reports 14 with 15 under 14.
+
+    const QSet<qlonglong> images = imageRange(1, 16);
+    SimilarityGraph graph;
+    addEdge(graph, 3,  12);
+    addEdge(graph, 12, 14);
+    addEdge(graph, 14, 15);
+
+    const HaarIface::DuplicatesResultsMap expected = sequentialResults(graph, images);
+    QCOMPARE(expected.count(), 2);
+    QCOMPARE(expected.value(3).second,  QList<qlonglong>({ 3, 12 }));
+    QCOMPARE(expected.value(12).second, QList<qlonglong>({ 12, 14, 15 }));
+
+    QVERIFY(parallelResults(graph, images, 2) == expected);
+}
+
+void DuplicatesWorkQueueTest::testRandomGraphs_data()
+{
+    QTest::addColumn<int>("workersCount");
+    QTest::addColumn<quint32>("seed");
+
+    const QList<int> workers = { 1, 2, 4, 8 };
+
+    for (const int count : workers)
+    {
+        for (quint32 seed = 1 ; seed <= 4 ; ++seed)
+        {
+            QTest::addRow("%d workers, seed %u", count, seed) << count << seed;
+        }
+    }
+}
+
+void DuplicatesWorkQueueTest::testRandomGraphs()
+{
+    QFETCH(int,     workersCount);
+    QFETCH(quint32, seed);
+
+    // Sparse ids, with random pairs and a few larger groups spread over the chunks.
+
+    QRandomGenerator random(seed);
+    QList<qlonglong> ids;
+    qlonglong id = 0;
+
+    for (int i = 0 ; i < 2000 ; ++i)
+    {
+        id += 1 + random.bounded(3);
+        ids << id;
+    }
+
+    const QSet<qlonglong> images(ids.constBegin(), ids.constEnd());
+    SimilarityGraph graph;
+
+    for (int i = 0 ; i < 600 ; ++i)
+    {
+        const qlonglong a = ids.at(random.bounded(ids.count()));
+        const qlonglong b = ids.at(random.bounded(ids.count()));
+
+        if (a != b)
+        {
+            addEdge(graph, a, b);
+        }
+    }
+
+    for (int group = 0 ; group < 20 ; ++group)
+    {
+        const qlonglong center = ids.at(random.bounded(ids.count()));
+
+        for (int i = 0 ; i < 5 ; ++i)
+        {
+            const qlonglong other = ids.at(random.bounded(ids.count()));
+
+            if (other != center)
+            {
+                addEdge(graph, center, other);
+            }
+        }
+    }
+
+    const HaarIface::DuplicatesResultsMap expected = sequentialResults(graph, images);
+    const HaarIface::DuplicatesResultsMap results  = parallelResults(graph, images, workersCount);
+
+    QCOMPARE(results.keys(), expected.keys());
+
+    for (auto it = expected.constBegin() ; it != expected.constEnd() ; ++it)
+    {
+        QCOMPARE(results.value(it.key()).first,  it.value().first);
+        QCOMPARE(results.value(it.key()).second, it.value().second);
+    }
+}
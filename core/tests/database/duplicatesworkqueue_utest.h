@@ -0,0 +1,39 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the merge of the parallel duplicates scan
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QTest>
+
+class DuplicatesWorkQueueTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DuplicatesWorkQueueTest(QObject* const parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void testChunks();
+    void testGroupAcrossChunks();
+    void testDuplicateOfSkippedImage();
+    void testRandomGraphs();
+    void testRandomGraphs_data();
+};
@@ -0,0 +1,134 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to benchmark the Haar signature computation
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dimg.h"
+#include "haar.h"
+#include "haariface.h"
+
+using namespace Digikam;
+
+/**
+ * Fill the image with noise, or with smooth gradients closer to real photographs.
+ */
+static DImg createImage(int index, QRandomGenerator& random)
+{
+    DImg img(Haar::NumberOfPixels, Haar::NumberOfPixels, false, false);
+    uchar* ptr = img.bits();
+
+    for (int y = 0 ; y < Haar::NumberOfPixels ; ++y)
+    {
+        for (int x = 0 ; x < Haar::NumberOfPixels ; ++x)
+        {
+            if (index % 2)
+            {
+                ptr[0] = (uchar)random.bounded(256);
+                ptr[1] = (uchar)random.bounded(256);
+                ptr[2] = (uchar)random.bounded(256);
+            }
+            else
+            {
+                ptr[0] = (uchar)((y * 2 + index)      % 256);
+                ptr[1] = (uchar)((x + y + index)      % 256);
+                ptr[2] = (uchar)((x * 3 + index / 2)  % 256);
+            }
+
+            ptr[3] = 0xFF;
+            ptr   += 4;
+        }
+    }
+
+    return img;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int images = 64;
+    int loops  = 20;
+
+    if (argc == 3)
+    {
+        images = QString::fromUtf8(argv[1]).toInt();
+        loops  = QString::fromUtf8(argv[2]).toInt();
+    }
+    else if (argc != 1)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "haarsignature_cli - benchmark the Haar signature computation";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [<images> <loops>]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Set DIGIKAM_HAAR_SIMD to 0 (scalar), 1 (SSE2) or 2 (AVX2) to select the kernels";
+        return -1;
+    }
+
+    if ((images <= 0) || (loops <= 0))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Images:" << images << "-" << loops << "loops";
+    qCDebug(DIGIKAM_TESTS_LOG) << "SIMD level requested:"
+                               << (qEnvironmentVariableIsSet("DIGIKAM_HAAR_SIMD") ? qgetenv("DIGIKAM_HAAR_SIMD")
+                                                                                  : QByteArray("auto"));
+
+    QRandomGenerator random(42);
+    QList<DImg> list;
+
+    for (int i = 0 ; i < images ; ++i)
+    {
+        list << createImage(i, random);
+    }
+
+    HaarIface haarIface;
+    Haar::SignatureData sig;
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int loop = 0 ; loop < loops ; ++loop)
+    {
+        for (const DImg& img : std::as_const(list))
+        {
+            haarIface.calculateSignature(img, sig);
+
+            if (loop == 0)
+            {
+                hash.addData(reinterpret_cast<const char*>(&sig), sizeof(sig));
+            }
+        }
+    }
+
+    double secs = qMax(timer.nsecsElapsed(), (qint64)1) / 1.0E9;
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("%1 signatures/s").arg((double)images * loops / secs, 0, 'f', 1);
+
+    // The checksum must not change with the SIMD level: the stored signatures stay comparable.
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Signatures checksum: %1").arg(QString::fromLatin1(hash.result().toHex()));
+
+    return 0;
+}
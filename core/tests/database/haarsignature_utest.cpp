@@ -0,0 +1,189 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a test to compare the scalar and SIMD Haar signature kernels
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "haarsignature_utest.h"
+
+// Qt includes
+
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTest>
+
+// Local includes
+
+#include "dimg.h"
+#include "dsimdlevel.h"
+#include "haar.h"
+#include "haariface.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(HaarSignatureTest)
+
+namespace
+{
+
+enum Pattern
+{
+    Gradients = 0,      ///< Smooth content, closer to real photographs.
+    Noise,              ///< Energy spread over all the coefficients.
+    Uniform,            ///< All the coefficients but the averages are null: only ties in the top coefficients selection.
+    Checkerboard,       ///< Finest coefficients with the same magnitude: ties in the top coefficients selection.
+    Stripes             ///< Vertical stripes: the rows and the columns decompositions differ.
+};
+
+} // namespace
+
+/**
+ * Compute the signature with the kernels selected by DIGIKAM_HAAR_SIMD (0 = scalar, 1 = SSE2, 2 = AVX2).
+ */
+static Haar::SignatureData signatureWithLevel(const DImg& img, int level)
+{
+    DSimdLevel simd("DIGIKAM_HAAR_SIMD", level);
+
+    HaarIface haarIface;
+    Haar::SignatureData sig;
+
+    if (!haarIface.calculateSignature(img, sig))
+    {
+        qWarning() << "Cannot compute the signature";
+    }
+
+    return sig;
+}
+
+static DImg createImage(const QSize& size, bool sixteenBit, int pattern)
+{
+    DImg img(size.width(), size.height(), sixteenBit, false);
+    uchar* const data = img.bits();
+    QRandomGenerator generator(12345);
+
+    for (quint64 i = 0 ; i < img.numBytes() ; ++i)
+    {
+        const quint64 pixel = i / img.bytesDepth();
+        const quint64 x     = pixel % img.width();
+        const quint64 y     = pixel / img.width();
+        const quint64 byte  = i % img.bytesDepth();
+
+        switch (pattern)
+        {
+            case Noise:
+                data[i] = (uchar)generator.bounded(256);
+                break;
+
+            case Uniform:
+                data[i] = (uchar)(0x40 + byte * 0x18);
+                break;
+
+            case Checkerboard:
+                data[i] = ((x + y) & 1) ? 0xFF : 0x00;
+                break;
+
+            case Stripes:
+                data[i] = ((x / 3) & 1) ? 0xE0 : 0x20;
+                break;
+
+            default:    // Gradients
+                data[i] = (uchar)((x * (i % 3 + 1) + y * 2) % 256);
+                break;
+        }
+    }
+
+    return img;
+}
+
+HaarSignatureTest::HaarSignatureTest(QObject* const parent)
+    : QObject(parent)
+{
+}
+
+void HaarSignatureTest::initTestCase()
+{
+
+#if !defined(__GNUC__) || (!defined(__x86_64__) && !defined(__i386__))
+
+    QSKIP("The SIMD Haar kernels are only built for x86");
+
+#endif
+
+}
+
+void HaarSignatureTest::testSimdBitExact_data()
+{
+    QTest::addColumn<bool>("sixteenBit");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("pattern");
+
+    const QList<QSize> sizes =
+    {
+        QSize(Haar::NumberOfPixels, Haar::NumberOfPixels),  // no scaling
+        QSize(613, 419)                                     // scaled to the Haar size
+    };
+
+    const QStringList patterns =
+    {
+        QLatin1String("gradients"),
+        QLatin1String("noise"),
+        QLatin1String("uniform"),
+        QLatin1String("checkerboard"),
+        QLatin1String("stripes")
+    };
+
+    for (int sixteenBit = 0 ; sixteenBit < 2 ; ++sixteenBit)
+    {
+        for (const QSize& size : sizes)
+        {
+            for (int pattern = Gradients ; pattern <= Stripes ; ++pattern)
+            {
+                QTest::newRow(QString::fromLatin1("%1 bits %2x%3 %4")
+                              .arg(sixteenBit ? 16 : 8)
+                              .arg(size.width())
+                              .arg(size.height())
+                              .arg(patterns[pattern])
+                              .toLatin1().constData())
+                    << (bool)sixteenBit
+                    << size
+                    << pattern;
+            }
+        }
+    }
+}
+
+void HaarSignatureTest::testSimdBitExact()
+{
+    QFETCH(bool,  sixteenBit);
+    QFETCH(QSize, size);
+    QFETCH(int,   pattern);
+
+    const DImg img                   = createImage(size, sixteenBit, pattern);
+    const Haar::SignatureData scalar = signatureWithLevel(img, 0);
+
+    for (int level = 1 ; level <= 2 ; ++level)
+    {
+        const Haar::SignatureData simd = signatureWithLevel(img, level);
+
+        const qint64 avgDiff = DSimdLevel::firstDifference(simd.avg, scalar.avg, sizeof(scalar.avg));
+
+        QVERIFY2(avgDiff == -1,
+                 qPrintable(QString::fromLatin1("SIMD level %1 differs from the scalar kernels on the average of channel %2")
+                            .arg(level).arg(avgDiff / qint64(sizeof(double)))));
+
+        const qint64 sigDiff = DSimdLevel::firstDifference(simd.sig, scalar.sig, sizeof(scalar.sig));
+        const qint64 coeff   = sigDiff / qint64(sizeof(Haar::Idx));
+
+        QVERIFY2(sigDiff == -1,
+                 qPrintable(QString::fromLatin1("SIMD level %1 differs from the scalar kernels on coefficient %2 of channel %3")
+                            .arg(level).arg(coeff % Haar::NumberOfCoefficients).arg(coeff / Haar::NumberOfCoefficients)));
+    }
+}
@@ -0,0 +1,35 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a test to compare the scalar and SIMD Haar signature kernels
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QObject>
+
+class HaarSignatureTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit HaarSignatureTest(QObject* const parent = nullptr);
+
+private Q_SLOTS:
+
+    void initTestCase();
+
+    void testSimdBitExact();
+    void testSimdBitExact_data();
+};
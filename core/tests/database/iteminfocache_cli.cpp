@@ -0,0 +1,194 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to measure the contention on the ItemInfo cache
+ *               with concurrent lookups and updates from several threads
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QRunnable>
+#include <QSqlDatabase>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "coredbaccess.h"
+#include "dbengineparameters.h"
+#include "iteminfo.h"
+#include "itemlisterrecord.h"
+
+using namespace Digikam;
+
+static ItemListerRecord createRecord(qlonglong id, int rating)
+{
+    ItemListerRecord record;
+    record.imageID          = id;
+    record.albumID          = 1 + int(id % 100);
+    record.albumRootID      = 1;
+    record.name             = QString::fromLatin1("image%1.jpg").arg(id);
+    record.rating           = rating;
+    record.format           = QLatin1String("JPG");
+    record.fileSize         = 1000 + id;
+    record.creationDate     = QDateTime::currentDateTime();
+    record.modificationDate = record.creationDate;
+    record.imageSize        = QSize(640, 480);
+    record.category         = DatabaseItem::Image;
+
+    return record;
+}
+
+/**
+ * A worker reading the cached fields of random items, and updating one item
+ * every updateEvery operations, as the listers do when a view is refreshed.
+ */
+class Q_DECL_HIDDEN CacheRunnable : public QRunnable
+{
+public:
+
+    CacheRunnable(qlonglong items, int operations, int updateEvery, quint32 seed)
+        : items      (items),
+          operations (operations),
+          updateEvery(updateEvery),
+          seed       (seed)
+    {
+    }
+
+    void run() override
+    {
+        QRandomGenerator random(seed);
+        qlonglong sum = 0;
+
+        for (int i = 0 ; i < operations ; ++i)
+        {
+            const qlonglong id = 1 + random.bounded(int(items));
+
+            if ((updateEvery > 0) && ((i % updateEvery) == 0))
+            {
+                ItemInfo info(createRecord(id, i % 6));
+                sum += info.rating();
+            }
+            else
+            {
+                ItemInfo info(id);
+                sum += info.rating() + info.fileSize() + info.name().size();
+            }
+        }
+
+        // Keep the compiler from dropping the reads.
+
+        if (sum == -1)
+        {
+            qCDebug(DIGIKAM_TESTS_LOG) << sum;
+        }
+    }
+
+private:
+
+    const qlonglong items;
+    const int       operations;
+    const int       updateEvery;
+    const quint32   seed;
+
+private:
+
+    Q_DISABLE_COPY(CacheRunnable)
+};
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    // Do not change the settings of the user.
+
+    QStandardPaths::setTestModeEnabled(true);
+
+    if (argc > 5)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "iteminfocache_cli - measure the contention on the ItemInfo cache";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [max threads] [items] [operations per thread] [update every n operations]";
+        return -1;
+    }
+
+    const int maxThreads     = (argc > 1) ? qMax(1, QString::fromLatin1(argv[1]).toInt()) : QThread::idealThreadCount();
+    const qlonglong items    = (argc > 2) ? qMax(1, QString::fromLatin1(argv[2]).toInt()) : 100000;
+    const int operations     = (argc > 3) ? qMax(1, QString::fromLatin1(argv[3]).toInt()) : 1000000;
+    const int updateEvery    = (argc > 4) ? qMax(0, QString::fromLatin1(argv[4]).toInt()) : 10;
+
+    if (!QSqlDatabase::isDriverAvailable(DbEngineParameters::SQLiteDatabaseType()))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Qt SQlite plugin is missing.";
+        return -1;
+    }
+
+    // The cache is set up with the database. The workers only use cached fields.
+
+    QTemporaryDir dir;
+    const QString dbFile = dir.filePath(QLatin1String("digikam4.db"));
+
+    DbEngineParameters params(DbEngineParameters::SQLiteDatabaseType(), dbFile,
+                              DbEngineParameters::SQLiteDatabaseType(), dbFile);
+    CoreDbAccess::setParameters(params, CoreDbAccess::MainApplication);
+
+    if (!CoreDbAccess::checkReadyForUse(nullptr))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Cannot open the database" << dbFile;
+        return -1;
+    }
+
+    // Keep all items in the cache, as the models of the views do.
+
+    QList<ItemInfo> infos;
+
+    for (qlonglong id = 1 ; id <= items ; ++id)
+    {
+        infos << ItemInfo(createRecord(id, 0));
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Items:" << items << "- operations per thread:" << operations
+                               << "- update every:" << updateEvery;
+
+    for (int threads = 1 ; threads <= maxThreads ; threads *= 2)
+    {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int t = 0 ; t < threads ; ++t)
+        {
+            pool.start(new CacheRunnable(items, operations, updateEvery, quint32(t + 1)));
+        }
+
+        pool.waitForDone();
+
+        const qint64 elapsed = qMax((qint64)1, timer.elapsed());
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("%1 threads: %2 ms - %3 Mops/s")
+               .arg(threads, 2)
+               .arg(elapsed, 6)
+               .arg(double(threads) * operations / elapsed / 1000.0, 0, 'f', 2);
+    }
+
+    infos.clear();
+    CoreDbAccess::cleanUpDatabase();
+
+    return 0;
+}
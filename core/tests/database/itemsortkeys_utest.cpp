@@ -0,0 +1,206 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the packed sort keys of the items
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "itemsortkeys_utest.h"
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QDateTime>
+
+// Local includes
+
+#include "itemsortkeys.h"
+#include "itemsortsettings.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(ItemSortKeysTest)
+
+/**
+ * Append the keys of one item to the columns.
+ */
+static void addItem(ItemSortKeyColumns& columns, qlonglong id, const QString& name,
+                    qlonglong fileSize, int rating, const QDateTime& creationDate)
+{
+    columns.indexes.insert(id, columns.ids.size());
+
+    columns.ids               << id;
+    columns.groupImageIds     << -1;
+    columns.albumIds          << 1;
+    columns.albumRootIds      << 1;
+    columns.albumPaths        << QLatin1String("/");
+    columns.names             << name;
+    columns.categories        << 1;
+    columns.modificationDates << creationDate.toMSecsSinceEpoch();
+    columns.creationDates     << creationDate.toMSecsSinceEpoch();
+    columns.creationDays      << creationDate.date();
+    columns.fileSizes         << fileSize;
+    columns.manualOrders      << 0;
+    columns.ratings           << rating;
+    columns.widths            << 640;
+    columns.heights           << 480;
+    columns.formats           << QLatin1String("JPG");
+    columns.nameRanks         << -1;
+    columns.pathRanks         << -1;
+    columns.formatRanks       << -1;
+}
+
+static ItemSortKeyColumns testColumns()
+{
+    const QDateTime date(QDate(2024, 6, 25), QTime(12, 0));
+    ItemSortKeyColumns columns;
+
+    addItem(columns, 10, QLatin1String("img10.jpg"), 3000, 2, date);
+    addItem(columns, 11, QLatin1String("img2.jpg"),  1000, 5, date.addDays(2));
+    addItem(columns, 12, QLatin1String("IMG1.jpg"),  2000, 0, date.addDays(-1));
+    addItem(columns, 13, QLatin1String("img3.jpg"),  1000, 2, date.addDays(1));
+    addItem(columns, 14, QLatin1String("img2.jpg"),  500,  5, date);
+
+    return columns;
+}
+
+void ItemSortKeysTest::testAppendReplace()
+{
+    const ItemSortKeyColumns source = testColumns();
+    ItemSortKeyColumns columns;
+
+    columns.append(source, 2);
+    columns.append(source, 0);
+
+    QCOMPARE(columns.size(),       2);
+    QCOMPARE(columns.indexOf(12),  0);
+    QCOMPARE(columns.indexOf(10),  1);
+    QCOMPARE(columns.indexOf(11), -1);
+    QCOMPARE(columns.names.at(1),  QLatin1String("img10.jpg"));
+
+    // Replacing an item moves the index to the new item.
+
+    columns.replace(0, source, 1);
+
+    QCOMPARE(columns.size(),       2);
+    QCOMPARE(columns.indexOf(12), -1);
+    QCOMPARE(columns.indexOf(11),  0);
+    QCOMPARE(columns.ratings.at(0), 5);
+    QCOMPARE(columns.nameRanks.at(0), -1);
+}
+
+void ItemSortKeysTest::testRelease()
+{
+    ItemSortKeyColumns columns = testColumns();
+
+    columns.release(1);
+
+    QCOMPARE(columns.indexOf(11), -1);
+    QCOMPARE(columns.ids.at(1),   qlonglong(-1));
+    QCOMPARE(columns.indexOf(12),  2);
+
+    // A released slot can be used again.
+
+    columns.replace(1, testColumns(), 3);
+
+    QCOMPARE(columns.indexOf(13),  1);
+    QCOMPARE(columns.indexOf(11), -1);
+}
+
+void ItemSortKeysTest::testSortPositions_data()
+{
+    QTest::addColumn<int>("role");
+    QTest::addColumn<int>("order");
+
+    QTest::newRow("name ascending")       << int(ItemSortSettings::SortByFileName)         << int(ItemSortSettings::AscendingOrder);
+    QTest::newRow("name descending")      << int(ItemSortSettings::SortByFileName)         << int(ItemSortSettings::DescendingOrder);
+    QTest::newRow("size ascending")       << int(ItemSortSettings::SortByFileSize)         << int(ItemSortSettings::AscendingOrder);
+    QTest::newRow("rating default")       << int(ItemSortSettings::SortByRating)           << int(ItemSortSettings::DefaultOrder);
+    QTest::newRow("creation descending")  << int(ItemSortSettings::SortByCreationDate)     << int(ItemSortSettings::DescendingOrder);
+    QTest::newRow("modification default") << int(ItemSortSettings::SortByModificationDate) << int(ItemSortSettings::DefaultOrder);
+}
+
+void ItemSortKeysTest::testSortPositions()
+{
+    QFETCH(int, role);
+    QFETCH(int, order);
+
+    ItemSortSettings sorter;
+    sorter.setSortRole((ItemSortSettings::SortRole)role);
+    sorter.setSortOrder((ItemSortSettings::SortOrder)order);
+
+    ItemSortKeyColumns columns    = testColumns();
+    const ItemSortKeyColumns copy = columns;
+    const QVector<int> positions  = ItemSortKeys::sortPositions(columns, sorter);
+
+    // The positions are a permutation of the items.
+
+    QCOMPARE(positions.size(), columns.size());
+
+    QVector<int> sorted = positions;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int i = 0 ; i < sorted.size() ; ++i)
+    {
+        QCOMPARE(sorted.at(i), i);
+    }
+
+    // The ranked keys and the plain strings give the same order as the positions.
+
+    for (int a = 0 ; a < columns.size() ; ++a)
+    {
+        for (int b = 0 ; b < columns.size() ; ++b)
+        {
+            if (a == b)
+            {
+                continue;
+            }
+
+            QCOMPARE(sorter.lessThan(columns, a, b), (positions.at(a) < positions.at(b)));
+            QCOMPARE(sorter.lessThan(copy,    a, b), (positions.at(a) < positions.at(b)));
+        }
+    }
+}
+
+void ItemSortKeysTest::testUnrankedKeys()
+{
+    ItemSortSettings sorter;
+    sorter.setSortRole(ItemSortSettings::SortByFileName);
+    sorter.setSortOrder(ItemSortSettings::AscendingOrder);
+    sorter.setStringTypeNatural(true);
+    sorter.sortCaseSensitivity = Qt::CaseInsensitive;
+
+    ItemSortKeyColumns columns   = testColumns();
+    const QVector<int> positions = ItemSortKeys::sortPositions(columns, sorter);
+
+    // Natural order: "IMG1" < "img2" < "img3" < "img10". Same names are ordered by creation date.
+
+    QCOMPARE(positions.at(columns.indexOf(12)), 0);
+    QCOMPARE(positions.at(columns.indexOf(14)), 1);
+    QCOMPARE(positions.at(columns.indexOf(11)), 2);
+    QCOMPARE(positions.at(columns.indexOf(13)), 3);
+    QCOMPARE(positions.at(columns.indexOf(10)), 4);
+
+    // An item updated after the ranking is compared with the other ones from its strings.
+
+    ItemSortKeyColumns updated;
+    addItem(updated, 11, QLatin1String("img11.jpg"), 1000, 5, QDateTime(QDate(2024, 6, 27), QTime(12, 0)));
+    columns.replace(columns.indexOf(11), updated, 0);
+
+    const int index = columns.indexOf(11);
+
+    QCOMPARE(columns.nameRanks.at(index), -1);
+    QVERIFY(sorter.lessThan(columns, columns.indexOf(10), index));
+    QVERIFY(sorter.lessThan(columns, columns.indexOf(13), index));
+    QVERIFY(!sorter.lessThan(columns, index, columns.indexOf(10)));
+}
@@ -0,0 +1,39 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the packed sort keys of the items
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QTest>
+
+class ItemSortKeysTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit ItemSortKeysTest(QObject* const parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void testAppendReplace();
+    void testRelease();
+    void testSortPositions();
+    void testSortPositions_data();
+    void testUnrankedKeys();
+};
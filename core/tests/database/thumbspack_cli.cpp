@@ -0,0 +1,257 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to compare thumbnails pack file and thumbnails database
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QSqlDatabase>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dbengineparameters.h"
+#include "pgfutils.h"
+#include "thumbnailinfo.h"
+#include "thumbnailpackfile.h"
+#include "thumbsdb.h"
+#include "thumbsdbaccess.h"
+
+using namespace Digikam;
+
+/**
+ * Number of thumbnails shown by one page of the icon view.
+ */
+static const int s_pageSize = 40;
+
+static QString thumbPath(int i)
+{
+    return QString::fromLatin1("/collection/album%1/image%2.jpg").arg(i / 1000).arg(i);
+}
+
+static ThumbnailInfo thumbInfo(int i)
+{
+    ThumbnailInfo info;
+    info.filePath         = thumbPath(i);
+    info.modificationDate = QDateTime(QDate(2024, 1, 1), QTime(0, 0));
+
+    return info;
+}
+
+static QImage makeThumbnail()
+{
+    // A smooth gradient with some noise, which compresses like a photograph.
+
+    QImage img(256, 192, QImage::Format_RGB32);
+    QLinearGradient gradient(0, 0, img.width(), img.height());
+    gradient.setColorAt(0.0, QColor::fromHsv(QRandomGenerator::global()->bounded(360), 200, 220));
+    gradient.setColorAt(1.0, QColor::fromHsv(QRandomGenerator::global()->bounded(360), 150, 80));
+
+    QPainter p(&img);
+    p.fillRect(img.rect(), gradient);
+    p.end();
+
+    for (int y = 0 ; y < img.height() ; ++y)
+    {
+        QRgb* const line = reinterpret_cast<QRgb*>(img.scanLine(y));
+
+        for (int x = 0 ; x < img.width() ; ++x)
+        {
+            const int n = QRandomGenerator::global()->bounded(16);
+            line[x]     = qRgb(qMin(255, qRed(line[x])   + n),
+                               qMin(255, qGreen(line[x]) + n),
+                               qMin(255, qBlue(line[x])  + n));
+        }
+    }
+
+    return img;
+}
+
+static void write(int count)
+{
+    QElapsedTimer timer;
+    qint64 dbTime   = 0;
+    qint64 packTime = 0;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        const QImage img = makeThumbnail();
+
+        timer.start();
+
+        ThumbsDbInfo dbInfo;
+        dbInfo.type             = DatabaseThumbnail::PGF;
+        dbInfo.modificationDate = thumbInfo(i).modificationDate;
+
+        PGFUtils::writePGFImageData(img, dbInfo.data, 4);
+
+        {
+            ThumbsDbAccess access;
+            QVariant id;
+            access.backend()->beginTransaction();
+            access.db()->insertThumbnail(dbInfo, &id);
+            access.db()->insertFilePath(thumbPath(i), id.toInt());
+            access.backend()->commitTransaction();
+        }
+
+        dbTime  += timer.nsecsElapsed();
+        timer.start();
+
+        ThumbnailPackFile::instance()->store(thumbInfo(i), img, thumbInfo(i).modificationDate, 0);
+
+        packTime += timer.nsecsElapsed();
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Write %1 thumbnails: database %2 thumbs/s - pack file %3 thumbs/s (%4 MB)")
+           .arg(count)
+           .arg(count * 1.0E9 / qMax(dbTime,   (qint64)1), 0, 'f', 0)
+           .arg(count * 1.0E9 / qMax(packTime, (qint64)1), 0, 'f', 0)
+           .arg(ThumbnailPackFile::instance()->dataSize() / 1048576.0, 0, 'f', 1);
+}
+
+/**
+ * Read all thumbnails page by page, as when scrolling the icon view,
+ * and return the throughput in thumbnails per second.
+ */
+static double scrollDatabase(int count)
+{
+    QElapsedTimer timer;
+    timer.start();
+    quint64 check = 0;
+
+    for (int page = 0 ; page < count ; page += s_pageSize)
+    {
+        for (int i = page ; i < qMin(count, page + s_pageSize) ; ++i)
+        {
+            ThumbsDbInfo dbInfo = ThumbsDbAccess().db()->findByFilePath(thumbPath(i));
+            QImage img;
+
+            if (PGFUtils::readPGFImageData(dbInfo.data, img))
+            {
+                check += img.pixel(0, 0);
+            }
+        }
+    }
+
+    Q_UNUSED(check);
+
+    return (count * 1.0E9 / qMax(timer.nsecsElapsed(), (qint64)1));
+}
+
+static double scrollPackFile(int count)
+{
+    QElapsedTimer timer;
+    timer.start();
+    quint64 check = 0;
+
+    for (int page = 0 ; page < count ; page += s_pageSize)
+    {
+        for (int i = page ; i < qMin(count, page + s_pageSize) ; ++i)
+        {
+            QImage    img;
+            QDateTime date;
+            int       orientation = 0;
+
+            if (ThumbnailPackFile::instance()->find(thumbInfo(i), img, date, orientation))
+            {
+                check += img.pixel(0, 0);
+            }
+        }
+    }
+
+    Q_UNUSED(check);
+
+    return (count * 1.0E9 / qMax(timer.nsecsElapsed(), (qint64)1));
+}
+
+static void read(int count)
+{
+    // The first pass runs just after opening the storages. Drop the page cache
+    // of the system between "write" and "read" runs to get a real cold start.
+
+    const double coldDb   = scrollDatabase(count);
+    const double coldPack = scrollPackFile(count);
+    const double warmDb   = scrollDatabase(count);
+    const double warmPack = scrollPackFile(count);
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Cold scroll: database %1 thumbs/s - pack file %2 thumbs/s")
+           .arg(coldDb, 0, 'f', 0).arg(coldPack, 0, 'f', 0);
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Warm scroll: database %1 thumbs/s - pack file %2 thumbs/s")
+           .arg(warmDb, 0, 'f', 0).arg(warmPack, 0, 'f', 0);
+}
+
+int main(int argc, char** argv)
+{
+    QApplication app(argc, argv);
+
+    if ((argc < 3) || (argc > 4))
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "thumbspack_cli - compare thumbnails database and thumbnails pack file";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <directory> <count> [write|read]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Without mode, write then read the thumbnails.";
+        return -1;
+    }
+
+    const QString dir   = QString::fromUtf8(argv[1]);
+    const int count     = QString::fromUtf8(argv[2]).toInt();
+    const QString mode  = (argc == 4) ? QString::fromUtf8(argv[3]) : QString();
+
+    if ((count <= 0) || !QDir().mkpath(dir))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    if (!QSqlDatabase::isDriverAvailable(DbEngineParameters::SQLiteDatabaseType()))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Qt SQlite plugin is missing.";
+        return -1;
+    }
+
+    DbEngineParameters params;
+    params.databaseType = DbEngineParameters::SQLiteDatabaseType();
+    params.setThumbsDatabasePath(dir + QLatin1String("/thumbnails-digikam.db"));
+    params.legacyAndDefaultChecks();
+
+    ThumbsDbAccess::setParameters(params.thumbnailParameters());
+
+    if (!ThumbsDbAccess::checkReadyForUse(nullptr) || !ThumbnailPackFile::instance()->open(dir + QLatin1String("/pack")))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Cannot open thumbnails storages in" << dir;
+        return -1;
+    }
+
+    if (mode != QLatin1String("read"))
+    {
+        write(count);
+    }
+
+    if (mode != QLatin1String("write"))
+    {
+        read(count);
+    }
+
+    ThumbnailPackFile::instance()->close();
+    ThumbsDbAccess::cleanUpDatabase();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to benchmark tiled filters with different threads count
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QThreadPool>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dimg.h"
+#include "blurfilter.h"
+#include "sharpenfilter.h"
+#include "unsharpmaskfilter.h"
+#include "localcontrastfilter.h"
+#include "nrfilter.h"
+
+using namespace Digikam;
+
+/**
+ * Run the filter created by 'create' and return the elapsed time in milliseconds.
+ */
+template <class Filter, class Creator>
+static double benchmark(DImg& img, Creator create)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    Filter* const filter = create(&img);
+    filter->startFilterDirectly();
+    DImg result          = filter->getTargetImage();
+    delete filter;
+
+    Q_UNUSED(result);
+
+    return (timer.nsecsElapsed() / 1.0E6);
+}
+
+static double run(const QString& name, DImg& img)
+{
+    if      (name == QLatin1String("Blur"))
+    {
+        return benchmark<BlurFilter>(img, [](DImg* const orgImage)
+            {
+                return new BlurFilter(orgImage, nullptr, 10);
+            }
+        );
+    }
+    else if (name == QLatin1String("Sharpen"))
+    {
+        return benchmark<SharpenFilter>(img, [](DImg* const orgImage)
+            {
+                return new SharpenFilter(orgImage, nullptr, 2.0, 1.0);
+            }
+        );
+    }
+    else if (name == QLatin1String("UnsharpMask"))
+    {
+        return benchmark<UnsharpMaskFilter>(img, [](DImg* const orgImage)
+            {
+                return new UnsharpMaskFilter(orgImage, nullptr, 1.0, 1.0, 0.05, false);
+            }
+        );
+    }
+    else if (name == QLatin1String("LocalContrast"))
+    {
+        return benchmark<LocalContrastFilter>(img, [](DImg* const orgImage)
+            {
+                LocalContrastContainer prm;
+                prm.stage[0].enabled = true;
+                prm.stage[1].enabled = true;
+                prm.lowSaturation    = 80;
+
+                return new LocalContrastFilter(orgImage, nullptr, prm);
+            }
+        );
+    }
+
+    return benchmark<NRFilter>(img, [](DImg* const orgImage)
+        {
+            return new NRFilter(orgImage, nullptr, NRContainer());
+        }
+    );
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int width  = 6000;
+    int height = 4000;
+
+    if      (argc == 3)
+    {
+        width  = QString::fromUtf8(argv[1]).toInt();
+        height = QString::fromUtf8(argv[2]).toInt();
+    }
+    else if (argc != 1)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "dimgfiltertiles_cli - benchmark tiled filters from 1 to 32 threads";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [<width> <height>]";
+        return -1;
+    }
+
+    if ((width <= 0) || (height <= 0))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    DImg img(width, height, false, true);
+    uchar* const data = img.bits();
+
+    for (quint64 i = 0 ; i < img.numBytes() ; ++i)
+    {
+        data[i] = (uchar)QRandomGenerator::global()->bounded(256);
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Source image:" << width << "x" << height
+                               << "-" << QThread::idealThreadCount() << "cores";
+
+    const QStringList filters = { QLatin1String("Blur"),
+                                  QLatin1String("Sharpen"),
+                                  QLatin1String("UnsharpMask"),
+                                  QLatin1String("LocalContrast"),
+                                  QLatin1String("NoiseReduction") };
+
+    const QList<int> threads  = { 1, 2, 4, 8, 16, 32 };
+
+    for (const QString& name : filters)
+    {
+        double reference = 0.0;
+
+        for (int count : threads)
+        {
+            QThreadPool::globalInstance()->setMaxThreadCount(count);
+
+            const double ms = run(name, img);
+
+            if (count == 1)
+            {
+                reference = ms;
+            }
+
+            qCDebug(DIGIKAM_TESTS_LOG).noquote()
+                << QString::fromLatin1("%1 - %2 threads : %3 ms - speed-up x%4")
+                   .arg(name, -14)
+                   .arg(count, 2)
+                   .arg(ms, 0, 'f', 0)
+                   .arg(reference / qMax(ms, 0.001), 0, 'f', 2);
+        }
+    }
+
+    return 0;
+}
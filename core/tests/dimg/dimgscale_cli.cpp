@@ -0,0 +1,135 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to benchmark DImg smooth scale kernels
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dimg.h"
+
+using namespace Digikam;
+
+/**
+ * Run one kernel 'loops' times and return the throughput in megapixels of
+ * source image processed per second.
+ */
+static double benchmark(const DImg& img, const QSize& size, bool section, int loops)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0 ; i < loops ; ++i)
+    {
+        DImg scaled;
+
+        if (section)
+        {
+            scaled = img.smoothScaleSection(QRect(img.width()  / 4, img.height() / 4,
+                                                  img.width()  / 2, img.height() / 2), size);
+        }
+        else
+        {
+            scaled = img.smoothScale(size, Qt::IgnoreAspectRatio);
+        }
+
+        Q_UNUSED(scaled);
+    }
+
+    double secs   = qMax(timer.nsecsElapsed(), (qint64)1) / 1.0E9;
+    double mpixel = (double)img.width() * img.height() / 1.0E6;
+
+    if (section)
+    {
+        mpixel /= 4.0;
+    }
+
+    return (mpixel * loops / secs);
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int width  = 8000;
+    int height = 6000;
+    int loops  = 3;
+
+    if (argc == 4)
+    {
+        width  = QString::fromUtf8(argv[1]).toInt();
+        height = QString::fromUtf8(argv[2]).toInt();
+        loops  = QString::fromUtf8(argv[3]).toInt();
+    }
+    else if (argc != 1)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "dimgscale_cli - benchmark DImg smooth scale kernels";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [<width> <height> <loops>]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Set DIGIKAM_DIMGSCALE_SIMD to 0 (scalar), 1 (SSE4.1) or 2 (AVX2) to select the kernels";
+        return -1;
+    }
+
+    if ((width <= 0) || (height <= 0) || (loops <= 0))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Source image:" << width << "x" << height << "-" << loops << "loops";
+    qCDebug(DIGIKAM_TESTS_LOG) << "SIMD level requested:"
+                               << (qEnvironmentVariableIsSet("DIGIKAM_DIMGSCALE_SIMD") ? qgetenv("DIGIKAM_DIMGSCALE_SIMD")
+                                                                                       : QByteArray("auto"));
+
+    const QList<QSize> sizes =
+    {
+        QSize(256,            256 * height / width),                  // thumbnail
+        QSize(1920,           1920 * height / width),                 // preview
+        QSize(width * 3 / 2,  height * 3 / 2)                         // up-scaling
+    };
+
+    for (int sixteenBit = 0 ; sixteenBit < 2 ; ++sixteenBit)
+    {
+        for (int alpha = 0 ; alpha < 2 ; ++alpha)
+        {
+            DImg img(width, height, (bool)sixteenBit, (bool)alpha);
+            uchar* const data = img.bits();
+
+            for (quint64 i = 0 ; i < img.numBytes() ; ++i)
+            {
+                data[i] = (uchar)QRandomGenerator::global()->bounded(256);
+            }
+
+            const QString kernel = QString::fromLatin1("%1 bits %2").arg(sixteenBit ? 16 : 8)
+                                                                    .arg(alpha ? QLatin1String("RGBA")
+                                                                               : QLatin1String("RGB"));
+
+            for (const QSize& size : sizes)
+            {
+                qCDebug(DIGIKAM_TESTS_LOG).noquote()
+                    << QString::fromLatin1("%1 -> %2x%3 : smoothScale %4 MP/s - smoothScaleSection %5 MP/s")
+                       .arg(kernel)
+                       .arg(size.width())
+                       .arg(size.height())
+                       .arg(benchmark(img, size, false, loops), 0, 'f', 1)
+                       .arg(benchmark(img, size, true,  loops), 0, 'f', 1);
+            }
+        }
+    }
+
+    return 0;
+}
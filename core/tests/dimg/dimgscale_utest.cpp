@@ -0,0 +1,143 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a test to compare the scalar and SIMD DImg smooth scale kernels
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "dimgscale_utest.h"
+
+// Qt includes
+
+#include <QRandomGenerator>
+#include <QTest>
+
+// Local includes
+
+#include "dimg.h"
+#include "dsimdlevel.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(DImgScaleTest)
+
+/**
+ * Scale the image with the kernels selected by DIGIKAM_DIMGSCALE_SIMD (0 = scalar, 1 = SSE4.1, 2 = AVX2).
+ */
+static DImg scaleWithLevel(const DImg& img, const QSize& size, bool section, int level)
+{
+    DSimdLevel simd("DIGIKAM_DIMGSCALE_SIMD", level);
+
+    if (section)
+    {
+        return img.smoothScaleSection(QRect(img.width() / 5, img.height() / 7,
+                                            img.width() / 2, img.height() / 2), size);
+    }
+
+    return img.smoothScale(size, Qt::IgnoreAspectRatio);
+}
+
+DImgScaleTest::DImgScaleTest(QObject* const parent)
+    : QObject(parent)
+{
+}
+
+void DImgScaleTest::initTestCase()
+{
+
+#if !defined(__GNUC__) || !defined(__x86_64__)
+
+    QSKIP("The SIMD scale kernels are only built for x86-64");
+
+#endif
+
+}
+
+void DImgScaleTest::testSimdBitExact_data()
+{
+    QTest::addColumn<bool>("sixteenBit");
+    QTest::addColumn<bool>("alpha");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<bool>("section");
+
+    const QList<QSize> sizes =
+    {
+        QSize(64,  47),                     // down-scaling
+        QSize(257, 61),                     // down-scaling, with other factors on X and Y
+        QSize(257, 800),                    // down-scaling on X, up-scaling on Y
+        QSize(900, 61),                     // up-scaling on X, down-scaling on Y
+        QSize(901, 677)                     // up-scaling
+    };
+
+    for (int sixteenBit = 0 ; sixteenBit < 2 ; ++sixteenBit)
+    {
+        for (int alpha = 0 ; alpha < 2 ; ++alpha)
+        {
+            for (const QSize& size : sizes)
+            {
+                for (int section = 0 ; section < 2 ; ++section)
+                {
+                    QTest::newRow(QString::fromLatin1("%1 bits %2 -> %3x%4%5")
+                                  .arg(sixteenBit ? 16 : 8)
+                                  .arg(alpha ? QLatin1String("RGBA") : QLatin1String("RGB"))
+                                  .arg(size.width())
+                                  .arg(size.height())
+                                  .arg(section ? QLatin1String(" section") : QLatin1String(""))
+                                  .toLatin1().constData())
+                        << (bool)sixteenBit
+                        << (bool)alpha
+                        << size
+                        << (bool)section;
+                }
+            }
+        }
+    }
+}
+
+void DImgScaleTest::testSimdBitExact()
+{
+    QFETCH(bool,  sixteenBit);
+    QFETCH(bool,  alpha);
+    QFETCH(QSize, size);
+    QFETCH(bool,  section);
+
+    // Odd sizes to run the kernels on the borders, with a fixed seed for reproducible results.
+
+    DImg img(613, 419, sixteenBit, alpha);
+    uchar* const data = img.bits();
+    QRandomGenerator generator(12345);
+
+    for (quint64 i = 0 ; i < img.numBytes() ; ++i)
+    {
+        data[i] = (uchar)generator.bounded(256);
+    }
+
+    const DImg scalar = scaleWithLevel(img, size, section, 0);
+
+    QVERIFY(!scalar.isNull());
+
+    // The level is bounded by the CPU features at run-time: an unsupported level runs the best available kernels.
+
+    for (int level = 1 ; level <= 2 ; ++level)
+    {
+        const DImg simd = scaleWithLevel(img, size, section, level);
+
+        QCOMPARE(simd.width(),    scalar.width());
+        QCOMPARE(simd.height(),   scalar.height());
+        QCOMPARE(simd.numBytes(), scalar.numBytes());
+
+        const qint64 diff = DSimdLevel::firstDifference(simd.bits(), scalar.bits(), scalar.numBytes());
+        const qint64 px   = diff / scalar.bytesDepth();
+
+        QVERIFY2(diff == -1,
+                 qPrintable(QString::fromLatin1("SIMD level %1 differs from the scalar kernels at pixel (%2, %3)")
+                            .arg(level).arg(px % scalar.width()).arg(px / scalar.width())));
+    }
+}
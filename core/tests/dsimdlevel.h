@@ -0,0 +1,80 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Common class to select the level of the SIMD kernels
+ *               in the unit-tests comparing them with the scalar code.
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// C++ includes
+
+#include <cstring>
+
+// Qt includes
+
+#include <QByteArray>
+#include <QtGlobal>
+
+/**
+ * \brief Class that selects the level of SIMD kernels for its life time.
+ *
+ * The kernels read their environment variable (as DIGIKAM_DIMGSCALE_SIMD) when an operation
+ * starts, and bound it by the CPU features: 0 runs the scalar code, an unsupported level runs
+ * the best available kernels. The best level is used again when the instance is destroyed.
+ */
+
+class DSimdLevel
+{
+public:
+
+    DSimdLevel(const char* const variable, int level)
+        : m_variable(variable)
+    {
+        qputenv(m_variable, QByteArray::number(level));
+    }
+
+    ~DSimdLevel()
+    {
+        qunsetenv(m_variable);
+    }
+
+    /**
+     * Offset of the first byte which differs between the outputs of two kernels,
+     * or -1 if they are identical.
+     */
+    static qint64 firstDifference(const void* const simd, const void* const scalar, qint64 size)
+    {
+        if (memcmp(simd, scalar, size) == 0)
+        {
+            return -1;
+        }
+
+        const uchar* const s = static_cast<const uchar*>(simd);
+        const uchar* const r = static_cast<const uchar*>(scalar);
+        qint64 i             = 0;
+
+        while (s[i] == r[i])
+        {
+            ++i;
+        }
+
+        return i;
+    }
+
+private:
+
+    const char* m_variable = nullptr;
+
+private:
+
+    Q_DISABLE_COPY(DSimdLevel)
+};
@@ -0,0 +1,168 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to run the face pipeline over a directory
+ *               and report the throughput and the queue length of each stage
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSqlDatabase>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QUrl>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "collectionmanager.h"
+#include "collectionscanner.h"
+#include "coredb.h"
+#include "coredbaccess.h"
+#include "dbengineparameters.h"
+#include "facedbaccess.h"
+#include "facepipeline.h"
+#include "iteminfo.h"
+
+using namespace Digikam;
+
+int main(int argc, char** argv)
+{
+    QApplication app(argc, argv);
+
+    // Do not change the settings of the user.
+
+    QStandardPaths::setTestModeEnabled(true);
+
+    if (argc < 2)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "benchmark_facepipeline_cli - run the face pipeline over the images of a directory";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <directory> [reduced] [parallel] [recognize]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "reduced:   detect on the smallest adequate preview";
+        qCDebug(DIGIKAM_TESTS_LOG) << "parallel:  use several detection threads";
+        qCDebug(DIGIKAM_TESTS_LOG) << "recognize: recognize the detected faces";
+        return -1;
+    }
+
+    const QString dir = QDir(QString::fromLocal8Bit(argv[1])).absolutePath();
+    QStringList options;
+
+    for (int i = 2 ; i < argc ; ++i)
+    {
+        options << QString::fromLatin1(argv[i]);
+    }
+
+    if (!QDir(dir).exists())
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid directory" << dir;
+        return -1;
+    }
+
+    if (!QSqlDatabase::isDriverAvailable(DbEngineParameters::SQLiteDatabaseType()))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Qt SQlite plugin is missing.";
+        return -1;
+    }
+
+    // The databases are created from scratch, the images are only read.
+
+    QTemporaryDir tmp;
+    const QString dbFile = tmp.filePath(QLatin1String("digikam4.db"));
+
+    DbEngineParameters params(DbEngineParameters::SQLiteDatabaseType(), dbFile,
+                              DbEngineParameters::SQLiteDatabaseType(), dbFile);
+    params.setFaceDatabasePath(tmp.path());
+    CoreDbAccess::setParameters(params, CoreDbAccess::MainApplication);
+    FaceDbAccess::setParameters(params);
+
+    if (!CoreDbAccess::checkReadyForUse(nullptr) || !FaceDbAccess::checkReadyForUse(nullptr))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Cannot open the databases in" << tmp.path();
+        return -1;
+    }
+
+    CollectionManager::instance()->addLocation(QUrl::fromLocalFile(dir));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CollectionScanner().completeScan();
+
+    ItemInfoList infos(CoreDbAccess().db()->getAllItems());
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Scanned %1 items in %2 ms").arg(infos.size()).arg(timer.elapsed());
+
+    if (infos.isEmpty())
+    {
+        CoreDbAccess::cleanUpDatabase();
+        return 0;
+    }
+
+    FacePipeline pipeline;
+    pipeline.plugDatabaseFilter(FacePipeline::ScanAll);
+    pipeline.plugFacePreviewLoader(options.contains(QLatin1String("reduced")) ? FacePipeline::ReducedSizePreview
+                                                                               : FacePipeline::HighQualityPreview);
+
+    if (options.contains(QLatin1String("parallel")))
+    {
+        pipeline.plugParallelFaceDetectors();
+    }
+    else
+    {
+        pipeline.plugFaceDetector();
+    }
+
+    if (options.contains(QLatin1String("recognize")))
+    {
+        pipeline.plugFaceRecognizer();
+    }
+
+    pipeline.plugDatabaseWriter(FacePipeline::NormalWrite);
+    pipeline.setAccuracyAndModel(0.7, false);
+    pipeline.construct();
+
+    QEventLoop loop;
+
+    QObject::connect(&pipeline, SIGNAL(finished()),
+                     &loop, SLOT(quit()));
+
+    timer.restart();
+    pipeline.process(infos);
+    loop.exec();
+
+    const qint64 elapsed = qMax((qint64)1, timer.elapsed());
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Pipeline: %1 images in %2 ms - %3 img/s")
+           .arg(infos.size())
+           .arg(elapsed)
+           .arg(infos.size() * 1000.0 / elapsed, 0, 'f', 1);
+
+    const QList<FacePipelineStageStats> stages = pipeline.stageStatistics();
+
+    for (const FacePipelineStageStats& stats : stages)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG).noquote() << stats.toString();
+    }
+
+    pipeline.shutDown();
+
+    FaceDbAccess::cleanUpDatabase();
+    CoreDbAccess::cleanUpDatabase();
+
+    return 0;
+}
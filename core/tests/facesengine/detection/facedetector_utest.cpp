@@ -0,0 +1,158 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the batched face detection against the detection of one image
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "facedetector_utest.h"
+
+// Qt includes
+
+#include <QDirIterator>
+#include <QStandardPaths>
+
+// Local includes
+
+#include "dcolor.h"
+#include "dimg.h"
+#include "dtestdatadir.h"
+#include "facedetector.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(FaceDetectorTest)
+
+/**
+ * Put the image at the top left of a larger canvas, so that the detection
+ * works on a non-square image whatever the shape of the original one.
+ */
+static DImg nonSquareCanvas(const DImg& image, bool landscape)
+{
+    const uint width  = landscape ? image.width() * 2 : image.width();
+    const uint height = landscape ? image.height()    : image.height() * 2;
+
+    DImg canvas(width, height, image.sixteenBit(), image.hasAlpha());
+    canvas.fill(DColor(QColor(128, 128, 128), image.sixteenBit()));
+    canvas.bitBltImage(&image, 0, 0);
+
+    return canvas;
+}
+
+static void compareRects(const QList<QRectF>& batch, const QList<QRectF>& single)
+{
+    QCOMPARE(batch.size(), single.size());
+
+    // One pass of the network for several images can round the scores a bit differently.
+
+    for (int i = 0 ; i < single.size() ; ++i)
+    {
+        QVERIFY2(qAbs(batch.at(i).x()      - single.at(i).x())      < 0.01, "Face offset on x");
+        QVERIFY2(qAbs(batch.at(i).y()      - single.at(i).y())      < 0.01, "Face offset on y");
+        QVERIFY2(qAbs(batch.at(i).width()  - single.at(i).width())  < 0.01, "Face width changed");
+        QVERIFY2(qAbs(batch.at(i).height() - single.at(i).height()) < 0.01, "Face height changed");
+    }
+}
+
+void FaceDetectorTest::initTestCase()
+{
+    const QString models = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
+                                                  QLatin1String("digikam/facesengine"),
+                                                  QStandardPaths::LocateDirectory);
+
+    if (models.isEmpty())
+    {
+        QSKIP("The face detection models are not installed");
+    }
+
+    const QString filesPath = DTestDataDir::TestData(QString::fromUtf8("core/tests/facesengine"))
+                              .root().path();
+
+    QDirIterator it(filesPath, QStringList() << QLatin1String("*.jpg") << QLatin1String("*.png"),
+                    QDir::Files, QDirIterator::Subdirectories);
+
+    while (it.hasNext() && (m_imagePaths.size() < 8))
+    {
+        m_imagePaths << it.next();
+    }
+
+    if (m_imagePaths.isEmpty())
+    {
+        QSKIP("No face images in the test data");
+    }
+}
+
+void FaceDetectorTest::testBatchNonSquare_data()
+{
+    QTest::addColumn<bool>("yolo");
+
+    QTest::newRow("YuNet") << false;
+    QTest::newRow("YOLO")  << true;
+}
+
+void FaceDetectorTest::testBatchNonSquare()
+{
+    QFETCH(bool, yolo);
+
+    FaceDetector detector;
+    QVariantMap params;
+    params[QLatin1String("useyolov3")] = yolo;
+    detector.setParameters(params);
+
+    // Landscape and portrait images, mixed in the same batch.
+
+    QList<DImg> images;
+
+    for (const QString& path : std::as_const(m_imagePaths))
+    {
+        const DImg image(path);
+
+        if (!image.isNull())
+        {
+            images << nonSquareCanvas(image, true)
+                   << nonSquareCanvas(image, false);
+        }
+    }
+
+    QVERIFY(!images.isEmpty());
+
+    QList<QImage> qimages;
+
+    for (const DImg& image : std::as_const(images))
+    {
+        qimages << image.copyQImage();
+    }
+
+    const QList<QList<QRectF> > batch  = detector.detectFaces(images);
+    const QList<QList<QRectF> > qbatch = detector.detectFaces(qimages);
+
+    QCOMPARE(batch.size(),  images.size());
+    QCOMPARE(qbatch.size(), images.size());
+
+    int faces = 0;
+
+    for (int i = 0 ; i < images.size() ; ++i)
+    {
+        const QList<QRectF> single = detector.detectFaces(images.at(i));
+        faces                     += single.size();
+
+        compareRects(batch.at(i),  single);
+        compareRects(qbatch.at(i), detector.detectFaces(qimages.at(i)));
+
+        // The QImage and DImg paths prepare the image the same way.
+
+        compareRects(qbatch.at(i), single);
+    }
+
+    if (faces == 0)
+    {
+        QSKIP("No face found in the test images");
+    }
+}
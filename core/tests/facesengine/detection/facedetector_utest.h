@@ -0,0 +1,41 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Test the batched face detection against the detection of one image
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QTest>
+
+class FaceDetectorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit FaceDetectorTest(QObject* const parent = nullptr)
+        : QObject(parent)
+    {
+    }
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void testBatchNonSquare();
+    void testBatchNonSquare_data();
+
+private:
+
+    QStringList m_imagePaths;
+};
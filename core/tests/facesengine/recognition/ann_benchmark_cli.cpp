@@ -0,0 +1,280 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to compare the recall and the latency
+ *               of the face embeddings nearest neighbors searches
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// C++ includes
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSqlDatabase>
+#include <QStringList>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dbengineparameters.h"
+#include "facedbaccess.h"
+#include "facedboperationgroup.h"
+#include "facedb.h"
+#include "kd_tree.h"
+#include "hnsw_index.h"
+
+using namespace Digikam;
+
+static const int   s_dim          = 128;
+static const int   s_kNeighbors   = 5;
+static const float s_sqRange      = 0.4F;
+static const float s_cosThreshold = 0.8F;
+
+/**
+ * A unit vector around the center, as the embeddings of the faces of one person.
+ */
+static cv::Mat randomFace(const cv::Mat& center, float spread, std::mt19937& generator)
+{
+    std::normal_distribution<float> noise(0.0F, spread);
+    cv::Mat face = center.clone();
+
+    for (int i = 0 ; i < s_dim ; ++i)
+    {
+        face.at<float>(i) += noise(generator);
+    }
+
+    return (face / cv::norm(face));
+}
+
+/**
+ * Squared distances of the exact closest neighbors, with the same filters than the searches.
+ */
+static std::vector<float> exactNeighbors(const std::vector<cv::Mat>& faces, const cv::Mat& query)
+{
+    std::vector<float> distances;
+
+    for (const cv::Mat& face : faces)
+    {
+        const double sqDist = cv::norm(face, query, cv::NORM_L2SQR);
+
+        if ((sqDist < s_sqRange) && (face.dot(query) > s_cosThreshold))
+        {
+            distances.push_back(float(sqDist));
+        }
+    }
+
+    std::sort(distances.begin(), distances.end());
+    distances.resize(std::min(distances.size(), size_t(s_kNeighbors)));
+
+    return distances;
+}
+
+static int matchedNeighbors(const std::vector<float>& exact, const QMap<double, QVector<int> >& found)
+{
+    std::vector<float> distances;
+
+    for (QMap<double, QVector<int> >::const_iterator it = found.cbegin() ; it != found.cend() ; ++it)
+    {
+        distances.insert(distances.end(), it.value().size(), float(it.key()));
+    }
+
+    int matched = 0;
+
+    for (const float dist : exact)
+    {
+        std::vector<float>::iterator it = std::find_if(distances.begin(), distances.end(),
+                                                       [dist](float d) { return (std::fabs(d - dist) < 1.0e-4F); });
+
+        if (it != distances.end())
+        {
+            distances.erase(it);
+            ++matched;
+        }
+    }
+
+    return matched;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    if ((argc < 2) || (argc > 5))
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "ann_benchmark_cli - compare the face embeddings searches: KD-Tree, database KD-Tree and HNSW index";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <directory> [vectors] [queries] [identities]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "The directory hosts a new face database filled with synthetic embeddings.";
+        return -1;
+    }
+
+    const QString dir      = QString::fromUtf8(argv[1]);
+    const int nbVectors    = (argc > 2) ? QString::fromUtf8(argv[2]).toInt() : 20000;
+    const int nbQueries    = (argc > 3) ? QString::fromUtf8(argv[3]).toInt() : 500;
+    const int nbIdentities = (argc > 4) ? QString::fromUtf8(argv[4]).toInt() : 200;
+
+    if ((nbVectors <= 0) || (nbQueries <= 0) || (nbIdentities <= 0) || !QDir().mkpath(dir))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Invalid arguments";
+        return -1;
+    }
+
+    if (!QSqlDatabase::isDriverAvailable(DbEngineParameters::SQLiteDatabaseType()))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Qt SQlite plugin is missing.";
+        return -1;
+    }
+
+    DbEngineParameters params(DbEngineParameters::SQLiteDatabaseType(), dir + QLatin1String("/digikam4.db"));
+    params.setFaceDatabasePath(dir);
+    QFile::remove(params.databaseNameFace);
+    FaceDbAccess::setParameters(params);
+
+    if (!FaceDbAccess::checkReadyForUse(nullptr))
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "Cannot open the face database in" << dir;
+        return -1;
+    }
+
+    QFile::remove(FaceDb::indexSnapshotPath());
+
+    // Synthetic embeddings: unit vectors spread around one center per identity.
+    // With this spread, two faces of the same identity are below the distance threshold.
+
+    std::mt19937 generator(42);
+    std::normal_distribution<float> gaussian(0.0F, 1.0F);
+    std::uniform_int_distribution<int> pickIdentity(0, nbIdentities - 1);
+    const float spread = 0.035F;
+
+    std::vector<cv::Mat> centers;
+    std::vector<cv::Mat> faces;
+
+    for (int i = 0 ; i < nbIdentities ; ++i)
+    {
+        cv::Mat center(1, s_dim, CV_32F);
+
+        for (int j = 0 ; j < s_dim ; ++j)
+        {
+            center.at<float>(j) = gaussian(generator);
+        }
+
+        centers.push_back(center / cv::norm(center));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    {
+        FaceDbOperationGroup group;
+
+        for (int i = 0 ; i < nbVectors ; ++i)
+        {
+            const int identity  = pickIdentity(generator);
+            const cv::Mat face  = randomFace(centers[identity], spread, generator);
+            const int nodeId    = FaceDbAccess().db()->insertFaceVector(face, identity + 1, QLatin1String("benchmark"));
+
+            FaceDbAccess().db()->insertToTreeDb(nodeId, face);
+            faces.push_back(face);
+        }
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Database filled with %1 vectors of %2 identities in %3 ms")
+           .arg(nbVectors).arg(nbIdentities).arg(timer.elapsed());
+
+    // Build the structures.
+
+    timer.restart();
+    KDTree* const tree      = FaceDbAccess().db()->reconstructTree();
+    const qint64 treeBuild  = timer.elapsed();
+
+    timer.restart();
+    HNSWIndex* const index  = FaceDbAccess().db()->reconstructIndex();
+    const qint64 indexBuild = timer.elapsed();
+
+    index->save(FaceDb::indexSnapshotPath());
+
+    timer.restart();
+    HNSWIndex* const loaded = FaceDbAccess().db()->reconstructIndex();
+    const qint64 indexLoad  = timer.elapsed();
+
+    delete loaded;
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Build: Tree %1 ms - HNSW %2 ms - HNSW from snapshot %3 ms")
+           .arg(treeBuild).arg(indexBuild).arg(indexLoad);
+
+    // Queries: new faces of the known identities.
+
+    std::vector<cv::Mat>            queries;
+    std::vector<std::vector<float> > exact;
+    int expected = 0;
+
+    for (int i = 0 ; i < nbQueries ; ++i)
+    {
+        queries.push_back(randomFace(centers[pickIdentity(generator)], spread, generator));
+        exact.push_back(exactNeighbors(faces, queries.back()));
+        expected += int(exact.back().size());
+    }
+
+    const QStringList methods = QStringList() << QLatin1String("Tree")
+                                              << QLatin1String("DB")
+                                              << QLatin1String("HNSW");
+
+    for (int m = 0 ; m < methods.size() ; ++m)
+    {
+        int matched = 0;
+        timer.restart();
+
+        for (int i = 0 ; i < nbQueries ; ++i)
+        {
+            QMap<double, QVector<int> > neighbors;
+
+            if      (m == 0)
+            {
+                neighbors = tree->getClosestNeighbors(queries[i], s_sqRange, s_cosThreshold, s_kNeighbors);
+            }
+            else if (m == 1)
+            {
+                neighbors = FaceDbAccess().db()->getClosestNeighborsTreeDb(queries[i], s_sqRange, s_cosThreshold, s_kNeighbors);
+            }
+            else
+            {
+                neighbors = index->getClosestNeighbors(queries[i], s_sqRange, s_cosThreshold, s_kNeighbors);
+            }
+
+            matched += matchedNeighbors(exact[i], neighbors);
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("%1: %2 us per query - recall@%3 %4 %")
+               .arg(methods.at(m), 5)
+               .arg(double(elapsed) / 1000.0 / nbQueries, 0, 'f', 1)
+               .arg(s_kNeighbors)
+               .arg(expected ? (100.0 * matched / expected) : 100.0, 0, 'f', 2);
+    }
+
+    delete tree;
+    delete index;
+
+    FaceDbAccess::cleanUpDatabase();
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to measure the throughput of the
+ *               face detection and face embedding neural networks by batch size
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// C++ includes
+
+#include <vector>
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dnnfaceextractor.h"
+#include "opencvdnnfacedetector.h"
+#include "opencvdnnfacerecognizer.h"
+
+using namespace Digikam;
+
+/**
+ * A worker of the face pipeline: compute the embeddings of its faces one by one.
+ */
+class Q_DECL_HIDDEN EmbeddingRunnable : public QRunnable
+{
+public:
+
+    EmbeddingRunnable(DNNFaceExtractor* const extractor, const std::vector<cv::Mat>& faces, int first, int step)
+        : extractor(extractor),
+          faces    (faces),
+          first    (first),
+          step     (step)
+    {
+    }
+
+    void run() override
+    {
+        for (size_t i = first ; i < faces.size() ; i += step)
+        {
+            extractor->getFaceEmbedding(faces[i]);
+        }
+    }
+
+private:
+
+    DNNFaceExtractor* const     extractor;
+    const std::vector<cv::Mat>& faces;
+    const int                   first;
+    const int                   step;
+
+private:
+
+    Q_DISABLE_COPY(EmbeddingRunnable)
+};
+
+static double perSecond(int count, qint64 msecs)
+{
+    return (1000.0 * count / qMax((qint64)1, msecs));
+}
+
+static void benchmarkEmbeddings(const QList<QImage>& images, int threads, const QList<int>& batchSizes)
+{
+    std::vector<cv::Mat> faces;
+
+    for (QImage image : images)
+    {
+        faces.push_back(OpenCVDNNFaceRecognizer::prepareForRecognition(image));
+    }
+
+    for (const int batchSize : batchSizes)
+    {
+        DNNFaceExtractor extractor;
+        extractor.setBatchSize(batchSize);
+
+        // Warm-up: the networks of the pool are loaded on demand.
+
+        extractor.getFaceEmbeddings(std::vector<cv::Mat>(faces.begin(), faces.begin() + qMin((size_t)threads, faces.size())));
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+
+        for (int t = 0 ; t < threads ; ++t)
+        {
+            pool.start(new EmbeddingRunnable(&extractor, faces, t, threads));
+        }
+
+        pool.waitForDone();
+
+        const qint64 workers = timer.elapsed();
+
+        timer.restart();
+        extractor.getFaceEmbeddings(faces);
+        const qint64 list    = timer.elapsed();
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("Embeddings, batch %1: %2 faces/s from %3 workers - %4 faces/s from one list")
+               .arg(batchSize, 2)
+               .arg(perSecond(int(faces.size()), workers), 0, 'f', 1)
+               .arg(threads)
+               .arg(perSecond(int(faces.size()), list), 0, 'f', 1);
+    }
+}
+
+static void benchmarkDetection(const QList<QImage>& images, DetectorNNModel model,
+                               const QString& name, const QList<int>& batchSizes)
+{
+    OpenCVDNNFaceDetector detector(model);
+    std::vector<cv::Mat>  cvImages;
+    std::vector<cv::Size> paddedSizes;
+
+    for (const QImage& image : images)
+    {
+        cv::Size paddedSize(0, 0);
+        cvImages.push_back(detector.prepareForDetection(image, paddedSize));
+        paddedSizes.push_back(paddedSize);
+    }
+
+    for (const int batchSize : batchSizes)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        int faces = 0;
+
+        for (size_t i = 0 ; i < cvImages.size() ; i += batchSize)
+        {
+            const size_t end = qMin(cvImages.size(), i + batchSize);
+            const std::vector<std::vector<cv::Rect> > bboxes
+                = detector.cvDetectFaces(std::vector<cv::Mat>(cvImages.begin() + i, cvImages.begin() + end),
+                                         std::vector<cv::Size>(paddedSizes.begin() + i, paddedSizes.begin() + end));
+
+            for (const std::vector<cv::Rect>& rects : bboxes)
+            {
+                faces += int(rects.size());
+            }
+        }
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("Detection %1, batch %2: %3 images/s (%4 faces)")
+               .arg(name, 5)
+               .arg(batchSize, 2)
+               .arg(perSecond(int(cvImages.size()), timer.elapsed()), 0, 'f', 1)
+               .arg(faces);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    if ((argc < 2) || (argc > 4))
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "benchmark_dnnbatch_cli - measure the face networks throughput by batch size";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <images directory> [workers] [max images]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Embeddings are computed on the whole images, use a directory of cropped faces.";
+        return -1;
+    }
+
+    const QDir dir(QString::fromLocal8Bit(argv[1]));
+    const int threads   = (argc > 2) ? qMax(1, QString::fromLatin1(argv[2]).toInt()) : QThread::idealThreadCount();
+    const int maxImages = (argc > 3) ? qMax(1, QString::fromLatin1(argv[3]).toInt()) : 200;
+
+    QList<QImage> images;
+    const QStringList files = dir.entryList(QStringList() << QLatin1String("*.jpg")
+                                                          << QLatin1String("*.jpeg")
+                                                          << QLatin1String("*.png")
+                                                          << QLatin1String("*.pgm"),
+                                            QDir::Files, QDir::Name);
+
+    for (const QString& file : files)
+    {
+        QImage image(dir.filePath(file));
+
+        if (!image.isNull())
+        {
+            images << image;
+        }
+
+        if (images.size() >= maxImages)
+        {
+            break;
+        }
+    }
+
+    if (images.isEmpty())
+    {
+        qCWarning(DIGIKAM_TESTS_LOG) << "No image found in" << dir.path();
+        return -1;
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Images:" << images.size() << "- workers:" << threads;
+
+    const QList<int> batchSizes = QList<int>() << 1 << 4 << 8 << 16;
+
+    benchmarkEmbeddings(images, threads, batchSizes);
+    benchmarkDetection(images, DetectorNNModel::YOLO,  QLatin1String("YOLO"),  batchSizes);
+    benchmarkDetection(images, DetectorNNModel::YUNET, QLatin1String("YuNet"), QList<int>() << 1);
+
+    return 0;
+}
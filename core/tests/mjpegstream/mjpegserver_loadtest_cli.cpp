@@ -0,0 +1,329 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to load the MJPEG server with local clients,
+ *               some of them reading slowly, and report the frames received
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// C++ includes
+
+#include <memory>
+#include <vector>
+
+// Qt includes
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QImage>
+#include <QList>
+#include <QTcpSocket>
+#include <QTimer>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "mjpegserver.h"
+
+using namespace DigikamGenericMjpegStreamPlugin;
+
+/**
+ * A stream client parsing the multipart sections sent by the server.
+ * A slow client only reads a small amount of data periodically.
+ */
+class LoadTestClient
+{
+public:
+
+    explicit LoadTestClient(bool isSlow)
+        : slow(isSlow)
+    {
+        if (slow)
+        {
+            // The remaining data stay in the socket buffers until the next read.
+
+            socket.setReadBufferSize(16384);
+        }
+    }
+
+    void readData()
+    {
+        buffer.append(socket.readAll());
+
+        parse();
+    }
+
+    void parse()
+    {
+        if (!headerDone)
+        {
+            int end = buffer.indexOf("\r\n\r\n");
+
+            if (end == -1)
+            {
+                return;
+            }
+
+            if (!buffer.startsWith("HTTP/1.0 200 OK\r\n"))
+            {
+                broken = true;
+            }
+
+            buffer.remove(0, end + 4);
+            headerDone = true;
+        }
+
+        while (!broken)
+        {
+            const QByteArray boundary("--mjpegstream\r\n");
+
+            if (buffer.size() < boundary.size())
+            {
+                return;
+            }
+
+            if (!buffer.startsWith(boundary))
+            {
+                broken = true;
+                break;
+            }
+
+            const int end = buffer.indexOf("\r\n\r\n");
+
+            if (end == -1)
+            {
+                return;
+            }
+
+            const QByteArray key("Content-length: ");
+            const int pos       = buffer.indexOf(key);
+
+            if ((pos == -1) || (pos > end))
+            {
+                broken = true;
+                break;
+            }
+
+            const int length    = buffer.mid(pos + key.size(), end - pos - key.size()).toInt();
+            const int size      = end + 4 + length + 4;
+
+            if (buffer.size() < size)
+            {
+                return;
+            }
+
+            // Check the JPEG start of image marker and the section trailer.
+
+            if (
+                (length < 2)                                          ||
+                ((uchar)buffer.at(end + 4)     != 0xFF)               ||
+                ((uchar)buffer.at(end + 5)     != 0xD8)               ||
+                (buffer.mid(end + 4 + length, 4) != QByteArray("\r\n\r\n"))
+               )
+            {
+                broken = true;
+                break;
+            }
+
+            bytes += size;
+            ++frames;
+            buffer.remove(0, size);
+        }
+
+        buffer.clear();
+    }
+
+public:
+
+    QTcpSocket socket;
+    QByteArray buffer;
+    bool       slow       = false;
+    bool       headerDone = false;
+    bool       broken     = false;
+    qint64     frames     = 0;
+    qint64     bytes      = 0;
+};
+
+/**
+ * Some JPEG frames with gradients, as the frames of a slideshow.
+ */
+static QList<QByteArray> createFrames(const QSize& size, int count, int quality)
+{
+    QList<QByteArray> frames;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        QImage img(size, QImage::Format_RGB32);
+
+        for (int y = 0 ; y < size.height() ; ++y)
+        {
+            QRgb* const line = reinterpret_cast<QRgb*>(img.scanLine(y));
+
+            for (int x = 0 ; x < size.width() ; ++x)
+            {
+                line[x] = qRgb((x * 255 / size.width() + i * 40) & 0xFF,
+                               (y * 255 / size.height())         & 0xFF,
+                               ((x + y + i * 90) / 8)            & 0xFF);
+            }
+        }
+
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        img.save(&buffer, "JPEG", quality);
+        frames << data;
+    }
+
+    return frames;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc > 5)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "mjpegserver_loadtest_cli - stream frames to local clients";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [clients] [slow clients] [seconds] [port]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Default: 20 clients, 4 slow clients, 10 seconds, port 8090";
+
+        return -1;
+    }
+
+    const int clientsCount = qBound(1, (argc > 1) ? QString::fromLatin1(argv[1]).toInt() : 20, 30);
+    const int slowCount    = qBound(0, (argc > 2) ? QString::fromLatin1(argv[2]).toInt() : 4, clientsCount);
+    const int seconds      = qMax(1,   (argc > 3) ? QString::fromLatin1(argv[3]).toInt() : 10);
+    const int port         = (argc > 4) ? QString::fromLatin1(argv[4]).toInt() : 8090;
+    const int rate         = 25;
+
+    const QList<QByteArray> frames = createFrames(QSize(1920, 1080), 8, 75);
+
+    MjpegServer* const server = new MjpegServer(QLatin1String("127.0.0.1"), port);
+    server->setRate(rate);
+    server->setMaxClients(30);
+    server->start();
+
+    // The frames are pushed at the server rate, as the frames generator does.
+
+    int current = 0;
+    QTimer producer;
+    producer.setInterval(1000 / rate);
+
+    QObject::connect(&producer, &QTimer::timeout,
+                     [&]()
+        {
+            server->slotWriteFrame(frames.at(current++ % frames.size()));
+        }
+    );
+
+    std::vector<std::unique_ptr<LoadTestClient> > clients;
+
+    for (int i = 0 ; i < clientsCount ; ++i)
+    {
+        LoadTestClient* const client = new LoadTestClient(i < slowCount);
+        clients.emplace_back(client);
+
+        if (!client->slow)
+        {
+            QObject::connect(&client->socket, &QTcpSocket::readyRead,
+                             [client]()
+                {
+                    client->readData();
+                }
+            );
+        }
+
+        client->socket.connectToHost(QHostAddress(QHostAddress::LocalHost), port);
+    }
+
+    // The slow clients read 16 KiB every 100 ms.
+
+    QTimer slowReader;
+    slowReader.setInterval(100);
+
+    QObject::connect(&slowReader, &QTimer::timeout,
+                     [&clients]()
+        {
+            for (const auto& client : clients)
+            {
+                if (client->slow)
+                {
+                    client->readData();
+                }
+            }
+        }
+    );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    producer.start();
+    slowReader.start();
+    QTimer::singleShot(seconds * 1000, &app, SLOT(quit()));
+    app.exec();
+
+    const double elapsed = qMax((qint64)1, timer.elapsed()) / 1000.0;
+
+    producer.stop();
+    slowReader.stop();
+    server->stop();
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("%1 clients (%2 slow), %3 frames pushed in %4 s at %5 frames/s")
+           .arg(clientsCount)
+           .arg(slowCount)
+           .arg(current)
+           .arg(elapsed, 0, 'f', 1)
+           .arg(rate);
+
+    for (bool slow : { false, true })
+    {
+        int count     = 0;
+        int broken    = 0;
+        qint64 total  = 0;
+        qint64 bytes  = 0;
+        qint64 minFps = -1;
+
+        for (const auto& client : clients)
+        {
+            if (client->slow != slow)
+            {
+                continue;
+            }
+
+            ++count;
+            broken += client->broken ? 1 : 0;
+            total  += client->frames;
+            bytes  += client->bytes;
+            minFps  = (minFps == -1) ? client->frames : qMin(minFps, client->frames);
+        }
+
+        if (count == 0)
+        {
+            continue;
+        }
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("%1 clients: %2 frames/s average, %3 frames/s minimum, %4 MB/s, %5 broken streams")
+               .arg(slow ? QLatin1String("Slow  ") : QLatin1String("Normal"))
+               .arg(total / elapsed / count, 0, 'f', 1)
+               .arg(minFps / elapsed, 0, 'f', 1)
+               .arg(bytes / elapsed / 1.0E6, 0, 'f', 1)
+               .arg(broken);
+    }
+
+    clients.clear();
+    delete server;
+
+    return 0;
+}
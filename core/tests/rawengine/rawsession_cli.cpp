@@ -0,0 +1,125 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to decode a RAW file again with other settings,
+ *               with and without a RAW session, and report the decoding times
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "drawdecoder.h"
+#include "drawdecodersession.h"
+#include "drawdecodersettings.h"
+
+using namespace Digikam;
+
+/**
+ * The settings changed one by one, as an user of the RAW import tool.
+ */
+static QList<QPair<QString, DRawDecoderSettings> > settingsSteps()
+{
+    QList<QPair<QString, DRawDecoderSettings> > steps;
+
+    DRawDecoderSettings settings;
+    settings.RAWQuality         = DRawDecoderSettings::AHD;
+    steps << qMakePair(QString::fromLatin1("Default AHD"),         settings);
+
+    DRawDecoderSettings preview = settings;
+    preview.halfSizeColorImage  = true;
+    steps << qMakePair(QString::fromLatin1("Half size preview"),   preview);
+
+    settings.whiteBalance       = DRawDecoderSettings::AUTO;
+    steps << qMakePair(QString::fromLatin1("Auto white balance"),  settings);
+
+    settings.RAWQuality         = DRawDecoderSettings::DHT;
+    steps << qMakePair(QString::fromLatin1("DHT demosaicing"),     settings);
+
+    settings.NRType             = DRawDecoderSettings::WAVELETSNR;
+    settings.NRThreshold        = 200;
+    steps << qMakePair(QString::fromLatin1("Wavelets denoising"),  settings);
+
+    steps << qMakePair(QString::fromLatin1("Same settings"),       settings);
+
+    return steps;
+}
+
+static qint64 decodeSteps(const QString& filePath)
+{
+    qint64 total = 0;
+    const QList<QPair<QString, DRawDecoderSettings> > steps = settingsSteps();
+
+    for (const auto& step : steps)
+    {
+        DRawDecoder decoder;
+        QByteArray  data;
+        int width   = 0;
+        int height  = 0;
+        int rgbmax  = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        bool ret              = decoder.decodeRAWImage(filePath, step.second, data, width, height, rgbmax);
+        const qint64 elapsed  = timer.elapsed();
+        total                += elapsed;
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("%1: %2x%3 in %4 ms%5")
+               .arg(step.first, -20)
+               .arg(width)
+               .arg(height)
+               .arg(elapsed, 6)
+               .arg(ret ? QString() : QString::fromLatin1(" - failed"));
+    }
+
+    return total;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "rawsession_cli - decode a RAW file again with other settings";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: <rawfile>";
+        return -1;
+    }
+
+    const QString filePath = QString::fromLocal8Bit(argv[1]);
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "--- Without session";
+
+    const qint64 withoutSession = decodeSteps(filePath);
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "--- With session";
+
+    qint64 withSession          = 0;
+
+    {
+        DRawDecoderSession session(filePath);
+        withSession             = decodeSteps(filePath);
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG).noquote()
+        << QString::fromLatin1("Total: %1 ms without session, %2 ms with session")
+           .arg(withoutSession)
+           .arg(withSession);
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a command line tool to render a fixed sequence of transitions
+ *               and effects, and report the frames per second at 1080p and 2160p
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QList>
+#include <QPainter>
+#include <QSize>
+#include <QThreadPool>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "effectmngr.h"
+#include "transitionmngr.h"
+
+using namespace Digikam;
+
+/**
+ * An opaque test image with gradients, as the framed images of a slideshow.
+ */
+static QImage createImage(const QSize& size, int seed)
+{
+    QImage img(size, QImage::Format_ARGB32);
+
+    for (int y = 0 ; y < size.height() ; ++y)
+    {
+        QRgb* const line = reinterpret_cast<QRgb*>(img.scanLine(y));
+
+        for (int x = 0 ; x < size.width() ; ++x)
+        {
+            line[x] = qRgba((x * 255 / size.width() + seed * 40) & 0xFF,
+                            (y * 255 / size.height())            & 0xFF,
+                            ((x + y + seed * 90) / 8)            & 0xFF,
+                            255);
+        }
+    }
+
+    return img;
+}
+
+int main(int argc, char** argv)
+{
+    QCoreApplication app(argc, argv);
+
+    if (argc > 2)
+    {
+        qCDebug(DIGIKAM_TESTS_LOG) << "framesrender_cli - render transitions and effects frames";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Usage: [max threads]";
+        qCDebug(DIGIKAM_TESTS_LOG) << "Set DIGIKAM_FRAMES_SIMD to 0 (scalar) or 1 (SSE2) to select the kernels";
+
+        return -1;
+    }
+
+    if (argc > 1)
+    {
+        QThreadPool::globalInstance()->setMaxThreadCount(qMax(1, QString::fromLatin1(argv[1]).toInt()));
+    }
+
+    qCDebug(DIGIKAM_TESTS_LOG) << "Threads:" << QThreadPool::globalInstance()->maxThreadCount()
+                               << "- SIMD:" << (qEnvironmentVariableIsSet("DIGIKAM_FRAMES_SIMD") ? qgetenv("DIGIKAM_FRAMES_SIMD")
+                                                                                                 : QByteArray("auto"));
+
+    const QList<TransitionMngr::TransType> transitions = QList<TransitionMngr::TransType>()
+        << TransitionMngr::PushL2R
+        << TransitionMngr::SlideB2T
+        << TransitionMngr::SwapR2L
+        << TransitionMngr::ChessBoard
+        << TransitionMngr::Growing
+        << TransitionMngr::SpiralIn
+        << TransitionMngr::BlurIn
+        << TransitionMngr::BlurOut;
+
+    const QList<EffectMngr::EffectType> effects = QList<EffectMngr::EffectType>()
+        << EffectMngr::KenBurnsZoomIn
+        << EffectMngr::KenBurnsZoomOut
+        << EffectMngr::KenBurnsPanLR
+        << EffectMngr::KenBurnsPanTB;
+
+    const QMap<TransitionMngr::TransType, QString> transNames = TransitionMngr::transitionNames();
+    const QMap<EffectMngr::EffectType, QString>    effNames   = EffectMngr::effectNames();
+    const int effectFrames                                    = 50;
+
+    for (const QSize& size : { QSize(1920, 1080), QSize(3840, 2160) })
+    {
+        const QImage img1 = createImage(size, 1);
+        const QImage img2 = createImage(size, 2);
+        int totalFrames   = 0;
+        qint64 totalTime  = 0;
+        quint64 checksum  = 0;
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote() << QString::fromLatin1("--- %1x%2").arg(size.width()).arg(size.height());
+
+        TransitionMngr transmngr;
+        transmngr.setOutputSize(size);
+
+        for (TransitionMngr::TransType type : transitions)
+        {
+            transmngr.setInImage(img1);
+            transmngr.setOutImage(img2);
+            transmngr.setTransition(type);
+
+            int tmout  = 0;
+            int frames = 0;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            do
+            {
+                QImage frame = transmngr.currentFrame(tmout);
+                checksum    += reinterpret_cast<const QRgb*>(frame.constScanLine(frame.height() / 2))[frame.width() / 3];
+                ++frames;
+            }
+            while (tmout != -1);
+
+            const qint64 elapsed = qMax((qint64)1, timer.elapsed());
+            totalFrames         += frames;
+            totalTime           += elapsed;
+
+            qCDebug(DIGIKAM_TESTS_LOG).noquote()
+                << QString::fromLatin1("%1: %2 frames in %3 ms - %4 fps")
+                   .arg(transNames.value(type), -24)
+                   .arg(frames, 4)
+                   .arg(elapsed, 6)
+                   .arg(frames * 1000.0 / elapsed, 0, 'f', 1);
+        }
+
+        EffectMngr effmngr;
+        effmngr.setOutputSize(size);
+        effmngr.setFrames(effectFrames);
+
+        for (EffectMngr::EffectType type : effects)
+        {
+            effmngr.setImage(img1);
+            effmngr.setEffect(type);
+
+            int tmout  = 0;
+            int frames = 0;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            do
+            {
+                QImage frame = effmngr.currentFrame(tmout);
+                checksum    += reinterpret_cast<const QRgb*>(frame.constScanLine(frame.height() / 2))[frame.width() / 3];
+                ++frames;
+            }
+            while (tmout != -1);
+
+            const qint64 elapsed = qMax((qint64)1, timer.elapsed());
+            totalFrames         += frames;
+            totalTime           += elapsed;
+
+            qCDebug(DIGIKAM_TESTS_LOG).noquote()
+                << QString::fromLatin1("%1: %2 frames in %3 ms - %4 fps")
+                   .arg(effNames.value(type), -24)
+                   .arg(frames, 4)
+                   .arg(elapsed, 6)
+                   .arg(frames * 1000.0 / elapsed, 0, 'f', 1);
+        }
+
+        qCDebug(DIGIKAM_TESTS_LOG).noquote()
+            << QString::fromLatin1("Total: %1 frames in %2 ms - %3 fps - checksum %4")
+               .arg(totalFrames)
+               .arg(totalTime)
+               .arg(totalFrames * 1000.0 / qMax((qint64)1, totalTime), 0, 'f', 1)
+               .arg(checksum, 0, 16);
+    }
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : a test to compare the scalar and SIMD transitions and effects frame kernels
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "framesrender_utest.h"
+
+// Qt includes
+
+#include <QImage>
+#include <QList>
+#include <QPair>
+#include <QRandomGenerator>
+#include <QSize>
+#include <QStringList>
+#include <QTest>
+
+// Local includes
+
+#include "dsimdlevel.h"
+#include "effectmngr.h"
+#include "transitionmngr.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(FramesRenderTest)
+
+namespace
+{
+
+enum Pattern
+{
+    Gradients = 0,      ///< Opaque: the blur sums are computed 4 pixels at once.
+    Checkerboard,       ///< Opaque, with the largest differences between adjacent pixels for the interpolation.
+    SparseAlpha,        ///< Groups of 4 pixels with opaque and transparent pixels, summed by the scalar code.
+    RandomAlpha         ///< Pixels which are not premultiplied, with unpremultiplied channels above 8 bits.
+};
+
+/// The output size is not a multiple of 4 pixels, to run the scalar code at the end of the rows.
+static const QSize s_outSize(331, 217);
+
+} // namespace
+
+static QImage createImage(const QSize& size, int seed, int pattern)
+{
+    QImage img(size, QImage::Format_ARGB32);
+    QRandomGenerator generator(seed);
+
+    for (int y = 0 ; y < size.height() ; ++y)
+    {
+        QRgb* const line = reinterpret_cast<QRgb*>(img.scanLine(y));
+
+        for (int x = 0 ; x < size.width() ; ++x)
+        {
+            if (pattern == Checkerboard)
+            {
+                line[x] = ((x + y + seed) & 1) ? qRgba(255, 255, 255, 255)
+                                               : qRgba(0,   0,   0,   255);
+                continue;
+            }
+
+            int alpha = 255;
+
+            if      (pattern == SparseAlpha)
+            {
+                alpha = ((x + y * 3) % 7) ? 255 : generator.bounded(256);
+            }
+            else if (pattern == RandomAlpha)
+            {
+                alpha = generator.bounded(256);
+            }
+
+            line[x] = qRgba((x * 255 / size.width() + seed * 40) & 0xFF,
+                            (y * 255 / size.height())            & 0xFF,
+                            ((x + y + seed * 90) / 8)            & 0xFF,
+                            alpha);
+        }
+    }
+
+    return img;
+}
+
+/**
+ * Render all frames of a transition with the kernels selected by DIGIKAM_FRAMES_SIMD (0 = scalar, 1 = SSE2).
+ */
+static QList<QImage> renderTransition(TransitionMngr::TransType type, int pattern, int level)
+{
+    DSimdLevel simd("DIGIKAM_FRAMES_SIMD", level);
+
+    TransitionMngr mngr;
+    mngr.setOutputSize(s_outSize);
+    mngr.setInImage(createImage(s_outSize, 1, pattern));
+    mngr.setOutImage(createImage(s_outSize, 2, pattern));
+    mngr.setTransition(type);
+
+    QList<QImage> frames;
+    int tmout = 0;
+
+    do
+    {
+        frames << mngr.currentFrame(tmout);
+    }
+    while (tmout != -1);
+
+    return frames;
+}
+
+/**
+ * Render all frames of an effect with the kernels selected by DIGIKAM_FRAMES_SIMD (0 = scalar, 1 = SSE2).
+ */
+static QList<QImage> renderEffect(EffectMngr::EffectType type, const QSize& size, int pattern, int level)
+{
+    DSimdLevel simd("DIGIKAM_FRAMES_SIMD", level);
+
+    EffectMngr mngr;
+    mngr.setOutputSize(s_outSize);
+    mngr.setEffect(type);
+    mngr.setImage(createImage(size, 3, pattern));
+    mngr.setFrames(25);
+
+    QList<QImage> frames;
+    int tmout = 0;
+
+    do
+    {
+        frames << mngr.currentFrame(tmout);
+    }
+    while (tmout != -1);
+
+    return frames;
+}
+
+static void compareFrames(const QList<QImage>& simd, const QList<QImage>& scalar)
+{
+    QVERIFY(!scalar.isEmpty());
+    QCOMPARE(simd.size(), scalar.size());
+
+    for (int i = 0 ; i < scalar.size() ; ++i)
+    {
+        QCOMPARE(simd[i].size(),         scalar[i].size());
+        QCOMPARE(simd[i].format(),       scalar[i].format());
+        QCOMPARE(simd[i].bytesPerLine(), scalar[i].bytesPerLine());
+
+        const qint64 diff = DSimdLevel::firstDifference(simd[i].constBits(), scalar[i].constBits(), scalar[i].sizeInBytes());
+
+        QVERIFY2(diff == -1,
+                 qPrintable(QString::fromLatin1("Frame %1 of the SSE2 kernels differs from the scalar kernels at pixel (%2, %3)")
+                            .arg(i)
+                            .arg((diff % scalar[i].bytesPerLine()) / qint64(sizeof(QRgb)))
+                            .arg(diff / scalar[i].bytesPerLine())));
+    }
+}
+
+static QString patternName(int pattern)
+{
+    const QStringList names =
+    {
+        QLatin1String("gradients"),
+        QLatin1String("checkerboard"),
+        QLatin1String("sparse alpha"),
+        QLatin1String("random alpha")
+    };
+
+    return names[pattern];
+}
+
+FramesRenderTest::FramesRenderTest(QObject* const parent)
+    : QObject(parent)
+{
+}
+
+void FramesRenderTest::initTestCase()
+{
+
+#if !defined(__GNUC__) || (!defined(__x86_64__) && !defined(__i386__))
+
+    QSKIP("The SIMD frame kernels are only built for x86");
+
+#endif
+
+}
+
+void FramesRenderTest::testTransitionsBitExact_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("pattern");
+
+    // The opaque images are blurred in the frame buffers, the others through TransitionMngr::Private::fastBlur().
+
+    for (int pattern = Gradients ; pattern <= RandomAlpha ; ++pattern)
+    {
+        QTest::newRow(QString::fromLatin1("BlurIn %1").arg(patternName(pattern)).toLatin1().constData())
+            << (int)TransitionMngr::BlurIn  << pattern;
+
+        QTest::newRow(QString::fromLatin1("BlurOut %1").arg(patternName(pattern)).toLatin1().constData())
+            << (int)TransitionMngr::BlurOut << pattern;
+    }
+}
+
+void FramesRenderTest::testTransitionsBitExact()
+{
+    QFETCH(int, type);
+    QFETCH(int, pattern);
+
+    const QList<QImage> scalar = renderTransition((TransitionMngr::TransType)type, pattern, 0);
+    const QList<QImage> simd   = renderTransition((TransitionMngr::TransType)type, pattern, 1);
+
+    compareFrames(simd, scalar);
+}
+
+void FramesRenderTest::testEffectsBitExact_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("pattern");
+
+    const QList<QPair<QLatin1String, EffectMngr::EffectType> > effects =
+    {
+        qMakePair(QLatin1String("KenBurnsZoomIn"),  EffectMngr::KenBurnsZoomIn),
+        qMakePair(QLatin1String("KenBurnsZoomOut"), EffectMngr::KenBurnsZoomOut),
+        qMakePair(QLatin1String("KenBurnsPanLR"),   EffectMngr::KenBurnsPanLR),
+        qMakePair(QLatin1String("KenBurnsPanTB"),   EffectMngr::KenBurnsPanTB)
+    };
+
+    const QList<QSize> sizes =
+    {
+        QSize(3,    2),                     // smallest image scaled: interpolation weights of 128 on the last pixels
+        QSize(293,  181),                   // up-scaling
+        QSize(1201, 797)                    // down-scaling
+    };
+
+    // The pixels are interpolated as they are: the alpha channel does not change the kernels.
+
+    for (const auto& effect : effects)
+    {
+        for (const QSize& size : sizes)
+        {
+            for (int pattern = Gradients ; pattern <= Checkerboard ; ++pattern)
+            {
+                QTest::newRow(QString::fromLatin1("%1 %2x%3 %4")
+                              .arg(effect.first)
+                              .arg(size.width())
+                              .arg(size.height())
+                              .arg(patternName(pattern))
+                              .toLatin1().constData())
+                    << (int)effect.second << size << pattern;
+            }
+        }
+    }
+}
+
+void FramesRenderTest::testEffectsBitExact()
+{
+    QFETCH(int,   type);
+    QFETCH(QSize, size);
+    QFETCH(int,   pattern);
+
+    const QList<QImage> scalar = renderEffect((EffectMngr::EffectType)type, size, pattern, 0);
+    const QList<QImage> simd   = renderEffect((EffectMngr::EffectType)type, size, pattern, 1);
+
+    compareFrames(simd, scalar);
+}
@@ -66,12 +66,38 @@ QList<QImage*> FaceItemRetriever::getDetails(const DImg& src, const QList<FaceTa
 QList<QImage*> FaceItemRetriever::getThumbnails(const QString& filePath, const QList<FaceTagsIface>& faces) const
 {
     Q_UNUSED(filePath)
-    catcher->setActive(true);
+
+    QList<QPair<qlonglong, QRect> > details;
 
     for (const FaceTagsIface& face : std::as_const(faces))
     {
-        QRect rect = face.region().toRect();
-        catcher->thread()->find(ItemInfo::thumbnailIdentifier(face.imageId()), rect);
+        details << qMakePair(face.imageId(), face.region().toRect());
+    }
+
+    return getDetailThumbnails(details);
+}
+
+QList<QImage*> FaceItemRetriever::getFullSizeDetails(qlonglong imageId,
+                                                     const QSize& originalSize,
+                                                     const QList<QRectF>& rects) const
+{
+    QList<QPair<qlonglong, QRect> > details;
+
+    for (const QRectF& rect : std::as_const(rects))
+    {
+        details << qMakePair(imageId, FaceDetector::toAbsoluteRect(rect, originalSize));
+    }
+
+    return getDetailThumbnails(details);
+}
+
+QList<QImage*> FaceItemRetriever::getDetailThumbnails(const QList<QPair<qlonglong, QRect> >& details) const
+{
+    catcher->setActive(true);
+
+    for (const auto& detail : std::as_const(details))
+    {
+        catcher->thread()->find(ItemInfo::thumbnailIdentifier(detail.first), detail.second);
         catcher->enqueue();
     }
 
@@ -34,6 +34,18 @@ public:
     QList<QImage*> getDetails(const DImg& src, const QList<FaceTagsIface>& faces)            const;
     QList<QImage*> getThumbnails(const QString& filePath, const QList<FaceTagsIface>& faces) const;
 
+    /**
+     * Crop the detected faces from the full resolution image, instead of the reduced
+     * image used for detection. The relative rects are mapped to originalSize.
+     */
+    QList<QImage*> getFullSizeDetails(qlonglong imageId,
+                                      const QSize& originalSize,
+                                      const QList<QRectF>& rects)                            const;
+
+private:
+
+    QList<QImage*> getDetailThumbnails(const QList<QPair<qlonglong, QRect> >& details)      const;
+
 protected:
 
     ThumbnailImageCatcher* catcher = nullptr;
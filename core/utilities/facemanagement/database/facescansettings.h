@@ -62,6 +62,9 @@ public:
     /// Use Yolo V3 model
     bool                                    useYoloV3                   = false;
 
+    /// Detect on the smallest adequate preview, crop the faces at full resolution for recognition
+    bool                                    useReducedSize              = false;
+
     /// Detection accuracy
     double                                  accuracy                    = 0.7;
 
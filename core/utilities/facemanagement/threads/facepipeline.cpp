@@ -66,6 +66,11 @@ bool FacePipeline::hasFinished() const
     return d->hasFinished();
 }
 
+QList<FacePipelineStageStats> FacePipeline::stageStatistics() const
+{
+    return d->stats.stages();
+}
+
 QString FacePipeline::benchmarkResult() const
 {
     if (d->detectionBenchmarker)
@@ -98,9 +103,9 @@ void FacePipeline::plugRetrainingDatabaseFilter()
     d->databaseFilter->tasks = FacePipelineFaceTagsIface::ForTraining;
 }
 
-void FacePipeline::plugFacePreviewLoader()
+void FacePipeline::plugFacePreviewLoader(PreviewMode mode)
 {
-    d->previewThread = new FacePreviewLoader(d);
+    d->previewThread = new FacePreviewLoader(mode, d);
 }
 
 void FacePipeline::plugFaceDetector()
@@ -176,47 +181,55 @@ void FacePipeline::construct()
     if (d->previewThread)
     {
         d->pipeline << d->previewThread;
+        d->stats.addStage(QLatin1String("Preview"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add preview thread";
     }
 
     if      (d->parallelDetectors)
     {
         d->pipeline << d->parallelDetectors;
+        d->stats.addStage(QLatin1String("Detection"), d->parallelDetectors->m_workers.size());
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add parallel thread detectors";
     }
     else if (d->detectionWorker)
     {
         d->pipeline << d->detectionWorker;
+        d->stats.addStage(QLatin1String("Detection"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add single thread detector";
     }
 
     if (d->recognitionWorker)
     {
         d->pipeline << d->recognitionWorker;
+        d->stats.addStage(QLatin1String("Recognition"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add recognition worker";
     }
 
     if (d->detectionBenchmarker)
     {
         d->pipeline << d->detectionBenchmarker;
+        d->stats.addStage(QLatin1String("Detection benchmark"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add detection benchmaker";
     }
 
     if (d->recognitionBenchmarker)
     {
         d->pipeline << d->recognitionBenchmarker;
+        d->stats.addStage(QLatin1String("Recognition benchmark"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add recognition benchmaker";
     }
 
     if (d->databaseWriter)
     {
         d->pipeline << d->databaseWriter;
+        d->stats.addStage(QLatin1String("Database"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add database writer";
     }
 
     if (d->trainerWorker)
     {
         d->pipeline << d->trainerWorker;
+        d->stats.addStage(QLatin1String("Training"), 1);
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add faces trainer";
     }
 
@@ -226,6 +239,15 @@ void FacePipeline::construct()
         return;
     }
 
+    // The counters of a stage are updated before the package is queued to the next stage.
+
+    for (QObject* const element : std::as_const(d->pipeline))
+    {
+        connect(element, SIGNAL(processed(FacePipelineExtendedPackage::Ptr)),
+                d, SLOT(stageProcessed(FacePipelineExtendedPackage::Ptr)),
+                Qt::DirectConnection);
+    }
+
     connect(d, SIGNAL(startProcess(FacePipelineExtendedPackage::Ptr)),
             d->pipeline.first(), SLOT(process(FacePipelineExtendedPackage::Ptr)),
             Qt::QueuedConnection);
@@ -17,12 +17,14 @@
 
 // Local includes
 
+#include "digikam_export.h"
 #include "facepipelinepackage.h"
+#include "facepipelinestats.h"
 
 namespace Digikam
 {
 
-class FacePipeline : public QObject
+class DIGIKAM_GUI_EXPORT FacePipeline : public QObject
 {
     Q_OBJECT
 
@@ -59,6 +61,17 @@ public:
 
     };
 
+    enum PreviewMode
+    {
+        /// Load a large preview. Faces are detected and cropped from it.
+        HighQualityPreview,
+
+        /// Load the smallest preview adequate for detection: embedded preview,
+        /// DCT-scaled JPEG or half size RAW. Faces are cropped from the full
+        /// resolution image for recognition.
+        ReducedSizePreview
+    };
+
 public:
 
     explicit FacePipeline();
@@ -98,7 +111,7 @@ public:
     void plugDatabaseFilter(FilterMode mode);
     void plugRerecognizingDatabaseFilter();
     void plugRetrainingDatabaseFilter();
-    void plugFacePreviewLoader();
+    void plugFacePreviewLoader(PreviewMode mode = HighQualityPreview);
     void plugFaceDetector();
     void plugParallelFaceDetectors();
     void plugFaceRecognizer();
@@ -122,6 +135,11 @@ public:
     bool hasFinished()           const;
     QString benchmarkResult()    const;
 
+    /**
+     * The counters of the stages plugged in the pipeline, in the processing order.
+     */
+    QList<FacePipelineStageStats> stageStatistics() const;
+
     /**
      * Set the priority of the threads used by this pipeline.
      * The default setting is QThread::LowPriority.
@@ -125,6 +125,7 @@ void FacePipeline::Private::send(const FacePipelineExtendedPackage::Ptr& package
     if (senderFlowControl(package))
     {
         ++packagesOnTheRoad;
+        stats.enter(package.data());
 
         Q_EMIT startProcess(package);
     }
@@ -149,6 +150,26 @@ void FacePipeline::Private::finishProcess(FacePipelineExtendedPackage::Ptr packa
     checkFinished();
 }
 
+void FacePipeline::Private::stageProcessed(const FacePipelineExtendedPackage::Ptr& package)
+{
+    stats.leave(package.data());
+
+    if (previewThread)
+    {
+        // A place is free in a queue: the preview loader may be waiting for it.
+
+        QMetaObject::invokeMethod(this, [this]()
+            {
+                if (previewThread)
+                {
+                    previewThread->checkRestart();
+                }
+            },
+            Qt::QueuedConnection
+        );
+    }
+}
+
 bool FacePipeline::Private::senderFlowControl(const FacePipelineExtendedPackage::Ptr& package)
 {
     if (packagesOnTheRoad > maxPackagesOnTheRoad)
@@ -184,6 +205,9 @@ void FacePipeline::Private::checkFinished()
     {
         totalPackagesAdded = 0;
 
+        qCDebug(DIGIKAM_GENERAL_LOG).noquote() << "Face pipeline stages:" << Qt::endl
+                                               << stats.summary(QLatin1String("\n"));
+
         Q_EMIT q->finished();
 
         // stop threads
@@ -259,6 +283,10 @@ void FacePipeline::Private::stop()
         }
     }
 
+    // The packages in the queues are dropped.
+
+    stats.clearQueues();
+
     started = false;
     waiting = true;
 }
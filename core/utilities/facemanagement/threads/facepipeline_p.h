@@ -28,6 +28,7 @@
 // Local includes
 
 #include "facedetector.h"
+#include "facepipelinestats.h"
 #include "faceutils.h"
 #include "previewloadthread.h"
 #include "thumbnailloadthread.h"
@@ -93,10 +94,17 @@ public:
 
     QList<FacePipelineExtendedPackage::Ptr> delayedPackages;
 
+    FacePipelineStats                       stats;
+
 public Q_SLOTS:
 
     void finishProcess(FacePipelineExtendedPackage::Ptr package);
 
+    /**
+     * Called from the thread of a stage when it has processed the package.
+     */
+    void stageProcessed(const FacePipelineExtendedPackage::Ptr& package);
+
 Q_SIGNALS:
 
     friend class FacePipeline;
@@ -122,7 +122,8 @@ public:
         ProcessedByDetector     = 1 << 1,
         ProcessedByRecognizer   = 1 << 2,
         WrittenToDatabase       = 1 << 3,
-        ProcessedByTrainer      = 1 << 4
+        ProcessedByTrainer      = 1 << 4,
+        ReducedSizeImage        = 1 << 5
     };
     Q_DECLARE_FLAGS(ProcessFlags, ProcessFlag)
 
@@ -157,6 +158,11 @@ public:
 public:
 
     QString                                                           filePath;
+
+    /// The stage processing the package and the time it entered the stage, see FacePipelineStats
+    int                                                               stage      = 0;
+    qint64                                                            stageStart = 0;
+
     typedef QExplicitlySharedDataPointer<FacePipelineExtendedPackage> Ptr;
 };
 
@@ -0,0 +1,179 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Queue length and timing counters of the face pipeline stages
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#include "facepipelinestats.h"
+
+// Qt includes
+
+#include <QMutexLocker>
+#include <QStringList>
+
+// Local includes
+
+#include "facepipelinepackage.h"
+
+namespace Digikam
+{
+
+double FacePipelineStageStats::imagesPerSecond() const
+{
+    if (busyTime <= 0)
+    {
+        return 0.0;
+    }
+
+    return (processed * 1.0E9 / busyTime);
+}
+
+double FacePipelineStageStats::averageLatency() const
+{
+    if (processed == 0)
+    {
+        return 0.0;
+    }
+
+    return (latencyTime / 1.0E6 / processed);
+}
+
+QString FacePipelineStageStats::toString() const
+{
+    return QString::fromLatin1("%1: %2 images, %3 img/s, latency %4 ms, queue %5/%6 (max %7)")
+           .arg(name)
+           .arg(processed)
+           .arg(imagesPerSecond(), 0, 'f', 1)
+           .arg(averageLatency(),  0, 'f', 0)
+           .arg(queued)
+           .arg(capacity)
+           .arg(maxQueued);
+}
+
+// ----------------------------------------------------------------------------------------
+
+void FacePipelineStats::addStage(const QString& name, int workers)
+{
+    QMutexLocker lock(&mutex);
+
+    if (!clock.isValid())
+    {
+        clock.start();
+    }
+
+    FacePipelineStageStats stage;
+    stage.name     = name;
+    stage.workers  = workers;
+
+    // Two packages per thread keep the stage busy while the next one is queued.
+
+    stage.capacity = 2 * workers;
+
+    m_stages    << stage;
+    m_lastLeave << 0;
+}
+
+void FacePipelineStats::clearQueues()
+{
+    QMutexLocker lock(&mutex);
+
+    for (int i = 0 ; i < m_stages.size() ; ++i)
+    {
+        m_stages[i].queued = 0;
+    }
+}
+
+void FacePipelineStats::enter(FacePipelineExtendedPackage* const package)
+{
+    QMutexLocker lock(&mutex);
+
+    enterStage(package, 0, clock.nsecsElapsed());
+}
+
+void FacePipelineStats::leave(FacePipelineExtendedPackage* const package)
+{
+    QMutexLocker lock(&mutex);
+
+    const int stage = package->stage;
+
+    if ((stage < 0) || (stage >= m_stages.size()))
+    {
+        return;
+    }
+
+    const qint64 now              = clock.nsecsElapsed();
+    FacePipelineStageStats& stats = m_stages[stage];
+
+    // The stage was busy since the package entered it, or since the previous package left it.
+
+    stats.busyTime               += now - qMax(package->stageStart, m_lastLeave.at(stage));
+    stats.latencyTime            += now - package->stageStart;
+    stats.queued                  = qMax(0, stats.queued - 1);
+    ++stats.processed;
+    m_lastLeave[stage]            = now;
+
+    if ((stage + 1) < m_stages.size())
+    {
+        enterStage(package, stage + 1, now);
+    }
+}
+
+bool FacePipelineStats::isFullAfter(int stage) const
+{
+    QMutexLocker lock(&mutex);
+
+    for (int i = stage + 1 ; i < m_stages.size() ; ++i)
+    {
+        if (m_stages.at(i).queued >= m_stages.at(i).capacity)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QList<FacePipelineStageStats> FacePipelineStats::stages() const
+{
+    QMutexLocker lock(&mutex);
+
+    return m_stages;
+}
+
+QString FacePipelineStats::summary(const QString& separator) const
+{
+    const QList<FacePipelineStageStats> list = stages();
+    QStringList lines;
+
+    for (const FacePipelineStageStats& stats : list)
+    {
+        lines << stats.toString();
+    }
+
+    return lines.join(separator);
+}
+
+void FacePipelineStats::enterStage(FacePipelineExtendedPackage* const package, int stage, qint64 now)
+{
+    package->stage                = stage;
+    package->stageStart           = now;
+
+    if (stage >= m_stages.size())
+    {
+        return;
+    }
+
+    FacePipelineStageStats& stats = m_stages[stage];
+    ++stats.queued;
+    stats.maxQueued               = qMax(stats.maxQueued, stats.queued);
+}
+
+} // namespace Digikam
@@ -0,0 +1,118 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2026-10-17
+ * Description : Queue length and timing counters of the face pipeline stages
+ *
+ * SPDX-FileCopyrightText: 2026 by agent <agent at local>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * ============================================================ */
+
+#pragma once
+
+// Qt includes
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+class FacePipelineExtendedPackage;
+
+class DIGIKAM_GUI_EXPORT FacePipelineStageStats
+{
+public:
+
+    FacePipelineStageStats()  = default;
+    ~FacePipelineStageStats() = default;
+
+    /**
+     * The number of images processed per second while the stage is busy.
+     */
+    double  imagesPerSecond()                      const;
+
+    /**
+     * The average time in ms from the entry of a package in the queue
+     * of the stage to the end of its processing.
+     */
+    double  averageLatency()                       const;
+
+    QString toString()                             const;
+
+public:
+
+    QString name;
+
+    /// Threads processing the packages of the stage
+    int     workers     = 1;
+
+    /// Queue length from which the preview loader is paused
+    int     capacity    = 2;
+
+    int     processed   = 0;
+
+    /// Packages waiting in the queue of the stage or being processed
+    int     queued      = 0;
+    int     maxQueued   = 0;
+
+    /// Wall time in ns during which the stage had packages to process
+    qint64  busyTime    = 0;
+
+    /// Sum of the latencies of the packages in ns
+    qint64  latencyTime = 0;
+};
+
+// ----------------------------------------------------------------------------------------
+
+/**
+ * The counters of all the stages of a pipeline. The packages enter the first stage
+ * when they are sent, and move to the next stage each time a stage has processed them.
+ * All methods are thread-safe: the stages call leave() from their threads.
+ */
+class Q_DECL_HIDDEN FacePipelineStats
+{
+public:
+
+    FacePipelineStats()  = default;
+    ~FacePipelineStats() = default;
+
+    void addStage(const QString& name, int workers);
+    void clearQueues();
+
+    void enter(FacePipelineExtendedPackage* const package);
+    void leave(FacePipelineExtendedPackage* const package);
+
+    /**
+     * Returns true if the queue of a stage after the given one is full.
+     */
+    bool isFullAfter(int stage)                    const;
+
+    QList<FacePipelineStageStats> stages()         const;
+    QString summary(const QString& separator)      const;
+
+private:
+
+    void enterStage(FacePipelineExtendedPackage* const package, int stage, qint64 now);
+
+private:
+
+    mutable QMutex                mutex;
+    QElapsedTimer                 clock;
+    QList<FacePipelineStageStats> m_stages;
+
+    /// Time of the last package which left each stage
+    QList<qint64>                 m_lastLeave;
+};
+
+} // namespace Digikam
@@ -21,8 +21,10 @@
 namespace Digikam
 {
 
-FacePreviewLoader::FacePreviewLoader(FacePipeline::Private* const dd)
-    : d(dd)
+FacePreviewLoader::FacePreviewLoader(FacePipeline::PreviewMode mode, FacePipeline::Private* const dd)
+    : mode         (mode),
+      detectionSize(FaceDetector().recommendedImageSize()),
+      d            (dd)
 {
     // this is crucial! Per default, only the last added image will be loaded
 
@@ -52,7 +54,24 @@ void FacePreviewLoader::process(const FacePipelineExtendedPackage::Ptr& package)
     }
 
     scheduledPackages << package;
-    loadHighQuality(package->filePath, PreviewSettings::RawPreviewFromRawHalfSize);
+
+    if      (mode == FacePipeline::HighQualityPreview)
+    {
+        loadHighQuality(package->filePath, PreviewSettings::RawPreviewFromRawHalfSize);
+    }
+    else if (DImg::fileFormat(package->filePath) == DImg::RAW)
+    {
+        // Take the embedded preview if it is large enough, else the half size RAW.
+
+        loadFastButLarge(package->filePath, detectionSize);
+    }
+    else
+    {
+        // Take the embedded preview if it is large enough, else decode the JPEG or PGF scaled.
+
+        loadFast(package->filePath, detectionSize);
+    }
+
 /*
     load(package->filePath, 800, MetaEngineSettings::instance()->settings().exifRotate);
     loadHighQuality(package->filePath, MetaEngineSettings::instance()->settings().exifRotate);
@@ -82,10 +101,12 @@ void FacePreviewLoader::slotImageLoaded(const LoadingDescription& loadingDescrip
         wait();
     }
 
-    if (qMax(img.width(), img.height()) > 2000)
+    const int maxSize = (mode == FacePipeline::ReducedSizePreview) ? detectionSize : 2000;
+
+    if (qMax(img.width(), img.height()) > (uint)maxSize)
     {
-        package->image     = img.smoothScale(2000,
-                                             2000,
+        package->image     = img.smoothScale(maxSize,
+                                             maxSize,
                                              Qt::KeepAspectRatio);
     }
     else
@@ -95,6 +116,11 @@ void FacePreviewLoader::slotImageLoaded(const LoadingDescription& loadingDescrip
 
     package->processFlags |= FacePipelinePackage::PreviewImageLoaded;
 
+    if (mode == FacePipeline::ReducedSizePreview)
+    {
+        package->processFlags |= FacePipelinePackage::ReducedSizeImage;
+    }
+
     Q_EMIT processed(package);
 }
 
@@ -102,7 +128,12 @@ bool FacePreviewLoader::sentOutLimitReached() const
 {
     int packagesInTheFollowingPipeline = d->packagesOnTheRoad - scheduledPackages.size();
 
-    return (packagesInTheFollowingPipeline > maximumSentOutPackages);
+    // Do not load more images while a following stage, usually the detector, lags behind.
+
+    return (
+            (packagesInTheFollowingPipeline > maximumSentOutPackages) ||
+            d->stats.isFullAfter(0)
+           );
 }
 
 void FacePreviewLoader::checkRestart()
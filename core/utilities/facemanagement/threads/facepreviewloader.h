@@ -27,7 +27,7 @@ class Q_DECL_HIDDEN FacePreviewLoader : public PreviewLoadThread
 
 public:
 
-    explicit FacePreviewLoader(FacePipeline::Private* const dd);
+    FacePreviewLoader(FacePipeline::PreviewMode mode, FacePipeline::Private* const dd);
     ~FacePreviewLoader() override;
 
     void cancel();
@@ -50,6 +50,11 @@ protected:
     /// upper limit for memory cost
     int                           maximumSentOutPackages = qMin(QThread::idealThreadCount(), 4);
 
+    FacePipeline::PreviewMode     mode                   = FacePipeline::HighQualityPreview;
+
+    /// largest side of the images in ReducedSizePreview mode
+    int                           detectionSize          = 800;
+
     FacePipeline::Private* const  d                      = nullptr;
 
 private:
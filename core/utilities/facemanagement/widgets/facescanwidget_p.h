@@ -81,6 +81,7 @@ public:
     DIntNumInput*     accuracyInput                     = nullptr;
 
     QCheckBox*        useYoloV3Button                   = nullptr;
+    QCheckBox*        useReducedSizeButton              = nullptr;
     QCheckBox*        useFullCpuButton                  = nullptr;
 
     const QString     configName                        = QLatin1String("Face Management Settings");
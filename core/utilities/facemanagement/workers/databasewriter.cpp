@@ -65,7 +65,10 @@ void DatabaseWriter::process(const FacePipelineExtendedPackage::Ptr& package)
                                                                    package->image.originalSize());
             package->databaseFaces.setRole(FacePipelineFaceTagsIface::DetectedFromImage);
 
-            if (!package->image.isNull())
+            // A reduced size image gives blurred face thumbnails:
+            // let the thumbnail thread create them from the file on demand.
+
+            if (!package->image.isNull() && !(package->processFlags & FacePipelinePackage::ReducedSizeImage))
             {
                 utils.storeThumbnails(thumbnailLoadThread, package->filePath,
                                       package->databaseFaces.toFaceTagsIfaceList(), package->image);
@@ -22,6 +22,11 @@
 namespace Digikam
 {
 
+/**
+ * Maximum number of images given to the detector in one pass of the neural network.
+ */
+static const int s_detectionBatchSize = 4;
+
 DetectionWorker::DetectionWorker(FacePipeline::Private* const dd)
     : d(dd)
 {
@@ -34,22 +39,60 @@ DetectionWorker::~DetectionWorker()
 
 void DetectionWorker::process(const FacePipelineExtendedPackage::Ptr& package)
 {
-    if (!package->image.isNull())
+    // The packages queued in the event loop are collected, and detected together
+    // once the loop is idle, or when a full batch is available.
+
+    pending << package;
+
+    if      (pending.size() >= s_detectionBatchSize)
+    {
+        slotDetectPending();
+    }
+    else if (pending.size() == 1)
+    {
+        QMetaObject::invokeMethod(this, "slotDetectPending", Qt::QueuedConnection);
+    }
+}
+
+void DetectionWorker::slotDetectPending()
+{
+    if (pending.isEmpty())
+    {
+        return;
+    }
+
+    const QList<FacePipelineExtendedPackage::Ptr> packages = pending;
+    pending.clear();
+
+    QList<DImg> images;
+
+    for (const FacePipelineExtendedPackage::Ptr& package : packages)
     {
 /*
-        QImage detectionImage  = scaleForDetection(package->image);
-        package->detectedFaces = detector.detectFaces(detectionImage, package->image.originalSize());
+        images << scaleForDetection(package->image);
 */
-        package->detectedFaces = detector.detectFaces(package->image);
-
-        qCDebug(DIGIKAM_GENERAL_LOG) << "Found" << package->detectedFaces.size() << "faces in"
-                                     << package->info.name() << package->image.size()
-                                     << package->image.originalSize();
+        images << package->image;
     }
 
-    package->processFlags |= FacePipelinePackage::ProcessedByDetector;
+    const QList<QList<QRectF> > faces = detector.detectFaces(images);
 
-    Q_EMIT processed(package);
+    for (int i = 0 ; i < packages.size() ; ++i)
+    {
+        const FacePipelineExtendedPackage::Ptr& package = packages.at(i);
+
+        if (!package->image.isNull())
+        {
+            package->detectedFaces = faces.at(i);
+
+            qCDebug(DIGIKAM_GENERAL_LOG) << "Found" << package->detectedFaces.size() << "faces in"
+                                         << package->info.name() << package->image.size()
+                                         << package->image.originalSize();
+        }
+
+        package->processFlags |= FacePipelinePackage::ProcessedByDetector;
+
+        Q_EMIT processed(package);
+    }
 }
 
 QImage DetectionWorker::scaleForDetection(const DImg& image) const
@@ -43,10 +43,20 @@ Q_SIGNALS:
 
     void processed(const FacePipelineExtendedPackage::Ptr& package);
 
+private Q_SLOTS:
+
+    /**
+     * Detect the faces of the packages received since the last call, in one batch.
+     */
+    void slotDetectPending();
+
 protected:
 
-    FaceDetector                 detector;
-    FacePipeline::Private* const d          = nullptr;
+    FaceDetector                            detector;
+    FacePipeline::Private* const            d          = nullptr;
+
+    /// The packages waiting for the batched detection.
+    QList<FacePipelineExtendedPackage::Ptr> pending;
 
 private:
 
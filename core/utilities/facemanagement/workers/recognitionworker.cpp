@@ -41,7 +41,18 @@ void RecognitionWorker::process(const FacePipelineExtendedPackage::Ptr& package)
     FaceUtils      utils;
     QList<QImage*> images;
 
-    if      (package->processFlags & FacePipelinePackage::ProcessedByDetector)
+    if      (
+             (package->processFlags & FacePipelinePackage::ProcessedByDetector) &&
+             (package->processFlags & FacePipelinePackage::ReducedSizeImage)
+            )
+    {
+        // the image is too small for recognition, crop the faces from the full resolution image
+
+        images = imageRetriever.getFullSizeDetails(package->info.id(),
+                                                   package->image.originalSize(),
+                                                   package->detectedFaces);
+    }
+    else if (package->processFlags & FacePipelinePackage::ProcessedByDetector)
     {
         // assume we have an image
 
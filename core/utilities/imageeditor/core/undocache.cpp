@@ -16,17 +16,28 @@
 
 #include "undocache.h"
 
+// C++ includes
+
+#include <cstring>
+
 // Qt includes
 
 #include <QApplication>
 #include <QDataStream>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRect>
+#include <QRunnable>
 #include <QStringList>
 #include <QStandardPaths>
 #include <QStorageInfo>
 #include <QMessageBox>
+#include <QThreadPool>
 
 // KDE includes
 
@@ -39,8 +50,217 @@
 namespace Digikam
 {
 
+namespace
+{
+
+/// Side in pixels of the tiles compared between two levels.
+static const int     s_tileSize     = 256;
+
+/// Number of deltas after which a level is stored in full, to bound the restoring time.
+static const int     s_maxDeltas    = 8;
+
+static const quint32 s_endOfTiles   = 0xFFFFFFFF;
+
+/**
+ * The geometry of the tiles of an image.
+ */
+class Q_DECL_HIDDEN UndoTiles
+{
+public:
+
+    explicit UndoTiles(const DImg& img)
+        : width  (int(img.width())),
+          height (int(img.height())),
+          depth  (img.bytesDepth()),
+          columns((width  + s_tileSize - 1) / s_tileSize),
+          rows   ((height + s_tileSize - 1) / s_tileSize)
+    {
+    }
+
+    int count() const
+    {
+        return (columns * rows);
+    }
+
+    QRect rect(int tile) const
+    {
+        const int x = (tile % columns) * s_tileSize;
+        const int y = (tile / columns) * s_tileSize;
+
+        return QRect(x, y, qMin(s_tileSize, width - x), qMin(s_tileSize, height - y));
+    }
+
+    /// Offset in bytes of the first pixel of the line of the tile.
+    qint64 offset(const QRect& rect, int line) const
+    {
+        return ((qint64(rect.y() + line) * width + rect.x()) * depth);
+    }
+
+public:
+
+    const int width;
+    const int height;
+    const int depth;
+    const int columns;
+    const int rows;
+};
+
+bool sameGeometry(const DImg& a, const DImg& b)
+{
+    return (
+            (a.width()      == b.width())      &&
+            (a.height()     == b.height())     &&
+            (a.sixteenBit() == b.sixteenBit()) &&
+            (a.hasAlpha()   == b.hasAlpha())
+           );
+}
+
+/**
+ * Write the tiles of the image which differ from the base image, xored with it,
+ * or all the tiles if the base image is null. Returns the number of tiles written.
+ */
+int writeTiles(QDataStream& ds, const DImg& img, const DImg& base)
+{
+    const UndoTiles tiles(img);
+    const uchar* const data     = img.bits();
+    const uchar* const baseData = base.isNull() ? nullptr : base.bits();
+    int written                 = 0;
+    QByteArray buffer;
+
+    for (int t = 0 ; t < tiles.count() ; ++t)
+    {
+        const QRect rect   = tiles.rect(t);
+        const int rowBytes = rect.width() * tiles.depth;
+        bool changed       = !baseData;
+
+        for (int y = 0 ; !changed && (y < rect.height()) ; ++y)
+        {
+            const qint64 offset = tiles.offset(rect, y);
+            changed             = (memcmp(data + offset, baseData + offset, rowBytes) != 0);
+        }
+
+        if (!changed)
+        {
+            continue;
+        }
+
+        // The xored tile is mostly zeros where the filter did not change the pixels.
+
+        buffer.resize(rowBytes * rect.height());
+        uchar* out = reinterpret_cast<uchar*>(buffer.data());
+
+        for (int y = 0 ; y < rect.height() ; ++y)
+        {
+            const qint64 offset = tiles.offset(rect, y);
+
+            if (baseData)
+            {
+                for (int i = 0 ; i < rowBytes ; ++i)
+                {
+                    out[i] = data[offset + i] ^ baseData[offset + i];
+                }
+            }
+            else
+            {
+                memcpy(out, data + offset, rowBytes);
+            }
+
+            out += rowBytes;
+        }
+
+        ds << quint32(t) << qCompress(buffer, 1);
+        ++written;
+    }
+
+    ds << s_endOfTiles;
+
+    return written;
+}
+
+/**
+ * Read the tiles written by writeTiles() into the image, which contains
+ * the base image if the tiles are xored.
+ */
+bool readTiles(QDataStream& ds, DImg& img, bool xored)
+{
+    const UndoTiles tiles(img);
+    uchar* const data = img.bits();
+    quint32 t         = 0;
+    QByteArray buffer;
+
+    while (true)
+    {
+        ds >> t;
+
+        if ((ds.status() != QDataStream::Ok) || (t == s_endOfTiles))
+        {
+            break;
+        }
+
+        ds >> buffer;
+
+        if ((int(t) >= tiles.count()) || (ds.status() != QDataStream::Ok))
+        {
+            return false;
+        }
+
+        const QRect rect        = tiles.rect(int(t));
+        const int rowBytes      = rect.width() * tiles.depth;
+        const QByteArray pixels = qUncompress(buffer);
+
+        if (pixels.size() != (rowBytes * rect.height()))
+        {
+            return false;
+        }
+
+        const uchar* in = reinterpret_cast<const uchar*>(pixels.constData());
+
+        for (int y = 0 ; y < rect.height() ; ++y)
+        {
+            uchar* const out = data + tiles.offset(rect, y);
+
+            if (xored)
+            {
+                for (int i = 0 ; i < rowBytes ; ++i)
+                {
+                    out[i] ^= in[i];
+                }
+            }
+            else
+            {
+                memcpy(out, in, rowBytes);
+            }
+
+            in += rowBytes;
+        }
+    }
+
+    return (ds.status() == QDataStream::Ok);
+}
+
+} // namespace
+
 class Q_DECL_HIDDEN UndoCache::Private
 {
+public:
+
+    /**
+     * An undo level. Its full data is kept in memory while it is recent or not yet
+     * written to its cache file. The file contains the tiles xored with the data
+     * of the base level, or all the tiles if there is no base level.
+     */
+    class Level
+    {
+    public:
+
+        DImg image;
+        int  base    = -1;
+        int  deltas  = 0;
+        bool stored  = false;
+    };
+
+    class Writer;
+
 public:
 
     Private() = default;
@@ -50,15 +270,188 @@ public:
         return QString::fromUtf8("%1-%2.bin").arg(cachePrefix).arg(level);
     }
 
+    /**
+     * Free the memory of the oldest levels already written, above the memory budget.
+     * The last level put is always kept: it is the base of the next one.
+     * Must be called with the mutex locked.
+     */
+    void applyMemoryBudget()
+    {
+        quint64 used = 0;
+
+        for (const Level& level : std::as_const(levels))
+        {
+            used += level.image.isNull() ? 0 : level.image.numBytes();
+        }
+
+        for (QMap<int, Level>::iterator it = levels.begin() ; (used > memoryBudget) && (it != levels.end()) ; ++it)
+        {
+            if (!it->image.isNull() && it->stored && (it.key() != lastLevel))
+            {
+                used     -= it->image.numBytes();
+                it->image = DImg();
+            }
+        }
+    }
+
+    /**
+     * Restore the data of the level from memory or from its cache file.
+     * The returned image is a deep copy. Must be called with the mutex locked.
+     */
+    DImg restore(int level, int* const filesRead)
+    {
+        QMap<int, Level>::const_iterator it = levels.constFind(level);
+
+        if (it == levels.constEnd())
+        {
+            return DImg();
+        }
+
+        if (!it->image.isNull())
+        {
+            return it->image.copyImageData();
+        }
+
+        QFile file(cacheFile(level));
+
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return DImg();
+        }
+
+        quint32 w          = 0;
+        quint32 h          = 0;
+        bool    hasAlpha   = false;
+        bool    sixteenBit = false;
+        qint32  base       = -1;
+
+        QDataStream ds(&file);
+        ds >> w;
+        ds >> h;
+        ds >> hasAlpha;
+        ds >> sixteenBit;
+        ds >> base;
+
+        if ((ds.status() != QDataStream::Ok) || (base != it->base))
+        {
+            qCDebug(DIGIKAM_GENERAL_LOG) << "The undo cache file is corrupt";
+
+            return DImg();
+        }
+
+        DImg img = (base >= 0) ? restore(base, filesRead) : DImg(w, h, sixteenBit, hasAlpha);
+
+        if (img.isNull() || (img.width() != w) || (img.height() != h) ||
+            (img.sixteenBit() != sixteenBit) || (img.hasAlpha() != hasAlpha))
+        {
+            return DImg();
+        }
+
+        if (!readTiles(ds, img, (base >= 0)))
+        {
+            qCDebug(DIGIKAM_GENERAL_LOG) << "The undo cache file is corrupt";
+
+            return DImg();
+        }
+
+        ++(*filesRead);
+
+        return img;
+    }
+
+public:
+
+    QString          cacheDir;
+    QString          cachePrefix;
+
+    /// Memory in bytes for the image data of the recent levels.
+    quint64          memoryBudget = 1024ULL * 1024 * 1024;
+
+    QMutex           mutex;
+    QMap<int, Level> levels;
+    int              lastLevel    = -1;
+
+    /// Writes the cache files one after the other.
+    QThreadPool      writer;
+
+    bool             cacheError   = false;
+};
+
+// ----------------------------------------------------------------------------------------
+
+/**
+ * Write the cache file of a level in the background, then allow to free its data in memory.
+ */
+class Q_DECL_HIDDEN UndoCache::Private::Writer : public QRunnable
+{
 public:
 
-    QString   cacheDir;
-    QString   cachePrefix;
-    QSet<int> cachedLevels;
+    Writer(Private* const d, int level, const DImg& image, int base, const DImg& baseImage)
+        : d        (d),
+          level    (level),
+          image    (image),
+          base     (base),
+          baseImage(baseImage)
+    {
+    }
+
+    void run() override
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QFile file(d->cacheFile(level));
+        bool ok     = false;
+        int  tiles  = 0;
+
+        if (file.open(QIODevice::WriteOnly))
+        {
+            QDataStream ds(&file);
+            ds << (quint32)image.width();
+            ds << (quint32)image.height();
+            ds << image.hasAlpha();
+            ds << image.sixteenBit();
+            ds << (qint32)base;
+
+            tiles = writeTiles(ds, image, baseImage);
+            ok    = ((ds.status() == QDataStream::Ok) && (file.error() == QFileDevice::NoError));
+            file.close();
+        }
+
+        if (!ok)
+        {
+            // The level stays in memory.
+
+            file.remove();
+        }
+
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Undo level" << level << "written in" << timer.elapsed() << "ms:"
+                                     << tiles << "of" << UndoTiles(image).count() << "tiles,"
+                                     << file.size() / 1024 << "KiB"
+                                     << ((base >= 0) ? QString::fromLatin1("against level %1").arg(base)
+                                                     : QString::fromLatin1("in full"));
+
+        QMutexLocker lock(&d->mutex);
+
+        QMap<int, Private::Level>::iterator it = d->levels.find(level);
+
+        if (it != d->levels.end())
+        {
+            it->stored = ok;
+        }
+    }
 
-    bool      cacheError = false;
+private:
+
+    Private* const d;
+    const int      level;
+    const DImg     image;
+    const int      base;
+    const DImg     baseImage;
 };
 
+// ----------------------------------------------------------------------------------------
+
 UndoCache::UndoCache()
     : d(new Private)
 {
@@ -68,6 +461,18 @@ UndoCache::UndoCache()
                      .arg(d->cacheDir)
                      .arg(QCoreApplication::applicationPid());
 
+    d->writer.setMaxThreadCount(1);
+
+    // The memory budget can be changed in MiB for benchmarking.
+
+    bool ok            = false;
+    const int budget   = qEnvironmentVariableIntValue("DIGIKAM_UNDOCACHE_MEMORY", &ok);
+
+    if (ok && (budget >= 0))
+    {
+        d->memoryBudget = quint64(budget) * 1024 * 1024;
+    }
+
     // remove any remnants
 
     QDir dir(d->cacheDir);
@@ -87,29 +492,44 @@ UndoCache::~UndoCache()
 
 void UndoCache::clear()
 {
-    for (int level : std::as_const(d->cachedLevels))
+    d->writer.waitForDone();
+
+    QMutexLocker lock(&d->mutex);
+
+    for (QMap<int, Private::Level>::const_iterator it = d->levels.constBegin() ; it != d->levels.constEnd() ; ++it)
     {
-        QFile(d->cacheFile(level)).remove();
+        QFile(d->cacheFile(it.key())).remove();
     }
 
-    d->cachedLevels.clear();
+    d->levels.clear();
+    d->lastLevel = -1;
 }
 
 void UndoCache::clearFrom(int fromLevel)
 {
-    for (int level : std::as_const(d->cachedLevels))
+    // The levels below are never stored against the removed ones.
+
+    d->writer.waitForDone();
+
+    QMutexLocker lock(&d->mutex);
+
+    QMap<int, Private::Level>::iterator it = d->levels.lowerBound(fromLevel);
+
+    while (it != d->levels.end())
     {
-        if (level >= fromLevel)
-        {
-            QFile(d->cacheFile(level)).remove();
-            d->cachedLevels.remove(level);
-        }
+        QFile(d->cacheFile(it.key())).remove();
+        it = d->levels.erase(it);
+    }
+
+    if (d->lastLevel >= fromLevel)
+    {
+        d->lastLevel = d->levels.isEmpty() ? -1 : d->levels.lastKey();
     }
 }
 
 bool UndoCache::putData(int level, const DImg& img) const
 {
-    if (d->cacheError)
+    if (d->cacheError || img.isNull())
     {
         return false;
     }
@@ -137,87 +557,67 @@ bool UndoCache::putData(int level, const DImg& img) const
         return false;
     }
 
-    QFile file(d->cacheFile(level));
-
-    if (file.exists() || !file.open(QIODevice::WriteOnly))
-    {
-        return false;
-    }
-
-    QDataStream ds(&file);
-    ds << (quint32)img.width();
-    ds << (quint32)img.height();
-    ds << img.numBytes();
-    ds << img.hasAlpha();
-    ds << img.sixteenBit();
+    QElapsedTimer timer;
+    timer.start();
 
-    file.write((const char*)img.bits(), img.numBytes());
+    QMutexLocker lock(&d->mutex);
 
-    if (file.error() != QFileDevice::NoError)
+    if (d->levels.contains(level))
     {
-        file.close();
-        file.remove();
-
         return false;
     }
 
-    d->cachedLevels << level;
-
-    file.close();
+    // The editor changes its image in place: keep a deep copy.
 
-    return true;
-}
+    Private::Level entry;
+    entry.image = img.copyImageData();
 
-DImg UndoCache::getData(int level) const
-{
-    quint32 w          = 0;
-    quint32 h          = 0;
-    quint64 numBytes   = 0;
-    bool    hasAlpha   = false;
-    bool    sixteenBit = false;
+    // Store the tiles changed since the closest previous level still in memory.
 
-    QFile file(d->cacheFile(level));
+    QMap<int, Private::Level>::const_iterator it = d->levels.lowerBound(level);
+    DImg baseImage;
 
-    if (!file.open(QIODevice::ReadOnly))
+    while (it != d->levels.constBegin())
     {
-        return DImg();
-    }
-
-    QDataStream ds(&file);
-    ds >> w;
-    ds >> h;
-    ds >> numBytes;
-    ds >> hasAlpha;
-    ds >> sixteenBit;
+        --it;
 
-    if (ds.status() != QDataStream::Ok || ds.atEnd())
-    {
-        qCDebug(DIGIKAM_GENERAL_LOG) << "The undo cache file is corrupt";
+        if (!it->image.isNull())
+        {
+            if (sameGeometry(it->image, entry.image) && (it->deltas < s_maxDeltas))
+            {
+                entry.base   = it.key();
+                entry.deltas = it->deltas + 1;
+                baseImage    = it->image;
+            }
+
+            break;
+        }
+    }
 
-        file.close();
+    d->levels.insert(level, entry);
+    d->lastLevel = level;
 
-        return DImg();
-    }
+    d->writer.start(new Private::Writer(d, level, entry.image, entry.base, baseImage));
 
-    DImg img(w, h, sixteenBit, hasAlpha);
+    d->applyMemoryBudget();
 
-    if (img.isNull() || (numBytes != img.numBytes()))
-    {
-        file.close();
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Undo level" << level << "put in" << timer.elapsed() << "ms";
 
-        return DImg();
-    }
+    return true;
+}
 
-    qint64 readBytes = file.read((char*)img.bits(), numBytes);
+DImg UndoCache::getData(int level) const
+{
+    QElapsedTimer timer;
+    timer.start();
 
-    if ((file.error() != QFileDevice::NoError) || ((quint64)readBytes != numBytes))
-    {
-        file.close();
+    QMutexLocker lock(&d->mutex);
 
-        return DImg();
-    }
+    int filesRead = 0;
+    DImg img      = d->restore(level, &filesRead);
 
-    file.close();
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Undo level" << level << "restored in" << timer.elapsed() << "ms from"
+                                 << filesRead << "cache files";
 
     return img;
 }
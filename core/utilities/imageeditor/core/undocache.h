@@ -43,12 +43,14 @@ public:
     void clearFrom(int level);
 
     /**
-     * Write the image data into a cache file
+     * Put a copy of the image data in the cache. The recent levels are kept in memory
+     * within a budget. Each level is also written to a cache file in a background thread,
+     * as the tiles which changed since the previous level, or in full.
      */
     bool putData(int level, const DImg& img) const;
 
     /**
-     * Get the image data from a cache file
+     * Get the image data from memory, or restore it from the cache files
      */
     DImg getData(int level)                  const;
 
@@ -23,6 +23,7 @@
 
 // Qt includes
 
+#include <QElapsedTimer>
 #include <QList>
 
 // Local includes
@@ -190,6 +191,9 @@ void UndoManager::rollbackToOrigin()
 
 void UndoManager::undoStep(bool saveRedo, bool execute, bool flyingRollback)
 {
+    QElapsedTimer timer;
+    timer.start();
+
     UndoAction* const action                   = d->undoActions.last();
     UndoMetadataContainer dataBeforeStep       = action->getMetadata();
     UndoMetadataContainer dataAfterStep        = UndoMetadataContainer::fromImage(*d->core->getImg());
@@ -298,10 +302,16 @@ void UndoManager::undoStep(bool saveRedo, bool execute, bool flyingRollback)
     {
         d->origin--;
     }
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Undo step to level" << d->undoActions.size()
+                                 << "done in" << timer.elapsed() << "ms";
 }
 
 void UndoManager::redoStep(bool execute, bool flyingRollback)
 {
+    QElapsedTimer timer;
+    timer.start();
+
     UndoAction* const action                   = d->redoActions.last();
     UndoMetadataContainer dataBeforeStep       = UndoMetadataContainer::fromImage(*d->core->getImg());
     UndoMetadataContainer dataAfterStep        = action->getMetadata();
@@ -355,6 +365,9 @@ void UndoManager::redoStep(bool execute, bool flyingRollback)
     {
         d->origin++;
     }
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Redo step to level" << d->undoActions.size()
+                                 << "done in" << timer.elapsed() << "ms";
 }
 
 void UndoManager::makeSnapshot(int index)
@@ -24,6 +24,8 @@
 #include "iteminfo.h"
 #include "thumbsdb.h"
 #include "thumbsdbaccess.h"
+#include "thumbnailpackfile.h"
+#include "thumbnailwritequeue.h"
 #include "coredb.h"
 #include "coredbaccess.h"
 #include "facialrecognition_wrapper.h"
@@ -171,6 +173,16 @@ void DatabaseTask::run()
             Q_EMIT signalFinished(false, false);
         }
 
+        // The thumbnails pack file, if used, is compacted with the thumbnails DB.
+
+        if (ThumbnailPackFile::instance()->isOpen())
+        {
+            if (!ThumbnailPackFile::instance()->compact())
+            {
+                qCWarning(DIGIKAM_DATABASE_LOG) << "Compaction of the thumbnails pack file failed.";
+            }
+        }
+
         QThread::sleep(1);
 
         if (m_cancel)
@@ -487,6 +499,11 @@ void DatabaseTask::run()
         BdEngineBackend::QueryState lastQueryState = BdEngineBackend::QueryState(BdEngineBackend::ConnectionError);
         (void)lastQueryState; // prevent cppcheck warning.
 
+        // Thumbnails still queued must be written first, else a queued insert
+        // can create again a row after its removal.
+
+        ThumbnailWriteQueue::instance()->flush();
+
         // Connect to the database
 
         lastQueryState                             = ThumbsDbAccess().backend()->beginTransaction();
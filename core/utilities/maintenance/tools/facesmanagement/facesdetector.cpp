@@ -19,6 +19,7 @@
 // Qt includes
 
 #include <QClipboard>
+#include <QElapsedTimer>
 #include <QVBoxLayout>
 #include <QTimer>
 #include <QIcon>
@@ -102,6 +103,9 @@ public:
 
     ItemInfoJob                albumListing;
     FacePipeline               pipeline;
+
+    /// Time since the stage counters were shown in the status
+    QElapsedTimer              statusTimer;
 };
 
 FacesDetector::FacesDetector(const FaceScanSettings& settings, ProgressItem* const parent)
@@ -173,7 +177,8 @@ FacesDetector::FacesDetector(const FaceScanSettings& settings, ProgressItem* con
         }
 
         d->pipeline.plugDatabaseFilter(filterMode);
-        d->pipeline.plugFacePreviewLoader();
+        d->pipeline.plugFacePreviewLoader(settings.useReducedSize ? FacePipeline::ReducedSizePreview
+                                                                  : FacePipeline::HighQualityPreview);
 
         if (settings.useFullCpu)
         {
@@ -502,6 +507,29 @@ void FacesDetector::slotShowOneDetected(const FacePipelinePackage& package)
 
     setLabel(lbl);
     advance(1);
+
+    if (!d->statusTimer.isValid() || (d->statusTimer.elapsed() > 1000))
+    {
+        showStageStatistics();
+        d->statusTimer.start();
+    }
+}
+
+void FacesDetector::showStageStatistics()
+{
+    QStringList stages;
+    const QList<FacePipelineStageStats> statistics = d->pipeline.stageStatistics();
+
+    for (const FacePipelineStageStats& stats : statistics)
+    {
+        stages << i18nc("@info: face pipeline stage, images per second, queue length",
+                        "%1: %2 img/s, queue %3",
+                        stats.name,
+                        QString::number(stats.imagesPerSecond(), 'f', 1),
+                        stats.queued);
+    }
+
+    setStatus(stages.join(QLatin1String(" - ")));
 }
 
 } // namespace Digikam
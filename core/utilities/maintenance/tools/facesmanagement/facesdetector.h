@@ -61,6 +61,13 @@ private Q_SLOTS:
     void slotDone()                                                 override;
     void slotCancel()                                               override;
 
+private:
+
+    /**
+     * Show the throughput and the queue length of each stage of the pipeline in the progress item.
+     */
+    void showStageStatistics();
+
 private:
 
     class Private;
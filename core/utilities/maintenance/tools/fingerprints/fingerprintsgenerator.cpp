@@ -19,6 +19,7 @@
 // Qt includes
 
 #include <QApplication>
+#include <QSet>
 #include <QString>
 #include <QIcon>
 
@@ -101,32 +102,28 @@ void FingerPrintsGenerator::slotStart()
     // Get all item IDs from albums.
 
     QList<qlonglong> itemIds;
+    QSet<qlonglong>  knownIds;
 
     for (AlbumList::ConstIterator it = d->albumList.constBegin() ;
          !canceled() && (it != d->albumList.constEnd()) ; ++it)
     {
+        QList<qlonglong> ids;
+
         if      ((*it)->type() == Album::PHYSICAL)
         {
-            const auto ids = CoreDbAccess().db()->getItemIDsInAlbum((*it)->id());
-
-            for (const qlonglong& id : ids)
-            {
-                if (!itemIds.contains(id))
-                {
-                    itemIds << id;
-                }
-            }
+            ids = CoreDbAccess().db()->getItemIDsInAlbum((*it)->id());
         }
         else if ((*it)->type() == Album::TAG)
         {
-            const auto ids = CoreDbAccess().db()->getItemIDsInTag((*it)->id());
+            ids = CoreDbAccess().db()->getItemIDsInTag((*it)->id());
+        }
 
-            for (const qlonglong& id : ids)
+        for (const qlonglong& id : std::as_const(ids))
+        {
+            if (!knownIds.contains(id))
             {
-                if (!itemIds.contains(id))
-                {
-                    itemIds << id;
-                }
+                knownIds << id;
+                itemIds  << id;
             }
         }
     }
@@ -18,6 +18,7 @@
 
 #include <QQueue>
 #include <QIcon>
+#include <QPair>
 
 // Local includes
 
@@ -35,16 +36,50 @@ namespace Digikam
 
 class Q_DECL_HIDDEN FingerprintsTask::Private
 {
+public:
+
+    /**
+     * Number of signatures stored in the database within one transaction.
+     */
+    enum
+    {
+        StoreBatchSize = 64
+    };
+
 public:
 
     Private() = default;
 
-    MaintenanceData* data       = nullptr;
-    bool             rebuildAll = true;
+    DImg loadImage(const ItemInfo& info) const;
+    void storeSignatures();
+
+public:
 
-    QImage           okImage;
+    MaintenanceData*                              data       = nullptr;
+    bool                                          rebuildAll = true;
+
+    QImage                                        okImage;
+
+    HaarIface                                     haarIface;
+    QList<QPair<qlonglong, Haar::SignatureData> > signatures;
 };
 
+DImg FingerprintsTask::Private::loadImage(const ItemInfo& info) const
+{
+    // Decode at reduced size: JPEG and PGF are scaled while decoding,
+    // the embedded preview of RAW files is used if available. The same source
+    // is used for all files, so that their signatures stay comparable.
+
+    return PreviewLoadThread::loadFastSynchronously(info.filePath(),
+                                                    HaarIface::preferredSize());
+}
+
+void FingerprintsTask::Private::storeSignatures()
+{
+    HaarIface::storeSignatures(signatures);
+    signatures.clear();
+}
+
 // -------------------------------------------------------
 
 FingerprintsTask::FingerprintsTask()
@@ -80,7 +115,7 @@ void FingerprintsTask::run()
     {
         if (m_cancel)
         {
-            return;
+            break;
         }
 
         qlonglong id = d->data->getImageId();
@@ -105,15 +140,19 @@ void FingerprintsTask::run()
         {
             qCDebug(DIGIKAM_GENERAL_LOG) << "Updating fingerprints for file:" << info.filePath();
 
-            DImg dimg = PreviewLoadThread::loadFastSynchronously(info.filePath(),
-                                                                 HaarIface::preferredSize());
+            DImg dimg = d->loadImage(info);
+            Haar::SignatureData sig;
 
-            if (!dimg.isNull())
+            if (d->haarIface.calculateSignature(dimg, sig))
             {
-                // compute Haar fingerprint and store it to DB
+                // compute Haar fingerprint and store it to DB with the next batch
 
-                HaarIface haarIface;
-                haarIface.indexImage(info.id(), dimg);
+                d->signatures << qMakePair(info.id(), sig);
+
+                if (d->signatures.size() >= Private::StoreBatchSize)
+                {
+                    d->storeSignatures();
+                }
             }
 
             QImage qimg = dimg.smoothScale(48, 48, Qt::KeepAspectRatio).copyQImage();
@@ -126,7 +165,14 @@ void FingerprintsTask::run()
         }
     }
 
-    Q_EMIT signalDone();
+    // Store the signatures already computed, also when canceled.
+
+    d->storeSignatures();
+
+    if (!m_cancel)
+    {
+        Q_EMIT signalDone();
+    }
 }
 
 } // namespace Digikam
@@ -603,6 +603,13 @@ void QueueMgrWindow::loadItemInfosToNewQueue(const ItemInfoList& list)
 
 void QueueMgrWindow::slotQueueContentsChanged()
 {
+    QueueListView* const queue = d->queuePool->currentQueue();
+
+    if (queue)
+    {
+        d->queueSettingsView->setHandOffs(queue->handOffs(), queue->handOffBytes());
+    }
+
     if (d->busy)
     {
         refreshStatusBar();
@@ -935,6 +942,13 @@ void QueueMgrWindow::slotAction(const ActionData& ad)
         case ActionData::BatchDone:
         case ActionData::BatchSkipped:
         {
+            if (ad.handOffs)
+            {
+                QueueListView* const queue = d->queuePool->currentQueue();
+                queue->addHandOffs(ad.handOffs, ad.handOffBytes);
+                d->queueSettingsView->setHandOffs(queue->handOffs(), queue->handOffBytes());
+            }
+
             if (cItem)
             {
                 cItem->setDestFileName(ad.destUrl.fileName());
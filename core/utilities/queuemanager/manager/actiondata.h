@@ -45,14 +45,18 @@ public:
 
     ActionData() = default;
 
-    ActionStatus status     = None;
+    ActionStatus status       = None;
 
     QString      message;
 
     QUrl         fileUrl;
     QUrl         destUrl;
 
-    bool         noWrite    = false;
+    bool         noWrite      = false;
+
+    /// Number and size of the converted images passed in memory between chained tools in pipeline mode.
+    int          handOffs     = 0;
+    qint64       handOffBytes = 0;
 };
 
 } // namespace Digikam
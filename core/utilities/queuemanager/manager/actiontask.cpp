@@ -43,9 +43,12 @@ public:
 
     Private() = default;
 
-    bool               cancel   = false;
+    bool               cancel       = false;
 
-    BatchTool*         tool     = nullptr;
+    BatchTool*         tool         = nullptr;
+
+    int                handOffs     = 0;        ///< Converted images passed in memory between tools.
+    qint64             handOffBytes = 0;
 
     QueueSettings      settings;
     AssignedBatchTools tools;
@@ -101,6 +104,20 @@ void ActionTask::removeTempFiles(const QList<QUrl>& tmpList)
     }
 }
 
+bool ActionTask::nextToolRequiresFile(int index) const
+{
+    const BatchToolSet& next = d->tools.m_toolsList[index];
+
+    if (next.group == BatchTool::CustomTool)
+    {
+        return true;
+    }
+
+    BatchTool* const tool = BatchToolsFactory::instance()->findTool(next.name, next.group);
+
+    return (tool && tool->requiresFilePath());
+}
+
 void ActionTask::emitActionData(ActionData::ActionStatus st,
                           const QString& mess,
                           const QUrl& dest,
@@ -113,6 +130,12 @@ void ActionTask::emitActionData(ActionData::ActionStatus st,
     ad.destUrl = dest;
     ad.noWrite = noWrite;
 
+    if (st == ActionData::BatchDone)
+    {
+        ad.handOffs     = d->handOffs;
+        ad.handOffBytes = d->handOffBytes;
+    }
+
     Q_EMIT signalFinished(ad);
 }
 
@@ -193,9 +216,9 @@ void ActionTask::run()
         {
             d->tool->setLastChainedTool(true);
         }
-        else if (d->tools.m_toolsList[index].group == BatchTool::CustomTool)
+        else if (nextToolRequiresFile(index))
         {
-            // If the next tool is under the custom group (user script)
+            // If the next tool works on files only (user script, DNG converter)
             // treat as the last chained tool, i.e. save image to file
 
             d->tool->setLastChainedTool(true);
@@ -206,6 +229,7 @@ void ActionTask::run()
         }
 
         d->tool->setSaveAsNewVersion(d->settings.saveAsNewVersion);
+        d->tool->setPipelineMode(d->settings.pipelineMode);
         d->tool->setOutputUrlFromInputUrl();
         d->tool->setBranchHistory(true);
 
@@ -215,6 +239,20 @@ void ActionTask::run()
         errMsg   = d->tool->errorDescription();
         tmp2del.append(outUrl);
 
+        if (success                              &&
+            d->tool->pipelineMode()              &&
+            !d->tool->isLastChainedTool()        &&
+            !d->tool->outputSuffix().isEmpty()   &&
+            !tmpImage.isNull())
+        {
+            // A format conversion in the middle of the chain passes the image data
+            // to the next tool instead of writing and reading a file. The tools which
+            // keep the file format always did it, and are not counted as saved I/O.
+
+            d->handOffs++;
+            d->handOffBytes += tmpImage.numBytes();
+        }
+
         delete d->tool;
         d->tool = nullptr;
 
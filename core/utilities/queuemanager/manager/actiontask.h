@@ -57,6 +57,7 @@ protected:
 private:
 
     void removeTempFiles(const QList<QUrl>& tmpList);
+    bool nextToolRequiresFile(int index) const;
     void emitActionData(ActionData::ActionStatus st,
                         const QString& mess = QString(),
                         const QUrl& dest = QUrl(),
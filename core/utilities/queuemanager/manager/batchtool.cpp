@@ -56,6 +56,7 @@ public:
     bool                          exifCanEditOrientation    = true;
     bool                          saveAsNewVersion          = true;
     bool                          branchHistory             = true;
+    bool                          pipeline                  = false;
     bool                          cancel                    = false;
     bool                          last                      = false;
 
@@ -296,6 +297,11 @@ QString BatchTool::outputSuffix() const
     return QString();
 }
 
+bool BatchTool::requiresFilePath() const
+{
+    return false;
+}
+
 void BatchTool::setImageData(const DImg& img)
 {
     d->image = img;
@@ -346,6 +352,16 @@ void BatchTool::setSaveAsNewVersion(bool fork)
     d->saveAsNewVersion = fork;
 }
 
+void BatchTool::setPipelineMode(bool pipeline)
+{
+    d->pipeline = pipeline;
+}
+
+bool BatchTool::pipelineMode() const
+{
+    return d->pipeline;
+}
+
 void BatchTool::setBranchHistory(bool branch)
 {
     d->branchHistory = branch;
@@ -464,13 +480,35 @@ bool BatchTool::loadToDImg() const
 
 bool BatchTool::savefromDImg() const
 {
-    if (!isLastChainedTool() && outputSuffix().isEmpty())
+    if (!isLastChainedTool())
     {
-        return true;
+        if (outputSuffix().isEmpty())
+        {
+            return true;
+        }
+
+        if (d->pipeline)
+        {
+            // Do not encode and reload the image between two tools: remember the
+            // target format, the last chained tool will save in this format.
+
+            d->image.setAttribute(QLatin1String("batchOutputFormat"), outputSuffix().toUpper());
+
+            return true;
+        }
     }
 
     DImg::FORMAT detectedFormat = d->image.detectedFormat();
     QString frm                 = outputSuffix().toUpper();
+
+    if (frm.isEmpty())
+    {
+        // Target format set by a previous tool in pipeline mode.
+
+        frm = d->image.attribute(QLatin1String("batchOutputFormat")).toString();
+    }
+
+    d->image.removeAttribute(QLatin1String("batchOutputFormat"));
     bool resetOrientation       = getResetExifOrientationAllowed() &&
                                   (getNeedResetExifOrientation() || (detectedFormat == DImg::RAW));
 
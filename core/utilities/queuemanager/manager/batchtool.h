@@ -196,6 +196,14 @@ public:
      */
     void setRawLoadingRules(QueueSettings::RawLoadingRule rule);
 
+    /**
+     * Set the pipeline mode: when this tool is not the last one in the chain, a format
+     * conversion is not written to disk, the image is passed in memory to the next tool
+     * and the target format is applied by the tool which finally saves the image.
+     */
+    void setPipelineMode(bool pipeline);
+    bool pipelineMode()                                     const;
+
     /**
      * Sets if the history added by tools shall be made a branch (new version).
      */
@@ -248,6 +256,13 @@ public:
      */
     virtual void cancel();
 
+    /**
+     * Re-implement this method and return true if the tool only works on files given by inputUrl()
+     * (ex: an external program), and not on the image data. The previous tool in a chain
+     * will then write its result to disk. This method return false by default.
+     */
+    virtual bool requiresFilePath()                         const;
+
     /**
      * Re-implement this method if tool change file extension during batch process (ex: "png").
      * Typically, this is used with tool which convert to new file format.
@@ -58,6 +58,9 @@ public:
 
     bool                              saveAsNewVersion      = true;
 
+    /// If true, format conversions between chained tools are kept in memory.
+    bool                              pipelineMode          = true;
+
     /// Setting managed through Metadata control panel.
     bool                              exifSetOrientation    = true;
 
@@ -220,6 +220,10 @@ bool WorkflowManager::save()
             data.setAttribute(QLatin1String("value"), q.qSettings.saveAsNewVersion);
             elm.appendChild(data);
 
+            data = doc.createElement(QLatin1String("pipelinemode"));
+            data.setAttribute(QLatin1String("value"), q.qSettings.pipelineMode);
+            elm.appendChild(data);
+
             data = doc.createElement(QLatin1String("usemulticorecpu"));
             data.setAttribute(QLatin1String("value"), q.qSettings.useMultiCoreCPU);
             elm.appendChild(data);
@@ -425,6 +429,10 @@ bool WorkflowManager::load(QStringList& failed)
                 {
                     q.qSettings.saveAsNewVersion = (bool)val2.toUInt(&ok);
                 }
+                else if (name2 == QLatin1String("pipelinemode"))
+                {
+                    q.qSettings.pipelineMode = (bool)val2.toUInt(&ok);
+                }
                 else if (name2 == QLatin1String("usemulticorecpu"))
                 {
                     q.qSettings.useMultiCoreCPU = (bool)val2.toUInt(&ok);
@@ -276,6 +276,9 @@ public:
 
     AssignedBatchTools          toolsList;
 
+    int                         handOffs        = 0;
+    qint64                      handOffBytes    = 0;
+
     QueueToolTip*               toolTip         = nullptr;
 
     QueueListViewItem*          toolTipItem     = nullptr;
@@ -1047,6 +1050,22 @@ QueueSettings QueueListView::settings() const
     return d->settings;
 }
 
+void QueueListView::addHandOffs(int count, qint64 bytes)
+{
+    d->handOffs     += count;
+    d->handOffBytes += bytes;
+}
+
+int QueueListView::handOffs() const
+{
+    return d->handOffs;
+}
+
+qint64 QueueListView::handOffBytes() const
+{
+    return d->handOffBytes;
+}
+
 void QueueListView::setAssignedTools(const AssignedBatchTools& tools)
 {
     d->toolsList = tools;
@@ -126,6 +126,14 @@ public:
     void setAssignedTools(const AssignedBatchTools& tools);
     AssignedBatchTools assignedTools()                             const;
 
+    /**
+     * Count the intermediate images passed in memory between chained tools,
+     * i.e. the files which were not written and read back while processing this queue.
+     */
+    void addHandOffs(int count, qint64 bytes);
+    int    handOffs()                                              const;
+    qint64 handOffBytes()                                          const;
+
     void setEnableToolTips(bool val);
 
     void reloadThumbs(const QUrl& url);
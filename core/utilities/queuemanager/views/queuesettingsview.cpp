@@ -27,6 +27,7 @@
 #include <QApplication>
 #include <QStyle>
 #include <QIcon>
+#include <QLocale>
 
 // KDE includes
 
@@ -66,6 +67,7 @@ public:
     Private() = default;
 
     QLabel*                rawLoadingLabel          = nullptr;
+    QLabel*                handOffsLabel            = nullptr;
 
     QButtonGroup*          renamingButtonGroup      = nullptr;
     QButtonGroup*          rawLoadingButtonGroup    = nullptr;
@@ -78,6 +80,7 @@ public:
     QCheckBox*             useOrgAlbum              = nullptr;
     QCheckBox*             asNewVersion             = nullptr;
     QCheckBox*             useMutiCoreCPU           = nullptr;
+    QCheckBox*             pipelineMode             = nullptr;
 
     FileSaveConflictBox*   conflictBox              = nullptr;
     AlbumSelectWidget*     albumSel                 = nullptr;
@@ -198,6 +201,16 @@ QueueSettingsView::QueueSettingsView(QWidget* const parent)
     d->useMutiCoreCPU = new QCheckBox(i18nc("@option:check", "Work on all processor cores"), panel);
     d->useMutiCoreCPU->setWhatsThis(i18n("Turn on this option to use all CPU core from your computer "
                                          "to process more than one item from a queue at the same time."));
+
+    d->pipelineMode   = new QCheckBox(i18nc("@option:check", "Keep intermediate images in memory"), panel);
+    d->pipelineMode->setWhatsThis(i18n("Turn on this option to pass the image data directly from a tool "
+                                       "to the next one, including format conversions. Only the last tool "
+                                       "and the tools working on files, as user scripts, write the image to disk."));
+
+    d->handOffsLabel  = new QLabel(panel);
+    d->handOffsLabel->setWordWrap(true);
+    setHandOffs(0, 0);
+
     // -------------
 
     layout->addWidget(d->rawLoadingLabel);
@@ -205,6 +218,8 @@ QueueSettingsView::QueueSettingsView(QWidget* const parent)
     layout->addWidget(d->conflictBox);
     layout->addWidget(d->asNewVersion);
     layout->addWidget(d->useMutiCoreCPU);
+    layout->addWidget(d->pipelineMode);
+    layout->addWidget(d->handOffsLabel);
     layout->setContentsMargins(spacing, spacing, spacing, spacing);
     layout->setSpacing(spacing);
     layout->addStretch();
@@ -363,6 +378,9 @@ QueueSettingsView::QueueSettingsView(QWidget* const parent)
     connect(d->useMutiCoreCPU, SIGNAL(toggled(bool)),
             this, SLOT(slotSettingsChanged()));
 
+    connect(d->pipelineMode, SIGNAL(toggled(bool)),
+            this, SLOT(slotSettingsChanged()));
+
     connect(d->albumSel, SIGNAL(itemSelectionChanged()),
             this, SLOT(slotSettingsChanged()));
 
@@ -448,6 +466,13 @@ void QueueSettingsView::setBusy(bool b)
     }
 }
 
+void QueueSettingsView::setHandOffs(int count, qint64 bytes)
+{
+    d->handOffsLabel->setText(i18np("Saved I/O: 1 converted image passed in memory (%2)",
+                                    "Saved I/O: %1 converted images passed in memory (%2)",
+                                    count, QLocale().formattedDataSize(bytes)));
+}
+
 void QueueSettingsView::slotUseOrgAlbum()
 {
     if (!d->useOrgAlbum->isChecked())
@@ -473,6 +498,7 @@ void QueueSettingsView::slotResetSettings()
     d->useOrgAlbum->setChecked(true);
     d->asNewVersion->setChecked(true);
     d->useMutiCoreCPU->setChecked(false);
+    d->pipelineMode->setChecked(true);
 
     // TODO: reset d->albumSel
 
@@ -577,6 +603,7 @@ void QueueSettingsView::slotQueueSelected(int, const QueueSettings& settings, co
     d->useOrgAlbum->setChecked(settings.useOrgAlbum);
     d->asNewVersion->setChecked(settings.saveAsNewVersion);
     d->useMutiCoreCPU->setChecked(settings.useMultiCoreCPU);
+    d->pipelineMode->setChecked(settings.pipelineMode);
     d->albumSel->setEnabled(!settings.useOrgAlbum);
     d->albumSel->setCurrentAlbumUrl(settings.workingUrl);
 
@@ -667,6 +694,7 @@ void QueueSettingsView::slotSettingsChanged()
     settings.useOrgAlbum         = d->useOrgAlbum->isChecked();
     settings.saveAsNewVersion    = d->asNewVersion->isChecked();
     settings.useMultiCoreCPU     = d->useMutiCoreCPU->isChecked();
+    settings.pipelineMode        = d->pipelineMode->isChecked();
     settings.workingUrl          = d->albumSel->currentAlbumUrl();
 
     settings.renamingRule        = (QueueSettings::RenamingRule)d->renamingButtonGroup->checkedId();
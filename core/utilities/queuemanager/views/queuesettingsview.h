@@ -38,6 +38,11 @@ public:
 
     void setBusy(bool b);
 
+    /**
+     * Show the disk I/O saved by the pipeline mode for the current queue.
+     */
+    void setHandOffs(int count, qint64 bytes);
+
 Q_SIGNALS:
 
     void signalSettingsChanged(const QueueSettings&);